@@ -18,6 +18,7 @@ limitations under the License.
 #include <future>
 #include <iostream>
 
+#include "src/performance/trace/Tracer.h"
 #include "src/server/JasmineGraphInstance.h"
 #include "src/util/logger/Logger.h"
 #include "src/util/scheduler/SchedulerService.h"
@@ -45,6 +46,12 @@ int main(int argc, char *argv[]) {
     }
     std::cout << argc << std::endl;
 
+    Logger::setLevel(Logger::parseLevel(Utils::getJasmineGraphProperty("org.jasminegraph.logging.level")));
+    if (Utils::getJasmineGraphProperty("org.jasminegraph.logging.async") == "true") {
+        Logger::setAsync(true);
+    }
+    Tracer::setEnabled(Utils::getJasmineGraphProperty("org.jasminegraph.tracing.enabled") == "true");
+
     int mode = atoi(argv[2]);
     std::string JASMINEGRAPH_HOME = Utils::getJasmineGraphHome();
     std::string profile = argv[1];  // This can be either "docker" or "native"
@@ -58,6 +65,7 @@ int main(int argc, char *argv[]) {
         int numberOfWorkers = atoi(argv[4]);
         std::string workerIps = argv[5];
         enableNmon = argv[6];
+        Tracer::setProcessName("master");
         server = JasmineGraphServer::getInstance();
         thread schedulerThread(SchedulerService::startScheduler);
 
@@ -93,6 +101,7 @@ int main(int argc, char *argv[]) {
         enableNmon = argv[7];
 
         std::cout << "In worker mode" << std::endl;
+        Tracer::setProcessName("worker " + hostName + ":" + std::to_string(serverPort));
         instance = new JasmineGraphInstance();
         instance->start_running(profile, hostName, masterHost, serverPort, serverDataPort, enableNmon);
 
@@ -121,7 +121,7 @@ bool JasmineGraphHashMapDuplicateCentralStore::storeGraph() {
     return result;
 }
 
-map<long, unordered_set<long>> JasmineGraphHashMapDuplicateCentralStore::getUnderlyingHashMap() {
+const map<long, unordered_set<long>> &JasmineGraphHashMapDuplicateCentralStore::getUnderlyingHashMap() const {
     return centralDuplicateStoreSubgraphMap;
 }
 
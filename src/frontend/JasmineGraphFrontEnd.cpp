@@ -24,6 +24,7 @@ limitations under the License.
 #include <map>
 #include <nlohmann/json.hpp>
 #include <set>
+#include <stdexcept>
 #include <thread>
 
 #include "../metadb/SQLiteDBInterface.h"
@@ -33,8 +34,11 @@ limitations under the License.
 #include "../partitioner/local/MetisPartitioner.h"
 #include "../partitioner/local/RDFParser.h"
 #include "../partitioner/local/RDFPartitioner.h"
+#include "../partitioner/local/RDFStreamReader.h"
 #include "../partitioner/stream/Partitioner.h"
+#include "../performance/metrics/MetricsRegistry.h"
 #include "../performance/metrics/PerformanceUtil.h"
+#include "../performance/trace/Tracer.h"
 #include "../query/algorithms/linkprediction/JasminGraphLinkPredictor.h"
 #include "../server/JasmineGraphInstanceProtocol.h"
 #include "../server/JasmineGraphServer.h"
@@ -44,6 +48,7 @@ limitations under the License.
 #include "../util/logger/Logger.h"
 #include "JasmineGraphFrontEndProtocol.h"
 #include "core/CoreConstants.h"
+#include "core/cache/AnalyticsResultCache.h"
 #include "core/scheduler/JobScheduler.h"
 
 #define MAX_PENDING_CONNECTIONS 10
@@ -84,6 +89,7 @@ static void merge_command(int connFd, SQLiteDBInterface *sqlite, bool *loop_exit
 static void train_command(int connFd, SQLiteDBInterface *sqlite, bool *loop_exit_p);
 static void in_degree_command(int connFd, bool *loop_exit_p);
 static void out_degree_command(int connFd, bool *loop_exit_p);
+static void degree_histogram_command(int connFd, bool *loop_exit_p, bool in);
 static void page_rank_command(std::string masterIP, int connFd, SQLiteDBInterface *sqlite,
                               PerformanceSQLiteDBInterface *perfSqlite, JobScheduler *jobScheduler, bool *loop_exit_p);
 static void egonet_command(int connFd, bool *loop_exit_p);
@@ -92,6 +98,14 @@ static void predict_command(std::string masterIP, int connFd, SQLiteDBInterface
 static void start_remote_worker_command(int connFd, bool *loop_exit_p);
 static void sla_command(int connFd, SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfSqlite,
                         bool *loop_exit_p);
+static void metrics_command(int connFd, bool *loop_exit_p);
+static void trace_command(int connFd, bool *loop_exit_p);
+static void link_predict_command(int connFd, SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfSqlite,
+                                 bool *loop_exit_p);
+static void compact_command(int connFd, SQLiteDBInterface *sqlite, int numberOfPartitions, bool *loop_exit_p);
+static void k_hop_command(int connFd, SQLiteDBInterface *sqlite, int numberOfPartitions, bool *loop_exit_p);
+static void vertex_attributes_command(int connFd, SQLiteDBInterface *sqlite, bool *loop_exit_p);
+static void vertex_ids_command(int connFd, SQLiteDBInterface *sqlite, bool *loop_exit_p);
 
 void *frontendservicesesion(void *dummyPt) {
     frontendservicesessionargs *sessionargs = (frontendservicesessionargs *)dummyPt;
@@ -161,6 +175,8 @@ void *frontendservicesesion(void *dummyPt) {
             workerResponded = false;
         }
 
+        auto commandStart = std::chrono::steady_clock::now();
+        bool knownCommand = true;
         if (line.compare(EXIT) == 0) {
             currentFESession--;
             break;
@@ -203,6 +219,10 @@ void *frontendservicesesion(void *dummyPt) {
             in_degree_command(connFd, &loop_exit);
         } else if (line.compare(OUT_DEGREE) == 0) {
             out_degree_command(connFd, &loop_exit);
+        } else if (line.compare(IN_DEGREE_HISTOGRAM) == 0) {
+            degree_histogram_command(connFd, &loop_exit, true);
+        } else if (line.compare(OUT_DEGREE_HISTOGRAM) == 0) {
+            degree_histogram_command(connFd, &loop_exit, false);
         } else if (line.compare(PAGE_RANK) == 0) {
             page_rank_command(masterIP, connFd, sqlite, perfSqlite, jobScheduler, &loop_exit);
         } else if (line.compare(EGONET) == 0) {
@@ -215,14 +235,36 @@ void *frontendservicesesion(void *dummyPt) {
             start_remote_worker_command(connFd, &loop_exit);
         } else if (line.compare(SLA) == 0) {
             sla_command(connFd, sqlite, perfSqlite, &loop_exit);
+        } else if (line.compare(METRICS) == 0) {
+            metrics_command(connFd, &loop_exit);
+        } else if (line.compare(TRACE) == 0) {
+            trace_command(connFd, &loop_exit);
+        } else if (line.compare(LINK_PREDICT) == 0) {
+            link_predict_command(connFd, sqlite, perfSqlite, &loop_exit);
+        } else if (line.compare(COMPACT) == 0) {
+            compact_command(connFd, sqlite, numberOfPartitions, &loop_exit);
+        } else if (line.compare(K_HOP) == 0) {
+            k_hop_command(connFd, sqlite, numberOfPartitions, &loop_exit);
+        } else if (line.compare(VERTEX_ATTRIBUTES) == 0) {
+            vertex_attributes_command(connFd, sqlite, &loop_exit);
+        } else if (line.compare(VERTEX_IDS) == 0) {
+            vertex_ids_command(connFd, sqlite, &loop_exit);
         } else {
             frontend_logger.error("Message format not recognized " + line);
+            knownCommand = false;
             int result_wr = write(connFd, INVALID_FORMAT.c_str(), INVALID_FORMAT.size());
             if (result_wr < 0) {
                 frontend_logger.error("Error writing to socket");
                 break;
             }
         }
+        if (knownCommand) {
+            MetricsRegistry::histogram("jasminegraph_frontend_command_latency_us",
+                                       "Time taken by the master to serve a frontend command",
+                                       "command=\"" + line + "\"")
+                .record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                              commandStart).count());
+        }
     }
     if (input_stream_handler.joinable()) {
         input_stream_handler.join();
@@ -378,6 +420,8 @@ void JasmineGraphFrontEnd::removeGraph(std::string graphID, SQLiteDBInterface *s
     sqlite->runUpdate("DELETE FROM worker_has_partition WHERE partition_graph_idgraph = " + graphID);
     sqlite->runUpdate("DELETE FROM partition WHERE graph_idgraph = " + graphID);
     sqlite->runUpdate("DELETE FROM graph WHERE idgraph = " + graphID);
+    StreamHandler::removeVertexDictionary(graphID);
+    AnalyticsResultCache::bumpGraphVersion(graphID);
 }
 
 /**
@@ -676,22 +720,52 @@ static void add_rdf_command(std::string masterIP, int connFd, SQLiteDBInterface
             to_string(Conts::GRAPH_STATUS::LOADING) + "\", \"\", \"\", \"\")";
         int newGraphID = sqlite->runInsert(sqlStatement);
 
-        GetConfig appConfig;
-        appConfig.readConfigFile(path, newGraphID);
+        // Both readers stream the file into the partitioner input instead of building it in memory
+        string input_file_path = GetConfig::getEdgeFilePath(newGraphID);
+        bool isNTriples = path.size() > 3 && path.compare(path.size() - 3, 3, ".nt") == 0;
+        try {
+            if (isNTriples) {
+                Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/");
+                Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/tmp/");
+                Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/tmp/" + to_string(newGraphID));
+                RDFEdgeWriter writer(input_file_path, GetConfig::getArticleFilePath(newGraphID));
+                RDFStreamReader reader(writer);
+                long statementCount = reader.readNTriples(path);
+                frontend_logger.info("Read " + to_string(statementCount) + " N-Triples statements with " +
+                                     to_string(reader.getVertices().size()) + " resources and " +
+                                     to_string(writer.getLiteralCount()) + " literals");
+            } else {
+                GetConfig appConfig;
+                appConfig.readConfigFile(path, newGraphID);
+            }
+        } catch (const std::runtime_error &e) {
+            // Two terms sharing a vertex would silently corrupt the graph, so it is not uploaded at all
+            frontend_logger.error("Could not read graph " + to_string(newGraphID) + ": " + e.what());
+            sqlite->runUpdate("DELETE FROM graph WHERE idgraph = " + to_string(newGraphID));
+            Utils::deleteDirectory(Utils::getHomeDir() + "/.jasminegraph/tmp/" + to_string(newGraphID));
+            std::string message = std::string(e.what()) + "\r\n";
+            result_wr = write(connFd, message.c_str(), message.size());
+            if (result_wr < 0) {
+                frontend_logger.error("Error writing to socket");
+                *loop_exit_p = true;
+            }
+            return;
+        }
 
         MetisPartitioner *metisPartitioner = new MetisPartitioner(sqlite);
         vector<std::map<int, string>> fullFileList;
-        string input_file_path =
-            Utils::getHomeDir() + "/.jasminegraph/tmp/" + to_string(newGraphID) + "/" + to_string(newGraphID);
         metisPartitioner->loadDataSet(input_file_path, newGraphID);
 
-        metisPartitioner->constructMetisFormat(Conts::GRAPH_TYPE_RDF);
+        // N-Triples have no article attributes, so their edges are partitioned and uploaded as a plain graph
+        metisPartitioner->constructMetisFormat(isNTriples ? Conts::GRAPH_TYPE_NORMAL : Conts::GRAPH_TYPE_RDF);
         fullFileList = metisPartitioner->partitioneWithGPMetis("");
         JasmineGraphServer *server = JasmineGraphServer::getInstance();
-        server->uploadGraphLocally(newGraphID, Conts::GRAPH_WITH_ATTRIBUTES, fullFileList, masterIP);
+        server->uploadGraphLocally(newGraphID, isNTriples ? Conts::GRAPH_TYPE_NORMAL : Conts::GRAPH_WITH_ATTRIBUTES,
+                                   fullFileList, masterIP);
         Utils::deleteDirectory(Utils::getHomeDir() + "/.jasminegraph/tmp/" + to_string(newGraphID));
         Utils::deleteDirectory("/tmp/" + std::to_string(newGraphID));
         JasmineGraphFrontEnd::getAndUpdateUploadTime(to_string(newGraphID), sqlite);
+        AnalyticsResultCache::bumpGraphVersion(to_string(newGraphID));
         int result_wr = write(connFd, DONE.c_str(), DONE.size());
         if (result_wr < 0) {
             frontend_logger.error("Error writing to socket");
@@ -791,6 +865,7 @@ static void add_graph_command(std::string masterIP, int connFd, SQLiteDBInterfac
         string workerCount = results[0][0].second;
         int nWorkers = atoi(workerCount.c_str());
         JasmineGraphFrontEnd::getAndUpdateUploadTime(to_string(newGraphID), sqlite);
+        AnalyticsResultCache::bumpGraphVersion(to_string(newGraphID));
         int result_wr = write(connFd, DONE.c_str(), DONE.size());
         if (result_wr < 0) {
             frontend_logger.error("Error writing to socket");
@@ -963,6 +1038,7 @@ static void add_graph_cust_command(std::string masterIP, int connFd, SQLiteDBInt
         Utils::deleteDirectory(Utils::getHomeDir() + "/.jasminegraph/tmp/" + to_string(newGraphID));
         Utils::deleteDirectory("/tmp/" + std::to_string(newGraphID));
         JasmineGraphFrontEnd::getAndUpdateUploadTime(to_string(newGraphID), sqlite);
+        AnalyticsResultCache::bumpGraphVersion(to_string(newGraphID));
         result_wr = write(connFd, DONE.c_str(), DONE.size());
         if (result_wr < 0) {
             frontend_logger.error("Error writing to socket");
@@ -1385,6 +1461,27 @@ static void triangles_command(std::string masterIP, int connFd, SQLiteDBInterfac
         JobRequest jobDetails;
         jobDetails.setJobId(std::to_string(uniqueId));
         jobDetails.setJobType(TRIANGLES);
+        jobDetails.addParameter(Conts::PARAM_KEYS::GRAPH_ID, graph_id);
+        jobDetails.addParameter(Conts::PARAM_KEYS::GRAPH_VERSION,
+                                std::to_string(AnalyticsResultCache::getGraphVersion(graph_id)));
+
+        // Answers cached for the current version of the graph are returned without queueing the job
+        std::string cachedTriangleCount;
+        if (jobScheduler->getCachedResult(jobDetails, cachedTriangleCount)) {
+            frontend_logger.info("Triangle Count: " + cachedTriangleCount + " served from the result cache");
+            result_wr = write(connFd, cachedTriangleCount.c_str(), cachedTriangleCount.length());
+            if (result_wr < 0) {
+                frontend_logger.error("Error writing to socket");
+                *loop_exit_p = true;
+                return;
+            }
+            result_wr = write(connFd, "\r\n", 2);
+            if (result_wr < 0) {
+                frontend_logger.error("Error writing to socket");
+                *loop_exit_p = true;
+            }
+            return;
+        }
 
         long graphSLA;
         // All high priority threads will be set the same high priority level
@@ -1412,7 +1509,6 @@ static void triangles_command(std::string masterIP, int connFd, SQLiteDBInterfac
 
         jobDetails.setPriority(threadPriority);
         jobDetails.setMasterIP(masterIP);
-        jobDetails.addParameter(Conts::PARAM_KEYS::GRAPH_ID, graph_id);
         jobDetails.addParameter(Conts::PARAM_KEYS::CATEGORY, Conts::SLA_CATEGORY::LATENCY);
         if (canCalibrate) {
             jobDetails.addParameter(Conts::PARAM_KEYS::CAN_CALIBRATE, "true");
@@ -1420,8 +1516,17 @@ static void triangles_command(std::string masterIP, int connFd, SQLiteDBInterfac
             jobDetails.addParameter(Conts::PARAM_KEYS::CAN_CALIBRATE, "false");
         }
 
+        std::string traceId = Tracer::startTrace();
+        if (!traceId.empty()) {
+            jobDetails.addParameter(Conts::PARAM_KEYS::TRACE_ID, traceId);
+            frontend_logger.info("Triangle count of graph " + graph_id + " is traced with trace id " + traceId);
+        }
+        TraceContext traceContext(traceId);
+        TraceSpan querySpan("frontend.triangles", graph_id);
+
         jobScheduler->pushJob(jobDetails);
         JobResponse jobResponse = jobScheduler->getResult(jobDetails);
+        querySpan.end();
         std::string errorMessage = jobResponse.getParameter(Conts::PARAM_KEYS::ERROR_MESSAGE);
 
         if (!errorMessage.empty()) {
@@ -1460,6 +1565,16 @@ static void triangles_command(std::string masterIP, int connFd, SQLiteDBInterfac
         if (result_wr < 0) {
             frontend_logger.error("Error writing to socket");
             *loop_exit_p = true;
+            return;
+        }
+        if (!traceId.empty()) {
+            // The id of a traced query is what the trace command takes
+            std::string traceLine = "trace id: " + traceId + "\r\n";
+            result_wr = write(connFd, traceLine.c_str(), traceLine.length());
+            if (result_wr < 0) {
+                frontend_logger.error("Error writing to socket");
+                *loop_exit_p = true;
+            }
         }
     }
 }
@@ -1860,6 +1975,23 @@ static void train_command(int connFd, SQLiteDBInterface *sqlite, bool *loop_exit
     }
 }
 
+// The distribution stays on the workers, the cache only remembers that it is current for this version of the graph
+static void run_degree_distribution(const string &graphID, bool in) {
+    string algorithm = in ? IN_DEGREE : OUT_DEGREE;
+    string completed;
+    if (AnalyticsResultCache::get(graphID, algorithm, "", completed)) {
+        frontend_logger.info(string(in ? "In" : "Out") + " degree distribution of graph " + graphID +
+                             " is already current on the workers");
+        return;
+    }
+    long graphVersion = AnalyticsResultCache::getGraphVersion(graphID);
+    bool sent = in ? JasmineGraphServer::inDegreeDistribution(graphID)
+                   : JasmineGraphServer::outDegreeDistribution(graphID);
+    if (sent) {
+        AnalyticsResultCache::put(graphID, algorithm, "", graphVersion, DONE);
+    }
+}
+
 static void in_degree_command(int connFd, bool *loop_exit_p) {
     frontend_logger.info("Calculating In Degree Distribution");
 
@@ -1886,7 +2018,68 @@ static void in_degree_command(int connFd, bool *loop_exit_p) {
     graphID = Utils::trim_copy(graphID);
     frontend_logger.info("Graph ID received: " + graphID);
 
-    JasmineGraphServer::inDegreeDistribution(graphID);
+    run_degree_distribution(graphID, true);
+
+    result_wr = write(connFd, DONE.c_str(), FRONTEND_COMMAND_LENGTH);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+    }
+}
+
+static void degree_histogram_command(int connFd, bool *loop_exit_p, bool in) {
+    frontend_logger.info(string("Calculating ") + (in ? "In" : "Out") + " Degree Histogram");
+
+    int result_wr = write(connFd, SEND.c_str(), FRONTEND_COMMAND_LENGTH);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+
+    char graph_id[FRONTEND_DATA_LENGTH + 1];
+    bzero(graph_id, FRONTEND_DATA_LENGTH + 1);
+
+    read(connFd, graph_id, FRONTEND_DATA_LENGTH);
+
+    string graphID(graph_id);
+
+    graphID = Utils::trim_copy(graphID);
+    frontend_logger.info("Graph ID received: " + graphID);
+
+    // One "degree:vertex count" pair per line
+    string algorithm = in ? IN_DEGREE_HISTOGRAM : OUT_DEGREE_HISTOGRAM;
+    string histogramString;
+    long graphVersion = AnalyticsResultCache::getGraphVersion(graphID);
+    if (!AnalyticsResultCache::get(graphID, algorithm, "", histogramString)) {
+        std::map<long, long> histogram = JasmineGraphServer::degreeHistogram(graphID, in);
+        std::stringstream histogramStream;
+        for (auto it = histogram.begin(); it != histogram.end(); ++it) {
+            histogramStream << it->first << ":" << it->second << "\r\n";
+        }
+        histogramString = histogramStream.str();
+        AnalyticsResultCache::put(graphID, algorithm, "", graphVersion, histogramString);
+    }
+    if (!histogramString.empty()) {
+        result_wr = write(connFd, histogramString.c_str(), histogramString.length());
+        if (result_wr < 0) {
+            frontend_logger.error("Error writing to socket");
+            *loop_exit_p = true;
+            return;
+        }
+    }
 
     result_wr = write(connFd, DONE.c_str(), FRONTEND_COMMAND_LENGTH);
     if (result_wr < 0) {
@@ -1927,7 +2120,7 @@ static void out_degree_command(int connFd, bool *loop_exit_p) {
     graphID = Utils::trim_copy(graphID);
     frontend_logger.info("Graph ID received: " + graphID);
 
-    JasmineGraphServer::outDegreeDistribution(graphID);
+    run_degree_distribution(graphID, false);
 
     result_wr = write(connFd, DONE.c_str(), FRONTEND_COMMAND_LENGTH);
     if (result_wr < 0) {
@@ -2041,6 +2234,27 @@ static void page_rank_command(std::string masterIP, int connFd, SQLiteDBInterfac
 
     int threadPriority = std::atoi(priority.c_str());
 
+    // The ranks stay on the workers and every run overwrites them, so the cache keeps the parameters of the run that
+    // is current for this version of the graph
+    string parameters = to_string(alpha) + "|" + to_string(iterations);
+    long graphVersion = AnalyticsResultCache::getGraphVersion(graphID);
+    string cachedParameters;
+    if (AnalyticsResultCache::get(graphID, PAGE_RANK, "", cachedParameters) && cachedParameters == parameters) {
+        frontend_logger.info("PageRank of graph " + graphID + " is already current on the workers");
+        result_wr = write(connFd, DONE.c_str(), FRONTEND_COMMAND_LENGTH);
+        if (result_wr < 0) {
+            frontend_logger.error("Error writing to socket");
+            *loop_exit_p = true;
+            return;
+        }
+        result_wr = write(connFd, "\r\n", 2);
+        if (result_wr < 0) {
+            frontend_logger.error("Error writing to socket");
+            *loop_exit_p = true;
+        }
+        return;
+    }
+
     auto begin = chrono::high_resolution_clock::now();
     JobRequest jobDetails;
     int uniqueId = JasmineGraphFrontEnd::getUid();
@@ -2106,6 +2320,7 @@ static void page_rank_command(std::string masterIP, int connFd, SQLiteDBInterfac
     if (threadPriority == Conts::HIGH_PRIORITY_DEFAULT_VALUE) {
         highPriorityTaskCount--;
     }
+    AnalyticsResultCache::put(graphID, PAGE_RANK, "", graphVersion, parameters);
 
     auto end = chrono::high_resolution_clock::now();
     auto dur = end - begin;
@@ -2443,3 +2658,386 @@ static void sla_command(int connFd, SQLiteDBInterface *sqlite, PerformanceSQLite
         }
     }
 }
+
+static void metrics_command(int connFd, bool *loop_exit_p) {
+    std::string metrics = JasmineGraphServer::collectMetrics();
+    int result_wr = write(connFd, metrics.c_str(), metrics.length());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, DONE.c_str(), DONE.size());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+    }
+}
+
+static void trace_command(int connFd, bool *loop_exit_p) {
+    int result_wr = write(connFd, SEND.c_str(), SEND.size());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+
+    char trace_id_data[FRONTEND_DATA_LENGTH + 1];
+    bzero(trace_id_data, FRONTEND_DATA_LENGTH + 1);
+    read(connFd, trace_id_data, FRONTEND_DATA_LENGTH);
+    string traceId = Utils::trim_copy(string(trace_id_data));
+    frontend_logger.info("Collecting the spans of trace " + traceId);
+
+    // Chrome trace-event document with the spans of the master and all workers
+    std::string trace = JasmineGraphServer::collectTrace(traceId);
+    result_wr = write(connFd, trace.c_str(), trace.length());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, DONE.c_str(), DONE.size());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+    }
+}
+
+static void link_predict_command(int connFd, SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfSqlite,
+                                 bool *loop_exit_p) {
+    int result_wr = write(connFd, SEND.c_str(), SEND.size());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+
+    // graph id|metric|k where the metric and k are optional
+    char predict_data[FRONTEND_DATA_LENGTH + 1];
+    bzero(predict_data, FRONTEND_DATA_LENGTH + 1);
+    read(connFd, predict_data, FRONTEND_DATA_LENGTH);
+    std::vector<std::string> strArr = Utils::split(Utils::trim_copy(string(predict_data)), '|');
+
+    NeighborhoodSimilarity::Metric metric = NeighborhoodSimilarity::ADAMIC_ADAR;
+    int k = 10;
+    std::string error_message;
+    if (strArr.empty() || strArr.size() > 3) {
+        error_message = INVALID_FORMAT;
+    } else if (!JasmineGraphFrontEnd::graphExistsByID(strArr[0], sqlite)) {
+        error_message = "The specified graph id does not exist";
+    } else if (strArr.size() > 1 && !NeighborhoodSimilarity::parseMetric(strArr[1], metric)) {
+        error_message = "Metric should be common-neighbors, jaccard, adamic-adar or resource-allocation";
+    } else if (strArr.size() > 2) {
+        if (!Utils::is_number(strArr[2]) || atoi(strArr[2].c_str()) < 1) {
+            error_message = "k should be a positive number";
+        } else {
+            k = atoi(strArr[2].c_str());
+        }
+    }
+
+    std::string links;
+    if (error_message.empty()) {
+        frontend_logger.info("Predicting links of graph " + strArr[0] + " with " +
+                             NeighborhoodSimilarity::getMetricName(metric) + " top " + std::to_string(k));
+        links = JasminGraphLinkPredictor::predictLinks(sqlite, perfSqlite, strArr[0], metric, k);
+    } else {
+        frontend_logger.error(error_message);
+        links = error_message + "\r\n";
+    }
+
+    result_wr = write(connFd, links.c_str(), links.length());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, DONE.c_str(), DONE.size());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+    }
+}
+
+static void compact_command(int connFd, SQLiteDBInterface *sqlite, int numberOfPartitions, bool *loop_exit_p) {
+    int result_wr = write(connFd, SEND.c_str(), SEND.size());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+
+    // graph id of a streamed graph, whose partitions must not be loaded by their workers
+    char graph_id_data[FRONTEND_DATA_LENGTH + 1];
+    bzero(graph_id_data, FRONTEND_DATA_LENGTH + 1);
+    read(connFd, graph_id_data, FRONTEND_DATA_LENGTH);
+    std::string graphID = Utils::trim_copy(string(graph_id_data));
+
+    std::string result;
+    if (!JasmineGraphFrontEnd::graphExistsByID(graphID, sqlite)) {
+        frontend_logger.error("The specified graph id does not exist");
+        result = "The specified graph id does not exist\r\n";
+    } else {
+        frontend_logger.info("Compacting the native store of graph " + graphID);
+        result = JasmineGraphServer::compactGraph(sqlite, graphID, numberOfPartitions);
+    }
+
+    result_wr = write(connFd, result.c_str(), result.length());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, DONE.c_str(), DONE.size());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+    }
+}
+
+// The id the stores know a vertex of a streamed graph by, the dense id when the graph has a vertex dictionary
+static bool translateVertexId(const std::string &graphID, const std::string &externalId, std::string &storeId) {
+    std::shared_ptr<VertexDictionary> dictionary = StreamHandler::getVertexDictionary(graphID, false);
+    if (!dictionary) {
+        storeId = externalId;
+        return true;
+    }
+    std::vector<uint64_t> ids;
+    dictionary->lookup({externalId}, ids);
+    if (ids[0] == VertexDictionary::NOT_FOUND) {
+        return false;
+    }
+    storeId = std::to_string(ids[0]);
+    return true;
+}
+
+static void k_hop_command(int connFd, SQLiteDBInterface *sqlite, int numberOfPartitions, bool *loop_exit_p) {
+    int result_wr = write(connFd, SEND.c_str(), SEND.size());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+
+    // graph id|source vertex|k|directed where k (0 for all levels) and directed (true or false) are optional
+    char k_hop_data[FRONTEND_DATA_LENGTH + 1];
+    bzero(k_hop_data, FRONTEND_DATA_LENGTH + 1);
+    read(connFd, k_hop_data, FRONTEND_DATA_LENGTH);
+    std::vector<std::string> strArr = Utils::split(Utils::trim_copy(string(k_hop_data)), '|');
+
+    int k = 0;
+    bool directed = false;
+    std::string source;
+    std::string error_message;
+    if (strArr.size() < 2 || strArr.size() > 4 || strArr[1].empty()) {
+        error_message = INVALID_FORMAT;
+    } else if (!JasmineGraphFrontEnd::graphExistsByID(strArr[0], sqlite)) {
+        error_message = "The specified graph id does not exist";
+    } else if (strArr.size() > 2 && !Utils::is_number(strArr[2])) {
+        error_message = "k should be a number, 0 for all levels";
+    } else if (strArr.size() > 3 && strArr[3] != "true" && strArr[3] != "false") {
+        error_message = "directed should be true or false";
+    } else if (!translateVertexId(strArr[0], strArr[1], source)) {
+        error_message = "Vertex " + strArr[1] + " is not in graph " + strArr[0];
+    } else {
+        k = strArr.size() > 2 ? atoi(strArr[2].c_str()) : 0;
+        directed = strArr.size() > 3 && strArr[3] == "true";
+    }
+
+    std::string levels;
+    if (error_message.empty()) {
+        frontend_logger.info("Searching graph " + strArr[0] + " from vertex " + strArr[1] + " up to " +
+                             std::to_string(k) + " hops");
+        levels = JasmineGraphServer::kHop(sqlite, strArr[0], numberOfPartitions, source, k, directed);
+    } else {
+        frontend_logger.error(error_message);
+        levels = error_message + "\r\n";
+    }
+
+    result_wr = write(connFd, levels.c_str(), levels.length());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, DONE.c_str(), DONE.size());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+    }
+}
+
+static void vertex_attributes_command(int connFd, SQLiteDBInterface *sqlite, bool *loop_exit_p) {
+    int result_wr = write(connFd, SEND.c_str(), SEND.size());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+
+    // graph id|comma separated vertex ids, all the vertices of the graph when there are none
+    char attribute_data[FRONTEND_DATA_LENGTH + 1];
+    bzero(attribute_data, FRONTEND_DATA_LENGTH + 1);
+    read(connFd, attribute_data, FRONTEND_DATA_LENGTH);
+    std::vector<std::string> strArr = Utils::split(Utils::trim_copy(string(attribute_data)), '|');
+
+    std::string result;
+    if (strArr.empty() || strArr.size() > 2) {
+        frontend_logger.error(INVALID_FORMAT);
+        result = INVALID_FORMAT + "\r\n";
+    } else if (!JasmineGraphFrontEnd::graphExistsByID(strArr[0], sqlite)) {
+        frontend_logger.error("The specified graph id does not exist");
+        result = "The specified graph id does not exist\r\n";
+    } else {
+        frontend_logger.info("Reading vertex attributes of graph " + strArr[0]);
+        result = JasmineGraphServer::vertexAttributes(sqlite, strArr[0], strArr.size() > 1 ? strArr[1] : "");
+    }
+
+    result_wr = write(connFd, result.c_str(), result.length());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, DONE.c_str(), DONE.size());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+    }
+}
+
+static void vertex_ids_command(int connFd, SQLiteDBInterface *sqlite, bool *loop_exit_p) {
+    int result_wr = write(connFd, SEND.c_str(), SEND.size());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+
+    // graph id|comma separated vertex ids returned by the queries of a streamed graph
+    char vertex_id_data[FRONTEND_DATA_LENGTH + 1];
+    bzero(vertex_id_data, FRONTEND_DATA_LENGTH + 1);
+    read(connFd, vertex_id_data, FRONTEND_DATA_LENGTH);
+    std::vector<std::string> strArr = Utils::split(Utils::trim_copy(string(vertex_id_data)), '|');
+
+    std::string result;
+    std::shared_ptr<VertexDictionary> dictionary;
+    if (strArr.size() != 2) {
+        frontend_logger.error(INVALID_FORMAT);
+        result = INVALID_FORMAT + "\r\n";
+    } else if (!JasmineGraphFrontEnd::graphExistsByID(strArr[0], sqlite)) {
+        frontend_logger.error("The specified graph id does not exist");
+        result = "The specified graph id does not exist\r\n";
+    } else if (!(dictionary = StreamHandler::getVertexDictionary(strArr[0], false))) {
+        // The stores keep the ids of the stream itself
+        result = "Graph " + strArr[0] + " has no vertex dictionary\r\n";
+    } else {
+        std::vector<std::string> storeIds = Utils::split(strArr[1], ',');
+        std::vector<uint64_t> ids;
+        for (auto &id : storeIds) {
+            bool valid = Utils::is_number(id) && id.size() < 20;
+            ids.push_back(valid ? std::stoull(id) : VertexDictionary::NOT_FOUND);
+        }
+        std::vector<std::string> externalIds;
+        dictionary->getExternalIds(ids, externalIds);
+        // One "vertex id<tab>id in the stream" line per vertex, the second field is empty for unknown ids
+        for (size_t i = 0; i < storeIds.size(); i++) {
+            result += storeIds[i] + "\t" + externalIds[i] + "\r\n";
+        }
+    }
+
+    result_wr = write(connFd, result.c_str(), result.length());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, DONE.c_str(), DONE.size());
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+        return;
+    }
+    result_wr = write(connFd, "\r\n", 2);
+    if (result_wr < 0) {
+        frontend_logger.error("Error writing to socket");
+        *loop_exit_p = true;
+    }
+}
@@ -39,6 +39,8 @@ const string PAGE_RANK = "pgrnk";
 const string OUT_DEGREE_DISTRIBUTION = "odd";
 const string IN_DEGREE = "idd";
 const string OUT_DEGREE = "odd";
+const string IN_DEGREE_HISTOGRAM = "idd-hist";
+const string OUT_DEGREE_HISTOGRAM = "odd-hist";
 const string EGONET = "egnt";
 const string DPCNTRL = "dp-cntrl";
 const string TRAIN = "train";
@@ -50,6 +52,13 @@ const string MERGE = "merge";
 const string START_REMOTE_WORKER = "start-rmt-worker";
 const string REMOTE_WORKER_ARGS = "remote-worker-args";
 const string SLA = "sla";
+const string METRICS = "metrics";
+const string TRACE = "trace";
+const string LINK_PREDICT = "lnkpred";
+const string COMPACT = "compact";
+const string K_HOP = "khop";
+const string VERTEX_ATTRIBUTES = "vattr";
+const string VERTEX_IDS = "vid";
 const string COMMAND = "command";
 const string PRIORITY = "priority(>=1)";
 const string INVALID_FORMAT = "Invalid message format";
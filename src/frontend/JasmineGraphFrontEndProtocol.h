@@ -43,6 +43,8 @@ extern const string GREM_DONE;
 extern const string PAGERANK;
 extern const string OUT_DEGREE;
 extern const string IN_DEGREE;
+extern const string IN_DEGREE_HISTOGRAM;
+extern const string OUT_DEGREE_HISTOGRAM;
 extern const string IN_DEGREE_SEND;
 extern const string AVERAGE_OUT_DEGREE;
 extern const string AVERAGE_IN_DEGREE;
@@ -82,6 +84,13 @@ extern const string SLA;
 extern const string COMMAND;
 extern const string PRIORITY;
 extern const string STOP_STREAM_KAFKA;
+extern const string METRICS;
+extern const string TRACE;
+extern const string LINK_PREDICT;
+extern const string COMPACT;
+extern const string K_HOP;
+extern const string VERTEX_ATTRIBUTES;
+extern const string VERTEX_IDS;
 
 extern const string ADMDL;
 extern const string MERGE;
@@ -0,0 +1,165 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "AnalyticsResultCache.h"
+
+#include <tuple>
+#include <utility>
+
+#include "../../../performance/metrics/MetricsRegistry.h"
+#include "../../../util/logger/Logger.h"
+
+Logger result_cache_logger;
+
+const size_t AnalyticsResultCache::DEFAULT_CAPACITY = 1024;
+
+std::mutex AnalyticsResultCache::cacheMutex;
+std::mutex AnalyticsResultCache::versionsMutex;
+std::map<std::string, std::atomic<long>> AnalyticsResultCache::graphVersions;
+std::unordered_map<std::string, AnalyticsResultCache::CacheEntry> AnalyticsResultCache::entries;
+std::list<std::string> AnalyticsResultCache::lruList;
+size_t AnalyticsResultCache::capacity = AnalyticsResultCache::DEFAULT_CAPACITY;
+long AnalyticsResultCache::hitCount = 0;
+long AnalyticsResultCache::missCount = 0;
+
+std::string AnalyticsResultCache::makeKey(const std::string &graphId, const std::string &algorithm,
+                                          const std::string &parameters) {
+    // Graph ids and algorithm names never contain '|', so the key is unambiguous for any parameter string
+    return graphId + "|" + algorithm + "|" + parameters;
+}
+
+static void countLookup(bool hit) {
+    static Counter &hits = MetricsRegistry::counter("jasminegraph_result_cache_hits_total",
+                                                    "Analytics results answered from the result cache");
+    static Counter &misses = MetricsRegistry::counter("jasminegraph_result_cache_misses_total",
+                                                      "Analytics result cache lookups that missed");
+    (hit ? hits : misses).inc();
+}
+
+std::atomic<long> &AnalyticsResultCache::getVersionCounter(const std::string &graphId) {
+    // Counters are never erased, map nodes do not move, so the reference outlives the lock
+    std::lock_guard<std::mutex> lock(versionsMutex);
+    auto it = graphVersions.find(graphId);
+    if (it == graphVersions.end()) {
+        it = graphVersions.emplace(std::piecewise_construct, std::forward_as_tuple(graphId),
+                                   std::forward_as_tuple(0))
+                 .first;
+    }
+    return it->second;
+}
+
+long AnalyticsResultCache::getGraphVersion(const std::string &graphId) { return getVersionCounter(graphId).load(); }
+
+long AnalyticsResultCache::bumpGraphVersion(const std::string &graphId) { return ++getVersionCounter(graphId); }
+
+void AnalyticsResultCache::erase(std::unordered_map<std::string, CacheEntry>::iterator entry) {
+    lruList.erase(entry->second.lruPosition);
+    entries.erase(entry);
+}
+
+bool AnalyticsResultCache::get(const std::string &graphId, const std::string &algorithm,
+                               const std::string &parameters, std::string &result) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto entry = entries.find(makeKey(graphId, algorithm, parameters));
+    if (entry == entries.end()) {
+        missCount++;
+        countLookup(false);
+        return false;
+    }
+
+    if (entry->second.graphVersion != getGraphVersion(graphId)) {
+        erase(entry);
+        missCount++;
+        countLookup(false);
+        return false;
+    }
+
+    lruList.splice(lruList.begin(), lruList, entry->second.lruPosition);
+    result = entry->second.result;
+    hitCount++;
+    countLookup(true);
+    return true;
+}
+
+bool AnalyticsResultCache::put(const std::string &graphId, const std::string &algorithm,
+                               const std::string &parameters, long graphVersion, const std::string &result) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (capacity == 0) {
+        return false;
+    }
+
+    if (graphVersion != getGraphVersion(graphId)) {
+        result_cache_logger.info("Not caching " + algorithm + " result of graph " + graphId +
+                                 " since the graph changed while it was computed");
+        return false;
+    }
+
+    std::string key = makeKey(graphId, algorithm, parameters);
+    auto existing = entries.find(key);
+    if (existing != entries.end()) {
+        erase(existing);
+    }
+
+    while (entries.size() >= capacity) {
+        erase(entries.find(lruList.back()));
+    }
+
+    lruList.push_front(key);
+    CacheEntry &entry = entries[key];
+    entry.graphVersion = graphVersion;
+    entry.result = result;
+    entry.lruPosition = lruList.begin();
+    return true;
+}
+
+void AnalyticsResultCache::setCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    AnalyticsResultCache::capacity = capacity;
+    while (entries.size() > capacity) {
+        erase(entries.find(lruList.back()));
+    }
+}
+
+size_t AnalyticsResultCache::size() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return entries.size();
+}
+
+long AnalyticsResultCache::getHitCount() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return hitCount;
+}
+
+long AnalyticsResultCache::getMissCount() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return missCount;
+}
+
+double AnalyticsResultCache::getHitRate() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    long lookups = hitCount + missCount;
+    return lookups == 0 ? 0.0 : static_cast<double>(hitCount) / lookups;
+}
+
+void AnalyticsResultCache::clear() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    entries.clear();
+    lruList.clear();
+    // Stream handlers may hold the counters, reset them instead of dropping them
+    std::lock_guard<std::mutex> versionsLock(versionsMutex);
+    for (auto &version : graphVersions) {
+        version.second = 0;
+    }
+    hitCount = 0;
+    missCount = 0;
+}
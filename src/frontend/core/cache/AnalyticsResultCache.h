@@ -0,0 +1,88 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_ANALYTICSRESULTCACHE_H
+#define JASMINEGRAPH_ANALYTICSRESULTCACHE_H
+
+#include <atomic>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Master side cache of analytics results keyed by (graph id, algorithm, parameters, graph version).
+ * Every graph has a version counter that is bumped whenever the graph changes (upload, streamed edges,
+ * removal). Results are stored together with the version they were computed against, so a bump makes all
+ * older results of the graph unreachable without having to walk the cache. Stale and least recently used
+ * entries are dropped lazily. The version counters are atomic and live as long as the process, so the stream
+ * handlers keep them and bump them on every edge without taking a lock.
+ */
+class AnalyticsResultCache {
+ public:
+    static const size_t DEFAULT_CAPACITY;
+
+    static long getGraphVersion(const std::string &graphId);
+
+    // Invalidate every cached result of the graph. Returns the new version.
+    static long bumpGraphVersion(const std::string &graphId);
+
+    // The version counter of the graph. The reference stays valid, incrementing it invalidates the results.
+    static std::atomic<long> &getVersionCounter(const std::string &graphId);
+
+    static bool get(const std::string &graphId, const std::string &algorithm, const std::string &parameters,
+                    std::string &result);
+
+    /**
+     * Store a result computed against graphVersion. The result is dropped if the graph changed while it was
+     * being computed, i.e. graphVersion is no longer the current version of the graph.
+     */
+    static bool put(const std::string &graphId, const std::string &algorithm, const std::string &parameters,
+                    long graphVersion, const std::string &result);
+
+    static void setCapacity(size_t capacity);
+
+    static size_t size();
+
+    static long getHitCount();
+
+    static long getMissCount();
+
+    static double getHitRate();
+
+    static void clear();
+
+ private:
+    struct CacheEntry {
+        long graphVersion;
+        std::string result;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    static std::string makeKey(const std::string &graphId, const std::string &algorithm,
+                               const std::string &parameters);
+
+    static void erase(std::unordered_map<std::string, CacheEntry>::iterator entry);
+
+    static std::mutex cacheMutex;
+    static std::mutex versionsMutex;  // Guards the map, not the counters
+    static std::map<std::string, std::atomic<long>> graphVersions;
+    static std::unordered_map<std::string, CacheEntry> entries;
+    static std::list<std::string> lruList;  // Most recently used key at the front
+    static size_t capacity;
+    static long hitCount;
+    static long missCount;
+};
+
+#endif  // JASMINEGRAPH_ANALYTICSRESULTCACHE_H
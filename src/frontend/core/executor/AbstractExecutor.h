@@ -31,6 +31,7 @@ class AbstractExecutor {
  public:
     AbstractExecutor();
     AbstractExecutor(JobRequest jobRequest);
+    virtual ~AbstractExecutor() {}
     static std::vector<std::vector<string>> getCombinations(std::vector<string> inputVector);
     virtual void execute() = 0;
     static int collectPerformaceData(PerformanceSQLiteDBInterface *perDB, std::string graphId,
@@ -0,0 +1,222 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "AggregationPlanner.h"
+
+#include <algorithm>
+
+#include "../../../../util/Utils.h"
+#include "../../../../util/logger/Logger.h"
+
+Logger aggregation_planner_logger;
+
+constexpr double AggregationPlanner::DEFAULT_TRANSFER_BYTES_PER_MS;
+constexpr double AggregationPlanner::DEFAULT_EDGES_PER_MS;
+
+static long toLong(const std::string &value) { return Utils::is_number(value) ? std::stol(value) : 0; }
+
+void AggregationPlanner::addWorker(const std::string &workerId, long centralEdgeCount) {
+    centralEdgeCounts[workerId] += centralEdgeCount;
+}
+
+void AggregationPlanner::setCpuUsage(const std::string &workerId, double cpuUsage) { cpuUsages[workerId] = cpuUsage; }
+
+void AggregationPlanner::setTransferRate(const std::string &workerId, double bytesPerMs) {
+    if (bytesPerMs > 0) transferRates[workerId] = bytesPerMs;
+}
+
+void AggregationPlanner::setThroughput(const std::string &workerId, double edgesPerMs) {
+    if (edgesPerMs > 0) throughputs[workerId] = edgesPerMs;
+}
+
+void AggregationPlanner::addAvailableCopy(const std::string &aggregatorId, const std::string &workerId) {
+    availableCopies.insert(std::make_pair(aggregatorId, workerId));
+}
+
+bool AggregationPlanner::hasCopy(const std::string &aggregatorId, const std::string &workerId) const {
+    return aggregatorId == workerId || availableCopies.count(std::make_pair(aggregatorId, workerId)) > 0;
+}
+
+double AggregationPlanner::getOrDefault(const std::map<std::string, double> &values, const std::string &workerId,
+                                        double defaultValue) const {
+    // CPU usage, transfer rate and throughput belong to the worker of a central store
+    auto it = values.find(workerId);
+    if (it == values.end()) {
+        it = values.find(getWorkerId(workerId));
+    }
+    return it == values.end() ? defaultValue : it->second;
+}
+
+void AggregationPlanner::probeCopies(const std::vector<std::string> &workerCombination) {
+    if (!copyProbe) {
+        return;
+    }
+    std::vector<std::pair<std::string, std::string>> pairs;
+    for (auto &aggregatorId : workerCombination) {
+        for (auto &workerId : workerCombination) {
+            std::pair<std::string, std::string> copy = std::make_pair(aggregatorId, workerId);
+            if (!hasCopy(aggregatorId, workerId) && probedCopies.insert(copy).second) {
+                pairs.push_back(copy);
+            }
+        }
+    }
+    if (pairs.empty()) {
+        return;
+    }
+    std::vector<bool> available = copyProbe(pairs);
+    for (size_t i = 0; i < pairs.size() && i < available.size(); i++) {
+        if (available[i]) {
+            addAvailableCopy(pairs[i].first, pairs[i].second);
+        }
+    }
+}
+
+AggregationTask AggregationPlanner::estimate(const std::vector<std::string> &workerCombination,
+                                             const std::string &aggregatorId) {
+    AggregationTask task;
+    task.workerCombination = workerCombination;
+    task.aggregatorId = aggregatorId;
+
+    for (auto &workerId : workerCombination) {
+        long edges = centralEdgeCounts[workerId];
+        task.centralEdgeCount += edges;
+        if (!hasCopy(aggregatorId, workerId)) {
+            task.transferWorkers.push_back(workerId);
+            task.bytesToMove += edges * BYTES_PER_CENTRAL_EDGE;
+        }
+    }
+
+    double transferTime = task.bytesToMove / getOrDefault(transferRates, aggregatorId, DEFAULT_TRANSFER_BYTES_PER_MS);
+    double countTime = task.centralEdgeCount / getOrDefault(throughputs, aggregatorId, DEFAULT_EDGES_PER_MS);
+    // Counting competes with whatever else runs on the worker, the copy is mostly bound by the network
+    double cpuUsage = std::max(0.0, getOrDefault(cpuUsages, aggregatorId, 0));
+    task.estimatedCost = transferTime + countTime * (1 + cpuUsage / 100);
+    return task;
+}
+
+std::vector<AggregationTask> AggregationPlanner::plan(const std::vector<std::vector<std::string>> &workerCombinations) {
+    std::vector<std::pair<long, size_t>> order;
+    for (size_t i = 0; i < workerCombinations.size(); i++) {
+        long edges = 0;
+        for (auto &workerId : workerCombinations[i]) {
+            edges += centralEdgeCounts[workerId];
+        }
+        order.push_back(std::make_pair(-edges, i));
+    }
+    // Largest combinations first so that the small ones fill in the gaps between aggregators
+    std::sort(order.begin(), order.end());
+
+    std::map<std::string, double> assignedCost;
+    std::vector<AggregationTask> tasks;
+    for (auto &entry : order) {
+        const std::vector<std::string> &workerCombination = workerCombinations[entry.second];
+        probeCopies(workerCombination);
+        AggregationTask bestTask;
+        double bestFinishTime = -1;
+
+        for (auto &aggregatorId : workerCombination) {
+            AggregationTask task = estimate(workerCombination, aggregatorId);
+            double finishTime = assignedCost[aggregatorId] + task.estimatedCost;
+            if (bestFinishTime < 0 || finishTime < bestFinishTime) {
+                bestFinishTime = finishTime;
+                bestTask = task;
+            }
+        }
+        if (bestFinishTime < 0) {
+            continue;
+        }
+
+        assignedCost[bestTask.aggregatorId] = bestFinishTime;
+        // Copies made for this combination stay on the aggregator and are reused by later ones
+        for (auto &workerId : bestTask.transferWorkers) {
+            addAvailableCopy(bestTask.aggregatorId, workerId);
+        }
+        tasks.push_back(bestTask);
+    }
+
+    for (auto &cost : assignedCost) {
+        aggregation_planner_logger.info("Aggregator " + cost.first + " estimated busy time " +
+                                        std::to_string(static_cast<long>(cost.second)) + " ms");
+    }
+    return tasks;
+}
+
+AggregationPlanner AggregationPlanner::load(SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfDb,
+                                            std::string graphId) {
+    AggregationPlanner planner;
+
+    std::vector<std::vector<std::pair<std::string, std::string>>> partitionData = sqlite->runSelect(
+        "SELECT worker_has_partition.worker_idworker, partition.idpartition, partition.central_edgecount "
+        "FROM worker_has_partition INNER JOIN partition "
+        "ON worker_has_partition.partition_idpartition = partition.idpartition "
+        "AND worker_has_partition.partition_graph_idgraph = partition.graph_idgraph "
+        "WHERE partition.graph_idgraph = " + graphId + ";");
+    for (auto &row : partitionData) {
+        planner.addWorker(getStoreId(row.at(0).second, row.at(1).second), toLong(row.at(2).second));
+    }
+
+    std::map<std::string, std::string> placeWorkers;
+    std::vector<std::vector<std::pair<std::string, std::string>>> workerData =
+        sqlite->runSelect("SELECT idworker, ip, server_port FROM worker;");
+    for (auto &row : workerData) {
+        placeWorkers[row.at(1).second + ":" + row.at(2).second] = row.at(0).second;
+    }
+
+    if (perfDb == NULL) {
+        return planner;
+    }
+
+    // Rows are ordered by insertion so the most recent CPU usage of a place wins
+    std::vector<std::vector<std::pair<std::string, std::string>>> usageData = perfDb->runSelect(
+        "SELECT place.ip, place.server_port, place_performance_data.cpu_usage "
+        "FROM place_performance_data INNER JOIN place ON place_performance_data.idplace = place.idplace "
+        "ORDER BY place_performance_data.id;");
+    for (auto &row : usageData) {
+        auto placeWorker = placeWorkers.find(row.at(0).second + ":" + row.at(1).second);
+        if (placeWorker != placeWorkers.end() && row.at(2).second != "NULL") {
+            planner.setCpuUsage(placeWorker->second, atof(row.at(2).second.c_str()));
+        }
+    }
+
+    std::vector<std::vector<std::pair<std::string, std::string>>> historyData = perfDb->runSelect(
+        "SELECT aggregator_id, SUM(bytes_moved), SUM(transfer_time), SUM(central_edgecount), "
+        "SUM(elapsed_time - transfer_time) FROM aggregation_performance GROUP BY aggregator_id;");
+    for (auto &row : historyData) {
+        double bytesMoved = atof(row.at(1).second.c_str());
+        double transferTime = atof(row.at(2).second.c_str());
+        double edges = atof(row.at(3).second.c_str());
+        double countTime = atof(row.at(4).second.c_str());
+        if (transferTime > 0) planner.setTransferRate(row.at(0).second, bytesMoved / transferTime);
+        if (countTime > 0) planner.setThroughput(row.at(0).second, edges / countTime);
+    }
+    return planner;
+}
+
+void AggregationPlanner::recordExecution(PerformanceSQLiteDBInterface *perfDb, std::string graphId,
+                                         const AggregationTask &task, long transferTime, long elapsedTime) {
+    if (perfDb == NULL) {
+        return;
+    }
+    std::string combination;
+    for (auto &workerId : task.workerCombination) {
+        combination += (combination.empty() ? "" : ",") + workerId;
+    }
+    // The history is kept per worker, the combination lists the central stores
+    perfDb->runInsert(
+        "INSERT INTO aggregation_performance (graph_id, aggregator_id, combination, central_edgecount, "
+        "bytes_moved, transfer_time, elapsed_time, estimated_time) VALUES ('" +
+        graphId + "','" + getWorkerId(task.aggregatorId) + "','" + combination + "'," +
+        std::to_string(task.centralEdgeCount) + "," + std::to_string(task.bytesToMove) + "," +
+        std::to_string(transferTime) + "," + std::to_string(elapsedTime) + "," +
+        std::to_string(static_cast<long>(task.estimatedCost)) + ")");
+}
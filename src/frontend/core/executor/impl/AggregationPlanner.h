@@ -0,0 +1,108 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_AGGREGATIONPLANNER_H
+#define JASMINEGRAPH_AGGREGATIONPLANNER_H
+
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../../../metadb/SQLiteDBInterface.h"
+#include "../../../../performancedb/PerformanceSQLiteDBInterface.h"
+
+struct AggregationTask {
+    std::vector<std::string> workerCombination;
+    std::string aggregatorId;
+    std::vector<std::string> transferWorkers;  // Workers whose central store has to be copied to the aggregator
+    long bytesToMove = 0;
+    long centralEdgeCount = 0;  // Central edges of all the workers in the combination
+    double estimatedCost = 0;   // Estimated milliseconds to copy and count the combination
+};
+
+/**
+ * Chooses the aggregator of every central store worker combination for triangle counting. The cost of running a
+ * combination on one of its workers is the time to copy the central stores the worker does not hold yet plus the
+ * time to count the combination, scaled by the current CPU usage of the worker. Combinations are assigned largest
+ * first to the worker that would finish them earliest, which spreads them over several aggregators that then run
+ * in parallel. Transfer rates and counting throughput are learnt from the aggregation_performance table.
+ *
+ * A worker can hold several partitions of a graph, so the planned "workers" are central stores: the id of a
+ * partition on a worker, see getStoreId(). Whether an aggregator already holds a copy of a central store is asked
+ * from the copy probe, only for the pairs of the combinations being planned and only once per pair.
+ */
+class AggregationPlanner {
+ public:
+    // Tells for every (aggregator, central store) pair whether the aggregator already holds a copy of the store
+    typedef std::function<std::vector<bool>(const std::vector<std::pair<std::string, std::string>> &)> CopyProbe;
+
+    static const long BYTES_PER_CENTRAL_EDGE = 2 * sizeof(long);
+    // Used until a worker has aggregation history
+    static constexpr double DEFAULT_TRANSFER_BYTES_PER_MS = 50 * 1024;
+    static constexpr double DEFAULT_EDGES_PER_MS = 1000;
+
+    void addWorker(const std::string &workerId, long centralEdgeCount);
+
+    // CPU usage of the worker in percent
+    void setCpuUsage(const std::string &workerId, double cpuUsage);
+
+    void setTransferRate(const std::string &workerId, double bytesPerMs);
+
+    void setThroughput(const std::string &workerId, double edgesPerMs);
+
+    // Record that the aggregator already holds a copy of the central store of the worker
+    void addAvailableCopy(const std::string &aggregatorId, const std::string &workerId);
+
+    void setCopyProbe(CopyProbe copyProbe) { this->copyProbe = copyProbe; }
+
+    bool hasCopy(const std::string &aggregatorId, const std::string &workerId) const;
+
+    std::vector<AggregationTask> plan(const std::vector<std::vector<std::string>> &workerCombinations);
+
+    // Load central store sizes, CPU usage and aggregation history of the workers of a graph
+    static AggregationPlanner load(SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfDb,
+                                   std::string graphId);
+
+    static void recordExecution(PerformanceSQLiteDBInterface *perfDb, std::string graphId,
+                                const AggregationTask &task, long transferTime, long elapsedTime);
+
+    // Id of the central store of a partition held by a worker
+    static std::string getStoreId(const std::string &workerId, const std::string &partitionId) {
+        return workerId + "_" + partitionId;
+    }
+
+    // The worker of a central store id, ids without a partition are worker ids
+    static std::string getWorkerId(const std::string &storeId) { return storeId.substr(0, storeId.find('_')); }
+
+ private:
+    // Probe the copies the aggregators of the combination may hold that are not known yet
+    void probeCopies(const std::vector<std::string> &workerCombination);
+
+    AggregationTask estimate(const std::vector<std::string> &workerCombination, const std::string &aggregatorId);
+
+    double getOrDefault(const std::map<std::string, double> &values, const std::string &workerId,
+                        double defaultValue) const;
+
+    std::map<std::string, long> centralEdgeCounts;
+    std::map<std::string, double> cpuUsages;
+    std::map<std::string, double> transferRates;
+    std::map<std::string, double> throughputs;
+    std::set<std::pair<std::string, std::string>> availableCopies;
+    std::set<std::pair<std::string, std::string>> probedCopies;
+    CopyProbe copyProbe;
+};
+
+#endif  // JASMINEGRAPH_AGGREGATIONPLANNER_H
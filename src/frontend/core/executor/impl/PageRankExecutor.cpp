@@ -32,7 +32,6 @@ void PageRankExecutor::execute() {
     std::string masterIP = request.getMasterIP();
     std::string graphId = request.getParameter(Conts::PARAM_KEYS::GRAPH_ID);
     std::string canCalibrateString = request.getParameter(Conts::PARAM_KEYS::CAN_CALIBRATE);
-    std::string queueTime = request.getParameter(Conts::PARAM_KEYS::QUEUE_TIME);
     std::string graphSLAString = request.getParameter(Conts::PARAM_KEYS::GRAPH_SLA);
     std::string alphaString = request.getParameter(Conts::PARAM_KEYS::ALPHA);
     std::string iterationString = request.getParameter(Conts::PARAM_KEYS::ITERATION);
@@ -61,16 +60,8 @@ void PageRankExecutor::execute() {
     processInformation.priority = threadPriority;
     processInformation.startTimestamp = startTime.count();
 
-    if (!queueTime.empty()) {
-        long sleepTime = atol(queueTime.c_str());
-        processInformation.sleepTime = sleepTime;
-        processData.insert(processInformation);
-        processStatusMutex.unlock();
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleepTime));
-    } else {
-        processData.insert(processInformation);
-        processStatusMutex.unlock();
-    }
+    processData.insert(processInformation);
+    processStatusMutex.unlock();
 
     pageRank_logger.log(
             "###PAGERANK-EXECUTOR### Started with graph ID : " + graphId + " Master IP : " + masterIP, "info");
@@ -156,11 +147,8 @@ void PageRankExecutor::execute() {
     workerResponded = true;
     JobResponse jobResponse;
     jobResponse.setJobId(request.getJobId());
-    responseVector.push_back(jobResponse);
 
-    responseVectorMutex.lock();
-    responseMap[request.getJobId()] = jobResponse;
-    responseVectorMutex.unlock();
+    JobScheduler::publishResponse(request, jobResponse);
 
     auto end = chrono::high_resolution_clock::now();
     auto dur = end - begin;
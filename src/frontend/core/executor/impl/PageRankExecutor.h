@@ -16,6 +16,7 @@ limitations under the License.
 
 
 #include "../AbstractExecutor.h"
+#include "../../scheduler/JobScheduler.h"
 #include "../../../../server/JasmineGraphInstanceProtocol.h"
 #include "../../../JasmineGraphFrontEndProtocol.h"
 #include "../../../../performance/metrics/PerformanceUtil.h"
@@ -51,6 +51,13 @@ void StreamingTriangleCountExecutor::execute() {
     std::vector<std::future<long>> intermRes;
     long result = 0;
 
+    // The watermarks are missing for a graph that was never counted or whose native store was compacted since
+    if (mode == "1" && !streamingDB.hasTriangleCountWatermarks(graphId, partitionCount, partitionCount > 2)) {
+        streaming_triangleCount_logger.info("###STREAMING-TRIANGLE-COUNT-EXECUTOR### No watermarks of graph " +
+                                            graphId + ", counting all triangles");
+        mode = "0";
+    }
+
     if (partitionCount > 2) {
         long aggregatedTriangleCount = StreamingTriangleCountExecutor::aggregateCentralStoreTriangles(
                 sqlite, streamingDB, graphId, masterIP, mode, partitionCount);
@@ -91,9 +98,8 @@ void StreamingTriangleCountExecutor::execute() {
     JobResponse jobResponse;
     jobResponse.setJobId(request.getJobId());
     jobResponse.addParameter(Conts::PARAM_KEYS::STREAMING_TRIANGLE_COUNT, std::to_string(result));
-    responseVector.push_back(jobResponse);
 
-    responseMap[request.getJobId()] = jobResponse;
+    JobScheduler::publishResponse(request, jobResponse);
 }
 
 long StreamingTriangleCountExecutor::getTriangleCount(int graphId, std::string host, int port,
@@ -282,7 +288,6 @@ long StreamingTriangleCountExecutor::aggregateCentralStoreTriangles(
     std::map<string, int> workerWeightMap;
     std::vector<std::vector<string>>::iterator workerCombinationsIterator;
     std::vector<std::future<string>> triangleCountResponse;
-    std::string result = "";
     long aggregatedTriangleCount = 0;
 
     for (workerCombinationsIterator = workerCombinations.begin();
@@ -359,20 +364,9 @@ long StreamingTriangleCountExecutor::aggregateCentralStoreTriangles(
                 graphId, masterIP, 5, runMode));
     }
 
+    TriangleSet uniqueTriangleSet;
     for (auto &&futureCall : triangleCountResponse) {
-        result = result + ":" + futureCall.get();
-    }
-
-    std::vector<std::string> triangles = Utils::split(result, ':');
-    std::vector<std::string>::iterator triangleIterator;
-    std::set<std::string> uniqueTriangleSet;
-
-    for (triangleIterator = triangles.begin(); triangleIterator != triangles.end(); ++triangleIterator) {
-        std::string triangle = *triangleIterator;
-
-        if (!triangle.empty() && triangle != "NILL") {
-            uniqueTriangleSet.insert(triangle);
-        }
+        uniqueTriangleSet.insertAll(futureCall.get());
     }
 
     aggregatedTriangleCount = uniqueTriangleSet.size();
@@ -22,9 +22,11 @@ limitations under the License.
 #include "../../../../performancedb/PerformanceSQLiteDBInterface.h"
 #include "../../../../server/JasmineGraphInstanceProtocol.h"
 #include "../../../../query/algorithms/triangles/StreamingTriangles.h"
+#include "../../../../query/algorithms/triangles/TriangleSet.h"
 #include "../../../../server/JasmineGraphServer.h"
 #include "../../../JasmineGraphFrontEndProtocol.h"
 #include "../../CoreConstants.h"
+#include "../../scheduler/JobScheduler.h"
 #include "../AbstractExecutor.h"
 
 class StreamingTriangleCountExecutor : public AbstractExecutor{
@@ -13,12 +13,15 @@ limitations under the License.
 
 #include "TriangleCountExecutor.h"
 
+#include "../../../../performance/trace/Tracer.h"
+#include "../../scheduler/CostModel.h"
+
 using namespace std::chrono;
 
 Logger triangleCount_logger;
 std::vector<std::vector<string>> TriangleCountExecutor::fileCombinations;
 std::map<std::string, std::string> TriangleCountExecutor::combinationWorkerMap;
-std::map<long, std::map<long, std::vector<long>>> TriangleCountExecutor::triangleTree;
+TriangleSet TriangleCountExecutor::triangleSet;
 bool isStatCollect = false;
 
 std::mutex fileCombinationMutex;
@@ -39,7 +42,6 @@ void TriangleCountExecutor::execute() {
     std::string masterIP = request.getMasterIP();
     std::string graphId = request.getParameter(Conts::PARAM_KEYS::GRAPH_ID);
     std::string canCalibrateString = request.getParameter(Conts::PARAM_KEYS::CAN_CALIBRATE);
-    std::string queueTime = request.getParameter(Conts::PARAM_KEYS::QUEUE_TIME);
     std::string graphSLAString = request.getParameter(Conts::PARAM_KEYS::GRAPH_SLA);
 
     bool canCalibrate = Utils::parseBoolean(canCalibrateString);
@@ -65,16 +67,9 @@ void TriangleCountExecutor::execute() {
     processInformation.priority = threadPriority;
     processInformation.startTimestamp = startTime.count();
 
-    if (!queueTime.empty()) {
-        long sleepTime = atol(queueTime.c_str());
-        processInformation.sleepTime = sleepTime;
-        processData.insert(processInformation);
-        processStatusMutex.unlock();
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleepTime));
-    } else {
-        processData.insert(processInformation);
-        processStatusMutex.unlock();
-    }
+    // High priority jobs that have to wait for their SLA are held back by the scheduler before they get here
+    processData.insert(processInformation);
+    processStatusMutex.unlock();
 
     triangleCount_logger.log(
         "###TRIANGLE-COUNT-EXECUTOR### Started with graph ID : " + graphId + " Master IP : " + masterIP, "info");
@@ -86,6 +81,7 @@ void TriangleCountExecutor::execute() {
     int workerListSize = workerList.size();
     int partitionCount = 0;
     std::vector<std::future<long>> intermRes;
+    std::vector<std::pair<std::string, std::string>> intermPartitions;  // Worker and partition of every future
     std::vector<std::future<int>> statResponse;
     std::vector<std::future<string>> remoteCopyRes;
     PlacesToNodeMapper placesToNodeMapper;
@@ -94,15 +90,32 @@ void TriangleCountExecutor::execute() {
 
     auto begin = chrono::high_resolution_clock::now();
 
-    string sqlStatement =
-        "SELECT worker_idworker, name,ip,user,server_port,server_data_port,partition_idpartition "
+    TraceSpan partitionLookupSpan("executor.sqlite_lookup", "partitions");
+    PreparedStatement partitionStatement = sqlite->prepare(
+        "SELECT worker_idworker, ip, partition_idpartition "
         "FROM worker_has_partition INNER JOIN worker ON worker_has_partition.worker_idworker=worker.idworker "
-        "WHERE partition_graph_idgraph=" +
-        graphId + ";";
+        "WHERE partition_graph_idgraph=?;");
+    partitionStatement.bind(1, graphId);
 
-    std::vector<vector<pair<string, string>>> results = sqlite->runSelect(sqlStatement);
+    std::map<string, std::vector<string>> partitionMap;
+    int partitionRowCount = 0;
+    while (partitionStatement.next()) {
+        partitionRowCount++;
+        string workerID = partitionStatement.getString(0);
+        string partitionId = partitionStatement.getString(2);
+        partitionMap[workerID].push_back(partitionId);
+
+        triangleCount_logger.log("###TRIANGLE-COUNT-EXECUTOR### Getting Triangle Count : Host " +
+                                     partitionStatement.getString(1) + " PartitionId " + partitionId,
+                                 "info");
+    }
 
-    if (results.size() > Conts::COMPOSITE_CENTRAL_STORE_WORKER_THRESHOLD) {
+    GraphStatistics graphStatistics = CostModel::loadGraphStatistics(sqlite, graphId);
+    partitionLookupSpan.end();
+    // Filled in by the futures, so it must not be resized while they run
+    std::vector<long> kernelTimes(partitionRowCount, 0);
+
+    if (partitionRowCount > Conts::COMPOSITE_CENTRAL_STORE_WORKER_THRESHOLD) {
         isCompositeAggregation = true;
     }
 
@@ -125,33 +138,6 @@ void TriangleCountExecutor::execute() {
         fileCombinations = getCombinations(compositeCentralStoreFiles);
     }
 
-    std::map<string, std::vector<string>> partitionMap;
-
-    for (std::vector<vector<pair<string, string>>>::iterator i = results.begin(); i != results.end(); ++i) {
-        std::vector<pair<string, string>> rowData = *i;
-
-        string workerID = rowData.at(0).second;
-        string name = rowData.at(1).second;
-        string host = rowData.at(2).second;
-        string user = rowData.at(3).second;
-        string serverPort = rowData.at(4).second;
-        string serverDataPort = rowData.at(5).second;
-        string partitionId = rowData.at(6).second;
-
-        if (partitionMap.find(workerID) == partitionMap.end()) {
-            std::vector<string> partitionVec;
-            partitionVec.push_back(partitionId);
-            partitionMap.insert(std::pair<string, std::vector<string>>(workerID, partitionVec));
-        } else {
-            std::vector<string> partitionVec = partitionMap.find(workerID)->second;
-            partitionVec.push_back(partitionId);
-        }
-
-        triangleCount_logger.log("###TRIANGLE-COUNT-EXECUTOR### Getting Triangle Count : Host " + host +
-                                     " Server Port " + serverPort + " PartitionId " + partitionId,
-                                 "info");
-    }
-
     for (auto &&futureCall : remoteCopyRes) {
         futureCall.wait();
     }
@@ -172,27 +158,37 @@ void TriangleCountExecutor::execute() {
             int workerDataPort = atoi(string(currentWorker.dataPort).c_str());
 
             partitionId = *partitionIterator;
-            intermRes.push_back(std::async(
-                std::launch::async, TriangleCountExecutor::getTriangleCount, atoi(graphId.c_str()), host, workerPort,
-                workerDataPort, atoi(partitionId.c_str()), masterIP, uniqueId, isCompositeAggregation, threadPriority));
+            long *kernelTime = &kernelTimes.at(intermRes.size());
+            auto countPartition = [=]() {
+                auto kernelBegin = chrono::steady_clock::now();
+                long count = TriangleCountExecutor::getTriangleCount(
+                    atoi(graphId.c_str()), host, workerPort, workerDataPort, atoi(partitionId.c_str()), masterIP,
+                    uniqueId, isCompositeAggregation, threadPriority);
+                *kernelTime = duration_cast<milliseconds>(chrono::steady_clock::now() - kernelBegin).count();
+                return count;
+            };
+            intermRes.push_back(std::async(std::launch::async, traced(countPartition)));
+            intermPartitions.push_back(std::make_pair(workerID, partitionId));
         }
     }
 
     PerformanceUtil::init();
 
-    std::string query =
-        "SELECT attempt from graph_sla INNER JOIN sla_category where graph_sla.id_sla_category=sla_category.id and "
-        "graph_sla.graph_id='" +
-        graphId + "' and graph_sla.partition_count='" + std::to_string(partitionCount) +
-        "' and sla_category.category='" + Conts::SLA_CATEGORY::LATENCY +
-    "' and sla_category.command='" + TRIANGLES + "';";
-
-    std::vector<vector<pair<string, string>>> queryResults = perfDB->runSelect(query);
-
-    if (queryResults.size() > 0) {
-        std::string attemptString = queryResults[0][0].second;
-        int calibratedAttempts = atoi(attemptString.c_str());
+    int calibratedAttempts = -1;
+    {
+        TraceSpan attemptLookupSpan("executor.sqlite_lookup", "sla attempts");
+        PreparedStatement attemptStatement = perfDB->prepare(
+            "SELECT attempt from graph_sla INNER JOIN sla_category where graph_sla.id_sla_category=sla_category.id "
+            "and graph_sla.graph_id=? and graph_sla.partition_count=? and sla_category.category=? and "
+            "sla_category.command=?;");
+        attemptStatement.bind(1, graphId).bind(2, partitionCount).bind(3, Conts::SLA_CATEGORY::LATENCY);
+        attemptStatement.bind(4, TRIANGLES);
+        if (attemptStatement.next()) {
+            calibratedAttempts = attemptStatement.getInt(0);
+        }
+    }
 
+    if (calibratedAttempts >= 0) {
         if (calibratedAttempts >= Conts::MAX_SLA_CALIBRATE_ATTEMPTS) {
             canCalibrate = false;
         }
@@ -208,10 +204,19 @@ void TriangleCountExecutor::execute() {
     for (auto &&futureCall : intermRes) {
         result += futureCall.get();
     }
+    for (size_t i = 0; i < intermPartitions.size(); i++) {
+        const PartitionStatistics *partition =
+            graphStatistics.getPartition(intermPartitions[i].first, intermPartitions[i].second);
+        if (partition != NULL) {
+            CostModel::recordKernelExecution(perfDB, TRIANGLES, graphId, *partition, kernelTimes[i]);
+        }
+    }
 
     if (!isCompositeAggregation) {
+        TraceSpan aggregationSpan("executor.central_store_aggregation", graphId);
         long aggregatedTriangleCount =
-            TriangleCountExecutor::aggregateCentralStoreTriangles(sqlite, graphId, masterIP, threadPriority);
+            TriangleCountExecutor::aggregateCentralStoreTriangles(sqlite, perfDB, graphId, masterIP, threadPriority);
+        aggregationSpan.end();
         result += aggregatedTriangleCount;
         workerResponded = true;
         triangleCount_logger.log(
@@ -223,11 +228,8 @@ void TriangleCountExecutor::execute() {
     JobResponse jobResponse;
     jobResponse.setJobId(request.getJobId());
     jobResponse.addParameter(Conts::PARAM_KEYS::TRIANGLE_COUNT, std::to_string(result));
-    responseVector.push_back(jobResponse);
 
-    responseVectorMutex.lock();
-    responseMap[request.getJobId()] = jobResponse;
-    responseVectorMutex.unlock();
+    JobScheduler::publishResponse(request, jobResponse);
 
     auto end = chrono::high_resolution_clock::now();
     auto dur = end - begin;
@@ -254,13 +256,18 @@ void TriangleCountExecutor::execute() {
     }
     processStatusMutex.unlock();
 
-    triangleTree.clear();
+    triangleTreeMutex.lock();
+    triangleSet.clear();
+    triangleTreeMutex.unlock();
     combinationWorkerMap.clear();
 }
 
 long TriangleCountExecutor::getTriangleCount(int graphId, std::string host, int port, int dataPort, int partitionId,
                                              std::string masterIP, int uniqueId, bool isCompositeAggregation,
                                              int threadPriority) {
+    TraceSpan workerSpan("executor.worker_triangles",
+                         host + ":" + std::to_string(port) + " partition " + std::to_string(partitionId));
+    TraceSpan handshakeSpan("executor.handshake", host);
     int sockfd;
     char data[301];
     bool loop = false;
@@ -330,6 +337,8 @@ long TriangleCountExecutor::getTriangleCount(int graphId, std::string host, int
         } else {
             triangleCount_logger.log("Received : " + response, "error");
         }
+        handshakeSpan.end();
+        Tracer::sendTraceId(sockfd);
         result_wr = write(sockfd, JasmineGraphInstanceProtocol::TRIANGLES.c_str(),
                           JasmineGraphInstanceProtocol::TRIANGLES.size());
 
@@ -490,17 +499,11 @@ long TriangleCountExecutor::getTriangleCount(int graphId, std::string host, int
                         }
                     }
 
-                    std::string compositeTriangles =
-                        countCompositeCentralStoreTriangles(host, std::to_string(port), adjustedTransferredFile,
-                                                            masterIP, adjustedAvailableFiles, threadPriority);
+                    triangleCount += countCompositeCentralStoreTriangles(
+                        host, std::to_string(port), adjustedTransferredFile, masterIP, adjustedAvailableFiles,
+                        threadPriority, triangleSet, triangleTreeMutex);
 
                     triangleCount_logger.log("###COMPOSITE### Retrieved Composite triangle list ", "debug");
-
-                    std::vector<std::string> triangles = Utils::split(compositeTriangles, ':');
-
-                    if (triangles.size() > 0) {
-                        triangleCount += updateTriangleTreeAndGetTriangleCount(triangles);
-                    }
                 }
                 updateMap(partitionId);
             }
@@ -566,182 +569,124 @@ void TriangleCountExecutor::updateMap(int partitionId) {
                              "info");
 }
 
-int TriangleCountExecutor::updateTriangleTreeAndGetTriangleCount(std::vector<std::string> triangles) {
-    const std::lock_guard<std::mutex> lock1(triangleTreeMutex);
-    std::vector<std::string>::iterator triangleIterator;
-    int aggregateCount = 0;
-
-    triangleCount_logger.log("###COMPOSITE### Triangle Tree locked ", "debug");
-
-    for (triangleIterator = triangles.begin(); triangleIterator != triangles.end(); ++triangleIterator) {
-        std::string triangle = *triangleIterator;
-
-        if (!triangle.empty() && triangle != "NILL") {
-            std::vector<std::string> triangleVertexList = Utils::split(triangle, ',');
-
-            long vertexOne = std::atol(triangleVertexList.at(0).c_str());
-            long vertexTwo = std::atol(triangleVertexList.at(1).c_str());
-            long vertexThree = std::atol(triangleVertexList.at(2).c_str());
-
-            std::map<long, std::vector<long>> itemRes = triangleTree[vertexOne];
-
-            std::map<long, std::vector<long>>::iterator itemResIterator = itemRes.find(vertexTwo);
-
-            if (itemResIterator != itemRes.end()) {
-                std::vector<long> list = itemRes[vertexTwo];
-
-                if (std::find(list.begin(), list.end(), vertexThree) == list.end()) {
-                    triangleTree[vertexOne][vertexTwo].push_back(vertexThree);
-                    aggregateCount++;
-                }
-            } else {
-                triangleTree[vertexOne][vertexTwo].push_back(vertexThree);
-                aggregateCount++;
-            }
-        }
-    }
-
-    return aggregateCount;
-}
-
-long TriangleCountExecutor::aggregateCentralStoreTriangles(SQLiteDBInterface *sqlite, std::string graphId,
+long TriangleCountExecutor::aggregateCentralStoreTriangles(SQLiteDBInterface *sqlite,
+                                                           PerformanceSQLiteDBInterface *perfDb, std::string graphId,
                                                            std::string masterIP, int threadPriority) {
     std::vector<std::vector<string>> workerCombinations = getWorkerCombination(sqlite, graphId);
-    std::map<string, int> workerWeightMap;
-    std::vector<std::vector<string>>::iterator workerCombinationsIterator;
-    std::vector<std::future<string>> triangleCountResponse;
-    std::string result = "";
-    long aggregatedTriangleCount = 0;
-
-    for (workerCombinationsIterator = workerCombinations.begin();
-         workerCombinationsIterator != workerCombinations.end(); ++workerCombinationsIterator) {
-        std::vector<string> workerCombination = *workerCombinationsIterator;
-        std::map<string, int>::iterator workerWeightMapIterator;
-        std::vector<std::future<string>> remoteGraphCopyResponse;
-        int minimumWeight = 0;
-        std::string minWeightWorker;
-        string aggregatorHost = "";
-        std::string partitionIdList = "";
-
-        std::vector<string>::iterator workerCombinationIterator;
-        std::vector<string>::iterator aggregatorCopyCombinationIterator;
-
-        for (workerCombinationIterator = workerCombination.begin();
-             workerCombinationIterator != workerCombination.end(); ++workerCombinationIterator) {
-            std::string workerId = *workerCombinationIterator;
+    std::map<std::string, JasmineGraphServer::workerPartition> workers;
+    TriangleSet uniqueTriangleSet;
+    std::mutex uniqueTriangleSetMutex;
 
-            workerWeightMapIterator = workerWeightMap.find(workerId);
-
-            if (workerWeightMapIterator != workerWeightMap.end()) {
-                int weight = workerWeightMap.at(workerId);
-
-                if (minimumWeight == 0 || minimumWeight > weight) {
-                    minimumWeight = weight + 1;
-                    minWeightWorker = workerId;
-                }
-            } else {
-                minimumWeight = 1;
-                minWeightWorker = workerId;
-            }
-        }
-
-        string aggregatorSqlStatement =
-            "SELECT ip,user,server_port,server_data_port,partition_idpartition "
-            "FROM worker_has_partition INNER JOIN worker ON worker_has_partition.worker_idworker=worker.idworker "
-            "WHERE partition_graph_idgraph=" +
-            graphId + " and idworker=" + minWeightWorker + ";";
-
-        std::vector<vector<pair<string, string>>> result = sqlite->runSelect(aggregatorSqlStatement);
-
-        vector<pair<string, string>> aggregatorData = result.at(0);
-
-        std::string aggregatorIp = aggregatorData.at(0).second;
-        std::string aggregatorUser = aggregatorData.at(1).second;
-        std::string aggregatorPort = aggregatorData.at(2).second;
-        std::string aggregatorDataPort = aggregatorData.at(3).second;
-        std::string aggregatorPartitionId = aggregatorData.at(4).second;
-
-        if ((aggregatorIp.find("localhost") != std::string::npos) || aggregatorIp == masterIP) {
-            aggregatorHost = aggregatorIp;
+    string workerSqlStatement =
+        "SELECT idworker,ip,user,server_port,server_data_port,partition_idpartition "
+        "FROM worker_has_partition INNER JOIN worker ON worker_has_partition.worker_idworker=worker.idworker "
+        "WHERE partition_graph_idgraph=" +
+        graphId + ";";
+    std::vector<vector<pair<string, string>>> workerData = sqlite->runSelect(workerSqlStatement);
+
+    // A worker can hold several partitions of the graph, each with its own central store
+    for (auto &row : workerData) {
+        std::string workerIp = row.at(1).second;
+        JasmineGraphServer::workerPartition worker;
+        if ((workerIp.find("localhost") != std::string::npos) || workerIp == masterIP) {
+            worker.hostname = workerIp;
         } else {
-            aggregatorHost = aggregatorUser + "@" + aggregatorIp;
+            worker.hostname = row.at(2).second + "@" + workerIp;
         }
+        worker.port = atoi(row.at(3).second.c_str());
+        worker.dataPort = atoi(row.at(4).second.c_str());
+        worker.partitionID = row.at(5).second;
+        workers[AggregationPlanner::getStoreId(row.at(0).second, worker.partitionID)] = worker;
+    }
 
-        for (aggregatorCopyCombinationIterator = workerCombination.begin();
-             aggregatorCopyCombinationIterator != workerCombination.end(); ++aggregatorCopyCombinationIterator) {
-            std::string workerId = *aggregatorCopyCombinationIterator;
-            string host = "";
-
-            if (workerId != minWeightWorker) {
-                string sqlStatement =
-                    "SELECT ip,user,server_port,server_data_port,partition_idpartition "
-                    "FROM worker_has_partition INNER JOIN worker ON "
-                    "worker_has_partition.worker_idworker=worker.idworker "
-                    "WHERE partition_graph_idgraph=" +
-                    graphId + " and idworker=" + workerId + ";";
+    AggregationPlanner planner = AggregationPlanner::load(sqlite, perfDb, graphId);
+
+    // Ask the aggregators the planner considers whether they already hold copies of the other central stores
+    planner.setCopyProbe([&](const std::vector<std::pair<std::string, std::string>> &pairs) {
+        std::vector<std::future<string>> copyAvailableResponse;
+        for (auto &pair : pairs) {
+            const JasmineGraphServer::workerPartition &aggregator = workers.at(pair.first);
+            copyAvailableResponse.push_back(std::async(
+                std::launch::async, traced(TriangleCountExecutor::isFileAccessibleToWorker), graphId,
+                workers.at(pair.second).partitionID, aggregator.hostname, std::to_string(aggregator.port), masterIP,
+                JasmineGraphInstanceProtocol::FILE_TYPE_CENTRALSTORE_AGGREGATE, std::string()));
+        }
+        std::vector<bool> available;
+        for (auto &response : copyAvailableResponse) {
+            available.push_back(response.get().compare("true") == 0);
+        }
+        return available;
+    });
 
-                std::vector<vector<pair<string, string>>> result = sqlite->runSelect(sqlStatement);
+    // Combinations of the same aggregator run one after the other, different aggregators run in parallel
+    std::map<std::string, std::vector<AggregationTask>> aggregatorTasks;
+    for (auto &task : planner.plan(workerCombinations)) {
+        aggregatorTasks[task.aggregatorId].push_back(task);
+    }
 
-                vector<pair<string, string>> workerData = result.at(0);
+    std::vector<std::future<std::vector<AggregationResult>>> aggregationResponse;
+    for (auto &tasks : aggregatorTasks) {
+        aggregationResponse.push_back(std::async(
+            std::launch::async, traced(TriangleCountExecutor::runAggregationTasks), tasks.second, std::cref(workers),
+            graphId, masterIP, threadPriority, std::ref(uniqueTriangleSet), std::ref(uniqueTriangleSetMutex)));
+    }
 
-                std::string workerIp = workerData.at(0).second;
-                std::string workerUser = workerData.at(1).second;
-                std::string workerPort = workerData.at(2).second;
-                std::string workerDataPort = workerData.at(3).second;
-                std::string partitionId = workerData.at(4).second;
+    for (auto &&futureCall : aggregationResponse) {
+        for (auto &result : futureCall.get()) {
+            AggregationPlanner::recordExecution(perfDb, graphId, result.task, result.transferTime,
+                                                result.elapsedTime);
+            CostModel::recordAggregation(result.task.centralEdgeCount, result.elapsedTime);
+        }
+    }
 
-                if ((workerIp.find("localhost") != std::string::npos) || workerIp == masterIP) {
-                    host = workerIp;
-                } else {
-                    host = workerUser + "@" + workerIp;
-                }
+    return uniqueTriangleSet.size();
+}
 
-                partitionIdList += partitionId + ",";
+std::vector<TriangleCountExecutor::AggregationResult> TriangleCountExecutor::runAggregationTasks(
+    std::vector<AggregationTask> tasks, const std::map<std::string, JasmineGraphServer::workerPartition> &workers,
+    std::string graphId, std::string masterIP, int threadPriority, TriangleSet &triangleSet,
+    std::mutex &triangleSetMutex) {
+    std::vector<AggregationResult> results;
 
-                std::string centralStoreAvailable = isFileAccessibleToWorker(
-                    graphId, partitionId, aggregatorHost, aggregatorPort, masterIP,
-                    JasmineGraphInstanceProtocol::FILE_TYPE_CENTRALSTORE_AGGREGATE, std::string());
+    for (auto &task : tasks) {
+        const JasmineGraphServer::workerPartition &aggregator = workers.at(task.aggregatorId);
+        auto begin = std::chrono::high_resolution_clock::now();
 
-                if (centralStoreAvailable.compare("false") == 0) {
-                    remoteGraphCopyResponse.push_back(
-                        std::async(std::launch::async, TriangleCountExecutor::copyCentralStoreToAggregator,
-                                   aggregatorHost, aggregatorPort, aggregatorDataPort, atoi(graphId.c_str()),
-                                   atoi(partitionId.c_str()), masterIP));
-                }
-            }
+        std::vector<std::future<string>> remoteGraphCopyResponse;
+        for (auto &workerId : task.transferWorkers) {
+            remoteGraphCopyResponse.push_back(std::async(
+                std::launch::async, traced(TriangleCountExecutor::copyCentralStoreToAggregator), aggregator.hostname,
+                std::to_string(aggregator.port), std::to_string(aggregator.dataPort), atoi(graphId.c_str()),
+                atoi(workers.at(workerId).partitionID.c_str()), masterIP));
         }
-
         for (auto &&futureCallCopy : remoteGraphCopyResponse) {
             futureCallCopy.get();
         }
+        auto transferEnd = std::chrono::high_resolution_clock::now();
 
-        std::string adjustedPartitionIdList = partitionIdList.substr(0, partitionIdList.size() - 1);
-        workerWeightMap[minWeightWorker] = minimumWeight;
-
-        triangleCountResponse.push_back(std::async(
-            std::launch::async, TriangleCountExecutor::countCentralStoreTriangles, aggregatorHost, aggregatorPort,
-            aggregatorHost, aggregatorPartitionId, adjustedPartitionIdList, graphId, masterIP, threadPriority));
-    }
-
-    for (auto &&futureCall : triangleCountResponse) {
-        result = result + ":" + futureCall.get();
-    }
-
-    std::vector<std::string> triangles = Utils::split(result, ':');
-    std::vector<std::string>::iterator triangleIterator;
-    std::set<std::string> uniqueTriangleSet;
-
-    for (triangleIterator = triangles.begin(); triangleIterator != triangles.end(); ++triangleIterator) {
-        std::string triangle = *triangleIterator;
-
-        if (!triangle.empty() && triangle != "NILL") {
-            uniqueTriangleSet.insert(triangle);
+        std::string partitionIdList;
+        for (auto &workerId : task.workerCombination) {
+            if (workerId != task.aggregatorId) {
+                partitionIdList += (partitionIdList.empty() ? "" : ",") + workers.at(workerId).partitionID;
+            }
         }
-    }
 
-    aggregatedTriangleCount = uniqueTriangleSet.size();
-
-    return aggregatedTriangleCount;
+        countCentralStoreTriangles(aggregator.hostname, std::to_string(aggregator.port), aggregator.hostname,
+                                   aggregator.partitionID, partitionIdList, graphId, masterIP, threadPriority,
+                                   triangleSet, triangleSetMutex);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        AggregationResult result;
+        result.task = task;
+        result.transferTime = duration_cast<milliseconds>(transferEnd - begin).count();
+        result.elapsedTime = duration_cast<milliseconds>(end - begin).count();
+        triangleCount_logger.info("Aggregated combination on worker " + task.aggregatorId + " in " +
+                                  std::to_string(result.elapsedTime) + " ms (estimated " +
+                                  std::to_string(static_cast<long>(task.estimatedCost)) + " ms), moved " +
+                                  std::to_string(task.bytesToMove) + " bytes");
+        results.push_back(result);
+    }
+    return results;
 }
 
 string TriangleCountExecutor::isFileAccessibleToWorker(std::string graphId, std::string partitionId,
@@ -760,7 +705,7 @@ string TriangleCountExecutor::isFileAccessibleToWorker(std::string graphId, std:
 
     if (sockfd < 0) {
         std::cerr << "Cannot create socket" << std::endl;
-        return 0;
+        return isFileAccessible;
     }
 
     if (aggregatorHostName.find('@') != std::string::npos) {
@@ -770,7 +715,8 @@ string TriangleCountExecutor::isFileAccessibleToWorker(std::string graphId, std:
     server = gethostbyname(aggregatorHostName.c_str());
     if (server == NULL) {
         triangleCount_logger.error("ERROR, no host named " + aggregatorHostName);
-        return 0;
+        close(sockfd);
+        return isFileAccessible;
     }
 
     bzero((char *)&serv_addr, sizeof(serv_addr));
@@ -779,8 +725,9 @@ string TriangleCountExecutor::isFileAccessibleToWorker(std::string graphId, std:
     serv_addr.sin_port = htons(atoi(aggregatorPort.c_str()));
     if (Utils::connect_wrapper(sockfd, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0) {
         std::cerr << "ERROR connecting" << std::endl;
-        // TODO::exit
-        return 0;
+        // An unreachable aggregator does not hold the file
+        close(sockfd);
+        return isFileAccessible;
     }
 
     bzero(data, 301);
@@ -1078,11 +1025,13 @@ std::string TriangleCountExecutor::copyCompositeCentralStoreToAggregator(std::st
     return response;
 }
 
-string TriangleCountExecutor::countCompositeCentralStoreTriangles(std::string aggregatorHostName,
-                                                                  std::string aggregatorPort,
-                                                                  std::string compositeCentralStoreFileList,
-                                                                  std::string masterIP, std::string availableFileList,
-                                                                  int threadPriority) {
+long TriangleCountExecutor::countCompositeCentralStoreTriangles(std::string aggregatorHostName,
+                                                                std::string aggregatorPort,
+                                                                std::string compositeCentralStoreFileList,
+                                                                std::string masterIP, std::string availableFileList,
+                                                                int threadPriority, TriangleSet &triangleSet,
+                                                                std::mutex &triangleSetMutex) {
+    long newTriangles = 0;
     int sockfd;
     char data[301];
     bool loop = false;
@@ -1221,28 +1170,7 @@ string TriangleCountExecutor::countCompositeCentralStoreTriangles(std::string ag
 
             triangleCount_logger.log("Sent : Thread Priority " + std::to_string(threadPriority), "info");
 
-            bzero(data, 301);
-            read(sockfd, data, 300);
-            response = (data);
-            response = Utils::trim_copy(response);
-            string status = response.substr(response.size() - 5);
-            std::string result = response.substr(0, response.size() - 5);
-
-            while (status.compare("/SEND") == 0) {
-                result_wr = write(sockfd, status.c_str(), status.size());
-
-                if (result_wr < 0) {
-                    triangleCount_logger.log("Error writing to socket", "error");
-                }
-                bzero(data, 301);
-                read(sockfd, data, 300);
-                response = (data);
-                response = Utils::trim_copy(response);
-                status = response.substr(response.size() - 5);
-                std::string triangleResponse = response.substr(0, response.size() - 5);
-                result = result + triangleResponse;
-            }
-            response = result;
+            newTriangles = receiveTriangles(sockfd, triangleSet, triangleSetMutex);
         }
 
         triangleCount_logger.log("Aggregate Response Received", "info");
@@ -1251,7 +1179,8 @@ string TriangleCountExecutor::countCompositeCentralStoreTriangles(std::string ag
         triangleCount_logger.log("There was an error in the upload process and the response is :: " + response,
                                  "error");
     }
-    return response;
+    close(sockfd);
+    return newTriangles;
 }
 
 std::vector<std::vector<string>> TriangleCountExecutor::getWorkerCombination(SQLiteDBInterface *sqlite,
@@ -1259,7 +1188,7 @@ std::vector<std::vector<string>> TriangleCountExecutor::getWorkerCombination(SQL
     std::set<string> workerIdSet;
 
     string sqlStatement =
-        "SELECT worker_idworker "
+        "SELECT worker_idworker, partition_idpartition "
         "FROM worker_has_partition INNER JOIN worker ON worker_has_partition.worker_idworker=worker.idworker "
         "WHERE partition_graph_idgraph=" +
         graphId + ";";
@@ -1270,8 +1199,9 @@ std::vector<std::vector<string>> TriangleCountExecutor::getWorkerCombination(SQL
         std::vector<pair<string, string>> rowData = *i;
 
         string workerId = rowData.at(0).second;
+        string partitionId = rowData.at(1).second;
 
-        workerIdSet.insert(workerId);
+        workerIdSet.insert(AggregationPlanner::getStoreId(workerId, partitionId));
     }
 
     std::vector<string> workerIdVector(workerIdSet.begin(), workerIdSet.end());
@@ -1285,6 +1215,8 @@ std::string TriangleCountExecutor::copyCentralStoreToAggregator(std::string aggr
                                                                 std::string aggregatorPort,
                                                                 std::string aggregatorDataPort, int graphId,
                                                                 int partitionId, std::string masterIP) {
+    TraceSpan copySpan("executor.copy_centralstore", aggregatorHostName + " partition " + std::to_string(partitionId));
+    TraceSpan handshakeSpan("executor.handshake", aggregatorHostName);
     int sockfd;
     char data[301];
     bool loop = false;
@@ -1358,6 +1290,8 @@ std::string TriangleCountExecutor::copyCentralStoreToAggregator(std::string aggr
         } else {
             triangleCount_logger.log("Received : " + response, "error");
         }
+        handshakeSpan.end();
+        Tracer::sendTraceId(sockfd);
         result_wr = write(sockfd, JasmineGraphInstanceProtocol::SEND_CENTRALSTORE_TO_AGGREGATOR.c_str(),
                           JasmineGraphInstanceProtocol::SEND_CENTRALSTORE_TO_AGGREGATOR.size());
 
@@ -1471,10 +1405,14 @@ std::string TriangleCountExecutor::copyCentralStoreToAggregator(std::string aggr
     return response;
 }
 
-string TriangleCountExecutor::countCentralStoreTriangles(std::string aggregatorHostName, std::string aggregatorPort,
-                                                         std::string host, std::string partitionId,
-                                                         std::string partitionIdList, std::string graphId,
-                                                         std::string masterIP, int threadPriority) {
+long TriangleCountExecutor::countCentralStoreTriangles(std::string aggregatorHostName, std::string aggregatorPort,
+                                                       std::string host, std::string partitionId,
+                                                       std::string partitionIdList, std::string graphId,
+                                                       std::string masterIP, int threadPriority,
+                                                       TriangleSet &triangleSet, std::mutex &triangleSetMutex) {
+    TraceSpan countSpan("executor.count_centralstore", aggregatorHostName + " partitions " + partitionIdList);
+    TraceSpan handshakeSpan("executor.handshake", aggregatorHostName);
+    long newTriangles = 0;
     int sockfd;
     char data[301];
     bool loop = false;
@@ -1542,6 +1480,8 @@ string TriangleCountExecutor::countCentralStoreTriangles(std::string aggregatorH
         } else {
             triangleCount_logger.log("Received : " + response, "error");
         }
+        handshakeSpan.end();
+        Tracer::sendTraceId(sockfd);
         result_wr = write(sockfd, JasmineGraphInstanceProtocol::AGGREGATE_CENTRALSTORE_TRIANGLES.c_str(),
                           JasmineGraphInstanceProtocol::AGGREGATE_CENTRALSTORE_TRIANGLES.size());
 
@@ -1613,35 +1553,37 @@ string TriangleCountExecutor::countCentralStoreTriangles(std::string aggregatorH
 
             triangleCount_logger.log("Sent : Thread Priority " + std::to_string(threadPriority), "info");
 
-            bzero(data, 301);
-            read(sockfd, data, 300);
-            response = (data);
-            response = Utils::trim_copy(response);
-            string status = response.substr(response.size() - 5);
-            std::string result = response.substr(0, response.size() - 5);
-
-            while (status == "/SEND") {
-                result_wr = write(sockfd, status.c_str(), status.size());
-
-                if (result_wr < 0) {
-                    triangleCount_logger.log("Error writing to socket", "error");
-                }
-                bzero(data, 301);
-                read(sockfd, data, 300);
-                response = (data);
-                response = Utils::trim_copy(response);
-                status = response.substr(response.size() - 5);
-                std::string triangleResponse = response.substr(0, response.size() - 5);
-                result = result + triangleResponse;
-            }
-            response = result;
+            newTriangles = receiveTriangles(sockfd, triangleSet, triangleSetMutex);
         }
 
     } else {
         triangleCount_logger.log("There was an error in the upload process and the response is :: " + response,
                                  "error");
     }
-    return response;
+    close(sockfd);
+    return newTriangles;
+}
+
+long TriangleCountExecutor::receiveTriangles(int sockfd, TriangleSet &triangleSet, std::mutex &triangleSetMutex) {
+    TriangleStreamReader triangleReader(
+        [sockfd](char *bytes, size_t size) { return Utils::recv_wrapper(sockfd, bytes, size); });
+    std::vector<long> triangles;
+    long newTriangles = 0;
+
+    // One frame is decoded at a time so memory use does not grow with the number of triangles sent
+    while (triangleReader.next(triangles)) {
+        const std::lock_guard<std::mutex> lock(triangleSetMutex);
+        for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+            if (triangleSet.insert(triangles[i], triangles[i + 1], triangles[i + 2])) {
+                newTriangles++;
+            }
+        }
+    }
+
+    if (triangleReader.hasFailed()) {
+        triangleCount_logger.error("Error while receiving triangles from the aggregator");
+    }
+    return newTriangles;
 }
 
 int TriangleCountExecutor::getUid() {
@@ -19,11 +19,15 @@ limitations under the License.
 #include "../../../../metadb/SQLiteDBInterface.h"
 #include "../../../../performance/metrics/PerformanceUtil.h"
 #include "../../../../performancedb/PerformanceSQLiteDBInterface.h"
+#include "../../../../query/algorithms/triangles/TriangleSet.h"
+#include "../../../../query/algorithms/triangles/TriangleStream.h"
 #include "../../../../server/JasmineGraphInstanceProtocol.h"
 #include "../../../../server/JasmineGraphServer.h"
 #include "../../../JasmineGraphFrontEndProtocol.h"
 #include "../../CoreConstants.h"
+#include "../../scheduler/JobScheduler.h"
 #include "../AbstractExecutor.h"
+#include "AggregationPlanner.h"
 
 class TriangleCountExecutor : public AbstractExecutor {
  public:
@@ -38,8 +42,19 @@ class TriangleCountExecutor : public AbstractExecutor {
     static long getTriangleCount(int graphId, std::string host, int port, int dataPort, int partitionId,
                                  std::string masterIP, int uniqueId, bool isCompositeAggregation, int threadPriority);
 
-    static long aggregateCentralStoreTriangles(SQLiteDBInterface *sqlite, std::string graphId, std::string masterIP,
-                                               int threadPriority);
+    struct AggregationResult {
+        AggregationTask task;
+        long transferTime;
+        long elapsedTime;
+    };
+
+    static long aggregateCentralStoreTriangles(SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfDb,
+                                               std::string graphId, std::string masterIP, int threadPriority);
+
+    static std::vector<AggregationResult> runAggregationTasks(
+        std::vector<AggregationTask> tasks, const std::map<std::string, JasmineGraphServer::workerPartition> &workers,
+        std::string graphId, std::string masterIP, int threadPriority, TriangleSet &triangleSet,
+        std::mutex &triangleSetMutex);
 
     static string isFileAccessibleToWorker(std::string graphId, std::string partitionId, std::string aggregatorHostName,
                                            std::string aggregatorPort, std::string masterIP, std::string fileType,
@@ -49,9 +64,10 @@ class TriangleCountExecutor : public AbstractExecutor {
                                                              std::string aggregatorDataPort, std::string fileName,
                                                              std::string masterIP);
 
-    static string countCompositeCentralStoreTriangles(std::string aggregatorHostName, std::string aggregatorPort,
-                                                      std::string compositeCentralStoreFileList, std::string masterIP,
-                                                      std::string availableFileList, int threadPriority);
+    static long countCompositeCentralStoreTriangles(std::string aggregatorHostName, std::string aggregatorPort,
+                                                    std::string compositeCentralStoreFileList, std::string masterIP,
+                                                    std::string availableFileList, int threadPriority,
+                                                    TriangleSet &triangleSet, std::mutex &triangleSetMutex);
 
     static std::vector<std::vector<string>> getWorkerCombination(SQLiteDBInterface *sqlite, std::string graphId);
 
@@ -59,19 +75,21 @@ class TriangleCountExecutor : public AbstractExecutor {
                                                     std::string aggregatorDataPort, int graphId, int partitionId,
                                                     std::string masterIP);
 
-    static string countCentralStoreTriangles(std::string aggregatorHostName, std::string aggregatorPort,
-                                             std::string host, std::string partitionId, std::string partitionIdList,
-                                             std::string graphId, std::string masterIP, int threadPriority);
+    static long countCentralStoreTriangles(std::string aggregatorHostName, std::string aggregatorPort,
+                                           std::string host, std::string partitionId, std::string partitionIdList,
+                                           std::string graphId, std::string masterIP, int threadPriority,
+                                           TriangleSet &triangleSet, std::mutex &triangleSetMutex);
+
+    // Reads a binary triangle stream sent by an aggregator into triangleSet. Returns the number of new triangles.
+    static long receiveTriangles(int sockfd, TriangleSet &triangleSet, std::mutex &triangleSetMutex);
 
     static bool proceedOrNot(std::set<string> partitionSet, int partitionId);
 
     static void updateMap(int partitionId);
 
-    static int updateTriangleTreeAndGetTriangleCount(std::vector<std::string> triangles);
-
     static std::vector<std::vector<string>> fileCombinations;
     static std::map<std::string, std::string> combinationWorkerMap;
-    static std::map<long, std::map<long, std::vector<long>>> triangleTree;
+    static TriangleSet triangleSet;
 
  private:
     SQLiteDBInterface *sqlite;
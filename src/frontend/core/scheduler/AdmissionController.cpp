@@ -0,0 +1,89 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "AdmissionController.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+constexpr double AdmissionController::SLA_TOLERANCE;
+
+AdmissionController::AdmissionController(int slots) : slots(std::max(1, slots)) {}
+
+void AdmissionController::setSlots(int slots) {
+    std::lock_guard<std::mutex> lock(controllerMutex);
+    this->slots = std::max(1, slots);
+}
+
+static long getDeadline(const AdmissionController::PendingJob &job) {
+    long sla = std::max(job.sla, job.estimatedTime);
+    return job.submitTime + static_cast<long>(sla * (1 + AdmissionController::SLA_TOLERANCE));
+}
+
+std::vector<AdmissionController::Admission> AdmissionController::admit(std::vector<PendingJob> jobs, long now) {
+    std::stable_sort(jobs.begin(), jobs.end(),
+                     [](const PendingJob &lhs, const PendingJob &rhs) { return getDeadline(lhs) < getDeadline(rhs); });
+
+    std::lock_guard<std::mutex> lock(controllerMutex);
+    std::vector<long> reservedUntil;
+    for (auto &reservation : reservations) {
+        // A job running past its estimate keeps its slot, but nothing is known about how much longer it takes
+        reservedUntil.push_back(std::max(now, reservation.second.second));
+    }
+    std::sort(reservedUntil.begin(), reservedUntil.end());
+
+    std::priority_queue<long, std::vector<long>, std::greater<long>> slotFreeTimes;
+    for (int i = 0; i < slots; i++) {
+        slotFreeTimes.push(now);
+    }
+    for (long end : reservedUntil) {
+        long freeTime = slotFreeTimes.top();
+        slotFreeTimes.pop();
+        slotFreeTimes.push(std::max(freeTime, end));
+    }
+
+    std::vector<Admission> admissions;
+    for (auto &job : jobs) {
+        Admission admission;
+        admission.jobId = job.jobId;
+        admission.estimatedTime = job.estimatedTime;
+
+        long start = std::max(now, slotFreeTimes.top());
+        long end = start + job.estimatedTime;
+        // A job that can start right away is never rejected, waiting longer would not help it
+        if (start > now && end > getDeadline(job)) {
+            admission.decision = REJECT;
+            admissions.push_back(admission);
+            continue;
+        }
+
+        slotFreeTimes.pop();
+        slotFreeTimes.push(end);
+        reservations[job.jobId] = std::make_pair(start, end);
+        admission.decision = start > now ? DELAY : ADMIT;
+        admission.delay = start - now;
+        admissions.push_back(admission);
+    }
+    return admissions;
+}
+
+void AdmissionController::jobFinished(const std::string &jobId) {
+    std::lock_guard<std::mutex> lock(controllerMutex);
+    reservations.erase(jobId);
+}
+
+size_t AdmissionController::getReservationCount() {
+    std::lock_guard<std::mutex> lock(controllerMutex);
+    return reservations.size();
+}
@@ -0,0 +1,69 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_ADMISSIONCONTROLLER_H
+#define JASMINEGRAPH_ADMISSIONCONTROLLER_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Decides when the high priority jobs run. The cluster runs a fixed number of high priority jobs at a time
+ * (slots) and every admitted job holds a slot from its planned start until its estimated end or until it
+ * finishes. Pending jobs are planned earliest deadline first into the slot that frees up first. A job starts
+ * right away if a slot is free, is delayed until one frees up, or is rejected when it would end later than its
+ * SLA allows. The SLA of a job is its calibrated latency, or its estimated run time when the graph was never
+ * calibrated, plus SLA_TOLERANCE of it for waiting.
+ */
+class AdmissionController {
+ public:
+    enum Decision { ADMIT, DELAY, REJECT };
+
+    struct PendingJob {
+        std::string jobId;
+        long submitTime = 0;     // Milliseconds since epoch
+        long sla = 0;            // Milliseconds, 0 if unknown
+        long estimatedTime = 0;  // Milliseconds
+    };
+
+    struct Admission {
+        std::string jobId;
+        Decision decision = ADMIT;
+        long delay = 0;  // Milliseconds to wait before dispatching a delayed job
+        long estimatedTime = 0;
+    };
+
+    static constexpr double SLA_TOLERANCE = 0.1;
+
+    explicit AdmissionController(int slots = 1);
+
+    void setSlots(int slots);
+
+    // Plan the pending jobs. The admissions are returned in the order the jobs should be dispatched.
+    std::vector<Admission> admit(std::vector<PendingJob> jobs, long now);
+
+    // Release the slot of an admitted job
+    void jobFinished(const std::string &jobId);
+
+    size_t getReservationCount();
+
+ private:
+    std::mutex controllerMutex;
+    int slots;
+    std::map<std::string, std::pair<long, long>> reservations;  // Planned start and end of the admitted jobs
+};
+
+#endif  // JASMINEGRAPH_ADMISSIONCONTROLLER_H
@@ -0,0 +1,224 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "CostModel.h"
+
+#include <algorithm>
+
+#include "../../../util/logger/Logger.h"
+#include "../../JasmineGraphFrontEndProtocol.h"
+
+Logger cost_model_logger;
+
+constexpr double CostModel::DEFAULT_EDGES_PER_MS;
+constexpr double CostModel::RECALIBRATION_WEIGHT;
+
+std::mutex CostModel::modelMutex;
+std::map<std::string, double> CostModel::throughputs;
+double CostModel::aggregationThroughput = CostModel::DEFAULT_EDGES_PER_MS;
+std::map<std::string, double> CostModel::calibrations;
+
+// A single job far off the estimate (e.g. a worker that was swapping) should not throw the model off
+static const double MAX_CALIBRATION_STEP = 10;
+
+static double movingAverage(double average, double value) {
+    return average + CostModel::RECALIBRATION_WEIGHT * (value - average);
+}
+
+const PartitionStatistics *GraphStatistics::getPartition(const std::string &workerId,
+                                                         const std::string &partitionId) const {
+    for (auto &partition : partitions) {
+        if (partition.workerId == workerId && partition.partitionId == partitionId) {
+            return &partition;
+        }
+    }
+    return NULL;
+}
+
+GraphStatistics CostModel::loadGraphStatistics(SQLiteDBInterface *sqlite, std::string graphId) {
+    GraphStatistics statistics;
+    PreparedStatement statement = sqlite->prepare(
+        "SELECT worker_has_partition.worker_idworker, partition.idpartition, partition.vertexcount, "
+        "partition.edgecount, partition.central_edgecount "
+        "FROM worker_has_partition INNER JOIN partition "
+        "ON worker_has_partition.partition_idpartition = partition.idpartition "
+        "AND worker_has_partition.partition_graph_idgraph = partition.graph_idgraph "
+        "WHERE partition.graph_idgraph = ?;");
+    statement.bind(1, graphId);
+    while (statement.next()) {
+        PartitionStatistics partition;
+        partition.workerId = statement.getString(0);
+        partition.partitionId = statement.getString(1);
+        partition.vertexCount = statement.getLong(2);
+        partition.edgeCount = statement.getLong(3);
+        partition.centralEdgeCount = statement.getLong(4);
+        statistics.vertexCount += partition.vertexCount;
+        statistics.edgeCount += partition.edgeCount;
+        statistics.centralEdgeCount += partition.centralEdgeCount;
+        statistics.partitions.push_back(partition);
+    }
+
+    if (statistics.vertexCount == 0 || statistics.edgeCount == 0) {
+        return statistics;
+    }
+    double averageDegree = static_cast<double>(statistics.edgeCount) / statistics.vertexCount;
+    for (auto &partition : statistics.partitions) {
+        if (partition.vertexCount > 0) {
+            partition.degreeSkew = partition.edgeCount / (averageDegree * partition.vertexCount);
+        }
+        statistics.degreeSkew = std::max(statistics.degreeSkew, partition.degreeSkew);
+    }
+    return statistics;
+}
+
+void CostModel::load(PerformanceSQLiteDBInterface *perfDb) {
+    if (perfDb == NULL) {
+        return;
+    }
+
+    PreparedStatement kernelStatement = perfDb->prepare(
+        "SELECT worker_id, SUM(edgecount * degree_skew), SUM(elapsed_time) FROM kernel_performance "
+        "WHERE job_type = ? GROUP BY worker_id;");
+    kernelStatement.bind(1, TRIANGLES);
+    while (kernelStatement.next()) {
+        double elapsedTime = kernelStatement.getDouble(2);
+        if (elapsedTime > 0) {
+            setThroughput(kernelStatement.getString(0), kernelStatement.getDouble(1) / elapsedTime);
+        }
+    }
+
+    PreparedStatement aggregationStatement =
+        perfDb->prepare("SELECT SUM(central_edgecount), SUM(elapsed_time) FROM aggregation_performance;");
+    if (aggregationStatement.next() && aggregationStatement.getDouble(1) > 0) {
+        setAggregationThroughput(aggregationStatement.getDouble(0) / aggregationStatement.getDouble(1));
+    }
+    aggregationStatement.reset();
+
+    // Replay the completed jobs in the order they ran, the way the factors were updated while they ran
+    PreparedStatement jobStatement = perfDb->prepare(
+        "SELECT job_type, estimated_time, run_time FROM job_performance "
+        "WHERE state = 'done' AND estimated_time > 0 AND run_time > 0 ORDER BY id;");
+    std::lock_guard<std::mutex> lock(modelMutex);
+    while (jobStatement.next()) {
+        std::string jobType = jobStatement.getString(0);
+        auto calibration = calibrations.find(jobType);
+        calibrations[jobType] = calibrate(calibration == calibrations.end() ? 1 : calibration->second,
+                                          jobStatement.getLong(1), jobStatement.getLong(2));
+    }
+    for (auto &calibration : calibrations) {
+        cost_model_logger.info("Calibration factor of " + calibration.first + " jobs " +
+                               std::to_string(calibration.second));
+    }
+}
+
+bool CostModel::isModelled(const std::string &jobType) { return jobType == TRIANGLES; }
+
+long CostModel::estimate(const std::string &jobType, const GraphStatistics &statistics) {
+    if (!isModelled(jobType)) {
+        return -1;
+    }
+
+    std::map<std::string, double> workerCosts;
+    for (auto &partition : statistics.partitions) {
+        workerCosts[partition.workerId] += partition.edgeCount * partition.degreeSkew;
+    }
+
+    std::lock_guard<std::mutex> lock(modelMutex);
+    // Workers count their partitions in parallel, the central stores are aggregated once all of them are done
+    double localTime = 0;
+    for (auto &workerCost : workerCosts) {
+        auto throughput = throughputs.find(workerCost.first);
+        double edgesPerMs = throughput == throughputs.end() ? DEFAULT_EDGES_PER_MS : throughput->second;
+        localTime = std::max(localTime, workerCost.second / edgesPerMs);
+    }
+    double aggregationTime = statistics.centralEdgeCount / aggregationThroughput;
+
+    auto calibration = calibrations.find(jobType);
+    double factor = calibration == calibrations.end() ? 1 : calibration->second;
+    return static_cast<long>((localTime + aggregationTime) * factor);
+}
+
+void CostModel::recordKernelExecution(PerformanceSQLiteDBInterface *perfDb, const std::string &jobType,
+                                      const std::string &graphId, const PartitionStatistics &partition,
+                                      long elapsedTime) {
+    double edgesPerMs = elapsedTime > 0 ? partition.edgeCount * partition.degreeSkew / elapsedTime : 0;
+    if (edgesPerMs > 0) {
+        std::lock_guard<std::mutex> lock(modelMutex);
+        auto throughput = throughputs.find(partition.workerId);
+        if (throughput == throughputs.end()) {
+            throughputs[partition.workerId] = edgesPerMs;
+        } else {
+            throughput->second = movingAverage(throughput->second, edgesPerMs);
+        }
+    }
+
+    if (perfDb == NULL) {
+        return;
+    }
+    PreparedStatement statement = perfDb->prepare(
+        "INSERT INTO kernel_performance (job_type, graph_id, worker_id, partition_id, edgecount, degree_skew, "
+        "elapsed_time) VALUES (?, ?, ?, ?, ?, ?, ?);");
+    statement.bind(1, jobType).bind(2, graphId).bind(3, partition.workerId).bind(4, partition.partitionId);
+    statement.bind(5, partition.edgeCount).bind(6, partition.degreeSkew).bind(7, elapsedTime);
+    statement.execute();
+}
+
+void CostModel::recordAggregation(long centralEdgeCount, long elapsedTime) {
+    if (elapsedTime <= 0 || centralEdgeCount <= 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(modelMutex);
+    aggregationThroughput = movingAverage(aggregationThroughput, static_cast<double>(centralEdgeCount) / elapsedTime);
+}
+
+double CostModel::calibrate(double calibration, long estimatedTime, long runTime) {
+    if (estimatedTime <= 0 || runTime <= 0) {
+        return calibration;
+    }
+    double ratio = static_cast<double>(runTime) / estimatedTime;
+    ratio = std::min(MAX_CALIBRATION_STEP, std::max(1 / MAX_CALIBRATION_STEP, ratio));
+    // The estimate already includes the current factor, so the ratio is the error that is left
+    return calibration * movingAverage(1, ratio);
+}
+
+void CostModel::recordJobExecution(const std::string &jobType, long estimatedTime, long runTime) {
+    std::lock_guard<std::mutex> lock(modelMutex);
+    auto calibration = calibrations.find(jobType);
+    double factor = calibrate(calibration == calibrations.end() ? 1 : calibration->second, estimatedTime, runTime);
+    calibrations[jobType] = factor;
+    cost_model_logger.info(jobType + " job took " + std::to_string(runTime) + " ms, estimated " +
+                           std::to_string(estimatedTime) + " ms. Calibration factor " + std::to_string(factor));
+}
+
+void CostModel::setThroughput(const std::string &workerId, double edgesPerMs) {
+    std::lock_guard<std::mutex> lock(modelMutex);
+    if (edgesPerMs > 0) throughputs[workerId] = edgesPerMs;
+}
+
+void CostModel::setAggregationThroughput(double edgesPerMs) {
+    std::lock_guard<std::mutex> lock(modelMutex);
+    if (edgesPerMs > 0) aggregationThroughput = edgesPerMs;
+}
+
+double CostModel::getCalibration(const std::string &jobType) {
+    std::lock_guard<std::mutex> lock(modelMutex);
+    auto calibration = calibrations.find(jobType);
+    return calibration == calibrations.end() ? 1 : calibration->second;
+}
+
+void CostModel::clear() {
+    std::lock_guard<std::mutex> lock(modelMutex);
+    throughputs.clear();
+    aggregationThroughput = DEFAULT_EDGES_PER_MS;
+    calibrations.clear();
+}
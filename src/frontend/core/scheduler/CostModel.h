@@ -0,0 +1,99 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_COSTMODEL_H
+#define JASMINEGRAPH_COSTMODEL_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../../../metadb/SQLiteDBInterface.h"
+#include "../../../performancedb/PerformanceSQLiteDBInterface.h"
+
+struct PartitionStatistics {
+    std::string workerId;
+    std::string partitionId;
+    long vertexCount = 0;
+    long edgeCount = 0;
+    long centralEdgeCount = 0;
+    double degreeSkew = 1;  // Average degree of the partition relative to the average degree of the graph
+};
+
+struct GraphStatistics {
+    long vertexCount = 0;
+    long edgeCount = 0;
+    long centralEdgeCount = 0;
+    double degreeSkew = 1;  // Highest degree skew of a partition
+    std::vector<PartitionStatistics> partitions;
+
+    const PartitionStatistics *getPartition(const std::string &workerId, const std::string &partitionId) const;
+};
+
+/**
+ * Estimates the run time of a job from the statistics of its graph in the partition table and the measured
+ * throughput of the workers. Counting triangles of a partition costs about its edges times its average degree,
+ * so the local phase takes the edges of the partitions of a worker weighted by their degree skew divided by the
+ * throughput of the worker, the slowest worker deciding. The central store aggregation follows with the central
+ * edges divided by the aggregation throughput.
+ *
+ * Worker throughput is learnt from the kernel_performance table, which the executors fill with the time every
+ * partition took, and the aggregation throughput from the aggregation_performance table. Both are updated with
+ * every measurement, and a calibration factor per job type corrects the estimates with the run times of the
+ * completed jobs recorded in job_performance, so the model follows the cluster without calibration runs.
+ */
+class CostModel {
+ public:
+    // Used until a worker has kernel history
+    static constexpr double DEFAULT_EDGES_PER_MS = 1000;
+    // Weight of a new measurement in the moving averages of the throughput and the calibration factor
+    static constexpr double RECALIBRATION_WEIGHT = 0.2;
+
+    static GraphStatistics loadGraphStatistics(SQLiteDBInterface *sqlite, std::string graphId);
+
+    // Learn worker throughput and calibration factors from the performance DB history
+    static void load(PerformanceSQLiteDBInterface *perfDb);
+
+    static bool isModelled(const std::string &jobType);
+
+    // Estimated run time of the job in milliseconds, -1 if the job type is not modelled
+    static long estimate(const std::string &jobType, const GraphStatistics &statistics);
+
+    static void recordKernelExecution(PerformanceSQLiteDBInterface *perfDb, const std::string &jobType,
+                                      const std::string &graphId, const PartitionStatistics &partition,
+                                      long elapsedTime);
+
+    static void recordAggregation(long centralEdgeCount, long elapsedTime);
+
+    // Move the calibration factor of the job type towards the ratio of the run time to the estimate
+    static void recordJobExecution(const std::string &jobType, long estimatedTime, long runTime);
+
+    static void setThroughput(const std::string &workerId, double edgesPerMs);
+
+    static void setAggregationThroughput(double edgesPerMs);
+
+    static double getCalibration(const std::string &jobType);
+
+    static void clear();
+
+ private:
+    static double calibrate(double calibration, long estimatedTime, long runTime);
+
+    static std::mutex modelMutex;
+    static std::map<std::string, double> throughputs;
+    static double aggregationThroughput;
+    static std::map<std::string, double> calibrations;
+};
+
+#endif  // JASMINEGRAPH_COSTMODEL_H
@@ -13,19 +13,69 @@ limitations under the License.
 
 #include "JobScheduler.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "../../../performance/metrics/MetricsRegistry.h"
+#include "../../../performance/trace/Tracer.h"
 #include "../../../util/Conts.h"
 #include "../../../util/logger/Logger.h"
+#include "../../../util/Utils.h"
+#include "../cache/AnalyticsResultCache.h"
 #include "../executor/AbstractExecutor.h"
 #include "../factory/ExecutorFactory.h"
+#include "AdmissionController.h"
+#include "CostModel.h"
 
 Logger jobScheduler_Logger;
 std::priority_queue<JobRequest> jobQueue;
-std::vector<JobResponse> responseVector;
 std::map<std::string, JobResponse> responseMap;
-std::vector<std::future<void>> JobScheduler::intermRes;
 bool workerResponded;
 std::vector<std::string> highPriorityGraphList;
 
+static std::mutex jobQueueMutex;
+static std::condition_variable jobQueueCondition;
+static std::condition_variable responseCondition;  // Guarded by responseVectorMutex
+static std::mutex jobStateMutex;
+static std::map<std::string, JobScheduler::JobRecord> jobRecords;
+static AdmissionController admissionController;
+
+struct ExecutorPool {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<JobRequest> jobs;
+    Gauge *queueDepth;
+};
+static std::map<std::string, ExecutorPool *> executorPools;
+
+static Gauge &getSchedulerQueueDepth() {
+    static Gauge &queueDepth =
+        MetricsRegistry::gauge("jasminegraph_scheduler_queue_depth", "Jobs waiting for the scheduler dispatcher");
+    return queueDepth;
+}
+
+static long currentTimeMillis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+static std::string jobStateToString(JobScheduler::JobState state) {
+    switch (state) {
+        case JobScheduler::QUEUED:
+            return "queued";
+        case JobScheduler::RUNNING:
+            return "running";
+        case JobScheduler::DONE:
+            return "done";
+        case JobScheduler::CANCELLED:
+            return "cancelled";
+        default:
+            return "unknown";
+    }
+}
+
 JobScheduler::JobScheduler(SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfDB) {
     this->sqlite = sqlite;
     this->perfSqlite = perfDB;
@@ -33,101 +83,463 @@ JobScheduler::JobScheduler(SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterfa
 
 JobScheduler::JobScheduler() {}
 
+// Estimated run time of the job, or -1 if the cost model does not cover its job type
+static long estimateJob(JobRequest &request, SQLiteDBInterface *sqlite) {
+    if (sqlite == NULL || !CostModel::isModelled(request.getJobType())) {
+        return -1;
+    }
+    GraphStatistics statistics =
+        CostModel::loadGraphStatistics(sqlite, request.getParameter(Conts::PARAM_KEYS::GRAPH_ID));
+    long estimatedTime = CostModel::estimate(request.getJobType(), statistics);
+
+    std::lock_guard<std::mutex> lock(jobStateMutex);
+    auto recordIt = jobRecords.find(request.getJobId());
+    if (recordIt != jobRecords.end()) {
+        recordIt->second.estimatedTime = estimatedTime;
+    }
+    return estimatedTime;
+}
+
+static long getSubmitTime(const std::string &jobId) {
+    std::lock_guard<std::mutex> lock(jobStateMutex);
+    auto recordIt = jobRecords.find(jobId);
+    return recordIt == jobRecords.end() ? currentTimeMillis() : recordIt->second.submitTime;
+}
+
+static void countAdmission(AdmissionController::Decision decision) {
+    static Counter &admitted = MetricsRegistry::counter("jasminegraph_scheduler_admissions_total",
+                                                        "High priority jobs by admission decision",
+                                                        "decision=\"admit\"");
+    static Counter &delayed = MetricsRegistry::counter("jasminegraph_scheduler_admissions_total",
+                                                       "High priority jobs by admission decision",
+                                                       "decision=\"delay\"");
+    static Counter &rejected = MetricsRegistry::counter("jasminegraph_scheduler_admissions_total",
+                                                        "High priority jobs by admission decision",
+                                                        "decision=\"reject\"");
+    if (decision == AdmissionController::ADMIT) {
+        admitted.inc();
+    } else if (decision == AdmissionController::DELAY) {
+        delayed.inc();
+    } else {
+        rejected.inc();
+    }
+}
+
 void *startScheduler(void *dummyPt) {
     JobScheduler *refToScheduler = (JobScheduler *)dummyPt;
-    PerformanceUtil::init();
+    // High priority jobs held back by the admission controller, keyed by the time they are dispatched at
+    std::multimap<long, JobRequest> delayedJobs;
     while (true) {
-        if (jobQueue.size() > 0) {
-            jobScheduler_Logger.log("##JOB SCHEDULER## Jobs Available for Scheduling", "info");
+        std::vector<JobRequest> requests;
+        {
+            // Wake up as soon as a job is pushed. The timeout drives the dispatch of delayed jobs and the garbage
+            // collection of finished jobs.
+            std::chrono::milliseconds timeout = std::chrono::seconds(Conts::SCHEDULER_SLEEP_TIME);
+            if (!delayedJobs.empty()) {
+                timeout = std::min(timeout,
+                                   std::chrono::milliseconds(std::max(0L, delayedJobs.begin()->first -
+                                                                              currentTimeMillis())));
+            }
+            std::unique_lock<std::mutex> lock(jobQueueMutex);
+            jobQueueCondition.wait_for(lock, timeout, [] { return !jobQueue.empty(); });
+            while (!jobQueue.empty()) {
+                requests.push_back(jobQueue.top());
+                jobQueue.pop();
+            }
+            getSchedulerQueueDepth().set(0);
+        }
 
-            std::vector<JobRequest> pendingHPJobList;
-            std::vector<std::string> highPriorityGraphList;
+        long now = currentTimeMillis();
+        while (!delayedJobs.empty() && delayedJobs.begin()->first <= now) {
+            JobRequest delayedRequest = delayedJobs.begin()->second;
+            delayedJobs.erase(delayedJobs.begin());
+            if (JobScheduler::getJobState(delayedRequest.getJobId()) != JobScheduler::CANCELLED) {
+                JobScheduler::processJob(delayedRequest);
+            } else {
+                // The slot reserved when the job was delayed is not going to be used
+                admissionController.jobFinished(delayedRequest.getJobId());
+            }
+        }
 
-            while (!jobQueue.empty()) {
-                JobRequest request = jobQueue.top();
-
-                if (request.getPriority() == Conts::HIGH_PRIORITY_DEFAULT_VALUE && request.getJobType() == TRIANGLES) {
-                    pendingHPJobList.push_back(request);
-                    highPriorityGraphList.push_back(request.getParameter(Conts::PARAM_KEYS::GRAPH_ID));
-                    jobQueue.pop();
-                } else {
-                    jobQueue.pop();
-                    JobScheduler::processJob(request, refToScheduler->sqlite, refToScheduler->perfSqlite);
-                }
+        JobScheduler::collectCompletedJobs();
+        if (requests.empty()) {
+            continue;
+        }
+
+        jobScheduler_Logger.log("##JOB SCHEDULER## Jobs Available for Scheduling. Result cache hit rate: " +
+                                    std::to_string(AnalyticsResultCache::getHitRate()),
+                                "info");
+
+        std::map<std::string, JobRequest> pendingHPJobs;
+        std::vector<AdmissionController::PendingJob> pendingHPJobList;
+        for (auto &request : requests) {
+            if (JobScheduler::getJobState(request.getJobId()) == JobScheduler::CANCELLED) {
+                continue;
+            }
+
+            long estimatedTime = estimateJob(request, refToScheduler->sqlite);
+            if (request.getPriority() == Conts::HIGH_PRIORITY_DEFAULT_VALUE && estimatedTime >= 0) {
+                AdmissionController::PendingJob pendingJob;
+                pendingJob.jobId = request.getJobId();
+                pendingJob.submitTime = getSubmitTime(request.getJobId());
+                pendingJob.sla = std::atol(request.getParameter(Conts::PARAM_KEYS::GRAPH_SLA).c_str());
+                pendingJob.estimatedTime = estimatedTime;
+                pendingHPJobList.push_back(pendingJob);
+                pendingHPJobs[request.getJobId()] = request;
+            } else {
+                JobScheduler::processJob(request);
             }
+        }
 
-            if (pendingHPJobList.size() > 0) {
-                jobScheduler_Logger.log(
-                    "##JOB SCHEDULER## High Priority Jobs in Queue: " + std::to_string(pendingHPJobList.size()),
-                    "info");
-                std::string masterIP = pendingHPJobList[0].getMasterIP();
-                std::string jobType = pendingHPJobList[0].getJobType();
-                std::string category = pendingHPJobList[0].getParameter(Conts::PARAM_KEYS::CATEGORY);
-
-                std::vector<long> scheduleTimeVector = PerformanceUtil::getResourceAvailableTime(
-                    highPriorityGraphList, jobType, category, masterIP, pendingHPJobList);
-
-                for (int index = 0; index != pendingHPJobList.size(); ++index) {
-                    JobRequest hpRequest = pendingHPJobList[index];
-                    long queueTime = scheduleTimeVector[index];
-
-                    if (queueTime < 0) {
-                        JobResponse failedJobResponse;
-                        failedJobResponse.setJobId(hpRequest.getJobId());
-                        failedJobResponse.addParameter(Conts::PARAM_KEYS::ERROR_MESSAGE,
-                                                       "Rejecting the job request because "
-                                                       "SLA cannot be maintained");
-                        responseVectorMutex.lock();
-                        responseMap[hpRequest.getJobId()] = failedJobResponse;
-                        responseVectorMutex.unlock();
-                        continue;
-                    }
-
-                    hpRequest.addParameter(Conts::PARAM_KEYS::QUEUE_TIME, std::to_string(queueTime));
-                    JobScheduler::processJob(hpRequest, refToScheduler->sqlite, refToScheduler->perfSqlite);
-                }
+        if (pendingHPJobList.empty()) {
+            continue;
+        }
+        jobScheduler_Logger.log(
+            "##JOB SCHEDULER## High Priority Jobs in Queue: " + std::to_string(pendingHPJobList.size()), "info");
+
+        for (auto &admission : admissionController.admit(pendingHPJobList, currentTimeMillis())) {
+            JobRequest hpRequest = pendingHPJobs[admission.jobId];
+            countAdmission(admission.decision);
+            if (admission.decision == AdmissionController::REJECT) {
+                jobScheduler_Logger.info("##JOB SCHEDULER## Rejecting job " + admission.jobId + " estimated at " +
+                                         std::to_string(admission.estimatedTime) + " ms");
+                JobResponse failedJobResponse;
+                failedJobResponse.setJobId(hpRequest.getJobId());
+                failedJobResponse.addParameter(Conts::PARAM_KEYS::ERROR_MESSAGE,
+                                               "Rejecting the job request because "
+                                               "SLA cannot be maintained");
+                JobScheduler::publishResponse(hpRequest, failedJobResponse);
+                JobScheduler::finishJob(hpRequest.getJobId(), JobScheduler::DONE, refToScheduler->perfSqlite);
+            } else if (admission.decision == AdmissionController::DELAY) {
+                jobScheduler_Logger.info("##JOB SCHEDULER## Delaying job " + admission.jobId + " estimated at " +
+                                         std::to_string(admission.estimatedTime) + " ms by " +
+                                         std::to_string(admission.delay) + " ms");
+                delayedJobs.insert(std::make_pair(currentTimeMillis() + admission.delay, hpRequest));
+            } else {
+                JobScheduler::processJob(hpRequest);
             }
-        } else {
-            std::this_thread::sleep_for(std::chrono::seconds(Conts::SCHEDULER_SLEEP_TIME));
         }
     }
     return NULL;
 }
 
+static void runExecutorPool(ExecutorPool *pool, SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfDB) {
+    while (true) {
+        JobRequest request;
+        {
+            std::unique_lock<std::mutex> lock(pool->mutex);
+            pool->condition.wait(lock, [pool] { return !pool->jobs.empty(); });
+            request = pool->jobs.front();
+            pool->jobs.pop_front();
+            pool->queueDepth->set(pool->jobs.size());
+        }
+        JobScheduler::executeJob(request, sqlite, perfDB);
+    }
+}
+
 void JobScheduler::init() {
+    CostModel::load(this->perfSqlite);
+    std::string admissionSlots = Utils::getJasmineGraphProperty("org.jasminegraph.scheduler.admission.slots");
+    if (!admissionSlots.empty()) {
+        admissionController.setSlots(std::stoi(admissionSlots));
+    }
+
+    std::string jobTimeout = Utils::getJasmineGraphProperty("org.jasminegraph.scheduler.job.timeout");
+    if (!jobTimeout.empty() && std::stoi(jobTimeout) > 0) {
+        Conts::JOB_RESULT_TIMEOUT = std::stoi(jobTimeout);
+    }
+
+    std::string cacheSize = Utils::getJasmineGraphProperty("org.jasminegraph.frontend.resultcache.size");
+    if (!cacheSize.empty()) {
+        AnalyticsResultCache::setCapacity(std::stoul(cacheSize));
+    }
+
+    const std::string jobClasses[] = {"triangles", "pagerank", "streaming", "default"};
+    for (const auto &jobClass : jobClasses) {
+        int poolSize = Conts::SCHEDULER_POOL_SIZE;
+        std::string poolSizeProperty = Utils::getJasmineGraphProperty("org.jasminegraph.scheduler.pool." + jobClass);
+        if (!poolSizeProperty.empty() && std::stoi(poolSizeProperty) > 0) {
+            poolSize = std::stoi(poolSizeProperty);
+        }
+
+        ExecutorPool *pool = new ExecutorPool();
+        pool->queueDepth = &MetricsRegistry::gauge("jasminegraph_scheduler_pool_queue_depth",
+                                                   "Jobs waiting for an executor of the pool",
+                                                   "pool=\"" + jobClass + "\"");
+        executorPools[jobClass] = pool;
+        for (int i = 0; i < poolSize; i++) {
+            std::thread(runExecutorPool, pool, this->sqlite, this->perfSqlite).detach();
+        }
+        jobScheduler_Logger.info("##JOB SCHEDULER## Started " + std::to_string(poolSize) + " executors for " +
+                                 jobClass + " jobs");
+    }
+
     pthread_t schedulerThread;
     pthread_create(&schedulerThread, NULL, startScheduler, this);
 }
 
-void JobScheduler::processJob(JobRequest request, SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfDB) {
-    intermRes.push_back(std::async(std::launch::async, JobScheduler::executeJob, request, sqlite, perfDB));
+std::string JobScheduler::getJobClass(std::string jobType) {
+    if (jobType == TRIANGLES) {
+        return "triangles";
+    } else if (jobType == PAGE_RANK) {
+        return "pagerank";
+    } else if (jobType == STREAMING_TRIANGLES) {
+        return "streaming";
+    }
+    return "default";
+}
+
+void JobScheduler::processJob(JobRequest request) {
+    auto poolIt = executorPools.find(JobScheduler::getJobClass(request.getJobType()));
+    if (poolIt == executorPools.end()) {
+        jobScheduler_Logger.error("##JOB SCHEDULER## No executor pool for job " + request.getJobId());
+        return;
+    }
+
+    ExecutorPool *pool = poolIt->second;
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        pool->jobs.push_back(request);
+        pool->queueDepth->set(pool->jobs.size());
+    }
+    pool->condition.notify_one();
 }
 
 void JobScheduler::executeJob(JobRequest request, SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfDB) {
-    ExecutorFactory *executorFactory = new ExecutorFactory(sqlite, perfDB);
-    AbstractExecutor *abstractExecutor = executorFactory->getExecutor(request);
+    std::string jobId = request.getJobId();
+    long submitTime = 0;
+    long startTime = currentTimeMillis();
+    {
+        std::lock_guard<std::mutex> lock(jobStateMutex);
+        auto recordIt = jobRecords.find(jobId);
+        if (recordIt != jobRecords.end()) {
+            if (recordIt->second.state == CANCELLED) {
+                return;
+            }
+            recordIt->second.state = RUNNING;
+            recordIt->second.startTime = startTime;
+            submitTime = recordIt->second.submitTime;
+        }
+    }
+
+    TraceContext traceContext(request.getParameter(Conts::PARAM_KEYS::TRACE_ID));
+    if (Tracer::isEnabled() && !Tracer::getCurrentTraceId().empty() && submitTime > 0) {
+        Tracer::Span queueSpan;
+        queueSpan.traceId = Tracer::getCurrentTraceId();
+        queueSpan.name = "scheduler.queue";
+        queueSpan.detail = request.getJobType();
+        queueSpan.startMicros = submitTime * 1000;
+        queueSpan.durationMicros = (startTime - submitTime) * 1000;
+        queueSpan.threadId = 0;
+        Tracer::record(queueSpan);
+    }
+    TraceSpan executeSpan("scheduler.execute", request.getJobType());
+
+    ExecutorFactory executorFactory(sqlite, perfDB);
+    AbstractExecutor *abstractExecutor = executorFactory.getExecutor(request);
     if (abstractExecutor == nullptr) {
         jobScheduler_Logger.error("abstractExecutor is null");
-        return;
+    } else {
+        abstractExecutor->execute();
+        delete abstractExecutor;
     }
-    abstractExecutor->execute();
+
+    bool responded = false;
+    {
+        std::lock_guard<std::mutex> lock(jobStateMutex);
+        auto recordIt = jobRecords.find(jobId);
+        responded = recordIt != jobRecords.end() && recordIt->second.responded;
+    }
+    if (!responded) {
+        // Never leave the frontend session waiting on a job that ended without producing a response
+        JobResponse failedJobResponse;
+        failedJobResponse.setJobId(jobId);
+        failedJobResponse.addParameter(Conts::PARAM_KEYS::ERROR_MESSAGE, "Job finished without a response");
+        JobScheduler::publishResponse(request, failedJobResponse);
+    }
+    JobScheduler::finishJob(jobId, DONE, perfDB);
 }
 
-void JobScheduler::pushJob(JobRequest jobDetails) { jobQueue.push(jobDetails); }
+void JobScheduler::pushJob(JobRequest jobDetails) {
+    JobRecord record;
+    record.jobType = jobDetails.getJobType();
+    record.graphId = jobDetails.getParameter(Conts::PARAM_KEYS::GRAPH_ID);
+    record.priority = jobDetails.getPriority();
+    record.submitTime = currentTimeMillis();
+    {
+        std::lock_guard<std::mutex> lock(jobStateMutex);
+        jobRecords[jobDetails.getJobId()] = record;
+    }
+    {
+        std::lock_guard<std::mutex> lock(jobQueueMutex);
+        jobQueue.push(jobDetails);
+        getSchedulerQueueDepth().set(jobQueue.size());
+    }
+    jobQueueCondition.notify_one();
+}
 
 JobResponse JobScheduler::getResult(JobRequest jobRequest) {
-    JobResponse jobResponse;
-    bool responseFound = false;
-
-    while (!responseFound) {
-        responseVectorMutex.lock();
-        if (responseMap.find(jobRequest.getJobId()) != responseMap.end()) {
-            jobResponse = responseMap[jobRequest.getJobId()];
-            responseFound = true;
+    std::string jobId = jobRequest.getJobId();
+    auto hasResponse = [&jobId] { return responseMap.find(jobId) != responseMap.end(); };
+    std::unique_lock<std::mutex> lock(responseVectorMutex);
+    if (!responseCondition.wait_for(lock, std::chrono::seconds(Conts::JOB_RESULT_TIMEOUT), hasResponse)) {
+        lock.unlock();
+        jobScheduler_Logger.error("##JOB SCHEDULER## No response for job " + jobId + " within " +
+                                  std::to_string(Conts::JOB_RESULT_TIMEOUT) + " s");
+        // A queued job publishes its cancellation as the response. The response of a running job is dropped by
+        // collectCompletedJobs once the job ends.
+        if (!cancelJob(jobId)) {
+            JobResponse timedOutResponse;
+            timedOutResponse.setJobId(jobId);
+            timedOutResponse.addParameter(Conts::PARAM_KEYS::ERROR_MESSAGE, "Timed out waiting for the job");
+            return timedOutResponse;
         }
-        responseVectorMutex.unlock();
-        usleep(50000);
+        lock.lock();
     }
-
+    auto responseIt = responseMap.find(jobId);
+    JobResponse jobResponse = responseIt->second;
+    responseMap.erase(responseIt);
     return jobResponse;
 }
+
+void JobScheduler::publishResponse(JobRequest request, JobResponse response) {
+    JobScheduler::cacheResult(request, response);
+    {
+        std::lock_guard<std::mutex> lock(jobStateMutex);
+        auto recordIt = jobRecords.find(request.getJobId());
+        if (recordIt != jobRecords.end()) {
+            recordIt->second.responded = true;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(responseVectorMutex);
+        responseMap[request.getJobId()] = response;
+    }
+    responseCondition.notify_all();
+}
+
+bool JobScheduler::cancelJob(std::string jobId) {
+    JobRequest request;
+    {
+        std::lock_guard<std::mutex> lock(jobStateMutex);
+        auto recordIt = jobRecords.find(jobId);
+        if (recordIt == jobRecords.end() || recordIt->second.state != QUEUED) {
+            return false;
+        }
+        recordIt->second.state = CANCELLED;
+    }
+    jobScheduler_Logger.info("##JOB SCHEDULER## Cancelled job " + jobId);
+
+    request.setJobId(jobId);
+    JobResponse cancelledJobResponse;
+    cancelledJobResponse.setJobId(jobId);
+    cancelledJobResponse.addParameter(Conts::PARAM_KEYS::ERROR_MESSAGE, "Job cancelled");
+    JobScheduler::publishResponse(request, cancelledJobResponse);
+    JobScheduler::finishJob(jobId, CANCELLED, this->perfSqlite);
+    return true;
+}
+
+JobScheduler::JobState JobScheduler::getJobState(std::string jobId) {
+    std::lock_guard<std::mutex> lock(jobStateMutex);
+    auto recordIt = jobRecords.find(jobId);
+    return recordIt == jobRecords.end() ? UNKNOWN : recordIt->second.state;
+}
+
+void JobScheduler::finishJob(std::string jobId, JobState state, PerformanceSQLiteDBInterface *perfDB) {
+    // Release the admission slot even for a job whose record was already collected
+    admissionController.jobFinished(jobId);
+    JobRecord record;
+    {
+        std::lock_guard<std::mutex> lock(jobStateMutex);
+        auto recordIt = jobRecords.find(jobId);
+        if (recordIt == jobRecords.end()) {
+            return;
+        }
+        recordIt->second.state = state;
+        recordIt->second.endTime = currentTimeMillis();
+        record = recordIt->second;
+    }
+
+    long queueTime = (record.startTime > 0 ? record.startTime : record.endTime) - record.submitTime;
+    long runTime = record.startTime > 0 ? record.endTime - record.startTime : 0;
+    jobScheduler_Logger.info("##JOB SCHEDULER## Job " + jobId + " " + jobStateToString(state) +
+                             " Queue time: " + std::to_string(queueTime) +
+                             " ms Run time: " + std::to_string(runTime) + " ms");
+    if (state == DONE && runTime > 0 && record.estimatedTime > 0) {
+        CostModel::recordJobExecution(record.jobType, record.estimatedTime, runTime);
+    }
+    if (perfDB == NULL) {
+        return;
+    }
+    perfDB->runInsert(
+        "INSERT INTO job_performance (job_id, job_type, graph_id, priority, state, submit_time, queue_time, "
+        "run_time, estimated_time) VALUES ('" +
+        jobId + "','" + record.jobType + "','" + record.graphId + "'," + std::to_string(record.priority) + ",'" +
+        jobStateToString(state) + "'," + std::to_string(record.submitTime) + "," + std::to_string(queueTime) + "," +
+        std::to_string(runTime) + "," + std::to_string(record.estimatedTime) + ")");
+}
+
+void JobScheduler::collectCompletedJobs() {
+    long expiryTime = currentTimeMillis() - Conts::COMPLETED_JOB_RETENTION_TIME * 1000L;
+    std::vector<std::string> expiredJobs;
+    {
+        std::lock_guard<std::mutex> lock(jobStateMutex);
+        for (auto recordIt = jobRecords.begin(); recordIt != jobRecords.end();) {
+            JobState state = recordIt->second.state;
+            if ((state == DONE || state == CANCELLED) && recordIt->second.endTime < expiryTime) {
+                expiredJobs.push_back(recordIt->first);
+                recordIt = jobRecords.erase(recordIt);
+            } else {
+                ++recordIt;
+            }
+        }
+    }
+    if (expiredJobs.empty()) {
+        return;
+    }
+
+    // Responses of sessions that went away before collecting them
+    std::lock_guard<std::mutex> lock(responseVectorMutex);
+    for (auto &jobId : expiredJobs) {
+        responseMap.erase(jobId);
+    }
+    jobScheduler_Logger.info("##JOB SCHEDULER## Garbage collected " + std::to_string(expiredJobs.size()) +
+                             " finished jobs");
+}
+
+std::string JobScheduler::getCachedResultKey(std::string jobType) {
+    if (jobType == TRIANGLES) {
+        return Conts::PARAM_KEYS::TRIANGLE_COUNT;
+    }
+    return "";
+}
+
+bool JobScheduler::getCachedResult(JobRequest jobRequest, std::string &result) {
+    std::string resultKey = JobScheduler::getCachedResultKey(jobRequest.getJobType());
+    if (resultKey.empty()) {
+        return false;
+    }
+
+    std::string graphId = jobRequest.getParameter(Conts::PARAM_KEYS::GRAPH_ID);
+    if (!AnalyticsResultCache::get(graphId, jobRequest.getJobType(), "", result)) {
+        return false;
+    }
+    jobScheduler_Logger.info("##JOB SCHEDULER## Serving " + jobRequest.getJobType() + " of graph " + graphId +
+                             " from the result cache. Hit rate: " + std::to_string(AnalyticsResultCache::getHitRate()));
+    return true;
+}
+
+void JobScheduler::cacheResult(JobRequest request, JobResponse response) {
+    std::string resultKey = JobScheduler::getCachedResultKey(request.getJobType());
+    std::string graphVersion = request.getParameter(Conts::PARAM_KEYS::GRAPH_VERSION);
+    if (resultKey.empty() || graphVersion.empty()) {
+        return;
+    }
+
+    std::string result = response.getParameter(resultKey);
+    if (result.empty() || !response.getParameter(Conts::PARAM_KEYS::ERROR_MESSAGE).empty()) {
+        return;
+    }
+    AnalyticsResultCache::put(request.getParameter(Conts::PARAM_KEYS::GRAPH_ID), request.getJobType(), "",
+                              std::stol(graphVersion), result);
+}
@@ -16,6 +16,8 @@ limitations under the License.
 
 #include <chrono>
 #include <future>
+#include <map>
+#include <string>
 #include <thread>
 
 #include "../../../metadb/SQLiteDBInterface.h"
@@ -25,25 +27,79 @@ limitations under the License.
 #include "../domain/JobRequest.h"
 #include "../domain/JobResponse.h"
 
+/**
+ * Jobs pushed to the scheduler are picked up by a dispatcher thread that is woken through a condition variable.
+ * The dispatcher estimates the run time of the jobs with the CostModel, lets the AdmissionController start, delay
+ * or reject the high priority jobs against their SLA and hands the jobs over to a bounded executor pool per job
+ * class (triangles, PageRank, streaming and the rest). Delayed jobs wait in the dispatcher, not in an executor.
+ * Finished jobs are kept for Conts::COMPLETED_JOB_RETENTION_TIME seconds and garbage collected afterwards.
+ */
 class JobScheduler {
  public:
+    enum JobState { QUEUED, RUNNING, DONE, CANCELLED, UNKNOWN };
+
+    struct JobRecord {
+        std::string jobType;
+        std::string graphId;
+        int priority = 0;
+        JobState state = QUEUED;
+        long submitTime = 0;  // Milliseconds since epoch
+        long startTime = 0;
+        long endTime = 0;
+        long estimatedTime = -1;  // Milliseconds, -1 if the cost model does not cover the job type
+        bool responded = false;
+    };
+
     JobScheduler(SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfDB);
 
     JobScheduler();
 
     void init();
 
-    static void processJob(JobRequest request, SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfDB);
+    // Hand the job over to the executor pool of its job class
+    static void processJob(JobRequest request);
 
     static void executeJob(JobRequest request, SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfDB);
 
     void pushJob(JobRequest jobDetails);
 
+    /**
+     * Block until the response of the job is available. The response is removed once it is returned. After
+     * Conts::JOB_RESULT_TIMEOUT seconds a queued job is cancelled and a running job is left to finish, with an
+     * error response returned in both cases.
+     */
     JobResponse getResult(JobRequest jobRequest);
 
+    // Cancel a job that has not started yet. Running jobs cannot be cancelled.
+    bool cancelJob(std::string jobId);
+
+    static JobState getJobState(std::string jobId);
+
+    static std::string getJobClass(std::string jobType);
+
+    // Make the response of a job visible to getResult and wake up the waiting frontend session
+    static void publishResponse(JobRequest request, JobResponse response);
+
+    // Move the job to its final state and record its queue wait time and run time in the performance DB
+    static void finishJob(std::string jobId, JobState state, PerformanceSQLiteDBInterface *perfDB);
+
+    // Drop finished jobs and responses nobody collected once they are older than the retention time
+    static void collectCompletedJobs();
+
+    /**
+     * Look up the answer of the job in the analytics result cache. Cached answers are returned to the caller
+     * directly, so the job never enters the queue and skips the SLA based scheduling.
+     */
+    bool getCachedResult(JobRequest jobRequest, std::string &result);
+
+    // Store the result of a completed job against the graph version recorded in the request
+    static void cacheResult(JobRequest request, JobResponse response);
+
+    // Name of the response parameter holding the cacheable result of a job type, empty if not cacheable
+    static std::string getCachedResultKey(std::string jobType);
+
     SQLiteDBInterface *sqlite;
     PerformanceSQLiteDBInterface *perfSqlite;
-    static std::vector<std::future<void>> intermRes;
 };
 
 inline bool operator<(const JobRequest& lhs, const JobRequest& rhs) { return lhs.priority < rhs.priority; }
@@ -79,6 +79,7 @@ class JasmineGraphHashMapLocalStore : public JasmineGraphLocalStore {
         auto edgeStoreData = GetPartEdgeMapStore(data);
 
         toLocalSubGraphMap(edgeStoreData);
+        delete[] data;
 
         result = true;
 
@@ -108,7 +109,7 @@ class JasmineGraphHashMapLocalStore : public JasmineGraphLocalStore {
 
     map<long, long> getInDegreeDistributionHashMap();
 
-    map<long, unordered_set<long>> getUnderlyingHashMap();
+    const map<long, unordered_set<long>> &getUnderlyingHashMap() const;
 
     void initialize();
 
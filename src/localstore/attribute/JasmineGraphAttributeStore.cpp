@@ -0,0 +1,413 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "JasmineGraphAttributeStore.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+
+#include "../../util/logger/Logger.h"
+
+Logger attribute_store_logger;
+
+const uint32_t JasmineGraphAttributeStore::MAGIC = 0x4341474a;  // "JGAC"
+const uint32_t JasmineGraphAttributeStore::VERSION = 1;
+
+static const size_t HEADER_SIZE = 2 * sizeof(uint32_t) + sizeof(uint64_t) + 2 * sizeof(uint32_t);
+static const size_t COLUMN_HEADER_SIZE = 2 * sizeof(uint32_t) + 3 * sizeof(uint64_t);
+// Integers, floats and dictionary codes all take 4 bytes
+static const size_t VALUE_SIZE = 4;
+
+static uint64_t align(uint64_t offset) { return (offset + 7) & ~static_cast<uint64_t>(7); }
+
+static bool parseInt(const std::string &value, int32_t &result) {
+    if (value.empty()) {
+        return false;
+    }
+    char *end;
+    errno = 0;
+    long parsed = strtol(value.c_str(), &end, 10);
+    if (*end != '\0' || errno != 0 || parsed < INT32_MIN || parsed > INT32_MAX) {
+        return false;
+    }
+    result = parsed;
+    return true;
+}
+
+static bool parseFloat(const std::string &value, float &result) {
+    if (value.empty()) {
+        return false;
+    }
+    char *end;
+    result = strtof(value.c_str(), &end);
+    return *end == '\0';
+}
+
+JasmineGraphAttributeStore::JasmineGraphAttributeStore(std::string storePath) : storePath(storePath) {}
+
+JasmineGraphAttributeStore::~JasmineGraphAttributeStore() { close(); }
+
+std::string JasmineGraphAttributeStore::getStorePath(std::string folderLocation, std::string attributeFileName) {
+    return folderLocation + "/" + attributeFileName + ".columnar";
+}
+
+bool JasmineGraphAttributeStore::convertTextFile(const std::string &textFilePath, const std::string &storePath) {
+    std::ifstream textFile(textFilePath);
+    if (!textFile.is_open()) {
+        attribute_store_logger.error("Cannot open attribute file " + textFilePath);
+        return false;
+    }
+
+    JasmineGraphAttributeStore store(storePath);
+    std::string line;
+    std::vector<std::string> values;
+    while (std::getline(textFile, line)) {
+        // The partitioner separates the vertex with a tab and keeps the separator of the input for the attributes
+        values.clear();
+        size_t start = line.find_first_not_of(" \t,\r");
+        while (start != std::string::npos) {
+            size_t end = line.find_first_of(" \t,\r", start);
+            values.push_back(line.substr(start, end == std::string::npos ? std::string::npos : end - start));
+            start = end == std::string::npos ? end : line.find_first_not_of(" \t,\r", end);
+        }
+        if (values.empty()) {
+            continue;
+        }
+        char *end;
+        long vertex = strtol(values[0].c_str(), &end, 10);
+        if (*end != '\0') {
+            attribute_store_logger.warn("Skipping attribute line without a vertex id in " + textFilePath);
+            continue;
+        }
+        values.erase(values.begin());
+        store.addRow(vertex, values);
+    }
+    return store.persist();
+}
+
+void JasmineGraphAttributeStore::addRow(long vertex, const std::vector<std::string> &values) {
+    pendingRows[vertex] = values;
+}
+
+bool JasmineGraphAttributeStore::persist() {
+    size_t maxWidth = 0;
+    bool sameWidth = true;
+    for (auto &row : pendingRows) {
+        if (maxWidth != 0 && row.second.size() != maxWidth) {
+            sameWidth = false;
+        }
+        maxWidth = std::max(maxWidth, row.second.size());
+    }
+
+    // Infer the type of every attribute position from all the rows that have it
+    std::vector<ColumnType> types(maxWidth, INT);
+    for (auto &row : pendingRows) {
+        for (size_t i = 0; i < row.second.size(); i++) {
+            int32_t intValue;
+            float floatValue;
+            if (types[i] == INT && !parseInt(row.second[i], intValue)) {
+                types[i] = FLOAT;
+            }
+            if (types[i] == FLOAT && !parseFloat(row.second[i], floatValue)) {
+                types[i] = STRING;
+            }
+        }
+    }
+    bool numeric = std::find(types.begin(), types.end(), STRING) == types.end();
+    bool integral = std::find(types.begin(), types.end(), FLOAT) == types.end();
+
+    std::vector<ColumnType> columnTypes;
+    std::vector<uint32_t> widths;
+    if (sameWidth && numeric && maxWidth > 1) {
+        // Floats hold integers exactly only up to 2^24, so a vector of integers keeps them as integers
+        columnTypes.push_back(integral ? INT_VECTOR : FLOAT_VECTOR);
+        widths.push_back(maxWidth);
+    } else {
+        columnTypes = types;
+        widths.assign(maxWidth, 1);
+    }
+
+    uint64_t count = pendingRows.size();
+    std::vector<std::vector<char>> columnData(columnTypes.size());
+    std::vector<std::vector<std::string>> dictionaries(columnTypes.size());
+    for (size_t column = 0; column < columnTypes.size(); column++) {
+        columnData[column].resize(count * widths[column] * VALUE_SIZE);
+        std::unordered_map<std::string, uint32_t> codes;
+        char *cursor = columnData[column].data();
+        for (auto &row : pendingRows) {
+            for (uint32_t i = 0; i < widths[column]; i++) {
+                // A row without the attribute reads as 0, NaN or an empty string
+                bool vector = columnTypes[column] == FLOAT_VECTOR || columnTypes[column] == INT_VECTOR;
+                size_t position = vector ? i : column;
+                bool present = position < row.second.size();
+                const std::string &value = present ? row.second[position] : "";
+                if (columnTypes[column] == INT || columnTypes[column] == INT_VECTOR) {
+                    int32_t intValue = 0;
+                    if (present) {
+                        parseInt(value, intValue);
+                    }
+                    memcpy(cursor, &intValue, VALUE_SIZE);
+                } else if (columnTypes[column] == STRING) {
+                    auto code = codes.find(value);
+                    if (code == codes.end()) {
+                        code = codes.emplace(value, dictionaries[column].size()).first;
+                        dictionaries[column].push_back(value);
+                    }
+                    memcpy(cursor, &code->second, VALUE_SIZE);
+                } else {
+                    float floatValue = NAN;
+                    if (present) {
+                        parseFloat(value, floatValue);
+                    }
+                    memcpy(cursor, &floatValue, VALUE_SIZE);
+                }
+                cursor += VALUE_SIZE;
+            }
+        }
+    }
+
+    // Lay out the sections after the header and the column descriptors
+    uint64_t verticesOffset = align(HEADER_SIZE + columnTypes.size() * COLUMN_HEADER_SIZE);
+    uint64_t offset = align(verticesOffset + count * sizeof(int64_t));
+    std::vector<uint64_t> dataOffsets;
+    std::vector<uint64_t> dictionaryOffsets;
+    std::vector<std::vector<uint32_t>> entryOffsets(columnTypes.size());
+    for (size_t column = 0; column < columnTypes.size(); column++) {
+        dataOffsets.push_back(offset);
+        offset = align(offset + columnData[column].size());
+        dictionaryOffsets.push_back(columnTypes[column] == STRING ? offset : 0);
+        if (columnTypes[column] == STRING) {
+            uint32_t entryOffset = 0;
+            for (auto &entry : dictionaries[column]) {
+                entryOffsets[column].push_back(entryOffset);
+                entryOffset += entry.size();
+            }
+            entryOffsets[column].push_back(entryOffset);
+            offset = align(offset + entryOffsets[column].size() * sizeof(uint32_t) + entryOffset);
+        }
+    }
+
+    std::vector<char> buffer(offset, 0);
+    char *cursor = buffer.data();
+    uint32_t columnCount = columnTypes.size();
+    uint32_t reserved = 0;
+    memcpy(cursor, &MAGIC, sizeof(uint32_t));
+    memcpy(cursor + 4, &VERSION, sizeof(uint32_t));
+    memcpy(cursor + 8, &count, sizeof(uint64_t));
+    memcpy(cursor + 16, &columnCount, sizeof(uint32_t));
+    memcpy(cursor + 20, &reserved, sizeof(uint32_t));
+    cursor += HEADER_SIZE;
+    for (size_t column = 0; column < columnTypes.size(); column++) {
+        uint32_t type = columnTypes[column];
+        uint64_t dictionarySize = dictionaries[column].size();
+        memcpy(cursor, &type, sizeof(uint32_t));
+        memcpy(cursor + 4, &widths[column], sizeof(uint32_t));
+        memcpy(cursor + 8, &dataOffsets[column], sizeof(uint64_t));
+        memcpy(cursor + 16, &dictionaryOffsets[column], sizeof(uint64_t));
+        memcpy(cursor + 24, &dictionarySize, sizeof(uint64_t));
+        cursor += COLUMN_HEADER_SIZE;
+    }
+
+    cursor = buffer.data() + verticesOffset;
+    for (auto &row : pendingRows) {
+        int64_t vertex = row.first;
+        memcpy(cursor, &vertex, sizeof(int64_t));
+        cursor += sizeof(int64_t);
+    }
+    for (size_t column = 0; column < columnTypes.size(); column++) {
+        memcpy(buffer.data() + dataOffsets[column], columnData[column].data(), columnData[column].size());
+        if (columnTypes[column] == STRING) {
+            cursor = buffer.data() + dictionaryOffsets[column];
+            memcpy(cursor, entryOffsets[column].data(), entryOffsets[column].size() * sizeof(uint32_t));
+            cursor += entryOffsets[column].size() * sizeof(uint32_t);
+            for (auto &entry : dictionaries[column]) {
+                memcpy(cursor, entry.data(), entry.size());
+                cursor += entry.size();
+            }
+        }
+    }
+
+    // Write to a temporary file and rename it so readers never map a partially written store
+    std::string tempPath = storePath + ".tmp";
+    std::ofstream storeFile(tempPath, std::ios::binary | std::ios::trunc);
+    if (!storeFile.is_open()) {
+        attribute_store_logger.error("Cannot open attribute store " + tempPath + " for writing");
+        return false;
+    }
+    storeFile.write(buffer.data(), buffer.size());
+    storeFile.close();
+    if (!storeFile) {
+        attribute_store_logger.error("Error while writing attribute store " + tempPath);
+        return false;
+    }
+    if (std::rename(tempPath.c_str(), storePath.c_str()) != 0) {
+        attribute_store_logger.error("Cannot move attribute store into place " + storePath);
+        return false;
+    }
+    pendingRows.clear();
+    return true;
+}
+
+bool JasmineGraphAttributeStore::open() {
+    close();
+    int fd = ::open(storePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < HEADER_SIZE) {
+        ::close(fd);
+        attribute_store_logger.warn("Ignoring truncated attribute store " + storePath);
+        return false;
+    }
+    void *mapped = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        attribute_store_logger.error("Cannot map attribute store " + storePath);
+        return false;
+    }
+    mapping = static_cast<char *>(mapped);
+    mappingSize = fileStat.st_size;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t columnCount;
+    memcpy(&magic, mapping, sizeof(uint32_t));
+    memcpy(&version, mapping + 4, sizeof(uint32_t));
+    memcpy(&rowCount, mapping + 8, sizeof(uint64_t));
+    memcpy(&columnCount, mapping + 16, sizeof(uint32_t));
+    uint64_t verticesOffset = align(HEADER_SIZE + static_cast<uint64_t>(columnCount) * COLUMN_HEADER_SIZE);
+    if (magic != MAGIC || version != VERSION || verticesOffset + rowCount * sizeof(int64_t) > mappingSize) {
+        attribute_store_logger.warn("Ignoring incompatible attribute store " + storePath);
+        close();
+        return false;
+    }
+    vertices = reinterpret_cast<const int64_t *>(mapping + verticesOffset);
+
+    const char *cursor = mapping + HEADER_SIZE;
+    for (uint32_t i = 0; i < columnCount; i++) {
+        uint32_t type;
+        uint64_t dataOffset;
+        uint64_t dictionaryOffset;
+        Column column;
+        memcpy(&type, cursor, sizeof(uint32_t));
+        memcpy(&column.width, cursor + 4, sizeof(uint32_t));
+        memcpy(&dataOffset, cursor + 8, sizeof(uint64_t));
+        memcpy(&dictionaryOffset, cursor + 16, sizeof(uint64_t));
+        memcpy(&column.dictionarySize, cursor + 24, sizeof(uint64_t));
+        cursor += COLUMN_HEADER_SIZE;
+
+        column.type = static_cast<ColumnType>(type);
+        column.data = mapping + dataOffset;
+        column.dictionaryOffsets = NULL;
+        column.dictionary = NULL;
+        bool valid = type <= INT_VECTOR && dataOffset + rowCount * column.width * VALUE_SIZE <= mappingSize;
+        if (valid && column.type == STRING) {
+            uint64_t dictionaryStart = dictionaryOffset + (column.dictionarySize + 1) * sizeof(uint32_t);
+            valid = dictionaryStart <= mappingSize;
+            if (valid) {
+                column.dictionaryOffsets = reinterpret_cast<const uint32_t *>(mapping + dictionaryOffset);
+                column.dictionary = mapping + dictionaryStart;
+                valid = dictionaryStart + column.dictionaryOffsets[column.dictionarySize] <= mappingSize;
+            }
+        }
+        if (!valid) {
+            attribute_store_logger.warn("Ignoring corrupt attribute store " + storePath);
+            close();
+            return false;
+        }
+        columns.push_back(column);
+    }
+    return true;
+}
+
+void JasmineGraphAttributeStore::close() {
+    if (mapping != NULL) {
+        munmap(mapping, mappingSize);
+    }
+    mapping = NULL;
+    mappingSize = 0;
+    rowCount = 0;
+    vertices = NULL;
+    columns.clear();
+}
+
+long JasmineGraphAttributeStore::getRowIndex(long vertex) {
+    const int64_t *row = std::lower_bound(vertices, vertices + rowCount, vertex);
+    return row != vertices + rowCount && *row == vertex ? row - vertices : -1;
+}
+
+int32_t JasmineGraphAttributeStore::getInt(long row, int column) {
+    return reinterpret_cast<const int32_t *>(columns[column].data)[row];
+}
+
+float JasmineGraphAttributeStore::getFloat(long row, int column) {
+    return reinterpret_cast<const float *>(columns[column].data)[row];
+}
+
+const float *JasmineGraphAttributeStore::getVector(long row, int column) {
+    return reinterpret_cast<const float *>(columns[column].data) + row * columns[column].width;
+}
+
+const int32_t *JasmineGraphAttributeStore::getIntVector(long row, int column) {
+    return reinterpret_cast<const int32_t *>(columns[column].data) + row * columns[column].width;
+}
+
+const char *JasmineGraphAttributeStore::getString(long row, int column, uint32_t &length) {
+    const Column &stringColumn = columns[column];
+    uint32_t code = reinterpret_cast<const uint32_t *>(stringColumn.data)[row];
+    length = stringColumn.dictionaryOffsets[code + 1] - stringColumn.dictionaryOffsets[code];
+    return stringColumn.dictionary + stringColumn.dictionaryOffsets[code];
+}
+
+std::vector<std::string> JasmineGraphAttributeStore::getRowValues(long row) {
+    std::vector<std::string> values;
+    for (int column = 0; column < getColumnCount(); column++) {
+        if (columns[column].type == INT || columns[column].type == INT_VECTOR) {
+            // An integer column is a vector of width 1
+            const int32_t *features = getIntVector(row, column);
+            for (uint32_t i = 0; i < columns[column].width; i++) {
+                values.push_back(std::to_string(features[i]));
+            }
+        } else if (columns[column].type == STRING) {
+            uint32_t length;
+            const char *value = getString(row, column, length);
+            values.push_back(std::string(value, length));
+        } else {
+            // A float column is a vector of width 1
+            const float *features = getVector(row, column);
+            for (uint32_t i = 0; i < columns[column].width; i++) {
+                // Enough digits to read back the same float
+                std::ostringstream value;
+                value.precision(std::numeric_limits<float>::max_digits10);
+                value << features[i];
+                values.push_back(value.str());
+            }
+        }
+    }
+    return values;
+}
@@ -0,0 +1,113 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_JASMINEGRAPHATTRIBUTESTORE_H
+#define JASMINEGRAPH_JASMINEGRAPHATTRIBUTESTORE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Columnar store of the vertex attributes of a partition, written next to the text attribute file the
+ * partitioner ships (<graphId>_attributes_<partitionId>.columnar). Each attribute position becomes a typed column:
+ * 32 bit integers, floats or dictionary encoded strings. Rows of only numbers, as the feature rows of a feature
+ * graph are, are stored as a single dense vector column instead, which takes 4 bytes per feature. The vector holds
+ * integers when every value is one, so integer attributes are never rounded to floats.
+ *
+ * The file is a header and column descriptors followed by the sorted vertex ids, which are the row index, and the
+ * column data, all 8 byte aligned. Readers map it and read the values in place without parsing or allocating.
+ */
+class JasmineGraphAttributeStore {
+ public:
+    enum ColumnType : uint32_t { INT = 0, FLOAT = 1, FLOAT_VECTOR = 2, STRING = 3, INT_VECTOR = 4 };
+
+    static const uint32_t MAGIC;
+    static const uint32_t VERSION;
+
+    explicit JasmineGraphAttributeStore(std::string storePath);
+
+    JasmineGraphAttributeStore(const JasmineGraphAttributeStore &) = delete;
+
+    JasmineGraphAttributeStore &operator=(const JasmineGraphAttributeStore &) = delete;
+
+    ~JasmineGraphAttributeStore();
+
+    static std::string getStorePath(std::string folderLocation, std::string attributeFileName);
+
+    // Build the store from a text attribute file with one vertex id and its attributes per line
+    static bool convertTextFile(const std::string &textFilePath, const std::string &storePath);
+
+    // Rows are buffered until persist, which infers the column types from all of them
+    void addRow(long vertex, const std::vector<std::string> &values);
+
+    bool persist();
+
+    // Map the store for reading
+    bool open();
+
+    void close();
+
+    bool isOpen() { return mapping != NULL; }
+
+    long size() { return rowCount; }
+
+    int getColumnCount() { return columns.size(); }
+
+    ColumnType getColumnType(int column) { return columns[column].type; }
+
+    // Number of values in a row of the column, the feature count for a vector column
+    int getWidth(int column) { return columns[column].width; }
+
+    // Row of the vertex, -1 if the partition has no attributes for it
+    long getRowIndex(long vertex);
+
+    long getVertex(long row) { return vertices[row]; }
+
+    int32_t getInt(long row, int column);
+
+    float getFloat(long row, int column);
+
+    // The getWidth(column) features of the row, valid while the store is open
+    const float *getVector(long row, int column);
+
+    const int32_t *getIntVector(long row, int column);
+
+    // The dictionary entry of the row, valid while the store is open
+    const char *getString(long row, int column, uint32_t &length);
+
+    // The attributes of the row formatted as text, for callers of the text attribute format
+    std::vector<std::string> getRowValues(long row);
+
+ private:
+    struct Column {
+        ColumnType type;
+        uint32_t width;
+        const char *data;
+        const uint32_t *dictionaryOffsets;
+        const char *dictionary;
+        uint64_t dictionarySize;
+    };
+
+    std::string storePath;
+    std::map<long, std::vector<std::string>> pendingRows;
+
+    char *mapping = NULL;
+    size_t mappingSize = 0;
+    uint64_t rowCount = 0;
+    const int64_t *vertices = NULL;
+    std::vector<Column> columns;
+};
+
+#endif  // JASMINEGRAPH_JASMINEGRAPHATTRIBUTESTORE_H
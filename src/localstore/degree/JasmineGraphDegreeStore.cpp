@@ -0,0 +1,312 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "JasmineGraphDegreeStore.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "../../util/logger/Logger.h"
+
+Logger degree_store_logger;
+
+const uint32_t JasmineGraphDegreeStore::MAGIC = 0x4444474a;  // "JGDD"
+const uint32_t JasmineGraphDegreeStore::VERSION = 1;
+const char *JasmineGraphDegreeStore::DIRTY_MARKER_SUFFIX = ".dirty";
+
+static const uint32_t DISTRIBUTION_MAGIC = 0x5644474a;  // "JGDV"
+static const size_t RECORD_SIZE = sizeof(int64_t) + 4 * sizeof(uint32_t);
+
+JasmineGraphDegreeStore::JasmineGraphDegreeStore(std::string graphId, std::string partitionId,
+                                                 std::string folderLocation) {
+    this->graphId = graphId;
+    this->partitionId = partitionId;
+    this->storePath = getStorePath(folderLocation, graphId, partitionId);
+}
+
+std::string JasmineGraphDegreeStore::getStorePath(std::string folderLocation, std::string graphId,
+                                                  std::string partitionId) {
+    return folderLocation + "/" + graphId + "_degree_" + partitionId;
+}
+
+void JasmineGraphDegreeStore::build(const std::map<long, std::unordered_set<long>> &localGraphMap,
+                                    const std::map<long, std::unordered_set<long>> &centralGraphMap) {
+    degreeMap.clear();
+    for (auto it = localGraphMap.begin(); it != localGraphMap.end(); ++it) {
+        DegreeEntry &entry = degreeMap[it->first];
+        entry.outDegree += it->second.size();
+        entry.owned = 1;
+        for (auto endVid : it->second) {
+            degreeMap[endVid].localInDegree++;
+        }
+    }
+
+    for (auto it = centralGraphMap.begin(); it != centralGraphMap.end(); ++it) {
+        auto ownerIt = localGraphMap.find(it->first);
+        if (ownerIt != localGraphMap.end()) {
+            degreeMap[it->first].outDegree += it->second.size();
+        }
+        for (auto endVid : it->second) {
+            degreeMap[endVid].centralInDegree++;
+        }
+    }
+    pendingUpdates = degreeMap.size();
+}
+
+long JasmineGraphDegreeStore::addEdge(long startVid, long endVid, bool isCentral, bool sourceOwned) {
+    if (pendingUpdates == 0) {
+        markDirty();
+    }
+    DegreeEntry &source = degreeMap[startVid];
+    source.outDegree++;
+    if (!isCentral || sourceOwned) {
+        source.owned = 1;
+    }
+    DegreeEntry &destination = degreeMap[endVid];
+    if (isCentral) {
+        destination.centralInDegree++;
+    } else {
+        destination.localInDegree++;
+        destination.owned = 1;
+    }
+    return ++pendingUpdates;
+}
+
+bool JasmineGraphDegreeStore::exists() {
+    std::ifstream storeFile(storePath, std::ios::binary);
+    return storeFile.good();
+}
+
+bool JasmineGraphDegreeStore::markDirty() {
+    std::ofstream markerFile(getDirtyMarkerPath(), std::ios::trunc);
+    if (!markerFile.is_open()) {
+        degree_store_logger.error("Cannot mark degree store " + storePath + " dirty");
+        return false;
+    }
+    return true;
+}
+
+bool JasmineGraphDegreeStore::isMarkedDirty() {
+    std::ifstream markerFile(getDirtyMarkerPath());
+    return markerFile.good();
+}
+
+bool JasmineGraphDegreeStore::load() {
+    if (isMarkedDirty()) {
+        degree_store_logger.warn("Degree store " + storePath + " is behind its partition store");
+        return false;
+    }
+    std::ifstream storeFile(storePath, std::ios::binary | std::ios::in);
+    if (!storeFile.is_open()) {
+        return false;
+    }
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t count = 0;
+    storeFile.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    storeFile.read(reinterpret_cast<char *>(&version), sizeof(version));
+    storeFile.read(reinterpret_cast<char *>(&count), sizeof(count));
+    if (!storeFile || magic != MAGIC || version != VERSION) {
+        degree_store_logger.warn("Ignoring incompatible degree store " + storePath);
+        return false;
+    }
+
+    std::vector<char> buffer(count * RECORD_SIZE);
+    if (!storeFile.read(buffer.data(), buffer.size())) {
+        degree_store_logger.error("Degree store " + storePath + " is truncated");
+        return false;
+    }
+
+    degreeMap.clear();
+    const char *cursor = buffer.data();
+    for (uint64_t i = 0; i < count; i++) {
+        int64_t vertex;
+        DegreeEntry entry;
+        memcpy(&vertex, cursor, sizeof(vertex));
+        cursor += sizeof(vertex);
+        memcpy(&entry.outDegree, cursor, sizeof(uint32_t));
+        cursor += sizeof(uint32_t);
+        memcpy(&entry.localInDegree, cursor, sizeof(uint32_t));
+        cursor += sizeof(uint32_t);
+        memcpy(&entry.centralInDegree, cursor, sizeof(uint32_t));
+        cursor += sizeof(uint32_t);
+        memcpy(&entry.owned, cursor, sizeof(uint32_t));
+        cursor += sizeof(uint32_t);
+        degreeMap.emplace_hint(degreeMap.end(), vertex, entry);
+    }
+    pendingUpdates = 0;
+    return true;
+}
+
+bool JasmineGraphDegreeStore::persist() {
+    // Write to a temporary file and rename it so readers never observe a partially written sidecar
+    std::string tempPath = storePath + ".tmp";
+    std::ofstream storeFile(tempPath, std::ios::binary | std::ios::trunc);
+    if (!storeFile.is_open()) {
+        degree_store_logger.error("Cannot open degree store " + tempPath + " for writing");
+        return false;
+    }
+
+    uint64_t count = degreeMap.size();
+    storeFile.write(reinterpret_cast<const char *>(&MAGIC), sizeof(MAGIC));
+    storeFile.write(reinterpret_cast<const char *>(&VERSION), sizeof(VERSION));
+    storeFile.write(reinterpret_cast<const char *>(&count), sizeof(count));
+
+    std::vector<char> buffer(count * RECORD_SIZE);
+    char *cursor = buffer.data();
+    for (auto it = degreeMap.begin(); it != degreeMap.end(); ++it) {
+        int64_t vertex = it->first;
+        memcpy(cursor, &vertex, sizeof(vertex));
+        cursor += sizeof(vertex);
+        memcpy(cursor, &it->second.outDegree, sizeof(uint32_t));
+        cursor += sizeof(uint32_t);
+        memcpy(cursor, &it->second.localInDegree, sizeof(uint32_t));
+        cursor += sizeof(uint32_t);
+        memcpy(cursor, &it->second.centralInDegree, sizeof(uint32_t));
+        cursor += sizeof(uint32_t);
+        memcpy(cursor, &it->second.owned, sizeof(uint32_t));
+        cursor += sizeof(uint32_t);
+    }
+    storeFile.write(buffer.data(), buffer.size());
+    storeFile.close();
+    if (!storeFile) {
+        degree_store_logger.error("Error while writing degree store " + tempPath);
+        return false;
+    }
+
+    if (std::rename(tempPath.c_str(), storePath.c_str()) != 0) {
+        degree_store_logger.error("Cannot move degree store into place " + storePath);
+        return false;
+    }
+    std::remove(getDirtyMarkerPath().c_str());
+    pendingUpdates = 0;
+    return true;
+}
+
+std::map<long, long> JasmineGraphDegreeStore::getOutDegreeDistribution() {
+    std::map<long, long> distribution;
+    for (auto it = degreeMap.begin(); it != degreeMap.end(); ++it) {
+        // Vertices that only appear as central edge destinations belong to other partitions
+        if (it->second.owned) {
+            distribution.emplace_hint(distribution.end(), it->first, it->second.outDegree);
+        }
+    }
+    return distribution;
+}
+
+std::map<long, long> JasmineGraphDegreeStore::getLocalInDegreeDistribution() {
+    std::map<long, long> distribution;
+    for (auto it = degreeMap.begin(); it != degreeMap.end(); ++it) {
+        if (it->second.localInDegree > 0) {
+            distribution.emplace_hint(distribution.end(), it->first, it->second.localInDegree);
+        }
+    }
+    return distribution;
+}
+
+std::map<long, long> JasmineGraphDegreeStore::getCentralInDegreeDistribution() {
+    std::map<long, long> distribution;
+    for (auto it = degreeMap.begin(); it != degreeMap.end(); ++it) {
+        if (it->second.centralInDegree > 0) {
+            distribution.emplace_hint(distribution.end(), it->first, it->second.centralInDegree);
+        }
+    }
+    return distribution;
+}
+
+std::map<long, long> JasmineGraphDegreeStore::toHistogram(const std::map<long, long> &distribution) {
+    std::map<long, long> histogram;
+    for (auto it = distribution.begin(); it != distribution.end(); ++it) {
+        histogram[it->second]++;
+    }
+    return histogram;
+}
+
+std::string JasmineGraphDegreeStore::histogramToString(const std::map<long, long> &histogram) {
+    std::stringstream histogramStream;
+    for (auto it = histogram.begin(); it != histogram.end(); ++it) {
+        if (it != histogram.begin()) {
+            histogramStream << ",";
+        }
+        histogramStream << it->first << ":" << it->second;
+    }
+    return histogramStream.str();
+}
+
+std::map<long, long> JasmineGraphDegreeStore::histogramFromString(const std::string &histogram) {
+    std::map<long, long> result;
+    std::stringstream histogramStream(histogram);
+    std::string bucket;
+    while (std::getline(histogramStream, bucket, ',')) {
+        size_t separator = bucket.find(':');
+        if (separator == std::string::npos) {
+            continue;
+        }
+        result[std::stol(bucket.substr(0, separator))] += std::stol(bucket.substr(separator + 1));
+    }
+    return result;
+}
+
+bool JasmineGraphDegreeStore::writeDistribution(const std::string &filePath,
+                                                const std::map<long, long> &distribution) {
+    std::ofstream distributionFile(filePath, std::ios::binary | std::ios::trunc);
+    if (!distributionFile.is_open()) {
+        degree_store_logger.error("Cannot open degree distribution file " + filePath);
+        return false;
+    }
+
+    uint64_t count = distribution.size();
+    distributionFile.write(reinterpret_cast<const char *>(&DISTRIBUTION_MAGIC), sizeof(DISTRIBUTION_MAGIC));
+    distributionFile.write(reinterpret_cast<const char *>(&count), sizeof(count));
+
+    std::vector<int64_t> buffer;
+    buffer.reserve(count * 2);
+    for (auto it = distribution.begin(); it != distribution.end(); ++it) {
+        buffer.push_back(it->first);
+        buffer.push_back(it->second);
+    }
+    distributionFile.write(reinterpret_cast<const char *>(buffer.data()), buffer.size() * sizeof(int64_t));
+    distributionFile.close();
+    return !distributionFile.fail();
+}
+
+std::map<long, long> JasmineGraphDegreeStore::readDistribution(const std::string &filePath) {
+    std::map<long, long> distribution;
+    std::ifstream distributionFile(filePath, std::ios::binary | std::ios::in);
+    if (!distributionFile.is_open()) {
+        return distribution;
+    }
+
+    uint32_t magic = 0;
+    uint64_t count = 0;
+    distributionFile.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    distributionFile.read(reinterpret_cast<char *>(&count), sizeof(count));
+    if (!distributionFile || magic != DISTRIBUTION_MAGIC) {
+        degree_store_logger.error("Invalid degree distribution file " + filePath);
+        return distribution;
+    }
+
+    std::vector<int64_t> buffer(count * 2);
+    if (!distributionFile.read(reinterpret_cast<char *>(buffer.data()), buffer.size() * sizeof(int64_t))) {
+        degree_store_logger.error("Degree distribution file " + filePath + " is truncated");
+        return distribution;
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        distribution.emplace_hint(distribution.end(), buffer[2 * i], buffer[2 * i + 1]);
+    }
+    return distribution;
+}
@@ -0,0 +1,106 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_JASMINEGRAPHDEGREESTORE_H
+#define JASMINEGRAPH_JASMINEGRAPHDEGREESTORE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_set>
+
+/**
+ * Per partition degree cache persisted as a binary sidecar (<graphId>_degree_<partitionId>) next to the
+ * partition stores. The sidecar is built once when a partition is uploaded, updated edge by edge by the
+ * incremental (streaming) store and read back when the master asks for in/out degree distributions, so the
+ * local and central hash map stores do not have to be loaded and walked on every query.
+ */
+class JasmineGraphDegreeStore {
+ public:
+    struct DegreeEntry {
+        uint32_t outDegree = 0;         // Local out degree plus the central out degree of the vertex
+        uint32_t localInDegree = 0;     // In degree contributed by local edges of this partition
+        uint32_t centralInDegree = 0;   // In degree contributed by the central store of this partition
+        uint32_t owned = 0;             // Non zero when the vertex is a vertex of the local store
+    };
+
+    static const uint32_t MAGIC;
+    static const uint32_t VERSION;
+    static const char *DIRTY_MARKER_SUFFIX;
+
+    JasmineGraphDegreeStore(std::string graphId, std::string partitionId, std::string folderLocation);
+
+    /**
+     * Rebuild the degree entries from the adjacency maps of the local and central store of the partition.
+     * Central out edges are only counted for vertices owned by the local store, which matches the semantics of
+     * the out degree distribution computed from the hash map stores.
+     */
+    void build(const std::map<long, std::unordered_set<long>> &localGraphMap,
+               const std::map<long, std::unordered_set<long>> &centralGraphMap);
+
+    /**
+     * Record one newly inserted edge. The source of a local edge is always a vertex of this partition, the source
+     * of a central edge only when sourceOwned is set. The first update after a persist marks the sidecar dirty.
+     * Returns the number of pending updates not yet persisted.
+     */
+    long addEdge(long startVid, long endVid, bool isCentral, bool sourceOwned);
+
+    // Leave a marker next to the sidecar telling readers it is behind its partition store until the next persist
+    bool markDirty();
+
+    bool isMarkedDirty();
+
+    // Fails for a missing, incompatible or dirty sidecar
+    bool load();
+
+    bool persist();
+
+    bool exists();
+
+    bool isDirty() { return pendingUpdates > 0; }
+
+    long size() { return degreeMap.size(); }
+
+    std::map<long, long> getOutDegreeDistribution();
+
+    std::map<long, long> getLocalInDegreeDistribution();
+
+    std::map<long, long> getCentralInDegreeDistribution();
+
+    std::string getStorePath() { return storePath; }
+
+    std::string getDirtyMarkerPath() { return storePath + DIRTY_MARKER_SUFFIX; }
+
+    static std::string getStorePath(std::string folderLocation, std::string graphId, std::string partitionId);
+
+    // Convert a vertex -> degree distribution to a degree -> number of vertices histogram.
+    static std::map<long, long> toHistogram(const std::map<long, long> &distribution);
+
+    static std::string histogramToString(const std::map<long, long> &histogram);
+
+    static std::map<long, long> histogramFromString(const std::string &histogram);
+
+    // Binary vertex -> degree files used to share distributions between workers (e.g. the _idd_ files)
+    static bool writeDistribution(const std::string &filePath, const std::map<long, long> &distribution);
+
+    static std::map<long, long> readDistribution(const std::string &filePath);
+
+ private:
+    std::string graphId;
+    std::string partitionId;
+    std::string storePath;
+    std::map<long, DegreeEntry> degreeMap;
+    long pendingUpdates = 0;
+};
+
+#endif  // JASMINEGRAPH_JASMINEGRAPHDEGREESTORE_H
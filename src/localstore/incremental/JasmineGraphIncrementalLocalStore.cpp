@@ -29,8 +29,42 @@ JasmineGraphIncrementalLocalStore::JasmineGraphIncrementalLocalStore(unsigned in
     gc.maxLabelSize = std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size"));
     gc.openMode = openMode;
     this->nm = new NodeManager(gc);
+    this->degreeStore =
+        new JasmineGraphDegreeStore(std::to_string(graphID), std::to_string(partitionID),
+                                    Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder"));
+    if (openMode != "app") {
+        // The partition store was truncated, the sidecar of an earlier stream no longer describes it
+        this->degreeStore->markDirty();
+    } else if (!this->degreeStore->load()) {
+        // Missing, or left dirty by a store that was never closed
+        try {
+            this->degreeStore->build(this->nm->getAdjacencyList(true), this->nm->getAdjacencyList(false));
+            this->degreeStore->persist();
+        } catch (const std::exception &e) {
+            incremental_localstore_logger.warn("Cannot rebuild the degree store of " + std::to_string(graphID) +
+                                               "_" + std::to_string(partitionID) + " : " + e.what());
+            this->degreeStore->markDirty();
+        }
+    }
 };
 
+void JasmineGraphIncrementalLocalStore::close() {
+    if (!this->nm) {
+        return;
+    }
+    if (this->degreeStore->isDirty()) {
+        this->degreeStore->persist();
+    }
+    this->nm->close();
+    delete this->nm;
+    this->nm = NULL;
+}
+
+JasmineGraphIncrementalLocalStore::~JasmineGraphIncrementalLocalStore() {
+    close();
+    delete this->degreeStore;
+}
+
 std::pair<std::string, unsigned int> JasmineGraphIncrementalLocalStore::getIDs(std::string edgeString) {
     try {
         auto edgeJson = json::parse(edgeString);
@@ -65,16 +99,21 @@ void JasmineGraphIncrementalLocalStore::addEdgeFromString(std::string edgeString
         if (!newRelation) {
             return;
         }
-        char value[PropertyLink::MAX_VALUE_SIZE] = {};
-
+        if (Utils::is_number(sId) && Utils::is_number(dId)) {
+            // A central edge reaches both partitions, only the one the source was placed on owns the source
+            bool sourceOwned = sourceJson.contains("pid") && sourceJson["pid"] == edgeJson["PID"];
+            if (this->degreeStore->addEdge(std::stol(sId), std::stol(dId), edgeJson["EdgeType"] == "Central",
+                                           sourceOwned) >= DEGREE_STORE_FLUSH_INTERVAL) {
+                this->degreeStore->persist();
+            }
+        }
         if (edgeJson.contains("properties")) {
             auto edgeProperties = edgeJson["properties"];
             for (auto it = edgeProperties.begin(); it != edgeProperties.end(); it++) {
-                strcpy(value, it.value().get<std::string>().c_str());
                 if (edgeJson["EdgeType"] == "Central") {
-                    newRelation->addCentralProperty(std::string(it.key()), &value[0]);
+                    newRelation->addCentralProperty(std::string(it.key()), it.value().get<std::string>());
                 } else {
-                    newRelation->addLocalProperty(std::string(it.key()), &value[0]);
+                    newRelation->addLocalProperty(std::string(it.key()), it.value().get<std::string>());
                 }
             }
         }
@@ -82,15 +121,13 @@ void JasmineGraphIncrementalLocalStore::addEdgeFromString(std::string edgeString
         if (sourceJson.contains("properties")) {
             auto sourceProps = sourceJson["properties"];
             for (auto it = sourceProps.begin(); it != sourceProps.end(); it++) {
-                strcpy(value, it.value().get<std::string>().c_str());
-                newRelation->getSource()->addProperty(std::string(it.key()), &value[0]);
+                newRelation->getSource()->addProperty(std::string(it.key()), it.value().get<std::string>());
             }
         }
         if (destinationJson.contains("properties")) {
             auto destProps = destinationJson["properties"];
             for (auto it = destProps.begin(); it != destProps.end(); it++) {
-                strcpy(value, it.value().get<std::string>().c_str());
-                newRelation->getDestination()->addProperty(std::string(it.key()), &value[0]);
+                newRelation->getDestination()->addProperty(std::string(it.key()), it.value().get<std::string>());
             }
         }
 
@@ -16,6 +16,7 @@ limitations under the License.
 using json = nlohmann::json;
 
 #include "../../nativestore/NodeManager.h"
+#include "../degree/JasmineGraphDegreeStore.h"
 #ifndef Incremental_LocalStore
 #define Incremental_LocalStore
 
@@ -23,10 +24,15 @@ class JasmineGraphIncrementalLocalStore {
  public:
     GraphConfig gc;
     NodeManager *nm;
+    JasmineGraphDegreeStore *degreeStore;
+    static const long DEGREE_STORE_FLUSH_INTERVAL = 1000;  // Edges buffered before the degree sidecar is rewritten
     void addEdgeFromString(std::string edgeString);
     static std::pair<std::string, unsigned int> getIDs(std::string edgeString);
     JasmineGraphIncrementalLocalStore(unsigned int graphID = 0,
                                       unsigned int partitionID = 0, std::string openMode = "trunk");
+    // Persists pending degree updates and closes the native store. Call it on the thread that added the edges.
+    void close();
+    ~JasmineGraphIncrementalLocalStore();
 };
 
 #endif
@@ -13,21 +13,37 @@ limitations under the License.
 
 #include "JasmineGraphTrainingSchedular.h"
 
+#include <netdb.h>
+#include <unistd.h>
+
+#include <climits>
 #include <iostream>
 
-#include "../../metadb/SQLiteDBInterface.h"
-#include "../../performancedb/PerformanceSQLiteDBInterface.h"
+#include "../../server/JasmineGraphInstanceProtocol.h"
 #include "../../util/Conts.h"
+#include "../../util/Utils.h"
 #include "../../util/logger/Logger.h"
+#include "TrainingResourceModel.h"
 #include "algorithm"
 
 using namespace std;
 Logger trainScheduler_logger;
 
-static long getAvailableMemory(std::string hostname);
-static long estimateMemory(int edgeCount, std::string graph_id);
+// Memory samples of a host averaged for its available memory
+static const int HOST_MEMORY_SAMPLES = 5;
+
+static std::once_flag trainingModelLoaded;
+
+struct HostResources {
+    long availableMemory = 0;  // KB, 0 if the host did not report its memory
+    int cores = 0;
+};
 
-static std::map<int, int> packPartitionsToMemory(std::vector<std::pair<int, int>> partitionMemoryList, int capacity);
+static HostResources getHostResources(PerformanceSQLiteDBInterface *perfDb, std::string hostname);
+static long getAvailableMemory(PerformanceSQLiteDBInterface *perfDb, std::string hostname);
+static bool loadTrainingInput(SQLiteDBInterface *sqlite, std::string graphID, std::string partitionID,
+                              TrainingInput &input);
+static std::string fetchTrainingProfiles(std::string host, int port);
 
 static std::map<std::string, std::map<int, std::map<int, int>>> scheduleGradientPassingTraining(std::string graphID);
 
@@ -42,6 +58,11 @@ map<string, std::map<int, int>> JasmineGraphTrainingSchedular::schedulePartition
     vector<pair<string, string>> hostData;
     auto *refToSqlite = new SQLiteDBInterface();
     refToSqlite->init();
+    auto *refToPerfDb = new PerformanceSQLiteDBInterface();
+    refToPerfDb->init();
+
+    std::call_once(trainingModelLoaded, TrainingResourceModel::load, refToPerfDb);
+    collectTrainingProfiles(refToSqlite, refToPerfDb);
 
     string sqlStatement =
         "SELECT host_idhost, name FROM worker_has_partition INNER JOIN worker ON worker_idworker = "
@@ -62,137 +83,220 @@ map<string, std::map<int, int>> JasmineGraphTrainingSchedular::schedulePartition
             count++;
         }
     }
-    string id_partition = "";
-    string vertexCount = "";
-    string centralvertexCount = "";
-    int partition_id;
-    int vertexcount;
-    int centralVertexCount;
+
+    int featureCount = 0;
+    PreparedStatement featureStatement = refToSqlite->prepare("SELECT feature_count FROM graph WHERE idgraph = ?;");
+    featureStatement.bind(1, graphID);
+    if (featureStatement.next()) {
+        featureCount = featureStatement.getInt(0);
+    }
+    featureStatement.reset();
+
     trainScheduler_logger.log("Scheduling training order for each worker", "info");
     for (std::vector<pair<string, string>>::iterator j = (hostData.begin()); j != hostData.end(); ++j) {
         sqlStatement =
-            "SELECT idpartition, vertexcount, central_vertexcount, graph_idgraph FROM partition INNER JOIN "
-            "(SELECT host_idhost, partition_idpartition, partition_graph_idgraph, worker_idworker FROM "
+            "SELECT idpartition, vertexcount, central_vertexcount, edgecount, central_edgecount FROM partition "
+            "INNER JOIN (SELECT host_idhost, partition_idpartition, partition_graph_idgraph, worker_idworker FROM "
             "worker_has_partition INNER JOIN worker ON worker_idworker = idworker) AS a ON partition.idpartition = "
             "a.partition_idpartition WHERE partition.graph_idgraph =  " +
             graphID + " AND a.host_idhost = " + j->first;
         std::vector<vector<pair<string, string>>> results = refToSqlite->runSelect(sqlStatement);
-        std::map<int, int> vertexCountToPartitionId;
+
+        HostResources resources = getHostResources(refToPerfDb, j->second);
+        vector<PartitionDemand> partitionDemands;
         for (std::vector<vector<pair<string, string>>>::iterator i = results.begin(); i != results.end(); ++i) {
             std::vector<pair<string, string>> rowData = *i;
-            id_partition = rowData.at(0).second;
-            vertexCount = rowData.at(1).second;
-            centralvertexCount = rowData.at(2).second;
-
-            partition_id = stoi(id_partition);
-            vertexcount = stoi(vertexCount);
-            centralVertexCount = stoi(centralvertexCount);
-
-            vertexCountToPartitionId.insert({vertexcount + centralVertexCount, partition_id});
-        }
-        long availableMemory = getAvailableMemory(j->second);
-        vector<pair<int, int>> memoryEstimationForEachPartition;
-        for (auto i = vertexCountToPartitionId.begin(); i != vertexCountToPartitionId.end(); ++i) {
-            long memoryForPartition = estimateMemory(i->first, graphID);
-            trainScheduler_logger.log(
-                "Estimated memory for partition :" + to_string(i->second) + " is " + to_string(memoryForPartition),
-                "info");
-            if (memoryForPartition > availableMemory) {
-                memoryForPartition = availableMemory;
-            }
-            memoryEstimationForEachPartition.push_back(make_pair(i->second, (int)memoryForPartition));
+            TrainingInput input;
+            input.graphId = graphID;
+            input.partitionId = rowData.at(0).second;
+            input.vertexCount = stol(rowData.at(1).second) + stol(rowData.at(2).second);
+            input.edgeCount = stol(rowData.at(3).second) + stol(rowData.at(4).second);
+            input.featureCount = featureCount;
+
+            TrainingEstimate estimate = TrainingResourceModel::estimate(TrainingProfiler::FL_CLIENT_MODEL, input);
+            trainScheduler_logger.log("Estimated memory for partition :" + input.partitionId + " is " +
+                                          to_string(estimate.memory) + " KB and time is " +
+                                          to_string(estimate.time) + " ms" +
+                                          (estimate.measured ? "" : " (no training profiles yet)"),
+                                      "info");
+            TrainingResourceModel::recordEstimate(refToPerfDb, TrainingProfiler::FL_CLIENT_MODEL, j->second, input,
+                                                  estimate);
+            partitionDemands.push_back({stoi(input.partitionId), estimate.memory, estimate.time, estimate.cpuFraction});
         }
         std::map<int, int> scheduledPartitionSets =
-            packPartitionsToMemory(memoryEstimationForEachPartition, availableMemory);
+            packPartitions(partitionDemands, resources.availableMemory, resources.cores);
         scheduleForEachHost.insert(make_pair(j->second, scheduledPartitionSets));
     }
+    refToPerfDb->finalize();
+    delete refToPerfDb;
     refToSqlite->finalize();
     delete refToSqlite;
     return scheduleForEachHost;
 }
 
-static long estimateMemory(int vertexCount, string graph_id) {
-    auto *refToSqlite = new SQLiteDBInterface();
-    refToSqlite->init();
-
-    string sqlStatement = "SELECT feature_count FROM graph WHERE idgraph = " + graph_id;
-    std::vector<vector<pair<string, string>>> result = refToSqlite->runSelect(sqlStatement);
-    refToSqlite->finalize();
-    delete refToSqlite;
-    int feature_Count;
+struct TrainingIteration {
+    long freeMemory;
+    long longest;
+    double cpuTime;
+    double ioTime;
+};
 
-    for (std::vector<vector<pair<string, string>>>::iterator i = result.begin(); i != result.end(); ++i) {
-        std::vector<pair<string, string>> rowData = *i;
+static double getDuration(const TrainingIteration &iteration, int cores) {
+    double duration = std::max(static_cast<double>(iteration.longest), iteration.ioTime);
+    return cores > 0 ? std::max(duration, iteration.cpuTime / cores) : duration;
+}
 
-        string featureCount = rowData.at(0).second;
+std::map<int, int> JasmineGraphTrainingSchedular::packPartitions(vector<PartitionDemand> partitions, long capacity,
+                                                                 int cores) {
+    std::map<int, int> partitionToIteration;
+    sort(partitions.begin(), partitions.end(), [](const PartitionDemand &a, const PartitionDemand &b) {
+        if (a.time != b.time) return a.time > b.time;
+        if (a.memory != b.memory) return a.memory > b.memory;
+        return a.partitionId < b.partitionId;
+    });
+
+    vector<TrainingIteration> iterations;
+    for (auto &partition : partitions) {
+        // A partition larger than the memory still has to be trained, alone in its iteration
+        long memory = capacity > 0 ? std::min(partition.memory, capacity) : 0;
+        double cpuTime = partition.time * partition.cpuFraction;
+        double ioTime = partition.time - cpuTime;
+
+        // Opening an iteration adds the whole time of the partition to the makespan
+        int best = -1;
+        double bestIncrease = partition.time;
+        long bestFreeMemory = 0;
+        for (int i = 0; i < iterations.size(); i++) {
+            const TrainingIteration &iteration = iterations[i];
+            if (iteration.freeMemory < memory) {
+                continue;
+            }
+            TrainingIteration merged = iteration;
+            merged.longest = std::max(merged.longest, partition.time);
+            merged.cpuTime += cpuTime;
+            merged.ioTime += ioTime;
+            double increase = getDuration(merged, cores) - getDuration(iteration, cores);
+            long freeMemory = iteration.freeMemory - memory;
+            bool better;
+            if (best < 0) {
+                better = increase < bestIncrease || increase == 0;
+            } else {
+                better = increase < bestIncrease || (increase == bestIncrease && freeMemory < bestFreeMemory);
+            }
+            if (better) {
+                best = i;
+                bestIncrease = increase;
+                bestFreeMemory = freeMemory;
+            }
+        }
 
-        feature_Count = stoi(featureCount);
+        if (best < 0) {
+            best = iterations.size();
+            iterations.push_back({capacity > 0 ? capacity : 0, 0, 0, 0});
+        }
+        TrainingIteration &iteration = iterations[best];
+        iteration.freeMemory -= memory;
+        iteration.longest = std::max(iteration.longest, partition.time);
+        iteration.cpuTime += cpuTime;
+        iteration.ioTime += ioTime;
+        partitionToIteration[partition.partitionId] = best;
     }
 
-    long featureMatrixSize;
-    long adjacencyMatrixSize;
-    long degreeMatrixSize;
-    long embeddingMatrixSize;
-    long networkXgraphsize;
+    double makespan = 0;
+    for (auto &iteration : iterations) {
+        makespan += getDuration(iteration, cores);
+    }
+    trainScheduler_logger.log("Packed " + to_string(partitions.size()) + " partitions into " +
+                                  to_string(iterations.size()) + " iterations with an estimated makespan of " +
+                                  to_string(static_cast<long>(makespan)) + " ms",
+                              "info");
+    return partitionToIteration;
+}
 
-    featureMatrixSize = 4 * 16 * feature_Count * (vertexCount + 1);
-    adjacencyMatrixSize = 4 * 16 * 128 * (vertexCount + 1);
-    degreeMatrixSize = 4 * 16 * 1 * (vertexCount + 1);
-    embeddingMatrixSize = 4 * 16 * 256 * (vertexCount + 1);
-    networkXgraphsize = 60 * (vertexCount);
+void JasmineGraphTrainingSchedular::collectTrainingProfiles(SQLiteDBInterface *sqlite,
+                                                            PerformanceSQLiteDBInterface *perfDb) {
+    vector<Utils::worker> workers = Utils::getWorkerList(sqlite);
+    for (auto &worker : workers) {
+        std::string host = worker.hostname;
+        if (host.find('@') != std::string::npos) {
+            host = Utils::split(host, '@')[1];
+        }
+        std::vector<TrainingProfile> profiles = TrainingProfiler::parse(fetchTrainingProfiles(host, stoi(worker.port)));
+        for (auto &profile : profiles) {
+            TrainingInput input;
+            if (!loadTrainingInput(sqlite, profile.graphId, profile.partitionId, input)) {
+                trainScheduler_logger.warn("Dropping the training profile of unknown partition " +
+                                           profile.partitionId + " of graph " + profile.graphId);
+                continue;
+            }
+            TrainingResourceModel::recordRun(perfDb, input, profile);
+        }
+    }
+}
 
-    long totalMemoryApproximation =
-        (featureMatrixSize + adjacencyMatrixSize + degreeMatrixSize + embeddingMatrixSize + networkXgraphsize) / 1024;
+static std::string fetchTrainingProfiles(std::string host, int port) {
+    int sockfd = Utils::connectToWorker(host, port);
+    if (sockfd < 0) {
+        return "";
+    }
+    if (!Utils::send_str_wrapper(sockfd, JasmineGraphInstanceProtocol::TRAINING_PROFILE)) {
+        trainScheduler_logger.error("Could not collect the training profiles of " + host + ":" + to_string(port));
+        close(sockfd);
+        return "";
+    }
 
-    return totalMemoryApproximation;
+    std::string profiles = Utils::readChunkedResponse(sockfd);
+    close(sockfd);
+    return profiles;
 }
 
-static long getAvailableMemory(string hostname) {
-    auto *refToPerfDb = new PerformanceSQLiteDBInterface();
-    refToPerfDb->init();
-    trainScheduler_logger.log("Fetching available host " + hostname + " memory", "info");
-    string perfSqlStatement =
-        "SELECT memory_usage FROM host_performance_data INNER JOIN (SELECT idhost FROM host WHERE ip = '" + hostname +
-        "') USING (idhost) ORDER BY date_time DESC LIMIT 1";
-    vector<vector<pair<string, string>>> result = refToPerfDb->runSelect(perfSqlStatement);
-    if (result.size() == 0) {
-        return 0;
+static bool loadTrainingInput(SQLiteDBInterface *sqlite, std::string graphID, std::string partitionID,
+                              TrainingInput &input) {
+    PreparedStatement statement = sqlite->prepare(
+        "SELECT partition.vertexcount, partition.central_vertexcount, partition.edgecount, "
+        "partition.central_edgecount, graph.feature_count FROM partition INNER JOIN graph "
+        "ON partition.graph_idgraph = graph.idgraph WHERE partition.graph_idgraph = ? AND partition.idpartition = ?;");
+    statement.bind(1, graphID).bind(2, partitionID);
+    if (!statement.next()) {
+        return false;
     }
-    long availableMemory = stol(result[0][0].second);
-    refToPerfDb->finalize();
-    delete refToPerfDb;
-    return availableMemory;
+    input.graphId = graphID;
+    input.partitionId = partitionID;
+    input.vertexCount = statement.getLong(0) + statement.getLong(1);
+    input.edgeCount = statement.getLong(2) + statement.getLong(3);
+    input.featureCount = statement.getInt(4);
+    statement.reset();
+    return true;
 }
 
-static std::map<int, int> packPartitionsToMemory(vector<pair<int, int>> partitionMemoryList, int capacity) {
-    std::map<int, int> partitionToIteration;
-
-    int res = 0;
-    int n = partitionMemoryList.size();
-    int bin_rem[n];
-
-    for (int i = 0; i < n; i++) {
-        int min = capacity + 1;
-        int bestBin = 0;
+static HostResources getHostResources(PerformanceSQLiteDBInterface *perfDb, string hostname) {
+    HostResources resources;
+    resources.availableMemory = getAvailableMemory(perfDb, hostname);
+    PreparedStatement statement = perfDb->prepare("SELECT total_cpu_cores FROM host WHERE ip = ?;");
+    statement.bind(1, hostname);
+    if (statement.next()) {
+        resources.cores = statement.getInt(0);
+    }
+    statement.reset();
+    return resources;
+}
 
-        for (int j = 0; j < res; j++) {
-            if (bin_rem[j] >= partitionMemoryList[i].second && bin_rem[j] - partitionMemoryList[i].second < min) {
-                bestBin = j;
-                min = bin_rem[j] - partitionMemoryList[i].second;
-            }
-        }
-        if (min == capacity + 1) {
-            vector<int> partitionBin;
-            bin_rem[res] = capacity - partitionMemoryList[i].second;
-            partitionToIteration[partitionMemoryList[i].first] = res;
-            res++;
-        } else {
-            bin_rem[bestBin] -= partitionMemoryList[i].second;
-            partitionToIteration[partitionMemoryList[i].first] = bestBin;
-        }
+// Total memory of the host less its average use over the latest samples, so a single spike does not decide
+static long getAvailableMemory(PerformanceSQLiteDBInterface *perfDb, string hostname) {
+    trainScheduler_logger.log("Fetching available host " + hostname + " memory", "info");
+    PreparedStatement statement = perfDb->prepare(
+        "SELECT host.total_memory, AVG(samples.memory_usage) FROM host LEFT JOIN (SELECT idhost, memory_usage "
+        "FROM host_performance_data WHERE idhost IN (SELECT idhost FROM host WHERE ip = ?) ORDER BY id DESC "
+        "LIMIT ?) AS samples USING (idhost) WHERE host.ip = ? GROUP BY host.idhost;");
+    statement.bind(1, hostname).bind(2, HOST_MEMORY_SAMPLES).bind(3, hostname);
+    long availableMemory = 0;
+    if (statement.next() && !statement.isNull(0)) {
+        long totalMemory = statement.getLong(0);
+        long usedMemory = statement.isNull(1) ? 0 : static_cast<long>(statement.getDouble(1));
+        availableMemory = std::max(0L, totalMemory - usedMemory);
     }
-    trainScheduler_logger.log("Packing partitions to fit memory completed", "info");
-    return partitionToIteration;
+    statement.reset();
+    return availableMemory;
 }
 
 /** Method to initiate the creation of training schedule
@@ -205,6 +309,8 @@ static map<string, std::map<int, map<int, int>>> scheduleGradientPassingTraining
     vector<pair<string, string>> hostData;
     auto *refToSqlite = new SQLiteDBInterface();
     refToSqlite->init();
+    auto *refToPerfDb = new PerformanceSQLiteDBInterface();
+    refToPerfDb->init();
 
     // Get graph attribute metadata
     string sql = "SELECT feature_count, feature_type FROM graph WHERE idgraph = " + graphID;
@@ -302,7 +408,7 @@ static map<string, std::map<int, map<int, int>>> scheduleGradientPassingTraining
             partitionWorkerMap[partitionID] = workerid;
         }
 
-        long availableMemory = getAvailableMemory(j->second);  // Host memory (in KB)
+        long availableMemory = getAvailableMemory(refToPerfDb, j->second);  // Host memory (in KB)
 
         // Get memory estimation list for each partition of host
         vector<pair<int, double>> partitionMemoryList = estimateMemoryDistOpt(partitionMetadata, availableMemory);
@@ -312,6 +418,8 @@ static map<string, std::map<int, map<int, int>>> scheduleGradientPassingTraining
             schedulePartitionsBestFit(partitionMemoryList, partitionWorkerMap, availableMemory);
         scheduleForEachHost.insert(make_pair(j->second, scheduledPartitionSets));
     }
+    refToPerfDb->finalize();
+    delete refToPerfDb;
     refToSqlite->finalize();
     delete refToSqlite;
     return scheduleForEachHost;
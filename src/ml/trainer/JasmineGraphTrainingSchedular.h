@@ -22,9 +22,34 @@ limitations under the License.
 #ifndef JASMINEGRAPH_JASMINEGRAPHTRAININGSCHEDULAR_H
 #define JASMINEGRAPH_JASMINEGRAPHTRAININGSCHEDULAR_H
 
+#include "../../metadb/SQLiteDBInterface.h"
+#include "../../performancedb/PerformanceSQLiteDBInterface.h"
+
+struct PartitionDemand {
+    int partitionId;
+    long memory;         // KB
+    long time;           // Milliseconds
+    double cpuFraction;  // Share of the time spent on the CPU, the rest waits for I/O
+};
+
 class JasmineGraphTrainingSchedular {
  public:
     static std::map<std::string, std::map<int, int>> schedulePartitionTraining(std::string graphID);
+
+    // Add the training profiles the workers recorded since the last collection to the resource model
+    static void collectTrainingProfiles(SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfDb);
+
+    /**
+     * Assign the partitions of a host to training iterations, which run one after the other with their
+     * partitions in parallel. The peak memory of an iteration stays within the capacity (KB, 0 if unknown) and
+     * the partitions are placed longest first into the iteration whose duration grows least, opening a new
+     * iteration when that would grow the makespan less. An iteration lasts as long as its longest partition, its
+     * CPU time spread over the cores (0 if unknown) or its I/O time on one disk, whichever is larger, so I/O
+     * bound partitions are overlapped with CPU bound ones.
+     *
+     * @return Map from partition id to iteration
+     */
+    static std::map<int, int> packPartitions(std::vector<PartitionDemand> partitions, long capacity, int cores);
 };
 
 #endif  // JASMINEGRAPH_JASMINEGRAPHTRAININGSCHEDULAR_H
@@ -0,0 +1,105 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "TrainingProfiler.h"
+
+#include <errno.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <sstream>
+
+#include "../../util/logger/Logger.h"
+
+Logger training_profiler_logger;
+
+const std::string TrainingProfiler::FL_CLIENT_MODEL = "fl-client";
+const size_t TrainingProfiler::MAX_PENDING_PROFILES;
+
+std::mutex TrainingProfiler::profileMutex;
+std::vector<TrainingProfile> TrainingProfiler::pendingProfiles;
+
+int TrainingProfiler::run(const std::string &command, TrainingProfile &profile) {
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid < 0) {
+        training_profiler_logger.error("Could not fork the training process");
+        return -1;
+    }
+    if (pid == 0) {
+        execl("/bin/sh", "sh", "-c", command.c_str(), (char *)NULL);
+        _exit(127);
+    }
+
+    // The usage of a waited child includes its own waited children, so the peak covers the process tree
+    int status;
+    struct rusage usage;
+    while (wait4(pid, &status, 0, &usage) < 0) {
+        if (errno != EINTR) {
+            training_profiler_logger.error("Could not wait for the training process " + std::to_string(pid));
+            return -1;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    profile.elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    profile.peakMemory = usage.ru_maxrss;
+    profile.cpuTime = (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000L +
+                      (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000L;
+    profile.exitStatus = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    return profile.exitStatus;
+}
+
+void TrainingProfiler::record(const TrainingProfile &profile) {
+    training_profiler_logger.info("Training " + profile.model + " of partition " + profile.partitionId + " of graph " +
+                                  profile.graphId + " used " + std::to_string(profile.peakMemory) + " KB at peak in " +
+                                  std::to_string(profile.elapsedTime) + " ms");
+    std::lock_guard<std::mutex> lock(profileMutex);
+    if (pendingProfiles.size() >= MAX_PENDING_PROFILES) {
+        pendingProfiles.erase(pendingProfiles.begin());
+    }
+    pendingProfiles.push_back(profile);
+}
+
+std::vector<TrainingProfile> TrainingProfiler::drain() {
+    std::vector<TrainingProfile> profiles;
+    std::lock_guard<std::mutex> lock(profileMutex);
+    profiles.swap(pendingProfiles);
+    return profiles;
+}
+
+std::string TrainingProfiler::serialize(const std::vector<TrainingProfile> &profiles) {
+    std::ostringstream stream;
+    for (auto &profile : profiles) {
+        stream << profile.model << " " << profile.graphId << " " << profile.partitionId << " " << profile.peakMemory
+               << " " << profile.elapsedTime << " " << profile.cpuTime << " " << profile.exitStatus << "\n";
+    }
+    return stream.str();
+}
+
+std::vector<TrainingProfile> TrainingProfiler::parse(const std::string &profiles) {
+    std::vector<TrainingProfile> parsed;
+    std::istringstream stream(profiles);
+    std::string line;
+    while (std::getline(stream, line)) {
+        std::istringstream fields(line);
+        TrainingProfile profile;
+        if (fields >> profile.model >> profile.graphId >> profile.partitionId >> profile.peakMemory >>
+            profile.elapsedTime >> profile.cpuTime >> profile.exitStatus) {
+            parsed.push_back(profile);
+        }
+    }
+    return parsed;
+}
@@ -0,0 +1,63 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_TRAININGPROFILER_H
+#define JASMINEGRAPH_TRAININGPROFILER_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Resources used by one training run of a partition
+struct TrainingProfile {
+    std::string model;
+    std::string graphId;
+    std::string partitionId;
+    long peakMemory = 0;   // Peak resident set size of the training process and its children in KB
+    long elapsedTime = 0;  // Wall clock time in milliseconds
+    long cpuTime = 0;      // User and system time in milliseconds
+    int exitStatus = 0;
+};
+
+/**
+ * Runs the training processes of a worker and keeps the resources they used until the master collects them with
+ * the training-profile command. The training command is run through the shell like system(), but the process is
+ * waited for with wait4 so the peak RSS of the whole process tree is measured rather than estimated.
+ */
+class TrainingProfiler {
+ public:
+    // Model of the federated learning client, which trains one partition per process
+    static const std::string FL_CLIENT_MODEL;
+
+    // Profiles not collected by the master are dropped beyond this
+    static const size_t MAX_PENDING_PROFILES = 1024;
+
+    // Run the shell command and fill the resources it used into the profile. Returns the exit status or -1.
+    static int run(const std::string &command, TrainingProfile &profile);
+
+    static void record(const TrainingProfile &profile);
+
+    // Take the profiles recorded since the last call
+    static std::vector<TrainingProfile> drain();
+
+    // One profile per line as model graph partition peak_memory elapsed_time cpu_time exit_status
+    static std::string serialize(const std::vector<TrainingProfile> &profiles);
+
+    static std::vector<TrainingProfile> parse(const std::string &profiles);
+
+ private:
+    static std::mutex profileMutex;
+    static std::vector<TrainingProfile> pendingProfiles;
+};
+
+#endif  // JASMINEGRAPH_TRAININGPROFILER_H
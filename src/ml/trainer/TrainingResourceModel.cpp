@@ -0,0 +1,327 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "TrainingResourceModel.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../../performance/metrics/MetricsRegistry.h"
+#include "../../util/logger/Logger.h"
+
+Logger training_model_logger;
+
+const int TrainingResourceModel::MIN_FIT_SAMPLES;
+const size_t TrainingResourceModel::MAX_SAMPLES;
+constexpr double TrainingResourceModel::MEMORY_HEADROOM;
+constexpr double TrainingResourceModel::DEFAULT_ELEMENTS_PER_MS;
+
+std::mutex TrainingResourceModel::modelMutex;
+std::map<std::string, std::vector<TrainingResourceModel::Sample>> TrainingResourceModel::samples;
+std::map<std::string, TrainingResourceModel::Fit> TrainingResourceModel::fits;
+
+static const int FEATURE_COUNT = 4;
+
+// Keeps the normal equations solvable when the features are collinear, e.g. all partitions share a feature count
+static const double RIDGE = 1e-6;
+
+static void getFeatures(const TrainingInput &input, double *features) {
+    features[0] = 1;
+    features[1] = input.vertexCount;
+    features[2] = static_cast<double>(input.vertexCount) * input.featureCount;
+    features[3] = input.edgeCount;
+}
+
+static double predict(const double *coefficients, const TrainingInput &input) {
+    double features[FEATURE_COUNT];
+    getFeatures(input, features);
+    double value = 0;
+    for (int i = 0; i < FEATURE_COUNT; i++) {
+        value += coefficients[i] * features[i];
+    }
+    return value;
+}
+
+// Solve the FEATURE_COUNT x FEATURE_COUNT system in place by Gaussian elimination with partial pivoting
+static bool solve(double matrix[FEATURE_COUNT][FEATURE_COUNT], double *vector, double *solution) {
+    for (int column = 0; column < FEATURE_COUNT; column++) {
+        int pivot = column;
+        for (int row = column + 1; row < FEATURE_COUNT; row++) {
+            if (std::fabs(matrix[row][column]) > std::fabs(matrix[pivot][column])) {
+                pivot = row;
+            }
+        }
+        if (std::fabs(matrix[pivot][column]) < 1e-12) {
+            return false;
+        }
+        std::swap(matrix[pivot], matrix[column]);
+        std::swap(vector[pivot], vector[column]);
+        for (int row = column + 1; row < FEATURE_COUNT; row++) {
+            double factor = matrix[row][column] / matrix[column][column];
+            for (int i = column; i < FEATURE_COUNT; i++) {
+                matrix[row][i] -= factor * matrix[column][i];
+            }
+            vector[row] -= factor * vector[column];
+        }
+    }
+    for (int row = FEATURE_COUNT - 1; row >= 0; row--) {
+        double value = vector[row];
+        for (int i = row + 1; i < FEATURE_COUNT; i++) {
+            value -= matrix[row][i] * solution[i];
+        }
+        solution[row] = value / matrix[row][row];
+    }
+    return true;
+}
+
+// Least squares fit of the sample values over the features. The features are scaled to [0, 1] first since the
+// vertex count times the feature count is orders of magnitude above the intercept.
+static bool fitLinear(const std::vector<TrainingInput> &inputs, const std::vector<double> &values,
+                      double *coefficients) {
+    double scale[FEATURE_COUNT] = {1, 1, 1, 1};
+    double features[FEATURE_COUNT];
+    for (auto &input : inputs) {
+        getFeatures(input, features);
+        for (int i = 0; i < FEATURE_COUNT; i++) {
+            scale[i] = std::max(scale[i], std::fabs(features[i]));
+        }
+    }
+
+    double matrix[FEATURE_COUNT][FEATURE_COUNT] = {};
+    double vector[FEATURE_COUNT] = {};
+    for (size_t sample = 0; sample < inputs.size(); sample++) {
+        getFeatures(inputs[sample], features);
+        for (int i = 0; i < FEATURE_COUNT; i++) {
+            features[i] /= scale[i];
+        }
+        for (int i = 0; i < FEATURE_COUNT; i++) {
+            for (int j = 0; j < FEATURE_COUNT; j++) {
+                matrix[i][j] += features[i] * features[j];
+            }
+            vector[i] += features[i] * values[sample];
+        }
+    }
+    for (int i = 0; i < FEATURE_COUNT; i++) {
+        matrix[i][i] += RIDGE * inputs.size();
+    }
+
+    if (!solve(matrix, vector, coefficients)) {
+        return false;
+    }
+    for (int i = 0; i < FEATURE_COUNT; i++) {
+        coefficients[i] /= scale[i];
+    }
+    return true;
+}
+
+void TrainingResourceModel::load(PerformanceSQLiteDBInterface *perfDb) {
+    PreparedStatement statement = perfDb->prepare(
+        "SELECT model, graph_id, partition_id, vertexcount, edgecount, feature_count, peak_memory, elapsed_time, "
+        "cpu_time FROM training_performance WHERE peak_memory IS NOT NULL ORDER BY id;");
+    int count = 0;
+    while (statement.next()) {
+        TrainingInput input;
+        TrainingProfile profile;
+        profile.model = statement.getString(0);
+        input.graphId = profile.graphId = statement.getString(1);
+        input.partitionId = profile.partitionId = statement.getString(2);
+        input.vertexCount = statement.getLong(3);
+        input.edgeCount = statement.getLong(4);
+        input.featureCount = statement.getInt(5);
+        profile.peakMemory = statement.getLong(6);
+        profile.elapsedTime = statement.getLong(7);
+        profile.cpuTime = statement.getLong(8);
+        addSample(profile.model, input, profile);
+        count++;
+    }
+    training_model_logger.info("Loaded " + std::to_string(count) + " training profiles");
+}
+
+TrainingEstimate TrainingResourceModel::formulaEstimate(const TrainingInput &input) {
+    // Feature, adjacency, degree and embedding matrices of the partition plus its NetworkX graph
+    long vertices = input.vertexCount + 1;
+    long featureMatrixSize = 4L * 16 * input.featureCount * vertices;
+    long adjacencyMatrixSize = 4L * 16 * 128 * vertices;
+    long degreeMatrixSize = 4L * 16 * 1 * vertices;
+    long embeddingMatrixSize = 4L * 16 * 256 * vertices;
+    long networkXgraphsize = 60L * input.vertexCount;
+
+    TrainingEstimate estimate;
+    estimate.memory =
+        (featureMatrixSize + adjacencyMatrixSize + degreeMatrixSize + embeddingMatrixSize + networkXgraphsize) / 1024;
+    estimate.time = static_cast<long>(
+        (static_cast<double>(input.vertexCount) * (input.featureCount + 1) + input.edgeCount) /
+        DEFAULT_ELEMENTS_PER_MS);
+    return estimate;
+}
+
+TrainingEstimate TrainingResourceModel::estimate(const std::string &model, const TrainingInput &input) {
+    std::lock_guard<std::mutex> lock(modelMutex);
+    auto modelSamples = samples.find(model);
+    if (modelSamples == samples.end()) {
+        return formulaEstimate(input);
+    }
+
+    TrainingEstimate estimate;
+    for (auto sample = modelSamples->second.rbegin(); sample != modelSamples->second.rend(); ++sample) {
+        if (sample->input.graphId != input.graphId || sample->input.partitionId != input.partitionId ||
+            sample->input.featureCount != input.featureCount) {
+            continue;
+        }
+        if (!estimate.measured) {
+            estimate.measured = true;
+            estimate.time = sample->profile.elapsedTime;
+            estimate.cpuFraction = sample->profile.elapsedTime > 0
+                                       ? std::min(1.0, static_cast<double>(sample->profile.cpuTime) /
+                                                           sample->profile.elapsedTime)
+                                       : 1;
+        }
+        estimate.memory = std::max(estimate.memory, sample->profile.peakMemory);
+    }
+    if (estimate.measured) {
+        return estimate;
+    }
+
+    Fit &fit = fits[model];
+    if (!fit.valid) {
+        return formulaEstimate(input);
+    }
+    estimate.measured = true;
+    estimate.memory = std::max(1L, static_cast<long>(predict(fit.memory, input) * MEMORY_HEADROOM));
+    estimate.time = std::max(1L, static_cast<long>(predict(fit.time, input)));
+    estimate.cpuFraction = fit.cpuFraction;
+    return estimate;
+}
+
+void TrainingResourceModel::recordEstimate(PerformanceSQLiteDBInterface *perfDb, const std::string &model,
+                                           const std::string &host, const TrainingInput &input,
+                                           const TrainingEstimate &estimate) {
+    // An earlier schedule of the partition that never reported a profile is superseded
+    PreparedStatement superseded = perfDb->prepare(
+        "DELETE FROM training_performance WHERE model = ? AND graph_id = ? AND partition_id = ? "
+        "AND peak_memory IS NULL;");
+    superseded.bind(1, model).bind(2, input.graphId).bind(3, input.partitionId);
+    superseded.execute();
+
+    PreparedStatement statement = perfDb->prepare(
+        "INSERT INTO training_performance (model, graph_id, partition_id, host, vertexcount, edgecount, "
+        "feature_count, estimated_memory, estimated_time) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?);");
+    statement.bind(1, model).bind(2, input.graphId).bind(3, input.partitionId).bind(4, host);
+    statement.bind(5, input.vertexCount).bind(6, input.edgeCount).bind(7, input.featureCount);
+    statement.bind(8, estimate.memory).bind(9, estimate.time);
+    statement.execute();
+}
+
+static long getErrorPercent(long estimated, long measured) {
+    return measured > 0 ? std::labs(estimated - measured) * 100 / measured : 0;
+}
+
+void TrainingResourceModel::recordRun(PerformanceSQLiteDBInterface *perfDb, const TrainingInput &input,
+                                      const TrainingProfile &profile) {
+    static Histogram &memoryError = MetricsRegistry::histogram(
+        "jasminegraph_training_memory_error_percent", "Error of the predicted peak memory of partition training");
+    static Histogram &timeError = MetricsRegistry::histogram(
+        "jasminegraph_training_time_error_percent", "Error of the predicted time of partition training");
+
+    PreparedStatement pending = perfDb->prepare(
+        "SELECT id, estimated_memory, estimated_time FROM training_performance WHERE model = ? AND graph_id = ? "
+        "AND partition_id = ? AND peak_memory IS NULL ORDER BY id DESC LIMIT 1;");
+    pending.bind(1, profile.model).bind(2, profile.graphId).bind(3, profile.partitionId);
+    if (pending.next()) {
+        long id = pending.getLong(0);
+        long estimatedMemory = pending.getLong(1);
+        long estimatedTime = pending.getLong(2);
+        pending.reset();
+
+        PreparedStatement update = perfDb->prepare(
+            "UPDATE training_performance SET peak_memory = ?, elapsed_time = ?, cpu_time = ? WHERE id = ?;");
+        update.bind(1, profile.peakMemory).bind(2, profile.elapsedTime).bind(3, profile.cpuTime).bind(4, id);
+        update.execute();
+
+        memoryError.record(getErrorPercent(estimatedMemory, profile.peakMemory));
+        timeError.record(getErrorPercent(estimatedTime, profile.elapsedTime));
+        training_model_logger.info("Training " + profile.model + " of partition " + profile.partitionId +
+                                   " of graph " + profile.graphId + " used " + std::to_string(profile.peakMemory) +
+                                   " KB in " + std::to_string(profile.elapsedTime) + " ms, predicted " +
+                                   std::to_string(estimatedMemory) + " KB in " + std::to_string(estimatedTime) +
+                                   " ms");
+    } else {
+        pending.reset();
+        PreparedStatement insert = perfDb->prepare(
+            "INSERT INTO training_performance (model, graph_id, partition_id, vertexcount, edgecount, "
+            "feature_count, peak_memory, elapsed_time, cpu_time) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?);");
+        insert.bind(1, profile.model).bind(2, profile.graphId).bind(3, profile.partitionId);
+        insert.bind(4, input.vertexCount).bind(5, input.edgeCount).bind(6, input.featureCount);
+        insert.bind(7, profile.peakMemory).bind(8, profile.elapsedTime).bind(9, profile.cpuTime);
+        insert.execute();
+        training_model_logger.info("Training " + profile.model + " of partition " + profile.partitionId +
+                                   " of graph " + profile.graphId + " used " + std::to_string(profile.peakMemory) +
+                                   " KB in " + std::to_string(profile.elapsedTime) + " ms without a prediction");
+    }
+
+    addSample(profile.model, input, profile);
+}
+
+void TrainingResourceModel::addSample(const std::string &model, const TrainingInput &input,
+                                      const TrainingProfile &profile) {
+    // A failed run may have stopped before reaching its peak
+    if (profile.exitStatus != 0 || profile.peakMemory <= 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(modelMutex);
+    std::vector<Sample> &modelSamples = samples[model];
+    if (modelSamples.size() >= MAX_SAMPLES) {
+        modelSamples.erase(modelSamples.begin());
+    }
+    Sample sample;
+    sample.input = input;
+    sample.profile = profile;
+    modelSamples.push_back(sample);
+    refit(model);
+}
+
+void TrainingResourceModel::refit(const std::string &model) {
+    std::vector<Sample> &modelSamples = samples[model];
+    Fit &fit = fits[model];
+    fit.valid = false;
+    if (modelSamples.size() < MIN_FIT_SAMPLES) {
+        return;
+    }
+
+    std::vector<TrainingInput> inputs;
+    std::vector<double> peaks;
+    std::vector<double> times;
+    long elapsedTime = 0;
+    long cpuTime = 0;
+    for (auto &sample : modelSamples) {
+        inputs.push_back(sample.input);
+        peaks.push_back(sample.profile.peakMemory);
+        times.push_back(sample.profile.elapsedTime);
+        elapsedTime += sample.profile.elapsedTime;
+        cpuTime += sample.profile.cpuTime;
+    }
+    fit.valid = fitLinear(inputs, peaks, fit.memory) && fitLinear(inputs, times, fit.time);
+    fit.cpuFraction = elapsedTime > 0 ? std::min(1.0, static_cast<double>(cpuTime) / elapsedTime) : 1;
+}
+
+bool TrainingResourceModel::isFitted(const std::string &model) {
+    std::lock_guard<std::mutex> lock(modelMutex);
+    auto fit = fits.find(model);
+    return fit != fits.end() && fit->second.valid;
+}
+
+void TrainingResourceModel::clear() {
+    std::lock_guard<std::mutex> lock(modelMutex);
+    samples.clear();
+    fits.clear();
+}
@@ -0,0 +1,101 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_TRAININGRESOURCEMODEL_H
+#define JASMINEGRAPH_TRAININGRESOURCEMODEL_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../../performancedb/PerformanceSQLiteDBInterface.h"
+#include "TrainingProfiler.h"
+
+// Size of a partition as seen by the training process, the central store included
+struct TrainingInput {
+    std::string graphId;
+    std::string partitionId;
+    long vertexCount = 0;
+    long edgeCount = 0;
+    int featureCount = 0;
+};
+
+struct TrainingEstimate {
+    long memory = 0;          // Peak memory in KB
+    long time = 0;            // Milliseconds
+    double cpuFraction = 1;   // Share of the time spent on the CPU, the rest waits for I/O
+    bool measured = false;    // False when there are no profiles yet and the formula is used
+};
+
+/**
+ * Predicts the peak memory and the run time of training a partition from profiles of earlier runs. A partition
+ * that was trained with the same feature count before is predicted by its own highest peak and latest time.
+ * Other partitions are predicted by a least squares fit per model of the peak and the time over the vertex count,
+ * the vertex count times the feature count and the edge count, once the model has MIN_FIT_SAMPLES profiles.
+ * Until then the size formula of the dense GraphSAGE matrices is used.
+ *
+ * The estimates handed to the scheduler are kept in training_performance and completed with the measured
+ * resources when the profile of the run arrives, so every run reports how far off its prediction was.
+ */
+class TrainingResourceModel {
+ public:
+    static const int MIN_FIT_SAMPLES = 8;
+    static const size_t MAX_SAMPLES = 1000;
+    // Fitted peaks are scaled up since running out of memory costs more than running fewer partitions at once
+    static constexpr double MEMORY_HEADROOM = 1.2;
+    // Vertex features and edges a partition trains per millisecond, used by the formula
+    static constexpr double DEFAULT_ELEMENTS_PER_MS = 100;
+
+    // Learn from the profiled runs in the performance DB
+    static void load(PerformanceSQLiteDBInterface *perfDb);
+
+    static TrainingEstimate estimate(const std::string &model, const TrainingInput &input);
+
+    static TrainingEstimate formulaEstimate(const TrainingInput &input);
+
+    // Keep the estimate of a scheduled run to compare with its profile
+    static void recordEstimate(PerformanceSQLiteDBInterface *perfDb, const std::string &model, const std::string &host,
+                               const TrainingInput &input, const TrainingEstimate &estimate);
+
+    // Add the profile of a finished run to the model and report it against the estimate of the run
+    static void recordRun(PerformanceSQLiteDBInterface *perfDb, const TrainingInput &input,
+                          const TrainingProfile &profile);
+
+    static void addSample(const std::string &model, const TrainingInput &input, const TrainingProfile &profile);
+
+    static bool isFitted(const std::string &model);
+
+    static void clear();
+
+ private:
+    struct Sample {
+        TrainingInput input;
+        TrainingProfile profile;
+    };
+
+    struct Fit {
+        bool valid = false;
+        double memory[4];
+        double time[4];
+        double cpuFraction = 1;
+    };
+
+    static void refit(const std::string &model);
+
+    static std::mutex modelMutex;
+    static std::map<std::string, std::vector<Sample>> samples;
+    static std::map<std::string, Fit> fits;
+};
+
+#endif  // JASMINEGRAPH_TRAININGRESOURCEMODEL_H
@@ -0,0 +1,216 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "EdgeFilter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "../util/logger/Logger.h"
+
+Logger edge_filter_logger;
+
+const uint32_t EdgeFilter::MAGIC = 0x4645474a;  // "JGEF"
+const uint32_t EdgeFilter::VERSION = 1;
+const uint64_t EdgeFilter::DEFAULT_CAPACITY = 1 << 16;
+const int EdgeFilter::BITS_PER_KEY = 16;
+
+static const int WORDS_PER_BLOCK = 8;
+static const uint32_t SALTS[WORDS_PER_BLOCK] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                                0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+static uint64_t hashKey(unsigned int source, unsigned int destination) {
+    uint64_t key = (static_cast<uint64_t>(std::min(source, destination)) << 32) | std::max(source, destination);
+    // splitmix64 finalizer
+    key += 0x9e3779b97f4a7c15ULL;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+}
+
+EdgeFilter::EdgeFilter(uint64_t capacity) : initialCapacity(std::max<uint64_t>(capacity, 1)) {
+    addLayer(initialCapacity);
+}
+
+void EdgeFilter::addLayer(uint64_t capacity) {
+    uint64_t blockCount = std::max<uint64_t>(1, (capacity * BITS_PER_KEY + 255) / 256);
+    Layer layer;
+    layer.capacity = capacity;
+    layer.count = 0;
+    layer.words.assign(blockCount * WORDS_PER_BLOCK, 0);
+    layers.push_back(std::move(layer));
+}
+
+void EdgeFilter::insert(unsigned int source, unsigned int destination) {
+    if (layers.back().count >= layers.back().capacity) {
+        addLayer(layers.back().capacity * 2);
+    }
+    Layer &layer = layers.back();
+    uint64_t hash = hashKey(source, destination);
+    uint64_t block = ((hash >> 32) * (layer.words.size() / WORDS_PER_BLOCK)) >> 32;
+    uint32_t *words = &layer.words[block * WORDS_PER_BLOCK];
+    for (int i = 0; i < WORDS_PER_BLOCK; i++) {
+        words[i] |= 1U << ((static_cast<uint32_t>(hash) * SALTS[i]) >> 27);
+    }
+    layer.count++;
+    keyCount++;
+}
+
+bool EdgeFilter::mayContain(unsigned int source, unsigned int destination) {
+    lookups++;
+    uint64_t hash = hashKey(source, destination);
+    for (auto &layer : layers) {
+        uint64_t block = ((hash >> 32) * (layer.words.size() / WORDS_PER_BLOCK)) >> 32;
+        const uint32_t *words = &layer.words[block * WORDS_PER_BLOCK];
+        bool found = true;
+        for (int i = 0; i < WORDS_PER_BLOCK && found; i++) {
+            found = (words[i] >> ((static_cast<uint32_t>(hash) * SALTS[i]) >> 27)) & 1;
+        }
+        if (found) {
+            positives++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void EdgeFilter::clear() {
+    layers.clear();
+    addLayer(initialCapacity);
+    keyCount = 0;
+    lookups = 0;
+    positives = 0;
+    falsePositives = 0;
+}
+
+size_t EdgeFilter::getSizeInBytes() const {
+    size_t bytes = 0;
+    for (auto &layer : layers) {
+        bytes += layer.words.size() * sizeof(uint32_t);
+    }
+    return bytes;
+}
+
+double EdgeFilter::getFalsePositiveRate() const {
+    long negatives = lookups - (positives - falsePositives);
+    return negatives == 0 ? 0.0 : static_cast<double>(falsePositives) / negatives;
+}
+
+bool EdgeFilter::write(const std::string &filePath, uint64_t relationCount) const {
+    // Write to a temporary file and rename it so a reader never loads a partially written filter
+    std::string tempPath = filePath + ".tmp";
+    std::ofstream filterFile(tempPath, std::ios::binary | std::ios::trunc);
+    if (!filterFile.is_open()) {
+        edge_filter_logger.error("Cannot open edge filter " + tempPath + " for writing");
+        return false;
+    }
+
+    uint32_t layerCount = layers.size();
+    filterFile.write(reinterpret_cast<const char *>(&MAGIC), sizeof(MAGIC));
+    filterFile.write(reinterpret_cast<const char *>(&VERSION), sizeof(VERSION));
+    filterFile.write(reinterpret_cast<const char *>(&relationCount), sizeof(relationCount));
+    filterFile.write(reinterpret_cast<const char *>(&keyCount), sizeof(keyCount));
+    filterFile.write(reinterpret_cast<const char *>(&layerCount), sizeof(layerCount));
+    for (auto &layer : layers) {
+        uint64_t wordCount = layer.words.size();
+        filterFile.write(reinterpret_cast<const char *>(&layer.capacity), sizeof(layer.capacity));
+        filterFile.write(reinterpret_cast<const char *>(&layer.count), sizeof(layer.count));
+        filterFile.write(reinterpret_cast<const char *>(&wordCount), sizeof(wordCount));
+        filterFile.write(reinterpret_cast<const char *>(layer.words.data()), wordCount * sizeof(uint32_t));
+    }
+    filterFile.close();
+    if (!filterFile) {
+        edge_filter_logger.error("Error while writing edge filter " + tempPath);
+        return false;
+    }
+
+    if (std::rename(tempPath.c_str(), filePath.c_str()) != 0) {
+        edge_filter_logger.error("Cannot move edge filter into place " + filePath);
+        return false;
+    }
+    return true;
+}
+
+bool EdgeFilter::read(const std::string &filePath, uint64_t &relationCount) {
+    std::ifstream filterFile(filePath, std::ios::binary | std::ios::in);
+    if (!filterFile.is_open()) {
+        return false;
+    }
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t count = 0;
+    uint32_t layerCount = 0;
+    filterFile.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    filterFile.read(reinterpret_cast<char *>(&version), sizeof(version));
+    filterFile.read(reinterpret_cast<char *>(&relationCount), sizeof(relationCount));
+    filterFile.read(reinterpret_cast<char *>(&count), sizeof(count));
+    filterFile.read(reinterpret_cast<char *>(&layerCount), sizeof(layerCount));
+    if (!filterFile || magic != MAGIC || version != VERSION || layerCount == 0) {
+        edge_filter_logger.warn("Ignoring incompatible edge filter " + filePath);
+        return false;
+    }
+
+    std::vector<Layer> readLayers(layerCount);
+    for (auto &layer : readLayers) {
+        uint64_t wordCount = 0;
+        filterFile.read(reinterpret_cast<char *>(&layer.capacity), sizeof(layer.capacity));
+        filterFile.read(reinterpret_cast<char *>(&layer.count), sizeof(layer.count));
+        filterFile.read(reinterpret_cast<char *>(&wordCount), sizeof(wordCount));
+        if (!filterFile || wordCount == 0 || wordCount % WORDS_PER_BLOCK != 0) {
+            edge_filter_logger.error("Edge filter " + filePath + " is corrupted");
+            return false;
+        }
+        layer.words.resize(wordCount);
+        if (!filterFile.read(reinterpret_cast<char *>(layer.words.data()), wordCount * sizeof(uint32_t))) {
+            edge_filter_logger.error("Edge filter " + filePath + " is truncated");
+            return false;
+        }
+    }
+    layers = std::move(readLayers);
+    keyCount = count;
+    return true;
+}
+
+bool EdgeFilter::rebuild(const std::string &relationsDBPath, unsigned long blockSize) {
+    std::ifstream relationsFile(relationsDBPath, std::ios::binary | std::ios::in);
+    if (!relationsFile.is_open()) {
+        return false;
+    }
+    clear();
+
+    // Relation blocks start with the ids and then the block addresses of the source and destination nodes
+    const size_t blocksPerRead = 4096;
+    std::vector<char> buffer(blockSize * blocksPerRead);
+    uint64_t blockIndex = 0;
+    while (relationsFile) {
+        relationsFile.read(buffer.data(), buffer.size());
+        size_t blocksRead = relationsFile.gcount() / blockSize;
+        for (size_t i = 0; i < blocksRead; i++, blockIndex++) {
+            // Block 0 is never allocated
+            if (blockIndex == 0) {
+                continue;
+            }
+            unsigned int source;
+            unsigned int destination;
+            memcpy(&source, &buffer[i * blockSize + 2 * sizeof(unsigned int)], sizeof(unsigned int));
+            memcpy(&destination, &buffer[i * blockSize + 3 * sizeof(unsigned int)], sizeof(unsigned int));
+            insert(source, destination);
+        }
+    }
+    edge_filter_logger.info("Rebuilt edge filter of " + relationsDBPath + " with " + std::to_string(keyCount) +
+                            " relations");
+    return true;
+}
@@ -0,0 +1,89 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_EDGEFILTER_H
+#define JASMINEGRAPH_EDGEFILTER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Membership filter of the relations of a native store partition, keyed on the block addresses of the two nodes.
+ * A negative answer means the relation is certainly new, so inserting it needs no walk of the relation chain of the
+ * source node. A positive answer may be false and is confirmed by the walk.
+ *
+ * Each layer is a split block Bloom filter: a key sets one bit in each of the eight 32 bit words of a single 32 byte
+ * block, so a lookup touches one cache line. When a layer holds the number of keys it was sized for, a layer of
+ * twice the capacity is added, which keeps the false positive rate bounded without rehashing the existing keys.
+ *
+ * Keys are unordered pairs, so the filter answers for both directions of an edge as the undirected relation search
+ * does. For a directed graph the reverse edge is only a false positive.
+ */
+class EdgeFilter {
+ public:
+    static const uint32_t MAGIC;
+    static const uint32_t VERSION;
+    static const uint64_t DEFAULT_CAPACITY;
+    static const int BITS_PER_KEY;
+
+    explicit EdgeFilter(uint64_t capacity = DEFAULT_CAPACITY);
+
+    void insert(unsigned int source, unsigned int destination);
+
+    // False if the relation was never inserted. Counted for the false positive rate.
+    bool mayContain(unsigned int source, unsigned int destination);
+
+    // Report that a positive answer was not confirmed by the relation chain
+    void recordFalsePositive() { falsePositives++; }
+
+    void clear();
+
+    uint64_t size() const { return keyCount; }
+
+    size_t getSizeInBytes() const;
+
+    long getLookupCount() const { return lookups; }
+
+    long getFalsePositiveCount() const { return falsePositives; }
+
+    // False positives among the lookups of relations that did not exist
+    double getFalsePositiveRate() const;
+
+    // The relation count is the number of relation blocks the filter covers, so a filter that missed the last
+    // inserts (a worker that stopped without closing the store) is detected and rebuilt when it is read
+    bool write(const std::string &filePath, uint64_t relationCount) const;
+
+    bool read(const std::string &filePath, uint64_t &relationCount);
+
+    // Insert the relations of a relations DB file by reading it sequentially
+    bool rebuild(const std::string &relationsDBPath, unsigned long blockSize);
+
+ private:
+    struct Layer {
+        uint64_t capacity;
+        uint64_t count;
+        std::vector<uint32_t> words;
+    };
+
+    std::vector<Layer> layers;
+    uint64_t initialCapacity;
+    uint64_t keyCount = 0;
+    long lookups = 0;
+    long positives = 0;
+    long falsePositives = 0;
+
+    void addLayer(uint64_t capacity);
+};
+
+#endif  // JASMINEGRAPH_EDGEFILTER_H
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include "../util/logger/Logger.h"
 #include "RelationBlock.h"
+#include "WriteAheadLog.h"
 
 Logger node_block_logger;
 pthread_mutex_t lockSaveNode;
@@ -47,13 +48,13 @@ void NodeBlock::setLabel(const char *_label) {
 
 void NodeBlock::save() {
     //    pthread_mutex_lock(&lockSaveNode);
-    char _label[PropertyLink::MAX_VALUE_SIZE] = {0};
-    std::strcpy(_label, id.c_str());
-
     bool isSmallLabel = id.length() <= sizeof(label) * 2;
         if (isSmallLabel) {
             std::strcpy(this->label, this->id.c_str());
         }
+    if (WriteAheadLog::storeLog) {
+        WriteAheadLog::storeLog->saveBeforeImage(NodeBlock::nodesDB, this->addr, NodeBlock::BLOCK_SIZE);
+    }
     NodeBlock::nodesDB->seekp(this->addr);
     NodeBlock::nodesDB->put(this->usage);                                                                       // 1
     NodeBlock::nodesDB->write(reinterpret_cast<char*>(&(this->nodeId)), sizeof(this->nodeId));                  // 4
@@ -66,29 +67,26 @@ void NodeBlock::save() {
     //    pthread_mutex_unlock(&lockSaveNode);
 
         if (!isSmallLabel) {
-            this->addProperty("label", _label);
+            this->addProperty("label", this->id);
         }
 }
 
-void NodeBlock::addProperty(std::string name, const char* value) {
-    if (this->propRef == 0) {
-        PropertyLink* newLink = PropertyLink::create(name, value);
-        //        pthread_mutex_lock(&lockAddNodeProperty);
-        if (newLink) {
-            this->propRef = newLink->blockAddress;
-            // If it was an empty prop link before inserting, Then update the property reference of this node
-            // block
-            //            node_block_logger.info("propRef = " + std::to_string(this->propRef));
-            NodeBlock::nodesDB->seekp(this->addr + sizeof(this->nodeId) + sizeof(this->edgeRef) +
-                                      sizeof(this->centralEdgeRef) + sizeof(this->edgeRefPID));
-            NodeBlock::nodesDB->write(reinterpret_cast<char*>(&(this->propRef)), sizeof(this->propRef));
-            NodeBlock::nodesDB->flush();
-        } else {
-            node_block_logger.error("Error occurred while adding a new property link to " +
-                        std::to_string(this->addr) + " node block");
+void NodeBlock::addProperty(const std::string &name, const std::string &value) {
+    if (WriteAheadLog::storeLog) {
+        WriteAheadLog::storeLog->logNodeProperty(this->id, name, value);
+    }
+    unsigned int newRef = PropertyStore::nodeProperties->put(this->propRef, name, value, this->addr);
+    if (newRef != this->propRef) {
+        // The reference changes when the properties of the node move to a larger run
+        this->propRef = newRef;
+        unsigned int propRefAddress = this->addr + sizeof(this->usage) + sizeof(this->nodeId) + sizeof(this->edgeRef) +
+                                      sizeof(this->centralEdgeRef) + sizeof(this->edgeRefPID);
+        if (WriteAheadLog::storeLog) {
+            WriteAheadLog::storeLog->saveBeforeImage(NodeBlock::nodesDB, propRefAddress, sizeof(this->propRef));
         }
-    } else {
-        this->propRef = this->getPropertyHead()->insert(name, value);
+        NodeBlock::nodesDB->seekp(propRefAddress);
+        NodeBlock::nodesDB->write(reinterpret_cast<char*>(&(this->propRef)), sizeof(this->propRef));
+        NodeBlock::nodesDB->flush();
     }
 }
 
@@ -209,6 +207,10 @@ RelationBlock* NodeBlock::getCentralRelationHead() {
 bool NodeBlock::setLocalRelationHead(RelationBlock newRelation) {
     unsigned int edgeReferenceAddress = newRelation.addr;
     int edgeReferenceOffset = sizeof(this->usage) + sizeof(this->nodeId);
+    if (WriteAheadLog::storeLog) {
+        WriteAheadLog::storeLog->saveBeforeImage(NodeBlock::nodesDB, this->addr + edgeReferenceOffset,
+                                                 sizeof(unsigned int));
+    }
     NodeBlock::nodesDB->seekp(this->addr + edgeReferenceOffset);
     if (!NodeBlock::nodesDB->write(reinterpret_cast<char*>(&(edgeReferenceAddress)), sizeof(unsigned int))) {
         node_block_logger.error("ERROR: Error while updating edge reference address of " +
@@ -223,6 +225,10 @@ bool NodeBlock::setLocalRelationHead(RelationBlock newRelation) {
 bool NodeBlock::setCentralRelationHead(RelationBlock newRelation) {
     unsigned int centralEdgeReferenceAddress = newRelation.addr;
     int edgeReferenceOffset = sizeof(this->usage) + sizeof(this->nodeId);
+    if (WriteAheadLog::storeLog) {
+        WriteAheadLog::storeLog->saveBeforeImage(
+            NodeBlock::nodesDB, this->addr + edgeReferenceOffset + sizeof(this->edgeRef), sizeof(unsigned int));
+    }
     NodeBlock::nodesDB->seekp(this->addr + edgeReferenceOffset + sizeof(this->edgeRef));
     if (!NodeBlock::nodesDB->write(reinterpret_cast<char*>(&(centralEdgeReferenceAddress)), sizeof(unsigned int))) {
         node_block_logger.error("ERROR: Error while updating edge reference address of " +
@@ -361,17 +367,8 @@ std::list<NodeBlock*> NodeBlock::getAllEdgeNodes() {
     return allEdges;
 }
 
-std::map<std::string, char*> NodeBlock::getAllProperties() {
-    std::map<std::string, char*> allProperties;
-    PropertyLink* current = this->getPropertyHead();
-    while (current) {
-        allProperties.insert({current->name, current->value});
-        PropertyLink* temp = current->next();
-        delete current;  // To prevent memory leaks
-        current = temp;
-    }
-    delete current;
-    return allProperties;
+std::map<std::string, std::string> NodeBlock::getAllProperties() {
+    return PropertyStore::nodeProperties->getAll(this->propRef);
 }
 
 NodeBlock* NodeBlock::get(unsigned int blockAddress) {
@@ -423,9 +420,10 @@ NodeBlock* NodeBlock::get(unsigned int blockAddress) {
     nodeBlockPointer =
         new NodeBlock(id, nodeId, blockAddress, propRef, edgeRef, centralEdgeRef, edgeRefPID, label, usage);
     if (nodeBlockPointer->id.length() == 0) {  // if label not found in node block look in the properties
-        std::map<std::string, char*> props = nodeBlockPointer->getAllProperties();
-        if (props["label"]) {
-            nodeBlockPointer->id = props["label"];
+        std::map<std::string, std::string> props = nodeBlockPointer->getAllProperties();
+        auto label = props.find("label");
+        if (label != props.end()) {
+            nodeBlockPointer->id = label->second;
         } else {
             node_block_logger.error("Could not find node ID/Label for node with block address = " +
                 std::to_string(nodeBlockPointer->addr));
@@ -438,5 +436,4 @@ NodeBlock* NodeBlock::get(unsigned int blockAddress) {
     return nodeBlockPointer;
 }
 
-PropertyLink* NodeBlock::getPropertyHead() { return PropertyLink::get(this->propRef); }
 thread_local std::fstream* NodeBlock::nodesDB = NULL;
@@ -17,7 +17,7 @@ limitations under the License.
 #include <map>
 #include <string>
 
-#include "PropertyLink.h"
+#include "PropertyStore.h"
 
 class RelationBlock;  // Forward declaration
 
@@ -67,10 +67,8 @@ class NodeBlock {
     int getFlags();
     static NodeBlock *get(unsigned int);
 
-    void addProperty(std::string, const char *);
-    std::map<std::string, char *> getProperty(std::string);
-    PropertyLink *getPropertyHead();
-    std::map<std::string, char *> getAllProperties();
+    void addProperty(const std::string &name, const std::string &value);
+    std::map<std::string, std::string> getAllProperties();
 
     bool updateLocalRelation(RelationBlock *, bool relocateHead = true);
     bool updateCentralRelation(RelationBlock *newRelation, bool relocateHead = true);
@@ -21,18 +21,25 @@ limitations under the License.
 #include "../util/Utils.h"
 #include "../util/logger/Logger.h"
 #include "NodeBlock.h"  // To setup node DB
-#include "PropertyEdgeLink.h"
-#include "PropertyLink.h"
+#include "PropertyStore.h"
 #include "RelationBlock.h"
+#include "StoreCompactor.h"
+#include "WriteAheadLog.h"
 #include "iostream"
 #include <sys/stat.h>
 
 Logger node_manager_logger;
 pthread_mutex_t lockEdgeAdd;
 
+// The edge filter of <prefix>_relations.db is persisted in <prefix>_relations.filter.db
+static std::string getEdgeFilterPath(std::string relationsDBPath) {
+    return relationsDBPath.substr(0, relationsDBPath.size() - 3) + ".filter.db";
+}
+
 NodeManager::NodeManager(GraphConfig gConfig) {
     this->graphID = gConfig.graphID;
     this->partitionID = gConfig.partitionID;
+    this->readOnly = gConfig.readOnly;
     Utils utils;
 
     std::string instanceDataFolderLocation =
@@ -41,8 +48,8 @@ NodeManager::NodeManager(GraphConfig gConfig) {
     dbPrefix = graphPrefix + "_p" + std::to_string(partitionID);
     std::string nodesDBPath = dbPrefix + "_nodes.db";
     indexDBPath = dbPrefix + "_nodes.index.db";
-    std::string propertiesDBPath = dbPrefix + "_properties.db";
-    std::string edgePropertiesDBPath = dbPrefix + "_edge_properties.db";
+    std::string legacyPropertiesDBPath = dbPrefix + "_properties.db";
+    std::string legacyEdgePropertiesDBPath = dbPrefix + "_edge_properties.db";
     std::string relationsDBPath = dbPrefix + "_relations.db";
     std::string centralRelationsDBPath = dbPrefix + "_central_relations.db";
     // This needs to be set in order to prevent index DB key overflows
@@ -59,11 +66,44 @@ NodeManager::NodeManager(GraphConfig gConfig) {
         node_manager_logger.info("Setting index key size to: " + std::to_string(gConfig.maxLabelSize));
     }
 
+    // Held until the store is closed, so that the partition is not compacted while it is open
+    partitionLock = new StoreCompactor::PartitionLock();
+    if (!gConfig.partitionLocked && !partitionLock->lock(dbPrefix, false)) {
+        node_manager_logger.error("Could not lock partition " + dbPrefix);
+    }
+
+    // The files of a compaction that was interrupted are moved in place or removed before the store is read
+    StoreCompactor::finish(dbPrefix);
+
+    // A partition left behind by a crash is brought back to its last checkpoint before it is read, and the records
+    // logged since are redone once the store is open
+    long walCheckpointRecords = gConfig.checkpointRecords;
+    if (walCheckpointRecords < 0) {
+        std::string configured = Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.wal.checkpoint.records");
+        walCheckpointRecords = Utils::is_number(configured) ? std::stol(configured) : 0;
+    }
+    WriteAheadLog *log = NULL;
+    std::vector<WriteAheadLog::Record> redoRecords;
+    if (walCheckpointRecords > 0 && !readOnly) {
+        log = new WriteAheadLog(dbPrefix);
+        if (!log->lock()) {
+            node_manager_logger.info("Not logging the writes to " + dbPrefix + ", another node manager logs them");
+            delete log;
+            log = NULL;
+        } else if (gConfig.openMode != NodeManager::FILE_MODE) {
+            std::remove(log->getPath().c_str());
+        } else if (!log->recover(redoRecords)) {
+            node_manager_logger.error("Could not recover " + dbPrefix + " from its write-ahead log");
+        }
+    }
+
     std::ios_base::openmode openMode = std::ios::in | std::ios::out;  // Default mode
     if (gConfig.openMode == NodeManager::FILE_MODE) {
         this->nodeIndex = readNodeIndex();
     } else {
         openMode |= std::ios::trunc;
+        // The index is appended to as nodes are added, so entries of a previous store must not survive a crash
+        std::remove(indexDBPath.c_str());
     }
 
     if (gConfig.openMode == NodeManager::FILE_MODE) {
@@ -72,32 +112,25 @@ NodeManager::NodeManager(GraphConfig gConfig) {
         node_manager_logger.info("Using TRUNC mode for file operations.");
     }
 
-    NodeBlock::nodesDB = Utils::openFile(nodesDBPath, openMode);
-    PropertyLink::propertiesDB = Utils::openFile(propertiesDBPath, openMode);
-    PropertyEdgeLink::edgePropertiesDB = Utils::openFile(edgePropertiesDBPath, openMode);
-    RelationBlock::relationsDB = utils.openFile(relationsDBPath, openMode);
-    RelationBlock::centralRelationsDB = Utils::openFile(centralRelationsDBPath, openMode);
+    // Partitions written with the linked property blocks are moved to the property stores once
+    if (gConfig.openMode == NodeManager::FILE_MODE && !readOnly &&
+        (Utils::fileExists(legacyPropertiesDBPath) || Utils::fileExists(legacyEdgePropertiesDBPath))) {
+        PropertyStore::migrate(dbPrefix);
+    }
+
+    nodesDB = NodeBlock::nodesDB = Utils::openFile(nodesDBPath, openMode);
+    nodeProperties = PropertyStore::nodeProperties = new PropertyStore();
+    nodeProperties->open(dbPrefix + "_properties", gConfig.openMode != NodeManager::FILE_MODE);
+    edgeProperties = PropertyStore::edgeProperties = new PropertyStore();
+    edgeProperties->open(dbPrefix + "_edge_properties", gConfig.openMode != NodeManager::FILE_MODE);
+    relationsDB = RelationBlock::relationsDB = utils.openFile(relationsDBPath, openMode);
+    centralRelationsDB = RelationBlock::centralRelationsDB = Utils::openFile(centralRelationsDBPath, openMode);
 
     //    RelationBlock::centralpropertiesDB =
     //            new std::fstream(dbPrefix + "_central_relations.db", std::ios::in | std::ios::out | openMode |
     //            std::ios::binary);
-    // TODO (tmkasun): set PropertyLink nextPropertyIndex after validating by modulus check from file number of bytes
 
     node_manager_logger.log("NodesDB, PropertiesDB, and RelationsDB files opened (or created) successfully.", "info");
-    //    unsigned int nextAddress;
-    //    unsigned int propertyBlockAddress = 0;
-    //    PropertyLink::propertiesDB->seekg(propertyBlockAddress * PropertyLink::PROPERTY_BLOCK_SIZE);
-    //    if (PropertyLink::propertiesDB && PropertyLink::propertiesDB->is_open()) {
-    //        PropertyLink::propertiesDB->seekg(propertyBlockAddress * PropertyLink::PROPERTY_BLOCK_SIZE);
-    //        if (!PropertyLink::propertiesDB->read(reinterpret_cast<char*>(&(nextAddress)), sizeof(unsigned int))) {
-    //            node_manager_logger.error("Error while reading node property next address from block = " +
-    //            std::to_string(propertyBlockAddress));
-    //        }
-    //    } else {
-    //        node_manager_logger.error("Failed to open propertiesDB file.");
-    //    }
-    //
-    //    node_manager_logger.log("Checking NextAddress : " + nextAddress, "info");
 
     if (dbSize(nodesDBPath) % NodeBlock::BLOCK_SIZE != 0) {
         node_manager_logger.warn("NodesDB size: " + std::to_string(dbSize(nodesDBPath)) +
@@ -118,21 +151,6 @@ NodeManager::NodeManager(GraphConfig gConfig) {
 
     struct stat stat_buf;
 
-    if (stat(propertiesDBPath.c_str(), &stat_buf) == 0) {
-        PropertyLink::nextPropertyIndex = (stat_buf.st_size / PropertyLink::PROPERTY_BLOCK_SIZE) == 0 ? 1 :
-                (stat_buf.st_size / PropertyLink::PROPERTY_BLOCK_SIZE);
-
-    } else {
-        node_manager_logger.error("Error getting file size for: " + propertiesDBPath);
-    }
-
-    if (stat(edgePropertiesDBPath.c_str(), &stat_buf) == 0) {
-        PropertyEdgeLink::nextPropertyIndex = (stat_buf.st_size / PropertyEdgeLink::PROPERTY_BLOCK_SIZE) == 0 ? 1 :
-                                            (stat_buf.st_size / PropertyEdgeLink::PROPERTY_BLOCK_SIZE);
-    } else {
-        node_manager_logger.error("Error getting file size for: " + edgePropertiesDBPath);
-    }
-
     if (stat(relationsDBPath.c_str(), &stat_buf) == 0) {
         RelationBlock::nextLocalRelationIndex = (stat_buf.st_size / RelationBlock::BLOCK_SIZE) == 0 ? 1 :
                                         (stat_buf.st_size / RelationBlock::BLOCK_SIZE);
@@ -146,9 +164,112 @@ NodeManager::NodeManager(GraphConfig gConfig) {
     } else {
         node_manager_logger.error("Error getting file size for: " + centralRelationsDBPath);
     }
+
+    if (gConfig.openMode == NodeManager::FILE_MODE) {
+        loadEdgeFilter(localEdgeFilter, relationsDBPath);
+        loadEdgeFilter(centralEdgeFilter, centralRelationsDBPath);
+    } else {
+        std::remove(getEdgeFilterPath(relationsDBPath).c_str());
+        std::remove(getEdgeFilterPath(centralRelationsDBPath).c_str());
+    }
+
+    WriteAheadLog::storeLog = NULL;
+    if (log) {
+        replay(redoRecords);
+        writeAheadLog = log;
+        checkpointRecords = walCheckpointRecords;
+        writeAheadLog->setSync(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.wal.sync") == "true");
+        checkpoint();
+        WriteAheadLog::storeLog = writeAheadLog;
+    }
     node_manager_logger.info("Node Manager Execution Completed!");
 }
 
+NodeManager::~NodeManager() {
+    delete NodeBlock::nodesDB;
+    // Without a checkpoint, as after a crash
+    if (WriteAheadLog::storeLog == writeAheadLog) {
+        WriteAheadLog::storeLog = NULL;
+    }
+    delete writeAheadLog;
+    delete partitionLock;
+}
+
+void NodeManager::replay(const std::vector<WriteAheadLog::Record> &records) {
+    for (auto &record : records) {
+        const std::vector<std::string> &fields = record.fields;
+        bool central =
+            record.type == WriteAheadLog::CENTRAL_EDGE || record.type == WriteAheadLog::CENTRAL_EDGE_PROPERTY;
+        if (record.type == WriteAheadLog::LOCAL_EDGE || record.type == WriteAheadLog::CENTRAL_EDGE) {
+            if (central) {
+                addCentralEdge({fields[0], fields[1]});
+            } else {
+                addLocalEdge({fields[0], fields[1]});
+            }
+            continue;
+        }
+        if (record.type == WriteAheadLog::NODE_PROPERTY) {
+            NodeBlock *node = get(fields[0]);
+            if (node) {
+                node->addProperty(fields[1], fields[2]);
+                delete node;
+            }
+            continue;
+        }
+
+        NodeBlock *source = get(fields[0]);
+        NodeBlock *destination = get(fields[1]);
+        RelationBlock *relation = NULL;
+        if (source && destination) {
+            relation =
+                central ? source->searchCentralRelation(*destination) : source->searchLocalRelation(*destination);
+        }
+        if (!relation) {
+            node_manager_logger.warn("No relation from " + fields[0] + " to " + fields[1] + " for the property " +
+                                     fields[2]);
+        } else if (central) {
+            relation->addCentralProperty(fields[2], fields[3]);
+        } else {
+            relation->addLocalProperty(fields[2], fields[3]);
+        }
+        delete relation;
+        delete source;
+        delete destination;
+    }
+}
+
+void NodeManager::checkpoint() {
+    if (!writeAheadLog) {
+        return;
+    }
+    nodesDB->flush();
+    relationsDB->flush();
+    centralRelationsDB->flush();
+    nodeProperties->flush();
+    edgeProperties->flush();
+    std::map<std::string, std::fstream *> files;
+    files[dbPrefix + "_nodes.db"] = nodesDB;
+    files[dbPrefix + "_relations.db"] = relationsDB;
+    files[dbPrefix + "_central_relations.db"] = centralRelationsDB;
+    files[indexDBPath] = NULL;
+    nodeProperties->getFiles(files);
+    edgeProperties->getFiles(files);
+    if (!writeAheadLog->checkpoint(files)) {
+        node_manager_logger.error("Could not checkpoint " + dbPrefix);
+    }
+}
+
+void NodeManager::logEdge(bool central, const std::pair<std::string, std::string> &edge) {
+    if (!writeAheadLog) {
+        return;
+    }
+    // Checkpoint before the log outgrows the interval, which bounds the records a recovery redoes
+    if (writeAheadLog->getRecordCount() >= checkpointRecords) {
+        checkpoint();
+    }
+    writeAheadLog->logEdge(central, edge.first, edge.second);
+}
+
 std::unordered_map<std::string, unsigned int> NodeManager::readNodeIndex() {
     std::ifstream index_db(indexDBPath, std::ios::app | std::ios::binary);
     std::unordered_map<std::string, unsigned int> _nodeIndex;  // temporary node index data holder
@@ -181,15 +302,42 @@ std::unordered_map<std::string, unsigned int> NodeManager::readNodeIndex() {
     return _nodeIndex;
 }
 
+void NodeManager::loadEdgeFilter(EdgeFilter &edgeFilter, std::string relationsDBPath) {
+    uint64_t relationCount = 0;
+    // A filter written before the last relations were added would miss them, so it is rebuilt from the relations
+    if (edgeFilter.read(getEdgeFilterPath(relationsDBPath), relationCount) &&
+        relationCount == dbSize(relationsDBPath) / RelationBlock::BLOCK_SIZE) {
+        return;
+    }
+    if (!edgeFilter.rebuild(relationsDBPath, RelationBlock::BLOCK_SIZE)) {
+        node_manager_logger.error("Cannot rebuild the edge filter of " + relationsDBPath);
+    }
+}
+
+void NodeManager::persistEdgeFilter(EdgeFilter &edgeFilter, std::string relationsDBPath) {
+    node_manager_logger.info("Edge filter of " + relationsDBPath + " answered " +
+                             std::to_string(edgeFilter.getLookupCount()) + " lookups with a false positive rate of " +
+                             std::to_string(edgeFilter.getFalsePositiveRate()));
+    edgeFilter.write(getEdgeFilterPath(relationsDBPath), dbSize(relationsDBPath) / RelationBlock::BLOCK_SIZE);
+}
+
 RelationBlock *NodeManager::addLocalRelation(NodeBlock source, NodeBlock destination) {
     RelationBlock *newRelation = NULL;
-    if (source.edgeRef == 0 || destination.edgeRef == 0 ||
-        !source.searchLocalRelation(destination)) {  // certainly a new relation block needed
+    bool exists = false;
+    // Only the relations the edge filter may contain need a walk of the relation chain
+    if (source.edgeRef != 0 && destination.edgeRef != 0 && localEdgeFilter.mayContain(source.addr, destination.addr)) {
+        exists = source.searchLocalRelation(destination) != NULL;
+        if (!exists) {
+            localEdgeFilter.recordFalsePositive();
+        }
+    }
+    if (!exists) {  // certainly a new relation block needed
         RelationBlock *relationBlock = new RelationBlock(source, destination);
         newRelation = relationBlock->addLocalRelation(source, destination);
         if (newRelation) {
             source.updateLocalRelation(newRelation, true);
             destination.updateLocalRelation(newRelation, true);
+            localEdgeFilter.insert(source.addr, destination.addr);
         } else {
             node_manager_logger.error("Error while adding the new edge/relation for source = " +
                                       std::string(source.id) + " destination = " + std::string(destination.id));
@@ -206,13 +354,21 @@ RelationBlock *NodeManager::addLocalRelation(NodeBlock source, NodeBlock destina
 
 RelationBlock *NodeManager::addCentralRelation(NodeBlock source, NodeBlock destination) {
     RelationBlock *newRelation = NULL;
-    if (source.centralEdgeRef == 0 || destination.centralEdgeRef == 0 ||
-        !source.searchCentralRelation(destination)) {  // certainly a new relation block needed
+    bool exists = false;
+    if (source.centralEdgeRef != 0 && destination.centralEdgeRef != 0 &&
+        centralEdgeFilter.mayContain(source.addr, destination.addr)) {
+        exists = source.searchCentralRelation(destination) != NULL;
+        if (!exists) {
+            centralEdgeFilter.recordFalsePositive();
+        }
+    }
+    if (!exists) {  // certainly a new relation block needed
         RelationBlock *relationBlock = new RelationBlock(source, destination);
         newRelation = relationBlock->addCentralRelation(source, destination);
         if (newRelation) {
             source.updateCentralRelation(newRelation, true);
             destination.updateCentralRelation(newRelation, true);
+            centralEdgeFilter.insert(source.addr, destination.addr);
         } else {
             node_manager_logger.error("Error while adding the new edge/relation for source = " +
                                       std::string(source.id) + " destination = " + std::string(destination.id));
@@ -229,9 +385,9 @@ RelationBlock *NodeManager::addCentralRelation(NodeBlock source, NodeBlock desti
 
 NodeBlock *NodeManager::addNode(std::string nodeId) {
     unsigned int assignedNodeIndex;
-    node_manager_logger.debug("Adding node index " + std::to_string(this->nextNodeIndex));
+    JG_LOG_DEBUG(node_manager_logger, "Adding node index {}", this->nextNodeIndex);
     if (this->nodeIndex.find(nodeId) == this->nodeIndex.end()) {
-        node_manager_logger.debug("Can't find NodeId (" + nodeId + ") in the index database");
+        JG_LOG_DEBUG(node_manager_logger, "Can't find NodeId ({}) in the index database", nodeId);
         unsigned int vertexId = std::stoul(nodeId);
         NodeBlock *sourceBlk = new NodeBlock(nodeId, vertexId, this->nextNodeIndex * NodeBlock::BLOCK_SIZE);
         this->addNodeIndex(nodeId, this->nextNodeIndex);
@@ -241,12 +397,13 @@ NodeBlock *NodeManager::addNode(std::string nodeId) {
         sourceBlk->save();
         return sourceBlk;
     }
-    node_manager_logger.debug("NodeId found in index for node ID " + nodeId);
+    JG_LOG_DEBUG(node_manager_logger, "NodeId found in index for node ID {}", nodeId);
     return this->get(nodeId);
 }
 
 RelationBlock *NodeManager::addLocalEdge(std::pair<std::string, std::string> edge) {
     pthread_mutex_lock(&lockEdgeAdd);
+    logEdge(false, edge);
 
     NodeBlock *sourceNode = this->addNode(edge.first);
     NodeBlock *destNode = this->addNode(edge.second);
@@ -257,8 +414,8 @@ RelationBlock *NodeManager::addLocalEdge(std::pair<std::string, std::string> edg
     }
     pthread_mutex_unlock(&lockEdgeAdd);
 
-    node_manager_logger.debug("DEBUG: Source DB block address " + std::to_string(sourceNode->addr) +
-                              " Destination DB block address " + std::to_string(destNode->addr));
+    JG_LOG_DEBUG(node_manager_logger, "Source DB block address {} Destination DB block address {}", sourceNode->addr,
+                 destNode->addr);
     return newRelation;
 }
 
@@ -267,6 +424,7 @@ RelationBlock *NodeManager::addCentralEdge(std::pair<std::string, std::string> e
     //
     //    guard1.lock();
     pthread_mutex_lock(&lockEdgeAdd);
+    logEdge(true, edge);
 
     NodeBlock *sourceNode = this->addNode(edge.first);
     NodeBlock *destNode = this->addNode(edge.second);
@@ -278,8 +436,8 @@ RelationBlock *NodeManager::addCentralEdge(std::pair<std::string, std::string> e
     pthread_mutex_unlock(&lockEdgeAdd);
 
     //    guard1.unlock();
-    node_manager_logger.debug("DEBUG: Source DB block address " + std::to_string(sourceNode->addr) +
-                              " Destination DB block address " + std::to_string(destNode->addr));
+    JG_LOG_DEBUG(node_manager_logger, "Source DB block address {} Destination DB block address {}", sourceNode->addr,
+                 destNode->addr);
     return newRelation;
 }
 
@@ -293,8 +451,8 @@ void NodeManager::addNodeIndex(std::string nodeId, unsigned int nodeIndex) {
         index_db.write(nodeIDC, sizeof(nodeIDC));
         index_db.write(reinterpret_cast<char *>(&nodeIndex), sizeof(unsigned int));
         index_db.flush();
-        node_manager_logger.debug("Writing node index --> Node key = " +
-                                  std::string(nodeIDC) + ", value = " + std::to_string(nodeIndex));
+        JG_LOG_DEBUG(node_manager_logger, "Writing node index --> Node key = {}, value = {}",
+                     static_cast<const char *>(nodeIDC), nodeIndex);
     } else {
         node_manager_logger.error("Failed to open index database file.");
     }
@@ -377,15 +535,14 @@ NodeBlock *NodeManager::get(std::string nodeId) {
         node_manager_logger.error("Error while reading label data from block " + std::to_string(blockAddress));
     }
     bool usage = usageBlock == '\1';
-    node_manager_logger.debug("Label = " + std::string(label));
-    node_manager_logger.debug("Length of label = " + std::to_string(strlen(label)));
-    node_manager_logger.debug("DEBUG: raw edgeRef from DB (disk) " + std::to_string(edgeRef));
+    JG_LOG_DEBUG(node_manager_logger, "Label = {}, length of label = {}", label, strlen(label));
+    JG_LOG_DEBUG(node_manager_logger, "Raw edgeRef from DB (disk) {}", edgeRef);
 
     nodeBlockPointer =
         new NodeBlock(nodeId, vertexId, blockAddress, propRef, edgeRef, centralEdgeRef, edgeRefPID, label, usage);
 
-    node_manager_logger.debug("DEBUG: nodeBlockPointer after creating the object edgeRef " +
-                              std::to_string(nodeBlockPointer->edgeRef));
+    JG_LOG_DEBUG(node_manager_logger, "nodeBlockPointer after creating the object edgeRef {}",
+                 nodeBlockPointer->edgeRef);
 
     if (nodeBlockPointer->edgeRef % RelationBlock::BLOCK_SIZE != 0) {
         node_manager_logger.error("Exception: Invalid edge reference address = " + nodeBlockPointer->edgeRef);
@@ -408,8 +565,8 @@ void NodeManager::persistNodeIndex() {
             index_db.write(nodeIDC, sizeof(nodeIDC));
             unsigned int nodeBlockIndex = nodeMap.second;
             index_db.write(reinterpret_cast<char *>(&(nodeBlockIndex)), sizeof(unsigned int));
-            node_manager_logger.debug("Writing node index --> Node key = " + std::string(nodeIDC) + " value " +
-                                      std::to_string(nodeBlockIndex));
+            JG_LOG_DEBUG(node_manager_logger, "Writing node index --> Node key = {} value {}",
+                         static_cast<const char *>(nodeIDC), nodeBlockIndex);
         }
     }
     index_db.close();
@@ -443,8 +600,7 @@ std::list<NodeBlock*> NodeManager::getGraph() {
         auto nodeId = it.first;
         NodeBlock *node = this->get(nodeId);
         vertices.push_back(node);
-        node_manager_logger.debug("Read node index for node  " + nodeId + " with node index " +
-                                  std::to_string(it.second));
+        JG_LOG_DEBUG(node_manager_logger, "Read node index for node {} with node index {}", nodeId, it.second);
     }
     return vertices;
 }
@@ -460,8 +616,7 @@ std::list<NodeBlock*> NodeManager::getCentralGraph() {
         if (node->getCentralRelationHead()) {
             vertices.push_back(node);
         }
-        node_manager_logger.debug("Read node index for central node " + nodeId + " with node index " +
-                                  std::to_string(it.second));
+        JG_LOG_DEBUG(node_manager_logger, "Read node index for central node {} with node index {}", nodeId, it.second);
     }
     return vertices;
 }
@@ -530,10 +685,20 @@ std::map<long, long> NodeManager::getDistributionMap() {
  *
  * **/
 void NodeManager::close() {
-    this->persistNodeIndex();
-    if (PropertyLink::propertiesDB) {
-        PropertyLink::propertiesDB->flush();
-        PropertyLink::propertiesDB->close();
+    // The node index is rewritten after the checkpoint, which has its entries already
+    checkpoint();
+    if (!readOnly) {
+        this->persistNodeIndex();
+    }
+    if (PropertyStore::nodeProperties) {
+        PropertyStore::nodeProperties->close();
+        delete PropertyStore::nodeProperties;
+        PropertyStore::nodeProperties = NULL;
+    }
+    if (PropertyStore::edgeProperties) {
+        PropertyStore::edgeProperties->close();
+        delete PropertyStore::edgeProperties;
+        PropertyStore::edgeProperties = NULL;
     }
     if (NodeBlock::nodesDB) {
         NodeBlock::nodesDB->flush();
@@ -547,6 +712,20 @@ void NodeManager::close() {
         RelationBlock::centralRelationsDB->flush();
         RelationBlock::centralRelationsDB->close();
     }
+    if (!readOnly) {
+        persistEdgeFilter(localEdgeFilter, dbPrefix + "_relations.db");
+        persistEdgeFilter(centralEdgeFilter, dbPrefix + "_central_relations.db");
+    }
+    if (writeAheadLog) {
+        if (WriteAheadLog::storeLog == writeAheadLog) {
+            WriteAheadLog::storeLog = NULL;
+        }
+        delete writeAheadLog;
+        writeAheadLog = NULL;
+    }
+    if (partitionLock) {
+        partitionLock->unlock();
+    }
 }
 
 /**
@@ -576,4 +755,54 @@ std::string NodeManager::getDbPrefix() {
     return dbPrefix;
 }
 
+EdgeFilter &NodeManager::getEdgeFilter(bool isLocal) {
+    return isLocal ? localEdgeFilter : centralEdgeFilter;
+}
+
+void NodeManager::indexRecords(const std::string &recordsDBPath, unsigned int first, unsigned long recordSize,
+                               unsigned long referenceOffset, uint64_t entityFlag, PropertyStore *store,
+                               const std::string &name, PropertyIndex *index) {
+    // Read through a stream of its own up to the end of the file, since the record files and the record counters
+    // of the store are thread local to the thread that opened it
+    std::ifstream recordsDB(recordsDBPath, std::ios::binary);
+    std::string value;
+    for (unsigned int record = first;; record++) {
+        unsigned int reference = 0;
+        recordsDB.seekg(record * recordSize + referenceOffset);
+        if (!recordsDB.read(reinterpret_cast<char *>(&reference), sizeof(reference))) {
+            break;
+        }
+        if (reference != 0 && store->get(reference, name, value)) {
+            index->add(value, entityFlag | (record * recordSize));
+        }
+    }
+}
+
+bool NodeManager::createPropertyIndex(bool relations, const std::string &name, PropertyIndex::Type type) {
+    pthread_mutex_lock(&lockEdgeAdd);
+    PropertyIndex *index = (relations ? edgeProperties : nodeProperties)->createIndex(name, type);
+    if (index && relations) {
+        unsigned long referenceOffset = static_cast<int>(RelationOffsets::RELATION_PROPS) * RelationBlock::RECORD_SIZE;
+        indexRecords(dbPrefix + "_relations.db", 1, RelationBlock::BLOCK_SIZE, referenceOffset, 0, edgeProperties,
+                     name, index);
+        indexRecords(dbPrefix + "_central_relations.db", 1, RelationBlock::BLOCK_SIZE, referenceOffset,
+                     PropertyIndex::CENTRAL_RELATION, edgeProperties, name, index);
+    } else if (index) {
+        // The property reference follows usage, nodeId, edgeRef, centralEdgeRef and edgeRefPID
+        unsigned long referenceOffset = sizeof(char) + 3 * sizeof(unsigned int) + sizeof(unsigned char);
+        indexRecords(dbPrefix + "_nodes.db", 0, NodeBlock::BLOCK_SIZE, referenceOffset, 0, nodeProperties, name,
+                     index);
+    }
+    pthread_mutex_unlock(&lockEdgeAdd);
+    if (index) {
+        node_manager_logger.info("Indexed " + std::to_string(index->size()) + " values of the " +
+                                 (relations ? "relation" : "node") + " property " + name + " of " + dbPrefix);
+    }
+    return index != NULL;
+}
+
+PropertyIndex *NodeManager::getPropertyIndex(bool relations, const std::string &name) {
+    return (relations ? edgeProperties : nodeProperties)->getIndex(name);
+}
+
 const std::string NodeManager::FILE_MODE = "app";  // for appending to existing DB
@@ -12,11 +12,16 @@ limitations under the License.
 **/
 
 #include <fstream>
+#include <map>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
+#include "EdgeFilter.h"
 #include "NodeBlock.h"
+#include "StoreCompactor.h"
+#include "WriteAheadLog.h"
 
 #ifndef NODE_MANAGER
 #define NODE_MANAGER
@@ -26,6 +31,14 @@ struct GraphConfig {
     unsigned int graphID = 0;
     unsigned int partitionID = 0;
     std::string openMode;
+    // Records logged between two checkpoints of the write-ahead log, 0 to not log and -1 to take
+    // org.jasminegraph.nativestore.wal.checkpoint.records
+    long checkpointRecords = -1;
+    // Opened by a query to read the store. Takes no write-ahead log lock, does not recover or checkpoint the store
+    // and writes nothing back on close.
+    bool readOnly = false;
+    // The caller holds the partition lock exclusive, as a compaction does, so the node manager does not take it
+    bool partitionLocked = false;
 };
 
 class NodeManager {
@@ -39,16 +52,32 @@ class NodeManager {
     unsigned long INDEX_KEY_SIZE = 6;  // Size of an index key entry in bytes
     std::string indexDBPath;
     std::unordered_map<std::string, unsigned int> nodeIndex;
+    EdgeFilter localEdgeFilter;
+    EdgeFilter centralEdgeFilter;
+    PropertyStore *nodeProperties;
+    PropertyStore *edgeProperties;
+    std::fstream *nodesDB;
+    std::fstream *relationsDB;
+    std::fstream *centralRelationsDB;
+    WriteAheadLog *writeAheadLog = NULL;
+    StoreCompactor::PartitionLock *partitionLock = NULL;
+    unsigned long checkpointRecords = 0;
+    bool readOnly = false;
 
     void persistNodeIndex();
+    void loadEdgeFilter(EdgeFilter &edgeFilter, std::string relationsDBPath);
+    void persistEdgeFilter(EdgeFilter &edgeFilter, std::string relationsDBPath);
     std::unordered_map<std::string, unsigned int> readNodeIndex();
     void addNodeIndex(std::string nodeId, unsigned int nodeIndex);
+    void replay(const std::vector<WriteAheadLog::Record> &records);
+    void logEdge(bool central, const std::pair<std::string, std::string> &edge);
+    void indexRecords(const std::string &recordsDBPath, unsigned int first, unsigned long recordSize,
+                      unsigned long referenceOffset, uint64_t entityFlag, PropertyStore *store,
+                      const std::string &name, PropertyIndex *index);
 
  public:
-    static unsigned int nextPropertyIndex;  // Next available property block index
-
     NodeManager(GraphConfig);
-    ~NodeManager() { delete NodeBlock::nodesDB; };
+    ~NodeManager();
 
     void setIndexKeySize(unsigned long);
     static int dbSize(std::string path);
@@ -57,6 +86,9 @@ class NodeManager {
     std::string getDbPrefix();
     void close();
 
+    // Sync the store to the disk and empty the write-ahead log, if the store logs
+    void checkpoint();
+
     RelationBlock* addLocalEdge(std::pair<std::string, std::string>);
     RelationBlock* addCentralEdge(std::pair<std::string, std::string> edge);
 
@@ -73,6 +105,15 @@ class NodeManager {
     std::map<long, std::unordered_set<long>> getAdjacencyList();
     std::map<long, std::unordered_set<long>> getAdjacencyList(bool isLocal);
     std::map<long, long> getDistributionMap();
+    EdgeFilter &getEdgeFilter(bool isLocal);
+
+    // Index the values of a node or relation property, including the values stored before. Returns false when the
+    // property is already indexed.
+    bool createPropertyIndex(bool relations, const std::string &name, PropertyIndex::Type type);
+
+    // NULL when the property is not indexed. Relation indexes hold local relation addresses and central relation
+    // addresses flagged with PropertyIndex::CENTRAL_RELATION.
+    PropertyIndex *getPropertyIndex(bool relations, const std::string &name);
 };
 
 #endif
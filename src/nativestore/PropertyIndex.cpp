@@ -0,0 +1,229 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "PropertyIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "../util/logger/Logger.h"
+
+Logger property_index_logger;
+
+const uint32_t PropertyIndex::MAGIC = 0x4950474a;  // "JGPI"
+const uint32_t PropertyIndex::VERSION = 1;
+const uint64_t PropertyIndex::CENTRAL_RELATION = 1ULL << 32;
+
+static bool parseNumber(const std::string &value, double &number) {
+    if (value.empty()) {
+        return false;
+    }
+    char *end;
+    number = strtod(value.c_str(), &end);
+    return *end == '\0' && std::isfinite(number);
+}
+
+bool PropertyIndex::ValueLess::operator()(const std::string &a, const std::string &b) const {
+    double x;
+    double y;
+    bool aNumber = parseNumber(a, x);
+    bool bNumber = parseNumber(b, y);
+    if (aNumber != bNumber) {
+        return aNumber;
+    }
+    // Equal numbers written differently ("1" and "1.0") stay separate values next to each other
+    if (aNumber && x != y) {
+        return x < y;
+    }
+    return a < b;
+}
+
+PropertyIndex::PropertyIndex(const std::string &path, Type type) : path(path), type(type) {}
+
+PropertyIndex::~PropertyIndex() { close(); }
+
+PropertyIndex::Type PropertyIndex::parseType(const std::string &name, bool &valid) {
+    valid = name == "hash" || name == "ordered";
+    return name == "ordered" ? ORDERED : HASH;
+}
+
+std::vector<uint64_t> *PropertyIndex::getPostings(const std::string &value, bool create) {
+    if (type == HASH) {
+        auto postings = hashPostings.find(value);
+        if (postings != hashPostings.end()) {
+            return &postings->second;
+        }
+        return create ? &hashPostings[value] : NULL;
+    }
+    auto postings = orderedPostings.find(value);
+    if (postings != orderedPostings.end()) {
+        return &postings->second;
+    }
+    return create ? &orderedPostings[value] : NULL;
+}
+
+void PropertyIndex::apply(bool added, const std::string &value, uint64_t entity) {
+    if (added) {
+        getPostings(value, true)->push_back(entity);
+        postingCount++;
+        return;
+    }
+    std::vector<uint64_t> *postings = getPostings(value, false);
+    if (!postings) {
+        return;
+    }
+    auto posting = std::find(postings->begin(), postings->end(), entity);
+    if (posting == postings->end()) {
+        return;
+    }
+    *posting = postings->back();
+    postings->pop_back();
+    postingCount--;
+    removedCount++;
+    if (postings->empty()) {
+        if (type == HASH) {
+            hashPostings.erase(value);
+        } else {
+            orderedPostings.erase(value);
+        }
+    }
+}
+
+void PropertyIndex::writeHeader() {
+    uint32_t header[3] = {MAGIC, VERSION, static_cast<uint32_t>(type)};
+    log.write(reinterpret_cast<char *>(header), sizeof(header));
+}
+
+// Record layout: added (1 byte), entity (8 bytes), value length (2 bytes), value
+void PropertyIndex::append(bool added, const std::string &value, uint64_t entity) {
+    uint8_t operation = added ? 1 : 0;
+    uint16_t length = std::min<size_t>(value.size(), UINT16_MAX);
+    log.write(reinterpret_cast<char *>(&operation), sizeof(operation));
+    log.write(reinterpret_cast<char *>(&entity), sizeof(entity));
+    log.write(reinterpret_cast<char *>(&length), sizeof(length));
+    log.write(value.data(), length);
+}
+
+bool PropertyIndex::open(bool truncate) {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    hashPostings.clear();
+    orderedPostings.clear();
+    postingCount = 0;
+    removedCount = 0;
+
+    std::ifstream input(path, std::ios::binary);
+    if (!truncate && input.is_open()) {
+        uint32_t header[3] = {0};
+        if (!input.read(reinterpret_cast<char *>(header), sizeof(header)) || header[0] != MAGIC ||
+            header[1] != VERSION || header[2] != static_cast<uint32_t>(type)) {
+            property_index_logger.error("Invalid property index " + path);
+            return false;
+        }
+        uint8_t operation;
+        uint64_t entity;
+        uint16_t length;
+        std::string value;
+        while (input.read(reinterpret_cast<char *>(&operation), sizeof(operation)) &&
+               input.read(reinterpret_cast<char *>(&entity), sizeof(entity)) &&
+               input.read(reinterpret_cast<char *>(&length), sizeof(length))) {
+            value.resize(length);
+            if (!input.read(&value[0], length)) {
+                break;
+            }
+            apply(operation == 1, value, entity);
+        }
+        input.close();
+        log.open(path, std::ios::binary | std::ios::app);
+    } else {
+        input.close();
+        log.open(path, std::ios::binary | std::ios::trunc);
+        writeHeader();
+        log.flush();
+    }
+    return log.is_open();
+}
+
+void PropertyIndex::close() {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    if (!log.is_open()) {
+        return;
+    }
+    log.close();
+    if (removedCount == 0) {
+        return;
+    }
+    // Drop the removed postings and the postings they cancelled
+    log.open(path, std::ios::binary | std::ios::trunc);
+    writeHeader();
+    if (type == HASH) {
+        for (auto &postings : hashPostings) {
+            for (uint64_t entity : postings.second) {
+                append(true, postings.first, entity);
+            }
+        }
+    } else {
+        for (auto &postings : orderedPostings) {
+            for (uint64_t entity : postings.second) {
+                append(true, postings.first, entity);
+            }
+        }
+    }
+    log.close();
+    removedCount = 0;
+}
+
+void PropertyIndex::add(const std::string &value, uint64_t entity) {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    apply(true, value, entity);
+    append(true, value, entity);
+    log.flush();
+}
+
+void PropertyIndex::remove(const std::string &value, uint64_t entity) {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    apply(false, value, entity);
+    append(false, value, entity);
+    log.flush();
+}
+
+std::vector<uint64_t> PropertyIndex::lookup(const std::string &value) {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    std::vector<uint64_t> *postings = getPostings(value, false);
+    return postings ? *postings : std::vector<uint64_t>();
+}
+
+std::vector<uint64_t> PropertyIndex::range(const std::string &from, const std::string &to) {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    std::vector<uint64_t> entities;
+    if (type != ORDERED) {
+        property_index_logger.warn("Range lookup on the hash index " + path);
+        return entities;
+    }
+    ValueLess less;
+    auto it = from.empty() ? orderedPostings.begin() : orderedPostings.lower_bound(from);
+    for (; it != orderedPostings.end() && (to.empty() || !less(to, it->first)); it++) {
+        entities.insert(entities.end(), it->second.begin(), it->second.end());
+    }
+    return entities;
+}
+
+size_t PropertyIndex::size() {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    return postingCount;
+}
+
+void PropertyIndex::flush() {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    log.flush();
+}
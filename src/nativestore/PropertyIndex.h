@@ -0,0 +1,94 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_PROPERTYINDEX_H
+#define JASMINEGRAPH_PROPERTYINDEX_H
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Secondary index of the values of one node or relation property of a partition, mapping a value to the entities
+ * that have it. Entities are node or local relation block addresses, and central relation block addresses with
+ * CENTRAL_RELATION set. A hash index answers equality lookups, an ordered index also answers ranges, comparing
+ * numbers by value before other strings.
+ *
+ * The postings are kept in memory and every change is appended to the index file, which is replayed when the index
+ * is opened and rewritten without the removed postings when it is closed.
+ */
+class PropertyIndex {
+ public:
+    enum Type { HASH = 0, ORDERED = 1 };
+
+    static const uint32_t MAGIC;
+    static const uint32_t VERSION;
+    static const uint64_t CENTRAL_RELATION;
+
+    // Numbers by value, then other strings byte by byte
+    struct ValueLess {
+        bool operator()(const std::string &a, const std::string &b) const;
+    };
+
+    PropertyIndex(const std::string &path, Type type);
+
+    ~PropertyIndex();
+
+    bool open(bool truncate);
+
+    void close();
+
+    Type getType() const { return type; }
+
+    std::string getPath() const { return path; }
+
+    void add(const std::string &value, uint64_t entity);
+
+    void remove(const std::string &value, uint64_t entity);
+
+    std::vector<uint64_t> lookup(const std::string &value);
+
+    // Entities with values between from and to, both included. An empty bound leaves that end open. Hash indexes
+    // can not answer ranges and return nothing.
+    std::vector<uint64_t> range(const std::string &from, const std::string &to);
+
+    size_t size();
+
+    void flush();
+
+    static Type parseType(const std::string &name, bool &valid);
+
+ private:
+    std::string path;
+    Type type;
+    std::mutex indexMutex;
+    std::ofstream log;
+    std::unordered_map<std::string, std::vector<uint64_t>> hashPostings;
+    std::map<std::string, std::vector<uint64_t>, ValueLess> orderedPostings;
+    size_t postingCount = 0;
+    size_t removedCount = 0;
+
+    std::vector<uint64_t> *getPostings(const std::string &value, bool create);
+
+    void apply(bool added, const std::string &value, uint64_t entity);
+
+    void append(bool added, const std::string &value, uint64_t entity);
+
+    void writeHeader();
+};
+
+#endif  // JASMINEGRAPH_PROPERTYINDEX_H
@@ -0,0 +1,493 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "PropertyStore.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "../util/Utils.h"
+#include "../util/logger/Logger.h"
+#include "NodeBlock.h"
+#include "RelationBlock.h"
+#include "WriteAheadLog.h"
+
+Logger property_store_logger;
+
+const uint32_t PropertyStore::INLINE_FLAG = 0x80000000;
+const size_t PropertyStore::MIN_RUN_SIZE = 32;
+const int PropertyStore::SIZE_CLASS_COUNT = 16;
+const size_t PropertyStore::MAX_VALUE_SIZE = UINT16_MAX;
+const uint64_t PropertyStore::NO_ENTITY = UINT64_MAX;
+thread_local PropertyStore *PropertyStore::nodeProperties = NULL;
+thread_local PropertyStore *PropertyStore::edgeProperties = NULL;
+
+static const uint32_t RUNS_MAGIC = 0x5350474a;  // "JGPS"
+static const uint32_t RUNS_VERSION = 1;
+static const uint32_t SLOT_MASK = 0x07ffffff;
+static const int SIZE_CLASS_SHIFT = 27;
+static const int INLINE_KEY_SHIFT = 24;
+static const int INLINE_KEY_LIMIT = 1 << 7;
+static const size_t INLINE_VALUE_SIZE = 3;
+
+// Layout of the linked property blocks of the previous format
+static const size_t LEGACY_NAME_SIZE = 12;
+static const size_t LEGACY_VALUE_SIZE = 180;
+static const size_t LEGACY_BLOCK_SIZE = LEGACY_NAME_SIZE + LEGACY_VALUE_SIZE + sizeof(uint32_t);
+static const size_t NODE_PROPERTY_OFFSET = 14;  // usage, nodeId, edgeRef, centralEdgeRef and edgeRefPID come first
+
+static size_t getRunSize(int sizeClass) { return PropertyStore::MIN_RUN_SIZE << sizeClass; }
+
+static bool openStoreFile(std::fstream &file, const std::string &path, bool truncate) {
+    std::ios_base::openmode mode = std::ios::in | std::ios::out | std::ios::binary;
+    if (truncate || !Utils::fileExists(path)) {
+        mode |= std::ios::trunc;
+    }
+    file.open(path, mode);
+    return file.is_open();
+}
+
+bool PropertyStore::open(const std::string &path, bool truncate) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    this->path = path;
+    keyIds.clear();
+    keys.clear();
+    indexes.clear();
+    freeRuns.assign(SIZE_CLASS_COUNT, std::vector<uint32_t>());
+    if (!openStoreFile(keysFile, path + ".keys.db", truncate) ||
+        !openStoreFile(runsFile, path + ".runs.db", truncate)) {
+        property_store_logger.error("Could not open the property store " + path);
+        return false;
+    }
+
+    uint16_t length;
+    std::string name;
+    while (keysFile.read(reinterpret_cast<char *>(&length), sizeof(length))) {
+        name.resize(length);
+        if (!keysFile.read(&name[0], length)) {
+            break;
+        }
+        keyIds[name] = keys.size();
+        keys.push_back(name);
+    }
+    keysFile.clear();
+
+    // The header takes the first slot, so that no run has the reference 0
+    runsFile.seekg(0, std::ios::end);
+    uint64_t fileSize = runsFile.tellg();
+    if (fileSize == 0) {
+        uint32_t header[MIN_RUN_SIZE / sizeof(uint32_t)] = {RUNS_MAGIC, RUNS_VERSION};
+        runsFile.seekp(0);
+        runsFile.write(reinterpret_cast<char *>(header), sizeof(header));
+        runsFile.flush();
+        fileSize = sizeof(header);
+    } else {
+        uint32_t header[2] = {0};
+        runsFile.seekg(0);
+        if (!runsFile.read(reinterpret_cast<char *>(header), sizeof(header)) || header[0] != RUNS_MAGIC ||
+            header[1] != RUNS_VERSION) {
+            property_store_logger.error("Invalid property store " + path + ".runs.db");
+            return false;
+        }
+    }
+    runsEnd = (fileSize + MIN_RUN_SIZE - 1) / MIN_RUN_SIZE * MIN_RUN_SIZE;
+
+    // Index definitions outlive a truncation, their postings do not
+    std::ifstream definitions(path + ".indexes.db");
+    std::string typeName;
+    while (definitions >> typeName && std::getline(definitions >> std::ws, name)) {
+        bool valid;
+        PropertyIndex::Type type = PropertyIndex::parseType(typeName, valid);
+        if (valid && !openIndex(name, type, truncate)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+PropertyIndex *PropertyStore::openIndex(const std::string &name, PropertyIndex::Type type, bool truncate) {
+    int keyId = getKeyId(name);
+    if (keyId < 0) {
+        return NULL;
+    }
+    PropertyIndex *index = new PropertyIndex(path + ".index" + std::to_string(keyId) + ".db", type);
+    indexes[keyId].reset(index);
+    if (!index->open(truncate)) {
+        indexes.erase(keyId);
+        return NULL;
+    }
+    return index;
+}
+
+PropertyIndex *PropertyStore::createIndex(const std::string &name, PropertyIndex::Type type) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    auto keyId = keyIds.find(name);
+    if ((keyId != keyIds.end() && indexes.count(keyId->second) > 0) || name.empty() ||
+        name.find('\n') != std::string::npos) {
+        return NULL;
+    }
+    PropertyIndex *index = openIndex(name, type, true);
+    if (index) {
+        std::ofstream definitions(path + ".indexes.db", std::ios::app);
+        definitions << (type == PropertyIndex::ORDERED ? "ordered" : "hash") << " " << name << "\n";
+    }
+    return index;
+}
+
+PropertyIndex *PropertyStore::getIndex(const std::string &name) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    auto keyId = keyIds.find(name);
+    if (keyId == keyIds.end()) {
+        return NULL;
+    }
+    auto index = indexes.find(keyId->second);
+    return index == indexes.end() ? NULL : index->second.get();
+}
+
+void PropertyStore::flush() {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    keysFile.flush();
+    runsFile.flush();
+    for (auto &index : indexes) {
+        index.second->flush();
+    }
+}
+
+void PropertyStore::getFiles(std::map<std::string, std::fstream *> &files) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    files[path + ".keys.db"] = NULL;
+    files[path + ".runs.db"] = &runsFile;
+    files[path + ".indexes.db"] = NULL;
+    for (auto &index : indexes) {
+        files[index.second->getPath()] = NULL;
+    }
+}
+
+void PropertyStore::close() {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    indexes.clear();
+    if (keysFile.is_open()) {
+        keysFile.close();
+    }
+    if (runsFile.is_open()) {
+        runsFile.close();
+    }
+}
+
+int PropertyStore::getKeyId(const std::string &name) {
+    auto keyId = keyIds.find(name);
+    if (keyId != keyIds.end()) {
+        return keyId->second;
+    }
+    if (keys.size() > UINT16_MAX || name.size() > UINT16_MAX) {
+        property_store_logger.error("Too many property names to add " + name);
+        return -1;
+    }
+    uint16_t length = name.size();
+    keysFile.clear();
+    keysFile.seekp(0, std::ios::end);
+    keysFile.write(reinterpret_cast<char *>(&length), sizeof(length));
+    keysFile.write(name.data(), length);
+    keysFile.flush();
+    keyIds[name] = keys.size();
+    keys.push_back(name);
+    return keys.size() - 1;
+}
+
+bool PropertyStore::readRun(uint32_t reference, std::vector<std::pair<uint16_t, std::string>> &properties) {
+    properties.clear();
+    if (reference == 0) {
+        return true;
+    }
+    if (reference & INLINE_FLAG) {
+        std::string value;
+        for (size_t i = 0; i < INLINE_VALUE_SIZE && ((reference >> (8 * i)) & 0xff) != 0; i++) {
+            value.push_back(static_cast<char>((reference >> (8 * i)) & 0xff));
+        }
+        properties.push_back(std::make_pair((reference & ~INLINE_FLAG) >> INLINE_KEY_SHIFT, value));
+        return true;
+    }
+
+    size_t runSize = getRunSize(reference >> SIZE_CLASS_SHIFT);
+    std::vector<char> run(runSize);
+    runsFile.clear();
+    runsFile.seekg(static_cast<uint64_t>(reference & SLOT_MASK) * MIN_RUN_SIZE);
+    if (!runsFile.read(run.data(), runSize)) {
+        property_store_logger.error("Error while reading the property run " + std::to_string(reference));
+        return false;
+    }
+    uint16_t count;
+    memcpy(&count, run.data(), sizeof(count));
+    size_t position = sizeof(count);
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t keyId;
+        uint16_t length;
+        if (position + sizeof(keyId) + sizeof(length) > runSize) {
+            return false;
+        }
+        memcpy(&keyId, run.data() + position, sizeof(keyId));
+        memcpy(&length, run.data() + position + sizeof(keyId), sizeof(length));
+        position += sizeof(keyId) + sizeof(length);
+        if (position + length > runSize || keyId >= keys.size()) {
+            property_store_logger.error("Corrupted property run " + std::to_string(reference));
+            return false;
+        }
+        properties.push_back(std::make_pair(keyId, std::string(run.data() + position, length)));
+        position += length;
+    }
+    return true;
+}
+
+void PropertyStore::releaseRun(uint32_t reference) {
+    if (reference != 0 && !(reference & INLINE_FLAG)) {
+        freeRuns[reference >> SIZE_CLASS_SHIFT].push_back(reference & SLOT_MASK);
+    }
+}
+
+void PropertyStore::updateIndex(uint16_t keyId, const std::string *oldValue, const std::string &value,
+                                uint64_t entity) {
+    auto index = entity == NO_ENTITY ? indexes.end() : indexes.find(keyId);
+    if (index == indexes.end()) {
+        return;
+    }
+    if (oldValue) {
+        index->second->remove(*oldValue, entity);
+    }
+    index->second->add(value, entity);
+}
+
+uint32_t PropertyStore::put(uint32_t reference, const std::string &name, const std::string &value,
+                            uint64_t entity) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    int keyId = getKeyId(name);
+    if (keyId < 0 || value.size() > MAX_VALUE_SIZE) {
+        property_store_logger.error("Property " + name + " is too large to store");
+        return reference;
+    }
+    std::vector<std::pair<uint16_t, std::string>> properties;
+    if (!readRun(reference, properties)) {
+        return reference;
+    }
+    bool found = false;
+    std::string oldValue;
+    for (auto &property : properties) {
+        if (property.first == keyId) {
+            oldValue.swap(property.second);
+            property.second = value;
+            found = true;
+        }
+    }
+    if (!found) {
+        properties.push_back(std::make_pair(keyId, value));
+    }
+
+    if (properties.size() == 1 && keyId < INLINE_KEY_LIMIT &&
+        value.size() <= INLINE_VALUE_SIZE && value.find('\0') == std::string::npos) {
+        uint32_t inlined = INLINE_FLAG | (static_cast<uint32_t>(keyId) << INLINE_KEY_SHIFT);
+        for (size_t i = 0; i < value.size(); i++) {
+            inlined |= static_cast<uint32_t>(static_cast<unsigned char>(value[i])) << (8 * i);
+        }
+        releaseRun(reference);
+        updateIndex(keyId, found ? &oldValue : NULL, value, entity);
+        return inlined;
+    }
+
+    std::string run;
+    uint16_t count = properties.size();
+    run.append(reinterpret_cast<char *>(&count), sizeof(count));
+    for (auto &property : properties) {
+        uint16_t length = property.second.size();
+        run.append(reinterpret_cast<char *>(&property.first), sizeof(property.first));
+        run.append(reinterpret_cast<char *>(&length), sizeof(length));
+        run.append(property.second);
+    }
+    int sizeClass = 0;
+    while (sizeClass < SIZE_CLASS_COUNT && getRunSize(sizeClass) < run.size()) {
+        sizeClass++;
+    }
+    if (sizeClass == SIZE_CLASS_COUNT) {
+        property_store_logger.error("The properties of an entity do not fit a run after adding " + name);
+        return reference;
+    }
+    run.resize(getRunSize(sizeClass), '\0');
+
+    // A run that still fits its size class is rewritten in place
+    uint32_t slot;
+    bool inPlace = reference != 0 && !(reference & INLINE_FLAG) &&
+                   static_cast<int>(reference >> SIZE_CLASS_SHIFT) == sizeClass;
+    if (inPlace) {
+        slot = reference & SLOT_MASK;
+    } else if (!freeRuns[sizeClass].empty()) {
+        slot = freeRuns[sizeClass].back();
+        freeRuns[sizeClass].pop_back();
+    } else {
+        if (runsEnd / MIN_RUN_SIZE > SLOT_MASK) {
+            property_store_logger.error("The property store is full");
+            return reference;
+        }
+        slot = runsEnd / MIN_RUN_SIZE;
+        runsEnd += run.size();
+    }
+    if (WriteAheadLog::storeLog) {
+        WriteAheadLog::storeLog->saveBeforeImage(&runsFile, static_cast<uint64_t>(slot) * MIN_RUN_SIZE, run.size());
+    }
+    runsFile.clear();
+    runsFile.seekp(static_cast<uint64_t>(slot) * MIN_RUN_SIZE);
+    if (!runsFile.write(run.data(), run.size())) {
+        property_store_logger.error("Error while writing the property " + name);
+        return reference;
+    }
+    runsFile.flush();
+    if (!inPlace) {
+        releaseRun(reference);
+    }
+    updateIndex(keyId, found ? &oldValue : NULL, value, entity);
+    return (static_cast<uint32_t>(sizeClass) << SIZE_CLASS_SHIFT) | slot;
+}
+
+std::map<std::string, std::string> PropertyStore::getAll(uint32_t reference) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    std::map<std::string, std::string> allProperties;
+    std::vector<std::pair<uint16_t, std::string>> properties;
+    readRun(reference, properties);
+    for (auto &property : properties) {
+        if (property.first < keys.size()) {
+            allProperties[keys[property.first]] = property.second;
+        }
+    }
+    return allProperties;
+}
+
+bool PropertyStore::get(uint32_t reference, const std::string &name, std::string &value) {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    auto keyId = keyIds.find(name);
+    if (keyId == keyIds.end()) {
+        return false;
+    }
+    std::vector<std::pair<uint16_t, std::string>> properties;
+    readRun(reference, properties);
+    for (auto &property : properties) {
+        if (property.first == keyId->second) {
+            value = property.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t PropertyStore::getKeyCount() {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    return keys.size();
+}
+
+uint64_t PropertyStore::getSizeInBytes() {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    uint64_t bytes = runsEnd;
+    for (auto &key : keys) {
+        bytes += sizeof(uint16_t) + key.size();
+    }
+    return bytes;
+}
+
+// Follow a chain of legacy property blocks. The blocks point to each other by their byte offsets.
+static std::vector<std::pair<std::string, std::string>> readLegacyChain(std::ifstream &legacyFile,
+                                                                         uint64_t fileSize, uint32_t address) {
+    std::vector<std::pair<std::string, std::string>> properties;
+    char block[LEGACY_BLOCK_SIZE];
+    for (uint64_t blocks = 0; address != 0 && address % LEGACY_BLOCK_SIZE == 0 &&
+                              address + LEGACY_BLOCK_SIZE <= fileSize && blocks * LEGACY_BLOCK_SIZE < fileSize;
+         blocks++) {
+        legacyFile.clear();
+        legacyFile.seekg(address);
+        if (!legacyFile.read(block, LEGACY_BLOCK_SIZE)) {
+            break;
+        }
+        properties.push_back(std::make_pair(std::string(block, strnlen(block, LEGACY_NAME_SIZE)),
+                                            std::string(block + LEGACY_NAME_SIZE,
+                                                        strnlen(block + LEGACY_NAME_SIZE, LEGACY_VALUE_SIZE))));
+        memcpy(&address, block + LEGACY_NAME_SIZE + LEGACY_VALUE_SIZE, sizeof(address));
+    }
+    return properties;
+}
+
+// Copy the legacy properties of every record of a node or relation file to the store and update the references
+static bool migrateRecords(const std::string &recordsPath, size_t recordSize, size_t referenceOffset,
+                           const std::string &legacyPath, PropertyStore &store, long &migrated) {
+    std::fstream records(recordsPath, std::ios::in | std::ios::out | std::ios::binary);
+    if (!records.is_open()) {
+        return true;
+    }
+    std::ifstream legacyFile(legacyPath, std::ios::binary);
+    legacyFile.seekg(0, std::ios::end);
+    uint64_t legacySize = legacyFile.is_open() ? static_cast<uint64_t>(legacyFile.tellg()) : 0;
+    records.seekg(0, std::ios::end);
+    uint64_t recordCount = static_cast<uint64_t>(records.tellg()) / recordSize;
+
+    std::vector<uint32_t> references(recordCount, 0);
+    for (uint64_t record = 0; record < recordCount; record++) {
+        records.seekg(record * recordSize + referenceOffset);
+        if (!records.read(reinterpret_cast<char *>(&references[record]), sizeof(uint32_t))) {
+            return false;
+        }
+    }
+    // The new references are written once all the properties are in the store
+    for (uint64_t record = 0; record < recordCount; record++) {
+        if (references[record] == 0) {
+            continue;
+        }
+        uint32_t reference = 0;
+        for (auto &property : readLegacyChain(legacyFile, legacySize, references[record])) {
+            reference = store.put(reference, property.first, property.second);
+            migrated++;
+        }
+        references[record] = reference;
+        records.seekp(record * recordSize + referenceOffset);
+        records.write(reinterpret_cast<char *>(&reference), sizeof(reference));
+    }
+    records.flush();
+    return static_cast<bool>(records);
+}
+
+bool PropertyStore::migrate(const std::string &dbPrefix) {
+    std::string legacyNodePath = dbPrefix + "_properties.db";
+    std::string legacyEdgePath = dbPrefix + "_edge_properties.db";
+    PropertyStore nodeStore;
+    PropertyStore edgeStore;
+    if (!nodeStore.open(dbPrefix + "_properties", true) || !edgeStore.open(dbPrefix + "_edge_properties", true)) {
+        return false;
+    }
+
+    long migrated = 0;
+    size_t relationPropertyOffset = static_cast<int>(RelationOffsets::RELATION_PROPS) * RelationBlock::RECORD_SIZE;
+    bool success =
+        migrateRecords(dbPrefix + "_nodes.db", NodeBlock::BLOCK_SIZE, NODE_PROPERTY_OFFSET, legacyNodePath,
+                       nodeStore, migrated) &&
+        migrateRecords(dbPrefix + "_relations.db", RelationBlock::BLOCK_SIZE, relationPropertyOffset,
+                       legacyEdgePath, edgeStore, migrated) &&
+        migrateRecords(dbPrefix + "_central_relations.db", RelationBlock::BLOCK_SIZE, relationPropertyOffset,
+                       legacyEdgePath, edgeStore, migrated);
+    nodeStore.close();
+    edgeStore.close();
+    if (!success) {
+        property_store_logger.error("Could not migrate the properties of " + dbPrefix);
+        return false;
+    }
+
+    for (auto &legacyPath : {legacyNodePath, legacyEdgePath}) {
+        if (Utils::fileExists(legacyPath)) {
+            std::rename(legacyPath.c_str(), (legacyPath + ".legacy").c_str());
+        }
+    }
+    property_store_logger.info("Migrated " + std::to_string(migrated) + " properties of " + dbPrefix);
+    return true;
+}
@@ -0,0 +1,112 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_PROPERTYSTORE_H
+#define JASMINEGRAPH_PROPERTYSTORE_H
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "PropertyIndex.h"
+
+/**
+ * Properties of the nodes or the relations of a partition. Property names are interned in a key dictionary
+ * (<path>.keys.db) and the properties of an entity are kept together in one run of <path>.runs.db:
+ *
+ *     count (2 bytes), then per property: key id (2 bytes), value length (2 bytes), value
+ *
+ * Runs are allocated from slabs of size classes of 32 << c bytes, so a run grows in place until it fills its class
+ * and then moves to the next class, leaving its slot for the next run of that class. The 32 bit reference kept in
+ * the node or relation record holds the size class and the position of the run, so all properties are read with
+ * a single read. An entity with a single property of up to 3 bytes keeps it in the reference itself.
+ *
+ * Properties listed in <path>.indexes.db are indexed by value, and the indexes are updated by the puts that name
+ * the entity.
+ */
+class PropertyStore {
+ public:
+    static const uint32_t INLINE_FLAG;
+    static const size_t MIN_RUN_SIZE;
+    static const int SIZE_CLASS_COUNT;
+    static const size_t MAX_VALUE_SIZE;
+    static const uint64_t NO_ENTITY;
+
+    // Stores of the partition opened by the node manager of the current thread
+    static thread_local PropertyStore *nodeProperties;
+    static thread_local PropertyStore *edgeProperties;
+
+    bool open(const std::string &path, bool truncate);
+
+    void close();
+
+    // Set a property of the entity with the given reference (0 when it has none) and return the new reference,
+    // which changes when the run moves to another size class
+    uint32_t put(uint32_t reference, const std::string &name, const std::string &value,
+                 uint64_t entity = NO_ENTITY);
+
+    std::map<std::string, std::string> getAll(uint32_t reference);
+
+    bool get(uint32_t reference, const std::string &name, std::string &value);
+
+    size_t getKeyCount();
+
+    uint64_t getSizeInBytes();
+
+    // Start indexing a property. The new index is empty, the caller adds the values the entities already have.
+    // Returns NULL when the property is already indexed.
+    PropertyIndex *createIndex(const std::string &name, PropertyIndex::Type type);
+
+    // NULL when the property is not indexed
+    PropertyIndex *getIndex(const std::string &name);
+
+    void flush();
+
+    // Add the files of the store to a checkpoint, with the stream of the runs that are rewritten in place
+    void getFiles(std::map<std::string, std::fstream *> &files);
+
+    /**
+     * Move the properties of a partition from the linked 196 byte blocks of <prefix>_properties.db and
+     * <prefix>_edge_properties.db to property stores, rewriting the references in the node and relation records.
+     * The old files are kept as <file>.legacy.
+     */
+    static bool migrate(const std::string &dbPrefix);
+
+ private:
+    std::mutex storeMutex;
+    std::string path;
+    std::fstream keysFile;
+    std::fstream runsFile;
+    std::unordered_map<std::string, uint16_t> keyIds;
+    std::vector<std::string> keys;
+    uint64_t runsEnd = 0;
+    std::vector<std::vector<uint32_t>> freeRuns;  // Released runs of each size class
+    std::map<uint16_t, std::unique_ptr<PropertyIndex>> indexes;
+
+    int getKeyId(const std::string &name);
+
+    bool readRun(uint32_t reference, std::vector<std::pair<uint16_t, std::string>> &properties);
+
+    void releaseRun(uint32_t reference);
+
+    void updateIndex(uint16_t keyId, const std::string *oldValue, const std::string &value, uint64_t entity);
+
+    PropertyIndex *openIndex(const std::string &name, PropertyIndex::Type type, bool truncate);
+};
+
+#endif  // JASMINEGRAPH_PROPERTYSTORE_H
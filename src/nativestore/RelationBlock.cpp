@@ -18,6 +18,7 @@ limitations under the License.
 
 #include "../util/logger/Logger.h"
 #include "NodeManager.h"
+#include "WriteAheadLog.h"
 
 Logger relation_block_logger;
 pthread_mutex_t lockAddProperty;
@@ -585,6 +586,9 @@ bool RelationBlock::setCentralPreviousDestination(unsigned int newAddress) {
 bool RelationBlock::updateLocalRelationRecords(RelationOffsets recordOffset, unsigned int data) {
     int offsetValue = static_cast<int>(recordOffset);
     int dataOffset = RECORD_SIZE * offsetValue;
+    if (WriteAheadLog::storeLog) {
+        WriteAheadLog::storeLog->saveBeforeImage(RelationBlock::relationsDB, this->addr + dataOffset, RECORD_SIZE);
+    }
     RelationBlock::relationsDB->seekg(this->addr + dataOffset);
     if (!RelationBlock::relationsDB->write(reinterpret_cast<char*>(&data), RECORD_SIZE)) {
         relation_block_logger.error("Error while updating relation data record offset " + std::to_string(offsetValue) +
@@ -598,6 +602,10 @@ bool RelationBlock::updateLocalRelationRecords(RelationOffsets recordOffset, uns
 bool RelationBlock::updateCentralRelationRecords(RelationOffsets recordOffset, unsigned int data) {
     int offsetValue = static_cast<int>(recordOffset);
     int dataOffset = RECORD_SIZE * offsetValue;
+    if (WriteAheadLog::storeLog) {
+        WriteAheadLog::storeLog->saveBeforeImage(RelationBlock::centralRelationsDB, this->addr + dataOffset,
+                                                 RECORD_SIZE);
+    }
     RelationBlock::centralRelationsDB->seekg(this->addr + dataOffset);
     if (!RelationBlock::centralRelationsDB->write(reinterpret_cast<char*>(&data), RECORD_SIZE)) {
         relation_block_logger.error("Error while updating relation data record offset " + std::to_string(offsetValue) +
@@ -615,52 +623,32 @@ thread_local unsigned int RelationBlock::nextCentralRelationIndex =
     1;  // Starting with 1 because of the 0 and '\0' differentiation issue
 
 
-void RelationBlock::addLocalProperty(std::string name, char* value) {
-    if (this->propertyAddress == 0) {
-        PropertyEdgeLink* newLink = PropertyEdgeLink::create(name, value);
-        if (newLink) {
-            this->propertyAddress = newLink->blockAddress;
-            // If it was an empty prop link before inserting, Then update the property reference of this node
-            // block
-            this->updateLocalRelationRecords(RelationOffsets::RELATION_PROPS, this->propertyAddress);
-        } else {
-            relation_block_logger.error("Error occurred while adding a new property link to " +
-                    std::to_string(this->addr) + " node block");
-        }
-    } else {
-        this->propertyAddress = this->getPropertyHead()->insert(name, value);
+void RelationBlock::addLocalProperty(const std::string &name, const std::string &value) {
+    if (WriteAheadLog::storeLog && this->sourceBlock && this->destinationBlock) {
+        WriteAheadLog::storeLog->logEdgeProperty(false, this->sourceBlock->id, this->destinationBlock->id, name, value);
     }
-}
-void RelationBlock::addCentralProperty(std::string name, char* value) {
-    if (this->propertyAddress == 0) {
-        PropertyEdgeLink* newLink = PropertyEdgeLink::create(name, value);
-        if (newLink) {
-            this->propertyAddress = newLink->blockAddress;
-            // If it was an empty prop link before inserting, Then update the property reference of this node
-            // block
-            this->updateCentralRelationRecords(RelationOffsets::RELATION_PROPS, this->propertyAddress);
-        } else {
-            relation_block_logger.error("Error occurred while adding a new property link to " +
-                    std::to_string(this->addr) + " node block");
-        }
-    } else {
-        this->propertyAddress = this->getPropertyHead()->insert(name, value);
+    unsigned int newAddress = PropertyStore::edgeProperties->put(this->propertyAddress, name, value, this->addr);
+    if (newAddress != this->propertyAddress) {
+        // The reference changes when the properties of the relation move to a larger run
+        this->propertyAddress = newAddress;
+        this->updateLocalRelationRecords(RelationOffsets::RELATION_PROPS, this->propertyAddress);
     }
 }
 
-PropertyEdgeLink* RelationBlock::getPropertyHead() { return PropertyEdgeLink::get(this->propertyAddress); }
-
-std::map<std::string, char*> RelationBlock::getAllProperties() {
-    std::map<std::string, char*> allProperties;
-    PropertyEdgeLink* current = this->getPropertyHead();
-    while (current) {
-        allProperties.insert({current->name, current->value});
-        PropertyEdgeLink* temp = current->next();
-        delete current;  // To prevent memory leaks
-        current = temp;
+void RelationBlock::addCentralProperty(const std::string &name, const std::string &value) {
+    if (WriteAheadLog::storeLog && this->sourceBlock && this->destinationBlock) {
+        WriteAheadLog::storeLog->logEdgeProperty(true, this->sourceBlock->id, this->destinationBlock->id, name, value);
+    }
+    unsigned int newAddress = PropertyStore::edgeProperties->put(this->propertyAddress, name, value,
+                                                                  PropertyIndex::CENTRAL_RELATION | this->addr);
+    if (newAddress != this->propertyAddress) {
+        this->propertyAddress = newAddress;
+        this->updateCentralRelationRecords(RelationOffsets::RELATION_PROPS, this->propertyAddress);
     }
-    delete current;
-    return allProperties;
+}
+
+std::map<std::string, std::string> RelationBlock::getAllProperties() {
+    return PropertyStore::edgeProperties->getAll(this->propertyAddress);
 }
 
 /**
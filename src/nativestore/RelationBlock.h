@@ -17,7 +17,7 @@ limitations under the License.
 #include <string>
 
 #include "NodeBlock.h"
-#include "PropertyEdgeLink.h"
+#include "PropertyStore.h"
 
 #ifndef RELATION_BLOCK
 #define RELATION_BLOCK
@@ -80,7 +80,6 @@ class RelationBlock {
     NodeRelation source;
     NodeRelation destination;
     unsigned int propertyAddress = 0;
-    PropertyEdgeLink *propertyHead = NULL;
     static thread_local unsigned int nextLocalRelationIndex;
     static thread_local unsigned int nextCentralRelationIndex;
     static thread_local const unsigned long BLOCK_SIZE;  // Size of a relation record block in bytes
@@ -129,11 +128,10 @@ class RelationBlock {
     static RelationBlock *getLocalRelation(unsigned int);
     static RelationBlock *getCentralRelation(unsigned int address);
 
-    void addLocalProperty(std::string, char *);
-    void addCentralProperty(std::string name, char *value);
+    void addLocalProperty(const std::string &name, const std::string &value);
+    void addCentralProperty(const std::string &name, const std::string &value);
 
-    PropertyEdgeLink *getPropertyHead();
-    std::map<std::string, char *> getAllProperties();
+    std::map<std::string, std::string> getAllProperties();
 };
 
 #endif
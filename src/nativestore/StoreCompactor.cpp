@@ -0,0 +1,439 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "StoreCompactor.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "../util/Utils.h"
+#include "../util/logger/Logger.h"
+#include "NodeBlock.h"
+#include "PropertyIndex.h"
+#include "PropertyStore.h"
+#include "RelationBlock.h"
+#include "WriteAheadLog.h"
+
+Logger store_compactor_logger;
+
+// Offsets in a node block, after usage (1 byte) and nodeId (4 bytes)
+static const size_t NODE_EDGE_REF_OFFSET = 5;
+static const size_t NODE_CENTRAL_EDGE_REF_OFFSET = 9;
+static const size_t NODE_PROPERTY_OFFSET = 14;
+
+static const char *STORE_FILES[] = {"_nodes.db",           "_nodes.index.db",          "_relations.db",
+                                    "_central_relations.db", "_properties.keys.db",      "_properties.runs.db",
+                                    "_edge_properties.keys.db", "_edge_properties.runs.db"};
+
+static uint32_t getWord(const std::string &data, size_t offset) {
+    uint32_t value;
+    memcpy(&value, data.data() + offset, sizeof(value));
+    return value;
+}
+
+static void setWord(std::string &data, size_t offset, uint32_t value) { memcpy(&data[offset], &value, sizeof(value)); }
+
+static size_t fieldOffset(uint32_t relation, RelationOffsets field) {
+    return relation * RelationBlock::BLOCK_SIZE + static_cast<int>(field) * RelationBlock::RECORD_SIZE;
+}
+
+static uint64_t getFileSize(const std::string &path) {
+    struct stat fileStat;
+    return stat(path.c_str(), &fileStat) == 0 ? fileStat.st_size : 0;
+}
+
+static bool readFile(const std::string &path, std::string &data) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream contents;
+    if (file.is_open()) {
+        contents << file.rdbuf();
+    }
+    data = contents.str();
+    return file.is_open();
+}
+
+static bool writeFile(const std::string &path, const std::string &data) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), data.size());
+    file.close();
+    return static_cast<bool>(file);
+}
+
+static void syncPath(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        ::close(fd);
+    }
+}
+
+static std::string getDirectory(const std::string &dbPrefix) {
+    size_t separator = dbPrefix.find_last_of('/');
+    return separator == std::string::npos ? "." : dbPrefix.substr(0, separator);
+}
+
+static uint64_t getStoreSize(const std::string &dbPrefix) {
+    uint64_t size = 0;
+    for (auto suffix : STORE_FILES) {
+        size += getFileSize(dbPrefix + suffix);
+    }
+    return size;
+}
+
+bool StoreCompactor::PartitionLock::lock(const std::string &dbPrefix, bool exclusive) {
+    unlock();
+    lockFd = ::open((dbPrefix + "_partition.lock").c_str(), O_RDWR | O_CREAT, 0644);
+    if (lockFd >= 0 && flock(lockFd, exclusive ? LOCK_EX | LOCK_NB : LOCK_SH) != 0) {
+        ::close(lockFd);
+        lockFd = -1;
+    }
+    return lockFd >= 0;
+}
+
+StoreCompactor::PartitionLock::~PartitionLock() { unlock(); }
+
+void StoreCompactor::PartitionLock::unlock() {
+    if (lockFd >= 0) {
+        ::close(lockFd);
+        lockFd = -1;
+    }
+}
+
+std::string StoreCompactor::Stats::toString() const {
+    std::ostringstream result;
+    result << "nodes " << nodes << " (" << droppedNodes << " dropped), relations " << relations << " ("
+           << droppedRelations << " dropped), central relations " << centralRelations << " ("
+           << droppedCentralRelations << " dropped), bytes " << bytesBefore << " -> " << bytesAfter
+           << ", traversal " << traversalBefore << " -> " << traversalAfter << " us/relation";
+    return result.str();
+}
+
+// Complete or discard the compaction of a partition whose write-ahead log lock is held
+static void finishCompaction(const std::string &dbPrefix) {
+    std::string directory = getDirectory(dbPrefix);
+    std::string base = dbPrefix.substr(dbPrefix.find_last_of('/') + 1);
+    std::string temporaryStart = base + "_compact_";
+    std::string commitPath = dbPrefix + "_compact.commit";
+    bool committed = Utils::fileExists(commitPath);
+    bool found = false;
+    for (auto &file : Utils::getListOfFilesInDirectory(directory)) {
+        if (file.compare(0, temporaryStart.size(), temporaryStart) != 0) {
+            continue;
+        }
+        found = true;
+        std::string path = directory + "/" + file;
+        if (!committed) {
+            std::remove(path.c_str());
+        } else if (std::rename(path.c_str(), (dbPrefix + "_" + file.substr(temporaryStart.size())).c_str()) != 0) {
+            store_compactor_logger.error("Could not replace the store file of " + path);
+            return;
+        }
+    }
+    if (!committed) {
+        if (found) {
+            store_compactor_logger.info("Removed the files of an unfinished compaction of " + dbPrefix);
+        }
+        return;
+    }
+    // The write-ahead log has the sizes of the old files, and the edge filters their node addresses
+    std::remove((dbPrefix + "_wal.db").c_str());
+    std::remove((dbPrefix + "_relations.filter.db").c_str());
+    std::remove((dbPrefix + "_central_relations.filter.db").c_str());
+    syncPath(directory);
+    std::remove(commitPath.c_str());
+}
+
+/**
+ * Rewrite one relation file. The relations are taken from the chain of their source, following the nodes in their
+ * new order, which puts the relations of a source next to each other. The chain of every node is then linked again
+ * through the new addresses, and the head of the chain is set in the new node blocks at headOffset.
+ */
+static std::string compactRelations(const std::string &relations, const std::string &nodes, std::string &newNodes,
+                                    const std::vector<uint32_t> &keptNodes, const std::vector<int64_t> &newNodeIndex,
+                                    size_t headOffset, PropertyStore &properties, PropertyStore &newProperties,
+                                    uint64_t entityFlag, uint64_t &kept, uint64_t &dropped) {
+    const unsigned long blockSize = RelationBlock::BLOCK_SIZE;
+    uint32_t count = relations.size() / blockSize;
+    std::vector<uint32_t> newIndex(count, 0);
+    std::vector<uint32_t> order(1, 0);  // Relations start at index 1
+    for (uint32_t node : keptNodes) {
+        uint32_t address = node * NodeBlock::BLOCK_SIZE;
+        uint32_t reference = getWord(nodes, address + headOffset);
+        for (uint32_t steps = 0; reference != 0 && reference % blockSize == 0 && reference / blockSize < count &&
+                                 steps < count;
+             steps++) {
+            uint32_t relation = reference / blockSize;
+            uint32_t source = getWord(relations, fieldOffset(relation, RelationOffsets::SOURCE));
+            uint32_t destination = getWord(relations, fieldOffset(relation, RelationOffsets::DESTINATION));
+            if (source == address) {
+                uint64_t destinationNode = destination / NodeBlock::BLOCK_SIZE;
+                if (newIndex[relation] == 0 && destination % NodeBlock::BLOCK_SIZE == 0 &&
+                    destinationNode < newNodeIndex.size() && newNodeIndex[destinationNode] >= 0) {
+                    newIndex[relation] = order.size();
+                    order.push_back(relation);
+                }
+                reference = getWord(relations, fieldOffset(relation, RelationOffsets::SOURCE_NEXT));
+            } else if (destination == address) {
+                reference = getWord(relations, fieldOffset(relation, RelationOffsets::DESTINATION_NEXT));
+            } else {
+                store_compactor_logger.warn("Relation " + std::to_string(reference) + " in the chain of node " +
+                                            std::to_string(address) + " does not have the node");
+                break;
+            }
+        }
+    }
+    kept = order.size() - 1;
+    dropped = count > 0 ? count - 1 - kept : 0;
+    if (count == 0) {
+        return "";
+    }
+
+    std::string result(order.size() * blockSize, '\0');
+    memcpy(&result[0], relations.data(), blockSize);
+    std::vector<std::vector<uint32_t>> chains(keptNodes.size());
+    for (uint32_t relation = 1; relation < order.size(); relation++) {
+        memcpy(&result[relation * blockSize], relations.data() + order[relation] * blockSize, blockSize);
+        for (auto field : {RelationOffsets::SOURCE, RelationOffsets::DESTINATION}) {
+            uint32_t node = getWord(result, fieldOffset(relation, field)) / NodeBlock::BLOCK_SIZE;
+            setWord(result, fieldOffset(relation, field), newNodeIndex[node] * NodeBlock::BLOCK_SIZE);
+        }
+        for (auto field : {RelationOffsets::SOURCE_NEXT, RelationOffsets::SOURCE_PREVIOUS,
+                           RelationOffsets::DESTINATION_NEXT, RelationOffsets::DESTINATION_PREVIOUS}) {
+            setWord(result, fieldOffset(relation, field), 0);
+        }
+        chains[getWord(result, fieldOffset(relation, RelationOffsets::SOURCE)) / NodeBlock::BLOCK_SIZE].push_back(
+            relation);
+
+        uint32_t reference = getWord(result, fieldOffset(relation, RelationOffsets::RELATION_PROPS));
+        uint32_t newReference = 0;
+        if (reference != 0) {
+            for (auto &property : properties.getAll(reference)) {
+                newReference = newProperties.put(newReference, property.first, property.second,
+                                                 entityFlag | (relation * blockSize));
+            }
+        }
+        setWord(result, fieldOffset(relation, RelationOffsets::RELATION_PROPS), newReference);
+    }
+    // A chain lists the relations of the node as a source, which are contiguous, before the ones to the node
+    for (uint32_t relation = 1; relation < order.size(); relation++) {
+        uint32_t source = getWord(result, fieldOffset(relation, RelationOffsets::SOURCE));
+        uint32_t destination = getWord(result, fieldOffset(relation, RelationOffsets::DESTINATION));
+        if (destination != source) {
+            chains[destination / NodeBlock::BLOCK_SIZE].push_back(relation);
+        }
+    }
+
+    for (size_t node = 0; node < chains.size(); node++) {
+        const std::vector<uint32_t> &chain = chains[node];
+        uint32_t address = node * NodeBlock::BLOCK_SIZE;
+        setWord(newNodes, address + headOffset, chain.empty() ? 0 : chain[0] * blockSize);
+        for (size_t i = 0; i < chain.size(); i++) {
+            bool isSource = getWord(result, fieldOffset(chain[i], RelationOffsets::SOURCE)) == address;
+            if (i + 1 < chain.size()) {
+                setWord(result,
+                        fieldOffset(chain[i], isSource ? RelationOffsets::SOURCE_NEXT
+                                                       : RelationOffsets::DESTINATION_NEXT),
+                        chain[i + 1] * blockSize);
+            }
+            if (i > 0) {
+                setWord(result,
+                        fieldOffset(chain[i], isSource ? RelationOffsets::SOURCE_PREVIOUS
+                                                       : RelationOffsets::DESTINATION_PREVIOUS),
+                        chain[i - 1] * blockSize);
+            }
+        }
+    }
+    return result;
+}
+
+bool StoreCompactor::compact(const std::string &dbPrefix, unsigned long indexKeySize, Stats &stats,
+                             bool partitionLocked) {
+    stats = Stats();
+    if (Utils::fileExists(dbPrefix + "_properties.db") || Utils::fileExists(dbPrefix + "_edge_properties.db")) {
+        store_compactor_logger.error("The properties of " + dbPrefix + " are not migrated to property stores yet");
+        return false;
+    }
+    PartitionLock partitionLock;
+    WriteAheadLog log(dbPrefix);
+    std::vector<WriteAheadLog::Record> records;
+    if ((!partitionLocked && !partitionLock.lock(dbPrefix, true)) || !log.lock()) {
+        store_compactor_logger.error("Not compacting " + dbPrefix + " since it is open");
+        return false;
+    }
+    if (!log.recover(records) || !records.empty()) {
+        store_compactor_logger.error("Not compacting " + dbPrefix + " since its write-ahead log has records to redo");
+        return false;
+    }
+    finishCompaction(dbPrefix);
+    stats.bytesBefore = getStoreSize(dbPrefix);
+    stats.traversalBefore = measureTraversal(dbPrefix);
+
+    std::string nodes;
+    std::string index;
+    std::string relations;
+    std::string centralRelations;
+    readFile(dbPrefix + "_nodes.db", nodes);
+    readFile(dbPrefix + "_nodes.index.db", index);
+    readFile(dbPrefix + "_relations.db", relations);
+    readFile(dbPrefix + "_central_relations.db", centralRelations);
+
+    // Nodes that are in use and in the node index keep their order
+    uint32_t nodeCount = nodes.size() / NodeBlock::BLOCK_SIZE;
+    std::vector<std::string> keys(nodeCount);
+    unsigned long entrySize = indexKeySize + sizeof(uint32_t);
+    for (size_t entry = 0; entry + entrySize <= index.size(); entry += entrySize) {
+        uint32_t node = getWord(index, entry + indexKeySize);
+        if (node < nodeCount && nodes[node * NodeBlock::BLOCK_SIZE] != 0 && keys[node].empty()) {
+            keys[node] = index.substr(entry, indexKeySize);
+        }
+    }
+    std::vector<uint32_t> keptNodes;
+    std::vector<int64_t> newNodeIndex(nodeCount, -1);
+    for (uint32_t node = 0; node < nodeCount; node++) {
+        if (!keys[node].empty()) {
+            newNodeIndex[node] = keptNodes.size();
+            keptNodes.push_back(node);
+        }
+    }
+    stats.nodes = keptNodes.size();
+    stats.droppedNodes = nodeCount - keptNodes.size();
+
+    // The property names keep their ids, so the new property indexes replace the old ones file by file
+    std::string compactPrefix = dbPrefix + "_compact";
+    for (auto store : {"_properties", "_edge_properties"}) {
+        for (auto suffix : {".keys.db", ".indexes.db"}) {
+            std::string data;
+            if (readFile(dbPrefix + store + suffix, data)) {
+                writeFile(compactPrefix + store + suffix, data);
+            }
+        }
+    }
+    PropertyStore nodeProperties;
+    PropertyStore edgeProperties;
+    PropertyStore newNodeProperties;
+    PropertyStore newEdgeProperties;
+    if (!nodeProperties.open(dbPrefix + "_properties", false) ||
+        !edgeProperties.open(dbPrefix + "_edge_properties", false) ||
+        !newNodeProperties.open(compactPrefix + "_properties", false) ||
+        !newEdgeProperties.open(compactPrefix + "_edge_properties", false)) {
+        store_compactor_logger.error("Could not open the property stores of " + dbPrefix);
+        finishCompaction(dbPrefix);
+        return false;
+    }
+
+    std::string newNodes(keptNodes.size() * NodeBlock::BLOCK_SIZE, '\0');
+    std::string newIndex;
+    for (size_t node = 0; node < keptNodes.size(); node++) {
+        uint32_t address = node * NodeBlock::BLOCK_SIZE;
+        memcpy(&newNodes[address], nodes.data() + keptNodes[node] * NodeBlock::BLOCK_SIZE, NodeBlock::BLOCK_SIZE);
+        uint32_t reference = getWord(newNodes, address + NODE_PROPERTY_OFFSET);
+        uint32_t newReference = 0;
+        if (reference != 0) {
+            for (auto &property : nodeProperties.getAll(reference)) {
+                newReference = newNodeProperties.put(newReference, property.first, property.second, address);
+            }
+        }
+        setWord(newNodes, address + NODE_PROPERTY_OFFSET, newReference);
+        newIndex += keys[keptNodes[node]];
+        newIndex.append(reinterpret_cast<const char *>(&node), sizeof(uint32_t));
+    }
+    std::string newRelations =
+        compactRelations(relations, nodes, newNodes, keptNodes, newNodeIndex, NODE_EDGE_REF_OFFSET, edgeProperties,
+                         newEdgeProperties, 0, stats.relations, stats.droppedRelations);
+    std::string newCentralRelations = compactRelations(
+        centralRelations, nodes, newNodes, keptNodes, newNodeIndex, NODE_CENTRAL_EDGE_REF_OFFSET, edgeProperties,
+        newEdgeProperties, PropertyIndex::CENTRAL_RELATION, stats.centralRelations, stats.droppedCentralRelations);
+    nodeProperties.close();
+    edgeProperties.close();
+    newNodeProperties.close();
+    newEdgeProperties.close();
+
+    if (!writeFile(compactPrefix + "_nodes.db", newNodes) || !writeFile(compactPrefix + "_nodes.index.db", newIndex) ||
+        !writeFile(compactPrefix + "_relations.db", newRelations) ||
+        !writeFile(compactPrefix + "_central_relations.db", newCentralRelations)) {
+        store_compactor_logger.error("Could not write the compacted files of " + dbPrefix);
+        finishCompaction(dbPrefix);
+        return false;
+    }
+
+    // The old files are replaced only once all the new ones are on the disk
+    std::string directory = getDirectory(dbPrefix);
+    std::string temporaryStart = compactPrefix.substr(directory.size() + 1) + "_";
+    for (auto &file : Utils::getListOfFilesInDirectory(directory)) {
+        if (file.compare(0, temporaryStart.size(), temporaryStart) == 0) {
+            syncPath(directory + "/" + file);
+        }
+    }
+    if (!writeFile(dbPrefix + "_compact.commit", "")) {
+        store_compactor_logger.error("Could not commit the compaction of " + dbPrefix);
+        finishCompaction(dbPrefix);
+        return false;
+    }
+    syncPath(dbPrefix + "_compact.commit");
+    syncPath(directory);
+    finishCompaction(dbPrefix);
+
+    stats.bytesAfter = getStoreSize(dbPrefix);
+    stats.traversalAfter = measureTraversal(dbPrefix);
+    store_compactor_logger.info("Compacted " + dbPrefix + ": " + stats.toString());
+    return true;
+}
+
+void StoreCompactor::finish(const std::string &dbPrefix) {
+    // A compaction that is still running holds the lock of the partition
+    WriteAheadLog log(dbPrefix);
+    if (log.lock()) {
+        finishCompaction(dbPrefix);
+    }
+}
+
+double StoreCompactor::measureTraversal(const std::string &dbPrefix) {
+    std::string nodes;
+    readFile(dbPrefix + "_nodes.db", nodes);
+    std::ifstream relations(dbPrefix + "_relations.db", std::ios::binary);
+    uint64_t count = getFileSize(dbPrefix + "_relations.db") / RelationBlock::BLOCK_SIZE;
+    uint32_t block[RelationBlock::BLOCK_SIZE / sizeof(uint32_t)];
+    uint64_t hops = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t address = 0; address + NodeBlock::BLOCK_SIZE <= nodes.size(); address += NodeBlock::BLOCK_SIZE) {
+        uint32_t reference = getWord(nodes, address + NODE_EDGE_REF_OFFSET);
+        // Blocks are read one at a time, as RelationBlock::getLocalRelation reads them
+        for (uint64_t steps = 0; reference != 0 && steps < count; steps++) {
+            relations.seekg(reference);
+            if (!relations.read(reinterpret_cast<char *>(block), sizeof(block))) {
+                relations.clear();
+                break;
+            }
+            hops++;
+            if (block[static_cast<int>(RelationOffsets::SOURCE)] == address) {
+                reference = block[static_cast<int>(RelationOffsets::SOURCE_NEXT)];
+            } else if (block[static_cast<int>(RelationOffsets::DESTINATION)] == address) {
+                reference = block[static_cast<int>(RelationOffsets::DESTINATION_NEXT)];
+            } else {
+                break;
+            }
+        }
+    }
+    double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return hops == 0 ? 0 : elapsed / hops;
+}
@@ -0,0 +1,96 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_STORECOMPACTOR_H
+#define JASMINEGRAPH_STORECOMPACTOR_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Offline compaction of the native store of a partition. The node, relation and property files only ever grow:
+ * relations are written in arrival order, so the relations of a vertex are scattered over the relation files, and
+ * the runs left behind by properties that moved to a larger size class are only reused while the store is open.
+ *
+ * Compaction rewrites the files of a closed partition so that the relations of each vertex are contiguous (grouped
+ * by source, in node order) and each relation chain lists the relations of the vertex as a source before the ones
+ * it has as a destination. Node blocks that are not in use or not in the node index, and relations no longer
+ * reachable from their source, are dropped. Properties are copied to fresh stores in the same order, and the
+ * property indexes are rebuilt for the new addresses.
+ *
+ * The new files are written next to the old ones as <prefix>_compact_*. They replace the old files only once they
+ * are all on the disk and <prefix>_compact.commit is written, and finish() completes or discards an interrupted
+ * compaction when the partition is opened again.
+ */
+class StoreCompactor {
+ public:
+    struct Stats {
+        uint64_t nodes = 0;
+        uint64_t droppedNodes = 0;
+        uint64_t relations = 0;
+        uint64_t droppedRelations = 0;
+        uint64_t centralRelations = 0;
+        uint64_t droppedCentralRelations = 0;
+        uint64_t bytesBefore = 0;  // Of the node, index, relation and property files
+        uint64_t bytesAfter = 0;
+        double traversalBefore = 0;  // Microseconds per relation when following the relation chains of every node
+        double traversalAfter = 0;
+
+        std::string toString() const;
+    };
+
+    /**
+     * Lock on <prefix>_partition.lock. Every node manager holds it shared while the partition is open, and a
+     * compaction holds it exclusive, so the files of an open partition are never rewritten. A shared lock waits
+     * for a running compaction to end, an exclusive lock fails at once if the partition is open.
+     */
+    class PartitionLock {
+     public:
+        PartitionLock() {}
+
+        PartitionLock(const std::string &dbPrefix, bool exclusive) { lock(dbPrefix, exclusive); }
+
+        PartitionLock(const PartitionLock &) = delete;
+
+        PartitionLock &operator=(const PartitionLock &) = delete;
+
+        ~PartitionLock();
+
+        bool lock(const std::string &dbPrefix, bool exclusive);
+
+        bool isLocked() const { return lockFd >= 0; }
+
+        void unlock();
+
+     private:
+        int lockFd = -1;
+    };
+
+    /**
+     * Compact the partition with the given prefix, which must not be open: the partition lock is taken exclusive
+     * for the duration, unless the caller holds it already (partitionLocked), and the compaction fails if the
+     * write-ahead log has records to redo. indexKeySize is the key size of the node index
+     * (org.jasminegraph.nativestore.max.label.size).
+     */
+    static bool compact(const std::string &dbPrefix, unsigned long indexKeySize, Stats &stats,
+                        bool partitionLocked = false);
+
+    // Complete a compaction that was committed before a crash, or remove the files of one that was not. Nothing is
+    // done while another thread or process holds the lock of the partition.
+    static void finish(const std::string &dbPrefix);
+
+    // Average time to read a relation block while following the local relation chain of every node
+    static double measureTraversal(const std::string &dbPrefix);
+};
+
+#endif  // JASMINEGRAPH_STORECOMPACTOR_H
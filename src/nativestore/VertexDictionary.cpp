@@ -0,0 +1,373 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "VertexDictionary.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <functional>
+
+#include "../util/Utils.h"
+#include "../util/logger/Logger.h"
+
+Logger vertex_dictionary_logger;
+
+const uint32_t VertexDictionary::MAGIC = 0x4456474a;  // "JGVD"
+const uint32_t VertexDictionary::VERSION = 1;
+const int VertexDictionary::DEFAULT_SHARD_COUNT = 16;
+const uint64_t VertexDictionary::NOT_FOUND = UINT64_MAX;
+const size_t VertexDictionaryCache::DEFAULT_SIZE = 1 << 14;
+
+static const size_t INITIAL_SLOT_COUNT = 1024;
+static const uint32_t HEADER_WORDS = 4;
+
+class VertexDictionary::Shard {
+ public:
+    std::mutex mutex;
+
+    Shard(int index, int shardCount) : index(index), shardCount(shardCount), slots(INITIAL_SLOT_COUNT, 0) {}
+
+    uint32_t size() const { return offsets.size() - 1; }
+
+    // The local id of the external id, or false with the slot where it would be inserted
+    bool find(const std::string &externalId, size_t hash, uint32_t &localId, size_t &slot) const {
+        uint64_t tag = static_cast<uint64_t>(hash >> 32) << 32;
+        size_t mask = slots.size() - 1;
+        for (slot = hash & mask; slots[slot] != 0; slot = (slot + 1) & mask) {
+            if ((slots[slot] & 0xffffffff00000000ULL) != tag) {
+                continue;
+            }
+            uint32_t candidate = static_cast<uint32_t>(slots[slot]) - 1;
+            uint64_t length = offsets[candidate + 1] - offsets[candidate];
+            if (length == externalId.size() && arena.compare(offsets[candidate], length, externalId) == 0) {
+                localId = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t insert(const std::string &externalId, size_t hash, size_t slot) {
+        uint32_t localId = size();
+        arena.append(externalId);
+        offsets.push_back(arena.size());
+        slots[slot] = (static_cast<uint64_t>(hash >> 32) << 32) | (localId + 1);
+        // Linear probing stays short below half full
+        if (2 * static_cast<size_t>(size()) > slots.size()) {
+            grow();
+        }
+        return localId;
+    }
+
+    uint64_t getOrAssign(const std::string &externalId, size_t hash) {
+        uint32_t localId;
+        size_t slot;
+        if (!find(externalId, hash, localId, slot)) {
+            localId = insert(externalId, hash, slot);
+        }
+        return static_cast<uint64_t>(localId) * shardCount + index;
+    }
+
+    uint64_t lookup(const std::string &externalId, size_t hash) const {
+        uint32_t localId;
+        size_t slot;
+        if (!find(externalId, hash, localId, slot)) {
+            return NOT_FOUND;
+        }
+        return static_cast<uint64_t>(localId) * shardCount + index;
+    }
+
+    std::string getExternalId(uint32_t localId) const {
+        if (localId >= size()) {
+            return "";
+        }
+        return arena.substr(offsets[localId], offsets[localId + 1] - offsets[localId]);
+    }
+
+    size_t getMemoryBytes() const {
+        return arena.capacity() + offsets.capacity() * sizeof(uint64_t) + slots.capacity() * sizeof(uint64_t);
+    }
+
+    // Append the ids assigned since the last write to the log
+    void writeLog() {
+        if (!log.is_open() || loggedCount == size()) {
+            return;
+        }
+        for (uint32_t localId = loggedCount; localId < size(); localId++) {
+            uint32_t length = offsets[localId + 1] - offsets[localId];
+            log.write(reinterpret_cast<const char *>(&length), sizeof(length));
+            log.write(arena.data() + offsets[localId], length);
+        }
+        log.flush();
+        loggedCount = size();
+    }
+
+    bool openLog(const std::string &path) {
+        std::ifstream input(path, std::ios::binary);
+        if (input.is_open()) {
+            uint32_t header[HEADER_WORDS];
+            if (!input.read(reinterpret_cast<char *>(header), sizeof(header)) || header[0] != MAGIC ||
+                header[1] != VERSION || header[2] != static_cast<uint32_t>(index) ||
+                header[3] != static_cast<uint32_t>(shardCount)) {
+                vertex_dictionary_logger.error("Invalid vertex dictionary log " + path);
+                return false;
+            }
+            uint64_t validLength = sizeof(header);
+            uint32_t length;
+            std::string externalId;
+            while (input.read(reinterpret_cast<char *>(&length), sizeof(length))) {
+                externalId.resize(length);
+                if (!input.read(&externalId[0], length)) {
+                    break;
+                }
+                getOrAssign(externalId, std::hash<std::string>()(externalId));
+                validLength += sizeof(length) + length;
+            }
+            input.clear();
+            input.seekg(0, std::ios::end);
+            uint64_t fileLength = input.tellg();
+            input.close();
+            // A record cut short by a crash is dropped, its vertex is assigned again when it is seen next
+            if (fileLength != validLength) {
+                vertex_dictionary_logger.warn("Dropping a partial record at the end of " + path);
+                if (truncate(path.c_str(), validLength) != 0) {
+                    return false;
+                }
+            }
+            loggedCount = size();
+            log.open(path, std::ios::binary | std::ios::app);
+        } else {
+            log.open(path, std::ios::binary | std::ios::trunc);
+            uint32_t header[HEADER_WORDS] = {MAGIC, VERSION, static_cast<uint32_t>(index),
+                                             static_cast<uint32_t>(shardCount)};
+            log.write(reinterpret_cast<const char *>(header), sizeof(header));
+            writeLog();
+        }
+        return log.is_open();
+    }
+
+ private:
+    int index;
+    int shardCount;
+    std::string arena;                     // External ids back to back
+    std::vector<uint64_t> offsets{0};      // Start of each external id in the arena, and the end of the last
+    std::vector<uint64_t> slots;           // High 32 bits of the hash and the local id + 1, 0 when empty
+    std::ofstream log;
+    uint32_t loggedCount = 0;
+
+    void grow() {
+        std::vector<uint64_t> grown(slots.size() * 2, 0);
+        size_t mask = grown.size() - 1;
+        for (uint32_t localId = 0; localId < size(); localId++) {
+            size_t hash = std::hash<std::string>()(arena.substr(offsets[localId], offsets[localId + 1] -
+                                                                                     offsets[localId]));
+            size_t slot = hash & mask;
+            while (grown[slot] != 0) {
+                slot = (slot + 1) & mask;
+            }
+            grown[slot] = (static_cast<uint64_t>(hash >> 32) << 32) | (localId + 1);
+        }
+        slots.swap(grown);
+    }
+};
+
+static std::string getShardLogPath(const std::string &directory, int shard) {
+    return directory + "/shard_" + std::to_string(shard) + ".log";
+}
+
+VertexDictionary::VertexDictionary(int shardCount) : shardCount(std::max(1, shardCount)) {
+    for (int shard = 0; shard < this->shardCount; shard++) {
+        shards.emplace_back(new Shard(shard, this->shardCount));
+    }
+}
+
+VertexDictionary::~VertexDictionary() {
+    for (auto &shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->writeLog();
+    }
+}
+
+bool VertexDictionary::open(const std::string &directory) {
+    Utils::createDirectory(directory);
+    std::ifstream firstLog(getShardLogPath(directory, 0), std::ios::binary);
+    uint32_t header[HEADER_WORDS];
+    if (firstLog.read(reinterpret_cast<char *>(header), sizeof(header)) && header[0] == MAGIC &&
+        static_cast<int>(header[3]) != shardCount && header[3] > 0) {
+        vertex_dictionary_logger.info("Vertex dictionary " + directory + " has " + std::to_string(header[3]) +
+                                      " shards");
+        shardCount = header[3];
+        shards.clear();
+        for (int shard = 0; shard < shardCount; shard++) {
+            shards.emplace_back(new Shard(shard, shardCount));
+        }
+    }
+    firstLog.close();
+
+    for (int shard = 0; shard < shardCount; shard++) {
+        std::lock_guard<std::mutex> lock(shards[shard]->mutex);
+        if (!shards[shard]->openLog(getShardLogPath(directory, shard))) {
+            vertex_dictionary_logger.error("Could not open the vertex dictionary in " + directory);
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<size_t> VertexDictionary::groupByShard(const std::vector<int> &owners) {
+    std::vector<size_t> order(owners.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&owners](size_t a, size_t b) { return owners[a] < owners[b]; });
+    return order;
+}
+
+void VertexDictionary::hashAll(const std::vector<std::string> &externalIds, std::vector<size_t> &hashes,
+                               std::vector<int> &owners) const {
+    hashes.resize(externalIds.size());
+    owners.resize(externalIds.size());
+    for (size_t i = 0; i < externalIds.size(); i++) {
+        hashes[i] = std::hash<std::string>()(externalIds[i]);
+        owners[i] = getShard(hashes[i]);
+    }
+}
+
+uint64_t VertexDictionary::getOrAssign(const std::string &externalId) {
+    size_t hash = std::hash<std::string>()(externalId);
+    Shard &shard = *shards[getShard(hash)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    uint64_t id = shard.getOrAssign(externalId, hash);
+    shard.writeLog();
+    return id;
+}
+
+void VertexDictionary::getOrAssign(const std::vector<std::string> &externalIds, std::vector<uint64_t> &ids) {
+    std::vector<size_t> hashes;
+    std::vector<int> owners;
+    hashAll(externalIds, hashes, owners);
+    std::vector<size_t> order = groupByShard(owners);
+    ids.resize(externalIds.size());
+    // One lock and one log write per shard of the batch
+    for (size_t k = 0; k < order.size();) {
+        int owner = owners[order[k]];
+        Shard &shard = *shards[owner];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (; k < order.size() && owners[order[k]] == owner; k++) {
+            size_t i = order[k];
+            ids[i] = shard.getOrAssign(externalIds[i], hashes[i]);
+        }
+        shard.writeLog();
+    }
+}
+
+void VertexDictionary::lookup(const std::vector<std::string> &externalIds, std::vector<uint64_t> &ids) {
+    std::vector<size_t> hashes;
+    std::vector<int> owners;
+    hashAll(externalIds, hashes, owners);
+    std::vector<size_t> order = groupByShard(owners);
+    ids.resize(externalIds.size());
+    for (size_t k = 0; k < order.size();) {
+        int owner = owners[order[k]];
+        Shard &shard = *shards[owner];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (; k < order.size() && owners[order[k]] == owner; k++) {
+            size_t i = order[k];
+            ids[i] = shard.lookup(externalIds[i], hashes[i]);
+        }
+    }
+}
+
+void VertexDictionary::getExternalIds(const std::vector<uint64_t> &ids, std::vector<std::string> &externalIds) {
+    std::vector<int> owners(ids.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+        owners[i] = static_cast<int>(ids[i] % shardCount);
+    }
+    std::vector<size_t> order = groupByShard(owners);
+    externalIds.resize(ids.size());
+    for (size_t k = 0; k < order.size();) {
+        int owner = owners[order[k]];
+        Shard &shard = *shards[owner];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (; k < order.size() && owners[order[k]] == owner; k++) {
+            size_t i = order[k];
+            uint64_t localId = ids[i] / shardCount;
+            externalIds[i] = localId > UINT32_MAX ? "" : shard.getExternalId(static_cast<uint32_t>(localId));
+        }
+    }
+}
+
+std::string VertexDictionary::getExternalId(uint64_t id) {
+    std::vector<std::string> externalIds;
+    getExternalIds(std::vector<uint64_t>(1, id), externalIds);
+    return externalIds[0];
+}
+
+uint64_t VertexDictionary::size() {
+    uint64_t count = 0;
+    for (auto &shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        count += shard->size();
+    }
+    return count;
+}
+
+size_t VertexDictionary::getMemoryBytes() {
+    size_t bytes = 0;
+    for (auto &shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        bytes += shard->getMemoryBytes();
+    }
+    return bytes;
+}
+
+VertexDictionaryCache::VertexDictionaryCache(VertexDictionary &dictionary, size_t size) : dictionary(dictionary) {
+    // A power of two so that the slot is a mask of the hash
+    size_t slotCount = 1;
+    while (slotCount < size) {
+        slotCount <<= 1;
+    }
+    entries.resize(slotCount);
+}
+
+void VertexDictionaryCache::getOrAssign(const std::vector<std::string> &externalIds, std::vector<uint64_t> &ids) {
+    ids.resize(externalIds.size());
+    std::vector<std::string> missedIds;
+    std::vector<size_t> missedPositions;
+    size_t mask = entries.size() - 1;
+    for (size_t i = 0; i < externalIds.size(); i++) {
+        Entry &entry = entries[std::hash<std::string>()(externalIds[i]) & mask];
+        if (entry.valid && entry.externalId == externalIds[i]) {
+            ids[i] = entry.id;
+            hits++;
+        } else {
+            missedIds.push_back(externalIds[i]);
+            missedPositions.push_back(i);
+            misses++;
+        }
+    }
+    if (missedIds.empty()) {
+        return;
+    }
+
+    std::vector<uint64_t> missedResults;
+    dictionary.getOrAssign(missedIds, missedResults);
+    for (size_t i = 0; i < missedIds.size(); i++) {
+        ids[missedPositions[i]] = missedResults[i];
+        Entry &entry = entries[std::hash<std::string>()(missedIds[i]) & mask];
+        entry.externalId.swap(missedIds[i]);
+        entry.id = missedResults[i];
+        entry.valid = true;
+    }
+}
@@ -0,0 +1,112 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_VERTEXDICTIONARY_H
+#define JASMINEGRAPH_VERTEXDICTIONARY_H
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Dense integer ids for the external vertex ids of a graph (account names, URIs or numbers of any width), assigned
+ * once at ingest so that the stores and algorithms downstream work on small integers.
+ *
+ * The external ids are split over shards by hash. Shard s of n owns the ids s, s + n, s + 2n, ..., so the owner of
+ * an id is id % n and the ids stay dense over all shards. A shard keeps its external ids back to back in one buffer
+ * with an open addressing table of 8 byte slots over it, 24 to 40 bytes per vertex plus the id itself, and appends
+ * every new id to its log so the assignment survives a restart. Lookups and assignments are batched per shard, so a
+ * batch takes the lock of each shard once.
+ */
+class VertexDictionary {
+ public:
+    static const uint32_t MAGIC;
+    static const uint32_t VERSION;
+    static const int DEFAULT_SHARD_COUNT;
+    static const uint64_t NOT_FOUND;
+
+    explicit VertexDictionary(int shardCount = DEFAULT_SHARD_COUNT);
+
+    ~VertexDictionary();
+
+    // Load the shards logged in the directory, or start logging there. An existing dictionary keeps the shard count
+    // it was created with. Without a directory the dictionary is in memory only.
+    bool open(const std::string &directory);
+
+    uint64_t getOrAssign(const std::string &externalId);
+
+    void getOrAssign(const std::vector<std::string> &externalIds, std::vector<uint64_t> &ids);
+
+    // NOT_FOUND for external ids that were never assigned
+    void lookup(const std::vector<std::string> &externalIds, std::vector<uint64_t> &ids);
+
+    // Translate dense ids back to the external ids, an empty string for ids that were never assigned
+    void getExternalIds(const std::vector<uint64_t> &ids, std::vector<std::string> &externalIds);
+
+    std::string getExternalId(uint64_t id);
+
+    int getShardCount() const { return shardCount; }
+
+    uint64_t size();
+
+    size_t getMemoryBytes();
+
+ private:
+    class Shard;
+
+    int shardCount;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    int getShard(size_t hash) const { return static_cast<int>((hash >> 32) % shardCount); }
+
+    void hashAll(const std::vector<std::string> &externalIds, std::vector<size_t> &hashes,
+                 std::vector<int> &owners) const;
+
+    // The positions of a batch ordered by the shard that owns them
+    static std::vector<size_t> groupByShard(const std::vector<int> &owners);
+};
+
+/**
+ * Cache of recent translations in front of a dictionary, for a single ingest thread. Streams repeat their hub
+ * vertices often, and a hit skips the hash table and the lock of the shard. Misses of a batch are sent to the
+ * dictionary as one batch.
+ */
+class VertexDictionaryCache {
+ public:
+    static const size_t DEFAULT_SIZE;
+
+    explicit VertexDictionaryCache(VertexDictionary &dictionary, size_t size = DEFAULT_SIZE);
+
+    void getOrAssign(const std::vector<std::string> &externalIds, std::vector<uint64_t> &ids);
+
+    long getHitCount() const { return hits; }
+
+    long getMissCount() const { return misses; }
+
+ private:
+    struct Entry {
+        std::string externalId;
+        uint64_t id;
+        bool valid = false;
+    };
+
+    VertexDictionary &dictionary;
+    std::vector<Entry> entries;
+    long hits = 0;
+    long misses = 0;
+};
+
+#endif  // JASMINEGRAPH_VERTEXDICTIONARY_H
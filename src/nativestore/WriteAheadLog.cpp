@@ -0,0 +1,344 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "WriteAheadLog.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "../util/logger/Logger.h"
+
+Logger write_ahead_log_logger;
+
+const uint32_t WriteAheadLog::MAGIC = 0x4c57474a;  // "JGWL"
+const uint32_t WriteAheadLog::VERSION = 1;
+thread_local WriteAheadLog *WriteAheadLog::storeLog = NULL;
+
+static const uint32_t MAX_RECORD_SIZE = 1 << 30;
+static const int FILE_ID_SHIFT = 48;
+
+static uint32_t checksum(const char *data, size_t length) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ static_cast<uint8_t>(data[i])) * 16777619u;
+    }
+    return hash;
+}
+
+template <typename T>
+static void putValue(std::string &buffer, T value) {
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T>
+static bool getValue(const std::string &buffer, size_t &position, T &value) {
+    if (position + sizeof(value) > buffer.size()) {
+        return false;
+    }
+    memcpy(&value, buffer.data() + position, sizeof(value));
+    position += sizeof(value);
+    return true;
+}
+
+static bool writeFully(int fd, const std::string &data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t count = ::write(fd, data.data() + written, data.size() - written);
+        if (count < 0) {
+            return false;
+        }
+        written += count;
+    }
+    return true;
+}
+
+static void syncPath(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        ::close(fd);
+    }
+}
+
+WriteAheadLog::WriteAheadLog(const std::string &prefix) : prefix(prefix), path(prefix + "_wal.db") {}
+
+WriteAheadLog::~WriteAheadLog() { close(); }
+
+bool WriteAheadLog::lock() {
+    std::lock_guard<std::mutex> lock(logMutex);
+    if (lockFd >= 0) {
+        return true;
+    }
+    lockFd = ::open((prefix + "_wal.lock").c_str(), O_RDWR | O_CREAT, 0644);
+    if (lockFd < 0 || flock(lockFd, LOCK_EX | LOCK_NB) != 0) {
+        if (lockFd >= 0) {
+            ::close(lockFd);
+            lockFd = -1;
+        }
+        return false;
+    }
+    return true;
+}
+
+void WriteAheadLog::close() {
+    std::lock_guard<std::mutex> lock(logMutex);
+    if (logFd >= 0) {
+        ::close(logFd);
+        logFd = -1;
+    }
+    if (lockFd >= 0) {
+        ::close(lockFd);
+        lockFd = -1;
+    }
+}
+
+bool WriteAheadLog::recover(std::vector<Record> &records) {
+    records.clear();
+    std::ifstream log(path, std::ios::binary);
+    if (!log.is_open()) {
+        return true;
+    }
+
+    uint32_t header[3] = {0};
+    if (!log.read(reinterpret_cast<char *>(header), sizeof(header)) || header[0] != MAGIC || header[1] != VERSION) {
+        write_ahead_log_logger.error("Invalid write-ahead log " + path);
+        return false;
+    }
+    std::vector<std::string> names(header[2]);
+    std::vector<uint64_t> sizes(header[2]);
+    for (uint32_t i = 0; i < header[2]; i++) {
+        uint16_t length = 0;
+        if (!log.read(reinterpret_cast<char *>(&length), sizeof(length))) {
+            write_ahead_log_logger.error("Invalid write-ahead log " + path);
+            return false;
+        }
+        names[i].resize(length);
+        if (!log.read(&names[i][0], length) || !log.read(reinterpret_cast<char *>(&sizes[i]), sizeof(sizes[i]))) {
+            write_ahead_log_logger.error("Invalid write-ahead log " + path);
+            return false;
+        }
+    }
+
+    // Records up to the first one that was not completely written
+    std::vector<std::pair<uint16_t, std::pair<uint64_t, std::string>>> images;
+    std::string record;
+    while (true) {
+        record.resize(sizeof(uint8_t) + sizeof(uint32_t));
+        if (!log.read(&record[0], record.size())) {
+            break;
+        }
+        uint32_t length;
+        memcpy(&length, record.data() + sizeof(uint8_t), sizeof(length));
+        if (length > MAX_RECORD_SIZE) {
+            break;
+        }
+        record.resize(record.size() + length);
+        uint32_t expected;
+        if (!log.read(&record[sizeof(uint8_t) + sizeof(uint32_t)], length) ||
+            !log.read(reinterpret_cast<char *>(&expected), sizeof(expected)) ||
+            checksum(record.data(), record.size()) != expected) {
+            break;
+        }
+
+        RecordType type = static_cast<RecordType>(record[0]);
+        std::string payload = record.substr(sizeof(uint8_t) + sizeof(uint32_t));
+        size_t position = 0;
+        if (type == BEFORE_IMAGE) {
+            uint16_t fileId;
+            uint64_t offset;
+            if (getValue(payload, position, fileId) && getValue(payload, position, offset) && fileId < names.size()) {
+                images.push_back({fileId, {offset, payload.substr(position)}});
+            }
+            continue;
+        }
+        Record redo;
+        redo.type = type;
+        uint32_t fieldLength;
+        while (getValue(payload, position, fieldLength) && position + fieldLength <= payload.size()) {
+            redo.fields.push_back(payload.substr(position, fieldLength));
+            position += fieldLength;
+        }
+        size_t fieldCount = type == LOCAL_EDGE || type == CENTRAL_EDGE ? 2 : type == NODE_PROPERTY ? 3 : 4;
+        if (type < LOCAL_EDGE || type > CENTRAL_EDGE_PROPERTY || redo.fields.size() != fieldCount) {
+            write_ahead_log_logger.error("Invalid record in the write-ahead log " + path);
+            break;
+        }
+        records.push_back(redo);
+    }
+    if (records.empty() && images.empty()) {
+        return true;
+    }
+
+    write_ahead_log_logger.info("Recovering " + prefix + " from the last checkpoint, redoing " +
+                                std::to_string(records.size()) + " records");
+    for (size_t i = 0; i < names.size(); i++) {
+        struct stat fileStat;
+        std::string file = prefix + names[i];
+        if (stat(file.c_str(), &fileStat) != 0) {
+            continue;
+        }
+        if (static_cast<uint64_t>(fileStat.st_size) < sizes[i]) {
+            write_ahead_log_logger.error("The checkpointed file " + file + " lost " +
+                                         std::to_string(sizes[i] - fileStat.st_size) + " bytes");
+        } else if (static_cast<uint64_t>(fileStat.st_size) > sizes[i] && truncate(file.c_str(), sizes[i]) != 0) {
+            write_ahead_log_logger.error("Could not truncate " + file);
+            return false;
+        }
+    }
+    // The first image saved of a range is the one the checkpoint had
+    for (auto image = images.rbegin(); image != images.rend(); image++) {
+        std::fstream file(prefix + names[image->first], std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(image->second.first);
+        if (!file.write(image->second.second.data(), image->second.second.size())) {
+            write_ahead_log_logger.error("Could not restore " + prefix + names[image->first]);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WriteAheadLog::checkpoint(const std::map<std::string, std::fstream *> &files) {
+    std::lock_guard<std::mutex> lock(logMutex);
+    std::string header;
+    putValue(header, MAGIC);
+    putValue(header, VERSION);
+    putValue(header, static_cast<uint32_t>(files.size()));
+    fileSizes.clear();
+    fileIds.clear();
+    savedImages.clear();
+    for (auto &file : files) {
+        syncPath(file.first);
+        struct stat fileStat;
+        uint64_t size = stat(file.first.c_str(), &fileStat) == 0 ? fileStat.st_size : 0;
+        std::string name = file.first.compare(0, prefix.size(), prefix) == 0 ? file.first.substr(prefix.size())
+                                                                                : file.first;
+        putValue(header, static_cast<uint16_t>(name.size()));
+        header += name;
+        putValue(header, size);
+        if (file.second) {
+            fileIds[file.second] = fileSizes.size();
+        }
+        fileSizes.push_back(size);
+    }
+
+    // The new log replaces the old one only once it is on the disk
+    std::string temporaryPath = path + ".tmp";
+    int fd = ::open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || !writeFully(fd, header) || fsync(fd) != 0) {
+        write_ahead_log_logger.error("Could not write the checkpoint of " + path);
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+    ::close(fd);
+    if (rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        write_ahead_log_logger.error("Could not replace " + path);
+        return false;
+    }
+    size_t separator = path.find_last_of('/');
+    syncPath(separator == std::string::npos ? "." : path.substr(0, separator));
+
+    if (logFd >= 0) {
+        ::close(logFd);
+    }
+    logFd = ::open(path.c_str(), O_WRONLY | O_APPEND);
+    recordCount = 0;
+    logSize = header.size();
+    return logFd >= 0;
+}
+
+void WriteAheadLog::write(RecordType type, const std::string &payload) {
+    std::string record;
+    record.reserve(sizeof(uint8_t) + 2 * sizeof(uint32_t) + payload.size());
+    putValue(record, static_cast<uint8_t>(type));
+    putValue(record, static_cast<uint32_t>(payload.size()));
+    record += payload;
+    putValue(record, checksum(record.data(), record.size()));
+    if (logFd < 0 || !writeFully(logFd, record)) {
+        write_ahead_log_logger.error("Could not append to the write-ahead log " + path);
+        return;
+    }
+    if (sync) {
+        fdatasync(logFd);
+    }
+    logSize += record.size();
+}
+
+void WriteAheadLog::append(RecordType type, const std::vector<const std::string *> &fields) {
+    std::string payload;
+    for (const std::string *field : fields) {
+        putValue(payload, static_cast<uint32_t>(field->size()));
+        payload += *field;
+    }
+    std::lock_guard<std::mutex> lock(logMutex);
+    write(type, payload);
+    recordCount++;
+}
+
+void WriteAheadLog::logEdge(bool central, const std::string &source, const std::string &destination) {
+    append(central ? CENTRAL_EDGE : LOCAL_EDGE, {&source, &destination});
+}
+
+void WriteAheadLog::logNodeProperty(const std::string &node, const std::string &name, const std::string &value) {
+    append(NODE_PROPERTY, {&node, &name, &value});
+}
+
+void WriteAheadLog::logEdgeProperty(bool central, const std::string &source, const std::string &destination,
+                                    const std::string &name, const std::string &value) {
+    append(central ? CENTRAL_EDGE_PROPERTY : LOCAL_EDGE_PROPERTY, {&source, &destination, &name, &value});
+}
+
+void WriteAheadLog::saveBeforeImage(std::fstream *file, uint64_t offset, uint64_t length) {
+    std::lock_guard<std::mutex> lock(logMutex);
+    auto fileId = fileIds.find(file);
+    if (fileId == fileIds.end() || offset >= fileSizes[fileId->second]) {
+        return;  // Appended since the checkpoint, truncated by the recovery
+    }
+    length = std::min(length, fileSizes[fileId->second] - offset);
+    uint64_t &saved = savedImages[(static_cast<uint64_t>(fileId->second) << FILE_ID_SHIFT) | offset];
+    if (saved >= length) {
+        return;
+    }
+
+    std::string payload;
+    putValue(payload, static_cast<uint16_t>(fileId->second));
+    putValue(payload, offset + saved);
+    size_t start = payload.size();
+    payload.resize(start + length - saved);
+    file->clear();
+    file->seekg(offset + saved);
+    if (!file->read(&payload[start], length - saved)) {
+        write_ahead_log_logger.error("Could not read the bytes to overwrite at " + std::to_string(offset));
+        file->clear();
+        return;
+    }
+    saved = length;
+    write(BEFORE_IMAGE, payload);
+}
+
+uint64_t WriteAheadLog::getRecordCount() {
+    std::lock_guard<std::mutex> lock(logMutex);
+    return recordCount;
+}
+
+uint64_t WriteAheadLog::getSizeInBytes() {
+    std::lock_guard<std::mutex> lock(logMutex);
+    return logSize;
+}
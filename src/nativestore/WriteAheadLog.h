@@ -0,0 +1,113 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_WRITEAHEADLOG_H
+#define JASMINEGRAPH_WRITEAHEADLOG_H
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Write-ahead log of the native store of a partition (<prefix>_wal.db). The edges and properties added to the store
+ * are logged before they are written, and the first write since the last checkpoint to bytes the checkpoint has
+ * (node and relation records updated in place, reused property runs) logs the bytes it overwrites.
+ *
+ * A checkpoint syncs the store files to the disk and starts an empty log that lists the files with their sizes.
+ * Recovery truncates the files to these sizes, puts the overwritten bytes back and redoes the logged edges and
+ * properties, so it takes time in proportion to the records since the checkpoint rather than to the graph.
+ *
+ * Only one node manager of a partition logs, the one holding the lock on <prefix>_wal.lock.
+ */
+class WriteAheadLog {
+ public:
+    enum RecordType : uint8_t {
+        LOCAL_EDGE = 1,
+        CENTRAL_EDGE = 2,
+        NODE_PROPERTY = 3,
+        LOCAL_EDGE_PROPERTY = 4,
+        CENTRAL_EDGE_PROPERTY = 5,
+        BEFORE_IMAGE = 6
+    };
+
+    // An edge (source, destination), a node property (node, name, value) or an edge property (source, destination,
+    // name, value) to redo
+    struct Record {
+        RecordType type;
+        std::vector<std::string> fields;
+    };
+
+    static const uint32_t MAGIC;
+    static const uint32_t VERSION;
+
+    // Log of the store opened by the node manager of the current thread, NULL when it does not log
+    static thread_local WriteAheadLog *storeLog;
+
+    explicit WriteAheadLog(const std::string &prefix);
+
+    ~WriteAheadLog();
+
+    // Returns false when another node manager of the partition holds the lock
+    bool lock();
+
+    // Bring the store files back to the last checkpoint and return the records logged since
+    bool recover(std::vector<Record> &records);
+
+    // Sync the files to the disk and start an empty log. The streams of the files that are updated in place are
+    // given so that their writes can be recognised, the other files are only appended to.
+    bool checkpoint(const std::map<std::string, std::fstream *> &files);
+
+    void logEdge(bool central, const std::string &source, const std::string &destination);
+
+    void logNodeProperty(const std::string &node, const std::string &name, const std::string &value);
+
+    void logEdgeProperty(bool central, const std::string &source, const std::string &destination,
+                         const std::string &name, const std::string &value);
+
+    // Called before overwriting length bytes of a store file at offset
+    void saveBeforeImage(std::fstream *file, uint64_t offset, uint64_t length);
+
+    void setSync(bool sync) { this->sync = sync; }
+
+    // Edges and properties logged since the last checkpoint
+    uint64_t getRecordCount();
+
+    uint64_t getSizeInBytes();
+
+    std::string getPath() const { return path; }
+
+    void close();
+
+ private:
+    std::string prefix;
+    std::string path;
+    int logFd = -1;
+    int lockFd = -1;
+    bool sync = false;
+    std::mutex logMutex;
+    uint64_t recordCount = 0;
+    uint64_t logSize = 0;
+    std::vector<uint64_t> fileSizes;                       // Of the files of the last checkpoint
+    std::unordered_map<const std::fstream *, int> fileIds;  // Index of the streams in the files of the checkpoint
+    std::unordered_map<uint64_t, uint64_t> savedImages;     // Length saved at each file id and offset
+
+    void append(RecordType type, const std::vector<const std::string *> &fields);
+
+    void write(RecordType type, const std::string &payload);
+};
+
+#endif  // JASMINEGRAPH_WRITEAHEADLOG_H
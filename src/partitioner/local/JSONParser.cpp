@@ -13,199 +13,550 @@ limitations under the License.
 
 #include "JSONParser.h"
 
-#include <jsoncpp/json/json.h>
-
-#include <boost/foreach.hpp>
-#include <boost/optional/optional.hpp>
-#include <boost/property_tree/ptree.hpp>
+#include <algorithm>
 #include <chrono>
-#include <ctime>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
 #include <future>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 
 #include "../../util/logger/Logger.h"
 
 Logger jsonparser_logger;
 
-class Value;
+using namespace std;
 
-namespace pt = boost::property_tree;
+const double JSONParser::FIELD_MIN_WEIGHT = 0.5;
+const int JSONParser::FIELD_MIN_COUNT = 821;
+const size_t JSONParser::CHUNK_SIZE = 4 * 1024 * 1024;
 
-using namespace std;
+static const size_t WRITE_BUFFER_SIZE = 1024 * 1024;
 
-static void attributeFileCreate(std::map<long, int> &vertexToIDMap, std::map<std::string, int> &fieldsMap,
-                                std::string inputFilePath, string outputFilePath);
-static void readFile(std::map<long, int> &vertexToIDMap, std::map<std::string, int> &fieldsMap,
-                     std::string inputFilePath, string outputFilePath);
-static std::map<long, int> createEdgeList(std::string inputFilePath, string outputFilePath);
-static std::map<std::string, int> countFileds(std::string inputFilePath);
+namespace {
+// The papers of one chunk in file order. Field ids are local to the chunk until it is merged.
+struct ParsedChunk {
+    std::vector<long> paperIds;
+    std::vector<size_t> referenceEnds;
+    std::vector<long> references;
+    std::vector<size_t> fieldEnds;
+    std::vector<int> fields;
+    std::vector<std::string> fieldNames;
+    long lineCount = 0;
+    long malformedLineCount = 0;
+    double parseSeconds = 0;
+};
 
-void JSONParser::jsonParse(string &filePath) {
-    std::string inputFilePath = filePath;
-    std::string outputFilePath = Utils::getHomeDir() + "/.jasminegraph/tmp/JSONParser/output";
-    const clock_t begin = clock();
-    std::map<long, int> vertexToIDMap;
-    std::map<std::string, int> fieldsMap;
-    readFile(vertexToIDMap, fieldsMap, inputFilePath, outputFilePath);
-    float time = float(clock() - begin) / CLOCKS_PER_SEC;
-    jsonparser_logger.log("FieldMap size : " + to_string(fieldsMap.size()), "info");
-    jsonparser_logger.log("Time for 1st read : " + to_string(time), "info");
-    const clock_t begin2 = clock();
-    attributeFileCreate(vertexToIDMap, fieldsMap, inputFilePath, outputFilePath);
-    float time2 = float(clock() - begin2) / CLOCKS_PER_SEC;
-    jsonparser_logger.log("Time for 2nd read : " + to_string(time2), "info");
+static void skipSpaces(const char *&p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+        p++;
+    }
 }
 
-static void attributeFileCreate(std::map<long, int> &vertexToIDMap, std::map<std::string, int> &fieldsMap,
-                                std::string inputFilePath, string outputFilePath) {
-    ofstream attrFile;
-    attrFile.open(outputFilePath + "/attributeList.txt");
-
-    std::ifstream infile(inputFilePath);
-    std::string line;
-    Json::Reader reader;
-    Json::Value root;
-    std::vector<int> vectorOfzeros(fieldsMap.size(), 0);
-
-    while (std::getline(infile, line)) {
-        std::vector<int> tempVectorOfZeros = vectorOfzeros;
-        if (!reader.parse(line, root)) {
-            string message = reader.getFormattedErrorMessages();
-            jsonparser_logger.log("Error : " + message, "error");
-            break;
-        }
-        string id = root["id"].asString();
-        auto idFound = vertexToIDMap.find(stol(id));
-        if (idFound != vertexToIDMap.end()) {
-            int mapped_id = vertexToIDMap.find(stol(id))->second;
-            const Json::Value fos = root["fos"];
-            for (int i = 0; i < fos.size(); i++) {
-                string field = fos[i]["name"].asString();
-                double weight = fos[i]["w"].asDouble();
-                if (weight > 0.5) {
-                    auto search = fieldsMap.find(field);
-                    if (search != fieldsMap.end()) {
-                        tempVectorOfZeros.at(search->second) = 1;
-                    }
+// Moves past the closing quote of the string that starts at p. memchr finds the quotes with vector instructions.
+static bool skipString(const char *&p, const char *end) {
+    const char *quote = p + 1;
+    while ((quote = static_cast<const char *>(memchr(quote, '"', end - quote))) != NULL) {
+        const char *backslash = quote;
+        while (backslash[-1] == '\\') {
+            backslash--;
+        }
+        if ((quote - backslash) % 2 == 0) {
+            p = quote + 1;
+            return true;
+        }
+        quote++;
+    }
+    return false;
+}
+
+static void appendUTF8(unsigned long codePoint, std::string &out) {
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xc0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+    } else {
+        out.push_back(static_cast<char>(0xe0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+    }
+}
+
+static bool parseString(const char *&p, const char *end, std::string &out) {
+    const char *start = p + 1;
+    if (!skipString(p, end)) {
+        return false;
+    }
+    const char *close = p - 1;
+    out.clear();
+    const char *backslash = static_cast<const char *>(memchr(start, '\\', close - start));
+    if (backslash == NULL) {
+        out.assign(start, close);
+        return true;
+    }
+    for (const char *c = start; c < close; c++) {
+        if (*c != '\\') {
+            out.push_back(*c);
+            continue;
+        }
+        c++;
+        switch (*c) {
+            case 'b':
+                out.push_back('\b');
+                break;
+            case 'f':
+                out.push_back('\f');
+                break;
+            case 'n':
+                out.push_back('\n');
+                break;
+            case 'r':
+                out.push_back('\r');
+                break;
+            case 't':
+                out.push_back('\t');
+                break;
+            case 'u': {
+                if (close - c < 5) {
+                    return false;
                 }
+                // Surrogate pairs are not combined, field names are plain text
+                appendUTF8(strtoul(std::string(c + 1, 4).c_str(), NULL, 16), out);
+                c += 4;
+                break;
             }
-            attrFile << mapped_id << "\t";
-            for (auto it = tempVectorOfZeros.begin(); it != tempVectorOfZeros.end(); ++it) {
-                attrFile << *it << "\t ";
+            default:
+                out.push_back(*c);
+        }
+    }
+    return true;
+}
+
+static bool skipValue(const char *&p, const char *end) {
+    if (p >= end) {
+        return false;
+    }
+    if (*p == '"') {
+        return skipString(p, end);
+    }
+    if (*p == '{' || *p == '[') {
+        int depth = 0;
+        while (p < end) {
+            if (*p == '"') {
+                if (!skipString(p, end)) {
+                    return false;
+                }
+                continue;
             }
-            attrFile << endl;
+            if (*p == '{' || *p == '[') {
+                depth++;
+            } else if (*p == '}' || *p == ']') {
+                if (--depth == 0) {
+                    p++;
+                    return true;
+                }
+            }
+            p++;
         }
+        return false;
+    }
+    // Numbers, true, false and null
+    while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\n') {
+        p++;
     }
-    infile.close();
-    attrFile.close();
+    return true;
 }
 
-static void readFile(std::map<long, int> &vertexToIDMap, std::map<std::string, int> &fieldsMap,
-                     std::string inputFilePath, string outputFilePath) {
-    Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/");
-    Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/tmp");
-    Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/tmp/JSONParser");
-    Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/tmp/JSONParser/output");
+// Ids are numbers or strings of digits
+static bool parseId(const char *&p, const char *end, long &id) {
+    bool quoted = p < end && *p == '"';
+    const char *digits = quoted ? p + 1 : p;
+    char *digitsEnd;
+    id = strtol(digits, &digitsEnd, 10);
+    if (digitsEnd == digits || digitsEnd > end) {
+        return false;
+    }
+    p = digitsEnd;
+    if (quoted) {
+        if (p >= end || *p != '"') {
+            return false;
+        }
+        p++;
+    }
+    return true;
+}
 
-    auto edgeListFuture = std::async(createEdgeList, inputFilePath, outputFilePath);
-    auto filedsFuture = std::async(countFileds, inputFilePath);
+static bool expect(const char *&p, const char *end, char c) {
+    skipSpaces(p, end);
+    if (p >= end || *p != c) {
+        return false;
+    }
+    p++;
+    skipSpaces(p, end);
+    return true;
+}
 
-    vertexToIDMap = edgeListFuture.get();
-    fieldsMap = filedsFuture.get();
+// Calls parseElement for each element of the array at p
+template <typename ElementParser>
+static bool parseArray(const char *&p, const char *end, ElementParser parseElement) {
+    if (p >= end || *p != '[') {
+        return skipValue(p, end);
+    }
+    p++;
+    skipSpaces(p, end);
+    if (p < end && *p == ']') {
+        p++;
+        return true;
+    }
+    while (p < end) {
+        if (!parseElement()) {
+            return false;
+        }
+        skipSpaces(p, end);
+        if (p < end && *p == ',') {
+            p++;
+            skipSpaces(p, end);
+        } else {
+            return expect(p, end, ']');
+        }
+    }
+    return false;
 }
 
-static std::map<long, int> createEdgeList(std::string inputFilePath, string outputFilePath) {
-    ofstream file;
-    file.open(outputFilePath + "/edgelist.txt");
-
-    std::ifstream infile(inputFilePath);
-    std::string line;
-    Json::Reader reader;
-    Json::Value root;
-    int idCounter = 0;
-    int mapped_id = 0;
-    std::map<long, int> vertexToIDMap;
-
-    while (std::getline(infile, line)) {
-        if (!reader.parse(line, root)) {
-            jsonparser_logger.log("File format mismatch", "error");
-            file.close();
-            infile.close();
-            return vertexToIDMap;
-        }
-        string id = root["id"].asString();
-        const Json::Value references = root["references"];
-        if (references.empty()) {
-            continue;
+// Calls parseMember with the key of each member of the object at p, positioned at the value
+template <typename MemberParser>
+static bool parseObject(const char *&p, const char *end, std::string &key, MemberParser parseMember) {
+    if (!expect(p, end, '{')) {
+        return false;
+    }
+    if (p < end && *p == '}') {
+        p++;
+        return true;
+    }
+    while (p < end && *p == '"') {
+        if (!parseString(p, end, key) || !expect(p, end, ':') || !parseMember()) {
+            return false;
         }
-        long idValue = stol(id);
-        if (vertexToIDMap.insert(make_pair(idValue, idCounter)).second) {
-            mapped_id = idCounter;
-            idCounter++;
+        skipSpaces(p, end);
+        if (p < end && *p == ',') {
+            p++;
+            skipSpaces(p, end);
         } else {
-            mapped_id = vertexToIDMap.find(idValue)->second;
+            return expect(p, end, '}');
         }
+    }
+    return false;
+}
+
+class PaperScanner {
+ public:
+    explicit PaperScanner(ParsedChunk &chunk) : chunk(chunk) {}
 
-        int mapped_ref_id;
-        for (int index = 0; index < references.size(); ++index) {
-            string ref_id = references[index].asString();
-            long ref_idValue = stol(ref_id);
-            if (vertexToIDMap.insert(make_pair(ref_idValue, idCounter)).second) {
-                mapped_ref_id = idCounter;
-                idCounter++;
-            } else {
-                mapped_ref_id = vertexToIDMap.find(ref_idValue)->second;
+    bool parseLine(const char *p, const char *end) {
+        size_t referenceStart = chunk.references.size();
+        size_t fieldStart = chunk.fields.size();
+        long id = 0;
+        bool hasId = false;
+        bool parsed = parseObject(p, end, key, [&]() {
+            if (key == "id") {
+                hasId = true;
+                return parseId(p, end, id);
+            }
+            if (key == "references") {
+                return parseArray(p, end, [&]() {
+                    long reference;
+                    if (!parseId(p, end, reference)) {
+                        return false;
+                    }
+                    chunk.references.push_back(reference);
+                    return true;
+                });
+            }
+            if (key == "fos") {
+                return parseArray(p, end, [&]() { return parseField(p, end); });
             }
+            return skipValue(p, end);
+        });
+        if (!parsed || !hasId) {
+            chunk.references.resize(referenceStart);
+            chunk.fields.resize(fieldStart);
+            return false;
+        }
+        chunk.paperIds.push_back(id);
+        chunk.referenceEnds.push_back(chunk.references.size());
+        chunk.fieldEnds.push_back(chunk.fields.size());
+        return true;
+    }
+
+ private:
+    ParsedChunk &chunk;
+    std::unordered_map<std::string, int> fieldIds;
+    std::string key;
+    std::string name;
+
+    // A {"name": ..., "w": ...} field of study, kept if its weight is above FIELD_MIN_WEIGHT
+    bool parseField(const char *&p, const char *end) {
+        double weight = 0;
+        bool hasName = false;
+        std::string fieldKey;
+        bool parsed = parseObject(p, end, fieldKey, [&]() {
+            if (fieldKey == "name" && p < end && *p == '"') {
+                hasName = true;
+                return parseString(p, end, name);
+            }
+            if (fieldKey == "w") {
+                char *numberEnd;
+                weight = strtod(p, &numberEnd);
+                if (numberEnd == p) {
+                    weight = 0;
+                    return skipValue(p, end);
+                }
+                p = numberEnd;
+                return numberEnd <= end;
+            }
+            return skipValue(p, end);
+        });
+        if (parsed && hasName && weight > JSONParser::FIELD_MIN_WEIGHT) {
+            auto inserted = fieldIds.insert(std::make_pair(name, static_cast<int>(fieldIds.size())));
+            if (inserted.second) {
+                chunk.fieldNames.push_back(name);
+            }
+            chunk.fields.push_back(inserted.first->second);
+        }
+        return parsed;
+    }
+};
 
-            file << mapped_id << " " << mapped_ref_id << endl;
+static ParsedChunk parseChunk(std::string data) {
+    auto begin = std::chrono::steady_clock::now();
+    ParsedChunk chunk;
+    PaperScanner scanner(chunk);
+    const char *p = data.c_str();
+    const char *end = p + data.size();
+    while (p < end) {
+        const char *lineEnd = static_cast<const char *>(memchr(p, '\n', end - p));
+        if (lineEnd == NULL) {
+            lineEnd = end;
+        }
+        const char *first = p;
+        skipSpaces(first, lineEnd);
+        if (first < lineEnd) {
+            chunk.lineCount++;
+            if (!scanner.parseLine(first, lineEnd)) {
+                chunk.malformedLineCount++;
+            }
         }
+        p = lineEnd + 1;
     }
-    file.close();
-    infile.close();
-    return vertexToIDMap;
+    chunk.parseSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return chunk;
 }
 
-static std::map<std::string, int> countFileds(std::string inputFilePath) {
-    std::ifstream infile(inputFilePath);
-    std::string line;
-    Json::Reader reader;
-    Json::Value root;
-    std::map<std::string, int> fieldCounts;
-    int field_counter = 0;
-
-    while (std::getline(infile, line)) {
-        if (!reader.parse(line, root)) {
-            jsonparser_logger.log("File format mismatch", "error");
-            return fieldCounts;
-        }
-        const Json::Value fos = root["fos"];
-
-        for (int i = 0; i < fos.size(); i++) {
-            string field = fos[i]["name"].asString();
-            double weight = fos[i]["w"].asDouble();
-            if (weight <= 0.5) {
-                continue;
+static void appendNumber(std::string &buffer, long value) {
+    char digits[24];
+    int length = snprintf(digits, sizeof(digits), "%ld", value);
+    buffer.append(digits, length);
+}
+
+static void flushBuffer(std::string &buffer, std::ofstream &file, size_t threshold) {
+    if (buffer.size() >= threshold) {
+        file.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+}
+
+// Everything kept of the file after a chunk is merged: the remapped ids and the fields of study of every paper
+class ChunkMerger {
+ public:
+    ChunkMerger(const std::string &edgeFilePath, JSONParseStats &stats) : edgeFile(edgeFilePath), stats(stats) {
+        edgeBuffer.reserve(WRITE_BUFFER_SIZE + 64);
+    }
+
+    void merge(const ParsedChunk &chunk) {
+        auto begin = std::chrono::steady_clock::now();
+        std::vector<int> globalFieldIds(chunk.fieldNames.size());
+        for (size_t i = 0; i < chunk.fieldNames.size(); i++) {
+            auto inserted = fieldIds.insert(std::make_pair(chunk.fieldNames[i], static_cast<int>(fieldNames.size())));
+            if (inserted.second) {
+                fieldNames.push_back(chunk.fieldNames[i]);
+                fieldCounts.push_back(0);
             }
-            if (fieldCounts.find(field) == fieldCounts.end()) {
-                fieldCounts.insert(make_pair(field, 1));
-            } else {
+            globalFieldIds[i] = inserted.first->second;
+        }
+
+        size_t referenceStart = 0;
+        size_t fieldStart = 0;
+        for (size_t paper = 0; paper < chunk.paperIds.size(); paper++) {
+            paperIds.push_back(chunk.paperIds[paper]);
+            for (size_t f = fieldStart; f < chunk.fieldEnds[paper]; f++) {
+                int field = globalFieldIds[chunk.fields[f]];
+                paperFields.push_back(field);
                 fieldCounts[field]++;
             }
+            paperFieldEnds.push_back(paperFields.size());
+            fieldStart = chunk.fieldEnds[paper];
+
+            size_t referenceEnd = chunk.referenceEnds[paper];
+            if (referenceEnd > referenceStart) {
+                int mappedId = getMappedId(chunk.paperIds[paper]);
+                for (size_t r = referenceStart; r < referenceEnd; r++) {
+                    int mappedReferenceId = getMappedId(chunk.references[r]);
+                    appendNumber(edgeBuffer, mappedId);
+                    edgeBuffer.push_back(' ');
+                    appendNumber(edgeBuffer, mappedReferenceId);
+                    edgeBuffer.push_back('\n');
+                    stats.edgeCount++;
+                }
+                flushBuffer(edgeBuffer, edgeFile, WRITE_BUFFER_SIZE);
+            }
+            referenceStart = referenceEnd;
+        }
+        stats.lineCount += chunk.lineCount;
+        stats.malformedLineCount += chunk.malformedLineCount;
+        stats.parseSeconds += chunk.parseSeconds;
+        stats.remapSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    void closeEdgeFile() {
+        flushBuffer(edgeBuffer, edgeFile, 0);
+        edgeFile.close();
+        stats.vertexCount = vertexToIDMap.size();
+    }
+
+    // One row per paper with an id in the edge list: the mapped id and a 0/1 column per frequent field of study,
+    // in the order of the field names
+    void writeAttributes(const std::string &attributeFilePath) {
+        auto begin = std::chrono::steady_clock::now();
+        std::vector<std::pair<std::string, int>> frequentFields;
+        for (size_t field = 0; field < fieldNames.size(); field++) {
+            if (fieldCounts[field] > JSONParser::FIELD_MIN_COUNT) {
+                frequentFields.push_back(std::make_pair(fieldNames[field], field));
+            }
+        }
+        std::sort(frequentFields.begin(), frequentFields.end());
+        std::vector<int> columns(fieldNames.size(), -1);
+        for (size_t column = 0; column < frequentFields.size(); column++) {
+            columns[frequentFields[column].second] = column;
+        }
+        stats.fieldCount = frequentFields.size();
+
+        std::string zeros;
+        for (size_t column = 0; column < frequentFields.size(); column++) {
+            zeros += "0\t ";
+        }
+        std::ofstream attributeFile(attributeFilePath);
+        std::string buffer;
+        buffer.reserve(WRITE_BUFFER_SIZE + zeros.size() + 32);
+        size_t fieldStart = 0;
+        for (size_t paper = 0; paper < paperIds.size(); paper++) {
+            size_t fieldEnd = paperFieldEnds[paper];
+            auto mapped = vertexToIDMap.find(paperIds[paper]);
+            if (mapped != vertexToIDMap.end()) {
+                appendNumber(buffer, mapped->second);
+                buffer.push_back('\t');
+                size_t rowStart = buffer.size();
+                buffer += zeros;
+                for (size_t f = fieldStart; f < fieldEnd; f++) {
+                    int column = columns[paperFields[f]];
+                    if (column >= 0) {
+                        buffer[rowStart + 3 * column] = '1';
+                    }
+                }
+                buffer.push_back('\n');
+                flushBuffer(buffer, attributeFile, WRITE_BUFFER_SIZE);
+            }
+            fieldStart = fieldEnd;
         }
+        flushBuffer(buffer, attributeFile, 0);
+        attributeFile.close();
+        stats.attributeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
     }
-    infile.close();
 
-    jsonparser_logger.log("Done counting fields", "info");
-    std::map<std::string, int> fieldsMap;
-    for (auto it = fieldCounts.begin(); it != fieldCounts.end(); ++it) {
-        std::string field = it->first;
-        if (it->second > 821) {
-            if (fieldsMap.find(field) == fieldsMap.end()) {
-                fieldsMap.insert(make_pair(field, field_counter));
-                field_counter++;
+ private:
+    std::ofstream edgeFile;
+    std::string edgeBuffer;
+    JSONParseStats &stats;
+    std::unordered_map<long, int> vertexToIDMap;
+    std::unordered_map<std::string, int> fieldIds;
+    std::vector<std::string> fieldNames;
+    std::vector<long> fieldCounts;
+    std::vector<long> paperIds;
+    std::vector<size_t> paperFieldEnds;
+    std::vector<int> paperFields;
+
+    int getMappedId(long id) {
+        return vertexToIDMap.insert(std::make_pair(id, static_cast<int>(vertexToIDMap.size()))).first->second;
+    }
+};
+}  // namespace
+
+void JSONParser::jsonParse(string &filePath) {
+    std::string outputFilePath = Utils::getHomeDir() + "/.jasminegraph/tmp/JSONParser/output";
+    Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/");
+    Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/tmp");
+    Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/tmp/JSONParser");
+    Utils::createDirectory(outputFilePath);
+
+    JSONParseStats stats = jsonParse(filePath, outputFilePath, std::max(1u, std::thread::hardware_concurrency()));
+    jsonparser_logger.info("Parsed " + to_string(stats.lineCount) + " papers into " + to_string(stats.vertexCount) +
+                           " vertices, " + to_string(stats.edgeCount) + " edges and " + to_string(stats.fieldCount) +
+                           " fields in " + to_string(stats.totalSeconds) + " s (parse " +
+                           to_string(stats.parseSeconds) + " s over all threads, remap " +
+                           to_string(stats.remapSeconds) + " s, attributes " + to_string(stats.attributeSeconds) +
+                           " s)");
+}
+
+JSONParseStats JSONParser::jsonParse(const string &inputFilePath, const string &outputFilePath, int threadCount) {
+    auto begin = std::chrono::steady_clock::now();
+    JSONParseStats stats;
+    std::ifstream input(inputFilePath, std::ios::binary);
+    if (!input.is_open()) {
+        jsonparser_logger.error("Could not open " + inputFilePath);
+        return stats;
+    }
+
+    ChunkMerger merger(outputFilePath + "/edgelist.txt", stats);
+    // Chunks are parsed ahead while the main thread merges the oldest one, which keeps the merge order
+    std::deque<std::future<ParsedChunk>> pending;
+    size_t maxPending = 2 * std::max(1, threadCount);
+    std::string carry;
+    bool endOfFile = false;
+    while (!endOfFile) {
+        std::string data;
+        data.swap(carry);
+        size_t carried = data.size();
+        data.resize(carried + CHUNK_SIZE);
+        input.read(&data[carried], CHUNK_SIZE);
+        data.resize(carried + input.gcount());
+        endOfFile = !input;
+        if (!endOfFile) {
+            // A line that does not end in this chunk is carried over to the next one
+            size_t lastLineEnd = data.rfind('\n');
+            if (lastLineEnd == std::string::npos) {
+                carry.swap(data);
+                continue;
             }
+            carry.assign(data, lastLineEnd + 1, std::string::npos);
+            data.resize(lastLineEnd + 1);
         }
+        stats.byteCount += data.size();
+        pending.push_back(std::async(std::launch::async, parseChunk, std::move(data)));
+        while (pending.size() >= maxPending || (endOfFile && !pending.empty())) {
+            merger.merge(pending.front().get());
+            pending.pop_front();
+        }
+    }
+    merger.closeEdgeFile();
+    merger.writeAttributes(outputFilePath + "/attributeList.txt");
+
+    if (stats.malformedLineCount > 0) {
+        jsonparser_logger.warn("Skipped " + to_string(stats.malformedLineCount) + " malformed lines of " +
+                               inputFilePath);
     }
-    return fieldsMap;
+    stats.totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return stats;
 }
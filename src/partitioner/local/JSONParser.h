@@ -28,9 +28,39 @@ limitations under the License.
 using std::string;
 using namespace std;
 
+struct JSONParseStats {
+    long byteCount = 0;
+    long lineCount = 0;
+    long malformedLineCount = 0;
+    long edgeCount = 0;
+    long vertexCount = 0;
+    int fieldCount = 0;
+    double parseSeconds = 0;      // Summed over the parser threads
+    double remapSeconds = 0;      // Vertex id remapping and writing the edge list
+    double attributeSeconds = 0;  // Selecting the fields and writing the attribute file
+    double totalSeconds = 0;
+};
+
+/**
+ * Converts a JSON lines citation dump (one paper per line with "id", "references" and "fos" fields of study) into an
+ * edge list of remapped vertex ids and a 0/1 attribute row of the frequent fields of study per vertex.
+ *
+ * The file is read once, in chunks that end at a line break. Threads parse the chunks with a scanner that only
+ * decodes the three fields it needs, and the main thread merges the parsed chunks in file order, so vertex ids are
+ * assigned in order of first appearance as before. The attribute rows are written from the parsed fields once the
+ * field counts of the whole file are known, without parsing the file again.
+ */
 class JSONParser {
  public:
+    // Fields of study weighted above this in more papers than FIELD_MIN_COUNT become attributes
+    static const double FIELD_MIN_WEIGHT;
+    static const int FIELD_MIN_COUNT;
+    static const size_t CHUNK_SIZE;
+
     static void jsonParse(string &inputFilePath);
+
+    // Writes edgelist.txt and attributeList.txt to the output directory
+    static JSONParseStats jsonParse(const string &inputFilePath, const string &outputFilePath, int threadCount);
 };
 
 #endif  // JASMINEGRAPH_JSONPARSER_H
@@ -15,8 +15,11 @@ limitations under the License.
 
 #include <flatbuffers/flatbuffers.h>
 
+#include <chrono>
+
 #include "../../util/Conts.h"
 #include "../../util/logger/Logger.h"
+#include "MultilevelPartitioner.h"
 
 Logger partitioner_logger;
 std::mutex partFileMutex;
@@ -141,17 +144,25 @@ void MetisPartitioner::loadDataSet(string inputFilePath, int graphID) {
     partitioner_logger.log("Processing dataset completed", "info");
 }
 
+bool MetisPartitioner::isInProcess() {
+    return Utils::getJasmineGraphProperty("org.jasminegraph.partitioner.metis.inprocess") != "false";
+}
+
 int MetisPartitioner::constructMetisFormat(string graph_type) {
     partitioner_logger.log("Constructing metis input format", "info");
     graphType = graph_type;
-    int adjacencyIndex = 0;
+    // The in-process partitioner takes the graph as CSR arrays, only gpmetis needs the graph file
+    bool inProcess = isInProcess();
     std::ofstream outputFile;
-    string outputFileName = this->outputFilePath + "/grf";
-    outputFile.open(outputFileName);
-
-    outputFile << (vertexCount) << ' ' << (edgeCountForMetis) << std::endl;
+    if (!inProcess) {
+        string outputFileName = this->outputFilePath + "/grf";
+        outputFile.open(outputFileName);
+        outputFile << (vertexCount) << ' ' << (edgeCountForMetis) << std::endl;
+    }
 
-    xadj.push_back(adjacencyIndex);
+    xadj.clear();
+    adjncy.clear();
+    xadj.push_back(0);
 
     for (int vertexNum = 0; vertexNum <= largestVertex; vertexNum++) {
         std::vector<int> vertexSet = graphStorageMap[vertexNum];
@@ -178,6 +189,13 @@ int MetisPartitioner::constructMetisFormat(string graph_type) {
         }
 
         for (std::vector<int>::const_iterator i = vertexSet.begin(); i != vertexSet.end(); ++i) {
+            if (inProcess) {
+                // Zero based CSR indexes, self loops never cross partitions
+                if (vertexNum != *i) {
+                    adjncy.push_back(zeroflag ? *i : *i - 1);
+                }
+                continue;
+            }
             // To handle zero vertex
             if (zeroflag) {
                 // To handle self loops
@@ -196,7 +214,11 @@ int MetisPartitioner::constructMetisFormat(string graph_type) {
             }
         }
 
-        outputFile << std::endl;
+        if (inProcess) {
+            xadj.push_back(adjncy.size());
+        } else {
+            outputFile << std::endl;
+        }
     }
     partitioner_logger.log("Constructing metis format completed", "info");
     return 1;
@@ -209,6 +231,9 @@ std::vector<std::map<int, std::string>> MetisPartitioner::partitioneWithGPMetis(
     } else {
         partitioner_logger.log("Using the default partition count " + partitionCount, "info");
     }
+    if (isInProcess()) {
+        return partitionInProcess();
+    }
 
     char buffer[128];
     std::string result = "";
@@ -285,20 +310,7 @@ std::vector<std::map<int, std::string>> MetisPartitioner::partitioneWithGPMetis(
                 }
             }
             partitioner_logger.log("Done partitioning with gpmetis", "info");
-            createPartitionFiles(partIndex);
-
-            string sqlStatement = "UPDATE graph SET vertexcount = '" + std::to_string(this->vertexCount) +
-                                  "' ,centralpartitioncount = '" + std::to_string(this->nParts) + "' ,edgecount = '" +
-                                  std::to_string(this->edgeCount) + "' WHERE idgraph = '" +
-                                  std::to_string(this->graphID) + "'";
-            this->sqlite->runUpdate(sqlStatement);
-            this->fullFileList.push_back(this->partitionFileList);
-            this->fullFileList.push_back(this->centralStoreFileList);
-            this->fullFileList.push_back(this->centralStoreDuplicateFileList);
-            this->fullFileList.push_back(this->partitionAttributeFileList);
-            this->fullFileList.push_back(this->centralStoreAttributeFileList);
-            this->fullFileList.push_back(this->compositeCentralStoreFileList);
-            return (this->fullFileList);
+            return completePartitioning(partIndex);
         }
     } else {
         perror("Popen error in executing gpmetis command");
@@ -306,6 +318,51 @@ std::vector<std::map<int, std::string>> MetisPartitioner::partitioneWithGPMetis(
     }
 }
 
+std::vector<std::map<int, std::string>> MetisPartitioner::partitionInProcess() {
+    double imbalance = MultilevelPartitioner::DEFAULT_IMBALANCE;
+    std::string imbalanceProperty = Utils::getJasmineGraphProperty("org.jasminegraph.partitioner.metis.imbalance");
+    if (!imbalanceProperty.empty() && imbalanceProperty != " ") {
+        imbalance = std::stod(imbalanceProperty);
+    }
+    int threadCount = std::max(1u, std::thread::hardware_concurrency());
+    partitioner_logger.info("Partitioning " + std::to_string(xadj.size() - 1) + " vertices into " +
+                            std::to_string(nParts) + " partitions in process");
+
+    auto start = std::chrono::steady_clock::now();
+    MultilevelPartitioner partitioner(nParts, imbalance, threadCount);
+    std::vector<int> parts = partitioner.partition(xadj, adjncy);
+    long elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    partitioner_logger.info("Done partitioning in " + std::to_string(elapsed) + " ms with an edge cut of " +
+                            std::to_string(MultilevelPartitioner::getEdgeCut(xadj, adjncy, parts)) + " and an " +
+                            "imbalance of " + std::to_string(MultilevelPartitioner::getImbalance(parts, nParts)));
+
+    // CSR index i is vertex i, or i + 1 for graphs that start from vertex 1
+    int firstVertex = zeroflag ? 0 : 1;
+    std::map<int, int> partIndex;
+    for (size_t i = 0; i < parts.size(); i++) {
+        partIndex[firstVertex + i] = parts[i];
+    }
+    return completePartitioning(partIndex);
+}
+
+std::vector<std::map<int, std::string>> MetisPartitioner::completePartitioning(std::map<int, int> partIndex) {
+    createPartitionFiles(partIndex);
+
+    string sqlStatement = "UPDATE graph SET vertexcount = '" + std::to_string(this->vertexCount) +
+                          "' ,centralpartitioncount = '" + std::to_string(this->nParts) + "' ,edgecount = '" +
+                          std::to_string(this->edgeCount) + "' WHERE idgraph = '" + std::to_string(this->graphID) +
+                          "'";
+    this->sqlite->runUpdate(sqlStatement);
+    this->fullFileList.push_back(this->partitionFileList);
+    this->fullFileList.push_back(this->centralStoreFileList);
+    this->fullFileList.push_back(this->centralStoreDuplicateFileList);
+    this->fullFileList.push_back(this->partitionAttributeFileList);
+    this->fullFileList.push_back(this->centralStoreAttributeFileList);
+    this->fullFileList.push_back(this->compositeCentralStoreFileList);
+    return (this->fullFileList);
+}
+
 void MetisPartitioner::createPartitionFiles(std::map<int, int> partMap) {
     std::vector<size_t> centralStoreSizeVector;
     std::vector<int> sortedPartVector;
@@ -313,8 +370,10 @@ void MetisPartitioner::createPartitionFiles(std::map<int, int> partMap) {
         partVertexCounts[partMap[i]]++;
     }
     partitioner_logger.log("Populating edge lists before writing to files", "info");
-    edgeMap = GetConfig::getEdgeMap();
-    articlesMap = GetConfig::getAttributesMap();
+    if (graphType == Conts::GRAPH_TYPE_RDF) {
+        edgeMap = GetConfig::getEdgeMap(graphID);
+        articlesMap = GetConfig::getAttributesMap(graphID);
+    }
 
     std::thread *threadList = new std::thread[nParts];
     int count = 0;
@@ -47,6 +47,8 @@ class MetisPartitioner {
     // void partitionGraph();
     int constructMetisFormat(string graph_type);
 
+    // Partition with the in-process multilevel partitioner, or with the gpmetis executable when
+    // org.jasminegraph.partitioner.metis.inprocess is false
     std::vector<std::map<int, std::string>> partitioneWithGPMetis(string partitionCount);
 
     // reformat the vertex list by mapping vertex values to new sequntial IDs
@@ -96,6 +98,12 @@ class MetisPartitioner {
     std::map<int, int> idToVertexMap;
     std::map<int, std::string> attributeDataMap;
 
+    static bool isInProcess();
+
+    std::vector<std::map<int, std::string>> partitionInProcess();
+
+    std::vector<std::map<int, std::string>> completePartitioning(std::map<int, int> partIndex);
+
     void createPartitionFiles(std::map<int, int> partMap);
 
     void populatePartMaps(std::map<int, int> partMap, int part);
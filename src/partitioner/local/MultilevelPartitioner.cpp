@@ -0,0 +1,381 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "MultilevelPartitioner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <thread>
+#include <utility>
+
+#include "../../util/logger/Logger.h"
+
+Logger multilevel_partitioner_logger;
+
+const double MultilevelPartitioner::DEFAULT_IMBALANCE = 1.03;
+
+// Coarsening stops at this many vertices per partition, or when a level shrinks the graph by less than 5%
+static const int COARSEST_VERTICES_PER_PART = 20;
+static const int MIN_COARSEST_VERTICES = 100;
+static const double MIN_COARSENING_RATIO = 0.95;
+static const int INITIAL_PARTITION_TRIES = 4;
+static const int MAX_REFINEMENT_PASSES = 8;
+// Contracting fewer coarse vertices than this per thread is not worth starting the threads
+static const int MIN_VERTICES_PER_THREAD = 10000;
+
+MultilevelPartitioner::MultilevelPartitioner(int partitionCount, double imbalance, int threadCount,
+                                             unsigned long seed)
+    : partitionCount(std::max(partitionCount, 1)),
+      imbalance(std::max(imbalance, 1.0)),
+      threadCount(std::max(threadCount, 1)),
+      seed(seed) {}
+
+std::vector<int> MultilevelPartitioner::partition(const std::vector<int> &xadj, const std::vector<int> &adjncy) {
+    int vertexCount = xadj.empty() ? 0 : xadj.size() - 1;
+    if (partitionCount == 1 || vertexCount == 0) {
+        return std::vector<int>(vertexCount, 0);
+    }
+
+    // Self loops never cross partitions, so they are left out
+    std::vector<Graph> levels(1);
+    Graph &graph = levels[0];
+    graph.xadj.push_back(0);
+    for (int v = 0; v < vertexCount; v++) {
+        for (int e = xadj[v]; e < xadj[v + 1]; e++) {
+            if (adjncy[e] != v) {
+                graph.adjncy.push_back(adjncy[e]);
+            }
+        }
+        graph.xadj.push_back(graph.adjncy.size());
+    }
+    graph.adjwgt.assign(graph.adjncy.size(), 1);
+    graph.vwgt.assign(vertexCount, 1);
+    graph.totalWeight = vertexCount;
+
+    int coarsestSize = std::max(COARSEST_VERTICES_PER_PART * partitionCount, MIN_COARSEST_VERTICES);
+    std::vector<std::vector<int>> coarseMaps;
+    while (levels.back().size() > coarsestSize) {
+        std::vector<int> coarseMap;
+        Graph coarse = coarsen(levels.back(), coarseMap, seed + levels.size());
+        if (coarse.size() > MIN_COARSENING_RATIO * levels.back().size()) {
+            break;
+        }
+        coarseMaps.push_back(std::move(coarseMap));
+        levels.push_back(std::move(coarse));
+    }
+    multilevel_partitioner_logger.info("Coarsened " + std::to_string(vertexCount) + " vertices to " +
+                                       std::to_string(levels.back().size()) + " in " +
+                                       std::to_string(coarseMaps.size()) + " levels");
+
+    const Graph &coarsest = levels.back();
+    long maxPartWeight = getMaxPartWeight(coarsest);
+    std::vector<int> parts;
+    long bestCut = -1;
+    bool bestBalanced = false;
+    for (int i = 0; i < INITIAL_PARTITION_TRIES; i++) {
+        std::vector<int> tryParts = growRegions(coarsest, seed * INITIAL_PARTITION_TRIES + i);
+        refine(coarsest, tryParts, seed + i);
+        std::vector<long> partWeights(partitionCount, 0);
+        for (int v = 0; v < coarsest.size(); v++) {
+            partWeights[tryParts[v]] += coarsest.vwgt[v];
+        }
+        bool balanced = *std::max_element(partWeights.begin(), partWeights.end()) <= maxPartWeight;
+        long cut = getWeightedEdgeCut(coarsest, tryParts);
+        if (bestCut < 0 || (balanced && !bestBalanced) || (balanced == bestBalanced && cut < bestCut)) {
+            parts = std::move(tryParts);
+            bestCut = cut;
+            bestBalanced = balanced;
+        }
+    }
+
+    for (int level = coarseMaps.size() - 1; level >= 0; level--) {
+        std::vector<int> fineParts(levels[level].size());
+        for (int v = 0; v < levels[level].size(); v++) {
+            fineParts[v] = parts[coarseMaps[level][v]];
+        }
+        refine(levels[level], fineParts, seed + level);
+        parts = std::move(fineParts);
+    }
+    return parts;
+}
+
+MultilevelPartitioner::Graph MultilevelPartitioner::coarsen(const Graph &graph, std::vector<int> &coarseMap,
+                                                            unsigned long levelSeed) {
+    int vertexCount = graph.size();
+    // Heavy vertices would make the coarsest graph impossible to balance
+    int coarsestSize = std::max(COARSEST_VERTICES_PER_PART * partitionCount, MIN_COARSEST_VERTICES);
+    long maxVertexWeight = std::max(1L, static_cast<long>(1.5 * graph.totalWeight / coarsestSize));
+
+    std::vector<int> order(vertexCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937_64(levelSeed));
+
+    // Match every vertex with the unmatched neighbour it shares the heaviest edge with
+    std::vector<int> match(vertexCount, -1);
+    for (int v : order) {
+        if (match[v] != -1) {
+            continue;
+        }
+        int matched = v;
+        int heaviest = -1;
+        for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+            int u = graph.adjncy[e];
+            if (match[u] == -1 && u != v && graph.vwgt[v] + graph.vwgt[u] <= maxVertexWeight &&
+                graph.adjwgt[e] > heaviest) {
+                matched = u;
+                heaviest = graph.adjwgt[e];
+            }
+        }
+        match[v] = matched;
+        match[matched] = v;
+    }
+
+    Graph coarse;
+    coarseMap.assign(vertexCount, -1);
+    std::vector<int> firstMember;
+    std::vector<int> secondMember;
+    for (int v = 0; v < vertexCount; v++) {
+        if (coarseMap[v] == -1) {
+            coarseMap[v] = coarseMap[match[v]] = firstMember.size();
+            firstMember.push_back(v);
+            secondMember.push_back(match[v] == v ? -1 : match[v]);
+            coarse.vwgt.push_back(graph.vwgt[v] + (match[v] == v ? 0 : graph.vwgt[match[v]]));
+        }
+    }
+    int coarseCount = firstMember.size();
+    coarse.totalWeight = graph.totalWeight;
+
+    // The adjacency of the coarse vertices is built in ranges, one per thread, and concatenated afterwards
+    int threads = std::max(1, std::min(threadCount, coarseCount / MIN_VERTICES_PER_THREAD));
+    std::vector<std::vector<int>> rangeAdjncy(threads);
+    std::vector<std::vector<int>> rangeAdjwgt(threads);
+    std::vector<int> degrees(coarseCount);
+    auto contract = [&](int thread) {
+        int begin = static_cast<long>(coarseCount) * thread / threads;
+        int end = static_cast<long>(coarseCount) * (thread + 1) / threads;
+        std::vector<int> &adjncy = rangeAdjncy[thread];
+        std::vector<int> &adjwgt = rangeAdjwgt[thread];
+        // Position of each coarse neighbour in adjncy, valid when it is at or after the start of the vertex
+        std::vector<int> position(coarseCount, -1);
+        for (int c = begin; c < end; c++) {
+            int start = adjncy.size();
+            for (int member : {firstMember[c], secondMember[c]}) {
+                if (member == -1) {
+                    continue;
+                }
+                for (int e = graph.xadj[member]; e < graph.xadj[member + 1]; e++) {
+                    int neighbour = coarseMap[graph.adjncy[e]];
+                    if (neighbour == c) {
+                        continue;
+                    }
+                    if (position[neighbour] >= start && adjncy[position[neighbour]] == neighbour) {
+                        adjwgt[position[neighbour]] += graph.adjwgt[e];
+                    } else {
+                        position[neighbour] = adjncy.size();
+                        adjncy.push_back(neighbour);
+                        adjwgt.push_back(graph.adjwgt[e]);
+                    }
+                }
+            }
+            degrees[c] = adjncy.size() - start;
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int thread = 1; thread < threads; thread++) {
+        workers.push_back(std::thread(contract, thread));
+    }
+    contract(0);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    coarse.xadj.push_back(0);
+    for (int c = 0; c < coarseCount; c++) {
+        coarse.xadj.push_back(coarse.xadj.back() + degrees[c]);
+    }
+    for (int thread = 0; thread < threads; thread++) {
+        coarse.adjncy.insert(coarse.adjncy.end(), rangeAdjncy[thread].begin(), rangeAdjncy[thread].end());
+        coarse.adjwgt.insert(coarse.adjwgt.end(), rangeAdjwgt[thread].begin(), rangeAdjwgt[thread].end());
+    }
+    return coarse;
+}
+
+std::vector<int> MultilevelPartitioner::growRegions(const Graph &graph, unsigned long trySeed) {
+    int vertexCount = graph.size();
+    std::vector<int> parts(vertexCount, -1);
+    std::vector<int> seeds(vertexCount);
+    std::iota(seeds.begin(), seeds.end(), 0);
+    std::shuffle(seeds.begin(), seeds.end(), std::mt19937_64(trySeed));
+    size_t nextSeed = 0;
+
+    // Connectivity of the unassigned vertices to the region being grown
+    std::vector<long> connectivity(vertexCount, 0);
+    long remainingWeight = graph.totalWeight;
+    for (int part = 0; part < partitionCount - 1; part++) {
+        double target = static_cast<double>(remainingWeight) / (partitionCount - part);
+        long weight = 0;
+        std::priority_queue<std::pair<long, int>> frontier;
+        while (weight < target) {
+            int v = -1;
+            while (!frontier.empty() && v == -1) {
+                std::pair<long, int> top = frontier.top();
+                frontier.pop();
+                if (parts[top.second] == -1 && connectivity[top.second] == top.first) {
+                    v = top.second;
+                }
+            }
+            // The region is a whole component, so it continues from a new seed
+            while (v == -1 && nextSeed < seeds.size()) {
+                if (parts[seeds[nextSeed]] == -1) {
+                    v = seeds[nextSeed];
+                }
+                nextSeed++;
+            }
+            if (v == -1) {
+                break;
+            }
+            parts[v] = part;
+            weight += graph.vwgt[v];
+            for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+                int u = graph.adjncy[e];
+                if (parts[u] == -1) {
+                    connectivity[u] += graph.adjwgt[e];
+                    frontier.push(std::make_pair(connectivity[u], u));
+                }
+            }
+        }
+        std::fill(connectivity.begin(), connectivity.end(), 0);
+        remainingWeight -= weight;
+    }
+    for (int v = 0; v < vertexCount; v++) {
+        if (parts[v] == -1) {
+            parts[v] = partitionCount - 1;
+        }
+    }
+    return parts;
+}
+
+long MultilevelPartitioner::getMaxPartWeight(const Graph &graph) {
+    double average = static_cast<double>(graph.totalWeight) / partitionCount;
+    int heaviest = graph.vwgt.empty() ? 0 : *std::max_element(graph.vwgt.begin(), graph.vwgt.end());
+    long bound = std::ceil(imbalance * average);
+    // A coarse graph can not be balanced more finely than the weight of its heaviest vertex
+    if (heaviest > 1) {
+        bound = std::max(bound, static_cast<long>(std::ceil(average)) + heaviest);
+    }
+    return bound;
+}
+
+void MultilevelPartitioner::refine(const Graph &graph, std::vector<int> &parts, unsigned long levelSeed) {
+    int vertexCount = graph.size();
+    long maxPartWeight = getMaxPartWeight(graph);
+    std::vector<long> partWeights(partitionCount, 0);
+    for (int v = 0; v < vertexCount; v++) {
+        partWeights[parts[v]] += graph.vwgt[v];
+    }
+
+    std::vector<int> order(vertexCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937_64(levelSeed));
+
+    std::vector<long> connectivity(partitionCount, 0);
+    std::vector<int> adjacentParts;
+    for (int pass = 0; pass < MAX_REFINEMENT_PASSES; pass++) {
+        int moves = 0;
+        for (int v : order) {
+            int from = parts[v];
+            adjacentParts.clear();
+            for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+                int part = parts[graph.adjncy[e]];
+                if (connectivity[part] == 0) {
+                    adjacentParts.push_back(part);
+                }
+                connectivity[part] += graph.adjwgt[e];
+            }
+
+            // Interior vertices only move out of a partition that is too heavy
+            bool overweight = partWeights[from] > maxPartWeight;
+            int to = -1;
+            for (int part : adjacentParts) {
+                if (part != from && partWeights[part] + graph.vwgt[v] <= maxPartWeight &&
+                    (to == -1 || connectivity[part] > connectivity[to] ||
+                     (connectivity[part] == connectivity[to] && partWeights[part] < partWeights[to]))) {
+                    to = part;
+                }
+            }
+            if (to == -1 && overweight) {
+                for (int part = 0; part < partitionCount; part++) {
+                    if (part != from && (to == -1 || partWeights[part] < partWeights[to])) {
+                        to = part;
+                    }
+                }
+            }
+
+            if (to != -1) {
+                long gain = connectivity[to] - connectivity[from];
+                if (gain > 0 || overweight ||
+                    (gain == 0 && partWeights[to] + graph.vwgt[v] < partWeights[from])) {
+                    parts[v] = to;
+                    partWeights[from] -= graph.vwgt[v];
+                    partWeights[to] += graph.vwgt[v];
+                    moves++;
+                }
+            }
+            for (int part : adjacentParts) {
+                connectivity[part] = 0;
+            }
+        }
+        if (moves == 0) {
+            break;
+        }
+    }
+}
+
+long MultilevelPartitioner::getWeightedEdgeCut(const Graph &graph, const std::vector<int> &parts) {
+    long cut = 0;
+    for (int v = 0; v < graph.size(); v++) {
+        for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+            if (parts[v] != parts[graph.adjncy[e]]) {
+                cut += graph.adjwgt[e];
+            }
+        }
+    }
+    return cut / 2;
+}
+
+long MultilevelPartitioner::getEdgeCut(const std::vector<int> &xadj, const std::vector<int> &adjncy,
+                                       const std::vector<int> &parts) {
+    long cut = 0;
+    for (size_t v = 0; v + 1 < xadj.size(); v++) {
+        for (int e = xadj[v]; e < xadj[v + 1]; e++) {
+            if (adjncy[e] > static_cast<int>(v) && parts[v] != parts[adjncy[e]]) {
+                cut++;
+            }
+        }
+    }
+    return cut;
+}
+
+double MultilevelPartitioner::getImbalance(const std::vector<int> &parts, int partitionCount) {
+    if (parts.empty()) {
+        return 1.0;
+    }
+    std::vector<long> sizes(partitionCount, 0);
+    for (int part : parts) {
+        sizes[part]++;
+    }
+    return *std::max_element(sizes.begin(), sizes.end()) * static_cast<double>(partitionCount) / parts.size();
+}
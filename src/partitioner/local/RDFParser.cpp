@@ -22,18 +22,26 @@ limitations under the License.
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <xercesc/sax/SAXParseException.hpp>
+#include <xercesc/util/TransService.hpp>
+
+#include "../../util/logger/Logger.h"
 
 using namespace xercesc;
 using namespace std;
 
+Logger rdf_parser_logger;
+
+static const int REFERENCE_DEPTH = 2;
+static const int PROPERTY_DEPTH = 3;
+// rdf:RDF > reference > akt:article-of-journal > akt:Journal > name
+static const int JOURNAL_NAME_DEPTH = 5;
+
 /**
  *  Constructor initializes xerces-C libraries.
  *  The XML tags and attributes which we seek are defined.
- *  The xerces-C DOM parser infrastructure is initialized.
+ *  The xerces-C SAX2 parser infrastructure is initialized.
  */
-static std::map<pair<int, int>, int> edgeMap;
-static std::map<long, string[7]> articlesMap;
-
 GetConfig::GetConfig() {
     try {
         XMLPlatformUtils::Initialize();  // Initialize Xerces infrastructure
@@ -45,7 +53,7 @@ GetConfig::GetConfig() {
 
     // Tags and attributes used in XML file.
     // Can't call transcode till after Xerces Initialize()
-    TAG_root = XMLString::transcode("root");
+    ATTR_about = XMLString::transcode("rdf:about");
     TAG_RDF = XMLString::transcode("rdf:RDF");
     TAG_has_author = XMLString::transcode("akt:has-author");
 
@@ -68,7 +76,8 @@ GetConfig::GetConfig() {
     TAG_Person = XMLString::transcode("akt:Person");
     TAG_full_name = XMLString::transcode("akt:full-name");
 
-    m_ConfigFileParser = new XercesDOMParser;
+    m_ConfigFileParser = XMLReaderFactory::createXMLReader();
+    writer = NULL;
 }
 
 /**
@@ -83,7 +92,7 @@ GetConfig::~GetConfig() {
     delete m_ConfigFileParser;
 
     try {
-        XMLString::release(&TAG_root);
+        XMLString::release(&ATTR_about);
 
         XMLString::release(&TAG_RDF);
         XMLString::release(&TAG_has_author);
@@ -121,18 +130,18 @@ GetConfig::~GetConfig() {
 
 /**
  *  This function:
- *  - Tests the access and availability of the XML configuration file.
- *  - Configures the xerces-c DOM parser.
- *  - Reads and extracts the pertinent information from the XML config file.
+ *  - Tests the access and availability of the RDF/XML file.
+ *  - Configures the xerces-c SAX2 parser.
+ *  - Streams the file through the element callbacks, which write the edges and article attributes to
+ *    getEdgeFilePath and getArticleFilePath.
  *
- *  @param in configFile The text string name of the HLA configuration file.
+ *  @param in configFile The text string name of the RDF/XML file.
  */
 
 void GetConfig::readConfigFile(string &configFile, int graphId) {
     /* throw(std::runtime_error) */
     struct stat fileStatus;
     this->graphID = graphId;
-    ofstream file;
 
     errno = 0;
     if (stat(configFile.c_str(), &fileStatus) == -1) {
@@ -148,202 +157,192 @@ void GetConfig::readConfigFile(string &configFile, int graphId) {
             throw(std::runtime_error("File can not be read\n"));
     }
 
-    // Configure DOM parser.
+    // Configure SAX2 parser.
+
+    m_ConfigFileParser->setFeature(XMLUni::fgSAX2CoreValidation, false);
+    m_ConfigFileParser->setFeature(XMLUni::fgSAX2CoreNameSpaces, false);
+    m_ConfigFileParser->setFeature(XMLUni::fgXercesSchema, false);
+    m_ConfigFileParser->setFeature(XMLUni::fgXercesLoadExternalDTD, false);
+    m_ConfigFileParser->setContentHandler(this);
+    m_ConfigFileParser->setErrorHandler(this);
 
-    m_ConfigFileParser->setValidationScheme(XercesDOMParser::Val_Never);
-    m_ConfigFileParser->setDoNamespaces(false);
-    m_ConfigFileParser->setDoSchema(false);
-    m_ConfigFileParser->setLoadExternalDTD(false);
+    Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/");
+    Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/tmp/");
+    Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/tmp/" + to_string(this->graphID));
+    RDFEdgeWriter edgeWriter(getEdgeFilePath(graphId), getArticleFilePath(graphId));
+    writer = &edgeWriter;
+    depth = 0;
+    inReference = false;
 
     try {
         m_ConfigFileParser->parse(configFile.c_str());
-        DOMDocument *xmlDoc = m_ConfigFileParser->getDocument();
-
-        DOMElement *elementRoot = xmlDoc->getDocumentElement();
-        if (!elementRoot) throw(std::runtime_error("empty XML document"));
-
-        DOMNodeList *children = elementRoot->getChildNodes();
-        const XMLSize_t nodeCount = children->getLength();
-
-        for (XMLSize_t xx = 0; xx < nodeCount; ++xx) {
-            std::vector<long> authorsInArticle;
-            long articleID;
-            string web_address;
-            string journal_name;
-            string year;
-            string month;
-            string title;
-            string type;
-            string volume;
-
-            DOMNode *currentNode = children->item(xx);
-            if (currentNode->getNodeType() &&  // is not NULL and is element
-                currentNode->getNodeType() == DOMNode::ELEMENT_NODE) {
-                // Found node which is an Element. Re-cast node as element
-                DOMElement *currentElement = dynamic_cast<xercesc::DOMElement *>(currentNode);
-                if (XMLString::equals(currentElement->getTagName(), TAG_Article_Reference) ||
-                    XMLString::equals(currentElement->getTagName(), TAG_Book_Reference) ||
-                    XMLString::equals(currentElement->getTagName(), TAG_Thesis_Reference) ||
-                    XMLString::equals(currentElement->getTagName(), TAG_Book_Section_Reference) ||
-                    XMLString::equals(currentElement->getTagName(), TAG_Conference_Proceedings_Reference)) {
-                    if (XMLString::equals(currentElement->getTagName(), TAG_Article_Reference)) {
-                        type = "0";
-                    } else if (XMLString::equals(currentElement->getTagName(), TAG_Book_Reference)) {
-                        type = "1";
-
-                    } else if (XMLString::equals(currentElement->getTagName(), TAG_Thesis_Reference)) {
-                        type = "2";
-                    } else if (XMLString::equals(currentElement->getTagName(), TAG_Book_Section_Reference)) {
-                        type = "3";
-
-                    } else if (XMLString::equals(currentElement->getTagName(), TAG_Conference_Proceedings_Reference)) {
-                        type = "4";
-                    }
-                    attributes[1] = type;
-
-                    DOMNodeList *children2 = currentElement->getChildNodes();
-                    const XMLSize_t nodeCount2 = children2->getLength();
-
-                    for (XMLSize_t xx2 = 0; xx2 < nodeCount2; ++xx2) {
-                        DOMNode *currentNode2 = children2->item(xx2);
-                        if (currentNode2->getNodeType() &&  // is not NULL and is element
-                            currentNode2->getNodeType() == DOMNode::ELEMENT_NODE) {
-                            DOMElement *currentElement2 = dynamic_cast<xercesc::DOMElement *>(currentNode2);
-                            if (XMLString::equals(currentElement2->getTagName(), TAG_has_author)) {
-                                DOMNode *child = currentElement2->getFirstElementChild();
-                                DOMElement *childElement = dynamic_cast<xercesc::DOMElement *>(child);
-                                DOMNode *author_name = childElement->getFirstElementChild();
-                                const XMLCh *author = author_name->getTextContent();
-                                Author_name = XMLString::transcode(author);
-                                long id = addToAuthors(&authors, Author_name);
-
-                                authorsInArticle.push_back(id);
-
-                            } else if (XMLString::equals(currentElement2->getTagName(), TAG_has_title)) {
-                                const XMLCh *paper = currentElement2->getTextContent();
-                                paper_title = XMLString::transcode(paper);
-                                long id = addToArticles(&articles, paper_title);
-                                articleID = id;
-                                attributes[0] = paper_title;
-
-                            } else if (XMLString::equals(currentElement2->getTagName(), TAG_article_of_journal)) {
-                                DOMNode *child = currentElement2->getFirstElementChild();
-                                DOMElement *childElement = dynamic_cast<xercesc::DOMElement *>(child);
-                                DOMNode *journalName = childElement->getFirstElementChild();
-                                const XMLCh *journal = journalName->getTextContent();
-                                journal_name = XMLString::transcode(journal);
-                                attributes[2] = journal_name;
-
-                            } else if (XMLString::equals(currentElement2->getTagName(), TAG_has_volume)) {
-                                const XMLCh *vol = currentElement2->getTextContent();
-
-                                volume = XMLString::transcode(vol);
-                                attributes[6] = volume;
-
-                            } else if (XMLString::equals(currentElement2->getTagName(), TAG_has_date)) {
-                                DOMNode *child = currentElement2->getFirstElementChild();
-                                DOMElement *childElement = dynamic_cast<xercesc::DOMElement *>(child);
-
-                                DOMNodeList *dateElements = childElement->getChildNodes();
-                                const XMLSize_t elementCount = dateElements->getLength();
-
-                                for (XMLSize_t e = 0; e < elementCount; ++e) {
-                                    DOMNode *dateEle = dateElements->item(e);
-                                    if (dateEle->getNodeType() &&  // is not null and is element
-                                        dateEle->getNodeType() == DOMNode::ELEMENT_NODE) {
-                                        DOMElement *currentDateElement = dynamic_cast<xercesc::DOMElement *>(dateEle);
-                                        if (XMLString::equals(currentDateElement->getTagName(), TAG_year_of)) {
-                                            const XMLCh *yearOf = currentDateElement->getTextContent();
-                                            year = XMLString::transcode(yearOf);
-                                            attributes[5] = year;
-
-                                        } else if (XMLString::equals(currentDateElement->getTagName(), TAG_month_of)) {
-                                            const XMLCh *monthOf = currentDateElement->getTextContent();
-                                            month = XMLString::transcode(monthOf);
-                                            attributes[4] = month;
-                                        }
-                                    }
-                                }
-
-                            } else if (XMLString::equals(currentElement2->getTagName(), TAG_has_web_address)) {
-                                const XMLCh *web_add = currentElement2->getTextContent();
-                                web_address = XMLString::transcode(web_add);
-                                attributes[3] = web_address;
-                            }
-                        }
-                    }
-                }
-
-                if (attributes->size() > 0) {
-                    // articlesMap.insert({articleID, attributes});
-                }
-                for (int i = 0; i < authorsInArticle.size(); i++) {
-                    for (int j = i + 1; j < authorsInArticle.size(); j++) {
-                        edgelist.push_back(make_pair(authorsInArticle.at(i), authorsInArticle.at(j)));
-                        addToEdges(&edgeMap, authorsInArticle.at(i), authorsInArticle.at(j), articleID);
-
-                        file << authorsInArticle.at(i) << ' ' << authorsInArticle.at(j);
-                    }
-                }
-
-                writeEdgesToFile();
-            }
-        }
-    } catch (xercesc::XMLException &e) {
+    } catch (const xercesc::SAXParseException &e) {
+        char *message = xercesc::XMLString::transcode(e.getMessage());
+        rdf_parser_logger.error("Error parsing file " + configFile + " at line " + to_string(e.getLineNumber()) +
+                                ": " + message);
+        XMLString::release(&message);
+    } catch (const xercesc::XMLException &e) {
         char *message = xercesc::XMLString::transcode(e.getMessage());
-        ostringstream errBuf;
-        errBuf << "Error parsing file: " << message << flush;
+        rdf_parser_logger.error("Error parsing file " + configFile + ": " + message);
         XMLString::release(&message);
     }
+
+    edgeWriter.close();
+    writer = NULL;
+    rdf_parser_logger.info("Read " + to_string(referenceCount) + " references with " + to_string(articles.size()) +
+                           " articles, " + to_string(authors.size()) + " authors and " +
+                           to_string(edgeWriter.getEdgeCount()) + " co-author edges");
 }
 
-void GetConfig::writeEdgesToFile() {
-    ofstream file;
-    Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/");
-    Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/tmp/");
-    Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/tmp/" + to_string(this->graphID));
-    file.open(Utils::getHomeDir() + "/.jasminegraph/tmp/" + std::to_string(this->graphID) + "/" +
-              std::to_string(this->graphID));
-    for (int i = 0; i < edgelist.size(); i++) {
-        file << edgelist[i].first << " " << edgelist[i].second << endl;
+void GetConfig::startElement(const XMLCh *const uri, const XMLCh *const localname, const XMLCh *const qname,
+                             const xercesc::Attributes &attrs) {
+    depth++;
+    if (depth == REFERENCE_DEPTH) {
+        const char *type = NULL;
+        if (XMLString::equals(qname, TAG_Article_Reference)) {
+            type = "0";
+        } else if (XMLString::equals(qname, TAG_Book_Reference)) {
+            type = "1";
+        } else if (XMLString::equals(qname, TAG_Thesis_Reference)) {
+            type = "2";
+        } else if (XMLString::equals(qname, TAG_Book_Section_Reference)) {
+            type = "3";
+        } else if (XMLString::equals(qname, TAG_Conference_Proceedings_Reference)) {
+            type = "4";
+        }
+        inReference = type != NULL;
+        if (!inReference) {
+            return;
+        }
+        for (int i = 0; i < RDFEdgeWriter::ATTRIBUTE_COUNT; i++) {
+            attributes[i].clear();
+        }
+        attributes[1] = type;
+        authorsInArticle.clear();
+        journalSeen = false;
+        textTag = NULL;
+        const XMLCh *aboutValue = attrs.getValue(ATTR_about);
+        about.clear();
+        if (aboutValue != NULL) {
+            char *value = XMLString::transcode(aboutValue);
+            about = value;
+            XMLString::release(&value);
+        }
+        return;
+    }
+    if (!inReference || textTag != NULL) {
+        return;
     }
 
-    file.close();
+    if (depth == PROPERTY_DEPTH) {
+        const XMLCh *properties[] = {TAG_has_author,  TAG_has_title,       TAG_article_of_journal,
+                                     TAG_has_volume,  TAG_has_web_address, TAG_has_date};
+        property = NULL;
+        for (const XMLCh *tag : properties) {
+            if (XMLString::equals(qname, tag)) {
+                property = tag;
+            }
+        }
+        if (property == TAG_has_title || property == TAG_has_volume || property == TAG_has_web_address) {
+            startText(property);
+        }
+    } else if (property == TAG_has_author && XMLString::equals(qname, TAG_full_name)) {
+        startText(TAG_full_name);
+    } else if (property == TAG_article_of_journal && depth == JOURNAL_NAME_DEPTH && !journalSeen) {
+        journalSeen = true;
+        startText(TAG_Journal);
+    } else if (property == TAG_has_date && XMLString::equals(qname, TAG_year_of)) {
+        startText(TAG_year_of);
+    } else if (property == TAG_has_date && XMLString::equals(qname, TAG_month_of)) {
+        startText(TAG_month_of);
+    }
 }
 
-long GetConfig::addToAuthors(std::map<string, long> *map, string name) {
-    long id;
-    id = map->size() + 1;
+void GetConfig::endElement(const XMLCh *const uri, const XMLCh *const localname, const XMLCh *const qname) {
+    if (textTag != NULL && depth == textDepth) {
+        endText();
+    }
+    if (depth == PROPERTY_DEPTH) {
+        property = NULL;
+    } else if (depth == REFERENCE_DEPTH && inReference) {
+        endReference();
+        inReference = false;
+    }
+    depth--;
+}
 
-    auto search = map->find(name);
-    if (search != map->end()) {
-        return search->second;
+void GetConfig::characters(const XMLCh *const chars, const XMLSize_t length) {
+    if (textTag == NULL) {
+        return;
     }
+    xercesc::TranscodeToStr utf8(chars, length, "UTF-8");
+    text.append(reinterpret_cast<const char *>(utf8.str()), utf8.length());
+}
 
-    authorsTemp.insert({id, name});
+void GetConfig::fatalError(const xercesc::SAXParseException &exception) { throw exception; }
 
-    map->insert({name, id});
-    return id;
+void GetConfig::startText(const XMLCh *tag) {
+    textTag = tag;
+    textDepth = depth;
+    text.clear();
 }
 
-long GetConfig::addToArticles(std::map<string, long> *map, string URI) {
-    long id;
-    id = map->size();
-    auto search = map->find(URI);
-    if (search != map->end()) {
-        return search->second;
+void GetConfig::endText() {
+    string value = Utils::trim_copy(text);
+    if (textTag == TAG_full_name) {
+        if (!value.empty()) {
+            authorsInArticle.push_back(authors.getId(value));
+        }
+    } else if (textTag == TAG_has_title) {
+        attributes[0] = value;
+    } else if (textTag == TAG_Journal) {
+        attributes[2] = value;
+    } else if (textTag == TAG_has_web_address) {
+        attributes[3] = value;
+    } else if (textTag == TAG_month_of) {
+        attributes[4] = value;
+    } else if (textTag == TAG_year_of) {
+        attributes[5] = value;
+    } else if (textTag == TAG_has_volume) {
+        attributes[6] = value;
     }
+    textTag = NULL;
+}
 
-    articlesTemp.insert({id, URI});
+void GetConfig::endReference() {
+    referenceCount++;
+    // Articles are identified by their title as before, and untitled ones by their resource IRI or position
+    string key = attributes[0];
+    if (key.empty()) {
+        key = about.empty() ? "#" + to_string(referenceCount) : about;
+    }
+    bool added;
+    long articleID = articles.getId(key.data(), key.size(), added);
+    if (added) {
+        writer->addAttributes(articleID, attributes);
+    }
 
-    map->insert({URI, id});
-    return id;
+    for (size_t i = 0; i < authorsInArticle.size(); i++) {
+        for (size_t j = i + 1; j < authorsInArticle.size(); j++) {
+            writer->addEdge(authorsInArticle[i], authorsInArticle[j], articleID);
+        }
+    }
 }
 
-void GetConfig::addToEdges(std::map<pair<int, int>, int> *map, long node_1, long node_2, long article_id) {
-    map->insert({{node_1, node_2}, article_id});
+string GetConfig::getEdgeFilePath(int graphId) {
+    return Utils::getHomeDir() + "/.jasminegraph/tmp/" + to_string(graphId) + "/" + to_string(graphId);
 }
 
-std::map<std::pair<int, int>, int> GetConfig::getEdgeMap() { return edgeMap; }
+string GetConfig::getArticleFilePath(int graphId) { return getEdgeFilePath(graphId) + "_articles"; }
+
+std::map<std::pair<int, int>, int> GetConfig::getEdgeMap(int graphId) {
+    std::map<std::pair<int, int>, int> edgeMap;
+    RDFEdgeWriter::readEdgeLabels(getEdgeFilePath(graphId), edgeMap);
+    return edgeMap;
+}
 
-std::map<long, string[7]> GetConfig::getAttributesMap() { return articlesMap; }
+std::map<long, string[7]> GetConfig::getAttributesMap(int graphId) {
+    std::map<long, string[7]> articlesMap;
+    RDFEdgeWriter::readAttributes(getArticleFilePath(graphId), articlesMap);
+    return articlesMap;
+}
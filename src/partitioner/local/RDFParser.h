@@ -16,26 +16,19 @@ limitations under the License.
 
 #include <fstream>
 #include <iostream>
-#include <list>
 #include <map>
 #include <stdexcept>
 #include <string>
 #include <vector>
-#include <xercesc/dom/DOM.hpp>
-#include <xercesc/dom/DOMDocument.hpp>
-#include <xercesc/dom/DOMDocumentType.hpp>
-#include <xercesc/dom/DOMElement.hpp>
-#include <xercesc/dom/DOMImplementation.hpp>
-#include <xercesc/dom/DOMImplementationLS.hpp>
-#include <xercesc/dom/DOMNode.hpp>
-#include <xercesc/dom/DOMNodeIterator.hpp>
-#include <xercesc/dom/DOMNodeList.hpp>
-#include <xercesc/dom/DOMText.hpp>
-#include <xercesc/parsers/XercesDOMParser.hpp>
+#include <xercesc/sax2/Attributes.hpp>
+#include <xercesc/sax2/DefaultHandler.hpp>
+#include <xercesc/sax2/SAX2XMLReader.hpp>
+#include <xercesc/sax2/XMLReaderFactory.hpp>
 #include <xercesc/util/PlatformUtils.hpp>
 #include <xercesc/util/XMLUni.hpp>
 
 #include "../../util/Utils.h"
+#include "RDFStreamReader.h"
 
 using std::string;
 using namespace std;
@@ -44,7 +37,13 @@ using namespace std;
 
 enum { ERROR_ARGS = 1, ERROR_XERCES_INIT, ERROR_PARSE, ERROR_EMPTY_DOCUMENT };
 
-class GetConfig {
+/**
+ * Reads an RDF/XML bibliographic dump (AKT ontology) with the Xerces SAX2 parser. Co-authors of an article are
+ * linked by an edge labelled with the article, and the edges and article attributes are written to the partitioner
+ * input as each reference element ends. Only one reference and the author and article dictionaries are held in
+ * memory, so the size of the dump is not limited by the memory of the master.
+ */
+class GetConfig : public xercesc::DefaultHandler {
  public:
     GetConfig();
 
@@ -52,37 +51,32 @@ class GetConfig {
 
     void readConfigFile(std::string &, int id) /* throw(std::runtime_error) */;
 
-    char *getOptionA() { return m_OptionA; };
+    void startElement(const XMLCh *const uri, const XMLCh *const localname, const XMLCh *const qname,
+                      const xercesc::Attributes &attrs) override;
 
-    char *getOptionB() { return m_OptionB; };
+    void endElement(const XMLCh *const uri, const XMLCh *const localname, const XMLCh *const qname) override;
 
-    void writeEdgesToFile();
+    void characters(const XMLCh *const chars, const XMLSize_t length) override;
 
-    long addToAuthors(std::map<std::string, long> *map, std::string URI);
+    void fatalError(const xercesc::SAXParseException &exception) override;
 
-    void addToEdges(std::map<pair<int, int>, int> *map, long node_1, long node_2, long article_id);
+    // Edge list of a graph written by readConfigFile, one "author author article" line per co-author pair
+    static std::string getEdgeFilePath(int graphId);
 
-    long addToArticles(std::map<std::string, long> *map, std::string URI);
+    static std::string getArticleFilePath(int graphId);
 
-    static std::map<std::pair<int, int>, int> getEdgeMap();
+    static std::map<std::pair<int, int>, int> getEdgeMap(int graphId);
 
-    static std::map<long, string[7]> getAttributesMap();
+    static std::map<long, string[7]> getAttributesMap(int graphId);
 
  private:
     int graphID;
-    xercesc::XercesDOMParser *m_ConfigFileParser;
-    char *m_OptionA;
-    char *m_OptionB;
-    char *Author_name;
-    char *paper_title;
+    xercesc::SAX2XMLReader *m_ConfigFileParser;
+    RDFEdgeWriter *writer;
 
     // Internal class use only. Hold Xerces data in UTF-16 SMLCh type.
 
-    XMLCh *TAG_root;
-
-    XMLCh *TAG_ApplicationSettings;
-    XMLCh *ATTR_OptionA;
-    XMLCh *ATTR_OptionB;
+    XMLCh *ATTR_about;
 
     XMLCh *TAG_has_author;
     XMLCh *TAG_has_title;
@@ -105,14 +99,27 @@ class GetConfig {
     XMLCh *TAG_full_name;
     XMLCh *TAG_Person;
 
-    std::map<string, long> authors;
-    vector<pair<int, int> > edgelist;
+    RDFDictionary authors{1};
+    RDFDictionary articles;
+
+    // Parser state within the current reference element
+    int depth = 0;
+    long referenceCount = 0;
+    bool inReference = false;
+    const XMLCh *property = NULL;
+    const XMLCh *textTag = NULL;
+    int textDepth = 0;
+    bool journalSeen = false;
+    string text;
+    string about;
+    std::vector<long> authorsInArticle;
+    string attributes[RDFEdgeWriter::ATTRIBUTE_COUNT];
+
+    void startText(const XMLCh *tag);
+
+    void endText();
 
-    std::map<long, string> authorsTemp;
-    std::map<string, long> articles;
-    std::map<long, string> articlesTemp;
-    // std::map<long, string[7]> articlesMap;
-    string attributes[7];
+    void endReference();
 };
 
 #endif  // JASMINEGRAPH_RDFPARSER_H
@@ -0,0 +1,336 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "RDFStreamReader.h"
+
+#include <sstream>
+#include <stdexcept>
+
+#include "../../util/logger/Logger.h"
+
+Logger rdf_stream_logger;
+
+uint64_t RDFDictionary::hash(const char *term, size_t length) {
+    // FNV-1a, finished with the splitmix64 mixer so that the low bits used by the hash table are well spread
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        h ^= static_cast<unsigned char>(term[i]);
+        h *= 1099511628211ULL;
+    }
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+}
+
+uint64_t RDFDictionary::checkHash(const char *term, size_t length) {
+    // FNV-1a from a different offset basis, finished with the murmur3 mixer
+    uint64_t h = 0x84222325cbf29ce4ULL;
+    for (size_t i = 0; i < length; i++) {
+        h ^= static_cast<unsigned char>(term[i]);
+        h *= 1099511628211ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    return h ^ (h >> 33);
+}
+
+long RDFDictionary::getId(const char *term, size_t length, bool &added) {
+    uint64_t check = checkHash(term, length);
+    auto inserted =
+        ids.insert(std::make_pair(hash(term, length), std::make_pair(firstId + static_cast<long>(ids.size()), check)));
+    added = inserted.second;
+    if (!added && inserted.first->second.second != check) {
+        throw std::runtime_error("RDF term " + std::string(term, length) + " collides with the term of id " +
+                                 std::to_string(inserted.first->second.first));
+    }
+    return inserted.first->second.first;
+}
+
+size_t RDFDictionary::getMemoryBytes() const {
+    // A node holds the next pointer and the key value pair
+    return ids.size() * (sizeof(void *) + sizeof(std::pair<const uint64_t, std::pair<long, uint64_t>>)) +
+           ids.bucket_count() * sizeof(void *);
+}
+
+RDFEdgeWriter::RDFEdgeWriter(const std::string &edgeFilePath, const std::string &attributeFilePath)
+    : edgeFile(edgeFilePath) {
+    if (!edgeFile.is_open()) {
+        rdf_stream_logger.error("Could not open the edge file " + edgeFilePath);
+    }
+    if (!attributeFilePath.empty()) {
+        attributeFile.open(attributeFilePath);
+        if (!attributeFile.is_open()) {
+            rdf_stream_logger.error("Could not open the attribute file " + attributeFilePath);
+        }
+    }
+}
+
+void RDFEdgeWriter::addEdge(long source, long destination, long label) {
+    edgeFile << source << ' ' << destination << ' ' << label << '\n';
+    edgeCount++;
+}
+
+void RDFEdgeWriter::addAttributes(long label, const std::string attributes[ATTRIBUTE_COUNT]) {
+    if (!attributeFile.is_open()) {
+        return;
+    }
+    attributeFile << label;
+    for (int i = 0; i < ATTRIBUTE_COUNT; i++) {
+        attributeFile << '\t';
+        writeField(attributes[i]);
+    }
+    attributeFile << '\n';
+    labelCount++;
+}
+
+void RDFEdgeWriter::addLiteral(long vertex, long predicate, const std::string &value) {
+    if (!attributeFile.is_open()) {
+        return;
+    }
+    attributeFile << vertex << '\t' << predicate << '\t';
+    writeField(value);
+    attributeFile << '\n';
+    literalCount++;
+}
+
+void RDFEdgeWriter::writeField(const std::string &value) {
+    for (char c : value) {
+        // Tabs and line breaks would split the record
+        attributeFile << (c == '\t' || c == '\n' || c == '\r' ? ' ' : c);
+    }
+}
+
+void RDFEdgeWriter::close() {
+    if (edgeFile.is_open()) {
+        edgeFile.close();
+    }
+    if (attributeFile.is_open()) {
+        attributeFile.close();
+    }
+}
+
+bool RDFEdgeWriter::readEdgeLabels(const std::string &edgeFilePath,
+                                   std::map<std::pair<int, int>, int> &edgeLabels) {
+    std::ifstream input(edgeFilePath);
+    if (!input.is_open()) {
+        rdf_stream_logger.error("Could not open the edge file " + edgeFilePath);
+        return false;
+    }
+    std::string line;
+    while (std::getline(input, line)) {
+        std::istringstream fields(line);
+        int source;
+        int destination;
+        int label;
+        if (fields >> source >> destination >> label) {
+            edgeLabels.insert({{source, destination}, label});
+        }
+    }
+    return true;
+}
+
+bool RDFEdgeWriter::readAttributes(const std::string &attributeFilePath,
+                                   std::map<long, std::string[ATTRIBUTE_COUNT]> &attributes) {
+    std::ifstream input(attributeFilePath);
+    if (!input.is_open()) {
+        rdf_stream_logger.error("Could not open the attribute file " + attributeFilePath);
+        return false;
+    }
+    std::string line;
+    while (std::getline(input, line)) {
+        size_t end = line.find('\t');
+        if (end == std::string::npos) {
+            continue;
+        }
+        long label = std::stol(line.substr(0, end));
+        if (attributes.count(label) > 0) {
+            continue;
+        }
+        std::string *values = attributes[label];
+        for (int i = 0; i < ATTRIBUTE_COUNT && end != std::string::npos; i++) {
+            size_t start = end + 1;
+            end = line.find('\t', start);
+            values[i] = line.substr(start, end == std::string::npos ? std::string::npos : end - start);
+        }
+    }
+    return true;
+}
+
+bool RDFEdgeWriter::readLiterals(const std::string &attributeFilePath,
+                                 std::map<long, std::vector<std::pair<long, std::string>>> &literals) {
+    std::ifstream input(attributeFilePath);
+    if (!input.is_open()) {
+        rdf_stream_logger.error("Could not open the attribute file " + attributeFilePath);
+        return false;
+    }
+    std::string line;
+    while (std::getline(input, line)) {
+        size_t vertexEnd = line.find('\t');
+        size_t predicateEnd = vertexEnd == std::string::npos ? std::string::npos : line.find('\t', vertexEnd + 1);
+        if (predicateEnd == std::string::npos) {
+            continue;
+        }
+        long vertex = std::stol(line.substr(0, vertexEnd));
+        long predicate = std::stol(line.substr(vertexEnd + 1, predicateEnd - vertexEnd - 1));
+        literals[vertex].push_back(std::make_pair(predicate, line.substr(predicateEnd + 1)));
+    }
+    return true;
+}
+
+static void skipSpaces(const std::string &line, size_t &position) {
+    while (position < line.size() && (line[position] == ' ' || line[position] == '\t')) {
+        position++;
+    }
+}
+
+// An IRI or a blank node label
+static bool parseResource(const std::string &line, size_t &position, std::string &term) {
+    if (position >= line.size()) {
+        return false;
+    }
+    if (line[position] == '<') {
+        size_t end = line.find('>', position + 1);
+        if (end == std::string::npos) {
+            return false;
+        }
+        term.assign(line, position + 1, end - position - 1);
+        position = end + 1;
+        return true;
+    }
+    if (line.compare(position, 2, "_:") == 0) {
+        size_t end = position + 2;
+        while (end < line.size() && line[end] != ' ' && line[end] != '\t' && line[end] != '.') {
+            end++;
+        }
+        if (end == position + 2) {
+            return false;
+        }
+        term.assign(line, position, end - position);
+        position = end;
+        return true;
+    }
+    return false;
+}
+
+static bool parseLiteral(const std::string &line, size_t &position, std::string &term) {
+    term.clear();
+    size_t i = position + 1;
+    for (; i < line.size() && line[i] != '"'; i++) {
+        if (line[i] != '\\') {
+            term.push_back(line[i]);
+            continue;
+        }
+        if (++i == line.size()) {
+            return false;
+        }
+        switch (line[i]) {
+            case 't':
+                term.push_back('\t');
+                break;
+            case 'n':
+                term.push_back('\n');
+                break;
+            case 'r':
+                term.push_back('\r');
+                break;
+            default:
+                // \" and \\, and the \u escapes which are kept as they are
+                if (line[i] == 'u' || line[i] == 'U') {
+                    term.push_back('\\');
+                }
+                term.push_back(line[i]);
+        }
+    }
+    if (i == line.size()) {
+        return false;
+    }
+    position = i + 1;
+    if (position < line.size() && line[position] == '@') {
+        while (position < line.size() && line[position] != ' ' && line[position] != '\t' && line[position] != '.') {
+            position++;
+        }
+    } else if (line.compare(position, 2, "^^") == 0) {
+        position += 2;
+        std::string datatype;
+        return parseResource(line, position, datatype);
+    }
+    return true;
+}
+
+bool RDFStreamReader::parseStatement(const std::string &line, std::string &subject, std::string &predicate,
+                                     std::string &object, bool &objectIsLiteral) {
+    size_t position = 0;
+    skipSpaces(line, position);
+    if (!parseResource(line, position, subject)) {
+        return false;
+    }
+    skipSpaces(line, position);
+    if (position >= line.size() || line[position] != '<' || !parseResource(line, position, predicate)) {
+        return false;
+    }
+    skipSpaces(line, position);
+    objectIsLiteral = position < line.size() && line[position] == '"';
+    if (objectIsLiteral ? !parseLiteral(line, position, object) : !parseResource(line, position, object)) {
+        return false;
+    }
+    skipSpaces(line, position);
+    return position < line.size() && line[position] == '.';
+}
+
+long RDFStreamReader::readNTriples(std::istream &input) {
+    std::string line;
+    std::string subject;
+    std::string predicate;
+    std::string object;
+    bool objectIsLiteral;
+    bool added;
+    long statementCount = 0;
+
+    while (std::getline(input, line)) {
+        if (!parseStatement(line, subject, predicate, object, objectIsLiteral)) {
+            size_t first = line.find_first_not_of(" \t\r");
+            if (first != std::string::npos && line[first] != '#') {
+                malformedCount++;
+            }
+            continue;
+        }
+        statementCount++;
+        if (objectIsLiteral) {
+            literalCount++;
+            writer.addLiteral(vertices.getId(subject.data(), subject.size(), added),
+                              predicates.getId(predicate.data(), predicate.size(), added), object);
+            continue;
+        }
+        long source = vertices.getId(subject.data(), subject.size(), added);
+        long destination = vertices.getId(object.data(), object.size(), added);
+        writer.addEdge(source, destination, predicates.getId(predicate.data(), predicate.size(), added));
+    }
+
+    if (malformedCount > 0) {
+        rdf_stream_logger.warn("Skipped " + std::to_string(malformedCount) + " malformed N-Triples statements");
+    }
+    return statementCount;
+}
+
+long RDFStreamReader::readNTriples(const std::string &inputFilePath) {
+    std::ifstream input(inputFilePath);
+    if (!input.is_open()) {
+        rdf_stream_logger.error("Could not open the N-Triples file " + inputFilePath);
+        return 0;
+    }
+    return readNTriples(input);
+}
@@ -0,0 +1,149 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_RDFSTREAMREADER_H
+#define JASMINEGRAPH_RDFSTREAMREADER_H
+
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Dense ids for the terms of an RDF graph (IRIs, blank nodes, author names or article titles). Only two independent
+ * 64 bit hashes of each term are kept, so the dictionary grows with the number of distinct terms but not with their
+ * length, and the terms themselves never have to be held in memory. The first hash is the key of the table and the
+ * second one tells apart terms that share it: such a collision, about 3% likely with a billion distinct terms, throws
+ * a std::runtime_error instead of silently merging the two terms into one vertex.
+ */
+class RDFDictionary {
+ public:
+    explicit RDFDictionary(long firstId = 0) : firstId(firstId) {}
+
+    // The id of the term, assigning the next free id when the term is new. Throws std::runtime_error when the term
+    // collides with another one.
+    long getId(const char *term, size_t length, bool &added);
+
+    long getId(const std::string &term) {
+        bool added;
+        return getId(term.data(), term.size(), added);
+    }
+
+    size_t size() const { return ids.size(); }
+
+    // Approximate heap usage of the hash table
+    size_t getMemoryBytes() const;
+
+    static uint64_t hash(const char *term, size_t length);
+
+    // A hash of the term independent of hash(), to detect terms that share it
+    static uint64_t checkHash(const char *term, size_t length);
+
+ private:
+    long firstId;
+    std::unordered_map<uint64_t, std::pair<long, uint64_t>> ids;  // hash to the id and check hash of the term
+};
+
+/**
+ * Writes a parsed RDF graph straight into the partitioner input. Every edge is a "source destination label" line of
+ * the edge list that MetisPartitioner::loadDataSet reads, and the attributes of a label (an article of a
+ * bibliographic dump) are one tab separated line of the attribute file, so nothing but the dictionaries of the
+ * parser grows with the input. The literals of N-Triples vertices go to the attribute file as one tab separated
+ * "vertex predicate value" line each.
+ */
+class RDFEdgeWriter {
+ public:
+    static const int ATTRIBUTE_COUNT = 7;
+
+    // An empty attribute file path writes the edges only
+    RDFEdgeWriter(const std::string &edgeFilePath, const std::string &attributeFilePath);
+
+    ~RDFEdgeWriter() { close(); }
+
+    bool isOpen() const { return edgeFile.is_open(); }
+
+    void addEdge(long source, long destination, long label);
+
+    void addAttributes(long label, const std::string attributes[ATTRIBUTE_COUNT]);
+
+    void addLiteral(long vertex, long predicate, const std::string &value);
+
+    void close();
+
+    long getEdgeCount() const { return edgeCount; }
+
+    long getLabelCount() const { return labelCount; }
+
+    long getLiteralCount() const { return literalCount; }
+
+    // Read back the label of every edge of an edge file. The first label of an edge is kept.
+    static bool readEdgeLabels(const std::string &edgeFilePath, std::map<std::pair<int, int>, int> &edgeLabels);
+
+    static bool readAttributes(const std::string &attributeFilePath,
+                               std::map<long, std::string[ATTRIBUTE_COUNT]> &attributes);
+
+    // The predicate and value of every literal of a vertex, in the order they were written
+    static bool readLiterals(const std::string &attributeFilePath,
+                             std::map<long, std::vector<std::pair<long, std::string>>> &literals);
+
+ private:
+    void writeField(const std::string &value);
+
+    std::ofstream edgeFile;
+    std::ofstream attributeFile;
+    long edgeCount = 0;
+    long labelCount = 0;
+    long literalCount = 0;
+};
+
+/**
+ * Streaming reader of N-Triples, one statement per line. Subjects and objects that are IRIs or blank nodes become
+ * dictionary encoded vertices and each statement between them an edge labelled with the id of its predicate.
+ * Statements with a literal object describe their subject rather than linking two vertices and are written to the
+ * attribute file of the writer as a literal of the subject.
+ */
+class RDFStreamReader {
+ public:
+    explicit RDFStreamReader(RDFEdgeWriter &writer) : writer(writer) {}
+
+    // Split an N-Triples line into its terms. IRIs are returned without the angle brackets and literals without
+    // the quotes, escapes, language tag or datatype. False for blank lines, comments and malformed statements.
+    static bool parseStatement(const std::string &line, std::string &subject, std::string &predicate,
+                               std::string &object, bool &objectIsLiteral);
+
+    // The number of statements read. Throws std::runtime_error when two terms collide in a dictionary.
+    long readNTriples(std::istream &input);
+
+    long readNTriples(const std::string &inputFilePath);
+
+    long getLiteralCount() const { return literalCount; }
+
+    long getMalformedCount() const { return malformedCount; }
+
+    const RDFDictionary &getVertices() const { return vertices; }
+
+    const RDFDictionary &getPredicates() const { return predicates; }
+
+ private:
+    RDFEdgeWriter &writer;
+    RDFDictionary vertices;
+    RDFDictionary predicates;
+    long literalCount = 0;
+    long malformedCount = 0;
+};
+
+#endif  // JASMINEGRAPH_RDFSTREAMREADER_H
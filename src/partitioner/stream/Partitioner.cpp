@@ -205,7 +205,6 @@ partitionedEdge Partitioner::fennelPartitioning(std::pair<std::string, std::stri
  **/
 std::pair<long, long> Partitioner::deserialize(std::string data) {
     std::vector<std::string> v = Partition::_split(data, ' ');
-    streaming_partitioner_logger.debug("Vertext/Node 1 = " + stoi(v[0]));
-    streaming_partitioner_logger.debug("Vertext/Node 2 = " + stoi(v[1]));
+    JG_LOG_DEBUG(streaming_partitioner_logger, "Vertext/Node 1 = {}, Vertext/Node 2 = {}", v[0], v[1]);
     return {stoi(v[0]), stoi(v[1])};
 }
@@ -0,0 +1,292 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "MetricsRegistry.h"
+
+#include <climits>
+#include <cmath>
+#include <sstream>
+
+#include "../../util/logger/Logger.h"
+
+Logger metrics_logger;
+
+std::mutex MetricsRegistry::registryMutex;
+std::map<std::string, MetricsRegistry::Family> MetricsRegistry::families;
+std::map<std::string, MetricsRegistry::Family> MetricsRegistry::detachedFamilies;
+
+static std::atomic<int> nextShard(0);
+
+Counter::Counter() { reset(); }
+
+int Counter::getShardIndex() {
+    static thread_local int shardIndex = nextShard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+    return shardIndex;
+}
+
+long Counter::value() const {
+    long total = 0;
+    for (int i = 0; i < SHARD_COUNT; i++) {
+        total += shards[i].value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Counter::reset() {
+    for (int i = 0; i < SHARD_COUNT; i++) {
+        shards[i].value.store(0, std::memory_order_relaxed);
+    }
+}
+
+Histogram::Histogram() { reset(); }
+
+int Histogram::getBucketIndex(long value) {
+    if (value < SUB_BUCKET_COUNT) {
+        return value < 0 ? 0 : static_cast<int>(value);
+    }
+    int highestBit = 63 - __builtin_clzl(static_cast<unsigned long>(value));
+    int shift = highestBit - SUB_BUCKET_BITS;
+    int subBucket = static_cast<int>(value >> shift) - SUB_BUCKET_COUNT;
+    return SUB_BUCKET_COUNT + shift * SUB_BUCKET_COUNT + subBucket;
+}
+
+long Histogram::getBucketUpperBound(int index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    int shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT;
+    unsigned long subBucket = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_COUNT;
+    unsigned long upperBound = ((SUB_BUCKET_COUNT + subBucket + 1) << shift) - 1;
+    return upperBound > LONG_MAX ? LONG_MAX : static_cast<long>(upperBound);
+}
+
+void Histogram::record(long value) {
+    if (value < 0) {
+        value = 0;
+    }
+    buckets[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+    long currentMax = max.load(std::memory_order_relaxed);
+    while (value > currentMax && !max.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {
+    }
+}
+
+long Histogram::percentile(double quantile) const {
+    long total = getCount();
+    if (total == 0) {
+        return 0;
+    }
+    long rank = static_cast<long>(std::ceil(quantile * total));
+    if (rank < 1) {
+        rank = 1;
+    }
+    long seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            long upperBound = getBucketUpperBound(i);
+            long recordedMax = getMax();
+            return upperBound < recordedMax ? upperBound : recordedMax;
+        }
+    }
+    return getMax();
+}
+
+void Histogram::reset() {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+static const char *getTypeName(int type) {
+    switch (type) {
+        case 0:
+            return "counter";
+        case 1:
+            return "gauge";
+        default:
+            return "summary";
+    }
+}
+
+MetricsRegistry::Family *MetricsRegistry::getFamily(const std::string &name, const std::string &help,
+                                                    MetricType type) {
+    auto existing = families.find(name);
+    if (existing == families.end()) {
+        Family &family = families[name];
+        family.type = type;
+        family.help = help;
+        return &family;
+    }
+    if (existing->second.type == type) {
+        return &existing->second;
+    }
+
+    metrics_logger.error("Metric " + name + " is already registered as a " + getTypeName(existing->second.type) +
+                         ", the " + getTypeName(type) + " will not be exported");
+    std::string detachedKey = name + "#" + getTypeName(type);
+    Family &family = detachedFamilies[detachedKey];
+    family.type = type;
+    family.help = help;
+    return &family;
+}
+
+Counter &MetricsRegistry::counter(const std::string &name, const std::string &help, const std::string &labels) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::unique_ptr<Counter> &counter = getFamily(name, help, COUNTER)->counters[labels];
+    if (!counter) {
+        counter.reset(new Counter());
+    }
+    return *counter;
+}
+
+Gauge &MetricsRegistry::gauge(const std::string &name, const std::string &help, const std::string &labels) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::unique_ptr<Gauge> &gauge = getFamily(name, help, GAUGE)->gauges[labels];
+    if (!gauge) {
+        gauge.reset(new Gauge());
+    }
+    return *gauge;
+}
+
+Histogram &MetricsRegistry::histogram(const std::string &name, const std::string &help, const std::string &labels) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::unique_ptr<Histogram> &histogram = getFamily(name, help, SUMMARY)->histograms[labels];
+    if (!histogram) {
+        histogram.reset(new Histogram());
+    }
+    return *histogram;
+}
+
+static std::string withLabels(const std::string &labels, const std::string &extraLabel = "") {
+    if (labels.empty() && extraLabel.empty()) {
+        return "";
+    }
+    if (labels.empty() || extraLabel.empty()) {
+        return "{" + labels + extraLabel + "}";
+    }
+    return "{" + labels + "," + extraLabel + "}";
+}
+
+std::string MetricsRegistry::snapshot() {
+    static const double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::stringstream out;
+    for (auto &entry : families) {
+        const std::string &name = entry.first;
+        Family &family = entry.second;
+        out << "# HELP " << name << " " << family.help << "\n";
+        out << "# TYPE " << name << " " << getTypeName(family.type) << "\n";
+        for (auto &counter : family.counters) {
+            out << name << withLabels(counter.first) << " " << counter.second->value() << "\n";
+        }
+        for (auto &gauge : family.gauges) {
+            out << name << withLabels(gauge.first) << " " << gauge.second->value() << "\n";
+        }
+        for (auto &histogram : family.histograms) {
+            for (double quantile : QUANTILES) {
+                std::stringstream quantileLabel;
+                quantileLabel << "quantile=\"" << quantile << "\"";
+                out << name << withLabels(histogram.first, quantileLabel.str()) << " "
+                    << histogram.second->percentile(quantile) << "\n";
+            }
+            out << name << "_sum" << withLabels(histogram.first) << " " << histogram.second->getSum() << "\n";
+            out << name << "_count" << withLabels(histogram.first) << " " << histogram.second->getCount() << "\n";
+        }
+    }
+    return out.str();
+}
+
+std::string MetricsRegistry::merge(const std::vector<std::pair<std::string, std::string>> &snapshots) {
+    struct MergedFamily {
+        std::string header;
+        std::vector<std::string> samples;
+    };
+    std::vector<std::string> familyOrder;
+    std::map<std::string, MergedFamily> merged;
+
+    for (auto &snapshot : snapshots) {
+        std::string instanceLabel = "instance=\"" + snapshot.first + "\"";
+        std::stringstream in(snapshot.second);
+        std::string line;
+        std::string currentFamily;
+        while (std::getline(in, line)) {
+            if (line.empty()) {
+                continue;
+            }
+            if (line.compare(0, 7, "# HELP ") == 0 || line.compare(0, 7, "# TYPE ") == 0) {
+                size_t nameEnd = line.find(' ', 7);
+                currentFamily = line.substr(7, nameEnd == std::string::npos ? std::string::npos : nameEnd - 7);
+                if (merged.find(currentFamily) == merged.end()) {
+                    familyOrder.push_back(currentFamily);
+                }
+                MergedFamily &family = merged[currentFamily];
+                // The header of the first instance that reports the family is kept
+                if (family.header.find(line.substr(0, 7)) == std::string::npos) {
+                    family.header += line + "\n";
+                }
+                continue;
+            }
+            if (line[0] == '#') {
+                continue;
+            }
+
+            size_t nameEnd = line.find_first_of("{ ");
+            if (nameEnd == std::string::npos) {
+                continue;
+            }
+            std::string sample;
+            if (line[nameEnd] == ' ') {
+                sample = line.substr(0, nameEnd) + "{" + instanceLabel + "}" + line.substr(nameEnd);
+            } else if (line[nameEnd + 1] == '}') {
+                sample = line.substr(0, nameEnd + 1) + instanceLabel + line.substr(nameEnd + 1);
+            } else {
+                sample = line.substr(0, nameEnd + 1) + instanceLabel + "," + line.substr(nameEnd + 1);
+            }
+            if (currentFamily.empty()) {
+                currentFamily = line.substr(0, nameEnd);
+                familyOrder.push_back(currentFamily);
+            }
+            merged[currentFamily].samples.push_back(sample);
+        }
+    }
+
+    std::stringstream out;
+    for (auto &name : familyOrder) {
+        MergedFamily &family = merged[name];
+        out << family.header;
+        for (auto &sample : family.samples) {
+            out << sample << "\n";
+        }
+    }
+    return out.str();
+}
+
+void MetricsRegistry::reset() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto &entry : families) {
+        for (auto &counter : entry.second.counters) {
+            counter.second->reset();
+        }
+        for (auto &gauge : entry.second.gauges) {
+            gauge.second->set(0);
+        }
+        for (auto &histogram : entry.second.histograms) {
+            histogram.second->reset();
+        }
+    }
+}
@@ -0,0 +1,179 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_METRICSREGISTRY_H
+#define JASMINEGRAPH_METRICSREGISTRY_H
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Monotonic counter split into cache line sized shards. Each thread adds to its own shard, so counters updated on
+ * every edge or every message do not bounce a shared cache line between cores. Reading sums the shards.
+ */
+class Counter {
+ public:
+    static const int SHARD_COUNT = 16;
+
+    Counter();
+
+    void inc(long amount = 1) { shards[getShardIndex()].value.fetch_add(amount, std::memory_order_relaxed); }
+
+    long value() const;
+
+    void reset();
+
+ private:
+    // Padded rather than aligned to a cache line, since new does not honour over-alignment before C++17. The values
+    // of two shards are a cache line apart, so they never share one.
+    struct Shard {
+        std::atomic<long> value;
+        char padding[64 - sizeof(std::atomic<long>)];
+    };
+
+    static int getShardIndex();
+
+    Shard shards[SHARD_COUNT];
+};
+
+// Value that can go up and down, such as a queue depth
+class Gauge {
+ public:
+    Gauge() : current(0) {}
+
+    void set(long value) { current.store(value, std::memory_order_relaxed); }
+
+    void inc(long amount = 1) { current.fetch_add(amount, std::memory_order_relaxed); }
+
+    void dec(long amount = 1) { current.fetch_sub(amount, std::memory_order_relaxed); }
+
+    long value() const { return current.load(std::memory_order_relaxed); }
+
+ private:
+    std::atomic<long> current;
+};
+
+/**
+ * HDR style histogram of non negative values (latencies in microseconds). Values below SUB_BUCKET_COUNT get a
+ * bucket each. Above that every power of two is split into SUB_BUCKET_COUNT linear buckets, so a percentile is
+ * reported within 1 / SUB_BUCKET_COUNT of the recorded value over the whole range of a long while recording is
+ * a single relaxed atomic increment.
+ */
+class Histogram {
+ public:
+    static const int SUB_BUCKET_BITS = 4;
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const int BUCKET_COUNT = SUB_BUCKET_COUNT * (64 - SUB_BUCKET_BITS);
+
+    Histogram();
+
+    void record(long value);
+
+    long getCount() const { return count.load(std::memory_order_relaxed); }
+
+    long getSum() const { return sum.load(std::memory_order_relaxed); }
+
+    long getMax() const { return max.load(std::memory_order_relaxed); }
+
+    // Value at the given quantile (0.0 - 1.0). Returns 0 for an empty histogram.
+    long percentile(double quantile) const;
+
+    void reset();
+
+    static int getBucketIndex(long value);
+
+    // Largest value that falls into the bucket
+    static long getBucketUpperBound(int index);
+
+ private:
+    std::atomic<long> buckets[BUCKET_COUNT];
+    std::atomic<long> count;
+    std::atomic<long> sum;
+    std::atomic<long> max;
+};
+
+// Records the microseconds between its construction and destruction into a histogram
+class ScopedTimer {
+ public:
+    explicit ScopedTimer(Histogram &histogram)
+        : histogram(histogram), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        histogram.record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                              start).count());
+    }
+
+ private:
+    Histogram &histogram;
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * Process wide registry of the counters, gauges and histograms. Looking a metric up takes a lock, so hot code
+ * keeps the returned reference (which stays valid for the lifetime of the process), e.g.
+ *
+ *     static Counter &edgesReceived = MetricsRegistry::counter("jasminegraph_stream_edges_received_total",
+ *                                                              "Edges received from the master");
+ *     edgesReceived.inc();
+ *
+ * Labels are given in Prometheus syntax (command="trian") and metrics with the same name but different labels
+ * are exported as one family. Histograms are exported as Prometheus summaries.
+ */
+class MetricsRegistry {
+ public:
+    static Counter &counter(const std::string &name, const std::string &help, const std::string &labels = "");
+
+    static Gauge &gauge(const std::string &name, const std::string &help, const std::string &labels = "");
+
+    static Histogram &histogram(const std::string &name, const std::string &help, const std::string &labels = "");
+
+    // Snapshot of all metrics in the Prometheus text exposition format
+    static std::string snapshot();
+
+    /**
+     * Merge the snapshots of several processes (instance name -> snapshot) into one exposition. Every sample gets
+     * an instance="<name>" label and the samples of a metric family from all instances are grouped under one
+     * HELP/TYPE header.
+     */
+    static std::string merge(const std::vector<std::pair<std::string, std::string>> &snapshots);
+
+    // Reset the value of every registered metric. Registered references stay valid.
+    static void reset();
+
+ private:
+    enum MetricType { COUNTER, GAUGE, SUMMARY };
+
+    struct Family {
+        MetricType type;
+        std::string help;
+        std::map<std::string, std::unique_ptr<Counter>> counters;
+        std::map<std::string, std::unique_ptr<Gauge>> gauges;
+        std::map<std::string, std::unique_ptr<Histogram>> histograms;
+    };
+
+    static Family *getFamily(const std::string &name, const std::string &help, MetricType type);
+
+    static std::mutex registryMutex;
+    static std::map<std::string, Family> families;
+    // Families whose name clashed with a family of another type. They keep the returned references valid but are
+    // never exported.
+    static std::map<std::string, Family> detachedFamilies;
+};
+
+#endif  // JASMINEGRAPH_METRICSREGISTRY_H
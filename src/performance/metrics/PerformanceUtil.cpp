@@ -20,6 +20,10 @@ Logger scheduler_logger;
 SQLiteDBInterface *sqlLiteDB;
 PerformanceSQLiteDBInterface *perfDb;
 
+static std::mutex performanceDataMutex;
+static std::vector<std::vector<std::string>> placePerformanceRows;
+static std::vector<std::vector<std::string>> hostPerformanceRows;
+
 void PerformanceUtil::init() {
     if (sqlLiteDB == nullptr) {
         sqlLiteDB = new SQLiteDBInterface();
@@ -85,9 +89,26 @@ int PerformanceUtil::collectPerformanceStatistics() {
         }
     }
 
+    flushPerformanceData();
     return 0;
 }
 
+void PerformanceUtil::flushPerformanceData() {
+    std::vector<std::vector<std::string>> placeRows;
+    std::vector<std::vector<std::string>> hostRows;
+    performanceDataMutex.lock();
+    placeRows.swap(placePerformanceRows);
+    hostRows.swap(hostPerformanceRows);
+    performanceDataMutex.unlock();
+
+    perfDb->runInsertBatch(
+        "insert into host_performance_data (date_time, memory_usage, cpu_usage, idhost) values (?, ?, ?, ?)",
+        hostRows);
+    perfDb->runInsertBatch(
+        "insert into place_performance_data (idplace, memory_usage, cpu_usage, date_time) values (?, ?, ?, ?)",
+        placeRows);
+}
+
 std::vector<Place> PerformanceUtil::getHostReporterList() {
     std::vector<Place> hostReporterList;
 
@@ -290,11 +311,9 @@ void PerformanceUtil::collectRemotePerformanceData(std::string host, int port, s
                 if (isVMStatManager == "true" && strArr.size() > 4) {
                     std::string memoryConsumption = strArr[4];
                     std::string cpuUsage = strArr[5];
-                    string vmPerformanceSql =
-                        "insert into host_performance_data (date_time, memory_usage, cpu_usage, idhost) values ('" +
-                        processTime + "','" + memoryConsumption + "','" + cpuUsage + "','" + hostId + "')";
-
-                    perfDb->runInsert(vmPerformanceSql);
+                    performanceDataMutex.lock();
+                    hostPerformanceRows.push_back({processTime, memoryConsumption, cpuUsage, hostId});
+                    performanceDataMutex.unlock();
 
                     if (isResourceAllocationRequired == "true") {
                         std::string totalMemory = strArr[6];
@@ -307,11 +326,9 @@ void PerformanceUtil::collectRemotePerformanceData(std::string host, int port, s
                     }
                 }
 
-                string placePerfSql =
-                    "insert into place_performance_data (idplace, memory_usage, cpu_usage, date_time) values ('" +
-                    placeId + "','" + memoryUsage + "','" + cpuUsage + "','" + processTime + "')";
-
-                perfDb->runInsert(placePerfSql);
+                performanceDataMutex.lock();
+                placePerformanceRows.push_back({placeId, memoryUsage, cpuUsage, processTime});
+                performanceDataMutex.unlock();
             }
         }
     }
@@ -338,11 +355,9 @@ void PerformanceUtil::collectLocalPerformanceData(std::string isVMStatManager, s
         string totalMemoryUsed = strArr[0];
         string totalCPUUsage = strArr[1];
 
-        string vmPerformanceSql =
-            "insert into host_performance_data (date_time, memory_usage, cpu_usage, idhost) values ('" +
-            reportTimeString + "','" + totalMemoryUsed + "','" + totalCPUUsage + "','" + hostId + "')";
-
-        perfDb->runInsert(vmPerformanceSql);
+        performanceDataMutex.lock();
+        hostPerformanceRows.push_back({reportTimeString, totalMemoryUsed, totalCPUUsage, hostId});
+        performanceDataMutex.unlock();
 
         if (isResourceAllocationRequired == "true") {
             std::string totalMemory = strArr[2];
@@ -354,11 +369,9 @@ void PerformanceUtil::collectLocalPerformanceData(std::string isVMStatManager, s
         }
     }
 
-    string placePerfSql = "insert into place_performance_data (idplace, memory_usage, cpu_usage, date_time) values ('" +
-                          placeId + "','" + to_string(memoryUsage) + "','" + to_string(cpuUsage) + "','" +
-                          reportTimeString + "')";
-
-    perfDb->runInsert(placePerfSql);
+    performanceDataMutex.lock();
+    placePerformanceRows.push_back({placeId, to_string(memoryUsage), to_string(cpuUsage), reportTimeString});
+    performanceDataMutex.unlock();
 }
 
 int PerformanceUtil::collectRemoteSLAResourceUtilization(std::string host, int port, std::string isVMStatManager,
@@ -619,280 +632,6 @@ ResourceConsumption PerformanceUtil::retrieveRemoteResourceConsumption(std::stri
     return placeResourceConsumption;
 }
 
-std::vector<long> PerformanceUtil::getResourceAvailableTime(std::vector<std::string> graphIdList, std::string command,
-                                                            std::string category, std::string masterIP,
-                                                            std::vector<JobRequest> &pendingHPJobList) {
-    PerformanceUtil performanceUtil;
-    performanceUtil.init();
-    std::set<std::string> hostSet;
-    std::vector<long> jobScheduleVector;
-
-    processStatusMutex.lock();
-    set<ProcessInfo>::iterator processInfoIterator;
-    std::vector<double> aggregatedLoadPoints;
-    std::map<std::string, std::vector<double>> hostLoadAvgMap;
-    std::chrono::milliseconds currentTime = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
-    long currentTimestamp = currentTime.count();
-    long jobAcceptableTime = 0;
-
-    for (processInfoIterator = processData.begin(); processInfoIterator != processData.end(); ++processInfoIterator) {
-        ProcessInfo process = *processInfoIterator;
-        std::string currentGraphId = process.graphId;
-
-        if (process.priority == Conts::HIGH_PRIORITY_DEFAULT_VALUE) {
-            long processScheduledTime = process.startTimestamp;
-            long initialSleepTime = process.sleepTime;
-            long elapsedTime = currentTimestamp - (processScheduledTime + initialSleepTime);
-            long adjustedElapsedTime;
-            long statCollectingGap = Conts::LOAD_AVG_COLLECTING_GAP * 1000;
-            long requiredAdjustment = 0;
-            long requiredNewPoints = 0;
-
-            if (elapsedTime < 0) {
-                adjustedElapsedTime = 0;
-                long jobIdleTime = (processScheduledTime + initialSleepTime) - currentTimestamp;
-                requiredAdjustment = jobIdleTime % statCollectingGap;
-                requiredNewPoints = (jobIdleTime / statCollectingGap) + 1;
-            } else if (elapsedTime < statCollectingGap) {
-                adjustedElapsedTime = 0;
-                requiredAdjustment = elapsedTime;
-            } else if (elapsedTime % statCollectingGap == 0) {
-                adjustedElapsedTime = elapsedTime;
-            } else {
-                adjustedElapsedTime = elapsedTime - statCollectingGap;
-                requiredAdjustment = elapsedTime % statCollectingGap;
-            }
-
-            std::string slaLoadQuery =
-                "select graph_place_sla_performance.place_id,graph_place_sla_performance.load_average,"
-                "graph_place_sla_performance.elapsed_time from graph_place_sla_performance inner join graph_sla"
-                "  inner join sla_category where graph_place_sla_performance.graph_sla_id=graph_sla.id"
-                "  and graph_sla.id_sla_category=sla_category.id and graph_sla.graph_id='" +
-                currentGraphId + "' and sla_category.command='" + command + "' and sla_category.category='" + category +
-                "' and graph_place_sla_performance.elapsed_time > '" + std::to_string(adjustedElapsedTime) +
-                "' order by graph_place_sla_performance.place_id,graph_place_sla_performance.elapsed_time;";
-
-            std::vector<vector<pair<string, string>>> loadAvgResults = perfDb->runSelect(slaLoadQuery);
-
-            std::map<std::string, std::vector<double>> hostTmpLoadAvgMap;
-
-            for (std::vector<vector<pair<string, string>>>::iterator i = loadAvgResults.begin();
-                 i != loadAvgResults.end(); ++i) {
-                std::vector<pair<string, string>> rowData = *i;
-
-                std::string placeId = rowData.at(0).second;
-                std::string loadAvg = rowData.at(1).second;
-
-                std::vector<double> currentHostLdAvgList = hostTmpLoadAvgMap[placeId];
-
-                if (requiredNewPoints > 0 && currentHostLdAvgList.empty()) {
-                    int newPointCount = 0;
-
-                    while (newPointCount < requiredNewPoints) {
-                        currentHostLdAvgList.push_back(0);
-                        newPointCount++;
-                    }
-                }
-
-                currentHostLdAvgList.push_back(std::atof(loadAvg.c_str()));
-
-                hostTmpLoadAvgMap[placeId] = currentHostLdAvgList;
-            }
-
-            for (std::map<std::string, std::vector<double>>::iterator mapIterator = hostTmpLoadAvgMap.begin();
-                 mapIterator != hostTmpLoadAvgMap.end(); ++mapIterator) {
-                std::string placeId = mapIterator->first;
-                std::vector<double> hostLoadVector = mapIterator->second;
-                std::vector<double> adjustedHostLoads;
-                long xAxisValue = 0;
-
-                for (std::size_t index = 0; index != hostLoadVector.size() - 1; ++index) {
-                    double currentLoad = hostLoadVector[index];
-                    double nextLoad = hostLoadVector[index + 1];
-
-                    double slope = (nextLoad - currentLoad) / statCollectingGap;
-
-                    double intercept = currentLoad - slope * xAxisValue;
-
-                    double adjustedLoad = slope * (xAxisValue + requiredAdjustment) + (intercept);
-
-                    adjustedHostLoads.push_back(adjustedLoad);
-
-                    xAxisValue += statCollectingGap;
-                }
-
-                std::vector<double> existingAggregateLoadVector = hostLoadAvgMap[placeId];
-
-                if (existingAggregateLoadVector.size() > 0) {
-                    auto maxVectorSize = std::max(existingAggregateLoadVector.size(), adjustedHostLoads.size());
-                    std::vector<double> aggregatedVector = std::vector<double>(maxVectorSize);
-
-                    existingAggregateLoadVector.resize(maxVectorSize);
-                    adjustedHostLoads.resize(maxVectorSize);
-
-                    std::transform(existingAggregateLoadVector.begin(), existingAggregateLoadVector.end(),
-                                   adjustedHostLoads.begin(), aggregatedVector.begin(), std::plus<double>());
-
-                    hostLoadAvgMap[placeId] = aggregatedVector;
-
-                } else {
-                    hostLoadAvgMap[placeId] = adjustedHostLoads;
-                }
-            }
-        }
-    }
-
-    processStatusMutex.unlock();
-
-    std::vector<std::string>::iterator graphIdListIterator;
-
-    for (graphIdListIterator = graphIdList.begin(); graphIdListIterator != graphIdList.end(); ++graphIdListIterator) {
-        std::string graphId = *graphIdListIterator;
-        scheduler_logger.log("###PERFORMANCE### New Job Graph ID:" + graphId, "info");
-        int loopCount = 0;
-
-        std::string newJobLoadQuery =
-            "select graph_place_sla_performance.place_id,graph_place_sla_performance.load_average,"
-            "graph_place_sla_performance.elapsed_time from graph_place_sla_performance inner join graph_sla"
-            "  inner join sla_category where graph_place_sla_performance.graph_sla_id=graph_sla.id"
-            "  and graph_sla.id_sla_category=sla_category.id and graph_sla.graph_id='" +
-            graphId + "' and sla_category.command='" + command + "' and sla_category.category='" + category +
-            "' order by graph_place_sla_performance.place_id,graph_place_sla_performance.elapsed_time;";
-
-        std::vector<vector<pair<string, string>>> newJobLoadAvgResults = perfDb->runSelect(newJobLoadQuery);
-
-        std::map<std::string, std::vector<double>> newJobLoadAvgMap;
-
-        for (std::vector<vector<pair<string, string>>>::iterator i = newJobLoadAvgResults.begin();
-             i != newJobLoadAvgResults.end(); ++i) {
-            std::vector<pair<string, string>> rowData = *i;
-
-            std::string placeId = rowData.at(0).second;
-            std::string loadAvg = rowData.at(1).second;
-
-            newJobLoadAvgMap[placeId].push_back(std::atof(loadAvg.c_str()));
-        }
-
-        for (std::map<std::string, std::vector<double>>::iterator mapIterator = hostLoadAvgMap.begin();
-             mapIterator != hostLoadAvgMap.end(); ++mapIterator) {
-            std::string placeId = mapIterator->first;
-            std::vector<double> hostLoadVector = mapIterator->second;
-            hostLoadVector.push_back(0);
-
-            std::vector<double> newJobHostLoadVector = newJobLoadAvgMap[placeId];
-
-            if (newJobHostLoadVector.size() > 0) {
-                double newJobHostMaxLoad = *std::max_element(newJobHostLoadVector.begin(), newJobHostLoadVector.end());
-                double currentAggHostMaxLoad = *std::max_element(hostLoadVector.begin(), hostLoadVector.end());
-
-                scheduler_logger.log("###PERFORMANCE### New Job Max Load:" + std::to_string(newJobHostMaxLoad), "info");
-                scheduler_logger.log(
-                    "###PERFORMANCE### Current Aggregated max load:" + std::to_string(currentAggHostMaxLoad), "info");
-
-                if (Conts::LOAD_AVG_THREASHOLD > currentAggHostMaxLoad + newJobHostMaxLoad) {
-                    jobAcceptableTime = 0;
-                } else {
-                    int maxValueIndex =
-                        std::max_element(hostLoadVector.begin(), hostLoadVector.end()) - hostLoadVector.begin();
-                    bool flag = true;
-
-                    for (int aggIndex = maxValueIndex; aggIndex != hostLoadVector.size(); ++aggIndex) {
-                        for (int currentJobIndex = 0; currentJobIndex != newJobHostLoadVector.size();
-                             ++currentJobIndex) {
-                            if (aggIndex + currentJobIndex >= hostLoadVector.size()) {
-                                break;
-                            }
-
-                            if (hostLoadVector[aggIndex + currentJobIndex] + newJobHostLoadVector[currentJobIndex] >
-                                Conts::LOAD_AVG_THREASHOLD) {
-                                flag = false;
-                                break;
-                            }
-                        }
-
-                        if (flag && aggIndex * Conts::LOAD_AVG_COLLECTING_GAP * 1000 > jobAcceptableTime) {
-                            jobAcceptableTime = aggIndex * Conts::LOAD_AVG_COLLECTING_GAP * 1000;
-                        } else {
-                            flag = true;
-                        }
-                    }
-                }
-            }
-        }
-
-        scheduler_logger.log("###PERFORMANCE### New Job onboard after:" + std::to_string(jobAcceptableTime), "info");
-
-        JobRequest jobRequest = pendingHPJobList[loopCount];
-        std::string slaString = jobRequest.getParameter(Conts::PARAM_KEYS::GRAPH_SLA);
-        long graphSla = std::atol(slaString.c_str());
-
-        if (jobAcceptableTime > graphSla * 0.1) {
-            jobScheduleVector.push_back(-1);
-        } else {
-            PerformanceUtil::adjustAggregateLoadMap(hostLoadAvgMap, newJobLoadAvgMap, jobAcceptableTime);
-            jobScheduleVector.push_back(jobAcceptableTime);
-        }
-
-        loopCount++;
-    }
-
-    std::map<std::string, std::vector<double>>::iterator logIterator;
-
-    for (logIterator = hostLoadAvgMap.begin(); logIterator != hostLoadAvgMap.end(); ++logIterator) {
-        std::string hostId = logIterator->first;
-        std::vector<double> loadVector = logIterator->second;
-
-        std::vector<double>::iterator loadIterator;
-
-        for (loadIterator = loadVector.begin(); loadIterator != loadVector.end(); ++loadIterator) {
-            double load = *loadIterator;
-            std::cout << "###PERF### Host ID: " + hostId + "EXPECTED LOAD: " + std::to_string(load) << std::endl;
-        }
-    }
-
-    return jobScheduleVector;
-}
-
-void PerformanceUtil::adjustAggregateLoadMap(std::map<std::string, std::vector<double>> &aggregateLoadAvgMap,
-                                             std::map<std::string, std::vector<double>> &newJobLoadAvgMap,
-                                             long newJobAcceptanceTime) {
-    std::map<std::string, std::vector<double>>::iterator newJobIterator;
-
-    for (newJobIterator = newJobLoadAvgMap.begin(); newJobIterator != newJobLoadAvgMap.end(); ++newJobIterator) {
-        std::string hostId = newJobIterator->first;
-        std::vector<double> newJobLoadVector = newJobIterator->second;
-        std::vector<double> newJobTmpLoadVector;
-
-        if (newJobAcceptanceTime > 0) {
-            for (long adjustCount = 0; adjustCount < newJobAcceptanceTime;
-                 adjustCount += Conts::LOAD_AVG_COLLECTING_GAP * 1000) {
-                newJobTmpLoadVector.push_back(0);
-                newJobTmpLoadVector.insert(newJobTmpLoadVector.end(), newJobLoadVector.begin(), newJobLoadVector.end());
-            }
-        } else {
-            newJobTmpLoadVector = newJobLoadVector;
-        }
-
-        std::vector<double> aggregateLoadVector = aggregateLoadAvgMap[hostId];
-
-        if (aggregateLoadVector.size() > 0) {
-            auto maxVectorSize = std::max(newJobTmpLoadVector.size(), aggregateLoadVector.size());
-            std::vector<double> aggregatedVector = std::vector<double>(maxVectorSize);
-
-            newJobTmpLoadVector.resize(maxVectorSize);
-            aggregateLoadVector.resize(maxVectorSize);
-
-            std::transform(aggregateLoadVector.begin(), aggregateLoadVector.end(), newJobTmpLoadVector.begin(),
-                           aggregatedVector.begin(), std::plus<double>());
-
-            aggregateLoadAvgMap[hostId] = aggregatedVector;
-
-        } else {
-            aggregateLoadAvgMap[hostId] = newJobTmpLoadVector;
-        }
-    }
-}
-
 void PerformanceUtil::logLoadAverage() {
     StatisticCollector statisticCollector;
 
@@ -61,9 +61,6 @@ class PerformanceUtil {
                                              std::string category, std::string masterIP, int elapsedTime,
                                              bool autoCalibrate);
     static std::vector<ResourceConsumption> retrieveCurrentResourceUtilization(std::string masterIP);
-    static std::vector<long> getResourceAvailableTime(std::vector<std::string> graphIdList, std::string command,
-                                                      std::string category, std::string masterIP,
-                                                      std::vector<JobRequest>& pendingHPJobList);
 
     static void logLoadAverage();
     static std::vector<Place> getHostReporterList();
@@ -84,6 +81,8 @@ class PerformanceUtil {
                                            std::string category, int elapsedTime);
 
  private:
+    // Write the place and host performance rows gathered in one collection round as a single batch
+    static void flushPerformanceData();
     static void collectRemotePerformanceData(std::string host, int port, std::string isVMStatManager,
                                              std::string isResourceAllocationRequired, std::string hostId,
                                              std::string placeId);
@@ -97,9 +96,6 @@ class PerformanceUtil {
     static ResourceConsumption retrieveRemoteResourceConsumption(std::string host, int port, std::string hostId,
                                                                  std::string placeId);
     static ResourceConsumption retrieveLocalResourceConsumption(std::string hostId, std::string placeId);
-    static void adjustAggregateLoadMap(std::map<std::string, std::vector<double>>& aggregateLoadAvgMap,
-                                       std::map<std::string, std::vector<double>>& newJobLoadAvgMap,
-                                       long newJobAcceptanceTime);
 };
 
 #endif  // JASMINEGRAPH_PERFORMANCEUTIL_H
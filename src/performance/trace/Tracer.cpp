@@ -0,0 +1,181 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "Tracer.h"
+
+#include <iomanip>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <sstream>
+
+#include "../../server/JasmineGraphInstanceProtocol.h"
+#include "../../util/Utils.h"
+#include "../../util/logger/Logger.h"
+
+using json = nlohmann::json;
+
+Logger tracer_logger;
+
+const size_t Tracer::DEFAULT_CAPACITY = 16384;
+std::atomic<bool> Tracer::enabled(false);
+
+static std::mutex spanMutex;
+static std::vector<Tracer::Span> spans;  // Ring buffer, the oldest span is overwritten once it is full
+static size_t spanCapacity = Tracer::DEFAULT_CAPACITY;
+static size_t nextSpan = 0;
+static std::string processName = "master";
+static std::atomic<int> nextThreadId(1);
+
+static std::string &currentTraceId() {
+    static thread_local std::string traceId;
+    return traceId;
+}
+
+static int getThreadId() {
+    static thread_local int threadId = nextThreadId.fetch_add(1);
+    return threadId;
+}
+
+static long currentTimeMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+void Tracer::setEnabled(bool enabled) { Tracer::enabled.store(enabled); }
+
+void Tracer::setProcessName(const std::string &name) {
+    std::lock_guard<std::mutex> lock(spanMutex);
+    processName = name;
+}
+
+std::string Tracer::startTrace() {
+    if (!isEnabled()) {
+        return "";
+    }
+    static thread_local std::mt19937_64 generator(std::random_device{}() ^ currentTimeMicros());
+    std::stringstream traceId;
+    traceId << std::hex << std::setw(16) << std::setfill('0') << generator();
+    return traceId.str();
+}
+
+const std::string &Tracer::getCurrentTraceId() { return currentTraceId(); }
+
+void Tracer::setCurrentTraceId(const std::string &traceId) { currentTraceId() = traceId; }
+
+void Tracer::record(Span span) {
+    std::lock_guard<std::mutex> lock(spanMutex);
+    if (spanCapacity == 0) {
+        return;
+    }
+    if (spans.size() < spanCapacity) {
+        spans.push_back(std::move(span));
+    } else {
+        spans[nextSpan] = std::move(span);
+    }
+    nextSpan = (nextSpan + 1) % spanCapacity;
+}
+
+std::vector<Tracer::Span> Tracer::getSpans(const std::string &traceId) {
+    std::lock_guard<std::mutex> lock(spanMutex);
+    std::vector<Span> traceSpans;
+    for (auto &span : spans) {
+        if (span.traceId == traceId) {
+            traceSpans.push_back(span);
+        }
+    }
+    return traceSpans;
+}
+
+std::string Tracer::exportEvents(const std::string &traceId, int processId) {
+    json events = json::array();
+    {
+        std::lock_guard<std::mutex> lock(spanMutex);
+        events.push_back({{"name", "process_name"},
+                          {"ph", "M"},
+                          {"pid", processId},
+                          {"tid", 0},
+                          {"args", {{"name", processName}}}});
+    }
+    for (auto &span : getSpans(traceId)) {
+        json event = {{"name", span.name},       {"cat", "jasminegraph"}, {"ph", "X"},
+                      {"ts", span.startMicros}, {"dur", span.durationMicros}, {"pid", processId},
+                      {"tid", span.threadId},   {"args", {{"traceId", span.traceId}}}};
+        if (!span.detail.empty()) {
+            event["args"]["detail"] = span.detail;
+        }
+        events.push_back(event);
+    }
+    return events.dump();
+}
+
+std::string Tracer::mergeEvents(const std::vector<std::string> &eventArrays) {
+    json events = json::array();
+    for (auto &eventArray : eventArrays) {
+        json parsed = json::parse(eventArray, nullptr, false);
+        if (!parsed.is_array()) {
+            tracer_logger.warn("Skipping trace events that are not a JSON array");
+            continue;
+        }
+        for (auto &event : parsed) {
+            events.push_back(event);
+        }
+    }
+    json trace = {{"traceEvents", events}, {"displayTimeUnit", "ms"}};
+    return trace.dump();
+}
+
+bool Tracer::sendTraceId(int sockfd) {
+    const std::string &traceId = getCurrentTraceId();
+    if (!isEnabled() || traceId.empty()) {
+        return true;
+    }
+    char data[INSTANCE_DATA_LENGTH + 1];
+    return Utils::sendExpectResponse(sockfd, data, INSTANCE_DATA_LENGTH, JasmineGraphInstanceProtocol::TRACE_ID,
+                                     JasmineGraphInstanceProtocol::OK) &&
+           Utils::sendExpectResponse(sockfd, data, INSTANCE_DATA_LENGTH, traceId, JasmineGraphInstanceProtocol::OK);
+}
+
+void Tracer::setCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(spanMutex);
+    spans.clear();
+    spanCapacity = capacity;
+    nextSpan = 0;
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(spanMutex);
+    spans.clear();
+    nextSpan = 0;
+}
+
+void TraceSpan::start(const char *name, const std::string &detail) {
+    active = true;
+    span.traceId = Tracer::getCurrentTraceId();
+    span.name = name;
+    span.detail = detail;
+    span.startMicros = currentTimeMicros();
+    span.threadId = getThreadId();
+    begin = std::chrono::steady_clock::now();
+}
+
+void TraceSpan::end() {
+    if (!active) {
+        return;
+    }
+    active = false;
+    span.durationMicros =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+    Tracer::record(std::move(span));
+}
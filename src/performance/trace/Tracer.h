@@ -0,0 +1,151 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_TRACER_H
+#define JASMINEGRAPH_TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Lightweight per query tracing. The frontend starts a trace for a query and the trace id follows the query through
+ * the JobRequest (Conts::PARAM_KEYS::TRACE_ID), the executor threads (traced()) and the instance protocol
+ * (Tracer::sendTraceId) to the workers. Every process records the spans of the trace into its own ring buffer, and
+ * the master merges the spans of all processes into one Chrome trace-event JSON document (chrome://tracing,
+ * Perfetto), so the critical path of the query can be followed across the nodes on one timeline.
+ *
+ * When tracing is disabled no trace id is generated and a TraceSpan costs one relaxed atomic load.
+ */
+class Tracer {
+ public:
+    struct Span {
+        std::string traceId;
+        std::string name;
+        std::string detail;
+        long startMicros;  // Microseconds since epoch, so the spans of different nodes line up
+        long durationMicros;
+        int threadId;
+    };
+
+    static const size_t DEFAULT_CAPACITY;
+
+    static void setEnabled(bool enabled);
+
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    // Name of this process in the exported trace, e.g. "master" or "worker 10.0.0.2:7780"
+    static void setProcessName(const std::string &name);
+
+    // Generate a new trace id, or an empty id if tracing is disabled
+    static std::string startTrace();
+
+    // Trace id of the query the calling thread works on, empty if none
+    static const std::string &getCurrentTraceId();
+
+    static void setCurrentTraceId(const std::string &traceId);
+
+    static void record(Span span);
+
+    // Spans of the trace recorded by this process
+    static std::vector<Span> getSpans(const std::string &traceId);
+
+    /**
+     * Chrome trace events (a JSON array) of the spans of this process that belong to the trace. The process id is
+     * given by the caller since the workers of a cluster may all run as the same pid in their containers.
+     */
+    static std::string exportEvents(const std::string &traceId, int processId);
+
+    // Combine the event arrays of several processes into one Chrome trace document
+    static std::string mergeEvents(const std::vector<std::string> &eventArrays);
+
+    /**
+     * Pass the trace id of the calling thread to a worker over an instance protocol session, so the spans of the
+     * commands that follow on that session belong to the trace. Does nothing when the thread is not tracing.
+     */
+    static bool sendTraceId(int sockfd);
+
+    static void setCapacity(size_t capacity);
+
+    static void clear();
+
+ private:
+    static std::atomic<bool> enabled;
+};
+
+/**
+ * Sets the trace id of the calling thread for its lifetime and restores the previous one afterwards.
+ */
+class TraceContext {
+ public:
+    explicit TraceContext(const std::string &traceId) : previous(Tracer::getCurrentTraceId()) {
+        Tracer::setCurrentTraceId(traceId);
+    }
+
+    ~TraceContext() { Tracer::setCurrentTraceId(previous); }
+
+ private:
+    std::string previous;
+};
+
+/**
+ * Records the time between its construction and end() (or destruction) as a span of the current trace.
+ */
+class TraceSpan {
+ public:
+    explicit TraceSpan(const char *name, const std::string &detail = "") : active(false) {
+        if (Tracer::isEnabled() && !Tracer::getCurrentTraceId().empty()) {
+            start(name, detail);
+        }
+    }
+
+    ~TraceSpan() { end(); }
+
+    void end();
+
+ private:
+    void start(const char *name, const std::string &detail);
+
+    bool active;
+    Tracer::Span span;
+    std::chrono::steady_clock::time_point begin;
+};
+
+/**
+ * Callable that runs the wrapped function under the trace id that was current when it was created. Used to carry
+ * the trace into threads started with std::async or std::thread.
+ */
+template <typename Function>
+class TracedCall {
+ public:
+    TracedCall(std::string traceId, Function function) : traceId(traceId), function(function) {}
+
+    template <typename... Args>
+    auto operator()(Args &&... args) -> decltype(std::declval<Function &>()(std::forward<Args>(args)...)) {
+        TraceContext context(traceId);
+        return function(std::forward<Args>(args)...);
+    }
+
+ private:
+    std::string traceId;
+    Function function;
+};
+
+template <typename Function>
+TracedCall<Function> traced(Function function) {
+    return TracedCall<Function>(Tracer::getCurrentTraceId(), function);
+}
+
+#endif  // JASMINEGRAPH_TRACER_H
@@ -35,6 +35,7 @@ int PerformanceSQLiteDBInterface::init() {
         return -1;
     }
     perfdb_logger.log("Database opened successfully", "info");
+    enableWriteAheadLog();
     return 0;
 }
 
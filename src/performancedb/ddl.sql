@@ -1,3 +1,17 @@
+create table aggregation_performance
+(
+    id                INTEGER not null
+        primary key,
+    graph_id          TEXT,
+    aggregator_id     TEXT,
+    combination       TEXT,
+    central_edgecount INTEGER,
+    bytes_moved       INTEGER,
+    transfer_time     INTEGER,
+    elapsed_time      INTEGER,
+    estimated_time    INTEGER
+);
+
 create table graph_performance_data
 (
     id             INTEGER not null
@@ -51,6 +65,34 @@ create table host_performance_data
     idhost       INTEGER not null
 );
 
+create table job_performance
+(
+    id             INTEGER not null
+        primary key,
+    job_id         TEXT,
+    job_type       TEXT,
+    graph_id       TEXT,
+    priority       INTEGER,
+    state          TEXT,
+    submit_time    INTEGER,
+    queue_time     INTEGER,
+    run_time       INTEGER,
+    estimated_time INTEGER
+);
+
+create table kernel_performance
+(
+    id           INTEGER not null
+        primary key,
+    job_type     TEXT,
+    graph_id     TEXT,
+    worker_id    TEXT,
+    partition_id TEXT,
+    edgecount    INTEGER,
+    degree_skew  NUMERIC,
+    elapsed_time INTEGER
+);
+
 create table place
 (
     idplace          INTEGER not null
@@ -86,3 +128,21 @@ values (1, 'trian', 'latency');
 
 insert into sla_category (id, command, category)
 values (2, 'pgrnk', 'latency');
+
+create table training_performance
+(
+    id               INTEGER not null
+        primary key,
+    model            TEXT,
+    graph_id         TEXT,
+    partition_id     TEXT,
+    host             TEXT,
+    vertexcount      INTEGER,
+    edgecount        INTEGER,
+    feature_count    INTEGER,
+    estimated_memory INTEGER,
+    estimated_time   INTEGER,
+    peak_memory      INTEGER,
+    elapsed_time     INTEGER,
+    cpu_time         INTEGER
+);
@@ -13,6 +13,9 @@ limitations under the License.
 
 #include "JasminGraphLinkPredictor.h"
 
+#include <future>
+
+#include "../../../performance/trace/Tracer.h"
 #include "../../../server/JasmineGraphInstanceProtocol.h"
 #include "../../../util/logger/Logger.h"
 
@@ -29,25 +32,37 @@ void JasminGraphLinkPredictor::initiateLinkPrediction(std::string graphID, std::
     int selectedHostDataPort;
     std::vector<std::string> selectedHostPartitions;
     int selectedHostPartitionsNo;
-    int count = 0;
-
-    /*Select the idle worker*/
-    //    TODO :: Need to select the idle worker to allocate predicting task.
-    //     For this time the first worker of the map is allocated
-
-    for (std::map<std::string, JasmineGraphServer::workerPartitions>::iterator it = (graphPartitionedHosts.begin());
-         it != graphPartitionedHosts.end(); ++it) {
-        if (count == 0) {
-            selectedHostName = it->first;
-            selectedHostPort = (graphPartitionedHosts[it->first]).port;
-            selectedHostDataPort = (graphPartitionedHosts[it->first]).dataPort;
-            selectedHostPartitions = (graphPartitionedHosts[it->first]).partitionID;
+
+    // Predicting runs on the least loaded worker, the others only serve their partitions to it
+    auto *refToPerfDb = new PerformanceSQLiteDBInterface();
+    refToPerfDb->init();
+    std::map<std::string, double> workerLoads = JasminGraphLinkPredictor::getWorkerLoads(refToPerfDb);
+    refToPerfDb->finalize();
+    delete refToPerfDb;
+
+    double selectedHostLoad = -1;
+    for (auto &host : graphPartitionedHosts) {
+        std::string address = host.first.find('@') != std::string::npos ? Utils::split(host.first, '@')[1]
+                                                                          : host.first;
+        auto load = workerLoads.find(address + ":" + std::to_string(host.second.port));
+        double hostLoad = load == workerLoads.end() ? 0 : load->second;
+        if (selectedHostLoad < 0 || hostLoad < selectedHostLoad) {
+            selectedHostLoad = hostLoad;
+            selectedHostName = host.first;
+        }
+    }
+    for (auto &host : graphPartitionedHosts) {
+        if (host.first == selectedHostName) {
+            selectedHostPort = host.second.port;
+            selectedHostDataPort = host.second.dataPort;
+            selectedHostPartitions = host.second.partitionID;
             selectedHostPartitionsNo = selectedHostPartitions.size();
         } else {
-            remainHostMap.insert(std::pair<std::string, JasmineGraphServer::workerPartitions>(it->first, it->second));
+            remainHostMap.insert(host);
         }
-        count++;
     }
+    predictor_logger.info("Selected worker " + selectedHostName + " with CPU usage " +
+                          std::to_string(selectedHostLoad) + "% for link prediction");
     std::string hostsList = "none|";
     for (std::map<std::string, JasmineGraphServer::workerPartitions>::iterator it = (remainHostMap.begin());
          it != remainHostMap.end(); ++it) {
@@ -228,3 +243,87 @@ int JasminGraphLinkPredictor::sendQueryToWorker(std::string host, int port, int
     close(sockfd);
     return 0;
 }
+
+std::map<std::string, double> JasminGraphLinkPredictor::getWorkerLoads(PerformanceSQLiteDBInterface *perfDb) {
+    std::map<std::string, double> workerLoads;
+    // Rows are ordered by insertion so the most recent CPU usage of a place wins
+    PreparedStatement statement = perfDb->prepare(
+        "SELECT place.ip, place.server_port, place_performance_data.cpu_usage "
+        "FROM place_performance_data INNER JOIN place ON place_performance_data.idplace = place.idplace "
+        "WHERE place_performance_data.cpu_usage IS NOT NULL ORDER BY place_performance_data.id;");
+    while (statement.next()) {
+        workerLoads[statement.getString(0) + ":" + statement.getString(1)] = statement.getDouble(2);
+    }
+    return workerLoads;
+}
+
+std::string JasminGraphLinkPredictor::predictLinks(SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfDb,
+                                                   std::string graphID, NeighborhoodSimilarity::Metric metric,
+                                                   int k) {
+    // Workers holding a copy of every partition
+    std::map<std::string, std::vector<std::pair<std::string, int>>> partitionWorkers;
+    PreparedStatement statement = sqlite->prepare(
+        "SELECT worker.ip, worker.server_port, worker_has_partition.partition_idpartition "
+        "FROM worker_has_partition INNER JOIN worker ON worker_has_partition.worker_idworker = worker.idworker "
+        "WHERE worker_has_partition.partition_graph_idgraph = ?;");
+    statement.bind(1, graphID);
+    while (statement.next()) {
+        partitionWorkers[statement.getString(2)].push_back(std::make_pair(statement.getString(0), statement.getInt(1)));
+    }
+
+    // Every partition assigned to a worker counts as one more busy core on top of the measured CPU usage
+    std::map<std::string, double> workerLoads = JasminGraphLinkPredictor::getWorkerLoads(perfDb);
+    std::vector<std::future<std::string>> workerResponses;
+    for (auto &partition : partitionWorkers) {
+        std::pair<std::string, int> selectedWorker;
+        double selectedLoad = -1;
+        for (auto &worker : partition.second) {
+            std::string workerKey = worker.first + ":" + std::to_string(worker.second);
+            double load = workerLoads[workerKey];
+            if (selectedLoad < 0 || load < selectedLoad) {
+                selectedLoad = load;
+                selectedWorker = worker;
+            }
+        }
+        workerLoads[selectedWorker.first + ":" + std::to_string(selectedWorker.second)] += 100;
+        predictor_logger.info("Predicting links of partition " + partition.first + " on " + selectedWorker.first +
+                              ":" + std::to_string(selectedWorker.second));
+        workerResponses.push_back(std::async(std::launch::async,
+                                             traced(JasminGraphLinkPredictor::sendLinkPredictionQuery),
+                                             selectedWorker.first, selectedWorker.second, graphID, partition.first,
+                                             metric, k));
+    }
+
+    // A vertex belongs to a single partition, so the top k lists of the partitions do not overlap
+    std::string links;
+    for (auto &response : workerResponses) {
+        links += response.get();
+    }
+    return links;
+}
+
+std::string JasminGraphLinkPredictor::sendLinkPredictionQuery(std::string host, int port, std::string graphID,
+                                                              std::string partitionID,
+                                                              NeighborhoodSimilarity::Metric metric, int k) {
+    char data[INSTANCE_DATA_LENGTH + 1];
+    int sockfd = Utils::connectToWorker(host, port);
+    if (sockfd < 0) {
+        return "";
+    }
+
+    std::string request =
+        graphID + "|" + partitionID + "|" + NeighborhoodSimilarity::getMetricName(metric) + "|" + std::to_string(k);
+    if (!Tracer::sendTraceId(sockfd) ||
+        !Utils::sendExpectResponse(sockfd, data, INSTANCE_DATA_LENGTH, JasmineGraphInstanceProtocol::LINK_PREDICT,
+                                   JasmineGraphInstanceProtocol::OK) ||
+        !Utils::send_str_wrapper(sockfd, request)) {
+        predictor_logger.error("Could not predict links of partition " + partitionID + " on " + host + ":" +
+                               std::to_string(port));
+        close(sockfd);
+        return "";
+    }
+
+    std::string links = Utils::readChunkedResponse(sockfd);
+    close(sockfd);
+    return links;
+}
@@ -20,12 +20,30 @@ limitations under the License.
 #include <map>
 #include <string>
 
+#include "../../../metadb/SQLiteDBInterface.h"
+#include "../../../performancedb/PerformanceSQLiteDBInterface.h"
 #include "../../../server/JasmineGraphServer.h"
+#include "NeighborhoodSimilarity.h"
 
 class JasminGraphLinkPredictor {
  public:
     static void initiateLinkPrediction(std::string graphID, std::string path, std::string masterIP);
 
+    /**
+     * Native link prediction with a neighbourhood similarity metric. Every partition of the graph is scored by
+     * one of the workers holding it, the least loaded one according to the performance DB, and the workers run in
+     * parallel. Returns the best k candidates of every vertex as "source target score" lines.
+     */
+    static std::string predictLinks(SQLiteDBInterface *sqlite, PerformanceSQLiteDBInterface *perfDb,
+                                    std::string graphID, NeighborhoodSimilarity::Metric metric, int k);
+
+    static std::string sendLinkPredictionQuery(std::string host, int port, std::string graphID,
+                                               std::string partitionID, NeighborhoodSimilarity::Metric metric,
+                                               int k);
+
+    // Latest CPU usage in percent of the workers in the performance DB, keyed by ip:port
+    static std::map<std::string, double> getWorkerLoads(PerformanceSQLiteDBInterface *perfDb);
+
     static int sendQueryToWorker(std::string host, int port, int dataPort, int selectedHostPartitionsNo,
                                  std::string graphID, std::string vertexCount, std::string filePath,
                                  std::string hostsList, std::string masterIP);
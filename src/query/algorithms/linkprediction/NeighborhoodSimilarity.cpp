@@ -0,0 +1,244 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "NeighborhoodSimilarity.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+// Sources handed to a thread at a time, small enough to balance vertices with very different degrees
+static const size_t SOURCE_BATCH_SIZE = 64;
+
+bool NeighborhoodSimilarity::parseMetric(const std::string &name, Metric &metric) {
+    if (name == "common-neighbors") {
+        metric = COMMON_NEIGHBORS;
+    } else if (name == "jaccard") {
+        metric = JACCARD;
+    } else if (name == "adamic-adar") {
+        metric = ADAMIC_ADAR;
+    } else if (name == "resource-allocation") {
+        metric = RESOURCE_ALLOCATION;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string NeighborhoodSimilarity::getMetricName(Metric metric) {
+    switch (metric) {
+        case COMMON_NEIGHBORS:
+            return "common-neighbors";
+        case JACCARD:
+            return "jaccard";
+        case ADAMIC_ADAR:
+            return "adamic-adar";
+        default:
+            return "resource-allocation";
+    }
+}
+
+void NeighborhoodSimilarity::addEdges(const std::map<long, std::unordered_set<long>> &adjacencyList) {
+    for (auto &vertex : adjacencyList) {
+        for (long neighbor : vertex.second) {
+            addEdge(vertex.first, neighbor);
+        }
+    }
+}
+
+void NeighborhoodSimilarity::addEdge(long source, long target) {
+    if (source == target) {
+        return;
+    }
+    edges.push_back(std::make_pair(source, target));
+    edges.push_back(std::make_pair(target, source));
+}
+
+void NeighborhoodSimilarity::build() {
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    vertexIds.clear();
+    for (auto &edge : edges) {
+        if (vertexIds.empty() || vertexIds.back() != edge.first) {
+            vertexIds.push_back(edge.first);
+        }
+    }
+
+    // Edges are sorted by source and then target, so every neighbour list comes out sorted
+    offsets.assign(vertexIds.size() + 1, 0);
+    neighbors.clear();
+    neighbors.reserve(edges.size());
+    size_t vertex = 0;
+    for (auto &edge : edges) {
+        while (vertexIds[vertex] != edge.first) {
+            offsets[++vertex] = neighbors.size();
+        }
+        neighbors.push_back(getIndex(edge.second));
+    }
+    while (vertex < vertexIds.size()) {
+        offsets[++vertex] = neighbors.size();
+    }
+    std::vector<std::pair<long, long>>().swap(edges);
+}
+
+int NeighborhoodSimilarity::getIndex(long vertex) const {
+    auto it = std::lower_bound(vertexIds.begin(), vertexIds.end(), vertex);
+    return it == vertexIds.end() || *it != vertex ? -1 : static_cast<int>(it - vertexIds.begin());
+}
+
+long NeighborhoodSimilarity::getDegree(long vertex) const {
+    int index = getIndex(vertex);
+    return index < 0 ? 0 : offsets[index + 1] - offsets[index];
+}
+
+double NeighborhoodSimilarity::score(long source, long target, Metric metric) const {
+    int sourceIndex = getIndex(source);
+    int targetIndex = getIndex(target);
+    if (sourceIndex < 0 || targetIndex < 0) {
+        return 0;
+    }
+    return scoreIndices(sourceIndex, targetIndex, metric);
+}
+
+double NeighborhoodSimilarity::scoreIndices(int source, int target, Metric metric) const {
+    const int *first = neighbors.data() + offsets[source];
+    const int *firstEnd = neighbors.data() + offsets[source + 1];
+    const int *second = neighbors.data() + offsets[target];
+    const int *secondEnd = neighbors.data() + offsets[target + 1];
+
+    long common = 0;
+    double weighted = 0;
+    while (first != firstEnd && second != secondEnd) {
+        if (*first < *second) {
+            ++first;
+        } else if (*second < *first) {
+            ++second;
+        } else {
+            common++;
+            long degree = offsets[*first + 1] - offsets[*first];
+            if (metric == ADAMIC_ADAR) {
+                // A common neighbour is adjacent to both vertices, so its degree is at least 2
+                weighted += 1.0 / std::log(static_cast<double>(degree));
+            } else if (metric == RESOURCE_ALLOCATION) {
+                weighted += 1.0 / degree;
+            }
+            ++first;
+            ++second;
+        }
+    }
+
+    switch (metric) {
+        case COMMON_NEIGHBORS:
+            return common;
+        case JACCARD: {
+            long unionSize = (offsets[source + 1] - offsets[source]) + (offsets[target + 1] - offsets[target]) - common;
+            return unionSize == 0 ? 0 : static_cast<double>(common) / unionSize;
+        }
+        default:
+            return weighted;
+    }
+}
+
+// Orders the candidate heap so that the worst candidate is on top
+static bool isBetter(const LinkScore &lhs, const LinkScore &rhs) {
+    return lhs.score > rhs.score || (lhs.score == rhs.score && lhs.target < rhs.target);
+}
+
+void NeighborhoodSimilarity::predictVertex(int source, Metric metric, int k, std::vector<int> &visited,
+                                           std::vector<LinkScore> &scores) const {
+    // The source and its neighbours are marked first so that only the unconnected vertices two hops away are scored
+    visited[source] = source;
+    for (long i = offsets[source]; i < offsets[source + 1]; i++) {
+        visited[neighbors[i]] = source;
+    }
+
+    for (long i = offsets[source]; i < offsets[source + 1]; i++) {
+        int neighbor = neighbors[i];
+        for (long j = offsets[neighbor]; j < offsets[neighbor + 1]; j++) {
+            int candidate = neighbors[j];
+            if (visited[candidate] == source) {
+                continue;
+            }
+            visited[candidate] = source;
+
+            LinkScore linkScore;
+            linkScore.source = vertexIds[source];
+            linkScore.target = vertexIds[candidate];
+            linkScore.score = scoreIndices(source, candidate, metric);
+            if (scores.size() < static_cast<size_t>(k)) {
+                scores.push_back(linkScore);
+                std::push_heap(scores.begin(), scores.end(), isBetter);
+            } else if (isBetter(linkScore, scores.front())) {
+                std::pop_heap(scores.begin(), scores.end(), isBetter);
+                scores.back() = linkScore;
+                std::push_heap(scores.begin(), scores.end(), isBetter);
+            }
+        }
+    }
+    std::sort_heap(scores.begin(), scores.end(), isBetter);
+}
+
+std::vector<LinkScore> NeighborhoodSimilarity::predict(const std::vector<long> &sources, Metric metric, int k,
+                                                       int threadCount) const {
+    std::vector<int> sourceIndices;
+    if (sources.empty()) {
+        for (size_t i = 0; i < vertexIds.size(); i++) {
+            sourceIndices.push_back(i);
+        }
+    } else {
+        for (long source : sources) {
+            int index = getIndex(source);
+            if (index >= 0) {
+                sourceIndices.push_back(index);
+            }
+        }
+    }
+    if (k <= 0 || sourceIndices.empty()) {
+        return std::vector<LinkScore>();
+    }
+
+    std::vector<std::vector<LinkScore>> sourceScores(sourceIndices.size());
+    std::atomic<size_t> nextSource(0);
+    auto scoreSources = [&]() {
+        std::vector<int> visited(vertexIds.size(), -1);
+        while (true) {
+            size_t begin = nextSource.fetch_add(SOURCE_BATCH_SIZE);
+            if (begin >= sourceIndices.size()) {
+                break;
+            }
+            size_t end = std::min(sourceIndices.size(), begin + SOURCE_BATCH_SIZE);
+            for (size_t i = begin; i < end; i++) {
+                predictVertex(sourceIndices[i], metric, k, visited, sourceScores[i]);
+            }
+        }
+    };
+
+    size_t batches = (sourceIndices.size() + SOURCE_BATCH_SIZE - 1) / SOURCE_BATCH_SIZE;
+    threadCount = std::max(1, std::min(threadCount, static_cast<int>(batches)));
+    std::vector<std::thread> threads;
+    for (int i = 1; i < threadCount; i++) {
+        threads.push_back(std::thread(scoreSources));
+    }
+    scoreSources();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::vector<LinkScore> scores;
+    for (auto &vertexScores : sourceScores) {
+        scores.insert(scores.end(), vertexScores.begin(), vertexScores.end());
+    }
+    return scores;
+}
@@ -0,0 +1,85 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_NEIGHBORHOODSIMILARITY_H
+#define JASMINEGRAPH_NEIGHBORHOODSIMILARITY_H
+
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+struct LinkScore {
+    long source;
+    long target;
+    double score;
+};
+
+/**
+ * Native link prediction with neighbourhood similarity heuristics. The adjacency lists handed in (local store,
+ * central store and duplicate central store of a partition) are merged into an undirected CSR with sorted
+ * neighbour lists. The candidates of a vertex are the vertices two hops away that it is not connected to yet, and
+ * every candidate pair is scored by intersecting the two sorted neighbour lists:
+ *
+ *     common-neighbors     |N(u) ∩ N(v)|
+ *     jaccard              |N(u) ∩ N(v)| / |N(u) ∪ N(v)|
+ *     adamic-adar          sum over w in N(u) ∩ N(v) of 1 / log(|N(w)|)
+ *     resource-allocation  sum over w in N(u) ∩ N(v) of 1 / |N(w)|
+ *
+ * Source vertices are spread over a pool of threads and the best k candidates of every source are kept. A worker
+ * only holds the edges of its own partitions, so neighbourhoods of vertices in other partitions are partial.
+ */
+class NeighborhoodSimilarity {
+ public:
+    enum Metric { COMMON_NEIGHBORS, JACCARD, ADAMIC_ADAR, RESOURCE_ALLOCATION };
+
+    static bool parseMetric(const std::string &name, Metric &metric);
+
+    static std::string getMetricName(Metric metric);
+
+    void addEdges(const std::map<long, std::unordered_set<long>> &adjacencyList);
+
+    void addEdge(long source, long target);
+
+    // Build the CSR from the edges added so far. Has to be called before scoring.
+    void build();
+
+    long getVertexCount() const { return vertexIds.size(); }
+
+    long getDegree(long vertex) const;
+
+    // Score of a single pair, 0 if either vertex is unknown
+    double score(long source, long target, Metric metric) const;
+
+    /**
+     * The best k candidates of every source vertex, best first. Pairs that are already connected are skipped
+     * and ties are broken by the smaller target id. An empty source list scores every vertex.
+     */
+    std::vector<LinkScore> predict(const std::vector<long> &sources, Metric metric, int k, int threadCount) const;
+
+ private:
+    int getIndex(long vertex) const;
+
+    double scoreIndices(int source, int target, Metric metric) const;
+
+    void predictVertex(int source, Metric metric, int k, std::vector<int> &visited,
+                       std::vector<LinkScore> &scores) const;
+
+    std::vector<std::pair<long, long>> edges;
+    std::vector<long> vertexIds;  // Sorted, the CSR works on positions in this list
+    std::vector<long> offsets;
+    std::vector<int> neighbors;
+};
+
+#endif  // JASMINEGRAPH_NEIGHBORHOODSIMILARITY_H
@@ -0,0 +1,346 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "FrontierBFS.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "../../../nativestore/NodeBlock.h"
+#include "../../../nativestore/RelationBlock.h"
+#include "../../../nativestore/StoreCompactor.h"
+#include "../../../util/logger/Logger.h"
+
+Logger frontier_bfs_logger;
+
+const double FrontierBFS::ALPHA = 14;
+const double FrontierBFS::BETA = 24;
+
+// Frontier vertices, or 64 vertex words of the bitmap bottom-up, handed to a thread at a time
+static const size_t FRONTIER_BATCH_SIZE = 256;
+static const size_t WORD_BATCH_SIZE = 16;
+static const uint32_t MAX_COUNTERS = 64;
+static const uint32_t MAX_MESSAGE_SIZE = 1 << 30;
+
+static bool readFile(const std::string &path, std::string &data) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream contents;
+    if (file.is_open()) {
+        contents << file.rdbuf();
+    }
+    data = contents.str();
+    return file.is_open();
+}
+
+static uint32_t getWord(const std::string &data, size_t offset) {
+    uint32_t value;
+    memcpy(&value, data.data() + offset, sizeof(value));
+    return value;
+}
+
+// CSR of the relations grouped by the first vertex of each pair
+static void buildCSR(uint32_t vertexCount, const std::vector<std::pair<uint32_t, uint32_t>> &relations,
+                     std::vector<uint64_t> &offsets, std::vector<uint32_t> &targets) {
+    offsets.assign(vertexCount + 1, 0);
+    for (auto &relation : relations) {
+        offsets[relation.first + 1]++;
+    }
+    for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+        offsets[vertex + 1] += offsets[vertex];
+    }
+    targets.resize(relations.size());
+    std::vector<uint64_t> position(offsets.begin(), offsets.end() - 1);
+    for (auto &relation : relations) {
+        targets[position[relation.first]++] = relation.second;
+    }
+}
+
+static void runThreads(int threadCount, const std::function<void(int)> &work) {
+    std::vector<std::thread> threads;
+    for (int thread = 1; thread < threadCount; thread++) {
+        threads.push_back(std::thread(work, thread));
+    }
+    work(0);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+bool FrontierBFS::load(const std::string &dbPrefix, unsigned long indexKeySize, bool directed) {
+    // Keeps a compaction from replacing the files between the reads
+    StoreCompactor::PartitionLock partitionLock(dbPrefix, false);
+    std::string nodes;
+    std::string index;
+    if (!readFile(dbPrefix + "_nodes.db", nodes) || !readFile(dbPrefix + "_nodes.index.db", index)) {
+        frontier_bfs_logger.error("No native store for " + dbPrefix);
+        return false;
+    }
+    uint32_t nodeCount = nodes.size() / NodeBlock::BLOCK_SIZE;
+    ids.assign(nodeCount, "");
+    vertices.clear();
+    unsigned long entrySize = indexKeySize + sizeof(uint32_t);
+    for (size_t entry = 0; entry + entrySize <= index.size(); entry += entrySize) {
+        uint32_t node = getWord(index, entry + indexKeySize);
+        if (node < nodeCount && nodes[node * NodeBlock::BLOCK_SIZE] != 0 && ids[node].empty()) {
+            ids[node] = std::string(index.data() + entry, strnlen(index.data() + entry, indexKeySize));
+            vertices[ids[node]] = node;
+        }
+    }
+
+    // Relation 0 is not used, and relations written after the files were read are left out
+    const unsigned long blockSize = RelationBlock::BLOCK_SIZE;
+    const size_t sourceOffset = static_cast<int>(RelationOffsets::SOURCE) * RelationBlock::RECORD_SIZE;
+    const size_t destinationOffset = static_cast<int>(RelationOffsets::DESTINATION) * RelationBlock::RECORD_SIZE;
+    std::vector<std::pair<uint32_t, uint32_t>> relations;
+    boundary.assign(nodeCount, false);
+    for (auto suffix : {"_relations.db", "_central_relations.db"}) {
+        bool central = std::string(suffix) == "_central_relations.db";
+        std::string data;
+        readFile(dbPrefix + suffix, data);
+        for (size_t block = blockSize; block + blockSize <= data.size(); block += blockSize) {
+            uint32_t source = getWord(data, block + sourceOffset);
+            uint32_t destination = getWord(data, block + destinationOffset);
+            if (source % NodeBlock::BLOCK_SIZE != 0 || destination % NodeBlock::BLOCK_SIZE != 0 ||
+                source / NodeBlock::BLOCK_SIZE >= nodeCount || destination / NodeBlock::BLOCK_SIZE >= nodeCount) {
+                continue;
+            }
+            source /= NodeBlock::BLOCK_SIZE;
+            destination /= NodeBlock::BLOCK_SIZE;
+            relations.push_back(std::make_pair(source, destination));
+            if (!directed && source != destination) {
+                relations.push_back(std::make_pair(destination, source));
+            }
+            if (central) {
+                boundary[source] = true;
+                boundary[destination] = true;
+            }
+        }
+    }
+
+    this->directed = directed;
+    buildCSR(nodeCount, relations, outOffsets, outTargets);
+    inOffsets.clear();
+    inTargets.clear();
+    if (directed) {
+        for (auto &relation : relations) {
+            std::swap(relation.first, relation.second);
+        }
+        buildCSR(nodeCount, relations, inOffsets, inTargets);
+    }
+    visited = std::vector<std::atomic<uint64_t>>((nodeCount + 63) / 64);
+    reset();
+    frontier_bfs_logger.info("Loaded " + std::to_string(nodeCount) + " vertices and " +
+                             std::to_string(relations.size()) + " relations of " + dbPrefix);
+    return true;
+}
+
+void FrontierBFS::reset() {
+    for (auto &word : visited) {
+        word.store(0, std::memory_order_relaxed);
+    }
+    frontier.clear();
+    previousFrontier = 0;
+    bottomUp = false;
+    frontierEdges = 0;
+    unvisitedEdges = directed ? inTargets.size() : outTargets.size();
+}
+
+bool FrontierBFS::visit(uint32_t vertex) {
+    uint64_t bit = 1ULL << (vertex % 64);
+    if (visited[vertex / 64].fetch_or(bit) & bit) {
+        return false;
+    }
+    const std::vector<uint64_t> &offsets = directed ? inOffsets : outOffsets;
+    unvisitedEdges -= offsets[vertex + 1] - offsets[vertex];
+    return true;
+}
+
+uint64_t FrontierBFS::addToFrontier(const std::vector<std::string> &vertexIds) {
+    uint64_t added = 0;
+    for (auto &id : vertexIds) {
+        auto vertex = vertices.find(id);
+        if (vertex != vertices.end() && visit(vertex->second)) {
+            frontier.push_back(vertex->second);
+            frontierEdges += outOffsets[vertex->second + 1] - outOffsets[vertex->second];
+            added++;
+        }
+    }
+    return added;
+}
+
+FrontierBFS::LevelStats FrontierBFS::expand(int threadCount, std::vector<std::string> &reachedBoundary) {
+    LevelStats stats;
+    stats.frontier = frontier.size();
+    auto start = std::chrono::steady_clock::now();
+    if (directionOptimizing) {
+        bool growing = frontier.size() > previousFrontier;
+        if (!bottomUp && growing && frontierEdges > unvisitedEdges / ALPHA) {
+            bottomUp = true;
+        } else if (bottomUp && !growing && frontier.size() < ids.size() / BETA) {
+            bottomUp = false;
+        }
+    }
+    previousFrontier = frontier.size();
+    stats.bottomUp = bottomUp;
+
+    threadCount = std::max(1, threadCount);
+    std::vector<std::vector<uint32_t>> reachedByThread(threadCount);
+    std::atomic<size_t> nextBatch(0);
+    if (!bottomUp) {
+        size_t batches = (frontier.size() + FRONTIER_BATCH_SIZE - 1) / FRONTIER_BATCH_SIZE;
+        runThreads(std::min(threadCount, static_cast<int>(std::max<size_t>(1, batches))), [&](int thread) {
+            std::vector<uint32_t> &reached = reachedByThread[thread];
+            while (true) {
+                size_t begin = nextBatch.fetch_add(FRONTIER_BATCH_SIZE);
+                if (begin >= frontier.size()) {
+                    break;
+                }
+                size_t end = std::min(frontier.size(), begin + FRONTIER_BATCH_SIZE);
+                for (size_t i = begin; i < end; i++) {
+                    uint32_t vertex = frontier[i];
+                    for (uint64_t edge = outOffsets[vertex]; edge < outOffsets[vertex + 1]; edge++) {
+                        uint32_t target = outTargets[edge];
+                        uint64_t bit = 1ULL << (target % 64);
+                        std::atomic<uint64_t> &word = visited[target / 64];
+                        // Most targets are reached already, which a plain load tells without taking the line
+                        if ((word.load(std::memory_order_relaxed) & bit) == 0 && (word.fetch_or(bit) & bit) == 0) {
+                            reached.push_back(target);
+                        }
+                    }
+                }
+            }
+        });
+    } else {
+        std::vector<uint64_t> frontierBits(visited.size(), 0);
+        for (uint32_t vertex : frontier) {
+            frontierBits[vertex / 64] |= 1ULL << (vertex % 64);
+        }
+        const std::vector<uint64_t> &offsets = directed ? inOffsets : outOffsets;
+        const std::vector<uint32_t> &targets = directed ? inTargets : outTargets;
+        size_t batches = (visited.size() + WORD_BATCH_SIZE - 1) / WORD_BATCH_SIZE;
+        // Each word of the visited bitmap is only written by the thread of its batch
+        runThreads(std::min(threadCount, static_cast<int>(std::max<size_t>(1, batches))), [&](int thread) {
+            std::vector<uint32_t> &reached = reachedByThread[thread];
+            while (true) {
+                size_t begin = nextBatch.fetch_add(WORD_BATCH_SIZE);
+                if (begin >= visited.size()) {
+                    break;
+                }
+                size_t end = std::min(visited.size(), begin + WORD_BATCH_SIZE);
+                for (size_t word = begin; word < end; word++) {
+                    uint64_t seen = visited[word].load(std::memory_order_relaxed);
+                    uint64_t found = 0;
+                    for (uint32_t bit = 0; bit < 64 && word * 64 + bit < ids.size(); bit++) {
+                        if (seen & (1ULL << bit)) {
+                            continue;
+                        }
+                        uint32_t vertex = word * 64 + bit;
+                        for (uint64_t edge = offsets[vertex]; edge < offsets[vertex + 1]; edge++) {
+                            uint32_t source = targets[edge];
+                            if (frontierBits[source / 64] & (1ULL << (source % 64))) {
+                                found |= 1ULL << bit;
+                                reached.push_back(vertex);
+                                break;
+                            }
+                        }
+                    }
+                    if (found) {
+                        visited[word].fetch_or(found, std::memory_order_relaxed);
+                    }
+                }
+            }
+        });
+    }
+
+    std::vector<uint32_t> next;
+    for (auto &reached : reachedByThread) {
+        next.insert(next.end(), reached.begin(), reached.end());
+    }
+    setFrontier(next);
+    stats.reached = frontier.size();
+    for (uint32_t vertex : frontier) {
+        if (boundary[vertex] && !ids[vertex].empty()) {
+            reachedBoundary.push_back(ids[vertex]);
+            stats.reachedBoundary++;
+        }
+    }
+    stats.milliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+uint64_t FrontierBFS::mergeBoundary(uint64_t reached, const std::vector<std::string> &boundary,
+                                    std::unordered_set<std::string> &reachedBoundary,
+                                    std::vector<std::string> &exchanged) {
+    // A boundary vertex can be reached by several partitions in the same level, it is counted once
+    exchanged.clear();
+    for (auto &id : boundary) {
+        if (reachedBoundary.insert(id).second) {
+            exchanged.push_back(id);
+        }
+    }
+    return reached + exchanged.size();
+}
+
+void FrontierBFS::setFrontier(std::vector<uint32_t> &vertices) {
+    const std::vector<uint64_t> &offsets = directed ? inOffsets : outOffsets;
+    frontier.swap(vertices);
+    frontierEdges = 0;
+    for (uint32_t vertex : frontier) {
+        frontierEdges += outOffsets[vertex + 1] - outOffsets[vertex];
+        unvisitedEdges -= offsets[vertex + 1] - offsets[vertex];
+    }
+}
+
+bool FrontierBFS::writeMessage(ByteSink sink, const std::vector<uint64_t> &counters,
+                               const std::vector<std::string> &vertexIds) {
+    std::string payload;
+    for (auto &id : vertexIds) {
+        payload += id;
+        payload += '\n';
+    }
+    uint32_t header[3] = {static_cast<uint32_t>(counters.size()), static_cast<uint32_t>(vertexIds.size()),
+                          static_cast<uint32_t>(payload.size())};
+    std::string message(reinterpret_cast<const char *>(header), sizeof(header));
+    message.append(reinterpret_cast<const char *>(counters.data()), counters.size() * sizeof(uint64_t));
+    message += payload;
+    return sink(message.data(), message.size());
+}
+
+bool FrontierBFS::readMessage(ByteSource source, std::vector<uint64_t> &counters,
+                              std::vector<std::string> &vertexIds) {
+    uint32_t header[3];
+    if (!source(reinterpret_cast<char *>(header), sizeof(header)) || header[0] > MAX_COUNTERS ||
+        header[2] > MAX_MESSAGE_SIZE) {
+        return false;
+    }
+    counters.assign(header[0], 0);
+    if (header[0] > 0 && !source(reinterpret_cast<char *>(counters.data()), header[0] * sizeof(uint64_t))) {
+        return false;
+    }
+    std::string payload(header[2], '\0');
+    if (header[2] > 0 && !source(&payload[0], header[2])) {
+        return false;
+    }
+    vertexIds.clear();
+    size_t begin = 0;
+    for (size_t end = payload.find('\n'); end != std::string::npos; end = payload.find('\n', begin)) {
+        vertexIds.push_back(payload.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return vertexIds.size() == header[1];
+}
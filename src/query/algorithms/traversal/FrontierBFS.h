@@ -0,0 +1,123 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_FRONTIERBFS_H
+#define JASMINEGRAPH_FRONTIERBFS_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Level synchronous breadth first search over a CSR snapshot of the native store of a partition. The snapshot is
+ * read from the node index and the relation files in one pass, so a hop costs an array read instead of a
+ * NodeBlock and a disk read per neighbour. Local and central relations are followed from their source to their
+ * destination, and also backwards unless the search is directed.
+ *
+ * Visited vertices are kept in a bitmap. A level is expanded top-down, from the frontier list over the out
+ * relations, or bottom-up, by every unvisited vertex looking for a frontier vertex among its in relations, which
+ * is cheaper once the frontier covers a large part of the graph. The direction is switched with the heuristic of
+ * Beamer et al.: bottom-up once the frontier grows and has more than 1/14 of the relations of the unvisited
+ * vertices, and top-down again once it shrinks below 1/24 of the vertices. Both directions spread the work over a
+ * pool of threads.
+ *
+ * A vertex only appears in the stores of several partitions as an endpoint of a central relation (a boundary
+ * vertex), the other vertices are stored by one partition. A distributed search runs one FrontierBFS per
+ * partition and exchanges the boundary vertices reached at every level: the ids returned by expand() are merged
+ * by the caller and handed to addToFrontier() of every partition before the next level, which adds the ones the
+ * partition stores and has not reached yet.
+ */
+class FrontierBFS {
+ public:
+    struct LevelStats {
+        uint64_t frontier = 0;  // Vertices expanded
+        uint64_t reached = 0;   // Vertices reached for the first time
+        uint64_t reachedBoundary = 0;
+        bool bottomUp = false;
+        double milliseconds = 0;
+    };
+
+    typedef std::function<bool(const char *, size_t)> ByteSink;
+    typedef std::function<bool(char *, size_t)> ByteSource;
+
+    static const double ALPHA;
+    static const double BETA;
+
+    // Read the snapshot of the partition with the given prefix. indexKeySize is the key size of the node index.
+    bool load(const std::string &dbPrefix, unsigned long indexKeySize, bool directed);
+
+    uint32_t getVertexCount() const { return ids.size(); }
+
+    uint64_t getEdgeCount() const { return outTargets.size(); }
+
+    void setDirectionOptimizing(bool directionOptimizing) { this->directionOptimizing = directionOptimizing; }
+
+    // Forget the vertices reached by the previous search
+    void reset();
+
+    // Add the vertices with the given ids that are stored by the partition and were not reached yet to the frontier.
+    // Returns how many were added.
+    uint64_t addToFrontier(const std::vector<std::string> &vertexIds);
+
+    // Expand the frontier by one hop. The ids of the boundary vertices reached are appended to reachedBoundary.
+    LevelStats expand(int threadCount, std::vector<std::string> &reachedBoundary);
+
+    /**
+     * Merge the boundary vertices the partitions reached in a level of a distributed search. The ones no partition
+     * reached before are added to reachedBoundary and replace the contents of exchanged, the ids to hand to
+     * addToFrontier() of every partition before the next level. reached is the number of other vertices the
+     * partitions reached in the level, the vertices reached by the whole level are returned.
+     */
+    static uint64_t mergeBoundary(uint64_t reached, const std::vector<std::string> &boundary,
+                                  std::unordered_set<std::string> &reachedBoundary,
+                                  std::vector<std::string> &exchanged);
+
+    /**
+     * Frontier exchange messages between the master and the workers: a header of three host order uint32 values
+     * (the number of counters, the number of ids and the size of the ids in bytes), the counters as uint64 values
+     * and the ids, each terminated by a newline.
+     */
+    static bool writeMessage(ByteSink sink, const std::vector<uint64_t> &counters,
+                             const std::vector<std::string> &vertexIds);
+
+    static bool readMessage(ByteSource source, std::vector<uint64_t> &counters, std::vector<std::string> &vertexIds);
+
+ private:
+    bool visit(uint32_t vertex);
+
+    void setFrontier(std::vector<uint32_t> &vertices);
+
+    std::vector<std::string> ids;  // Node index of the store -> vertex id, empty for nodes that are not in use
+    std::unordered_map<std::string, uint32_t> vertices;
+    std::vector<bool> boundary;
+    std::vector<uint64_t> outOffsets;
+    std::vector<uint32_t> outTargets;
+    // The in relations are the out relations when the search is not directed
+    std::vector<uint64_t> inOffsets;
+    std::vector<uint32_t> inTargets;
+    bool directed = false;
+
+    bool directionOptimizing = true;
+    bool bottomUp = false;
+    std::vector<std::atomic<uint64_t>> visited;
+    std::vector<uint32_t> frontier;
+    size_t previousFrontier = 0;
+    uint64_t frontierEdges = 0;   // Out relations of the frontier
+    uint64_t unvisitedEdges = 0;  // In relations of the vertices not reached yet
+};
+
+#endif  // JASMINEGRAPH_FRONTIERBFS_H
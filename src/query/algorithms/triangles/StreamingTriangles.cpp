@@ -72,9 +72,13 @@ std::map<long, std::unordered_set<long>> StreamingTriangles::getCentralAdjacency
     gc.partitionID = partitionID;
     gc.maxLabelSize = std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size"));
     gc.openMode = "app";
+    gc.readOnly = true;
     NodeManager* nm = new NodeManager(gc);
+    adjacencyList = nm->getAdjacencyList(false);
+    nm->close();
+    delete nm;
 
-    return nm->getAdjacencyList(false);
+    return adjacencyList;
 }
 
 std::vector<std::pair<long, long>> StreamingTriangles::getEdges(unsigned int graphID, unsigned int partitionID,
@@ -85,6 +89,7 @@ std::vector<std::pair<long, long>> StreamingTriangles::getEdges(unsigned int gra
     gc.partitionID = partitionID;
     gc.maxLabelSize = std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size"));
     gc.openMode = "app";
+    gc.readOnly = true;
     NodeManager* nodeManager = new NodeManager(gc);
 
     std::string dbPrefix = nodeManager->getDbPrefix();
@@ -101,6 +106,8 @@ std::vector<std::pair<long, long>> StreamingTriangles::getEdges(unsigned int gra
         edges.push_back(std::make_pair(std::stol(relationBlock->getDestination()->id),
                                            std::stol(relationBlock->getSource()->id)));
     }
+    nodeManager->close();
+    delete nodeManager;
 
     return edges;
 }
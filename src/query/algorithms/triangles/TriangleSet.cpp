@@ -0,0 +1,94 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "TriangleSet.h"
+
+#include <cstdlib>
+#include <utility>
+
+size_t TriangleSet::PackedTriangleHash::operator()(const PackedTriangle &triangle) const {
+    // 64 bit mix (splitmix64 finalizer) of both halves
+    uint64_t hash = triangle.high * 0x9E3779B97F4A7C15ULL ^ triangle.low;
+    hash ^= hash >> 30;
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBULL;
+    hash ^= hash >> 31;
+    return static_cast<size_t>(hash);
+}
+
+void TriangleSet::sort(long &vertexOne, long &vertexTwo, long &vertexThree) {
+    if (vertexOne > vertexTwo) std::swap(vertexOne, vertexTwo);
+    if (vertexOne > vertexThree) std::swap(vertexOne, vertexThree);
+    if (vertexTwo > vertexThree) std::swap(vertexTwo, vertexThree);
+}
+
+TriangleSet::PackedTriangle TriangleSet::pack(long vertexOne, long vertexTwo, long vertexThree) {
+    // | vertexOne (42) | vertexTwo (42) | vertexThree (42) | 2 unused bits
+    uint64_t one = static_cast<uint64_t>(vertexOne);
+    uint64_t two = static_cast<uint64_t>(vertexTwo);
+    uint64_t three = static_cast<uint64_t>(vertexThree);
+    PackedTriangle triangle;
+    triangle.high = (one << (64 - VERTEX_BITS)) | (two >> (2 * VERTEX_BITS - 64));
+    triangle.low = (two << (128 - 2 * VERTEX_BITS)) | three;
+    return triangle;
+}
+
+bool TriangleSet::insert(long vertexOne, long vertexTwo, long vertexThree) {
+    sort(vertexOne, vertexTwo, vertexThree);
+    if (vertexOne < 0 || vertexThree > MAX_PACKED_VERTEX) {
+        return overflowTriangles.insert(std::make_tuple(vertexOne, vertexTwo, vertexThree)).second;
+    }
+    return packedTriangles.insert(pack(vertexOne, vertexTwo, vertexThree)).second;
+}
+
+bool TriangleSet::contains(long vertexOne, long vertexTwo, long vertexThree) const {
+    sort(vertexOne, vertexTwo, vertexThree);
+    if (vertexOne < 0 || vertexThree > MAX_PACKED_VERTEX) {
+        return overflowTriangles.find(std::make_tuple(vertexOne, vertexTwo, vertexThree)) != overflowTriangles.end();
+    }
+    return packedTriangles.find(pack(vertexOne, vertexTwo, vertexThree)) != packedTriangles.end();
+}
+
+long TriangleSet::insertAll(const std::string &triangles) {
+    long newTriangles = 0;
+    const char *cursor = triangles.c_str();
+    const char *end = cursor + triangles.size();
+
+    while (cursor < end) {
+        const char *entryEnd = cursor;
+        while (entryEnd < end && *entryEnd != ':') entryEnd++;
+
+        long vertices[3];
+        int parsed = 0;
+        const char *position = cursor;
+        while (parsed < 3 && position < entryEnd) {
+            char *next;
+            long vertex = std::strtol(position, &next, 10);
+            if (next == position) break;  // Not a number, e.g. the NILL marker
+            vertices[parsed++] = vertex;
+            position = next;
+            if (position < entryEnd && *position == ',') position++;
+        }
+        if (parsed == 3 && insert(vertices[0], vertices[1], vertices[2])) {
+            newTriangles++;
+        }
+        cursor = entryEnd + 1;
+    }
+    return newTriangles;
+}
+
+void TriangleSet::clear() {
+    packedTriangles.clear();
+    overflowTriangles.clear();
+}
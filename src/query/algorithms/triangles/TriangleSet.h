@@ -0,0 +1,71 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_TRIANGLESET_H
+#define JASMINEGRAPH_TRIANGLESET_H
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+
+/**
+ * Set of undirected triangles used to deduplicate triangles reported by several partitions or aggregators.
+ * The three vertex ids are sorted and packed into a single 128 bit key (42 bits per vertex), so a triangle costs
+ * two machine words instead of the nested map / string representation. Triangles with a vertex id outside the
+ * packable range are kept in a small exact overflow set.
+ */
+class TriangleSet {
+ public:
+    static const int VERTEX_BITS = 42;
+    static const long MAX_PACKED_VERTEX = (1L << VERTEX_BITS) - 1;
+
+    // Insert a triangle given in any vertex order. Returns true if the triangle was not in the set.
+    bool insert(long vertexOne, long vertexTwo, long vertexThree);
+
+    bool contains(long vertexOne, long vertexTwo, long vertexThree) const;
+
+    /**
+     * Insert every triangle of a "v1,v2,v3:v1,v2,v3:..." list as returned by the workers, parsing the list in
+     * place. Empty entries and the "NILL" marker are skipped. Returns the number of triangles that were new.
+     */
+    long insertAll(const std::string &triangles);
+
+    long size() const { return packedTriangles.size() + overflowTriangles.size(); }
+
+    void clear();
+
+    void reserve(size_t count) { packedTriangles.reserve(count); }
+
+ private:
+    struct PackedTriangle {
+        uint64_t high;
+        uint64_t low;
+
+        bool operator==(const PackedTriangle &other) const { return high == other.high && low == other.low; }
+    };
+
+    struct PackedTriangleHash {
+        size_t operator()(const PackedTriangle &triangle) const;
+    };
+
+    static void sort(long &vertexOne, long &vertexTwo, long &vertexThree);
+
+    static PackedTriangle pack(long vertexOne, long vertexTwo, long vertexThree);
+
+    std::unordered_set<PackedTriangle, PackedTriangleHash> packedTriangles;
+    std::set<std::tuple<long, long, long>> overflowTriangles;
+};
+
+#endif  // JASMINEGRAPH_TRIANGLESET_H
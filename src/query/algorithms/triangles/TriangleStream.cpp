@@ -0,0 +1,161 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "TriangleStream.h"
+
+#include <cstring>
+#include <utility>
+
+static const size_t HEADER_SIZE = 2 * sizeof(uint32_t);
+static const size_t MAX_VARINT_SIZE = 10;
+// Guards the receiver against corrupted headers
+static const uint32_t MAX_FRAME_PAYLOAD = 64 * 1024 * 1024;
+
+static void putVarint(std::string &buffer, uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+static bool getVarint(const char *&cursor, const char *end, uint64_t &value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && cursor < end; shift += 7) {
+        uint8_t byte = static_cast<uint8_t>(*cursor++);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint64_t zigzagEncode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static int64_t zigzagDecode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+TriangleStreamWriter::TriangleStreamWriter(ByteSink sink, size_t frameSize) {
+    this->sink = sink;
+    this->frameSize = frameSize;
+    frame.reserve(frameSize + HEADER_SIZE + 3 * MAX_VARINT_SIZE);
+    frame.resize(HEADER_SIZE);
+}
+
+bool TriangleStreamWriter::add(long vertexOne, long vertexTwo, long vertexThree) {
+    if (failed) {
+        return false;
+    }
+    if (vertexOne > vertexTwo) std::swap(vertexOne, vertexTwo);
+    if (vertexOne > vertexThree) std::swap(vertexOne, vertexThree);
+    if (vertexTwo > vertexThree) std::swap(vertexTwo, vertexThree);
+
+    putVarint(frame, zigzagEncode(static_cast<int64_t>(vertexOne) - previousVertex));
+    putVarint(frame, static_cast<uint64_t>(vertexTwo - vertexOne));
+    putVarint(frame, static_cast<uint64_t>(vertexThree - vertexTwo));
+    previousVertex = vertexOne;
+    frameTriangles++;
+    triangleCount++;
+
+    if (frame.size() - HEADER_SIZE >= frameSize) {
+        return flush();
+    }
+    return true;
+}
+
+bool TriangleStreamWriter::flush() {
+    if (failed) {
+        return false;
+    }
+    uint32_t header[2] = {static_cast<uint32_t>(frame.size() - HEADER_SIZE), frameTriangles};
+    memcpy(&frame[0], header, HEADER_SIZE);
+    if (!sink(frame.data(), frame.size())) {
+        failed = true;
+        return false;
+    }
+    bytesWritten += frame.size();
+    frame.resize(HEADER_SIZE);
+    frameTriangles = 0;
+    previousVertex = 0;
+    return true;
+}
+
+bool TriangleStreamWriter::finish() {
+    if (frameTriangles > 0 && !flush()) {
+        return false;
+    }
+    return flush();  // Empty frame marks the end of the stream
+}
+
+TriangleStreamReader::TriangleStreamReader(ByteSource source) { this->source = source; }
+
+bool TriangleStreamReader::next(std::vector<long> &triangles) {
+    triangles.clear();
+    if (finished || failed) {
+        return false;
+    }
+
+    uint32_t header[2];
+    if (!source(reinterpret_cast<char *>(header), HEADER_SIZE)) {
+        failed = true;
+        return false;
+    }
+    uint32_t payloadSize = header[0];
+    uint32_t count = header[1];
+    if (count == 0) {
+        finished = true;
+        return false;
+    }
+    if (payloadSize > MAX_FRAME_PAYLOAD) {
+        failed = true;
+        return false;
+    }
+
+    payload.resize(payloadSize);
+    if (!source(payload.data(), payloadSize) || !decodeFrame(payload.data(), payloadSize, count, triangles)) {
+        failed = true;
+        return false;
+    }
+    return true;
+}
+
+bool TriangleStreamReader::decodeFrame(const char *payload, size_t payloadSize, uint32_t count,
+                                       std::vector<long> &triangles) {
+    const char *cursor = payload;
+    const char *end = payload + payloadSize;
+    long previousVertex = 0;
+    // Every vertex takes at least one varint byte, a count the payload cannot hold comes from a corrupt header
+    if (3 * static_cast<size_t>(count) > payloadSize) {
+        return false;
+    }
+    triangles.reserve(triangles.size() + 3 * static_cast<size_t>(count));
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t first, second, third;
+        if (!getVarint(cursor, end, first) || !getVarint(cursor, end, second) || !getVarint(cursor, end, third)) {
+            return false;
+        }
+        long vertexOne = previousVertex + zigzagDecode(first);
+        long vertexTwo = vertexOne + static_cast<long>(second);
+        long vertexThree = vertexTwo + static_cast<long>(third);
+        triangles.push_back(vertexOne);
+        triangles.push_back(vertexTwo);
+        triangles.push_back(vertexThree);
+        previousVertex = vertexOne;
+    }
+    return cursor == end;
+}
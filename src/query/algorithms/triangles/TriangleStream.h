@@ -0,0 +1,88 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_TRIANGLESTREAM_H
+#define JASMINEGRAPH_TRIANGLESTREAM_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Binary stream of triangles exchanged between a triangle aggregator (worker) and the master.
+ *
+ * The stream is a sequence of frames, each starting with a header of two host order uint32 values: the payload
+ * size in bytes and the number of triangles in the frame. A frame with zero triangles marks the end of the stream.
+ * Inside a frame every triangle is stored with its vertex ids sorted, as three varints: the zigzag encoded delta of
+ * the smallest vertex to the smallest vertex of the previous triangle of the frame, followed by the (non negative)
+ * deltas of the second and third vertex. Each frame is decodable on its own, so the receiver only ever holds one
+ * frame in memory.
+ */
+class TriangleStreamWriter {
+ public:
+    // Receives encoded bytes. Returns false if the bytes could not be delivered.
+    typedef std::function<bool(const char *, size_t)> ByteSink;
+
+    static const size_t DEFAULT_FRAME_SIZE = 64 * 1024;
+
+    explicit TriangleStreamWriter(ByteSink sink, size_t frameSize = DEFAULT_FRAME_SIZE);
+
+    // Append a triangle given in any vertex order. Returns false once the sink failed.
+    bool add(long vertexOne, long vertexTwo, long vertexThree);
+
+    // Flush the pending frame and write the end of stream marker.
+    bool finish();
+
+    long getTriangleCount() { return triangleCount; }
+
+    long getBytesWritten() { return bytesWritten; }
+
+ private:
+    bool flush();
+
+    ByteSink sink;
+    size_t frameSize;
+    std::string frame;
+    uint32_t frameTriangles = 0;
+    long previousVertex = 0;
+    long triangleCount = 0;
+    long bytesWritten = 0;
+    bool failed = false;
+};
+
+class TriangleStreamReader {
+ public:
+    // Fills the buffer with exactly the requested number of bytes. Returns false on error or end of input.
+    typedef std::function<bool(char *, size_t)> ByteSource;
+
+    explicit TriangleStreamReader(ByteSource source);
+
+    /**
+     * Read the next frame and replace the contents of triangles with its vertex ids, three per triangle in
+     * ascending order. Returns false at the end of the stream or on error; use hasFailed() to tell them apart.
+     */
+    bool next(std::vector<long> &triangles);
+
+    bool hasFailed() { return failed; }
+
+    static bool decodeFrame(const char *payload, size_t payloadSize, uint32_t count, std::vector<long> &triangles);
+
+ private:
+    ByteSource source;
+    std::vector<char> payload;
+    bool finished = false;
+    bool failed = false;
+};
+
+#endif  // JASMINEGRAPH_TRIANGLESTREAM_H
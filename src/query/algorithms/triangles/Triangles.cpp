@@ -16,11 +16,13 @@ limitations under the License.
 #include <algorithm>
 #include <chrono>
 #include <ctime>
+#include <iterator>
 #include <sstream>
 #include <vector>
 
 #include "../../../localstore/JasmineGraphHashMapLocalStore.h"
 #include "../../../util/logger/Logger.h"
+#include "TriangleSet.h"
 
 Logger triangle_logger;
 
@@ -47,22 +49,34 @@ long Triangles::run(JasmineGraphHashMapLocalStore graphDB, JasmineGraphHashMapCe
 
     auto mergeBbegin = std::chrono::high_resolution_clock::now();
 
+    // The duplicate central store holds central edges that were also replicated to this partition. Only the edges
+    // missing from the central store are merged; set_difference requires sorted ranges so the unordered adjacency
+    // sets are copied into sorted vectors first.
+    std::vector<long> centralDBSecondVertices;
+    std::vector<long> duplicateSecondVertices;
+    std::vector<long> missingSecondVertices;
     for (centralDuplicateDBDegreeDistributionIterator = centralDuplicateDBDegreeDistribution.begin();
          centralDuplicateDBDegreeDistributionIterator != centralDuplicateDBDegreeDistribution.end();
          ++centralDuplicateDBDegreeDistributionIterator) {
         long centralDuplicateDBStartVid = centralDuplicateDBDegreeDistributionIterator->first;
 
-        unordered_set<long> centralDBSecondVertexSet = centralDBSubGraphMap[centralDuplicateDBStartVid];
-        unordered_set<long> duplicateSecondVertexSet = duplicateCentralDBSubGraphMap[centralDuplicateDBStartVid];
-        std::set<long> result;
+        const unordered_set<long> &duplicateSecondVertexSet = duplicateCentralDBSubGraphMap[centralDuplicateDBStartVid];
+        if (duplicateSecondVertexSet.empty()) continue;
+        unordered_set<long> &centralDBSecondVertexSet = centralDBSubGraphMap[centralDuplicateDBStartVid];
 
-        std::set_difference(duplicateSecondVertexSet.begin(), duplicateSecondVertexSet.end(),
-                            centralDBSecondVertexSet.begin(), centralDBSecondVertexSet.end(),
-                            std::inserter(result, result.end()));
+        duplicateSecondVertices.assign(duplicateSecondVertexSet.begin(), duplicateSecondVertexSet.end());
+        centralDBSecondVertices.assign(centralDBSecondVertexSet.begin(), centralDBSecondVertexSet.end());
+        std::sort(duplicateSecondVertices.begin(), duplicateSecondVertices.end());
+        std::sort(centralDBSecondVertices.begin(), centralDBSecondVertices.end());
 
-        if (result.size() > 0) {
-            centralDBDegreeDistribution[centralDuplicateDBStartVid] += result.size();
-            centralDBSubGraphMap[centralDuplicateDBStartVid].insert(result.begin(), result.end());
+        missingSecondVertices.clear();
+        std::set_difference(duplicateSecondVertices.begin(), duplicateSecondVertices.end(),
+                            centralDBSecondVertices.begin(), centralDBSecondVertices.end(),
+                            std::back_inserter(missingSecondVertices));
+
+        if (!missingSecondVertices.empty()) {
+            centralDBDegreeDistribution[centralDuplicateDBStartVid] += missingSecondVertices.size();
+            centralDBSecondVertexSet.insert(missingSecondVertices.begin(), missingSecondVertices.end());
         }
     }
 
@@ -74,8 +88,8 @@ long Triangles::run(JasmineGraphHashMapLocalStore graphDB, JasmineGraphHashMapCe
         long centralDBDegree = centralDBDegreeDistributionIterator->second;
 
         degreeDistribution[centralDBStartVid] += centralDBDegree;
-        localSubGraphMap[centralDBStartVid].insert(centralDBSubGraphMap[centralDBStartVid].begin(),
-                                                   centralDBSubGraphMap[centralDBStartVid].end());
+        const unordered_set<long> &centralDBSecondVertexSet = centralDBSubGraphMap[centralDBStartVid];
+        localSubGraphMap[centralDBStartVid].insert(centralDBSecondVertexSet.begin(), centralDBSecondVertexSet.end());
     }
 
     auto mergeEnd = std::chrono::high_resolution_clock::now();
@@ -90,8 +104,32 @@ long Triangles::run(JasmineGraphHashMapLocalStore graphDB, JasmineGraphHashMapCe
 
 TriangleResult Triangles::countTriangles(map<long, unordered_set<long>> &centralStore, map<long, long> &distributionMap,
                                          bool returnTriangles) {
-    std::map<long, std::set<long>> degreeMap;
+    TriangleResult result;
+
+    if (!returnTriangles) {
+        result.count = countTriangles(centralStore, distributionMap, TriangleCallback());
+        return result;
+    }
+
     std::basic_ostringstream<char> triangleStream;
+    result.count = countTriangles(centralStore, distributionMap, [&triangleStream](long varOne, long varTwo,
+                                                                                   long varThree) {
+        triangleStream << varOne << "," << varTwo << "," << varThree << ":";
+    });
+
+    string triangle = triangleStream.str();
+    if (triangle.empty()) {
+        result.triangles = "NILL";
+    } else {
+        triangle.erase(triangle.size() - 1);
+        result.triangles = std::move(triangle);
+    }
+    return result;
+}
+
+long Triangles::countTriangles(map<long, unordered_set<long>> &centralStore, map<long, long> &distributionMap,
+                               const TriangleCallback &triangleCallback) {
+    std::map<long, std::set<long>> degreeMap;
 
     long startVertexId;
     long degree;
@@ -104,7 +142,7 @@ TriangleResult Triangles::countTriangles(map<long, unordered_set<long>> &central
     }
 
     long triangleCount = 0;
-    std::unordered_map<long, std::unordered_map<long, std::unordered_set<long>>> triangleTree;
+    TriangleSet triangles;
 
     for (auto iterator = degreeMap.begin(); iterator != degreeMap.end(); ++iterator) {
         std::set<long> &vertices = iterator->second;
@@ -124,42 +162,13 @@ TriangleResult Triangles::countTriangles(map<long, unordered_set<long>> &central
                     std::unordered_set<long> &centralStoreNu = centralStore[nu];
                     if ((unorderedUSet.find(nu) != unorderedUSet.end()) ||
                         (centralStoreNu.find(temp) != centralStoreNu.end())) {
-                        long varOne = temp;
-                        long varTwo = u;
-                        long varThree = nu;
-                        if (varOne > varTwo) {  // swap
-                            varOne ^= varTwo;
-                            varTwo ^= varOne;
-                            varOne ^= varTwo;
-                        }
-                        if (varOne > varThree) {  // swap
-                            varOne ^= varThree;
-                            varThree ^= varOne;
-                            varOne ^= varThree;
-                        }
-                        if (varTwo > varThree) {  // swap
-                            varTwo ^= varThree;
-                            varThree ^= varTwo;
-                            varTwo ^= varThree;
-                        }
-
-                        auto &itemRes = triangleTree[varOne];
-                        auto itemResIterator = itemRes.find(varTwo);
-                        if (itemResIterator != itemRes.end()) {
-                            auto &set2 = itemRes[varTwo];
-                            auto set2Iter = set2.find(varThree);
-                            if (set2Iter == set2.end()) {
-                                set2.insert(varThree);
-                                triangleCount++;
-                                if (returnTriangles) {
-                                    triangleStream << varOne << "," << varTwo << "," << varThree << ":";
-                                }
-                            }
-                        } else {
-                            triangleTree[varOne][varTwo].insert(varThree);
+                        if (triangles.insert(temp, u, nu)) {
                             triangleCount++;
-                            if (returnTriangles) {
-                                triangleStream << varOne << "," << varTwo << "," << varThree << ":";
+                            if (triangleCallback) {
+                                long varOne = std::min(temp, std::min(u, nu));
+                                long varThree = std::max(temp, std::max(u, nu));
+                                long varTwo = temp + u + nu - varOne - varThree;
+                                triangleCallback(varOne, varTwo, varThree);
                             }
                         }
                     }
@@ -168,19 +177,5 @@ TriangleResult Triangles::countTriangles(map<long, unordered_set<long>> &central
         }
     }
 
-    TriangleResult result;
-
-    if (returnTriangles) {
-        string triangle = triangleStream.str();
-        if (triangle.empty()) {
-            result.triangles = "NILL";
-        } else {
-            triangle.erase(triangle.size() - 1);
-            result.triangles = std::move(triangle);
-        }
-    } else {
-        result.count = triangleCount;
-    }
-
-    return result;
+    return triangleCount;
 }
@@ -16,6 +16,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <chrono>
+#include <functional>
 #include <map>
 #include <set>
 #include <string>
@@ -44,8 +45,14 @@ class Triangles {
                     JasmineGraphHashMapDuplicateCentralStore duplicateCentralStore, std::string graphId,
                     std::string partitionId, int threadPriority);
 
+    // Called once for every distinct triangle found, with the vertex ids in ascending order
+    typedef std::function<void(long, long, long)> TriangleCallback;
+
     static TriangleResult countTriangles(map<long, unordered_set<long>> &centralStore,
                                              map<long, long> &distributionMap, bool returnTriangles);
+
+    static long countTriangles(map<long, unordered_set<long>> &centralStore, map<long, long> &distributionMap,
+                               const TriangleCallback &triangleCallback);
 };
 
 #endif  // JASMINEGRAPH_TRIANGLES_H
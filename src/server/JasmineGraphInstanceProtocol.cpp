@@ -53,6 +53,8 @@ const string JasmineGraphInstanceProtocol::OUT_DEGREE_DISTRIBUTION = "odd";
 const string JasmineGraphInstanceProtocol::WORKER_OUT_DEGREE_DISTRIBUTION = "odd-worker";
 const string JasmineGraphInstanceProtocol::IN_DEGREE_DISTRIBUTION = "idd";
 const string JasmineGraphInstanceProtocol::WORKER_IN_DEGREE_DISTRIBUTION = "idd-worker";
+const string JasmineGraphInstanceProtocol::OUT_DEGREE_HISTOGRAM = "odd-hist";
+const string JasmineGraphInstanceProtocol::IN_DEGREE_HISTOGRAM = "idd-hist";
 const string JasmineGraphInstanceProtocol::WORKER_PAGE_RANK_DISTRIBUTION = "pgrn-worker";
 const string JasmineGraphInstanceProtocol::EGONET = "egont";
 const string JasmineGraphInstanceProtocol::WORKER_EGO_NET = "egont-worker";
@@ -98,3 +100,13 @@ const string JasmineGraphInstanceProtocol::INITIATE_FED_PREDICT = "initiate-fed-
 const string JasmineGraphInstanceProtocol::INITIATE_STREAMING_SERVER = "initiate-streaming-server";
 const string JasmineGraphInstanceProtocol::INITIATE_STREAMING_CLIENT = "initiate-streaming-client";
 const string JasmineGraphInstanceProtocol::INITIATE_STREAMING_TRIAN = "initiate-streaming-trian";
+const string JasmineGraphInstanceProtocol::METRICS = "metrics";
+const string JasmineGraphInstanceProtocol::TRACE_ID = "trace-id";
+const string JasmineGraphInstanceProtocol::TRACE = "trace";
+const string JasmineGraphInstanceProtocol::LINK_PREDICT = "link-predict";
+const string JasmineGraphInstanceProtocol::TRAINING_PROFILE = "training-profile";
+const string JasmineGraphInstanceProtocol::VERTEX_ATTRIBUTES = "vertex-attributes";
+const string JasmineGraphInstanceProtocol::PROPERTY_INDEX = "property-index";
+const string JasmineGraphInstanceProtocol::PROPERTY_LOOKUP = "property-lookup";
+const string JasmineGraphInstanceProtocol::COMPACT_PARTITION = "compact-partition";
+const string JasmineGraphInstanceProtocol::K_HOP = "k-hop";
@@ -67,6 +67,8 @@ class JasmineGraphInstanceProtocol {
     static const string IN_DEGREE_DISTRIBUTION;
     static const string WORKER_OUT_DEGREE_DISTRIBUTION;
     static const string WORKER_IN_DEGREE_DISTRIBUTION;
+    static const string OUT_DEGREE_HISTOGRAM;  // Returns degree -> vertex count of a partition instead of per vertex data
+    static const string IN_DEGREE_HISTOGRAM;
     static const string WORKER_PAGE_RANK_DISTRIBUTION;
     static const string EGONET;
     static const string WORKER_EGO_NET;
@@ -112,6 +114,16 @@ class JasmineGraphInstanceProtocol {
     static const string INITIATE_STREAMING_SERVER;
     static const string INITIATE_STREAMING_CLIENT;
     static const string INITIATE_STREAMING_TRIAN;
+    static const string METRICS;  // Returns a snapshot of the worker metrics in the Prometheus text format
+    static const string TRACE_ID;  // Trace id of the query the following commands of the session belong to
+    static const string TRACE;     // Returns the spans the worker recorded for a trace as Chrome trace events
+    static const string LINK_PREDICT;  // Scores the unconnected vertex pairs of a partition by neighbourhood overlap
+    static const string TRAINING_PROFILE;  // Returns the resources used by the training runs since the last call
+    static const string VERTEX_ATTRIBUTES;  // Returns the attributes of vertices from the columnar attribute store
+    static const string PROPERTY_INDEX;     // Indexes a node or edge property of a partition in the native store
+    static const string PROPERTY_LOOKUP;    // Returns the nodes or edges with a property value in a value range
+    static const string COMPACT_PARTITION;  // Rewrites the native store of a partition that is not loaded
+    static const string K_HOP;              // Expands a breadth first search of the native store a level at a time
 };
 
 const int INSTANCE_DATA_LENGTH = 300;
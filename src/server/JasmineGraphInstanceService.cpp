@@ -19,8 +19,17 @@ limitations under the License.
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <sstream>
 #include <string>
 
+#include "../localstore/attribute/JasmineGraphAttributeStore.h"
+#include "../localstore/degree/JasmineGraphDegreeStore.h"
+#include "../ml/trainer/TrainingProfiler.h"
+#include "../nativestore/StoreCompactor.h"
+#include "../performance/metrics/MetricsRegistry.h"
+#include "../performance/trace/Tracer.h"
+#include "../query/algorithms/linkprediction/NeighborhoodSimilarity.h"
+#include "../query/algorithms/traversal/FrontierBFS.h"
 #include "../query/algorithms/triangles/StreamingTriangles.h"
 #include "../server/JasmineGraphServer.h"
 #include "../util/kafka/InstanceStreamHandler.h"
@@ -73,6 +82,9 @@ static void worker_out_degree_distribution_command(
 static void out_degree_distribution_command(
     int connFd, int serverPort, std::map<std::string, JasmineGraphHashMapLocalStore> graphDBMapLocalStores,
     std::map<std::string, JasmineGraphHashMapCentralStore> graphDBMapCentralStores, bool *loop_exit_p);
+static void degree_histogram_command(
+    int connFd, std::map<std::string, JasmineGraphHashMapLocalStore> graphDBMapLocalStores,
+    std::map<std::string, JasmineGraphHashMapCentralStore> graphDBMapCentralStores, bool *loop_exit_p, bool in);
 static void page_rank_command(int connFd, int serverPort,
                               std::map<std::string, JasmineGraphHashMapCentralStore> graphDBMapCentralStores,
                               bool *loop_exit_p);
@@ -117,6 +129,25 @@ static void initiate_fragment_resolution_command(int connFd, bool *loop_exit_p);
 static void check_file_accessible_command(int connFd, bool *loop_exit_p);
 static void graph_stream_start_command(int connFd, InstanceStreamHandler &instanceStreamHandler, bool *loop_exit_p);
 static void send_priority_command(int connFd, bool *loop_exit_p);
+static void metrics_command(int connFd, bool *loop_exit_p);
+static void trace_id_command(int connFd, bool *loop_exit_p);
+static void trace_command(int connFd, bool *loop_exit_p);
+static void training_profile_command(int connFd, bool *loop_exit_p);
+static void vertex_attributes_command(int connFd, bool *loop_exit_p);
+static void property_index_command(
+    int connFd, std::map<std::string, JasmineGraphIncrementalLocalStore *> &incrementalLocalStoreMap,
+    bool *loop_exit_p);
+static void property_lookup_command(
+    int connFd, std::map<std::string, JasmineGraphIncrementalLocalStore *> &incrementalLocalStoreMap,
+    bool *loop_exit_p);
+static void compact_partition_command(int connFd, bool *loop_exit_p);
+static void k_hop_command(int connFd, bool *loop_exit_p);
+static void link_predict_command(
+    int connFd, std::map<std::string, JasmineGraphHashMapLocalStore> &graphDBMapLocalStores,
+    std::map<std::string, JasmineGraphHashMapCentralStore> &graphDBMapCentralStores,
+    std::map<std::string, JasmineGraphHashMapDuplicateCentralStore> &graphDBMapDuplicateCentralStores,
+    bool *loop_exit_p);
+static void send_chunked(int connFd, const std::string &message);
 static std::string initiate_command_common(int connFd, bool *loop_exit_p);
 static void batch_upload_common(int connFd, bool *loop_exit_p, bool batch_upload);
 static void degree_distribution_common(int connFd, int serverPort,
@@ -166,6 +197,10 @@ void *instanceservicesession(void *dummyPt) {
         line = Utils::trim_copy(line);
         instance_logger.info("Received : " + line);
 
+        auto commandStart = std::chrono::steady_clock::now();
+        std::string spanName = Tracer::isEnabled() ? "worker." + line : "";
+        TraceSpan commandSpan(spanName.c_str());
+        bool knownCommand = true;
         if (line.compare(JasmineGraphInstanceProtocol::HANDSHAKE) == 0) {
             handshake_command(connFd, &loop_exit);
         } else if (line.compare(JasmineGraphInstanceProtocol::CLOSE) == 0) {
@@ -200,6 +235,10 @@ void *instanceservicesession(void *dummyPt) {
         } else if (line.compare(JasmineGraphInstanceProtocol::OUT_DEGREE_DISTRIBUTION) == 0) {
             out_degree_distribution_command(connFd, serverPort, graphDBMapLocalStores, graphDBMapCentralStores,
                                             &loop_exit);
+        } else if (line.compare(JasmineGraphInstanceProtocol::IN_DEGREE_HISTOGRAM) == 0) {
+            degree_histogram_command(connFd, graphDBMapLocalStores, graphDBMapCentralStores, &loop_exit, true);
+        } else if (line.compare(JasmineGraphInstanceProtocol::OUT_DEGREE_HISTOGRAM) == 0) {
+            degree_histogram_command(connFd, graphDBMapLocalStores, graphDBMapCentralStores, &loop_exit, false);
         } else if (line.compare(JasmineGraphInstanceProtocol::PAGE_RANK) == 0) {
             page_rank_command(connFd, serverPort, graphDBMapCentralStores, &loop_exit);
         } else if (line.compare(JasmineGraphInstanceProtocol::WORKER_PAGE_RANK_DISTRIBUTION) == 0) {
@@ -257,11 +296,41 @@ void *instanceservicesession(void *dummyPt) {
             graph_stream_start_command(connFd, streamHandler, &loop_exit);
         } else if (line.compare(JasmineGraphInstanceProtocol::SEND_PRIORITY) == 0) {
             send_priority_command(connFd, &loop_exit);
+        } else if (line.compare(JasmineGraphInstanceProtocol::METRICS) == 0) {
+            metrics_command(connFd, &loop_exit);
+        } else if (line.compare(JasmineGraphInstanceProtocol::TRACE_ID) == 0) {
+            trace_id_command(connFd, &loop_exit);
+        } else if (line.compare(JasmineGraphInstanceProtocol::TRACE) == 0) {
+            trace_command(connFd, &loop_exit);
+        } else if (line.compare(JasmineGraphInstanceProtocol::TRAINING_PROFILE) == 0) {
+            training_profile_command(connFd, &loop_exit);
+        } else if (line.compare(JasmineGraphInstanceProtocol::LINK_PREDICT) == 0) {
+            link_predict_command(connFd, graphDBMapLocalStores, graphDBMapCentralStores,
+                                 graphDBMapDuplicateCentralStores, &loop_exit);
+        } else if (line.compare(JasmineGraphInstanceProtocol::VERTEX_ATTRIBUTES) == 0) {
+            vertex_attributes_command(connFd, &loop_exit);
+        } else if (line.compare(JasmineGraphInstanceProtocol::PROPERTY_INDEX) == 0) {
+            property_index_command(connFd, incrementalLocalStoreMap, &loop_exit);
+        } else if (line.compare(JasmineGraphInstanceProtocol::PROPERTY_LOOKUP) == 0) {
+            property_lookup_command(connFd, incrementalLocalStoreMap, &loop_exit);
+        } else if (line.compare(JasmineGraphInstanceProtocol::COMPACT_PARTITION) == 0) {
+            compact_partition_command(connFd, &loop_exit);
+        } else if (line.compare(JasmineGraphInstanceProtocol::K_HOP) == 0) {
+            k_hop_command(connFd, &loop_exit);
         } else {
             instance_logger.error("Invalid command");
+            knownCommand = false;
             loop_exit = true;
         }
+        if (knownCommand) {
+            MetricsRegistry::histogram("jasminegraph_worker_command_latency_us",
+                                       "Time taken by the worker to serve an instance protocol command",
+                                       "command=\"" + line + "\"")
+                .record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                              commandStart).count());
+        }
     }
+    Tracer::setCurrentTraceId("");
     instance_logger.info("Closing thread " + to_string(pthread_self()));
     close(connFd);
     return NULL;
@@ -356,6 +425,16 @@ int deleteGraphPartition(std::string graphID, std::string partitionID) {
         Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder") + "/" + graphID +
         "_centralstore_attributes_" + partitionID;
     status |= Utils::deleteDirectory(attributeCentalStoreFilePath);
+    status |= Utils::deleteDirectory(JasmineGraphAttributeStore::getStorePath(
+        Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder"), graphID + "_attributes_" +
+        partitionID));
+    status |= Utils::deleteDirectory(JasmineGraphAttributeStore::getStorePath(
+        Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder"),
+        graphID + "_centralstore_attributes_" + partitionID));
+    string degreeStoreFilePath = JasmineGraphDegreeStore::getStorePath(
+        Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder"), graphID, partitionID);
+    status |= Utils::deleteDirectory(degreeStoreFilePath);
+    status |= Utils::deleteDirectory(degreeStoreFilePath + JasmineGraphDegreeStore::DIRTY_MARKER_SUFFIX);
     if (status == 0) {
         instance_logger.info("Graph partition and centralstore files are now deleted");
     } else {
@@ -408,6 +487,7 @@ long countLocalTriangles(
     std::map<std::string, JasmineGraphHashMapDuplicateCentralStore>::iterator duplicateCentralStoreIterator =
         graphDBMapDuplicateCentralStores.find(graphIdentifier);
 
+    TraceSpan loadSpan("worker.load_store", graphIdentifier);
     if (localMapIterator == graphDBMapLocalStores.end() &&
         JasmineGraphInstanceService::isGraphDBExists(graphId, partitionId)) {
         JasmineGraphInstanceService::loadLocalStore(graphId, partitionId, graphDBMapLocalStores);
@@ -426,8 +506,11 @@ long countLocalTriangles(
                                                                        graphDBMapDuplicateCentralStores);
     }
     duplicateCentralGraphDB = graphDBMapDuplicateCentralStores[duplicateCentralGraphIdentifier];
+    loadSpan.end();
 
+    TraceSpan countSpan("worker.count_triangles", graphIdentifier);
     result = Triangles::run(graphDB, centralGraphDB, duplicateCentralGraphDB, graphId, partitionId, threadPriority);
+    countSpan.end();
 
     instance_logger.info("###INSTANCE### Local Triangle Count : Completed: Triangles: " + to_string(result));
 
@@ -518,8 +601,98 @@ JasmineGraphHashMapCentralStore JasmineGraphInstanceService::loadCentralStore(st
     return *jasmineGraphHashMapCentralStore;
 }
 
-string JasmineGraphInstanceService::aggregateCentralStoreTriangles(std::string graphId, std::string partitionId,
-                                                                   std::string partitionIdList, int threadPriority) {
+// A sidecar marked dirty belongs to a streaming partition whose native store is ahead of it, read that store instead
+static bool buildStreamingDegreeStore(JasmineGraphDegreeStore &degreeStore, std::string graphId,
+                                      std::string partitionId) {
+    if (!degreeStore.isMarkedDirty()) {
+        return false;
+    }
+    GraphConfig gc;
+    gc.graphID = std::stoi(graphId);
+    gc.partitionID = std::stoi(partitionId);
+    gc.maxLabelSize = std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size"));
+    gc.openMode = "app";
+    gc.readOnly = true;
+    NodeManager *nodeManager = new NodeManager(gc);
+    bool built = true;
+    try {
+        degreeStore.build(nodeManager->getAdjacencyList(true), nodeManager->getAdjacencyList(false));
+    } catch (const std::exception &e) {
+        instance_logger.error("Cannot read the degrees of " + graphId + "_" + partitionId + " : " + e.what());
+        built = false;
+    }
+    nodeManager->close();
+    delete nodeManager;
+    return built;
+}
+
+JasmineGraphDegreeStore JasmineGraphInstanceService::loadDegreeStore(
+    std::string graphId, std::string partitionId,
+    std::map<std::string, JasmineGraphHashMapLocalStore> &graphDBMapLocalStores,
+    std::map<std::string, JasmineGraphHashMapCentralStore> &graphDBMapCentralStores) {
+    std::string folderLocation = Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder");
+    JasmineGraphDegreeStore degreeStore(graphId, partitionId, folderLocation);
+    if (degreeStore.load()) {
+        instance_logger.info("###INSTANCE### Degree store loaded from " + degreeStore.getStorePath());
+        return degreeStore;
+    }
+    if (buildStreamingDegreeStore(degreeStore, graphId, partitionId)) {
+        // The streaming store owns the sidecar and rewrites it when it is closed
+        return degreeStore;
+    }
+
+    instance_logger.info("###INSTANCE### Building degree store for " + graphId + "_" + partitionId);
+    std::string graphIdentifier = graphId + "_" + partitionId;
+    std::string centralGraphIdentifier = graphId + "_centralstore_" + partitionId;
+    if (graphDBMapLocalStores.find(graphIdentifier) == graphDBMapLocalStores.end() &&
+        JasmineGraphInstanceService::isGraphDBExists(graphId, partitionId)) {
+        JasmineGraphInstanceService::loadLocalStore(graphId, partitionId, graphDBMapLocalStores);
+    }
+    if (graphDBMapCentralStores.find(centralGraphIdentifier) == graphDBMapCentralStores.end() &&
+        JasmineGraphInstanceService::isInstanceCentralStoreExists(graphId, partitionId)) {
+        JasmineGraphInstanceService::loadInstanceCentralStore(graphId, partitionId, graphDBMapCentralStores);
+    }
+
+    degreeStore.build(graphDBMapLocalStores[graphIdentifier].getUnderlyingHashMap(),
+                      graphDBMapCentralStores[centralGraphIdentifier].getUnderlyingHashMap());
+    degreeStore.persist();
+    return degreeStore;
+}
+
+bool JasmineGraphInstanceService::buildDegreeStore(std::string graphId, std::string partitionId) {
+    if (!isGraphDBExists(graphId, partitionId) || !isInstanceCentralStoreExists(graphId, partitionId)) {
+        return false;
+    }
+    std::map<std::string, JasmineGraphHashMapLocalStore> graphDBMapLocalStores;
+    std::map<std::string, JasmineGraphHashMapCentralStore> graphDBMapCentralStores;
+    std::string folderLocation = Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder");
+    JasmineGraphDegreeStore degreeStore(graphId, partitionId, folderLocation);
+    loadLocalStore(graphId, partitionId, graphDBMapLocalStores);
+    loadInstanceCentralStore(graphId, partitionId, graphDBMapCentralStores);
+    degreeStore.build(graphDBMapLocalStores[graphId + "_" + partitionId].getUnderlyingHashMap(),
+                      graphDBMapCentralStores[graphId + "_centralstore_" + partitionId].getUnderlyingHashMap());
+    return degreeStore.persist();
+}
+
+static map<long, long> getCentralInDegreeDist(
+    string graphID, string partitionID,
+    std::map<std::string, JasmineGraphHashMapCentralStore> &graphDBMapCentralStores) {
+    JasmineGraphDegreeStore degreeStore(
+        graphID, partitionID, Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder"));
+    if (degreeStore.load() || buildStreamingDegreeStore(degreeStore, graphID, partitionID)) {
+        return degreeStore.getCentralInDegreeDistribution();
+    }
+
+    // No sidecar for this partition on this worker, fall back to the central store itself
+    if (JasmineGraphInstanceService::isInstanceCentralStoreExists(graphID, partitionID)) {
+        JasmineGraphInstanceService::loadInstanceCentralStore(graphID, partitionID, graphDBMapCentralStores);
+    }
+    return graphDBMapCentralStores[graphID + "_centralstore_" + partitionID].getInDegreeDistributionHashMap();
+}
+
+long JasmineGraphInstanceService::aggregateCentralStoreTriangles(std::string graphId, std::string partitionId,
+                                                                 std::string partitionIdList, int threadPriority,
+                                                                 TriangleStreamWriter &triangleWriter) {
     instance_logger.info("###INSTANCE### Started Aggregating Central Store Triangles");
     std::string aggregatorFilePath = Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.aggregatefolder");
     std::vector<std::string> fileNames;
@@ -538,11 +711,9 @@ string JasmineGraphInstanceService::aggregateCentralStoreTriangles(std::string g
     for (workerCentalGraphIterator = workerCentralGraphMap.begin();
          workerCentalGraphIterator != workerCentralGraphMap.end(); ++workerCentalGraphIterator) {
         long startVid = workerCentalGraphIterator->first;
-        unordered_set<long> endVidSet = workerCentalGraphIterator->second;
+        const unordered_set<long> &endVidSet = workerCentalGraphIterator->second;
 
-        unordered_set<long> aggregatedEndVidSet = aggregatedCentralStore[startVid];
-        aggregatedEndVidSet.insert(endVidSet.begin(), endVidSet.end());
-        aggregatedCentralStore[startVid] = aggregatedEndVidSet;
+        aggregatedCentralStore[startVid].insert(endVidSet.begin(), endVidSet.end());
     }
 
     std::vector<std::string> paritionIdList = Utils::split(partitionIdList, ',');
@@ -563,11 +734,9 @@ string JasmineGraphInstanceService::aggregateCentralStoreTriangles(std::string g
             for (centralGraphMapIterator = centralGraphMap.begin(); centralGraphMapIterator != centralGraphMap.end();
                  ++centralGraphMapIterator) {
                 long startVid = centralGraphMapIterator->first;
-                unordered_set<long> endVidSet = centralGraphMapIterator->second;
+                const unordered_set<long> &endVidSet = centralGraphMapIterator->second;
 
-                unordered_set<long> aggregatedEndVidSet = aggregatedCentralStore[startVid];
-                aggregatedEndVidSet.insert(endVidSet.begin(), endVidSet.end());
-                aggregatedCentralStore[startVid] = aggregatedEndVidSet;
+                aggregatedCentralStore[startVid].insert(endVidSet.begin(), endVidSet.end());
             }
         }
     }
@@ -577,13 +746,16 @@ string JasmineGraphInstanceService::aggregateCentralStoreTriangles(std::string g
     map<long, long> distributionHashMap =
         JasmineGraphInstanceService::getOutDegreeDistributionHashMap(aggregatedCentralStore);
 
-    const TriangleResult &triangleResult = Triangles::countTriangles(aggregatedCentralStore, distributionHashMap, true);
-    return triangleResult.triangles;
+    return Triangles::countTriangles(aggregatedCentralStore, distributionHashMap,
+                                     [&triangleWriter](long varOne, long varTwo, long varThree) {
+                                         triangleWriter.add(varOne, varTwo, varThree);
+                                     });
 }
 
-string JasmineGraphInstanceService::aggregateCompositeCentralStoreTriangles(std::string compositeFileList,
-                                                                            std::string availableFileList,
-                                                                            int threadPriority) {
+long JasmineGraphInstanceService::aggregateCompositeCentralStoreTriangles(std::string compositeFileList,
+                                                                          std::string availableFileList,
+                                                                          int threadPriority,
+                                                                          TriangleStreamWriter &triangleWriter) {
     instance_logger.info("###INSTANCE### Started Aggregating Composite Central Store Triangles");
     std::string aggregatorFilePath = Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.aggregatefolder");
     std::string dataFolder = Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder");
@@ -611,11 +783,9 @@ string JasmineGraphInstanceService::aggregateCompositeCentralStoreTriangles(std:
                  compositeCentralGraphMapIterator != compositeCentralGraphMap.end();
                  ++compositeCentralGraphMapIterator) {
                 long startVid = compositeCentralGraphMapIterator->first;
-                unordered_set<long> endVidSet = compositeCentralGraphMapIterator->second;
+                const unordered_set<long> &endVidSet = compositeCentralGraphMapIterator->second;
 
-                unordered_set<long> aggregatedEndVidSet = aggregatedCompositeCentralStore[startVid];
-                aggregatedEndVidSet.insert(endVidSet.begin(), endVidSet.end());
-                aggregatedCompositeCentralStore[startVid] = aggregatedEndVidSet;
+                aggregatedCompositeCentralStore[startVid].insert(endVidSet.begin(), endVidSet.end());
             }
         }
     }
@@ -637,11 +807,9 @@ string JasmineGraphInstanceService::aggregateCompositeCentralStoreTriangles(std:
             for (centralGraphMapIterator = centralGraphMap.begin(); centralGraphMapIterator != centralGraphMap.end();
                  ++centralGraphMapIterator) {
                 long startVid = centralGraphMapIterator->first;
-                unordered_set<long> endVidSet = centralGraphMapIterator->second;
+                const unordered_set<long> &endVidSet = centralGraphMapIterator->second;
 
-                unordered_set<long> aggregatedEndVidSet = aggregatedCompositeCentralStore[startVid];
-                aggregatedEndVidSet.insert(endVidSet.begin(), endVidSet.end());
-                aggregatedCompositeCentralStore[startVid] = aggregatedEndVidSet;
+                aggregatedCompositeCentralStore[startVid].insert(endVidSet.begin(), endVidSet.end());
             }
         }
     }
@@ -651,11 +819,10 @@ string JasmineGraphInstanceService::aggregateCompositeCentralStoreTriangles(std:
     map<long, long> distributionHashMap =
         JasmineGraphInstanceService::getOutDegreeDistributionHashMap(aggregatedCompositeCentralStore);
 
-    TriangleResult triangleResult =
-        Triangles::countTriangles(aggregatedCompositeCentralStore, distributionHashMap, true);
-    std::string triangles = triangleResult.triangles;
-
-    return triangles;
+    return Triangles::countTriangles(aggregatedCompositeCentralStore, distributionHashMap,
+                                     [&triangleWriter](long varOne, long varTwo, long varThree) {
+                                         triangleWriter.add(varOne, varTwo, varThree);
+                                     });
 }
 
 map<long, long> JasmineGraphInstanceService::getOutDegreeDistributionHashMap(map<long, unordered_set<long>> graphMap) {
@@ -1261,12 +1428,7 @@ map<long, long> calculateOutDegreeDist(string graphID, string partitionID, int s
 
     string instanceDataFolderLocation = Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder");
     string attributeFilePart = instanceDataFolderLocation + "/" + graphID + "_odd_" + partitionID;
-    ofstream partfile;
-    partfile.open(attributeFilePart, std::fstream::trunc);
-    for (map<long, long>::iterator it = degreeDistribution.begin(); it != degreeDistribution.end(); ++it) {
-        partfile << to_string(it->first) << "\t" << to_string(it->second) << endl;
-    }
-    partfile.close();
+    JasmineGraphDegreeStore::writeDistribution(attributeFilePart, degreeDistribution);
 
     graphDBMapLocalStores.clear();
     graphDBMapCentralStores.clear();
@@ -1280,40 +1442,9 @@ map<long, long> calculateLocalOutDegreeDist(
     std::map<std::string, JasmineGraphHashMapCentralStore> graphDBMapCentralStores) {
     auto t_start = std::chrono::high_resolution_clock::now();
 
-    JasmineGraphHashMapLocalStore graphDB;
-    JasmineGraphHashMapCentralStore centralDB;
-    std::map<std::string, JasmineGraphHashMapLocalStore>::iterator it;
-    std::map<std::string, JasmineGraphHashMapCentralStore>::iterator itcen;
-
-    if (JasmineGraphInstanceService::isGraphDBExists(graphID, partitionID)) {
-        JasmineGraphInstanceService::loadLocalStore(graphID, partitionID, graphDBMapLocalStores);
-    }
-
-    if (JasmineGraphInstanceService::isInstanceCentralStoreExists(graphID, partitionID)) {
-        JasmineGraphInstanceService::loadInstanceCentralStore(graphID, partitionID, graphDBMapCentralStores);
-    }
-
-    graphDB = graphDBMapLocalStores[graphID + "_" + partitionID];
-    centralDB = graphDBMapCentralStores[graphID + "_centralstore_" + partitionID];
-
-    map<long, long> degreeDistributionLocal = graphDB.getOutDegreeDistributionHashMap();
-    std::map<long, long>::iterator itlocal;
-
-    std::map<long, unordered_set<long>>::iterator itcentral;
-
-    map<long, long> degreeDistributionCentralTotal;
-
-    map<long, unordered_set<long>> centralGraphMap = centralDB.getUnderlyingHashMap();
-    map<long, unordered_set<long>> localGraphMap = graphDB.getUnderlyingHashMap();
-
-    for (itcentral = centralGraphMap.begin(); itcentral != centralGraphMap.end(); ++itcentral) {
-        long distribution = (itcentral->second).size();
-        map<long, long>::iterator degreeDistributionLocalItr = degreeDistributionLocal.find(itcentral->first);
-        if (degreeDistributionLocalItr != degreeDistributionLocal.end()) {
-            long degreeDistributionValue = degreeDistributionLocalItr->second;
-            degreeDistributionLocal[degreeDistributionLocalItr->first] = degreeDistributionValue + distribution;
-        }
-    }
+    JasmineGraphDegreeStore degreeStore = JasmineGraphInstanceService::loadDegreeStore(
+        graphID, partitionID, graphDBMapLocalStores, graphDBMapCentralStores);
+    map<long, long> degreeDistributionLocal = degreeStore.getOutDegreeDistribution();
 
     auto t_end = std::chrono::high_resolution_clock::now();
     double elapsed_time_ms = std::chrono::duration<double, std::milli>(t_end - t_start).count();
@@ -1325,20 +1456,9 @@ map<long, long> calculateLocalOutDegreeDist(
 map<long, long> calculateLocalInDegreeDist(
     string graphID, string partitionID, std::map<std::string, JasmineGraphHashMapLocalStore> graphDBMapLocalStores,
     std::map<std::string, JasmineGraphHashMapCentralStore> graphDBMapCentralStores) {
-    JasmineGraphHashMapLocalStore graphDB;
-
-    std::map<std::string, JasmineGraphHashMapLocalStore>::iterator it;
-
-    if (JasmineGraphInstanceService::isGraphDBExists(graphID, partitionID)) {
-        JasmineGraphInstanceService::loadLocalStore(graphID, partitionID, graphDBMapLocalStores);
-    }
-
-    graphDB = graphDBMapLocalStores[graphID + "_" + partitionID];
-
-    map<long, long> degreeDistribution = graphDB.getInDegreeDistributionHashMap();
-    std::map<long, long>::iterator its;
-
-    return degreeDistribution;
+    JasmineGraphDegreeStore degreeStore = JasmineGraphInstanceService::loadDegreeStore(
+        graphID, partitionID, graphDBMapLocalStores, graphDBMapCentralStores);
+    return degreeStore.getLocalInDegreeDistribution();
 }
 
 map<long, long> calculateInDegreeDist(string graphID, string partitionID, int serverPort,
@@ -1361,16 +1481,8 @@ map<long, long> calculateInDegreeDist(string graphID, string partitionID, int se
         }
         string workerPartitionID = workerSocketPair[2];
 
-        JasmineGraphHashMapCentralStore centralDB;
-
-        std::map<std::string, JasmineGraphHashMapCentralStore>::iterator itcen;
-
-        if (JasmineGraphInstanceService::isInstanceCentralStoreExists(graphID, workerPartitionID)) {
-            JasmineGraphInstanceService::loadInstanceCentralStore(graphID, workerPartitionID, graphDBMapCentralStores);
-        }
-        centralDB = graphDBMapCentralStores[graphID + "_centralstore_" + workerPartitionID];
-
-        map<long, long> degreeDistributionCentral = centralDB.getInDegreeDistributionHashMap();
+        map<long, long> degreeDistributionCentral =
+            getCentralInDegreeDist(graphID, workerPartitionID, graphDBMapCentralStores);
         std::map<long, long>::iterator itcentral;
         std::map<long, long>::iterator its;
 
@@ -1400,12 +1512,7 @@ map<long, long> calculateInDegreeDist(string graphID, string partitionID, int se
 
     string instanceDataFolderLocation = Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder");
     string attributeFilePart = instanceDataFolderLocation + "/" + graphID + "_idd_" + partitionID;
-    ofstream partfile;
-    partfile.open(attributeFilePart, std::fstream::trunc);
-    for (map<long, long>::iterator it = degreeDistribution.begin(); it != degreeDistribution.end(); ++it) {
-        partfile << to_string(it->first) << "\t" << to_string(it->second) << endl;
-    }
-    partfile.close();
+    JasmineGraphDegreeStore::writeDistribution(attributeFilePart, degreeDistribution);
 
     degreeDistribution.clear();
     return degreeDistribution;
@@ -1713,29 +1820,10 @@ map<long, double> calculateLocalPageRank(string graphID, double alpha, string pa
 
     for (int partitionID = 0; partitionID < parCount; ++partitionID) {
         std::string iddFilePath = aggregatorFilePath + "/" + graphID + "_idd_" + std::to_string(partitionID);
-        std::ifstream dataFile;
-        dataFile.open(iddFilePath);
-
-        while (!dataFile.eof()) {
-            std::string line;
-            std::getline(dataFile, line);
-            std::stringstream buffer(line);
-            std::string temp;
-            std::vector<long> values;
-
-            while (getline(buffer, temp, '\t')) {
-                values.push_back(::strtod(temp.c_str(), nullptr));
-            }
-
-            if (values.size() == 2) {
-                long nodeID = values[0];
-                long iddValue = values[1];
-
-                inDegreeDistribution[nodeID] = std::max(inDegreeDistribution[nodeID], iddValue);
-            }
+        map<long, long> partitionInDegreeDistribution = JasmineGraphDegreeStore::readDistribution(iddFilePath);
+        for (auto it = partitionInDegreeDistribution.begin(); it != partitionInDegreeDistribution.end(); ++it) {
+            inDegreeDistribution[it->first] = std::max(inDegreeDistribution[it->first], it->second);
         }
-
-        dataFile.close();
     }
 
     string instanceDataFolderLocation = Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder");
@@ -2005,10 +2093,16 @@ void JasmineGraphInstanceService::initClient(string trainData) {
         Utils::getJasmineGraphProperty("org.jasminegraph.fl.org.port") + " >>" + log_file + " 2>&1";
 
     instance_logger.info("Executing : " + command);
-    int exit_status = system(command.c_str());
+    TrainingProfile profile;
+    profile.model = TrainingProfiler::FL_CLIENT_MODEL;
+    profile.graphId = graphID;
+    profile.partitionId = partitionID;
+    int exit_status = TrainingProfiler::run(command, profile);
     chmod(log_file.c_str(), 0666);
     if (exit_status == -1) {
         instance_logger.error("Could not start python client");
+    } else {
+        TrainingProfiler::record(profile);
     }
 }
 
@@ -2189,6 +2283,26 @@ static void batch_upload_common(int connFd, bool *loop_exit_p, bool batch_upload
         return;
     }
     instance_logger.info("Sent : " + JasmineGraphInstanceProtocol::BATCH_UPLOAD_ACK);
+
+    // Cache the degree distribution of the partition once both its local and central stores are in place
+    string uploadedPartitionID = rawname.substr(rawname.find_last_of("_") + 1);
+    if (Utils::is_number(uploadedPartitionID) && (rawname == graphID + "_" + uploadedPartitionID ||
+                                                  rawname == graphID + "_centralstore_" + uploadedPartitionID)) {
+        if (JasmineGraphInstanceService::buildDegreeStore(graphID, uploadedPartitionID)) {
+            instance_logger.info("Degree store created for partition " + graphID + "_" + uploadedPartitionID);
+        }
+    }
+
+    // Keep a columnar copy of the attributes next to the text file for the attribute lookups
+    if (Utils::is_number(uploadedPartitionID) &&
+        (rawname == graphID + "_attributes_" + uploadedPartitionID ||
+         rawname == graphID + "_centralstore_attributes_" + uploadedPartitionID)) {
+        string storePath = JasmineGraphAttributeStore::getStorePath(
+            Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder"), rawname);
+        if (JasmineGraphAttributeStore::convertTextFile(fullFilePath, storePath)) {
+            instance_logger.info("Attribute store created for " + rawname);
+        }
+    }
 }
 
 static void batch_upload_command(int connFd, bool *loop_exit_p) { batch_upload_common(connFd, loop_exit_p, true); }
@@ -2359,16 +2473,8 @@ static void worker_in_degree_distribution_command(
         }
         string workerPartitionID = workerSocketPair[2];
 
-        JasmineGraphHashMapCentralStore centralDB;
-
-        std::map<std::string, JasmineGraphHashMapCentralStore>::iterator itcen;
-
-        if (JasmineGraphInstanceService::isInstanceCentralStoreExists(graphID, workerPartitionID)) {
-            JasmineGraphInstanceService::loadInstanceCentralStore(graphID, workerPartitionID, graphDBMapCentralStores);
-        }
-        centralDB = graphDBMapCentralStores[graphID + "_centralstore_" + workerPartitionID];
-
-        map<long, long> degreeDistributionCentral = centralDB.getInDegreeDistributionHashMap();
+        map<long, long> degreeDistributionCentral =
+            getCentralInDegreeDist(graphID, workerPartitionID, graphDBMapCentralStores);
         std::map<long, long>::iterator itcentral;
         std::map<long, long>::iterator its;
 
@@ -2391,12 +2497,7 @@ static void worker_in_degree_distribution_command(
 
     string instanceDataFolderLocation = Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder");
     string attributeFilePart = instanceDataFolderLocation + "/" + graphID + "_idd_" + partitionID;
-    ofstream partfile;
-    partfile.open(attributeFilePart, std::fstream::trunc);
-    for (map<long, long>::iterator it = degreeDistribution.begin(); it != degreeDistribution.end(); ++it) {
-        partfile << to_string(it->first) << "\t" << to_string(it->second) << endl;
-    }
-    partfile.close();
+    JasmineGraphDegreeStore::writeDistribution(attributeFilePart, degreeDistribution);
 
     *loop_exit_p = true;
 }
@@ -2487,12 +2588,7 @@ static void worker_out_degree_distribution_command(
 
     string instanceDataFolderLocation = Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder");
     string attributeFilePart = instanceDataFolderLocation + "/" + graphID + "_odd_" + partitionID;
-    ofstream partfile;
-    partfile.open(attributeFilePart, std::fstream::trunc);
-    for (map<long, long>::iterator it = degreeDistribution.begin(); it != degreeDistribution.end(); ++it) {
-        partfile << to_string(it->first) << "\t" << to_string(it->second) << endl;
-    }
-    partfile.close();
+    JasmineGraphDegreeStore::writeDistribution(attributeFilePart, degreeDistribution);
 }
 
 static void out_degree_distribution_command(
@@ -2501,6 +2597,92 @@ static void out_degree_distribution_command(
     degree_distribution_common(connFd, serverPort, graphDBMapLocalStores, graphDBMapCentralStores, loop_exit_p, false);
 }
 
+static void degree_histogram_command(
+    int connFd, std::map<std::string, JasmineGraphHashMapLocalStore> graphDBMapLocalStores,
+    std::map<std::string, JasmineGraphHashMapCentralStore> graphDBMapCentralStores, bool *loop_exit_p, bool in) {
+    if (!Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::OK)) {
+        *loop_exit_p = true;
+        return;
+    }
+    instance_logger.info("Sent : " + JasmineGraphInstanceProtocol::OK);
+
+    char data[DATA_BUFFER_SIZE];
+    string graphID = Utils::read_str_trim_wrapper(connFd, data, INSTANCE_DATA_LENGTH);
+    instance_logger.info("Received Graph ID: " + graphID);
+
+    if (!Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::OK)) {
+        *loop_exit_p = true;
+        return;
+    }
+    instance_logger.info("Sent : " + JasmineGraphInstanceProtocol::OK);
+
+    string partitionID = Utils::read_str_trim_wrapper(connFd, data, INSTANCE_DATA_LENGTH);
+    instance_logger.info("Received Partition ID: " + partitionID);
+
+    if (!Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::OK)) {
+        *loop_exit_p = true;
+        return;
+    }
+    instance_logger.info("Sent : " + JasmineGraphInstanceProtocol::OK);
+
+    string workerList = Utils::read_str_trim_wrapper(connFd, data, INSTANCE_DATA_LENGTH);
+    instance_logger.info("Received Worker List " + workerList);
+
+    JasmineGraphDegreeStore degreeStore = JasmineGraphInstanceService::loadDegreeStore(
+        graphID, partitionID, graphDBMapLocalStores, graphDBMapCentralStores);
+    // Only vertices owned by this partition are counted so that the histograms of all partitions can be summed
+    map<long, long> degreeDistribution = degreeStore.getOutDegreeDistribution();
+    if (in) {
+        map<long, long> localInDegreeDistribution = degreeStore.getLocalInDegreeDistribution();
+        for (auto it = degreeDistribution.begin(); it != degreeDistribution.end(); ++it) {
+            auto localItr = localInDegreeDistribution.find(it->first);
+            it->second = localItr == localInDegreeDistribution.end() ? 0 : localItr->second;
+        }
+
+        std::vector<string> workerSockets = Utils::split(workerList, ',');
+        for (auto workerIt = workerSockets.begin(); workerIt != workerSockets.end(); ++workerIt) {
+            std::vector<string> workerSocketPair = Utils::split(*workerIt, ':');
+            if (workerSocketPair.size() < 3) {
+                continue;
+            }
+            map<long, long> degreeDistributionCentral =
+                getCentralInDegreeDist(graphID, workerSocketPair[2], graphDBMapCentralStores);
+            for (auto it = degreeDistributionCentral.begin(); it != degreeDistributionCentral.end(); ++it) {
+                auto ownedItr = degreeDistribution.find(it->first);
+                if (ownedItr != degreeDistribution.end()) {
+                    ownedItr->second += it->second;
+                }
+            }
+        }
+    }
+
+    map<long, long> degreeHistogram = JasmineGraphDegreeStore::toHistogram(degreeDistribution);
+    instance_logger.info("Degree histogram buckets: " + to_string(degreeHistogram.size()));
+    string histogram = JasmineGraphDegreeStore::histogramToString(degreeHistogram);
+
+    std::vector<std::string> chunksVector;
+    for (unsigned i = 0; i < histogram.length() || i == 0; i += CHUNK_OFFSET) {
+        std::string chunk = histogram.substr(i, CHUNK_OFFSET);
+        if (i + CHUNK_OFFSET < histogram.length()) {
+            chunk += "/SEND";
+        } else {
+            chunk += "/CMPT";
+        }
+        chunksVector.push_back(chunk);
+    }
+
+    for (int loopCount = 0; loopCount < chunksVector.size(); loopCount++) {
+        if (loopCount > 0) {
+            Utils::read_str_wrapper(connFd, data, INSTANCE_DATA_LENGTH, false);
+        }
+        if (!Utils::send_str_wrapper(connFd, chunksVector.at(loopCount))) {
+            *loop_exit_p = true;
+            return;
+        }
+    }
+    *loop_exit_p = true;
+}
+
 static void page_rank_command(int connFd, int serverPort,
                               std::map<std::string, JasmineGraphHashMapCentralStore> graphDBMapCentralStores,
                               bool *loop_exit_p) {
@@ -3323,8 +3505,11 @@ static void aggregate_centralstore_triangles_command(int connFd, bool *loop_exit
         threadPriorityMutex.unlock();
     }
 
-    std::string aggregatedTriangles = JasmineGraphInstanceService::aggregateCentralStoreTriangles(
-        graphId, partitionId, partitionIdList, threadPriority);
+    // Triangles are streamed to the master in binary frames while they are being counted
+    TriangleStreamWriter triangleWriter(
+        [connFd](const char *bytes, size_t size) { return Utils::send_wrapper(connFd, bytes, size); });
+    JasmineGraphInstanceService::aggregateCentralStoreTriangles(graphId, partitionId, partitionIdList,
+                                                                threadPriority, triangleWriter);
 
     if (threadPriority > Conts::DEFAULT_THREAD_PRIORITY) {
         threadPriorityMutex.lock();
@@ -3336,33 +3521,12 @@ static void aggregate_centralstore_triangles_command(int connFd, bool *loop_exit
         threadPriorityMutex.unlock();
     }
 
-    std::vector<std::string> chunksVector;
-
-    for (unsigned i = 0; i < aggregatedTriangles.length(); i += CHUNK_OFFSET) {
-        std::string chunk = aggregatedTriangles.substr(i, CHUNK_OFFSET);
-        if (i + CHUNK_OFFSET < aggregatedTriangles.length()) {
-            chunk += "/SEND";
-        } else {
-            chunk += "/CMPT";
-        }
-        chunksVector.push_back(chunk);
-    }
-
-    for (int loopCount = 0; loopCount < chunksVector.size(); loopCount++) {
-        if (loopCount == 0) {
-            std::string chunk = chunksVector.at(loopCount);
-            if (!Utils::send_str_wrapper(connFd, chunk)) {
-                *loop_exit_p = true;
-                return;
-            }
-        } else {
-            string chunkStatus = Utils::read_str_wrapper(connFd, data, INSTANCE_DATA_LENGTH, false);
-            std::string chunk = chunksVector.at(loopCount);
-            if (!Utils::send_str_wrapper(connFd, chunk)) {
-                *loop_exit_p = true;
-            }
-        }
+    if (!triangleWriter.finish()) {
+        *loop_exit_p = true;
+        return;
     }
+    instance_logger.info("Sent " + std::to_string(triangleWriter.getTriangleCount()) + " triangles in " +
+                         std::to_string(triangleWriter.getBytesWritten()) + " bytes");
 }
 
 static void aggregate_streaming_centralstore_triangles_command(
@@ -3522,8 +3686,10 @@ static void aggregate_composite_centralstore_triangles_command(int connFd, bool
         threadPriorityMutex.unlock();
     }
 
-    std::string aggregatedTriangles =
-        JasmineGraphInstanceService::aggregateCompositeCentralStoreTriangles(response, availableFiles, threadPriority);
+    TriangleStreamWriter triangleWriter(
+        [connFd](const char *bytes, size_t size) { return Utils::send_wrapper(connFd, bytes, size); });
+    JasmineGraphInstanceService::aggregateCompositeCentralStoreTriangles(response, availableFiles, threadPriority,
+                                                                         triangleWriter);
 
     if (threadPriority > Conts::DEFAULT_THREAD_PRIORITY) {
         threadPriorityMutex.lock();
@@ -3535,33 +3701,12 @@ static void aggregate_composite_centralstore_triangles_command(int connFd, bool
         threadPriorityMutex.unlock();
     }
 
-    std::vector<std::string> chunksVector;
-
-    for (unsigned i = 0; i < aggregatedTriangles.length(); i += CHUNK_OFFSET) {
-        std::string chunk = aggregatedTriangles.substr(i, CHUNK_OFFSET);
-        if (i + CHUNK_OFFSET < aggregatedTriangles.length()) {
-            chunk += "/SEND";
-        } else {
-            chunk += "/CMPT";
-        }
-        chunksVector.push_back(chunk);
-    }
-
-    for (int loopCount = 0; loopCount < chunksVector.size(); loopCount++) {
-        if (loopCount == 0) {
-            std::string chunk = chunksVector.at(loopCount);
-            if (!Utils::send_str_wrapper(connFd, chunk)) {
-                *loop_exit_p = true;
-                return;
-            }
-        } else {
-            string chunkStatus = Utils::read_str_wrapper(connFd, data, INSTANCE_DATA_LENGTH, false);
-            std::string chunk = chunksVector.at(loopCount);
-            if (!Utils::send_str_wrapper(connFd, chunk)) {
-                *loop_exit_p = true;
-            }
-        }
+    if (!triangleWriter.finish()) {
+        *loop_exit_p = true;
+        return;
     }
+    instance_logger.info("Sent " + std::to_string(triangleWriter.getTriangleCount()) + " triangles in " +
+                         std::to_string(triangleWriter.getBytesWritten()) + " bytes");
 }
 
 static void performance_statistics_command(int connFd, bool *loop_exit_p) {
@@ -4236,6 +4381,394 @@ static void send_priority_command(int connFd, bool *loop_exit_p) {
     highestPriority = retrievedPriority;
 }
 
+// Send a message longer than INSTANCE_DATA_LENGTH as "/SEND" terminated chunks followed by a "/CMPT" chunk
+static void send_chunked(int connFd, const std::string &message) {
+    char data[DATA_BUFFER_SIZE];
+    std::vector<std::string> chunksVector;
+    for (unsigned i = 0; i < message.length() || i == 0; i += CHUNK_OFFSET) {
+        std::string chunk = message.substr(i, CHUNK_OFFSET);
+        if (i + CHUNK_OFFSET < message.length()) {
+            chunk += "/SEND";
+        } else {
+            chunk += "/CMPT";
+        }
+        chunksVector.push_back(chunk);
+    }
+
+    for (int loopCount = 0; loopCount < chunksVector.size(); loopCount++) {
+        if (loopCount > 0) {
+            Utils::read_str_wrapper(connFd, data, INSTANCE_DATA_LENGTH, false);
+        }
+        if (!Utils::send_str_wrapper(connFd, chunksVector.at(loopCount))) {
+            break;
+        }
+    }
+}
+
+static void metrics_command(int connFd, bool *loop_exit_p) {
+    send_chunked(connFd, MetricsRegistry::snapshot());
+    *loop_exit_p = true;
+}
+
+static void training_profile_command(int connFd, bool *loop_exit_p) {
+    send_chunked(connFd, TrainingProfiler::serialize(TrainingProfiler::drain()));
+    *loop_exit_p = true;
+}
+
+static void vertex_attributes_command(int connFd, bool *loop_exit_p) {
+    *loop_exit_p = true;
+    if (!Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::OK)) {
+        return;
+    }
+
+    // graph id|partition id|comma separated vertex ids, all the vertices of the partition when there are none
+    char data[DATA_BUFFER_SIZE];
+    string request = Utils::read_str_trim_wrapper(connFd, data, INSTANCE_DATA_LENGTH);
+    std::vector<std::string> parameters = Utils::split(request, '|');
+    if (parameters.size() < 2 || parameters.size() > 3) {
+        instance_logger.error("Invalid vertex attribute request " + request);
+        send_chunked(connFd, "");
+        return;
+    }
+
+    string dataFolder = Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder");
+    JasmineGraphAttributeStore attributeStore(
+        JasmineGraphAttributeStore::getStorePath(dataFolder, parameters[0] + "_attributes_" + parameters[1]));
+    if (!attributeStore.open()) {
+        instance_logger.warn("No attribute store for partition " + parameters[0] + "_" + parameters[1]);
+        send_chunked(connFd, "");
+        return;
+    }
+
+    std::vector<long> rows;
+    if (parameters.size() == 3 && !parameters[2].empty()) {
+        for (auto &vertex : Utils::split(parameters[2], ',')) {
+            long row = Utils::is_number(vertex) ? attributeStore.getRowIndex(std::stol(vertex)) : -1;
+            if (row >= 0) {
+                rows.push_back(row);
+            }
+        }
+    } else {
+        for (long row = 0; row < attributeStore.size(); row++) {
+            rows.push_back(row);
+        }
+    }
+
+    // Same layout as the text attribute files, the vertex and a tab followed by the attributes
+    std::ostringstream result;
+    for (long row : rows) {
+        result << attributeStore.getVertex(row) << "\t";
+        std::vector<std::string> values = attributeStore.getRowValues(row);
+        for (size_t i = 0; i < values.size(); i++) {
+            result << (i == 0 ? "" : " ") << values[i];
+        }
+        result << "\n";
+    }
+    send_chunked(connFd, result.str());
+}
+
+static NodeManager *property_request_store(
+    const std::vector<std::string> &parameters,
+    std::map<std::string, JasmineGraphIncrementalLocalStore *> &incrementalLocalStoreMap) {
+    auto store = incrementalLocalStoreMap.find(parameters[0] + "_" + parameters[1]);
+    if (store != incrementalLocalStoreMap.end()) {
+        return store->second->nm;
+    }
+    return JasmineGraphInstanceService::loadStreamingStore(parameters[0], parameters[1], incrementalLocalStoreMap,
+                                                           "app")->nm;
+}
+
+static void property_index_command(
+    int connFd, std::map<std::string, JasmineGraphIncrementalLocalStore *> &incrementalLocalStoreMap,
+    bool *loop_exit_p) {
+    *loop_exit_p = true;
+    if (!Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::OK)) {
+        return;
+    }
+
+    // graph id|partition id|node or edge|property|hash or ordered
+    char data[DATA_BUFFER_SIZE];
+    string request = Utils::read_str_trim_wrapper(connFd, data, INSTANCE_DATA_LENGTH);
+    std::vector<std::string> parameters = Utils::split(request, '|');
+    bool validType = false;
+    PropertyIndex::Type type = parameters.size() == 5 ? PropertyIndex::parseType(parameters[4], validType)
+                                                      : PropertyIndex::HASH;
+    if (!validType || (parameters[2] != "node" && parameters[2] != "edge")) {
+        instance_logger.error("Invalid property index request " + request);
+        Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::ERROR);
+        return;
+    }
+
+    NodeManager *nodeManager = property_request_store(parameters, incrementalLocalStoreMap);
+    bool created = nodeManager->createPropertyIndex(parameters[2] == "edge", parameters[3], type);
+    Utils::send_str_wrapper(connFd, created ? JasmineGraphInstanceProtocol::OK : JasmineGraphInstanceProtocol::ERROR);
+}
+
+static void property_lookup_command(
+    int connFd, std::map<std::string, JasmineGraphIncrementalLocalStore *> &incrementalLocalStoreMap,
+    bool *loop_exit_p) {
+    *loop_exit_p = true;
+    if (!Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::OK)) {
+        return;
+    }
+
+    // graph id|partition id|node or edge|property|value, or |from|to for the values in a range of an ordered index
+    // where an empty bound leaves the range open
+    char data[DATA_BUFFER_SIZE];
+    string request = Utils::read_str_trim_wrapper(connFd, data, INSTANCE_DATA_LENGTH);
+    std::vector<std::string> parameters = Utils::split(request, '|');
+    if (!request.empty() && request.back() == '|') {
+        parameters.push_back("");
+    }
+    if (parameters.size() < 5 || parameters.size() > 6 || (parameters[2] != "node" && parameters[2] != "edge")) {
+        instance_logger.error("Invalid property lookup request " + request);
+        send_chunked(connFd, "");
+        return;
+    }
+
+    bool relations = parameters[2] == "edge";
+    NodeManager *nodeManager = property_request_store(parameters, incrementalLocalStoreMap);
+    PropertyIndex *index = nodeManager->getPropertyIndex(relations, parameters[3]);
+    if (!index) {
+        instance_logger.warn("The " + parameters[2] + " property " + parameters[3] + " of partition " + parameters[0] +
+                             "_" + parameters[1] + " is not indexed");
+        send_chunked(connFd, "");
+        return;
+    }
+
+    std::vector<uint64_t> entities =
+        parameters.size() == 5 ? index->lookup(parameters[4]) : index->range(parameters[4], parameters[5]);
+    // One node id per line, or the source and destination ids of an edge
+    std::ostringstream result;
+    for (uint64_t entity : entities) {
+        unsigned int address = static_cast<unsigned int>(entity);
+        if (!relations) {
+            std::unique_ptr<NodeBlock> node(NodeBlock::get(address));
+            result << node->id << "\n";
+            continue;
+        }
+        std::unique_ptr<RelationBlock> relation((entity & PropertyIndex::CENTRAL_RELATION)
+                                                    ? RelationBlock::getCentralRelation(address)
+                                                    : RelationBlock::getLocalRelation(address));
+        if (!relation) {
+            continue;
+        }
+        std::unique_ptr<NodeBlock> source(relation->getSource());
+        std::unique_ptr<NodeBlock> destination(relation->getDestination());
+        result << source->id << " " << destination->id << "\n";
+    }
+    send_chunked(connFd, result.str());
+}
+
+static void compact_partition_command(int connFd, bool *loop_exit_p) {
+    *loop_exit_p = true;
+    if (!Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::OK)) {
+        return;
+    }
+
+    // graph id|partition id
+    char data[DATA_BUFFER_SIZE];
+    string request = Utils::read_str_trim_wrapper(connFd, data, INSTANCE_DATA_LENGTH);
+    std::vector<std::string> parameters = Utils::split(request, '|');
+    if (parameters.size() != 2 || !Utils::is_number(parameters[0]) || !Utils::is_number(parameters[1])) {
+        instance_logger.error("Invalid compaction request " + request);
+        Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::ERROR);
+        return;
+    }
+
+    string graphIdentifier = parameters[0] + "_" + parameters[1];
+    string dbPrefix = Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder") + "/g" +
+                      parameters[0] + "_p" + parameters[1];
+    if (!Utils::fileExists(dbPrefix + "_nodes.db")) {
+        instance_logger.error("No native store for partition " + graphIdentifier);
+        Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::ERROR);
+        return;
+    }
+
+    // Every node manager that has the partition open, in any session or process of the worker, holds the partition
+    // lock shared, so the exclusive lock is only free for a partition that is not in use
+    StoreCompactor::PartitionLock partitionLock;
+    if (!partitionLock.lock(dbPrefix, true)) {
+        instance_logger.error("Not compacting partition " + graphIdentifier + " since it is open");
+        Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::ERROR);
+        return;
+    }
+
+    // Opening the store once redoes the write-ahead log and moves legacy properties to the property stores
+    GraphConfig graphConfig;
+    graphConfig.graphID = std::stoi(parameters[0]);
+    graphConfig.partitionID = std::stoi(parameters[1]);
+    graphConfig.maxLabelSize = std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size"));
+    graphConfig.openMode = "app";
+    graphConfig.partitionLocked = true;
+    NodeManager *nodeManager = new NodeManager(graphConfig);
+    nodeManager->close();
+    delete nodeManager;
+
+    StoreCompactor::Stats stats;
+    bool compacted = StoreCompactor::compact(dbPrefix, graphConfig.maxLabelSize, stats, true);
+    Utils::send_str_wrapper(connFd, compacted ? stats.toString() : JasmineGraphInstanceProtocol::ERROR);
+}
+
+static void k_hop_command(int connFd, bool *loop_exit_p) {
+    *loop_exit_p = true;
+    if (!Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::OK)) {
+        return;
+    }
+
+    // graph id|partition id|true for a directed search
+    char data[DATA_BUFFER_SIZE];
+    string request = Utils::read_str_trim_wrapper(connFd, data, INSTANCE_DATA_LENGTH);
+    std::vector<std::string> parameters = Utils::split(request, '|');
+    if (parameters.size() != 3 || !Utils::is_number(parameters[0]) || !Utils::is_number(parameters[1])) {
+        instance_logger.error("Invalid k-hop request " + request);
+        Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::ERROR);
+        return;
+    }
+
+    // The snapshot is read from the files, so a store that is being written to is searched as it was at this point
+    FrontierBFS search;
+    string dbPrefix = Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder") + "/g" +
+                      parameters[0] + "_p" + parameters[1];
+    if (!search.load(dbPrefix, std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size")),
+                     parameters[2] == "true")) {
+        Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::ERROR);
+        return;
+    }
+    if (!Utils::send_str_wrapper(connFd, std::to_string(search.getVertexCount()))) {
+        return;
+    }
+
+    // Every level the master sends the boundary vertices reached by the partitions (the source vertex at first) and
+    // the partition expands its frontier by one hop. A message with the first counter set ends the search.
+    int threadCount = std::max(1u, std::thread::hardware_concurrency());
+    auto sink = [connFd](const char *bytes, size_t size) { return Utils::send_wrapper(connFd, bytes, size); };
+    auto source = [connFd](char *bytes, size_t size) { return Utils::recv_wrapper(connFd, bytes, size); };
+    std::vector<uint64_t> counters;
+    std::vector<std::string> exchanged;
+    while (FrontierBFS::readMessage(source, counters, exchanged) && !counters.empty() && counters[0] == 0) {
+        uint64_t found = search.addToFrontier(exchanged);
+        std::vector<std::string> reachedBoundary;
+        FrontierBFS::LevelStats stats = search.expand(threadCount, reachedBoundary);
+        std::vector<uint64_t> levelCounters = {found,
+                                               stats.frontier,
+                                               stats.reached,
+                                               stats.reachedBoundary,
+                                               stats.bottomUp ? 1ULL : 0ULL,
+                                               static_cast<uint64_t>(stats.milliseconds * 1000)};
+        if (!FrontierBFS::writeMessage(sink, levelCounters, reachedBoundary)) {
+            break;
+        }
+    }
+}
+
+static void trace_id_command(int connFd, bool *loop_exit_p) {
+    if (!Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::OK)) {
+        *loop_exit_p = true;
+        return;
+    }
+
+    char data[DATA_BUFFER_SIZE];
+    string traceId = Utils::read_str_trim_wrapper(connFd, data, INSTANCE_DATA_LENGTH);
+    // The commands that follow on this session are recorded as spans of the trace
+    Tracer::setCurrentTraceId(traceId);
+
+    if (!Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::OK)) {
+        *loop_exit_p = true;
+    }
+}
+
+static void trace_command(int connFd, bool *loop_exit_p) {
+    if (!Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::OK)) {
+        *loop_exit_p = true;
+        return;
+    }
+
+    char data[DATA_BUFFER_SIZE];
+    string traceId = Utils::read_str_trim_wrapper(connFd, data, INSTANCE_DATA_LENGTH);
+    if (!Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::OK)) {
+        *loop_exit_p = true;
+        return;
+    }
+
+    string processId = Utils::read_str_trim_wrapper(connFd, data, INSTANCE_DATA_LENGTH);
+    send_chunked(connFd, Tracer::exportEvents(traceId, atoi(processId.c_str())));
+    *loop_exit_p = true;
+}
+
+static void link_predict_command(
+    int connFd, std::map<std::string, JasmineGraphHashMapLocalStore> &graphDBMapLocalStores,
+    std::map<std::string, JasmineGraphHashMapCentralStore> &graphDBMapCentralStores,
+    std::map<std::string, JasmineGraphHashMapDuplicateCentralStore> &graphDBMapDuplicateCentralStores,
+    bool *loop_exit_p) {
+    *loop_exit_p = true;
+    if (!Utils::send_str_wrapper(connFd, JasmineGraphInstanceProtocol::OK)) {
+        return;
+    }
+
+    // graph id|partition id|metric|k
+    char data[DATA_BUFFER_SIZE];
+    string request = Utils::read_str_trim_wrapper(connFd, data, INSTANCE_DATA_LENGTH);
+    std::vector<std::string> parameters = Utils::split(request, '|');
+    NeighborhoodSimilarity::Metric metric;
+    if (parameters.size() != 4 || !NeighborhoodSimilarity::parseMetric(parameters[2], metric) ||
+        !Utils::is_number(parameters[3])) {
+        instance_logger.error("Invalid link prediction request " + request);
+        send_chunked(connFd, "");
+        return;
+    }
+    string graphId = parameters[0];
+    string partitionId = parameters[1];
+    int k = atoi(parameters[3].c_str());
+
+    TraceSpan loadSpan("worker.load_store", graphId + "_" + partitionId);
+    if (graphDBMapLocalStores.find(graphId + "_" + partitionId) == graphDBMapLocalStores.end() &&
+        JasmineGraphInstanceService::isGraphDBExists(graphId, partitionId)) {
+        JasmineGraphInstanceService::loadLocalStore(graphId, partitionId, graphDBMapLocalStores);
+    }
+    if (graphDBMapCentralStores.find(graphId + "_centralstore_" + partitionId) == graphDBMapCentralStores.end() &&
+        JasmineGraphInstanceService::isInstanceCentralStoreExists(graphId, partitionId)) {
+        JasmineGraphInstanceService::loadInstanceCentralStore(graphId, partitionId, graphDBMapCentralStores);
+    }
+    if (graphDBMapDuplicateCentralStores.find(graphId + "_centralstore_dp_" + partitionId) ==
+            graphDBMapDuplicateCentralStores.end() &&
+        JasmineGraphInstanceService::isInstanceDuplicateCentralStoreExists(graphId, partitionId)) {
+        JasmineGraphInstanceService::loadInstanceDuplicateCentralStore(graphId, partitionId,
+                                                                       graphDBMapDuplicateCentralStores);
+    }
+    const map<long, unordered_set<long>> &localGraphMap =
+        graphDBMapLocalStores[graphId + "_" + partitionId].getUnderlyingHashMap();
+    const map<long, unordered_set<long>> &centralGraphMap =
+        graphDBMapCentralStores[graphId + "_centralstore_" + partitionId].getUnderlyingHashMap();
+    const map<long, unordered_set<long>> &duplicateCentralGraphMap =
+        graphDBMapDuplicateCentralStores[graphId + "_centralstore_dp_" + partitionId].getUnderlyingHashMap();
+    loadSpan.end();
+
+    TraceSpan predictSpan("worker.link_predict", NeighborhoodSimilarity::getMetricName(metric));
+    NeighborhoodSimilarity similarity;
+    similarity.addEdges(localGraphMap);
+    similarity.addEdges(centralGraphMap);
+    similarity.addEdges(duplicateCentralGraphMap);
+    similarity.build();
+
+    // Links are predicted for the vertices the partition owns, the central stores only complete their neighbourhoods
+    std::vector<long> sources;
+    for (auto &vertex : localGraphMap) {
+        sources.push_back(vertex.first);
+    }
+    int threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<LinkScore> scores = similarity.predict(sources, metric, k, threadCount);
+    predictSpan.end();
+    instance_logger.info("###INSTANCE### Predicted " + std::to_string(scores.size()) + " links for " +
+                         std::to_string(sources.size()) + " vertices of partition " + partitionId);
+
+    std::ostringstream result;
+    for (auto &score : scores) {
+        result << score.source << " " << score.target << " " << score.score << "\n";
+    }
+    send_chunked(connFd, result.str());
+}
+
 string JasmineGraphInstanceService::aggregateStreamingCentralStoreTriangles(
     std::string graphId, std::string partitionId, std::string partitionIdString, std::string centralCountString,
     int threadPriority, std::map<std::string, JasmineGraphIncrementalLocalStore *> incrementalLocalStores,
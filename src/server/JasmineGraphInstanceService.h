@@ -39,8 +39,10 @@ limitations under the License.
 #include "../localstore/JasmineGraphHashMapLocalStore.h"
 #include "../localstore/JasmineGraphLocalStore.h"
 #include "../localstore/JasmineGraphLocalStoreFactory.h"
+#include "../localstore/degree/JasmineGraphDegreeStore.h"
 #include "../localstore/incremental/JasmineGraphIncrementalLocalStore.h"
 #include "../performance/metrics/StatisticCollector.h"
+#include "../query/algorithms/triangles/TriangleStream.h"
 #include "../query/algorithms/triangles/Triangles.h"
 #include "../util/Conts.h"
 #include "../util/Utils.h"
@@ -137,10 +139,16 @@ class JasmineGraphInstanceService {
         std::string graphId, std::string partitionId,
         std::map<std::string, JasmineGraphHashMapDuplicateCentralStore>& graphDBMapDuplicateCentralStores);
     static JasmineGraphHashMapCentralStore loadCentralStore(std::string centralStoreFileName);
-    static string aggregateCentralStoreTriangles(std::string graphId, std::string partitionId,
-                                                 std::string partitionIdList, int threadPriority);
-    static string aggregateCompositeCentralStoreTriangles(std::string compositeFileList, std::string availableFileList,
-                                                          int threadPriority);
+    static JasmineGraphDegreeStore loadDegreeStore(
+        std::string graphId, std::string partitionId,
+        std::map<std::string, JasmineGraphHashMapLocalStore>& graphDBMapLocalStores,
+        std::map<std::string, JasmineGraphHashMapCentralStore>& graphDBMapCentralStores);
+    static bool buildDegreeStore(std::string graphId, std::string partitionId);
+    static long aggregateCentralStoreTriangles(std::string graphId, std::string partitionId,
+                                               std::string partitionIdList, int threadPriority,
+                                               TriangleStreamWriter &triangleWriter);
+    static long aggregateCompositeCentralStoreTriangles(std::string compositeFileList, std::string availableFileList,
+                                                        int threadPriority, TriangleStreamWriter &triangleWriter);
     static map<long, long> getOutDegreeDistributionHashMap(map<long, unordered_set<long>> graphMap);
     static string requestPerformanceStatistics(std::string isVMStatManager, std::string isResourceAllocationRequested);
 
@@ -17,12 +17,21 @@ limitations under the License.
 #include <stdlib.h>
 #include <sys/stat.h>
 
+#include <chrono>
 #include <iostream>
 #include <map>
+#include <set>
+#include <sstream>
 #include <string>
+#include <unordered_set>
 
+#include "../localstore/degree/JasmineGraphDegreeStore.h"
 #include "../ml/trainer/JasmineGraphTrainingSchedular.h"
 #include "../partitioner/local/MetisPartitioner.h"
+#include "../performance/metrics/MetricsRegistry.h"
+#include "../performance/trace/Tracer.h"
+#include "../query/algorithms/traversal/FrontierBFS.h"
+#include "../streamingdb/StreamingSQLiteDBInterface.h"
 #include "../util/Utils.h"
 #include "../util/logger/Logger.h"
 #include "JasmineGraphInstance.h"
@@ -65,7 +74,7 @@ static bool initiateAggregator(std::string host, int port, int dataPort, std::st
                                std::string partCount, std::string masterIP);
 static bool initiateOrgServer(std::string host, int port, int dataPort, std::string trainingArgs, int iteration,
                               std::string partCount, std::string masterIP);
-static void degreeDistributionCommon(std::string graphID, std::string command);
+static bool degreeDistributionCommon(std::string graphID, std::string command);
 
 static map<string, string> hostIDMap;
 static std::vector<JasmineGraphServer::workers> hostWorkerMap;
@@ -1612,7 +1621,7 @@ void JasmineGraphServer::addInstanceDetailsToPerformanceDB(std::string host, std
     this->performanceSqlite->runInsert(insertPlaceQuery);
 }
 
-static void degreeDistributionCommon(std::string graphID, std::string command) {
+static bool degreeDistributionCommon(std::string graphID, std::string command) {
     std::map<std::string, JasmineGraphServer::workerPartition> graphPartitionedHosts =
         JasmineGraphServer::getWorkerPartitions(graphID);
     int partition_count = 0;
@@ -1634,8 +1643,13 @@ static void degreeDistributionCommon(std::string graphID, std::string command) {
         workerList.append(host + ":" + std::to_string(port) + ":" + partition + ",");
     }
 
+    if (workerList.empty()) {
+        return false;
+    }
     workerList.pop_back();
 
+    bool sentToAll = true;
+
     for (workerit = graphPartitionedHosts.begin(); workerit != graphPartitionedHosts.end(); workerit++) {
         JasmineGraphServer::workerPartition workerPartition = workerit->second;
         partition = workerPartition.partitionID;
@@ -1656,12 +1670,14 @@ static void degreeDistributionCommon(std::string graphID, std::string command) {
         sockfd = socket(AF_INET, SOCK_STREAM, 0);
         if (sockfd < 0) {
             server_logger.error("Cannot create socket");
+            sentToAll = false;
             continue;
         }
 
         server = gethostbyname(host.c_str());
         if (server == NULL) {
             server_logger.error("ERROR, no host named " + host);
+            sentToAll = false;
             continue;
         }
 
@@ -1670,39 +1686,384 @@ static void degreeDistributionCommon(std::string graphID, std::string command) {
         bcopy((char *)server->h_addr, (char *)&serv_addr.sin_addr.s_addr, server->h_length);
         serv_addr.sin_port = htons(port);
         if (Utils::connect_wrapper(sockfd, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0) {
+            sentToAll = false;
             continue;
         }
 
         if (!Utils::sendExpectResponse(sockfd, data, INSTANCE_DATA_LENGTH, command, JasmineGraphInstanceProtocol::OK)) {
             close(sockfd);
+            sentToAll = false;
             continue;
         }
 
         if (!Utils::sendExpectResponse(sockfd, data, INSTANCE_DATA_LENGTH, graphID, JasmineGraphInstanceProtocol::OK)) {
             close(sockfd);
+            sentToAll = false;
             continue;
         }
 
         if (!Utils::sendExpectResponse(sockfd, data, INSTANCE_DATA_LENGTH, partition,
                                        JasmineGraphInstanceProtocol::OK)) {
             close(sockfd);
+            sentToAll = false;
             continue;
         }
 
         if (!Utils::send_str_wrapper(sockfd, workerList)) {
             close(sockfd);
+            sentToAll = false;
             continue;
         }
         server_logger.info("Sent: " + workerList);
     }
+    return sentToAll;
+}
+
+bool JasmineGraphServer::inDegreeDistribution(std::string graphID) {
+    return degreeDistributionCommon(graphID, JasmineGraphInstanceProtocol::IN_DEGREE_DISTRIBUTION);
+}
+
+bool JasmineGraphServer::outDegreeDistribution(std::string graphID) {
+    return degreeDistributionCommon(graphID, JasmineGraphInstanceProtocol::OUT_DEGREE_DISTRIBUTION);
+}
+
+std::map<long, long> JasmineGraphServer::degreeHistogram(std::string graphID, bool in) {
+    std::map<long, long> histogram;
+    std::map<std::string, JasmineGraphServer::workerPartition> graphPartitionedHosts =
+        JasmineGraphServer::getWorkerPartitions(graphID);
+    std::string command =
+        in ? JasmineGraphInstanceProtocol::IN_DEGREE_HISTOGRAM : JasmineGraphInstanceProtocol::OUT_DEGREE_HISTOGRAM;
+    std::string workerList;
+    std::map<std::string, JasmineGraphServer::workerPartition>::iterator workerit;
+    for (workerit = graphPartitionedHosts.begin(); workerit != graphPartitionedHosts.end(); workerit++) {
+        JasmineGraphServer::workerPartition workerPartition = workerit->second;
+        string host = workerPartition.hostname;
+        if (host.find('@') != std::string::npos) {
+            host = Utils::split(host, '@')[1];
+        }
+        workerList.append(host + ":" + std::to_string(workerPartition.port) + ":" + workerPartition.partitionID + ",");
+    }
+    if (!workerList.empty()) {
+        workerList.pop_back();
+    }
+
+    for (workerit = graphPartitionedHosts.begin(); workerit != graphPartitionedHosts.end(); workerit++) {
+        JasmineGraphServer::workerPartition workerPartition = workerit->second;
+        string partition = workerPartition.partitionID;
+        string host = workerPartition.hostname;
+        int port = workerPartition.port;
+
+        if (host.find('@') != std::string::npos) {
+            host = Utils::split(host, '@')[1];
+        }
+
+        char data[INSTANCE_DATA_LENGTH + 1];
+        struct sockaddr_in serv_addr;
+        struct hostent *server;
+
+        int sockfd = socket(AF_INET, SOCK_STREAM, 0);
+        if (sockfd < 0) {
+            server_logger.error("Cannot create socket");
+            continue;
+        }
+
+        server = gethostbyname(host.c_str());
+        if (server == NULL) {
+            server_logger.error("ERROR, no host named " + host);
+            close(sockfd);
+            continue;
+        }
+
+        bzero((char *)&serv_addr, sizeof(serv_addr));
+        serv_addr.sin_family = AF_INET;
+        bcopy((char *)server->h_addr, (char *)&serv_addr.sin_addr.s_addr, server->h_length);
+        serv_addr.sin_port = htons(port);
+        if (Utils::connect_wrapper(sockfd, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0) {
+            close(sockfd);
+            continue;
+        }
+
+        if (!Utils::sendExpectResponse(sockfd, data, INSTANCE_DATA_LENGTH, command, JasmineGraphInstanceProtocol::OK) ||
+            !Utils::sendExpectResponse(sockfd, data, INSTANCE_DATA_LENGTH, graphID, JasmineGraphInstanceProtocol::OK) ||
+            !Utils::sendExpectResponse(sockfd, data, INSTANCE_DATA_LENGTH, partition,
+                                       JasmineGraphInstanceProtocol::OK) ||
+            !Utils::send_str_wrapper(sockfd, workerList)) {
+            close(sockfd);
+            continue;
+        }
+
+        std::string response = Utils::read_str_trim_wrapper(sockfd, data, INSTANCE_DATA_LENGTH);
+        std::string result;
+        while (response.size() >= 5) {
+            std::string status = response.substr(response.size() - 5);
+            result += response.substr(0, response.size() - 5);
+            if (status.compare("/SEND") != 0 || !Utils::send_str_wrapper(sockfd, status)) {
+                break;
+            }
+            response = Utils::read_str_trim_wrapper(sockfd, data, INSTANCE_DATA_LENGTH);
+        }
+        close(sockfd);
+
+        std::map<long, long> partitionHistogram = JasmineGraphDegreeStore::histogramFromString(result);
+        for (auto it = partitionHistogram.begin(); it != partitionHistogram.end(); ++it) {
+            histogram[it->first] += it->second;
+        }
+        server_logger.info("Received degree histogram of partition " + partition);
+    }
+    return histogram;
 }
 
-void JasmineGraphServer::inDegreeDistribution(std::string graphID) {
-    degreeDistributionCommon(graphID, JasmineGraphInstanceProtocol::IN_DEGREE_DISTRIBUTION);
+// Whether an instance answered the metrics request, in the same format as the metrics snapshots
+static std::string getUpMetric(bool up) {
+    return std::string("# HELP jasminegraph_up Whether the instance answered the metrics request\n"
+                       "# TYPE jasminegraph_up gauge\njasminegraph_up ") +
+           (up ? "1" : "0") + "\n";
 }
 
-void JasmineGraphServer::outDegreeDistribution(std::string graphID) {
-    degreeDistributionCommon(graphID, JasmineGraphInstanceProtocol::OUT_DEGREE_DISTRIBUTION);
+std::string JasmineGraphServer::collectMetrics() {
+    std::vector<std::pair<std::string, std::string>> snapshots;
+    snapshots.push_back({"master", MetricsRegistry::snapshot() + getUpMetric(true)});
+
+    for (auto &worker : hostWorkerMap) {
+        std::string host = worker.hostname;
+        if (host.find('@') != std::string::npos) {
+            host = Utils::split(host, '@')[1];
+        }
+        std::string instance = host + ":" + std::to_string(worker.port);
+
+        int sockfd = Utils::connectToWorker(host, worker.port);
+        if (sockfd < 0) {
+            snapshots.push_back({instance, getUpMetric(false)});
+            continue;
+        }
+        if (!Utils::send_str_wrapper(sockfd, JasmineGraphInstanceProtocol::METRICS)) {
+            close(sockfd);
+            snapshots.push_back({instance, getUpMetric(false)});
+            continue;
+        }
+
+        std::string snapshot = Utils::readChunkedResponse(sockfd);
+        close(sockfd);
+        snapshots.push_back({instance, snapshot + getUpMetric(!snapshot.empty())});
+    }
+    return MetricsRegistry::merge(snapshots);
+}
+
+std::string JasmineGraphServer::collectTrace(std::string traceId) {
+    std::vector<std::string> eventArrays;
+    eventArrays.push_back(Tracer::exportEvents(traceId, 0));
+
+    // Process ids of the workers in the merged trace follow the order of the worker map, the master is 0
+    int processId = 0;
+    for (auto &worker : hostWorkerMap) {
+        processId++;
+        std::string host = worker.hostname;
+        if (host.find('@') != std::string::npos) {
+            host = Utils::split(host, '@')[1];
+        }
+
+        char data[INSTANCE_DATA_LENGTH + 1];
+        int sockfd = Utils::connectToWorker(host, worker.port);
+        if (sockfd < 0) {
+            continue;
+        }
+        if (!Utils::sendExpectResponse(sockfd, data, INSTANCE_DATA_LENGTH, JasmineGraphInstanceProtocol::TRACE,
+                                       JasmineGraphInstanceProtocol::OK) ||
+            !Utils::sendExpectResponse(sockfd, data, INSTANCE_DATA_LENGTH, traceId, JasmineGraphInstanceProtocol::OK) ||
+            !Utils::send_str_wrapper(sockfd, std::to_string(processId))) {
+            server_logger.error("Could not collect the spans of trace " + traceId + " from " + host + ":" +
+                                std::to_string(worker.port));
+            close(sockfd);
+            continue;
+        }
+
+        std::string events = Utils::readChunkedResponse(sockfd);
+        close(sockfd);
+        eventArrays.push_back(events);
+    }
+    return Tracer::mergeEvents(eventArrays);
+}
+
+std::string JasmineGraphServer::compactGraph(SQLiteDBInterface *sqlite, std::string graphID, int numberOfPartitions) {
+    // Partition i of a streamed graph is stored by worker i modulo the number of workers, as StreamHandler places it
+    vector<Utils::worker> workerList = Utils::getWorkerList(sqlite);
+    if (workerList.empty()) {
+        return "No workers to compact graph " + graphID + " on\r\n";
+    }
+    std::string result;
+    bool compactedAny = false;
+    for (int partition = 0; partition < numberOfPartitions; partition++) {
+        std::string status = "ERROR";
+        char data[INSTANCE_LONG_DATA_LENGTH + 1];
+        Utils::worker &worker = workerList[partition % workerList.size()];
+        int sockfd = Utils::connectToWorker(worker.hostname, atoi(worker.port.c_str()));
+        if (sockfd >= 0) {
+            if (!Utils::sendExpectResponse(sockfd, data, INSTANCE_DATA_LENGTH,
+                                           JasmineGraphInstanceProtocol::COMPACT_PARTITION,
+                                           JasmineGraphInstanceProtocol::OK) ||
+                !Utils::send_str_wrapper(sockfd, graphID + "|" + std::to_string(partition))) {
+                server_logger.error("Could not compact partition " + std::to_string(partition) + " of graph " +
+                                    graphID);
+            } else {
+                status = Utils::read_str_trim_wrapper(sockfd, data, INSTANCE_LONG_DATA_LENGTH);
+            }
+            close(sockfd);
+        }
+        compactedAny = compactedAny || (!status.empty() && status != "ERROR" &&
+                                        status != JasmineGraphInstanceProtocol::ERROR);
+        result += "partition " + std::to_string(partition) + ": " + status + "\r\n";
+    }
+
+    // Compaction renumbers the relations, so the relation index watermarks of the streaming triangle count no longer
+    // hold and its next incremental count has to count the whole graph, even if only some partitions were compacted
+    if (compactedAny) {
+        StreamingSQLiteDBInterface streamingDB;
+        if (streamingDB.init() == 0) {
+            streamingDB.removeTriangleCountWatermarks(graphID);
+            streamingDB.finalize();
+        } else {
+            server_logger.error("Could not reset the streaming triangle count of graph " + graphID);
+        }
+    }
+    return result;
+}
+
+std::string JasmineGraphServer::kHop(SQLiteDBInterface *sqlite, std::string graphID, int numberOfPartitions,
+                                     std::string source, int maxDepth, bool directed) {
+    // Every partition keeps its search on its own connection for the whole search. Partition i is stored by worker i
+    // modulo the number of workers, as StreamHandler places it.
+    vector<Utils::worker> workerList = Utils::getWorkerList(sqlite);
+    if (workerList.empty()) {
+        return "No workers to search graph " + graphID + " on\r\n";
+    }
+    std::vector<int> sockets;
+    std::string error;
+    for (int partition = 0; partition < numberOfPartitions; partition++) {
+        char data[INSTANCE_DATA_LENGTH + 1];
+        Utils::worker &worker = workerList[partition % workerList.size()];
+        int sockfd = Utils::connectToWorker(worker.hostname, atoi(worker.port.c_str()));
+        if (sockfd < 0) {
+            error = "Could not connect to the worker of partition " + std::to_string(partition);
+            break;
+        }
+        sockets.push_back(sockfd);
+        if (!Utils::sendExpectResponse(sockfd, data, INSTANCE_DATA_LENGTH, JasmineGraphInstanceProtocol::K_HOP,
+                                       JasmineGraphInstanceProtocol::OK) ||
+            !Utils::send_str_wrapper(sockfd, graphID + "|" + std::to_string(partition) + "|" +
+                                                 (directed ? "true" : "false"))) {
+            error = "Could not start the search on partition " + std::to_string(partition);
+            break;
+        }
+        std::string vertexCount = Utils::read_str_trim_wrapper(sockfd, data, INSTANCE_DATA_LENGTH);
+        if (!Utils::is_number(vertexCount)) {
+            error = "Partition " + std::to_string(partition) + " of graph " + graphID + " has no native store";
+            break;
+        }
+    }
+
+    // The boundary vertices reached by any partition are sent to all partitions with the next level
+    std::ostringstream result;
+    std::vector<std::string> exchanged = {source};
+    std::unordered_set<std::string> reachedBoundary = {source};
+    uint64_t reachable = 0;
+    for (int depth = 0; error.empty() && (maxDepth <= 0 || depth < maxDepth); depth++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int sockfd : sockets) {
+            if (!FrontierBFS::writeMessage(
+                    [sockfd](const char *bytes, size_t size) { return Utils::send_wrapper(sockfd, bytes, size); },
+                    {0}, exchanged)) {
+                error = "Could not send the frontier of level " + std::to_string(depth);
+            }
+        }
+
+        // found, frontier, reached, reached boundary vertices, bottom-up and microseconds of every partition
+        uint64_t found = 0;
+        uint64_t reached = 0;
+        int bottomUp = 0;
+        uint64_t expandMicroseconds = 0;
+        std::vector<std::string> boundary;
+        for (int sockfd : sockets) {
+            std::vector<uint64_t> counters;
+            std::vector<std::string> partitionBoundary;
+            if (!error.empty() ||
+                !FrontierBFS::readMessage(
+                    [sockfd](char *bytes, size_t size) { return Utils::recv_wrapper(sockfd, bytes, size); },
+                    counters, partitionBoundary) ||
+                counters.size() < 6) {
+                error = "Could not read the frontier of level " + std::to_string(depth + 1);
+                break;
+            }
+            found += counters[0];
+            reached += counters[2] - counters[3];
+            bottomUp += counters[4];
+            expandMicroseconds = std::max(expandMicroseconds, counters[5]);
+            boundary.insert(boundary.end(), partitionBoundary.begin(), partitionBoundary.end());
+        }
+        if (!error.empty()) {
+            break;
+        }
+        if (depth == 0) {
+            if (found == 0) {
+                error = "Vertex " + source + " is not in graph " + graphID;
+                break;
+            }
+            reachable = 1;
+            result << "level 0: 1 vertex\r\n";
+        }
+
+        reached = FrontierBFS::mergeBoundary(reached, boundary, reachedBoundary, exchanged);
+        if (reached == 0) {
+            break;
+        }
+        reachable += reached;
+        double milliseconds =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        result << "level " << depth + 1 << ": " << reached << " vertices in " << milliseconds << " ms (expansion "
+               << expandMicroseconds / 1000.0 << " ms, " << exchanged.size() << " boundary vertices exchanged, "
+               << "bottom-up on " << bottomUp << " of " << sockets.size() << " partitions)\r\n";
+    }
+
+    for (int sockfd : sockets) {
+        if (error.empty()) {
+            FrontierBFS::writeMessage(
+                [sockfd](const char *bytes, size_t size) { return Utils::send_wrapper(sockfd, bytes, size); }, {1},
+                {});
+        }
+        close(sockfd);
+    }
+    if (!error.empty()) {
+        server_logger.error(error);
+        return error + "\r\n";
+    }
+    result << "reachable: " << reachable << " vertices\r\n";
+    return result.str();
+}
+
+std::string JasmineGraphServer::vertexAttributes(SQLiteDBInterface *sqlite, std::string graphID,
+                                                 std::string vertices) {
+    std::vector<vector<pair<string, string>>> partitions = sqlite->runSelect(
+        "SELECT ip, server_port, partition_idpartition FROM worker_has_partition INNER JOIN worker ON "
+        "worker_idworker = idworker WHERE partition_graph_idgraph = '" + graphID + "'");
+    std::string result;
+    for (auto &partition : partitions) {
+        std::string partitionID = partition[2].second;
+        char data[INSTANCE_DATA_LENGTH + 1];
+        int sockfd = Utils::connectToWorker(partition[0].second, atoi(partition[1].second.c_str()));
+        if (sockfd < 0) {
+            return "Could not connect to the worker of partition " + partitionID + "\r\n";
+        }
+        if (!Utils::sendExpectResponse(sockfd, data, INSTANCE_DATA_LENGTH,
+                                       JasmineGraphInstanceProtocol::VERTEX_ATTRIBUTES,
+                                       JasmineGraphInstanceProtocol::OK) ||
+            !Utils::send_str_wrapper(sockfd, graphID + "|" + partitionID + "|" + vertices)) {
+            close(sockfd);
+            return "Could not read the attributes of partition " + partitionID + "\r\n";
+        }
+        // Every vertex has its attributes in the partition it was assigned to, at most one reply has a line for it
+        result += Utils::readChunkedResponse(sockfd);
+        close(sockfd);
+    }
+    return result;
 }
 
 long JasmineGraphServer::getGraphVertexCount(std::string graphID) {
@@ -144,9 +144,31 @@ class JasmineGraphServer {
 
     std::map<std::string, workerPartitions> getGraphPartitionedHosts(std::string graphID);
 
-    static void inDegreeDistribution(std::string graphID);
+    // Start the in degree distribution on the workers. False if it could not be sent to every partition.
+    static bool inDegreeDistribution(std::string graphID);
 
-    static void outDegreeDistribution(std::string graphID);
+    static bool outDegreeDistribution(std::string graphID);
+
+    // Degree -> number of vertices histogram of the whole graph, merged from the cached per partition histograms
+    static std::map<long, long> degreeHistogram(std::string graphID, bool in);
+
+    // Metrics snapshot of the master merged with the snapshots of all workers, in the Prometheus text format
+    static std::string collectMetrics();
+
+    // Chrome trace-event document with the spans of the trace recorded by the master and all workers
+    static std::string collectTrace(std::string traceId);
+
+    // Compact the native store of every partition of a streamed graph, one line of statistics per partition
+    static std::string compactGraph(SQLiteDBInterface *sqlite, std::string graphID, int numberOfPartitions);
+
+    // Vertices reached at every level of a breadth first search of a streamed graph from the source vertex, up to
+    // maxDepth hops (all levels when it is 0), with the time of every level
+    static std::string kHop(SQLiteDBInterface *sqlite, std::string graphID, int numberOfPartitions, std::string source,
+                            int maxDepth, bool directed);
+
+    // Attribute lines (vertex, a tab and the attributes) of the given comma separated vertices, all the vertices
+    // when there are none, read from the columnar attribute store of every partition of an uploaded graph
+    static std::string vertexAttributes(SQLiteDBInterface *sqlite, std::string graphID, std::string vertices);
 
     static void duplicateCentralStore(std::string graphID);
 
@@ -46,3 +46,19 @@ StreamingSQLiteDBInterface::StreamingSQLiteDBInterface() {
 StreamingSQLiteDBInterface::StreamingSQLiteDBInterface(string databaseLocation) {
     this->databaseLocation = databaseLocation;
 }
+
+bool StreamingSQLiteDBInterface::hasTriangleCountWatermarks(const std::string &graphId, int partitionCount,
+                                                            bool withCentralStores) {
+    auto partitions = runSelect("SELECT COUNT(*) FROM streaming_partition WHERE graph_id = " + graphId +
+                                " AND partition_id >= 0 AND partition_id < " + std::to_string(partitionCount));
+    if (partitions.empty() || std::stol(partitions[0][0].second) != partitionCount) {
+        return false;
+    }
+    return !withCentralStores || !runSelect("SELECT triangles FROM central_store WHERE graph_id = " + graphId).empty();
+}
+
+void StreamingSQLiteDBInterface::removeTriangleCountWatermarks(const std::string &graphId) {
+    runUpdate("DELETE FROM streaming_partition WHERE graph_id = " + graphId);
+    runUpdate("DELETE FROM central_store WHERE graph_id = " + graphId);
+    streamdb_logger.info("Removed the triangle count watermarks of graph " + graphId);
+}
@@ -28,6 +28,16 @@ class StreamingSQLiteDBInterface : public DBInterface {
     StreamingSQLiteDBInterface();
 
     StreamingSQLiteDBInterface(std::string databaseLocation);
+
+    /**
+     * The streaming triangle count keeps, per partition, the relation indexes counted so far as watermarks for the
+     * next incremental count. True if the watermarks of partitions 0 to partitionCount - 1, and of the central stores
+     * when they are counted, are all there.
+     */
+    bool hasTriangleCountWatermarks(const std::string &graphId, int partitionCount, bool withCentralStores);
+
+    // Forget the watermarks of the graph, e.g. after its relations were renumbered, so the next count is a full one
+    void removeTriangleCountWatermarks(const std::string &graphId);
 };
 
 #endif  // JASMINEGRAPH_STREAMINGSQLITEDBINTERFACE_H
@@ -62,6 +62,9 @@ int Conts::LOAD_AVG_COLLECTING_GAP = 5;
 double Conts::LOAD_AVG_THREASHOLD = 20;
 
 int Conts::SCHEDULER_SLEEP_TIME = 2;
+int Conts::SCHEDULER_POOL_SIZE = 4;
+int Conts::COMPLETED_JOB_RETENTION_TIME = 600;
+int Conts::JOB_RESULT_TIMEOUT = 3600;
 
 const int Conts::GRAPH_STATUS::LOADING = 1;
 const int Conts::GRAPH_STATUS::OPERATIONAL = 2;
@@ -92,8 +95,9 @@ const std::string Conts::PARAM_KEYS::STREAMING_TRIANGLE_COUNT = "streamingTriang
 const std::string Conts::PARAM_KEYS::PAGE_RANK = "pageRank";
 const std::string Conts::PARAM_KEYS::CAN_CALIBRATE = "canCalibrate";
 const std::string Conts::PARAM_KEYS::CATEGORY = "category";
-const std::string Conts::PARAM_KEYS::QUEUE_TIME = "queueTime";
 const std::string Conts::PARAM_KEYS::GRAPH_SLA = "graphSLA";
 const std::string Conts::PARAM_KEYS::AUTO_CALIBRATION = "autoCalibration";
+const std::string Conts::PARAM_KEYS::GRAPH_VERSION = "graphVersion";
+const std::string Conts::PARAM_KEYS::TRACE_ID = "traceId";
 
 const std::string Conts::FLAGS::MODEL_ID = "model_id";
@@ -40,7 +40,7 @@ struct ProcessInfo {
     int id;
     std::string graphId;
     std::string processName;
-    long sleepTime;
+    long sleepTime = 0;  // Milliseconds the job was held back before it started
     long startTimestamp;
     int priority;
     std::vector<std::string> workerList;
@@ -112,6 +112,9 @@ class Conts {
     static int MAX_HIGH_PRIORIY_TASKS;
 
     static int SCHEDULER_SLEEP_TIME;
+    static int SCHEDULER_POOL_SIZE;           // Default number of executor threads per job class
+    static int COMPLETED_JOB_RETENTION_TIME;  // Seconds a finished job is kept before it is garbage collected
+    static int JOB_RESULT_TIMEOUT;            // Seconds a frontend session waits for the response of a job
 
     struct GRAPH_STATUS {
         static const int LOADING;  // Graph partitions are being uploaded
@@ -154,10 +157,11 @@ class Conts {
         static const std::string PAGE_RANK;
         static const std::string CAN_CALIBRATE;
         static const std::string CATEGORY;
-        static const std::string QUEUE_TIME;
         static const std::string GRAPH_SLA;
         static const std::string IS_CALIBRATING;
         static const std::string AUTO_CALIBRATION;
+        static const std::string GRAPH_VERSION;
+        static const std::string TRACE_ID;
     };
 };
 
@@ -14,6 +14,8 @@ limitations under the License.
 #include "Utils.h"
 
 #include <dirent.h>
+#include <errno.h>
+#include <netdb.h>
 #include <pwd.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -25,6 +27,7 @@ limitations under the License.
 #include <sstream>
 #include <vector>
 
+#include "../performance/metrics/MetricsRegistry.h"
 #include "../server/JasmineGraphInstanceProtocol.h"
 #include "Conts.h"
 #include "logger/Logger.h"
@@ -561,6 +564,9 @@ std::string Utils::read_str_wrapper(int connFd, char *buf, size_t len, bool allo
         util_logger.error("Read failed: recv empty string");
         return "";
     }
+    static Counter &bytesReceived =
+        MetricsRegistry::counter("jasminegraph_network_bytes_received_total", "Bytes received through Utils sockets");
+    bytesReceived.inc(result);
     buf[result] = 0;  // null terminator for string
     string str = buf;
     return str;
@@ -572,12 +578,41 @@ std::string Utils::read_str_trim_wrapper(int connFd, char *buf, size_t len) {
     return str;
 }
 
+bool Utils::recv_wrapper(int connFd, char *buf, size_t size) {
+    size_t received = 0;
+    while (received < size) {
+        ssize_t result = recv(connFd, buf + received, size - received, 0);
+        if (result <= 0) {
+            util_logger.error("Read failed: recv returned " + std::to_string((int)result) + " after " +
+                              std::to_string(received) + " of " + std::to_string(size) + " bytes");
+            return false;
+        }
+        received += result;
+    }
+    static Counter &bytesReceived =
+        MetricsRegistry::counter("jasminegraph_network_bytes_received_total", "Bytes received through Utils sockets");
+    bytesReceived.inc(size);
+    return true;
+}
+
 bool Utils::send_wrapper(int connFd, const char *buf, size_t size) {
-    ssize_t sz = send(connFd, buf, size, 0);
-    if (sz < size) {
-        util_logger.error("Send failed");
-        return false;
+    // send() may accept only part of a large buffer (e.g. a triangle frame), keep going until all of it is out
+    size_t sent = 0;
+    while (sent < size) {
+        ssize_t result = send(connFd, buf + sent, size - sent, 0);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            util_logger.error("Send failed: send returned " + std::to_string((int)result) + " after " +
+                              std::to_string(sent) + " of " + std::to_string(size) + " bytes");
+            return false;
+        }
+        sent += result;
     }
+    static Counter &bytesSent =
+        MetricsRegistry::counter("jasminegraph_network_bytes_sent_total", "Bytes sent through Utils sockets");
+    bytesSent.inc(size);
     return true;
 }
 
@@ -598,6 +633,49 @@ bool Utils::sendExpectResponse(int sockfd, char *data, size_t data_length, std::
     return true;
 }
 
+int Utils::connectToWorker(std::string host, int port) {
+    if (host.find('@') != std::string::npos) {
+        host = Utils::split(host, '@')[1];
+    }
+    struct hostent *server = gethostbyname(host.c_str());
+    if (server == NULL) {
+        util_logger.error("ERROR, no host named " + host);
+        return -1;
+    }
+    int sockfd = socket(AF_INET, SOCK_STREAM, 0);
+    if (sockfd < 0) {
+        util_logger.error("Cannot create socket");
+        return -1;
+    }
+
+    struct sockaddr_in serv_addr;
+    bzero((char *)&serv_addr, sizeof(serv_addr));
+    serv_addr.sin_family = AF_INET;
+    bcopy((char *)server->h_addr, (char *)&serv_addr.sin_addr.s_addr, server->h_length);
+    serv_addr.sin_port = htons(port);
+    if (Utils::connect_wrapper(sockfd, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0) {
+        util_logger.error("Cannot connect to " + host + ":" + std::to_string(port));
+        close(sockfd);
+        return -1;
+    }
+    return sockfd;
+}
+
+std::string Utils::readChunkedResponse(int sockfd) {
+    char data[INSTANCE_DATA_LENGTH + 1];
+    std::string response = Utils::read_str_wrapper(sockfd, data, INSTANCE_DATA_LENGTH, false);
+    std::string message;
+    while (response.size() >= 5) {
+        std::string status = response.substr(response.size() - 5);
+        message += response.substr(0, response.size() - 5);
+        if (status.compare("/SEND") != 0 || !Utils::send_str_wrapper(sockfd, status)) {
+            break;
+        }
+        response = Utils::read_str_wrapper(sockfd, data, INSTANCE_DATA_LENGTH, false);
+    }
+    return message;
+}
+
 bool Utils::performHandshake(int sockfd, char *data, size_t data_length, std::string masterIP) {
     if (!Utils::sendExpectResponse(sockfd, data, data_length, JasmineGraphInstanceProtocol::HANDSHAKE,
                                    JasmineGraphInstanceProtocol::HANDSHAKE_OK)) {
@@ -140,6 +140,17 @@ class Utils {
      */
     static std::string read_str_trim_wrapper(int connFd, char *buf, size_t len);
 
+    /**
+     * Wrapper to recv(2) to read a fixed amount of binary data.
+     *
+     * @param connFd connection file descriptor
+     * @param buf writable buffer of size at least `size`
+     * @param size number of bytes to read
+     * @return true if exactly `size` bytes were read or false otherwise. Logs error if recv failed or the connection
+     * was closed before all the data arrived.
+     */
+    static bool recv_wrapper(int connFd, char *buf, size_t size);
+
     /**
      * Wrapper to send(2) to send data to socket.
      *
@@ -162,6 +173,24 @@ class Utils {
     static bool sendExpectResponse(int sockfd, char *data, size_t data_length, std::string sendMsg,
                                    std::string expectMsg);
 
+    /**
+     * Connect to the instance service of a worker.
+     *
+     * @param host host name or address of the worker, a user@host name connects to host
+     * @param port instance service port of the worker
+     * @return the connected socket, or -1 if the worker can not be reached
+     */
+    static int connectToWorker(std::string host, int port);
+
+    /**
+     * Read a reply the instance service sends in "/SEND" terminated chunks, acknowledging every chunk, up to the
+     * final "/CMPT" chunk. Chunks are not trimmed since a chunk may start or end at a line break of the reply.
+     *
+     * @param sockfd socket connected to the instance service
+     * @return the reply without the chunk markers, what arrived so far if the connection failed
+     */
+    static std::string readChunkedResponse(int sockfd);
+
     static bool performHandshake(int sockfd, char *data, size_t data_length, std::string masterIP);
 
     static std::string getCurrentTimestamp();
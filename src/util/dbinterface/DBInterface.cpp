@@ -17,6 +17,7 @@ limitations under the License.
 Logger interface_logger;
 
 int DBInterface::finalize() {
+    statementCache->close();
     return sqlite3_close(database);
 }
 
@@ -47,6 +48,8 @@ vector<vector<pair<string, string>>> DBInterface::runSelect(string query) {
 // This function inserts a new row to the DB and returns the last inserted row id
 // returns -1 on error
 int DBInterface::runInsert(std::string query) {
+    // The row id has to be read before another insert on the connection
+    std::lock_guard<std::recursive_mutex> lock(statementCache->getWriteMutex());
     char *errorMessage = 0;
     int rc = sqlite3_exec(database, query.c_str(), NULL, NULL, &errorMessage);
     if (rc != SQLITE_OK) {
@@ -74,6 +77,7 @@ int DBInterface::runInsert(std::string query) {
 // This function inserts one or more rows of the DB and nothing is returned
 // This is used for inserting tables which do not have primary IDs
 void DBInterface::runInsertNoIDReturn(std::string query) {
+    std::lock_guard<std::recursive_mutex> lock(statementCache->getWriteMutex());
     char *errorMessage = 0;
     int rc = sqlite3_exec(database, query.c_str(), NULL, NULL, &errorMessage);
     if (rc != SQLITE_OK) {
@@ -84,6 +88,7 @@ void DBInterface::runInsertNoIDReturn(std::string query) {
 
 // This function updates one or more rows of the DB
 void DBInterface::runUpdate(std::string query) {
+    std::lock_guard<std::recursive_mutex> lock(statementCache->getWriteMutex());
     char *errorMessage = 0;
 
     int rc = sqlite3_exec(database, query.c_str(), NULL, NULL, &errorMessage);
@@ -124,3 +129,71 @@ int DBInterface::runSqlNoCallback(const char *zSql) {
 
     return rc;
 }
+
+PreparedStatement DBInterface::prepare(const std::string &sql) {
+    return PreparedStatement(statementCache, sql, statementCache->acquire(database, sql));
+}
+
+bool DBInterface::beginTransaction() {
+    statementCache->getWriteMutex().lock();
+    if (prepare("BEGIN TRANSACTION").execute() != SQLITE_DONE) {
+        statementCache->getWriteMutex().unlock();
+        return false;
+    }
+    return true;
+}
+
+bool DBInterface::commitTransaction() {
+    if (prepare("COMMIT").execute() != SQLITE_DONE) {
+        return false;
+    }
+    statementCache->getWriteMutex().unlock();
+    return true;
+}
+
+void DBInterface::rollbackTransaction() {
+    prepare("ROLLBACK").execute();
+    statementCache->getWriteMutex().unlock();
+}
+
+bool DBInterface::enableWriteAheadLog() {
+    char *errorMessage = 0;
+    // NORMAL synchronization is safe in WAL mode, a crash can only lose the last transactions, never corrupt the DB
+    int rc = sqlite3_exec(database, "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL;", NULL, NULL, &errorMessage);
+    if (rc != SQLITE_OK) {
+        interface_logger.error("SQL Error: " + string(errorMessage) + " while enabling write ahead logging");
+        sqlite3_free(errorMessage);
+        return false;
+    }
+    return true;
+}
+
+int DBInterface::runInsertBatch(const std::string &sql, const std::vector<std::vector<std::string>> &rows) {
+    if (rows.empty()) {
+        return 0;
+    }
+    if (!beginTransaction()) {
+        return -1;
+    }
+
+    int inserted = 0;
+    {
+        PreparedStatement statement = prepare(sql);
+        for (auto &row : rows) {
+            for (size_t i = 0; i < row.size(); i++) {
+                statement.bind(i + 1, row[i]);
+            }
+            if (statement.execute() != SQLITE_DONE) {
+                inserted = -1;
+                break;
+            }
+            inserted++;
+        }
+    }
+
+    if (inserted < 0 || !commitTransaction()) {
+        rollbackTransaction();
+        return -1;
+    }
+    return inserted;
+}
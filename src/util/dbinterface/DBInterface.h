@@ -14,16 +14,21 @@ limitations under the License.
 #ifndef JASMINEGRAPH_SRC_UTIL_DBINTERFACE_H_
 #define JASMINEGRAPH_SRC_UTIL_DBINTERFACE_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <sqlite3.h>
 
+#include "PreparedStatement.h"
+
 using namespace std;
 
 class DBInterface {
  protected:
     sqlite3 *database;
     std::string databaseLocation;
+    // Shared by copies of the interface, which also share the connection
+    std::shared_ptr<StatementCache> statementCache = std::make_shared<StatementCache>();
 
  public:
     virtual int init() = 0;
@@ -39,6 +44,29 @@ class DBInterface {
     void runInsertNoIDReturn(std::string);
 
     int runSqlNoCallback(const char *zSql);
+
+    // Compile the statement or reuse a cached compiled copy of it. Check isValid() on the result.
+    PreparedStatement prepare(const std::string &sql);
+
+    /**
+     * A transaction holds the write lock of the connection from a successful begin until a successful commit or a
+     * rollback, so writes of other threads wait instead of joining it. A failed commit keeps the lock: roll back.
+     */
+    bool beginTransaction();
+
+    bool commitTransaction();
+
+    void rollbackTransaction();
+
+    // Switch the connection to write ahead logging so that readers do not block the frequent metric writes
+    bool enableWriteAheadLog();
+
+    /**
+     * Insert all rows with one compiled statement inside a single transaction. Each row holds the values bound to
+     * the ? parameters of the statement in order. Returns the number of rows inserted, or -1 if the batch failed
+     * and was rolled back.
+     */
+    int runInsertBatch(const std::string &sql, const std::vector<std::vector<std::string>> &rows);
 };
 
 #endif  // JASMINEGRAPH_SRC_UTIL_DBINTERFACE_H_
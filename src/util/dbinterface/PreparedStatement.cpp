@@ -0,0 +1,165 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "PreparedStatement.h"
+
+#include "../logger/Logger.h"
+
+Logger statement_logger;
+
+sqlite3_stmt *StatementCache::acquire(sqlite3 *database, const std::string &sql) {
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto idle = idleStatements.find(sql);
+        if (idle != idleStatements.end()) {
+            sqlite3_stmt *statement = idle->second;
+            idleStatements.erase(idle);
+            return statement;
+        }
+    }
+
+    sqlite3_stmt *statement = NULL;
+    if (sqlite3_prepare_v2(database, sql.c_str(), -1, &statement, NULL) != SQLITE_OK) {
+        statement_logger.error("SQL Error: " + std::string(sqlite3_errmsg(database)) + " " + sql);
+        sqlite3_finalize(statement);
+        return NULL;
+    }
+    return statement;
+}
+
+void StatementCache::release(const std::string &sql, sqlite3_stmt *statement) {
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (closed) {
+        sqlite3_finalize(statement);
+        return;
+    }
+    idleStatements.emplace(sql, statement);
+}
+
+void StatementCache::close() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    for (auto &idle : idleStatements) {
+        sqlite3_finalize(idle.second);
+    }
+    idleStatements.clear();
+    closed = true;
+}
+
+PreparedStatement::PreparedStatement(std::shared_ptr<StatementCache> cache, std::string sql,
+                                     sqlite3_stmt *statement)
+    : cache(cache), sql(sql), statement(statement) {}
+
+PreparedStatement::PreparedStatement(PreparedStatement &&other)
+    : cache(std::move(other.cache)), sql(std::move(other.sql)), statement(other.statement) {
+    other.statement = NULL;
+}
+
+PreparedStatement::~PreparedStatement() {
+    if (statement != NULL) {
+        cache->release(sql, statement);
+    }
+}
+
+PreparedStatement &PreparedStatement::bind(int index, int value) {
+    if (statement != NULL) {
+        sqlite3_bind_int(statement, index, value);
+    }
+    return *this;
+}
+
+PreparedStatement &PreparedStatement::bind(int index, long value) {
+    if (statement != NULL) {
+        sqlite3_bind_int64(statement, index, value);
+    }
+    return *this;
+}
+
+PreparedStatement &PreparedStatement::bind(int index, double value) {
+    if (statement != NULL) {
+        sqlite3_bind_double(statement, index, value);
+    }
+    return *this;
+}
+
+PreparedStatement &PreparedStatement::bind(int index, const std::string &value) {
+    if (statement != NULL) {
+        sqlite3_bind_text(statement, index, value.c_str(), value.size(), SQLITE_TRANSIENT);
+    }
+    return *this;
+}
+
+PreparedStatement &PreparedStatement::bindNull(int index) {
+    if (statement != NULL) {
+        sqlite3_bind_null(statement, index);
+    }
+    return *this;
+}
+
+bool PreparedStatement::next() {
+    if (statement == NULL) {
+        return false;
+    }
+    int rc = sqlite3_step(statement);
+    if (rc == SQLITE_ROW) {
+        return true;
+    }
+    if (rc != SQLITE_DONE) {
+        statement_logger.error("SQL Error: " + std::string(sqlite3_errmsg(sqlite3_db_handle(statement))) + " " + sql);
+    }
+    // Release the read lock as soon as the result set is exhausted. The bound parameters are kept.
+    sqlite3_reset(statement);
+    return false;
+}
+
+int PreparedStatement::execute() {
+    if (statement == NULL) {
+        return SQLITE_ERROR;
+    }
+    std::lock_guard<std::recursive_mutex> lock(cache->getWriteMutex());
+    int rc;
+    while ((rc = sqlite3_step(statement)) == SQLITE_ROW) {
+    }
+    if (rc != SQLITE_DONE) {
+        statement_logger.error("SQL Error: " + std::string(sqlite3_errmsg(sqlite3_db_handle(statement))) + " " + sql);
+    }
+    sqlite3_reset(statement);
+    return rc;
+}
+
+void PreparedStatement::reset() {
+    if (statement != NULL) {
+        sqlite3_reset(statement);
+        sqlite3_clear_bindings(statement);
+    }
+}
+
+int PreparedStatement::getColumnCount() { return statement == NULL ? 0 : sqlite3_column_count(statement); }
+
+bool PreparedStatement::isNull(int column) { return sqlite3_column_type(statement, column) == SQLITE_NULL; }
+
+int PreparedStatement::getInt(int column) { return sqlite3_column_int(statement, column); }
+
+long PreparedStatement::getLong(int column) { return sqlite3_column_int64(statement, column); }
+
+double PreparedStatement::getDouble(int column) { return sqlite3_column_double(statement, column); }
+
+std::string PreparedStatement::getString(int column) {
+    const char *text = getText(column);
+    return text == NULL ? "" : std::string(text, sqlite3_column_bytes(statement, column));
+}
+
+const char *PreparedStatement::getText(int column) {
+    return reinterpret_cast<const char *>(sqlite3_column_text(statement, column));
+}
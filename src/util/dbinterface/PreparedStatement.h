@@ -0,0 +1,117 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_PREPAREDSTATEMENT_H
+#define JASMINEGRAPH_PREPAREDSTATEMENT_H
+
+#include <sqlite3.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * Compiled statements of one database connection keyed by their SQL text. A statement is handed out to one
+ * PreparedStatement at a time, so a connection shared between threads can run the same query concurrently.
+ *
+ * The cache also holds the write lock of the connection. A transaction holds it from begin to commit or rollback
+ * and every write takes it, so the statements of other threads do not end up in the transaction.
+ */
+class StatementCache {
+ public:
+    sqlite3_stmt *acquire(sqlite3 *database, const std::string &sql);
+
+    std::recursive_mutex &getWriteMutex() { return writeMutex; }
+
+    void release(const std::string &sql, sqlite3_stmt *statement);
+
+    // Finalize the idle statements. Statements released afterwards are finalized instead of being cached.
+    void close();
+
+ private:
+    std::mutex cacheMutex;
+    std::recursive_mutex writeMutex;
+    std::multimap<std::string, sqlite3_stmt *> idleStatements;
+    bool closed = false;
+};
+
+/**
+ * Handle to a compiled SQLite statement checked out of the statement cache of a DBInterface. Parameters are
+ * bound by their 1 based index and rows are read in place through typed column accessors (0 based), so no
+ * string is allocated per cell. The statement goes back to the cache when the handle is destroyed, so a handle
+ * that stops reading before the last row should go out of scope (or be reset) to release its read lock.
+ *
+ *     PreparedStatement stmt = perfDb->prepare("SELECT place_id, load_average FROM ... WHERE graph_id = ?");
+ *     stmt.bind(1, graphId);
+ *     while (stmt.next()) {
+ *         long placeId = stmt.getLong(0);
+ *         double load = stmt.getDouble(1);
+ *     }
+ */
+class PreparedStatement {
+ public:
+    PreparedStatement(std::shared_ptr<StatementCache> cache, std::string sql, sqlite3_stmt *statement);
+
+    PreparedStatement(PreparedStatement &&other);
+
+    PreparedStatement(const PreparedStatement &) = delete;
+
+    PreparedStatement &operator=(const PreparedStatement &) = delete;
+
+    ~PreparedStatement();
+
+    bool isValid() const { return statement != NULL; }
+
+    PreparedStatement &bind(int index, int value);
+
+    PreparedStatement &bind(int index, long value);
+
+    PreparedStatement &bind(int index, double value);
+
+    PreparedStatement &bind(int index, const std::string &value);
+
+    PreparedStatement &bindNull(int index);
+
+    // Step to the next row. Returns false when there are no more rows or the statement failed, after which the
+    // statement is rewound and can be run again with the same parameters.
+    bool next();
+
+    // Run a statement that returns no rows. Returns the SQLite result code (SQLITE_DONE on success).
+    int execute();
+
+    // Clear the current result set and the bound parameters so the statement can be run again
+    void reset();
+
+    int getColumnCount();
+
+    bool isNull(int column);
+
+    int getInt(int column);
+
+    long getLong(int column);
+
+    double getDouble(int column);
+
+    std::string getString(int column);
+
+    // Zero copy view of a text column. Only valid until the next call to next() or reset().
+    const char *getText(int column);
+
+ private:
+    std::shared_ptr<StatementCache> cache;
+    std::string sql;
+    sqlite3_stmt *statement;
+};
+
+#endif  // JASMINEGRAPH_PREPAREDSTATEMENT_H
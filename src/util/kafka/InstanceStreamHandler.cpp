@@ -13,10 +13,18 @@
 
 #include "InstanceStreamHandler.h"
 #include "../../localstore/incremental/JasmineGraphIncrementalLocalStore.h"
+#include "../../performance/metrics/MetricsRegistry.h"
 #include "../Utils.h"
 #include "../logger/Logger.h"
 
 Logger instance_stream_logger;
+
+static Gauge &getStreamQueueDepth() {
+    static Gauge &queueDepth = MetricsRegistry::gauge("jasminegraph_stream_queue_depth",
+                                                      "Streamed edges waiting to be added to the local stores");
+    return queueDepth;
+}
+
 InstanceStreamHandler::InstanceStreamHandler(std::map<std::string,
                                              JasmineGraphIncrementalLocalStore*>& incrementalLocalStoreMap)
         : incrementalLocalStoreMap(incrementalLocalStoreMap) { }
@@ -35,6 +43,12 @@ void InstanceStreamHandler::handleRequest(const std::string& nodeString) {
              if (thread.second.joinable()) {
                  thread.second.join();
              }
+             // The stream thread closed the store, so it only has to be released here
+             auto store = incrementalLocalStoreMap.find(thread.first);
+             if (store != incrementalLocalStoreMap.end()) {
+                 delete store->second;
+                 incrementalLocalStoreMap.erase(store);
+             }
          }
 
         return;
@@ -47,9 +61,13 @@ void InstanceStreamHandler::handleRequest(const std::string& nodeString) {
         queues[graphIdentifier] = std::queue<std::string>();
     }
 
+    static Counter &edgesReceived =
+        MetricsRegistry::counter("jasminegraph_stream_edges_received_total", "Streamed edges received from the master");
+    edgesReceived.inc();
+    getStreamQueueDepth().inc();
     queues[graphIdentifier].push(nodeString);
     cond_vars[graphIdentifier].notify_one();
-    instance_stream_logger.info("Pushed into the Queue");
+    JG_LOG_DEBUG(instance_stream_logger, "Pushed into the queue of {}", graphIdentifier);
 }
 
 void InstanceStreamHandler::threadFunction(const std::string& nodeString) {
@@ -77,8 +95,11 @@ void InstanceStreamHandler::threadFunction(const std::string& nodeString) {
             nodeString = queues[graphIdentifier].front();
             queues[graphIdentifier].pop();
         }
+        getStreamQueueDepth().dec();
         localStore->addEdgeFromString(nodeString);
     }
+    // The native store streams are thread local, so the store is closed by the thread that wrote to it
+    localStore->close();
 }
 
 std::string InstanceStreamHandler::extractGraphIdentifier(const std::string& nodeString) {
@@ -14,10 +14,13 @@ limitations under the License.
 #include "StreamHandler.h"
 
 #include <chrono>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <string>
 #include <stdlib.h>
 
+#include "../../frontend/core/cache/AnalyticsResultCache.h"
+#include "../../performance/metrics/MetricsRegistry.h"
 #include "../logger/Logger.h"
 #include "../Utils.h"
 
@@ -31,7 +34,66 @@ StreamHandler::StreamHandler(KafkaConnector *kstream, int numberOfPartitions,
         : kstream(kstream),
           workerClients(workerClients),
           graphPartitioner(numberOfPartitions, 0, spt::Algorithms::HASH),
-          stream_topic_name("stream_topic_name") { }
+          stream_topic_name("stream_topic_name") {
+    useVertexDictionary = Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.vertexdictionary") == "true";
+}
+
+static std::mutex vertexDictionariesMutex;
+static std::map<std::string, std::shared_ptr<VertexDictionary>> openVertexDictionaries;
+
+static std::string getVertexDictionaryDirectory(const std::string &graphId) {
+    return Utils::getHomeDir() + "/.jasminegraph/dictionary/" + graphId;
+}
+
+std::shared_ptr<VertexDictionary> StreamHandler::getVertexDictionary(const std::string &graphId, bool create) {
+    std::lock_guard<std::mutex> lock(vertexDictionariesMutex);
+    auto dictionary = openVertexDictionaries.find(graphId);
+    if (dictionary != openVertexDictionaries.end()) {
+        return dictionary->second;
+    }
+    std::string directory = getVertexDictionaryDirectory(graphId);
+    if (!create && !Utils::fileExists(directory)) {
+        return nullptr;
+    }
+    Utils::createDirectory(Utils::getHomeDir() + "/.jasminegraph/dictionary");
+    std::shared_ptr<VertexDictionary> opened(new VertexDictionary());
+    if (!opened->open(directory)) {
+        stream_handler_logger.error("Vertex ids of graph " + graphId + " are assigned in memory only");
+    }
+    openVertexDictionaries[graphId] = opened;
+    return opened;
+}
+
+void StreamHandler::removeVertexDictionary(const std::string &graphId) {
+    std::lock_guard<std::mutex> lock(vertexDictionariesMutex);
+    openVertexDictionaries.erase(graphId);
+    std::string directory = getVertexDictionaryDirectory(graphId);
+    if (Utils::fileExists(directory)) {
+        Utils::deleteDirectory(directory);
+    }
+}
+
+VertexDictionaryCache &StreamHandler::getVertexDictionaryCache(const std::string &graphId) {
+    auto cache = vertexDictionaryCaches.find(graphId);
+    if (cache != vertexDictionaryCaches.end()) {
+        return *cache->second;
+    }
+    // The handler keeps the dictionary alive for its cache even after the graph is removed
+    std::shared_ptr<VertexDictionary> dictionary = getVertexDictionary(graphId, true);
+    vertexDictionaries[graphId] = dictionary;
+    vertexDictionaryCaches[graphId].reset(new VertexDictionaryCache(*dictionary));
+    return *vertexDictionaryCaches[graphId];
+}
+
+std::atomic<long> &StreamHandler::getGraphVersionCounter(const std::string &graphId) {
+    auto counter = graphVersionCounters.find(graphId);
+    if (counter != graphVersionCounters.end()) {
+        return *counter->second;
+    }
+    std::atomic<long> &graphVersion = AnalyticsResultCache::getVersionCounter(graphId);
+    graphVersionCounters[graphId] = &graphVersion;
+    return graphVersion;
+}
 
 
 // Polls kafka for a message.
@@ -86,6 +148,15 @@ void StreamHandler::listen_to_kafka_topic() {
         auto destinationJson = edgeJson["destination"];
         string sId = std::string(sourceJson["id"]);
         string dId = std::string(destinationJson["id"]);
+        if (useVertexDictionary) {
+            // The stores and the partitioner see dense integer ids, the dictionary keeps the ids of the stream
+            std::vector<uint64_t> ids;
+            getVertexDictionaryCache(std::string(edgeJson["properties"]["graphId"])).getOrAssign({sId, dId}, ids);
+            sId = std::to_string(ids[0]);
+            dId = std::to_string(ids[1]);
+            sourceJson["id"] = sId;
+            destinationJson["id"] = dId;
+        }
         partitionedEdge partitionedEdge = graphPartitioner.addEdge({sId, dId});
         sourceJson["pid"] = partitionedEdge[0].second;
         destinationJson["pid"] = partitionedEdge[1].second;
@@ -113,6 +184,11 @@ void StreamHandler::listen_to_kafka_topic() {
             obj["PID"] = part_d;
             workerClients.at(temp_d)->publish(obj.dump());
         }
+        // The edge is now visible to the workers, so results cached for the previous graph version are stale
+        ++getGraphVersionCounter(std::string(edgeJson["properties"]["graphId"]));
+        static Counter &edgesPublished = MetricsRegistry::counter("jasminegraph_stream_edges_published_total",
+                                                                  "Streamed edges partitioned and sent to the workers");
+        edgesPublished.inc();
     }
 
     graphPartitioner.printStats();
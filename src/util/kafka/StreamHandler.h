@@ -13,10 +13,14 @@ limitations under the License.
 
 #include <cppkafka/cppkafka.h>
 
+#include <atomic>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "../../nativestore/DataPublisher.h"
+#include "../../nativestore/VertexDictionary.h"
 #include "../../partitioner/stream/Partitioner.h"
 #include "../logger/Logger.h"
 #include "KafkaCC.h"
@@ -30,9 +34,28 @@ class StreamHandler {
     bool isEndOfStream(const cppkafka::Message &msg);
     Partitioner graphPartitioner;
 
+    /**
+     * Vertex dictionary of a graph, shared by the stream handlers and the queries of the master and kept under the
+     * master's home directory. Without create, NULL for a graph that has no dictionary.
+     */
+    static std::shared_ptr<VertexDictionary> getVertexDictionary(const std::string &graphId, bool create);
+
+    // Drop the dictionary of a removed graph and delete it from the disk
+    static void removeVertexDictionary(const std::string &graphId);
+
  private:
     KafkaConnector *kstream;
     Logger frontend_logger;
     std::string stream_topic_name;
     std::vector<DataPublisher *> &workerClients;
+    bool useVertexDictionary;
+    std::map<std::string, std::shared_ptr<VertexDictionary>> vertexDictionaries;
+    std::map<std::string, std::unique_ptr<VertexDictionaryCache>> vertexDictionaryCaches;
+    std::map<std::string, std::atomic<long> *> graphVersionCounters;
+
+    // Translation cache of this handler in front of the vertex dictionary of a graph
+    VertexDictionaryCache &getVertexDictionaryCache(const std::string &graphId);
+
+    // Result cache version counter of a graph, bumped for every published edge
+    std::atomic<long> &getGraphVersionCounter(const std::string &graphId);
 };
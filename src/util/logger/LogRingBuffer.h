@@ -0,0 +1,115 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_LOGRINGBUFFER_H
+#define JASMINEGRAPH_LOGRINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * Bounded lock free multi producer multi consumer queue (D. Vyukov's sequence numbered ring). Producers and
+ * consumers only contend on one atomic position each, so pushing a log line never takes a lock. push() fails
+ * instead of blocking when the ring is full, which lets the caller fall back to a synchronous write.
+ */
+template <typename T>
+class LogRingBuffer {
+ public:
+    // The capacity is rounded up to the next power of two
+    explicit LogRingBuffer(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask = size - 1;
+        cells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueuePosition.store(0, std::memory_order_relaxed);
+        dequeuePosition.store(0, std::memory_order_relaxed);
+    }
+
+    LogRingBuffer(const LogRingBuffer &) = delete;
+
+    LogRingBuffer &operator=(const LogRingBuffer &) = delete;
+
+    bool push(T &&item) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (diff == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(item);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &item) {
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (diff == 0) {
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        item = std::move(cell->data);
+        cell->sequence.store(position + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+ private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    // Padding keeps the producer and consumer positions on separate cache lines. alignas would over-align the type,
+    // which new does not honour before C++17.
+    char maskPadding[CACHE_LINE_SIZE];
+    std::atomic<size_t> enqueuePosition;
+    char enqueuePadding[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> dequeuePosition;
+    char dequeuePadding[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+};
+
+#endif  // JASMINEGRAPH_LOGRINGBUFFER_H
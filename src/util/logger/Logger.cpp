@@ -19,7 +19,13 @@ limitations under the License.
 #include <spdlog/spdlog.h>
 #include <stdlib.h>
 
+#include <chrono>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "LogRingBuffer.h"
 
 using namespace std;
 
@@ -29,6 +35,23 @@ auto logger = spdlog::stdout_color_mt("logger");
 auto daily_logger = spdlog::daily_logger_mt("JasmineGraph", "logs/server_logs.log", 00, 01);
 string worker_name = get_worker_name();
 
+const size_t Logger::DEFAULT_ASYNC_CAPACITY = 8192;
+std::atomic<int> Logger::minLevel(LOG_INFO);
+
+struct LogEntry {
+    LogLevel level;
+    pthread_t tid;
+    spdlog::log_clock::time_point time;
+    string message;
+};
+
+static std::once_flag flushOnce;
+static std::mutex asyncMutex;  // Serializes starting and stopping the background writer
+static std::atomic<bool> asyncRunning(false);
+static std::atomic<int> activeProducers(0);
+static std::unique_ptr<LogRingBuffer<LogEntry>> ringBuffer;
+static std::thread writerThread;
+
 static string get_worker_name() {
     char *worker_id = getenv("WORKER_ID");
     if (worker_id) {
@@ -37,24 +60,142 @@ static string get_worker_name() {
     return string("MASTER");
 }
 
+static spdlog::level::level_enum toSpdlogLevel(LogLevel level) {
+    switch (level) {
+        case LOG_TRACE:
+            return spdlog::level::trace;
+        case LOG_DEBUG:
+            return spdlog::level::debug;
+        case LOG_INFO:
+            return spdlog::level::info;
+        case LOG_WARN:
+            return spdlog::level::warn;
+        case LOG_ERROR:
+            return spdlog::level::err;
+        default:
+            return spdlog::level::off;
+    }
+}
+
+static void writeEntry(const LogEntry &entry) {
+    string message = "[" + worker_name + " : " + to_string(entry.tid) + "] " + entry.message;
+    spdlog::level::level_enum level = toSpdlogLevel(entry.level);
+    daily_logger->log(entry.time, spdlog::source_loc{}, level, message);
+    logger->log(entry.time, spdlog::source_loc{}, level, message);
+}
+
+static bool drainRingBuffer() {
+    LogEntry entry;
+    bool drained = false;
+    while (ringBuffer->pop(entry)) {
+        writeEntry(entry);
+        drained = true;
+    }
+    return drained;
+}
+
+static void runWriter() {
+    while (asyncRunning.load()) {
+        if (!drainRingBuffer()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+static void stopAsyncAtExit() { Logger::setAsync(false); }
+
 void Logger::log(std::string message, const std::string log_type) {
-    pthread_t tid = pthread_self();
-    message = "[" + worker_name + " : " + to_string(tid) + "] " + message;
     if (log_type.compare("info") == 0) {
-        daily_logger->info(message);
-        logger->info(message);
+        log(LOG_INFO, message);
     } else if (log_type.compare("warn") == 0) {
-        daily_logger->warn(message);
-        logger->warn(message);
+        log(LOG_WARN, message);
     } else if (log_type.compare("trace") == 0) {
-        daily_logger->trace(message);
-        logger->trace(message);
+        log(LOG_TRACE, message);
     } else if (log_type.compare("error") == 0) {
-        daily_logger->error(message);
-        logger->error(message);
+        log(LOG_ERROR, message);
     } else if (log_type.compare("debug") == 0) {
-        daily_logger->debug(message);
-        logger->debug(message);
+        log(LOG_DEBUG, message);
+    }
+}
+
+void Logger::write(LogLevel level, std::string message) {
+    std::call_once(flushOnce, []() {
+        // Levels are filtered by Logger::isEnabled before a message reaches the sinks
+        logger->set_level(spdlog::level::trace);
+        daily_logger->set_level(spdlog::level::trace);
+        spdlog::flush_every(std::chrono::seconds(5));
+    });
+
+    LogEntry entry{level, pthread_self(), spdlog::log_clock::now(), std::move(message)};
+    // The producer count lets setAsync(false) wait for pushes that already saw the writer running, so a message
+    // is never left behind in a ring buffer that nobody drains anymore
+    activeProducers.fetch_add(1);
+    if (asyncRunning.load() && ringBuffer->push(std::move(entry))) {
+        activeProducers.fetch_sub(1);
+        return;
+    }
+    activeProducers.fetch_sub(1);
+    writeEntry(entry);
+}
+
+void Logger::setLevel(LogLevel level) { minLevel.store(level, std::memory_order_relaxed); }
+
+LogLevel Logger::getLevel() { return static_cast<LogLevel>(minLevel.load(std::memory_order_relaxed)); }
+
+LogLevel Logger::parseLevel(const std::string &name) {
+    if (name == "trace") {
+        return LOG_TRACE;
+    } else if (name == "debug") {
+        return LOG_DEBUG;
+    } else if (name == "warn") {
+        return LOG_WARN;
+    } else if (name == "error") {
+        return LOG_ERROR;
+    } else if (name == "off") {
+        return LOG_OFF;
+    }
+    return LOG_INFO;
+}
+
+void Logger::setAsync(bool enabled, size_t capacity) {
+    static bool exitHandlerRegistered = false;
+    std::lock_guard<std::mutex> lock(asyncMutex);
+    if (enabled == asyncRunning.load()) {
+        return;
+    }
+
+    if (enabled) {
+        ringBuffer.reset(new LogRingBuffer<LogEntry>(capacity));
+        asyncRunning.store(true);
+        writerThread = std::thread(runWriter);
+        if (!exitHandlerRegistered) {
+            // Registered after the sinks were created, so it runs before they are destroyed
+            atexit(stopAsyncAtExit);
+            exitHandlerRegistered = true;
+        }
+        return;
+    }
+
+    asyncRunning.store(false);
+    writerThread.join();
+    while (activeProducers.load() > 0) {
+        std::this_thread::yield();
+    }
+    drainRingBuffer();
+    ringBuffer.reset();
+    logger->flush();
+    daily_logger->flush();
+}
+
+bool Logger::isAsync() { return asyncRunning.load(); }
+
+void Logger::flush() {
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        if (asyncRunning.load()) {
+            drainRingBuffer();
+        }
     }
-    spdlog::flush_every(std::chrono::seconds(5));
+    logger->flush();
+    daily_logger->flush();
 }
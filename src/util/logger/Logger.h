@@ -14,15 +14,113 @@ limitations under the License.
 #ifndef JASMINEGRAPH_SPDLOGGER_H
 #define JASMINEGRAPH_SPDLOGGER_H
 
+#include <spdlog/fmt/fmt.h>
+
+#include <atomic>
 #include <string>
 
+enum LogLevel { LOG_TRACE = 0, LOG_DEBUG = 1, LOG_INFO = 2, LOG_WARN = 3, LOG_ERROR = 4, LOG_OFF = 5 };
+
+/**
+ * Logging calls below this level are compiled out by the JG_LOG_* macros. Building with
+ * -DJASMINEGRAPH_MIN_LOG_LEVEL=2 (cmake -DJASMINEGRAPH_STRIP_DEBUG_LOGS=ON) strips the trace and debug logging
+ * from the hot paths so not even the level check is left behind.
+ */
+#ifndef JASMINEGRAPH_MIN_LOG_LEVEL
+#define JASMINEGRAPH_MIN_LOG_LEVEL 0
+#endif
+
+#if JASMINEGRAPH_MIN_LOG_LEVEL <= 0
+#define JG_LOG_TRACE(logger, ...) (logger).trace(__VA_ARGS__)
+#else
+#define JG_LOG_TRACE(logger, ...) static_cast<void>(0)
+#endif
+
+#if JASMINEGRAPH_MIN_LOG_LEVEL <= 1
+#define JG_LOG_DEBUG(logger, ...) (logger).debug(__VA_ARGS__)
+#else
+#define JG_LOG_DEBUG(logger, ...) static_cast<void>(0)
+#endif
+
+/**
+ * Messages below the runtime level (Logger::setLevel) are dropped before they are formatted. The overloads taking
+ * a format string and arguments ("Adding node {}", id) only format the message once it passed the level check,
+ * so disabled debug logging on a hot path costs one relaxed atomic load.
+ *
+ * In async mode (Logger::setAsync) the calling thread only pushes the formatted message into a lock free ring
+ * buffer and a background thread writes it to the console and the daily log file. When the ring buffer is full
+ * the message is written synchronously, so no message is ever dropped.
+ */
 class Logger {
  public:
+    static const size_t DEFAULT_ASYNC_CAPACITY;
+
     void log(std::string message, const std::string log_type);
-    void info(std::string message) { log(message, "info"); };
-    void warn(std::string message) { log(message, "warn"); };
-    void debug(std::string message) { log(message, "debug"); };
-    void error(std::string message) { log(message, "error"); };
+    void trace(const std::string &message) { log(LOG_TRACE, message); }
+    void info(const std::string &message) { log(LOG_INFO, message); }
+    void warn(const std::string &message) { log(LOG_WARN, message); }
+    void debug(const std::string &message) { log(LOG_DEBUG, message); }
+    void error(const std::string &message) { log(LOG_ERROR, message); }
+
+    template <typename Arg, typename... Args>
+    void trace(const char *format, const Arg &arg, const Args &... args) {
+        logFormat(LOG_TRACE, format, arg, args...);
+    }
+
+    template <typename Arg, typename... Args>
+    void debug(const char *format, const Arg &arg, const Args &... args) {
+        logFormat(LOG_DEBUG, format, arg, args...);
+    }
+
+    template <typename Arg, typename... Args>
+    void info(const char *format, const Arg &arg, const Args &... args) {
+        logFormat(LOG_INFO, format, arg, args...);
+    }
+
+    template <typename Arg, typename... Args>
+    void warn(const char *format, const Arg &arg, const Args &... args) {
+        logFormat(LOG_WARN, format, arg, args...);
+    }
+
+    template <typename Arg, typename... Args>
+    void error(const char *format, const Arg &arg, const Args &... args) {
+        logFormat(LOG_ERROR, format, arg, args...);
+    }
+
+    static bool isEnabled(LogLevel level) { return level >= minLevel.load(std::memory_order_relaxed); }
+
+    static void setLevel(LogLevel level);
+
+    static LogLevel getLevel();
+
+    // Map a level name (trace, debug, info, warn, error, off) to its level. Unknown names map to LOG_INFO.
+    static LogLevel parseLevel(const std::string &name);
+
+    // Start or stop the background writer. Stopping drains the messages that are still queued.
+    static void setAsync(bool enabled, size_t capacity = DEFAULT_ASYNC_CAPACITY);
+
+    static bool isAsync();
+
+    // Write out the queued messages and flush the sinks
+    static void flush();
+
+ private:
+    static std::atomic<int> minLevel;
+
+    void log(LogLevel level, const std::string &message) {
+        if (isEnabled(level)) {
+            write(level, message);
+        }
+    }
+
+    template <typename... Args>
+    void logFormat(LogLevel level, const char *format, const Args &... args) {
+        if (isEnabled(level)) {
+            write(level, fmt::format(format, args...));
+        }
+    }
+
+    static void write(LogLevel level, std::string message);
 };
 
 #endif  // JASMINEGRAPH_SPDLOGGER_H
@@ -0,0 +1,165 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "BenchmarkGraphs.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <unordered_set>
+
+BenchmarkGraphs::Options BenchmarkGraphs::options;
+
+static std::vector<std::pair<std::string, BenchmarkGraphs::GraphBenchmark>> &graphBenchmarks() {
+    static std::vector<std::pair<std::string, BenchmarkGraphs::GraphBenchmark>> benchmarks;
+    return benchmarks;
+}
+
+static std::string rmatName() { return "rmat" + std::to_string(BenchmarkGraphs::options.scale); }
+
+EdgeList BenchmarkGraphs::rmat(int scale, int edgeFactor, unsigned long seed) {
+    const double a = 0.57, b = 0.19, c = 0.19;
+    long vertexCount = 1L << scale;
+    long edgeCount = edgeFactor * vertexCount;
+
+    std::mt19937_64 random(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    // Vertex ids are shuffled so that high degree vertices are not clustered at the low ids
+    std::vector<long> permutation(vertexCount);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::shuffle(permutation.begin(), permutation.end(), random);
+
+    std::unordered_set<long> seen;
+    EdgeList edges;
+    edges.reserve(edgeCount);
+    for (long i = 0; i < edgeCount; i++) {
+        long from = 0;
+        long to = 0;
+        for (int level = 0; level < scale; level++) {
+            double p = uniform(random);
+            from <<= 1;
+            to <<= 1;
+            if (p < a) {
+                continue;
+            } else if (p < a + b) {
+                to |= 1;
+            } else if (p < a + b + c) {
+                from |= 1;
+            } else {
+                from |= 1;
+                to |= 1;
+            }
+        }
+        if (from == to || !seen.insert(from * vertexCount + to).second) {
+            continue;
+        }
+        edges.push_back(std::make_pair(permutation[from], permutation[to]));
+    }
+    return edges;
+}
+
+EdgeList BenchmarkGraphs::readEdgeList(const std::string &path) {
+    EdgeList edges;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#' || line[0] == '%') {
+            continue;
+        }
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream stream(line);
+        long from;
+        long to;
+        if (stream >> from >> to) {
+            edges.push_back(std::make_pair(from, to));
+        }
+    }
+    return edges;
+}
+
+void BenchmarkGraphs::writeEdgeList(const EdgeList &edges, const std::string &path) {
+    std::ofstream file(path);
+    for (auto &edge : edges) {
+        file << edge.first << " " << edge.second << "\n";
+    }
+}
+
+std::vector<std::string> BenchmarkGraphs::names() {
+    std::vector<std::string> names;
+    names.push_back(rmatName());
+
+    DIR *dir = opendir(options.datasetDir.c_str());
+    if (dir == NULL) {
+        return names;
+    }
+    std::vector<std::string> datasets;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        struct stat fileStat;
+        std::string path = options.datasetDir + "/" + entry->d_name;
+        if (stat(path.c_str(), &fileStat) == 0 && S_ISREG(fileStat.st_mode)) {
+            datasets.push_back(entry->d_name);
+        }
+    }
+    closedir(dir);
+    std::sort(datasets.begin(), datasets.end());
+    names.insert(names.end(), datasets.begin(), datasets.end());
+    return names;
+}
+
+const EdgeList &BenchmarkGraphs::get(const std::string &name) {
+    static std::map<std::string, EdgeList> graphs;
+    auto graph = graphs.find(name);
+    if (graph == graphs.end()) {
+        if (name == rmatName()) {
+            graph = graphs.emplace(name, rmat(options.scale, options.edgeFactor, options.seed)).first;
+        } else {
+            graph = graphs.emplace(name, readEdgeList(options.datasetDir + "/" + name)).first;
+        }
+    }
+    return graph->second;
+}
+
+std::string BenchmarkGraphs::edgeListFile(const std::string &name) {
+    if (name != rmatName()) {
+        return options.datasetDir + "/" + name;
+    }
+    std::string path = options.scratchDir + "/" + name + "_" + std::to_string(options.edgeFactor) + "_" +
+                       std::to_string(options.seed) + ".txt";
+    std::ifstream existing(path);
+    if (!existing.good()) {
+        writeEdgeList(get(name), path);
+    }
+    return path;
+}
+
+int BenchmarkGraphs::addBenchmark(const std::string &name, GraphBenchmark function) {
+    graphBenchmarks().push_back(std::make_pair(name, function));
+    return static_cast<int>(graphBenchmarks().size());
+}
+
+void BenchmarkGraphs::registerBenchmarks() {
+    for (auto &graph : names()) {
+        for (auto &graphBenchmark : graphBenchmarks()) {
+            std::string name = graphBenchmark.first + "/" + graph;
+            benchmark::RegisterBenchmark(name.c_str(), graphBenchmark.second, graph)->Unit(benchmark::kMillisecond);
+        }
+    }
+}
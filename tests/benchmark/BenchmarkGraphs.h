@@ -0,0 +1,72 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JASMINEGRAPH_BENCHMARKGRAPHS_H
+#define JASMINEGRAPH_BENCHMARKGRAPHS_H
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef std::vector<std::pair<long, long>> EdgeList;
+
+/**
+ * Input graphs of the benchmark suite. Every benchmark registered with JASMINEGRAPH_GRAPH_BENCHMARK runs once per
+ * input graph: a synthetic R-MAT graph generated from a fixed seed, so the same scale gives the same graph on every
+ * run and every machine, and each edge list file found in the dataset directory.
+ */
+class BenchmarkGraphs {
+ public:
+    struct Options {
+        int scale = 14;           // R-MAT graphs have 2^scale vertices
+        int edgeFactor = 8;       // and edgeFactor * 2^scale generated edges
+        unsigned long seed = 42;
+        std::string datasetDir;   // Edge list files, one "<from> <to>" pair per line
+        std::string scratchDir;   // Files written by the benchmarks
+    };
+
+    typedef void (*GraphBenchmark)(benchmark::State &, const std::string &);
+
+    static Options options;
+
+    /**
+     * Recursive matrix graph (Chakrabarti, Zhan and Faloutsos) with the Graph500 probabilities a=0.57, b=c=0.19,
+     * which gives the skewed power-law degree distribution of real graphs. Self loops and duplicate edges are dropped.
+     */
+    static EdgeList rmat(int scale, int edgeFactor, unsigned long seed);
+
+    static EdgeList readEdgeList(const std::string &path);
+
+    static void writeEdgeList(const EdgeList &edges, const std::string &path);
+
+    // Names of the input graphs: "rmat<scale>" followed by the dataset files
+    static std::vector<std::string> names();
+
+    // Edges of an input graph, loaded or generated once and kept for the other benchmarks
+    static const EdgeList &get(const std::string &name);
+
+    // Edge list file of an input graph, written to the scratch directory for generated graphs
+    static std::string edgeListFile(const std::string &name);
+
+    static int addBenchmark(const std::string &name, GraphBenchmark function);
+
+    // Register every graph benchmark once per input graph, as <benchmark>/<graph>
+    static void registerBenchmarks();
+};
+
+#define JASMINEGRAPH_GRAPH_BENCHMARK(function) \
+    static int function##_registration = BenchmarkGraphs::addBenchmark(#function, function)
+
+#endif  // JASMINEGRAPH_BENCHMARKGRAPHS_H
@@ -0,0 +1,88 @@
+"""Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+# Compare two JSON result files of jasminegraph_bench and fail when a benchmark got slower.
+#
+#     python3 tests/benchmark/compare.py baseline.json contender.json --threshold 10
+#
+# When the results were recorded with --benchmark_repetitions, the median of the repetitions is compared.
+# The exit status is 1 if any benchmark is slower than the baseline by more than the threshold (in percent).
+
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    with open(path) as result_file:
+        results = json.load(result_file)
+
+    iterations = {}
+    medians = {}
+    for benchmark in results.get('benchmarks', []):
+        if benchmark.get('error_occurred'):
+            continue
+        if benchmark.get('run_type') == 'aggregate':
+            if benchmark.get('aggregate_name') == 'median':
+                medians[benchmark['run_name']] = benchmark
+        else:
+            # Without repetitions there is one iteration row per benchmark
+            iterations.setdefault(benchmark.get('run_name', benchmark['name']), benchmark)
+    iterations.update(medians)
+    return results.get('context', {}), iterations
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare two jasminegraph_bench JSON result files')
+    parser.add_argument('baseline')
+    parser.add_argument('contender')
+    parser.add_argument('--threshold', type=float, default=10.0,
+                        help='slowdown in percent that is reported as a regression (default 10)')
+    parser.add_argument('--metric', choices=['real_time', 'cpu_time'], default='real_time')
+    args = parser.parse_args()
+
+    baseline_context, baseline = load_results(args.baseline)
+    contender_context, contender = load_results(args.contender)
+    print('baseline  %s (%s)' % (args.baseline, baseline_context.get('git_commit', 'unknown')))
+    print('contender %s (%s)' % (args.contender, contender_context.get('git_commit', 'unknown')))
+    print()
+
+    names = sorted(set(baseline) & set(contender))
+    width = max([len(name) for name in names] + [9])
+    print('%-*s %14s %14s %9s' % (width, 'Benchmark', 'Baseline', 'Contender', 'Change'))
+
+    regressions = []
+    for name in names:
+        old = baseline[name]
+        new = contender[name]
+        if old['time_unit'] != new['time_unit'] or old[args.metric] == 0:
+            continue
+        change = (new[args.metric] - old[args.metric]) * 100.0 / old[args.metric]
+        marker = ''
+        if change > args.threshold:
+            regressions.append(name)
+            marker = '  REGRESSION'
+        print('%-*s %11.3f %-2s %11.3f %-2s %+8.1f%%%s' % (width, name, old[args.metric], old['time_unit'],
+                                                         new[args.metric], new['time_unit'], change, marker))
+
+    for name in sorted(set(baseline) ^ set(contender)):
+        print('%-*s only in %s' % (width, name, 'baseline' if name in baseline else 'contender'))
+
+    if regressions:
+        print()
+        print('%d benchmark(s) slower by more than %.1f%%' % (len(regressions), args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,113 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/localstore/attribute/JasmineGraphAttributeStore.h"
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+
+#include "../../../src/util/Utils.h"
+#include "../BenchmarkGraphs.h"
+
+static const int FEATURE_COUNT = 128;
+
+// Text attribute file as the partitioner writes it, a sparse 0/1 feature row per vertex like the citation graphs
+static std::string writeAttributeFile(const std::string &graph) {
+    std::string textPath = BenchmarkGraphs::options.scratchDir + "/" + graph + "_attributes_0";
+    std::set<long> vertices;
+    for (auto &edge : BenchmarkGraphs::get(graph)) {
+        vertices.insert(edge.first);
+        vertices.insert(edge.second);
+    }
+    std::mt19937_64 random(BenchmarkGraphs::options.seed);
+    std::ofstream textFile(textPath);
+    for (long vertex : vertices) {
+        textFile << vertex << "\t";
+        for (int i = 0; i < FEATURE_COUNT; i++) {
+            textFile << (i == 0 ? "" : " ") << (random() % 10 == 0 ? "1" : "0");
+        }
+        textFile << "\n";
+    }
+    return textPath;
+}
+
+// Reading the attributes of a partition from the text file into the map of strings the local store keeps
+static void BM_AttributeStore_loadText(benchmark::State &state, const std::string &graph) {
+    std::string textPath = writeAttributeFile(graph);
+    size_t rowCount = 0;
+    size_t valueCount = 0;
+    for (auto _ : state) {
+        std::map<long, std::vector<std::string>> attributes;
+        std::ifstream textFile(textPath);
+        std::string line;
+        while (std::getline(textFile, line)) {
+            std::istringstream values(line);
+            long vertex;
+            values >> vertex;
+            std::vector<std::string> &row = attributes[vertex];
+            std::string value;
+            while (values >> value) {
+                row.push_back(value);
+            }
+            valueCount += row.size();
+        }
+        rowCount = attributes.size();
+        benchmark::DoNotOptimize(attributes);
+    }
+    state.SetBytesProcessed(state.iterations() * Utils::getFileSize(textPath));
+    state.counters["file_bytes"] = Utils::getFileSize(textPath);
+    // Lower bound of the memory the loaded map takes, short strings are stored inline
+    state.counters["memory_bytes"] = valueCount / state.iterations() * sizeof(std::string) +
+                                     rowCount * sizeof(std::vector<std::string>);
+    state.counters["vertices"] = rowCount;
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_AttributeStore_loadText);
+
+// Mapping the columnar store of the same attributes and reading every feature in place
+static void BM_JasmineGraphAttributeStore_open(benchmark::State &state, const std::string &graph) {
+    std::string textPath = writeAttributeFile(graph);
+    std::string storePath = JasmineGraphAttributeStore::getStorePath(BenchmarkGraphs::options.scratchDir,
+                                                                      graph + "_attributes_0");
+    if (!JasmineGraphAttributeStore::convertTextFile(textPath, storePath)) {
+        state.SkipWithError(("Cannot convert " + textPath).c_str());
+        return;
+    }
+
+    long rowCount = 0;
+    for (auto _ : state) {
+        JasmineGraphAttributeStore store(storePath);
+        if (!store.open()) {
+            state.SkipWithError(("Cannot open " + storePath).c_str());
+            break;
+        }
+        rowCount = store.size();
+        long sum = 0;
+        for (long row = 0; row < rowCount; row++) {
+            const int32_t *features = store.getIntVector(row, 0);
+            for (int i = 0; i < store.getWidth(0); i++) {
+                sum += features[i];
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * Utils::getFileSize(storePath));
+    state.counters["file_bytes"] = Utils::getFileSize(storePath);
+    state.counters["memory_bytes"] = Utils::getFileSize(storePath);
+    state.counters["vertices"] = rowCount;
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_JasmineGraphAttributeStore_open);
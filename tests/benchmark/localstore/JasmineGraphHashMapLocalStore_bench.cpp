@@ -0,0 +1,49 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/localstore/JasmineGraphHashMapLocalStore.h"
+
+#include <benchmark/benchmark.h>
+
+#include "../../../src/util/Utils.h"
+#include "../BenchmarkGraphs.h"
+
+// Loading a partition from its flatbuffers edge store, which a worker does before serving a query on it
+static void BM_JasmineGraphHashMapLocalStore_loadGraph(benchmark::State &state, const std::string &graph) {
+    const int graphId = 900003;
+    const int partitionId = 0;
+    const EdgeList &edges = BenchmarkGraphs::get(graph);
+    std::map<int, std::vector<int>> edgeMap;
+    for (auto &edge : edges) {
+        edgeMap[edge.first].push_back(edge.second);
+    }
+
+    std::string folder = BenchmarkGraphs::options.scratchDir;
+    std::string storePath = folder + "/" + std::to_string(graphId) + "_" + std::to_string(partitionId);
+    JasmineGraphHashMapLocalStore writer;
+    writer.storePartEdgeMap(edgeMap, storePath);
+
+    long vertexCount = 0;
+    for (auto _ : state) {
+        JasmineGraphHashMapLocalStore store(graphId, partitionId, folder);
+        if (!store.loadGraph()) {
+            state.SkipWithError(("Cannot load " + storePath).c_str());
+            break;
+        }
+        vertexCount = store.getVertexCount();
+        benchmark::DoNotOptimize(vertexCount);
+    }
+    state.SetBytesProcessed(state.iterations() * Utils::getFileSize(storePath));
+    state.counters["vertices"] = vertexCount;
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_JasmineGraphHashMapLocalStore_loadGraph);
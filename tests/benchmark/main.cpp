@@ -0,0 +1,83 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../../src/util/Utils.h"
+#include "../../src/util/logger/Logger.h"
+#include "BenchmarkGraphs.h"
+
+#ifndef JASMINEGRAPH_GIT_COMMIT
+#define JASMINEGRAPH_GIT_COMMIT "unknown"
+#endif
+
+static bool parseOption(const char *arg, const char *name, std::string &value) {
+    size_t length = strlen(name);
+    if (strncmp(arg, name, length) != 0 || arg[length] != '=') {
+        return false;
+    }
+    value = arg + length + 1;
+    return true;
+}
+
+/**
+ * Runs the benchmarks with the usual Google Benchmark flags, e.g.
+ *
+ *     jasminegraph_bench --benchmark_out=results.json --benchmark_out_format=json --rmat_scale=16
+ *
+ * and the options of the input graphs: --rmat_scale, --rmat_edge_factor, --rmat_seed and --dataset_dir.
+ */
+int main(int argc, char **argv) {
+    BenchmarkGraphs::options.datasetDir = std::string(ROOT_DIR) + "tests/integration/env_init/data";
+    BenchmarkGraphs::options.scratchDir = "/tmp/jasminegraph-bench";
+
+    std::vector<char *> benchmarkArgs;
+    for (int i = 0; i < argc; i++) {
+        std::string value;
+        if (parseOption(argv[i], "--rmat_scale", value)) {
+            BenchmarkGraphs::options.scale = std::stoi(value);
+        } else if (parseOption(argv[i], "--rmat_edge_factor", value)) {
+            BenchmarkGraphs::options.edgeFactor = std::stoi(value);
+        } else if (parseOption(argv[i], "--rmat_seed", value)) {
+            BenchmarkGraphs::options.seed = std::stoul(value);
+        } else if (parseOption(argv[i], "--dataset_dir", value)) {
+            BenchmarkGraphs::options.datasetDir = value;
+        } else {
+            benchmarkArgs.push_back(argv[i]);
+        }
+    }
+    int benchmarkArgc = static_cast<int>(benchmarkArgs.size());
+
+    // Per operation log lines would dominate the measured time
+    Logger::setLevel(LOG_WARN);
+    Utils::createDirectory(BenchmarkGraphs::options.scratchDir);
+    Utils::createDirectory(Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder"));
+
+    benchmark::Initialize(&benchmarkArgc, benchmarkArgs.data());
+    if (benchmark::ReportUnrecognizedArguments(benchmarkArgc, benchmarkArgs.data())) {
+        return 1;
+    }
+    benchmark::AddCustomContext("git_commit", JASMINEGRAPH_GIT_COMMIT);
+    benchmark::AddCustomContext("rmat_scale", std::to_string(BenchmarkGraphs::options.scale));
+    benchmark::AddCustomContext("rmat_edge_factor", std::to_string(BenchmarkGraphs::options.edgeFactor));
+    benchmark::AddCustomContext("rmat_seed", std::to_string(BenchmarkGraphs::options.seed));
+
+    BenchmarkGraphs::registerBenchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
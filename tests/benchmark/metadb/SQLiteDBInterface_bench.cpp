@@ -0,0 +1,79 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+#include "../../../src/metadb/SQLiteDBInterface.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../BenchmarkGraphs.h"
+
+// A meta DB in the scratch directory with 2000 hosts, removed when the benchmark ends
+class ScratchMetaDB {
+ public:
+    ScratchMetaDB() : path(BenchmarkGraphs::options.scratchDir + "/jasminegraph_bench_meta.db"), db(path) {
+        std::remove(path.c_str());
+        db.init();
+        std::vector<std::vector<std::string>> rows;
+        for (int i = 0; i < 2000; i++) {
+            std::string ip = "10.0." + std::to_string(i / 256) + "." + std::to_string(i % 256);
+            rows.push_back({"worker" + std::to_string(i), ip});
+        }
+        db.runInsertBatch("INSERT INTO host('name', 'ip') VALUES(?, ?)", rows);
+    }
+
+    ~ScratchMetaDB() {
+        db.finalize();
+        std::remove(path.c_str());
+    }
+
+    std::string path;
+    SQLiteDBInterface db;
+};
+
+// A repeated parameterised lookup through sqlite3_exec, which compiles the query and boxes every cell in a string
+static void BM_SQLiteDBInterface_runSelect(benchmark::State &state) {
+    ScratchMetaDB metaDB;
+    long sum = 0;
+    int i = 0;
+    for (auto _ : state) {
+        auto result = metaDB.db.runSelect("SELECT idhost, ip FROM host WHERE idhost <= " + std::to_string(i % 50 + 1));
+        for (auto &row : result) {
+            sum += std::stol(row[0].second);
+        }
+        i++;
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SQLiteDBInterface_runSelect);
+
+// The same lookup through a cached prepared statement with typed column reads
+static void BM_SQLiteDBInterface_prepared(benchmark::State &state) {
+    ScratchMetaDB metaDB;
+    long sum = 0;
+    int i = 0;
+    for (auto _ : state) {
+        PreparedStatement statement = metaDB.db.prepare("SELECT idhost, ip FROM host WHERE idhost <= ?");
+        statement.bind(1, i % 50 + 1);
+        while (statement.next()) {
+            sum += statement.getLong(0);
+        }
+        i++;
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SQLiteDBInterface_prepared);
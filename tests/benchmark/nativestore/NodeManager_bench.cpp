@@ -0,0 +1,59 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/nativestore/NodeManager.h"
+
+#include <benchmark/benchmark.h>
+
+#include "../../../src/util/Utils.h"
+#include "../BenchmarkGraphs.h"
+
+// Streaming ingestion into the native store, the per edge cost paid by every worker for every streamed edge
+static void BM_NodeManager_addLocalEdge(benchmark::State &state, const std::string &graph) {
+    const EdgeList &edges = BenchmarkGraphs::get(graph);
+    std::vector<std::pair<std::string, std::string>> labelledEdges;
+    labelledEdges.reserve(edges.size());
+    for (auto &edge : edges) {
+        labelledEdges.push_back(std::make_pair(std::to_string(edge.first), std::to_string(edge.second)));
+    }
+
+    GraphConfig graphConfig;
+    graphConfig.graphID = 900002;
+    graphConfig.partitionID = 0;
+    graphConfig.maxLabelSize = std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size"));
+    graphConfig.openMode = "trunc";
+
+    double falsePositiveRate = 0;
+    size_t filterBytes = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        NodeManager *nodeManager = new NodeManager(graphConfig);
+        state.ResumeTiming();
+
+        for (auto &edge : labelledEdges) {
+            benchmark::DoNotOptimize(nodeManager->addLocalEdge(edge));
+        }
+
+        state.PauseTiming();
+        falsePositiveRate = nodeManager->getEdgeFilter(true).getFalsePositiveRate();
+        filterBytes = nodeManager->getEdgeFilter(true).getSizeInBytes();
+        nodeManager->close();
+        delete nodeManager;
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * labelledEdges.size());
+    // Share of the new edges for which the edge filter could not rule out an existing relation
+    state.counters["filter_false_positive_rate"] = falsePositiveRate;
+    state.counters["filter_bytes"] = filterBytes;
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_NodeManager_addLocalEdge);
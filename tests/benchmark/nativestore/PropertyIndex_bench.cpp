@@ -0,0 +1,126 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/nativestore/PropertyIndex.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+
+#include "../../../src/nativestore/PropertyStore.h"
+#include "../BenchmarkGraphs.h"
+
+static const int WEIGHT_COUNT = 100;
+
+static std::string edgeWeight(const std::pair<long, long> &edge) {
+    return std::to_string((edge.first * 31 + edge.second) % WEIGHT_COUNT);
+}
+
+// Edge properties with an ordered index on the weight, the entity of an edge being its position
+static std::vector<unsigned int> fillStore(PropertyStore &store, const EdgeList &edges, const std::string &path) {
+    store.open(path, true);
+    store.createIndex("weight", PropertyIndex::ORDERED);
+    std::vector<unsigned int> references;
+    for (size_t i = 0; i < edges.size(); i++) {
+        unsigned int reference = store.put(0, "relationship_type", "follows", i);
+        references.push_back(store.put(reference, "weight", edgeWeight(edges[i]), i));
+    }
+    return references;
+}
+
+static void removeStore(const std::string &path) {
+    for (auto suffix : {".keys.db", ".runs.db", ".indexes.db", ".index0.db", ".index1.db"}) {
+        remove((path + suffix).c_str());
+    }
+}
+
+// Indexing the weights the edges already have, as when an index is created on a loaded partition
+static void BM_PropertyIndex_build(benchmark::State &state, const std::string &graph) {
+    const EdgeList &edges = BenchmarkGraphs::get(graph);
+    std::string path = BenchmarkGraphs::options.scratchDir + "/bench_index";
+    for (auto _ : state) {
+        state.PauseTiming();
+        PropertyIndex index(path + ".index0.db", PropertyIndex::ORDERED);
+        index.open(true);
+        state.ResumeTiming();
+        for (size_t i = 0; i < edges.size(); i++) {
+            index.add(edgeWeight(edges[i]), i);
+        }
+        index.close();
+    }
+    state.SetItemsProcessed(state.iterations() * edges.size());
+    removeStore(path);
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_PropertyIndex_build);
+
+// Finding the edges of every weight, through the index and by reading the properties of every edge
+static void BM_PropertyIndex_lookup(benchmark::State &state, const std::string &graph) {
+    const EdgeList &edges = BenchmarkGraphs::get(graph);
+    std::string path = BenchmarkGraphs::options.scratchDir + "/bench_index";
+    PropertyStore store;
+    fillStore(store, edges, path);
+    PropertyIndex *index = store.getIndex("weight");
+    for (auto _ : state) {
+        for (int weight = 0; weight < WEIGHT_COUNT; weight++) {
+            benchmark::DoNotOptimize(index->lookup(std::to_string(weight)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * WEIGHT_COUNT);
+    store.close();
+    removeStore(path);
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_PropertyIndex_lookup);
+
+static void BM_PropertyIndex_scan(benchmark::State &state, const std::string &graph) {
+    const EdgeList &edges = BenchmarkGraphs::get(graph);
+    std::string path = BenchmarkGraphs::options.scratchDir + "/bench_index";
+    PropertyStore store;
+    std::vector<unsigned int> references = fillStore(store, edges, path);
+    std::string value;
+    for (auto _ : state) {
+        // One weight per iteration, the index answers all of them in the time of one scan
+        std::string weight = std::to_string(state.iterations() % WEIGHT_COUNT);
+        std::vector<uint64_t> matches;
+        for (size_t i = 0; i < references.size(); i++) {
+            if (store.get(references[i], "weight", value) && value == weight) {
+                matches.push_back(i);
+            }
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+    state.SetItemsProcessed(state.iterations());
+    store.close();
+    removeStore(path);
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_PropertyIndex_scan);
+
+// The edges with a weight in a range of a tenth of the weights
+static void BM_PropertyIndex_range(benchmark::State &state, const std::string &graph) {
+    const EdgeList &edges = BenchmarkGraphs::get(graph);
+    std::string path = BenchmarkGraphs::options.scratchDir + "/bench_index";
+    PropertyStore store;
+    fillStore(store, edges, path);
+    PropertyIndex *index = store.getIndex("weight");
+    size_t matches = 0;
+    for (auto _ : state) {
+        int from = state.iterations() % (WEIGHT_COUNT - 10);
+        std::vector<uint64_t> entities = index->range(std::to_string(from), std::to_string(from + 9));
+        matches = entities.size();
+        benchmark::DoNotOptimize(entities);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["matches"] = matches;
+    store.close();
+    removeStore(path);
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_PropertyIndex_range);
@@ -0,0 +1,143 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/nativestore/PropertyStore.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "../../../src/nativestore/RelationBlock.h"
+#include "../BenchmarkGraphs.h"
+
+// Properties a stream typically attaches to an edge
+static std::vector<std::pair<std::string, std::string>> edgeProperties(const std::pair<long, long> &edge) {
+    return {{"weight", std::to_string((edge.first * 31 + edge.second) % 100)},
+            {"relationship_type", "follows"},
+            {"created_at", "2024-03-" + std::to_string(10 + edge.second % 20) + "T12:00:00Z"}};
+}
+
+static const int PROPERTIES_PER_EDGE = 3;
+// Name, value and next address of a block of the linked property format that the store replaced
+static const int LEGACY_BLOCK_SIZE = 12 + 180 + 4;
+
+// Adding the properties of every edge, one at a time as the incremental store does
+static void BM_PropertyStore_put(benchmark::State &state, const std::string &graph) {
+    const EdgeList &edges = BenchmarkGraphs::get(graph);
+    std::string path = BenchmarkGraphs::options.scratchDir + "/bench_edge_properties";
+    uint64_t storeBytes = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        PropertyStore store;
+        store.open(path, true);
+        state.ResumeTiming();
+        for (auto &edge : edges) {
+            unsigned int reference = 0;
+            for (auto &property : edgeProperties(edge)) {
+                reference = store.put(reference, property.first, property.second);
+            }
+            benchmark::DoNotOptimize(reference);
+        }
+        state.PauseTiming();
+        storeBytes = store.getSizeInBytes();
+        store.close();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * edges.size() * PROPERTIES_PER_EDGE);
+    state.counters["bytes_per_property"] = static_cast<double>(storeBytes) / (edges.size() * PROPERTIES_PER_EDGE);
+    state.counters["legacy_bytes_per_property"] = LEGACY_BLOCK_SIZE;
+    remove((path + ".keys.db").c_str());
+    remove((path + ".runs.db").c_str());
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_PropertyStore_put);
+
+// Reading all properties of every edge
+static void BM_PropertyStore_getAll(benchmark::State &state, const std::string &graph) {
+    const EdgeList &edges = BenchmarkGraphs::get(graph);
+    std::string path = BenchmarkGraphs::options.scratchDir + "/bench_edge_properties";
+    PropertyStore store;
+    store.open(path, true);
+    std::vector<unsigned int> references;
+    for (auto &edge : edges) {
+        unsigned int reference = 0;
+        for (auto &property : edgeProperties(edge)) {
+            reference = store.put(reference, property.first, property.second);
+        }
+        references.push_back(reference);
+    }
+
+    for (auto _ : state) {
+        for (unsigned int reference : references) {
+            std::map<std::string, std::string> properties = store.getAll(reference);
+            benchmark::DoNotOptimize(properties);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * references.size());
+    store.close();
+    remove((path + ".keys.db").c_str());
+    remove((path + ".runs.db").c_str());
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_PropertyStore_getAll);
+
+// Moving the edge properties of a partition written in the linked property format to a property store
+static void BM_PropertyStore_migrate(benchmark::State &state, const std::string &graph) {
+    const EdgeList &edges = BenchmarkGraphs::get(graph);
+    std::string prefix = BenchmarkGraphs::options.scratchDir + "/bench_g1_p0";
+    uint64_t legacyBytes = 0;
+    uint64_t storeBytes = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::ofstream legacyFile(prefix + "_edge_properties.db", std::ios::binary);
+        std::ofstream relationsFile(prefix + "_relations.db", std::ios::binary);
+        char block[LEGACY_BLOCK_SIZE] = {0};
+        legacyFile.write(block, sizeof(block));
+        unsigned int address = LEGACY_BLOCK_SIZE;
+        unsigned int relation[13] = {0};
+        for (auto &edge : edges) {
+            relation[static_cast<int>(RelationOffsets::RELATION_PROPS)] = address;
+            relationsFile.write(reinterpret_cast<char *>(relation), sizeof(relation));
+            std::vector<std::pair<std::string, std::string>> properties = edgeProperties(edge);
+            for (size_t i = 0; i < properties.size(); i++) {
+                memset(block, 0, sizeof(block));
+                strncpy(block, properties[i].first.c_str(), 12);
+                strncpy(block + 12, properties[i].second.c_str(), 180);
+                address += LEGACY_BLOCK_SIZE;
+                unsigned int next = i + 1 < properties.size() ? address : 0;
+                memcpy(block + 192, &next, sizeof(next));
+                legacyFile.write(block, sizeof(block));
+            }
+        }
+        legacyFile.close();
+        relationsFile.close();
+        legacyBytes = address;
+        state.ResumeTiming();
+
+        PropertyStore::migrate(prefix);
+
+        state.PauseTiming();
+        PropertyStore store;
+        store.open(prefix + "_edge_properties", false);
+        storeBytes = store.getSizeInBytes();
+        store.close();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * edges.size() * PROPERTIES_PER_EDGE);
+    state.counters["legacy_bytes"] = legacyBytes;
+    state.counters["store_bytes"] = storeBytes;
+    for (auto suffix : {"_edge_properties.db.legacy", "_relations.db", "_properties.keys.db", "_properties.runs.db",
+                        "_edge_properties.keys.db", "_edge_properties.runs.db"}) {
+        remove((prefix + suffix).c_str());
+    }
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_PropertyStore_migrate);
@@ -0,0 +1,77 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/nativestore/StoreCompactor.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "../../../src/nativestore/NodeManager.h"
+#include "../../../src/util/Utils.h"
+#include "../BenchmarkGraphs.h"
+
+static const char *PARTITION_FILES[] = {"_nodes.db", "_nodes.index.db", "_relations.db", "_central_relations.db",
+                                        "_properties.keys.db", "_properties.runs.db", "_edge_properties.keys.db",
+                                        "_edge_properties.runs.db"};
+
+static void copyFiles(const std::string &fromPrefix, const std::string &toPrefix) {
+    for (auto suffix : PARTITION_FILES) {
+        std::ifstream from(fromPrefix + suffix, std::ios::binary);
+        std::ofstream to(toPrefix + suffix, std::ios::binary | std::ios::trunc);
+        to << from.rdbuf();
+    }
+}
+
+// Compacting the partition of the graph ingested in edge order, with the time to follow the relation chains of
+// every node before and after
+static void BM_StoreCompactor_compact(benchmark::State &state, const std::string &graph) {
+    GraphConfig graphConfig;
+    graphConfig.graphID = 900013;
+    graphConfig.partitionID = 0;
+    graphConfig.maxLabelSize = std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size"));
+    graphConfig.openMode = "trunc";
+    graphConfig.checkpointRecords = 0;
+
+    NodeManager *nodeManager = new NodeManager(graphConfig);
+    for (auto &edge : BenchmarkGraphs::get(graph)) {
+        nodeManager->addLocalEdge({std::to_string(edge.first), std::to_string(edge.second)});
+    }
+    std::string dbPrefix = nodeManager->getDbPrefix();
+    nodeManager->close();
+    delete nodeManager;
+    std::string ingestedPrefix = BenchmarkGraphs::options.scratchDir + "/compactor_ingested";
+    copyFiles(dbPrefix, ingestedPrefix);
+
+    StoreCompactor::Stats stats;
+    for (auto _ : state) {
+        state.PauseTiming();
+        copyFiles(ingestedPrefix, dbPrefix);
+        state.ResumeTiming();
+
+        if (!StoreCompactor::compact(dbPrefix, graphConfig.maxLabelSize, stats)) {
+            state.SkipWithError("Compaction failed");
+            break;
+        }
+    }
+    for (auto suffix : PARTITION_FILES) {
+        std::remove((ingestedPrefix + suffix).c_str());
+    }
+    state.SetItemsProcessed(state.iterations() * stats.relations);
+    state.counters["bytes_before"] = stats.bytesBefore;
+    state.counters["bytes_after"] = stats.bytesAfter;
+    state.counters["traversal_before_us"] = stats.traversalBefore;
+    state.counters["traversal_after_us"] = stats.traversalAfter;
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_StoreCompactor_compact);
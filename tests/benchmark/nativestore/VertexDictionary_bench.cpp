@@ -0,0 +1,112 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/nativestore/VertexDictionary.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "../BenchmarkGraphs.h"
+
+// External ids as a stream would carry them, one batch of two endpoints per edge
+static std::vector<std::vector<std::string>> makeBatches(const EdgeList &edges) {
+    std::vector<std::vector<std::string>> batches;
+    batches.reserve(edges.size());
+    for (auto &edge : edges) {
+        batches.push_back({"user_" + std::to_string(edge.first), "user_" + std::to_string(edge.second)});
+    }
+    return batches;
+}
+
+// Translating the endpoints of every streamed edge through the cache, as the stream handler does
+static void BM_VertexDictionary_getOrAssign(benchmark::State &state, const std::string &graph) {
+    std::vector<std::vector<std::string>> batches = makeBatches(BenchmarkGraphs::get(graph));
+    uint64_t vertexCount = 0;
+    size_t memoryBytes = 0;
+    double hitRate = 0;
+    for (auto _ : state) {
+        VertexDictionary dictionary;
+        VertexDictionaryCache cache(dictionary);
+        std::vector<uint64_t> ids;
+        for (auto &batch : batches) {
+            cache.getOrAssign(batch, ids);
+            benchmark::DoNotOptimize(ids.data());
+        }
+        state.PauseTiming();
+        vertexCount = dictionary.size();
+        memoryBytes = dictionary.getMemoryBytes();
+        hitRate = static_cast<double>(cache.getHitCount()) / (cache.getHitCount() + cache.getMissCount());
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * batches.size() * 2);
+    state.counters["memory_bytes_per_vertex"] = static_cast<double>(memoryBytes) / vertexCount;
+    state.counters["cache_hit_rate"] = hitRate;
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_VertexDictionary_getOrAssign);
+
+// Translating every vertex of the graph in batches of 1024 once the dictionary is built
+static void BM_VertexDictionary_lookup(benchmark::State &state, const std::string &graph) {
+    std::vector<std::vector<std::string>> batches = makeBatches(BenchmarkGraphs::get(graph));
+    VertexDictionary dictionary;
+    std::vector<uint64_t> ids;
+    std::vector<std::string> externalIds;
+    for (auto &batch : batches) {
+        dictionary.getOrAssign(batch, ids);
+    }
+    for (uint64_t id = 0; id < dictionary.size(); id++) {
+        externalIds.push_back(dictionary.getExternalId(id));
+    }
+
+    const size_t batchSize = 1024;
+    for (auto _ : state) {
+        for (size_t begin = 0; begin < externalIds.size(); begin += batchSize) {
+            std::vector<std::string> batch(externalIds.begin() + begin,
+                                           externalIds.begin() + std::min(begin + batchSize, externalIds.size()));
+            dictionary.lookup(batch, ids);
+            benchmark::DoNotOptimize(ids.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * externalIds.size());
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_VertexDictionary_lookup);
+
+// The string keyed index of the native store node manager, for comparison
+static void BM_StringIndex_insert(benchmark::State &state, const std::string &graph) {
+    std::vector<std::vector<std::string>> batches = makeBatches(BenchmarkGraphs::get(graph));
+    size_t vertexCount = 0;
+    size_t memoryBytes = 0;
+    for (auto _ : state) {
+        std::unordered_map<std::string, unsigned int> index;
+        for (auto &batch : batches) {
+            for (auto &externalId : batch) {
+                benchmark::DoNotOptimize(index.emplace(externalId, index.size()));
+            }
+        }
+        state.PauseTiming();
+        vertexCount = index.size();
+        // A node of the key, the value and the cached hash with its next pointer, and a bucket pointer
+        memoryBytes = index.size() * (sizeof(std::string) + 3 * sizeof(void *)) +
+                      index.bucket_count() * sizeof(void *);
+        for (auto &entry : index) {
+            if (entry.first.capacity() > 15) {
+                memoryBytes += entry.first.capacity() + 1;
+            }
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * batches.size() * 2);
+    state.counters["memory_bytes_per_vertex"] = static_cast<double>(memoryBytes) / vertexCount;
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_StringIndex_insert);
@@ -0,0 +1,120 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/nativestore/WriteAheadLog.h"
+
+#include <benchmark/benchmark.h>
+
+#include "../../../src/nativestore/NodeManager.h"
+#include "../../../src/util/Utils.h"
+#include "../BenchmarkGraphs.h"
+
+static std::vector<std::pair<std::string, std::string>> labelEdges(const EdgeList &edges) {
+    std::vector<std::pair<std::string, std::string>> labelledEdges;
+    labelledEdges.reserve(edges.size());
+    for (auto &edge : edges) {
+        labelledEdges.push_back(std::make_pair(std::to_string(edge.first), std::to_string(edge.second)));
+    }
+    return labelledEdges;
+}
+
+static GraphConfig walGraphConfig(long checkpointRecords) {
+    GraphConfig graphConfig;
+    graphConfig.graphID = 900011;
+    graphConfig.partitionID = 0;
+    graphConfig.maxLabelSize = std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size"));
+    graphConfig.openMode = "trunc";
+    graphConfig.checkpointRecords = checkpointRecords;
+    return graphConfig;
+}
+
+// The same ingestion as BM_NodeManager_addLocalEdge with every edge logged and a checkpoint every 100 K edges
+static void BM_WriteAheadLog_addLocalEdge(benchmark::State &state, const std::string &graph) {
+    std::vector<std::pair<std::string, std::string>> labelledEdges = labelEdges(BenchmarkGraphs::get(graph));
+    GraphConfig graphConfig = walGraphConfig(100000);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        NodeManager *nodeManager = new NodeManager(graphConfig);
+        state.ResumeTiming();
+
+        for (auto &edge : labelledEdges) {
+            benchmark::DoNotOptimize(nodeManager->addLocalEdge(edge));
+        }
+
+        state.PauseTiming();
+        nodeManager->close();
+        delete nodeManager;
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * labelledEdges.size());
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_WriteAheadLog_addLocalEdge);
+
+static const char *PARTITION_FILES[] = {"_nodes.db", "_nodes.index.db", "_relations.db", "_central_relations.db",
+                                        "_properties.keys.db", "_properties.runs.db", "_edge_properties.keys.db",
+                                        "_edge_properties.runs.db", "_wal.db"};
+
+static void copyFiles(const std::string &fromPrefix, const std::string &toPrefix) {
+    for (auto suffix : PARTITION_FILES) {
+        std::ifstream from(fromPrefix + suffix, std::ios::binary);
+        std::ofstream to(toPrefix + suffix, std::ios::binary | std::ios::trunc);
+        to << from.rdbuf();
+    }
+}
+
+// Opening a partition that crashed after all edges were added, which redoes the edges since the last checkpoint
+static void recover(benchmark::State &state, const std::string &graph, long checkpointRecords) {
+    std::vector<std::pair<std::string, std::string>> labelledEdges = labelEdges(BenchmarkGraphs::get(graph));
+    GraphConfig graphConfig = walGraphConfig(checkpointRecords);
+
+    NodeManager *nodeManager = new NodeManager(graphConfig);
+    for (auto &edge : labelledEdges) {
+        nodeManager->addLocalEdge(edge);
+    }
+    std::string dbPrefix = nodeManager->getDbPrefix();
+    std::string crashedPrefix = BenchmarkGraphs::options.scratchDir + "/wal_crashed";
+    delete nodeManager;  // without closing the store
+    copyFiles(dbPrefix, crashedPrefix);
+    graphConfig.openMode = "app";
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        copyFiles(crashedPrefix, dbPrefix);
+        // The crashed store had no edge filters written, so they are rebuilt as well
+        std::remove((dbPrefix + "_relations.filter.db").c_str());
+        std::remove((dbPrefix + "_central_relations.filter.db").c_str());
+        state.ResumeTiming();
+
+        nodeManager = new NodeManager(graphConfig);
+
+        state.PauseTiming();
+        nodeManager->close();
+        delete nodeManager;
+        state.ResumeTiming();
+    }
+    for (auto suffix : PARTITION_FILES) {
+        std::remove((crashedPrefix + suffix).c_str());
+    }
+    state.counters["redo_records"] = labelledEdges.size() % checkpointRecords;
+}
+
+static void BM_WriteAheadLog_recover10K(benchmark::State &state, const std::string &graph) {
+    recover(state, graph, 10000);
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_WriteAheadLog_recover10K);
+
+static void BM_WriteAheadLog_recover100K(benchmark::State &state, const std::string &graph) {
+    recover(state, graph, 100000);
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_WriteAheadLog_recover100K);
@@ -0,0 +1,74 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/partitioner/local/JSONParser.h"
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <map>
+#include <random>
+#include <thread>
+
+#include "../../../src/util/Utils.h"
+#include "../BenchmarkGraphs.h"
+
+// A citation dump in the JSON lines format of the Open Academic Graph, a paper per vertex citing its neighbours
+static std::string writeCitationFile(const std::string &graph) {
+    std::string path = BenchmarkGraphs::options.scratchDir + "/" + graph + "_papers.json";
+    std::map<long, std::vector<long>> references;
+    for (auto &edge : BenchmarkGraphs::get(graph)) {
+        references[edge.first].push_back(edge.second);
+    }
+    std::mt19937_64 random(BenchmarkGraphs::options.seed);
+    std::ofstream output(path);
+    for (auto &paper : references) {
+        output << "{\"id\": \"" << paper.first << "\", \"title\": \"Paper " << paper.first
+               << "\", \"authors\": [{\"name\": \"Author " << random() % 1000 << "\", \"org\": \"University\"}], "
+               << "\"references\": [";
+        for (size_t i = 0; i < paper.second.size(); i++) {
+            output << (i == 0 ? "\"" : ", \"") << paper.second[i] << "\"";
+        }
+        // Skewed fields of study so that the first few are frequent enough to become attributes
+        output << "], \"fos\": [";
+        for (int i = 0; i < 4; i++) {
+            output << (i == 0 ? "" : ", ") << "{\"name\": \"Field " << random() % 8 * (random() % 8 + 1)
+                   << "\", \"w\": 0." << random() % 10 << "}";
+        }
+        output << "]}\n";
+    }
+    return path;
+}
+
+static void BM_JSONParser_jsonParse(benchmark::State &state, const std::string &graph) {
+    std::string inputPath = writeCitationFile(graph);
+    std::string outputPath = BenchmarkGraphs::options.scratchDir + "/" + graph + "_json";
+    Utils::createDirectory(outputPath);
+    JSONParseStats stats;
+    JSONParseStats total;
+    for (auto _ : state) {
+        stats = JSONParser::jsonParse(inputPath, outputPath, std::max(1u, std::thread::hardware_concurrency()));
+        total.parseSeconds += stats.parseSeconds;
+        total.remapSeconds += stats.remapSeconds;
+        total.attributeSeconds += stats.attributeSeconds;
+    }
+    long iterations = state.iterations();
+    state.SetItemsProcessed(iterations * stats.lineCount);
+    state.SetBytesProcessed(iterations * stats.byteCount);
+    // Throughput of each stage on its own, the parse stage per thread
+    state.counters["parse_bytes_per_second"] = iterations * stats.byteCount / total.parseSeconds;
+    state.counters["remap_edges_per_second"] = iterations * stats.edgeCount / total.remapSeconds;
+    state.counters["attribute_rows_per_second"] = iterations * stats.vertexCount / total.attributeSeconds;
+    state.counters["fields"] = stats.fieldCount;
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_JSONParser_jsonParse);
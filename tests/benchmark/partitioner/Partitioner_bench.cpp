@@ -0,0 +1,162 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <thread>
+
+#include "../../../src/partitioner/local/MetisPartitioner.h"
+#include "../../../src/partitioner/local/MultilevelPartitioner.h"
+#include "../../../src/partitioner/stream/Partitioner.h"
+#include "../../../src/util/Utils.h"
+#include "../BenchmarkGraphs.h"
+
+// Parsing an edge list file into the adjacency maps that are later written out in the METIS format
+static void BM_MetisPartitioner_loadDataSet(benchmark::State &state, const std::string &graph) {
+    std::string edgeListFile = BenchmarkGraphs::edgeListFile(graph);
+    size_t edgeCount = BenchmarkGraphs::get(graph).size();
+
+    for (auto _ : state) {
+        MetisPartitioner partitioner(NULL);
+        partitioner.loadDataSet(edgeListFile, 900004);
+    }
+    state.SetItemsProcessed(state.iterations() * edgeCount);
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_MetisPartitioner_loadDataSet);
+
+static const int METIS_PARTITION_COUNT = 4;
+
+// Undirected CSR of a graph with vertices 0 to the largest vertex id, as the partitioners take it
+static void buildCSR(const EdgeList &edges, std::vector<int> &xadj, std::vector<int> &adjncy) {
+    long largestVertex = 0;
+    for (auto &edge : edges) {
+        largestVertex = std::max(largestVertex, std::max(edge.first, edge.second));
+    }
+    std::vector<std::set<int>> adjacency(largestVertex + 1);
+    for (auto &edge : edges) {
+        if (edge.first != edge.second) {
+            adjacency[edge.first].insert(edge.second);
+            adjacency[edge.second].insert(edge.first);
+        }
+    }
+    xadj.assign(1, 0);
+    adjncy.clear();
+    for (auto &neighbours : adjacency) {
+        adjncy.insert(adjncy.end(), neighbours.begin(), neighbours.end());
+        xadj.push_back(adjncy.size());
+    }
+}
+
+static void reportPartitionQuality(benchmark::State &state, const std::vector<int> &xadj,
+                                   const std::vector<int> &adjncy, const std::vector<int> &parts) {
+    long edgeCut = MultilevelPartitioner::getEdgeCut(xadj, adjncy, parts);
+    state.counters["edge_cut"] = edgeCut;
+    state.counters["edge_cut_fraction"] = adjncy.empty() ? 0.0 : 2.0 * edgeCut / adjncy.size();
+    state.counters["imbalance"] = MultilevelPartitioner::getImbalance(parts, METIS_PARTITION_COUNT);
+}
+
+// Multilevel partitioning in process, which replaced writing the graph file and running gpmetis
+static void BM_MultilevelPartitioner_partition(benchmark::State &state, const std::string &graph) {
+    std::vector<int> xadj;
+    std::vector<int> adjncy;
+    buildCSR(BenchmarkGraphs::get(graph), xadj, adjncy);
+
+    std::vector<int> parts;
+    for (auto _ : state) {
+        MultilevelPartitioner partitioner(METIS_PARTITION_COUNT, MultilevelPartitioner::DEFAULT_IMBALANCE,
+                                          std::max(1u, std::thread::hardware_concurrency()));
+        parts = partitioner.partition(xadj, adjncy);
+    }
+    state.SetItemsProcessed(state.iterations() * adjncy.size() / 2);
+    reportPartitionQuality(state, xadj, adjncy, parts);
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_MultilevelPartitioner_partition);
+
+// The gpmetis path: writing the METIS graph file, running gpmetis and reading its partition file
+static void BM_Gpmetis_partition(benchmark::State &state, const std::string &graph) {
+    std::string gpmetis = Utils::getJasmineGraphProperty("org.jasminegraph.partitioner.metis.bin") + "/gpmetis";
+    if (!Utils::fileExists(gpmetis)) {
+        state.SkipWithError(("gpmetis is not installed at " + gpmetis).c_str());
+        return;
+    }
+    std::vector<int> xadj;
+    std::vector<int> adjncy;
+    buildCSR(BenchmarkGraphs::get(graph), xadj, adjncy);
+    std::string graphFile = BenchmarkGraphs::options.scratchDir + "/" + graph + ".grf";
+    std::string command =
+        gpmetis + " " + graphFile + " " + std::to_string(METIS_PARTITION_COUNT) + " > /dev/null 2>&1";
+
+    std::vector<int> parts;
+    for (auto _ : state) {
+        std::ofstream graphOutput(graphFile);
+        graphOutput << xadj.size() - 1 << ' ' << adjncy.size() / 2 << '\n';
+        for (size_t v = 0; v + 1 < xadj.size(); v++) {
+            for (int e = xadj[v]; e < xadj[v + 1]; e++) {
+                graphOutput << adjncy[e] + 1 << ' ';
+            }
+            graphOutput << '\n';
+        }
+        graphOutput.close();
+
+        if (system(command.c_str()) != 0) {
+            state.SkipWithError("gpmetis failed");
+            break;
+        }
+        parts.clear();
+        std::ifstream partOutput(graphFile + ".part." + std::to_string(METIS_PARTITION_COUNT));
+        int part;
+        while (partOutput >> part) {
+            parts.push_back(part);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * adjncy.size() / 2);
+    if (parts.size() + 1 == xadj.size()) {
+        reportPartitionQuality(state, xadj, adjncy, parts);
+    }
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_Gpmetis_partition);
+
+static void streamingPartitioning(benchmark::State &state, const std::string &graph, spt::Algorithms algorithm) {
+    const EdgeList &edges = BenchmarkGraphs::get(graph);
+    std::vector<std::pair<std::string, std::string>> labelledEdges;
+    labelledEdges.reserve(edges.size());
+    for (auto &edge : edges) {
+        labelledEdges.push_back(std::make_pair(std::to_string(edge.first), std::to_string(edge.second)));
+    }
+
+    for (auto _ : state) {
+        Partitioner partitioner(4, 900005, algorithm);
+        for (auto &edge : labelledEdges) {
+            benchmark::DoNotOptimize(partitioner.addEdge(edge));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * labelledEdges.size());
+}
+
+static void BM_Partitioner_hash(benchmark::State &state, const std::string &graph) {
+    streamingPartitioning(state, graph, spt::HASH);
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_Partitioner_hash);
+
+static void BM_Partitioner_fennel(benchmark::State &state, const std::string &graph) {
+    streamingPartitioning(state, graph, spt::FENNEL);
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_Partitioner_fennel);
+
+static void BM_Partitioner_ldg(benchmark::State &state, const std::string &graph) {
+    streamingPartitioning(state, graph, spt::LDG);
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_Partitioner_ldg);
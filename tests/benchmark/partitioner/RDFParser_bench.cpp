@@ -0,0 +1,95 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+
+#include "../../../src/partitioner/local/RDFParser.h"
+#include "../../../src/partitioner/local/RDFStreamReader.h"
+#include "../../../src/util/Utils.h"
+#include "../BenchmarkGraphs.h"
+
+static const char *PREDICATES[] = {"knows", "cites", "follows", "likes"};
+
+// Every edge of the graph as a statement between two resources, and a name literal per source vertex
+static std::string writeNTriplesFile(const std::string &graph) {
+    std::string path = BenchmarkGraphs::options.scratchDir + "/" + graph + ".nt";
+    std::ofstream output(path);
+    long index = 0;
+    for (auto &edge : BenchmarkGraphs::get(graph)) {
+        output << "<http://example.org/vertex/" << edge.first << "> <http://example.org/" << PREDICATES[index++ % 4]
+               << "> <http://example.org/vertex/" << edge.second << "> .\n";
+        if (index % 8 == 0) {
+            output << "<http://example.org/vertex/" << edge.first << "> <http://example.org/name> \"Vertex "
+                   << edge.first << "\"@en .\n";
+        }
+    }
+    return path;
+}
+
+static void BM_RDFStreamReader_readNTriples(benchmark::State &state, const std::string &graph) {
+    std::string inputPath = writeNTriplesFile(graph);
+    std::string edgePath = BenchmarkGraphs::options.scratchDir + "/" + graph + "_nt_edges";
+    long statementCount = 0;
+    size_t dictionaryBytes = 0;
+    for (auto _ : state) {
+        RDFEdgeWriter writer(edgePath, "");
+        RDFStreamReader reader(writer);
+        statementCount = reader.readNTriples(inputPath);
+        dictionaryBytes = reader.getVertices().getMemoryBytes() + reader.getPredicates().getMemoryBytes();
+    }
+    state.SetItemsProcessed(state.iterations() * statementCount);
+    state.SetBytesProcessed(state.iterations() * Utils::getFileSize(inputPath));
+    state.counters["file_bytes"] = Utils::getFileSize(inputPath);
+    // The only state that grows with the input
+    state.counters["memory_bytes"] = dictionaryBytes;
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_RDFStreamReader_readNTriples);
+
+// An AKT bibliographic dump with an article reference of two authors per edge
+static std::string writeRDFXMLFile(const std::string &graph) {
+    std::string path = BenchmarkGraphs::options.scratchDir + "/" + graph + ".rdf";
+    std::ofstream output(path);
+    output << "<?xml version=\"1.0\"?>\n<rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\" "
+              "xmlns:akt=\"http://www.aktors.org/ontology/portal#\" "
+              "xmlns:akts=\"http://www.aktors.org/ontology/support#\">\n";
+    long index = 0;
+    for (auto &edge : BenchmarkGraphs::get(graph)) {
+        output << "<akt:Article-Reference rdf:about=\"http://example.org/article/" << index << "\">\n"
+               << "<akt:has-title>Article " << index << "</akt:has-title>\n";
+        for (long author : {edge.first, edge.second}) {
+            output << "<akt:has-author><akt:Person><akt:full-name>Author " << author
+                   << "</akt:full-name></akt:Person></akt:has-author>\n";
+        }
+        output << "<akt:has-date><akts:Calendar-Date><akts:year-of>" << 1990 + index % 30
+               << "</akts:year-of></akts:Calendar-Date></akt:has-date>\n</akt:Article-Reference>\n";
+        index++;
+    }
+    output << "</rdf:RDF>\n";
+    return path;
+}
+
+static void BM_GetConfig_readConfigFile(benchmark::State &state, const std::string &graph) {
+    std::string inputPath = writeRDFXMLFile(graph);
+    const int graphId = 900005;
+    for (auto _ : state) {
+        GetConfig reader;
+        reader.readConfigFile(inputPath, graphId);
+    }
+    state.SetItemsProcessed(state.iterations() * BenchmarkGraphs::get(graph).size());
+    state.SetBytesProcessed(state.iterations() * Utils::getFileSize(inputPath));
+    state.counters["file_bytes"] = Utils::getFileSize(inputPath);
+    Utils::deleteDirectory(Utils::getHomeDir() + "/.jasminegraph/tmp/" + std::to_string(graphId));
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_GetConfig_readConfigFile);
@@ -0,0 +1,141 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/query/algorithms/traversal/FrontierBFS.h"
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+#include <thread>
+#include <unordered_set>
+
+#include "../../../src/nativestore/NodeManager.h"
+#include "../../../src/util/Utils.h"
+#include "../BenchmarkGraphs.h"
+
+static GraphConfig searchGraphConfig(unsigned int partitionID, const std::string &openMode) {
+    GraphConfig graphConfig;
+    graphConfig.graphID = 900015;
+    graphConfig.partitionID = partitionID;
+    graphConfig.maxLabelSize = std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size"));
+    graphConfig.openMode = openMode;
+    graphConfig.checkpointRecords = 0;
+    return graphConfig;
+}
+
+// Every input graph is ingested once into a partition of its own, which the search benchmarks share
+static unsigned int ingest(const std::string &graph) {
+    static std::map<std::string, unsigned int> partitions;
+    auto partition = partitions.find(graph);
+    if (partition != partitions.end()) {
+        return partition->second;
+    }
+    unsigned int partitionID = partitions.size();
+    NodeManager nodeManager(searchGraphConfig(partitionID, "trunc"));
+    for (auto &edge : BenchmarkGraphs::get(graph)) {
+        nodeManager.addLocalEdge({std::to_string(edge.first), std::to_string(edge.second)});
+    }
+    nodeManager.close();
+    partitions[graph] = partitionID;
+    return partitionID;
+}
+
+static std::string getDbPrefix(unsigned int partitionID) {
+    return Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder") + "/g900015_p" +
+           std::to_string(partitionID);
+}
+
+static void BM_FrontierBFS_load(benchmark::State &state, const std::string &graph) {
+    std::string dbPrefix = getDbPrefix(ingest(graph));
+    unsigned long indexKeySize = searchGraphConfig(0, "app").maxLabelSize;
+    for (auto _ : state) {
+        FrontierBFS search;
+        benchmark::DoNotOptimize(search.load(dbPrefix, indexKeySize, false));
+    }
+    state.SetItemsProcessed(state.iterations() * BenchmarkGraphs::get(graph).size());
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_FrontierBFS_load);
+
+// Undirected search of every level from the source of the first edge
+static void search(benchmark::State &state, const std::string &graph, int threadCount, bool directionOptimizing) {
+    FrontierBFS search;
+    search.load(getDbPrefix(ingest(graph)), searchGraphConfig(0, "app").maxLabelSize, false);
+    search.setDirectionOptimizing(directionOptimizing);
+    std::vector<std::string> source = {std::to_string(BenchmarkGraphs::get(graph).front().first)};
+
+    uint64_t reached = 0;
+    int levels = 0;
+    int bottomUpLevels = 0;
+    for (auto _ : state) {
+        search.reset();
+        reached = search.addToFrontier(source);
+        levels = 0;
+        bottomUpLevels = 0;
+        std::vector<std::string> boundary;
+        for (FrontierBFS::LevelStats stats = search.expand(threadCount, boundary); stats.reached > 0;
+             stats = search.expand(threadCount, boundary)) {
+            reached += stats.reached;
+            levels++;
+            bottomUpLevels += stats.bottomUp ? 1 : 0;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * search.getEdgeCount());
+    state.counters["reached"] = reached;
+    state.counters["levels"] = levels;
+    state.counters["bottom_up_levels"] = bottomUpLevels;
+}
+
+static void BM_FrontierBFS_topDown(benchmark::State &state, const std::string &graph) {
+    search(state, graph, 1, false);
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_FrontierBFS_topDown);
+
+static void BM_FrontierBFS_directionOptimizing(benchmark::State &state, const std::string &graph) {
+    search(state, graph, 1, true);
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_FrontierBFS_directionOptimizing);
+
+static void BM_FrontierBFS_parallel(benchmark::State &state, const std::string &graph) {
+    search(state, graph, std::max(1u, std::thread::hardware_concurrency()), true);
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_FrontierBFS_parallel);
+
+// The same search through the node blocks of the store, reading a block per neighbour
+static void BM_FrontierBFS_nodeBlocks(benchmark::State &state, const std::string &graph) {
+    NodeManager nodeManager(searchGraphConfig(ingest(graph), "app"));
+    std::string source = std::to_string(BenchmarkGraphs::get(graph).front().first);
+
+    uint64_t reached = 0;
+    for (auto _ : state) {
+        std::unordered_set<std::string> visited = {source};
+        std::vector<std::string> frontier = {source};
+        while (!frontier.empty()) {
+            std::vector<std::string> next;
+            for (auto &id : frontier) {
+                std::unique_ptr<NodeBlock> node(nodeManager.get(id));
+                for (NodeBlock *neighbor : node->getLocalEdgeNodes()) {
+                    if (visited.insert(neighbor->id).second) {
+                        next.push_back(neighbor->id);
+                    }
+                    delete neighbor;
+                }
+            }
+            frontier.swap(next);
+        }
+        reached = visited.size();
+    }
+    nodeManager.close();
+    state.counters["reached"] = reached;
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_FrontierBFS_nodeBlocks);
@@ -0,0 +1,94 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+#include "../../../src/query/algorithms/triangles/TriangleSet.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Replies of aggregators of a graph with a heavy edge cut, which report the same cross partition triangles many
+// times: half of every reply is shared with the other aggregators
+static std::vector<std::string> heavyEdgeCutResponses(int aggregators, int trianglesPerAggregator) {
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<long> vertex(0, 200000);
+
+    std::vector<long> shared;
+    for (int i = 0; i < trianglesPerAggregator * 3; i++) {
+        shared.push_back(vertex(random));
+    }
+
+    std::vector<std::string> responses;
+    for (int a = 0; a < aggregators; a++) {
+        std::stringstream response;
+        for (int i = 0; i < trianglesPerAggregator; i++) {
+            long v[3];
+            if (i % 2 == 0) {
+                v[0] = shared[3 * i];
+                v[1] = shared[3 * i + 1];
+                v[2] = shared[3 * i + 2];
+            } else {
+                v[0] = vertex(random);
+                v[1] = vertex(random);
+                v[2] = vertex(random);
+            }
+            std::sort(v, v + 3);
+            response << v[0] << "," << v[1] << "," << v[2] << ":";
+        }
+        std::string triangles = response.str();
+        triangles.erase(triangles.size() - 1);
+        responses.push_back(triangles);
+    }
+    return responses;
+}
+
+static void BM_TriangleSet_insertAll(benchmark::State &state) {
+    std::vector<std::string> responses = heavyEdgeCutResponses(8, 50000);
+    size_t triangles = 0;
+    for (auto _ : state) {
+        TriangleSet packedTriangles;
+        for (auto &response : responses) {
+            packedTriangles.insertAll(response);
+        }
+        triangles = packedTriangles.size();
+        benchmark::DoNotOptimize(triangles);
+    }
+    state.SetItemsProcessed(state.iterations() * responses.size() * 50000);
+    state.counters["triangles"] = triangles;
+}
+BENCHMARK(BM_TriangleSet_insertAll)->Unit(benchmark::kMillisecond);
+
+// The string based deduplication the packed set replaced, for comparison
+static void BM_TriangleSet_strings(benchmark::State &state) {
+    std::vector<std::string> responses = heavyEdgeCutResponses(8, 50000);
+    size_t triangles = 0;
+    for (auto _ : state) {
+        std::set<std::string> stringTriangles;
+        for (auto &response : responses) {
+            std::stringstream stream(response);
+            std::string triangle;
+            while (std::getline(stream, triangle, ':')) {
+                stringTriangles.insert(triangle);
+            }
+        }
+        triangles = stringTriangles.size();
+        benchmark::DoNotOptimize(triangles);
+    }
+    state.SetItemsProcessed(state.iterations() * responses.size() * 50000);
+    state.counters["triangles"] = triangles;
+}
+BENCHMARK(BM_TriangleSet_strings)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,71 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/query/algorithms/triangles/Triangles.h"
+
+#include <benchmark/benchmark.h>
+
+#include "../../../src/nativestore/NodeManager.h"
+#include "../../../src/query/algorithms/triangles/StreamingTriangles.h"
+#include "../../../src/util/Utils.h"
+#include "../BenchmarkGraphs.h"
+
+// Adjacency list and out degree distribution in the layout of the local store
+static void toLocalStore(const EdgeList &edges, map<long, unordered_set<long>> &adjacencyList,
+                         map<long, long> &distributionMap) {
+    for (auto &edge : edges) {
+        if (adjacencyList[edge.first].insert(edge.second).second) {
+            distributionMap[edge.first]++;
+        }
+        adjacencyList[edge.second];
+    }
+}
+
+static void BM_Triangles_countTriangles(benchmark::State &state, const std::string &graph) {
+    const EdgeList &edges = BenchmarkGraphs::get(graph);
+    map<long, unordered_set<long>> adjacencyList;
+    map<long, long> distributionMap;
+    toLocalStore(edges, adjacencyList, distributionMap);
+
+    long triangles = 0;
+    for (auto _ : state) {
+        triangles = Triangles::countTriangles(adjacencyList, distributionMap, false).count;
+        benchmark::DoNotOptimize(triangles);
+    }
+    state.SetItemsProcessed(state.iterations() * edges.size());
+    state.counters["triangles"] = triangles;
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_Triangles_countTriangles);
+
+static void BM_StreamingTriangles_countTriangles(benchmark::State &state, const std::string &graph) {
+    const EdgeList &edges = BenchmarkGraphs::get(graph);
+    GraphConfig graphConfig;
+    graphConfig.graphID = 900001;
+    graphConfig.partitionID = 0;
+    graphConfig.maxLabelSize = std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size"));
+    graphConfig.openMode = "trunc";
+    NodeManager nodeManager(graphConfig);
+    for (auto &edge : edges) {
+        nodeManager.addLocalEdge(std::make_pair(std::to_string(edge.first), std::to_string(edge.second)));
+    }
+
+    long triangles = 0;
+    for (auto _ : state) {
+        triangles = StreamingTriangles::countTriangles(&nodeManager, false).count;
+        benchmark::DoNotOptimize(triangles);
+    }
+    nodeManager.close();
+    state.SetItemsProcessed(state.iterations() * edges.size());
+    state.counters["triangles"] = triangles;
+}
+JASMINEGRAPH_GRAPH_BENCHMARK(BM_StreamingTriangles_countTriangles);
@@ -0,0 +1,77 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+#include "../../../src/server/JasmineGraphInstanceFileTransferService.h"
+#include "../../../src/server/JasmineGraphServer.h"
+#include "../../../src/util/Utils.h"
+#include "../BenchmarkGraphs.h"
+
+static const int FILE_TRANSFER_PORT = 17791;
+
+// File transfer service of a worker, listening on the loopback interface for the lifetime of the benchmark process
+static void startFileTransferService() {
+    static bool started = false;
+    if (!started) {
+        std::thread([]() {
+            JasmineGraphInstanceFileTransferService service;
+            service.run(FILE_TRANSFER_PORT);
+        }).detach();
+        usleep(100000);
+        started = true;
+    }
+}
+
+// Partition and central store files are shipped to the workers through the file transfer service
+static void BM_FileTransfer_sendFile(benchmark::State &state) {
+    startFileTransferService();
+    long fileSize = state.range(0);
+    std::string fileName = "jasminegraph_bench_" + std::to_string(fileSize);
+    std::string filePath = BenchmarkGraphs::options.scratchDir + "/" + fileName;
+    std::string receivedPath =
+        Utils::getJasmineGraphProperty("org.jasminegraph.server.instance.datafolder") + "/" + fileName;
+    {
+        std::ofstream file(filePath, std::ios::binary);
+        std::string block(1 << 20, 'j');
+        for (long written = 0; written < fileSize; written += block.size()) {
+            file.write(block.data(), std::min<long>(block.size(), fileSize - written));
+        }
+    }
+
+    for (auto _ : state) {
+        unlink(receivedPath.c_str());
+        if (!JasmineGraphServer::sendFileThroughService("localhost", FILE_TRANSFER_PORT, fileName, filePath, "")) {
+            state.SkipWithError("Cannot send the file");
+            break;
+        }
+        // The sender returns once the data is in the socket buffers, so wait until the receiver wrote all of it
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+        while (Utils::getFileSize(receivedPath) < fileSize && std::chrono::steady_clock::now() < deadline) {
+            usleep(100);
+        }
+        if (Utils::getFileSize(receivedPath) < fileSize) {
+            state.SkipWithError("The file was not received in time");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * fileSize);
+    unlink(receivedPath.c_str());
+    unlink(filePath.c_str());
+}
+BENCHMARK(BM_FileTransfer_sendFile)->RangeMultiplier(8)->Range(1 << 20, 64 << 20)->Unit(benchmark::kMillisecond);
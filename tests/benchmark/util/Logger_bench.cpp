@@ -0,0 +1,90 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+#include "../../../src/util/logger/Logger.h"
+
+#include <benchmark/benchmark.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/spdlog.h>
+
+#include <memory>
+#include <vector>
+
+#include "../BenchmarkGraphs.h"
+
+static Logger bench_logger;
+
+// Sends the log to a scratch file instead of the console and the daily log file while a benchmark runs, at the
+// default info level instead of the warn level of the benchmark runner
+class ScratchLogFile {
+ public:
+    ScratchLogFile() : runnerLevel(Logger::getLevel()) {
+        Logger::setLevel(LOG_INFO);
+        std::vector<spdlog::sink_ptr> &sinks = spdlog::get("JasmineGraph")->sinks();
+        dailySinks = sinks;
+        sinks.assign(1, std::make_shared<spdlog::sinks::basic_file_sink_mt>(
+                            BenchmarkGraphs::options.scratchDir + "/jasminegraph_bench_logger.log", true));
+        consoleSinks.swap(spdlog::get("logger")->sinks());
+        // The first message configures the loggers
+        bench_logger.info("Logger benchmark started");
+    }
+
+    ~ScratchLogFile() {
+        Logger::flush();
+        spdlog::get("JasmineGraph")->sinks() = dailySinks;
+        consoleSinks.swap(spdlog::get("logger")->sinks());
+        Logger::setLevel(runnerLevel);
+    }
+
+ private:
+    LogLevel runnerLevel;
+    std::vector<spdlog::sink_ptr> dailySinks;
+    std::vector<spdlog::sink_ptr> consoleSinks;
+};
+
+// Per edge logging cost of a streaming ingest loop that logs every edge it stores at a disabled debug level
+static void BM_Logger_filteredDebug(benchmark::State &state) {
+    ScratchLogFile logFile;
+    long edge = 0;
+    for (auto _ : state) {
+        bench_logger.debug("Storing edge {} -> {}", edge, edge + 1);
+        edge++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Logger_filteredDebug);
+
+// The same loop logging at info level, written to the file by the calling thread
+static void BM_Logger_synchronous(benchmark::State &state) {
+    ScratchLogFile logFile;
+    long edge = 0;
+    for (auto _ : state) {
+        bench_logger.info("Storing edge {} -> {}", edge, edge + 1);
+        edge++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Logger_synchronous);
+
+// The same loop with the messages handed to the background writer
+static void BM_Logger_async(benchmark::State &state) {
+    ScratchLogFile logFile;
+    Logger::setAsync(true);
+    long edge = 0;
+    for (auto _ : state) {
+        bench_logger.info("Storing edge {} -> {}", edge, edge + 1);
+        edge++;
+    }
+    Logger::setAsync(false);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Logger_async);
@@ -0,0 +1,61 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/frontend/core/scheduler/AdmissionController.h"
+
+#include "gtest/gtest.h"
+
+static AdmissionController::PendingJob makeJob(std::string jobId, long submitTime, long sla, long estimatedTime) {
+    AdmissionController::PendingJob job;
+    job.jobId = jobId;
+    job.submitTime = submitTime;
+    job.sla = sla;
+    job.estimatedTime = estimatedTime;
+    return job;
+}
+
+TEST(AdmissionControllerTest, TestDelaysAndRejectsWhenSlotsAreBusy) {
+    AdmissionController controller(1);
+    auto admissions = controller.admit({makeJob("1", 1000, 0, 1000)}, 1000);
+    ASSERT_EQ(admissions[0].decision, AdmissionController::ADMIT);
+
+    // A job with a lot of slack waits for the running job, a tight one cannot
+    admissions = controller.admit({makeJob("2", 1500, 10000, 1000), makeJob("3", 1500, 1000, 1000)}, 1500);
+    ASSERT_EQ(admissions.size(), 2);
+    ASSERT_EQ(admissions[0].jobId, "3");
+    ASSERT_EQ(admissions[0].decision, AdmissionController::REJECT);
+    ASSERT_EQ(admissions[1].jobId, "2");
+    ASSERT_EQ(admissions[1].decision, AdmissionController::DELAY);
+    ASSERT_EQ(admissions[1].delay, 500);
+    ASSERT_EQ(controller.getReservationCount(), 2);
+
+    controller.jobFinished("1");
+    controller.jobFinished("2");
+    admissions = controller.admit({makeJob("4", 1600, 1000, 1000)}, 1600);
+    ASSERT_EQ(admissions[0].decision, AdmissionController::ADMIT);
+}
+
+TEST(AdmissionControllerTest, TestEarliestDeadlineFirst) {
+    AdmissionController controller(2);
+    auto admissions = controller.admit(
+        {makeJob("1", 0, 50000, 5000), makeJob("2", 0, 1000, 1000), makeJob("3", 0, 20000, 2000)}, 0);
+    ASSERT_EQ(admissions.size(), 3);
+    ASSERT_EQ(admissions[0].jobId, "2");
+    ASSERT_EQ(admissions[0].decision, AdmissionController::ADMIT);
+    ASSERT_EQ(admissions[1].jobId, "3");
+    ASSERT_EQ(admissions[1].decision, AdmissionController::ADMIT);
+    // Job 1 takes the slot of job 2, which frees up first
+    ASSERT_EQ(admissions[2].jobId, "1");
+    ASSERT_EQ(admissions[2].decision, AdmissionController::DELAY);
+    ASSERT_EQ(admissions[2].delay, 1000);
+}
@@ -0,0 +1,142 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/frontend/core/executor/impl/AggregationPlanner.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(AggregationPlannerTest, TestPrefersWorkerHoldingCopies) {
+    AggregationPlanner planner;
+    planner.addWorker("1", 1000);
+    planner.addWorker("2", 1000);
+    planner.addWorker("3", 1000);
+    planner.addAvailableCopy("3", "1");
+    planner.addAvailableCopy("3", "2");
+
+    auto tasks = planner.plan({{"1", "2", "3"}});
+    ASSERT_EQ(tasks.size(), 1);
+    ASSERT_EQ(tasks[0].aggregatorId, "3");
+    ASSERT_TRUE(tasks[0].transferWorkers.empty());
+    ASSERT_EQ(tasks[0].bytesToMove, 0);
+    ASSERT_EQ(tasks[0].centralEdgeCount, 3000);
+}
+
+TEST(AggregationPlannerTest, TestPrefersLargestLocalStore) {
+    AggregationPlanner planner;
+    planner.addWorker("1", 100);
+    planner.addWorker("2", 100000);
+    planner.addWorker("3", 100);
+
+    auto tasks = planner.plan({{"1", "2", "3"}});
+    ASSERT_EQ(tasks.size(), 1);
+    ASSERT_EQ(tasks[0].aggregatorId, "2");
+    ASSERT_EQ(tasks[0].transferWorkers.size(), 2);
+    ASSERT_EQ(tasks[0].bytesToMove, 200 * AggregationPlanner::BYTES_PER_CENTRAL_EDGE);
+}
+
+TEST(AggregationPlannerTest, TestSpreadsCombinationsOverAggregators) {
+    AggregationPlanner planner;
+    std::vector<std::string> workerIds = {"1", "2", "3", "4", "5"};
+    for (auto &workerId : workerIds) {
+        planner.addWorker(workerId, 10000);
+    }
+    // Heavily loaded worker should not be picked
+    planner.setCpuUsage("1", 400);
+
+    std::vector<std::vector<std::string>> combinations = {
+        {"1", "2", "3"}, {"1", "2", "4"}, {"1", "2", "5"}, {"1", "3", "4"}, {"1", "3", "5"},
+        {"1", "4", "5"}, {"2", "3", "4"}, {"2", "3", "5"}, {"2", "4", "5"}, {"3", "4", "5"}};
+    auto tasks = planner.plan(combinations);
+    ASSERT_EQ(tasks.size(), combinations.size());
+
+    std::map<std::string, int> tasksPerAggregator;
+    for (auto &task : tasks) {
+        tasksPerAggregator[task.aggregatorId]++;
+    }
+    ASSERT_EQ(tasksPerAggregator.count("1"), 0);
+    ASSERT_GE(tasksPerAggregator.size(), 3);
+}
+
+TEST(AggregationPlannerTest, TestReusesCopiesAcrossCombinations) {
+    AggregationPlanner planner;
+    planner.addWorker("1", 1000);
+    planner.addWorker("2", 1000);
+    planner.addWorker("3", 1000);
+    planner.addWorker("4", 1000);
+
+    auto tasks = planner.plan({{"1", "2", "3"}, {"1", "2", "4"}});
+    ASSERT_EQ(tasks.size(), 2);
+    // Whatever the first aggregator copied is available to it afterwards
+    for (auto &workerId : tasks[0].transferWorkers) {
+        ASSERT_TRUE(planner.hasCopy(tasks[0].aggregatorId, workerId));
+    }
+}
+
+TEST(AggregationPlannerTest, TestProbesCopiesOnlyForPlannedCombinations) {
+    AggregationPlanner planner;
+    planner.addWorker("1", 1000);
+    planner.addWorker("2", 1000);
+    planner.addWorker("3", 1000);
+    planner.addWorker("4", 1000);
+    planner.addAvailableCopy("1", "2");
+
+    std::vector<std::pair<std::string, std::string>> probed;
+    planner.setCopyProbe([&](const std::vector<std::pair<std::string, std::string>> &pairs) {
+        probed.insert(probed.end(), pairs.begin(), pairs.end());
+        std::vector<bool> available;
+        for (auto &pair : pairs) {
+            available.push_back(pair.first == "3" && pair.second == "1");
+        }
+        return available;
+    });
+
+    planner.plan({{"1", "2", "3"}, {"1", "2", "3"}});
+    std::set<std::pair<std::string, std::string>> uniqueProbed(probed.begin(), probed.end());
+    // Each pair is asked once, never for worker 4 and never for copies that are already known
+    ASSERT_EQ(uniqueProbed.size(), probed.size());
+    ASSERT_EQ(probed.size(), 5);
+    for (auto &pair : probed) {
+        ASSERT_NE(pair.first, "4");
+        ASSERT_NE(pair.second, "4");
+        ASSERT_NE(pair.first, pair.second);
+    }
+    ASSERT_EQ(uniqueProbed.count(std::make_pair(std::string("1"), std::string("2"))), 0);
+    ASSERT_TRUE(planner.hasCopy("3", "1"));
+}
+
+TEST(AggregationPlannerTest, TestPlansCentralStoresOfTheSameWorker) {
+    std::string store1 = AggregationPlanner::getStoreId("1", "10");
+    std::string store2 = AggregationPlanner::getStoreId("1", "11");
+    std::string store3 = AggregationPlanner::getStoreId("2", "12");
+    ASSERT_NE(store1, store2);
+    ASSERT_EQ(AggregationPlanner::getWorkerId(store2), "1");
+    ASSERT_EQ(AggregationPlanner::getWorkerId("2"), "2");
+
+    AggregationPlanner planner;
+    planner.addWorker(store1, 1000);
+    planner.addWorker(store2, 1000);
+    planner.addWorker(store3, 1000);
+    // The CPU usage of a worker applies to all of its central stores
+    planner.setCpuUsage("1", 400);
+
+    auto tasks = planner.plan({{store1, store2, store3}});
+    ASSERT_EQ(tasks.size(), 1);
+    ASSERT_EQ(tasks[0].aggregatorId, store3);
+    ASSERT_EQ(tasks[0].transferWorkers.size(), 2);
+    ASSERT_EQ(tasks[0].centralEdgeCount, 3000);
+}
@@ -0,0 +1,117 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/frontend/core/cache/AnalyticsResultCache.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+class AnalyticsResultCacheTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        AnalyticsResultCache::clear();
+        AnalyticsResultCache::setCapacity(AnalyticsResultCache::DEFAULT_CAPACITY);
+    }
+
+    void TearDown() override { AnalyticsResultCache::clear(); }
+};
+
+TEST_F(AnalyticsResultCacheTest, TestHitAndMissCounts) {
+    std::string result;
+    ASSERT_FALSE(AnalyticsResultCache::get("1", "trian", "", result));
+    ASSERT_TRUE(AnalyticsResultCache::put("1", "trian", "", AnalyticsResultCache::getGraphVersion("1"), "42"));
+    ASSERT_TRUE(AnalyticsResultCache::get("1", "trian", "", result));
+    ASSERT_EQ(result, "42");
+    ASSERT_FALSE(AnalyticsResultCache::get("1", "trian", "alpha=0.5", result));
+    ASSERT_FALSE(AnalyticsResultCache::get("2", "trian", "", result));
+
+    ASSERT_EQ(AnalyticsResultCache::getHitCount(), 1);
+    ASSERT_EQ(AnalyticsResultCache::getMissCount(), 3);
+    ASSERT_DOUBLE_EQ(AnalyticsResultCache::getHitRate(), 0.25);
+}
+
+TEST_F(AnalyticsResultCacheTest, TestVersionBumpInvalidatesResults) {
+    std::string result;
+    long version = AnalyticsResultCache::getGraphVersion("1");
+    AnalyticsResultCache::put("1", "trian", "", version, "42");
+    AnalyticsResultCache::put("2", "trian", "", AnalyticsResultCache::getGraphVersion("2"), "7");
+
+    ASSERT_EQ(AnalyticsResultCache::bumpGraphVersion("1"), version + 1);
+    ASSERT_FALSE(AnalyticsResultCache::get("1", "trian", "", result));
+    ASSERT_TRUE(AnalyticsResultCache::get("2", "trian", "", result));
+    ASSERT_EQ(result, "7");
+    ASSERT_EQ(AnalyticsResultCache::size(), 1);
+}
+
+TEST_F(AnalyticsResultCacheTest, TestResultComputedAgainstOldVersionIsDropped) {
+    std::string result;
+    long version = AnalyticsResultCache::getGraphVersion("1");
+    AnalyticsResultCache::bumpGraphVersion("1");
+    ASSERT_FALSE(AnalyticsResultCache::put("1", "trian", "", version, "42"));
+    ASSERT_FALSE(AnalyticsResultCache::get("1", "trian", "", result));
+}
+
+TEST_F(AnalyticsResultCacheTest, TestLeastRecentlyUsedEviction) {
+    std::string result;
+    AnalyticsResultCache::setCapacity(2);
+    AnalyticsResultCache::put("1", "trian", "", 0, "1");
+    AnalyticsResultCache::put("2", "trian", "", 0, "2");
+    ASSERT_TRUE(AnalyticsResultCache::get("1", "trian", "", result));
+    AnalyticsResultCache::put("3", "trian", "", 0, "3");
+
+    ASSERT_EQ(AnalyticsResultCache::size(), 2);
+    ASSERT_TRUE(AnalyticsResultCache::get("1", "trian", "", result));
+    ASSERT_FALSE(AnalyticsResultCache::get("2", "trian", "", result));
+    ASSERT_TRUE(AnalyticsResultCache::get("3", "trian", "", result));
+}
+
+TEST_F(AnalyticsResultCacheTest, TestVersionCounterIsSharedWithTheCache) {
+    std::string result;
+    std::atomic<long> &version = AnalyticsResultCache::getVersionCounter("1");
+    ASSERT_EQ(&version, &AnalyticsResultCache::getVersionCounter("1"));
+    AnalyticsResultCache::put("1", "trian", "", version.load(), "42");
+
+    ++version;
+    ASSERT_EQ(AnalyticsResultCache::getGraphVersion("1"), 1);
+    ASSERT_FALSE(AnalyticsResultCache::get("1", "trian", "", result));
+
+    // Holders of the counter keep a valid reference across a clear
+    AnalyticsResultCache::clear();
+    ASSERT_EQ(&version, &AnalyticsResultCache::getVersionCounter("1"));
+    ASSERT_EQ(version.load(), 0);
+}
+
+TEST_F(AnalyticsResultCacheTest, TestConcurrentVersionBumps) {
+    std::atomic<long> &version = AnalyticsResultCache::getVersionCounter("1");
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.push_back(std::thread([&version]() {
+            for (int j = 0; j < 10000; j++) {
+                ++version;
+            }
+        }));
+        threads.push_back(std::thread([]() {
+            for (int j = 0; j < 10000; j++) {
+                AnalyticsResultCache::bumpGraphVersion("1");
+            }
+        }));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(AnalyticsResultCache::getGraphVersion("1"), 80000);
+}
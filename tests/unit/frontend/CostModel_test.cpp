@@ -0,0 +1,79 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/frontend/core/scheduler/CostModel.h"
+
+#include "../../../src/frontend/JasmineGraphFrontEndProtocol.h"
+#include "gtest/gtest.h"
+
+static PartitionStatistics makePartition(std::string workerId, std::string partitionId, long edgeCount,
+                                         double degreeSkew) {
+    PartitionStatistics partition;
+    partition.workerId = workerId;
+    partition.partitionId = partitionId;
+    partition.edgeCount = edgeCount;
+    partition.degreeSkew = degreeSkew;
+    return partition;
+}
+
+class CostModelTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        CostModel::clear();
+        statistics.partitions.push_back(makePartition("1", "0", 10000, 1));
+        statistics.partitions.push_back(makePartition("2", "1", 10000, 2));
+        statistics.centralEdgeCount = 5000;
+    }
+
+    void TearDown() override { CostModel::clear(); }
+
+    GraphStatistics statistics;
+};
+
+TEST_F(CostModelTest, TestSlowestWorkerDecides) {
+    CostModel::setThroughput("1", 100);
+    CostModel::setThroughput("2", 400);
+    CostModel::setAggregationThroughput(50);
+
+    // Worker 1 needs 100 ms, worker 2 needs 20000 / 400 = 50 ms, then 100 ms of aggregation
+    ASSERT_EQ(CostModel::estimate(TRIANGLES, statistics), 200);
+    ASSERT_EQ(CostModel::estimate(PAGE_RANK, statistics), -1);
+    ASSERT_EQ(statistics.getPartition("2", "1")->edgeCount, 10000);
+    ASSERT_EQ(statistics.getPartition("2", "0"), nullptr);
+}
+
+TEST_F(CostModelTest, TestRecalibratesFromMeasurements) {
+    CostModel::setThroughput("1", 100);
+    CostModel::setThroughput("2", 100);
+    CostModel::setAggregationThroughput(50);
+    ASSERT_EQ(CostModel::estimate(TRIANGLES, statistics), 300);
+
+    // Worker 2 turns out to count its partition 4 times faster than assumed, so worker 1 decides
+    CostModel::recordKernelExecution(NULL, TRIANGLES, "1", statistics.partitions[1], 50);
+    ASSERT_EQ(CostModel::estimate(TRIANGLES, statistics), 225);
+    for (int i = 0; i < 10; i++) {
+        CostModel::recordKernelExecution(NULL, TRIANGLES, "1", statistics.partitions[1], 50);
+    }
+    ASSERT_EQ(CostModel::estimate(TRIANGLES, statistics), 200);
+
+    // Jobs keep taking twice the estimate, so the calibration factor grows towards 2
+    double calibration = 1;
+    for (int i = 0; i < 20; i++) {
+        long estimatedTime = CostModel::estimate(TRIANGLES, statistics);
+        CostModel::recordJobExecution(TRIANGLES, estimatedTime, 400);
+        ASSERT_GT(CostModel::getCalibration(TRIANGLES), calibration);
+        calibration = CostModel::getCalibration(TRIANGLES);
+    }
+    ASSERT_NEAR(CostModel::estimate(TRIANGLES, statistics), 400, 10);
+    ASSERT_EQ(CostModel::getCalibration(PAGE_RANK), 1);
+}
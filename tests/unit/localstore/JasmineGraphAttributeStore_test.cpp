@@ -0,0 +1,124 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/localstore/attribute/JasmineGraphAttributeStore.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+class JasmineGraphAttributeStoreTest : public ::testing::Test {
+ protected:
+    std::string textPath = TEST_RESOURCE_DIR "temp/1_attributes_0";
+    std::string storePath = JasmineGraphAttributeStore::getStorePath(TEST_RESOURCE_DIR "temp", "1_attributes_0");
+
+    void TearDown() override {
+        remove(textPath.c_str());
+        remove(storePath.c_str());
+    }
+};
+
+TEST_F(JasmineGraphAttributeStoreTest, TestFeatureVectors) {
+    std::ofstream textFile(textPath);
+    textFile << "7\t0 1 0.5\n2\t1 0 0\n5\t0,0,2.25\n";
+    textFile.close();
+    ASSERT_TRUE(JasmineGraphAttributeStore::convertTextFile(textPath, storePath));
+
+    JasmineGraphAttributeStore store(storePath);
+    ASSERT_TRUE(store.open());
+    ASSERT_EQ(store.size(), 3);
+    ASSERT_EQ(store.getColumnCount(), 1);
+    ASSERT_EQ(store.getColumnType(0), JasmineGraphAttributeStore::FLOAT_VECTOR);
+    ASSERT_EQ(store.getWidth(0), 3);
+
+    long row = store.getRowIndex(5);
+    ASSERT_EQ(store.getVertex(row), 5);
+    const float *features = store.getVector(row, 0);
+    ASSERT_FLOAT_EQ(features[2], 2.25);
+    ASSERT_FLOAT_EQ(store.getVector(store.getRowIndex(7), 0)[2], 0.5);
+    ASSERT_EQ(store.getRowIndex(3), -1);
+    ASSERT_EQ(store.getRowValues(store.getRowIndex(2)), std::vector<std::string>({"1", "0", "0"}));
+}
+
+TEST_F(JasmineGraphAttributeStoreTest, TestIntegerVectors) {
+    JasmineGraphAttributeStore writer(storePath);
+    writer.addRow(1, {"16777217", "0"});
+    writer.addRow(2, {"-5", "2147483647"});
+    ASSERT_TRUE(writer.persist());
+
+    JasmineGraphAttributeStore store(storePath);
+    ASSERT_TRUE(store.open());
+    ASSERT_EQ(store.getColumnCount(), 1);
+    ASSERT_EQ(store.getColumnType(0), JasmineGraphAttributeStore::INT_VECTOR);
+    ASSERT_EQ(store.getIntVector(store.getRowIndex(1), 0)[0], 16777217);
+    ASSERT_EQ(store.getRowValues(store.getRowIndex(2)), std::vector<std::string>({"-5", "2147483647"}));
+}
+
+TEST_F(JasmineGraphAttributeStoreTest, TestFloatsReadBackExactly) {
+    JasmineGraphAttributeStore writer(storePath);
+    writer.addRow(1, {"0.1234567", "3"});
+    writer.addRow(2, {"1234567.5", "0.5"});
+    ASSERT_TRUE(writer.persist());
+
+    JasmineGraphAttributeStore store(storePath);
+    ASSERT_TRUE(store.open());
+    for (long row = 0; row < store.size(); row++) {
+        std::vector<std::string> values = store.getRowValues(row);
+        for (int i = 0; i < store.getWidth(0); i++) {
+            ASSERT_EQ(std::stof(values[i]), store.getVector(row, 0)[i]);
+        }
+    }
+    ASSERT_EQ(store.getRowValues(store.getRowIndex(2))[0], "1234567.5");
+}
+
+TEST_F(JasmineGraphAttributeStoreTest, TestTypedColumns) {
+    JasmineGraphAttributeStore writer(storePath);
+    writer.addRow(10, {"42", "1.5", "red"});
+    writer.addRow(20, {"-3", "2", "blue"});
+    writer.addRow(30, {"8"});
+    writer.addRow(40, {"9", "x", "red"});
+    ASSERT_TRUE(writer.persist());
+
+    JasmineGraphAttributeStore store(storePath);
+    ASSERT_TRUE(store.open());
+    ASSERT_EQ(store.getColumnCount(), 3);
+    ASSERT_EQ(store.getColumnType(0), JasmineGraphAttributeStore::INT);
+    ASSERT_EQ(store.getColumnType(1), JasmineGraphAttributeStore::STRING);
+    ASSERT_EQ(store.getColumnType(2), JasmineGraphAttributeStore::STRING);
+
+    ASSERT_EQ(store.getInt(store.getRowIndex(20), 0), -3);
+    uint32_t length;
+    const char *colour = store.getString(store.getRowIndex(40), 2, length);
+    ASSERT_EQ(std::string(colour, length), "red");
+    colour = store.getString(store.getRowIndex(30), 2, length);
+    ASSERT_EQ(length, 0);
+    ASSERT_EQ(store.getRowValues(store.getRowIndex(10)), std::vector<std::string>({"42", "1.5", "red"}));
+}
+
+TEST_F(JasmineGraphAttributeStoreTest, TestRejectsCorruptStore) {
+    JasmineGraphAttributeStore writer(storePath);
+    writer.addRow(1, {"1.5"});
+    ASSERT_TRUE(writer.persist());
+
+    std::fstream storeFile(storePath, std::ios::in | std::ios::out | std::ios::binary);
+    storeFile.write("XXXX", 4);
+    storeFile.close();
+
+    JasmineGraphAttributeStore store(storePath);
+    ASSERT_FALSE(store.open());
+    ASSERT_FALSE(store.isOpen());
+    ASSERT_FALSE(JasmineGraphAttributeStore(TEST_RESOURCE_DIR "temp/missing.columnar").open());
+}
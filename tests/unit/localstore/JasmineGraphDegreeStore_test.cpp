@@ -0,0 +1,107 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/localstore/degree/JasmineGraphDegreeStore.h"
+
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+
+class JasmineGraphDegreeStoreTest : public ::testing::Test {
+ protected:
+    JasmineGraphDegreeStore *degreeStore = NULL;
+
+    void SetUp() override {
+        degreeStore = new JasmineGraphDegreeStore("1", "0", TEST_RESOURCE_DIR "temp");
+        std::map<long, std::unordered_set<long>> localGraphMap = {{1, {2, 3}}, {2, {3}}, {3, {}}};
+        std::map<long, std::unordered_set<long>> centralGraphMap = {{1, {10}}, {3, {10, 11}}, {12, {1}}};
+        degreeStore->build(localGraphMap, centralGraphMap);
+    }
+
+    void TearDown() override {
+        remove(degreeStore->getStorePath().c_str());
+        remove(degreeStore->getDirtyMarkerPath().c_str());
+        delete degreeStore;
+    }
+};
+
+TEST_F(JasmineGraphDegreeStoreTest, TestBuild) {
+    auto outDegree = degreeStore->getOutDegreeDistribution();
+    ASSERT_EQ(outDegree.size(), 3);
+    ASSERT_EQ(outDegree[1], 3);
+    ASSERT_EQ(outDegree[2], 1);
+    ASSERT_EQ(outDegree[3], 2);
+
+    auto localInDegree = degreeStore->getLocalInDegreeDistribution();
+    ASSERT_EQ(localInDegree.size(), 2);
+    ASSERT_EQ(localInDegree[3], 2);
+
+    auto centralInDegree = degreeStore->getCentralInDegreeDistribution();
+    ASSERT_EQ(centralInDegree.size(), 3);
+    ASSERT_EQ(centralInDegree[10], 2);
+    ASSERT_EQ(centralInDegree[1], 1);
+}
+
+TEST_F(JasmineGraphDegreeStoreTest, TestPersistAndLoad) {
+    degreeStore->addEdge(2, 4, false, true);
+    ASSERT_TRUE(degreeStore->isDirty());
+    ASSERT_TRUE(degreeStore->persist());
+    ASSERT_FALSE(degreeStore->isDirty());
+
+    JasmineGraphDegreeStore loaded("1", "0", TEST_RESOURCE_DIR "temp");
+    ASSERT_TRUE(loaded.exists());
+    ASSERT_TRUE(loaded.load());
+    ASSERT_EQ(loaded.size(), degreeStore->size());
+    ASSERT_EQ(loaded.getOutDegreeDistribution(), degreeStore->getOutDegreeDistribution());
+    ASSERT_EQ(loaded.getLocalInDegreeDistribution()[4], 1);
+}
+
+TEST_F(JasmineGraphDegreeStoreTest, TestCentralEdgeOwnership) {
+    // The partition holding the destination of a central edge does not own its source
+    degreeStore->addEdge(20, 2, true, false);
+    degreeStore->addEdge(21, 22, true, true);
+    auto outDegree = degreeStore->getOutDegreeDistribution();
+    ASSERT_EQ(outDegree.count(20), 0);
+    ASSERT_EQ(outDegree[21], 1);
+    ASSERT_EQ(degreeStore->getCentralInDegreeDistribution()[2], 1);
+}
+
+TEST_F(JasmineGraphDegreeStoreTest, TestDirtySidecarIsNotLoaded) {
+    ASSERT_TRUE(degreeStore->persist());
+    degreeStore->addEdge(2, 4, false, true);
+    ASSERT_TRUE(degreeStore->isMarkedDirty());
+
+    JasmineGraphDegreeStore stale("1", "0", TEST_RESOURCE_DIR "temp");
+    ASSERT_FALSE(stale.load());
+
+    ASSERT_TRUE(degreeStore->persist());
+    ASSERT_FALSE(degreeStore->isMarkedDirty());
+    ASSERT_TRUE(stale.load());
+    ASSERT_EQ(stale.getLocalInDegreeDistribution()[4], 1);
+}
+
+TEST_F(JasmineGraphDegreeStoreTest, TestHistogram) {
+    auto histogram = JasmineGraphDegreeStore::toHistogram(degreeStore->getOutDegreeDistribution());
+    std::string encoded = JasmineGraphDegreeStore::histogramToString(histogram);
+    ASSERT_EQ(encoded, "1:1,2:1,3:1");
+    ASSERT_EQ(JasmineGraphDegreeStore::histogramFromString(encoded), histogram);
+}
+
+TEST_F(JasmineGraphDegreeStoreTest, TestDistributionFile) {
+    std::string filePath = TEST_RESOURCE_DIR "temp/1_idd_0";
+    auto distribution = degreeStore->getCentralInDegreeDistribution();
+    ASSERT_TRUE(JasmineGraphDegreeStore::writeDistribution(filePath, distribution));
+    ASSERT_EQ(JasmineGraphDegreeStore::readDistribution(filePath), distribution);
+    remove(filePath.c_str());
+}
@@ -13,7 +13,12 @@ limitations under the License.
 
 #include "../../../src/metadb/SQLiteDBInterface.h"
 
+#include <atomic>
+#include <chrono>
 #include <string>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 class SQLiteDBInterfaceTest : public ::testing::Test {
@@ -67,3 +72,79 @@ TEST_F(SQLiteDBInterfaceTest, TestRunInsertAndUpdate) {
     ASSERT_EQ(data[0][3].second, "false");
 }
 
+
+TEST_F(SQLiteDBInterfaceTest, TestPreparedStatement) {
+    ASSERT_EQ(dbInterface->runInsertBatch("INSERT INTO host('name', 'ip', 'is_public') VALUES(?, ?, ?)",
+                                          {{"worker1", "10.0.0.1", "false"}, {"worker2", "10.0.0.2", "true"}}),
+              2);
+
+    PreparedStatement statement = dbInterface->prepare("SELECT idhost, name, ip FROM host WHERE name = ?");
+    ASSERT_TRUE(statement.isValid());
+    statement.bind(1, std::string("worker2"));
+    ASSERT_TRUE(statement.next());
+    ASSERT_EQ(statement.getColumnCount(), 3);
+    ASSERT_EQ(statement.getLong(0), 2);
+    ASSERT_EQ(statement.getString(1), "worker2");
+    ASSERT_STREQ(statement.getText(2), "10.0.0.2");
+    ASSERT_FALSE(statement.next());
+
+    // A rewound statement runs again with new parameters
+    statement.bind(1, std::string("worker1"));
+    ASSERT_TRUE(statement.next());
+    ASSERT_EQ(statement.getInt(0), 1);
+
+    PreparedStatement invalid = dbInterface->prepare("SELECT * FROM no_such_table");
+    ASSERT_FALSE(invalid.isValid());
+    ASSERT_FALSE(invalid.next());
+}
+
+TEST_F(SQLiteDBInterfaceTest, TestFailedBatchIsRolledBack) {
+    ASSERT_EQ(dbInterface->runInsertBatch("INSERT INTO host(idhost, name) VALUES(?, ?)",
+                                          {{"1", "worker1"}, {"1", "duplicate"}}),
+              -1);
+    ASSERT_EQ(dbInterface->runSelect("SELECT * FROM host").size(), 0);
+}
+
+TEST_F(SQLiteDBInterfaceTest, TestPreparedStatementMatchesRunSelect) {
+    std::vector<std::vector<std::string>> rows;
+    for (int i = 0; i < 100; i++) {
+        rows.push_back({"worker" + std::to_string(i), "10.0.0." + std::to_string(i)});
+    }
+    ASSERT_EQ(dbInterface->runInsertBatch("INSERT INTO host('name', 'ip') VALUES(?, ?)", rows), 100);
+
+    for (int limit : {1, 17, 50}) {
+        long selectSum = 0;
+        for (auto &row : dbInterface->runSelect("SELECT idhost, ip FROM host WHERE idhost <= " +
+                                                std::to_string(limit))) {
+            selectSum += std::stol(row[0].second);
+        }
+        long preparedSum = 0;
+        PreparedStatement statement = dbInterface->prepare("SELECT idhost, ip FROM host WHERE idhost <= ?");
+        statement.bind(1, limit);
+        while (statement.next()) {
+            preparedSum += statement.getLong(0);
+        }
+        ASSERT_EQ(selectSum, preparedSum);
+    }
+}
+
+TEST_F(SQLiteDBInterfaceTest, TestTransactionExcludesOtherWriters) {
+    ASSERT_TRUE(dbInterface->beginTransaction());
+    ASSERT_EQ(dbInterface->prepare("INSERT INTO host('name', 'ip') VALUES('rolled back', '10.0.0.1')").execute(),
+              SQLITE_DONE);
+
+    std::atomic<bool> inserted(false);
+    std::thread writer([this, &inserted]() {
+        dbInterface->runInsert("INSERT INTO host('name', 'ip') VALUES('kept', '10.0.0.2')");
+        inserted = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(inserted);
+
+    // The insert of the other thread waited for the transaction instead of being rolled back with it
+    dbInterface->rollbackTransaction();
+    writer.join();
+    auto hosts = dbInterface->runSelect("SELECT name FROM host");
+    ASSERT_EQ(hosts.size(), 1);
+    ASSERT_EQ(hosts[0][0].second, "kept");
+}
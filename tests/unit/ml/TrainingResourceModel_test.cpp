@@ -0,0 +1,99 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/ml/trainer/TrainingResourceModel.h"
+
+#include "../../../src/ml/trainer/JasmineGraphTrainingSchedular.h"
+#include "gtest/gtest.h"
+
+static TrainingInput makeInput(std::string partitionId, long vertexCount, long edgeCount, int featureCount) {
+    TrainingInput input;
+    input.graphId = "1";
+    input.partitionId = partitionId;
+    input.vertexCount = vertexCount;
+    input.edgeCount = edgeCount;
+    input.featureCount = featureCount;
+    return input;
+}
+
+class TrainingResourceModelTest : public ::testing::Test {
+ protected:
+    void SetUp() override { TrainingResourceModel::clear(); }
+
+    void TearDown() override { TrainingResourceModel::clear(); }
+};
+
+TEST_F(TrainingResourceModelTest, TestFitsProfiles) {
+    TrainingInput unseen = makeInput("100", 5000, 20000, 16);
+    ASSERT_FALSE(TrainingResourceModel::estimate("model", unseen).measured);
+
+    for (int i = 0; i < TrainingResourceModel::MIN_FIT_SAMPLES; i++) {
+        TrainingInput input = makeInput(std::to_string(i), 1000 * (i + 1), 3000 * (i % 3 + 1), 8 * (i % 2 + 1));
+        TrainingProfile profile;
+        profile.peakMemory = 50000 + 2 * input.vertexCount + input.vertexCount * input.featureCount / 4 +
+                             input.edgeCount;
+        profile.elapsedTime = 100 + input.edgeCount / 10;
+        profile.cpuTime = profile.elapsedTime / 4;
+        TrainingResourceModel::addSample("model", input, profile);
+    }
+    ASSERT_TRUE(TrainingResourceModel::isFitted("model"));
+
+    TrainingEstimate estimate = TrainingResourceModel::estimate("model", unseen);
+    ASSERT_TRUE(estimate.measured);
+    ASSERT_NEAR(estimate.memory, (50000 + 10000 + 20000 + 20000) * TrainingResourceModel::MEMORY_HEADROOM, 100);
+    ASSERT_NEAR(estimate.time, 2100, 5);
+    ASSERT_NEAR(estimate.cpuFraction, 0.25, 0.01);
+
+    // A partition that was profiled before is predicted by its own profile
+    TrainingEstimate profiled = TrainingResourceModel::estimate("model", makeInput("0", 1000, 3000, 8));
+    ASSERT_EQ(profiled.memory, 50000 + 2000 + 2000 + 3000);
+    ASSERT_EQ(profiled.time, 400);
+}
+
+TEST_F(TrainingResourceModelTest, TestProfilesRoundTrip) {
+    TrainingProfile profile;
+    profile.model = TrainingProfiler::FL_CLIENT_MODEL;
+    profile.graphId = "3";
+    profile.partitionId = "1";
+    ASSERT_EQ(TrainingProfiler::run("exit 3", profile), 3);
+    ASSERT_GT(profile.peakMemory, 0);
+
+    TrainingProfiler::record(profile);
+    std::vector<TrainingProfile> parsed =
+        TrainingProfiler::parse(TrainingProfiler::serialize(TrainingProfiler::drain()));
+    ASSERT_EQ(parsed.size(), 1);
+    ASSERT_EQ(parsed[0].model, TrainingProfiler::FL_CLIENT_MODEL);
+    ASSERT_EQ(parsed[0].partitionId, "1");
+    ASSERT_EQ(parsed[0].peakMemory, profile.peakMemory);
+    ASSERT_EQ(parsed[0].exitStatus, 3);
+    ASSERT_TRUE(TrainingProfiler::drain().empty());
+}
+
+TEST(TrainingSchedularTest, TestPacksWithinMemory) {
+    std::vector<PartitionDemand> partitions = {{1, 60, 10, 0.5}, {2, 60, 10, 0.5}, {3, 30, 10, 0.5}};
+    std::map<int, int> schedule = JasmineGraphTrainingSchedular::packPartitions(partitions, 100, 0);
+    ASSERT_NE(schedule[1], schedule[2]);
+    ASSERT_EQ(schedule[3], 0);
+    ASSERT_EQ(std::max(schedule[1], schedule[2]), 1);
+}
+
+TEST(TrainingSchedularTest, TestOverlapsCpuAndIoBoundPartitions) {
+    // Partitions 1 and 2 are CPU bound, 3 and 4 wait for the disk. With one core each iteration should take one of
+    // each kind.
+    std::vector<PartitionDemand> partitions = {{1, 10, 100, 1}, {2, 10, 100, 1}, {3, 10, 100, 0}, {4, 10, 100, 0}};
+    std::map<int, int> schedule = JasmineGraphTrainingSchedular::packPartitions(partitions, 1000, 1);
+    ASSERT_NE(schedule[1], schedule[2]);
+    ASSERT_NE(schedule[3], schedule[4]);
+    ASSERT_EQ(schedule[1], schedule[3]);
+    ASSERT_EQ(schedule[2], schedule[4]);
+}
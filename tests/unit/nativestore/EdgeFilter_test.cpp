@@ -0,0 +1,92 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/nativestore/EdgeFilter.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+TEST(EdgeFilterTest, TestNoFalseNegatives) {
+    EdgeFilter edgeFilter(1000);
+    for (unsigned int i = 0; i < 10000; i++) {
+        edgeFilter.insert(i * 52, (i * 7919) % 5000 * 52);
+    }
+    ASSERT_EQ(edgeFilter.size(), 10000);
+    for (unsigned int i = 0; i < 10000; i++) {
+        ASSERT_TRUE(edgeFilter.mayContain(i * 52, (i * 7919) % 5000 * 52));
+        // Relations are found from either end
+        ASSERT_TRUE(edgeFilter.mayContain((i * 7919) % 5000 * 52, i * 52));
+    }
+}
+
+TEST(EdgeFilterTest, TestFalsePositiveRate) {
+    EdgeFilter edgeFilter(1000);
+    for (unsigned int i = 0; i < 20000; i++) {
+        edgeFilter.insert(i, i + 1);
+    }
+    int positives = 0;
+    for (unsigned int i = 0; i < 100000; i++) {
+        if (edgeFilter.mayContain(i + 100000, i + 300000)) {
+            positives++;
+            edgeFilter.recordFalsePositive();
+        }
+    }
+    // The layers added while growing keep the rate close to that of a single filter
+    ASSERT_LT(positives, 1000);
+    ASSERT_NEAR(edgeFilter.getFalsePositiveRate(), positives / 100000.0, 1e-9);
+}
+
+TEST(EdgeFilterTest, TestWriteAndRead) {
+    std::string filePath = TEST_RESOURCE_DIR "temp/g1_p0_relations.filter.db";
+    EdgeFilter edgeFilter(16);
+    for (unsigned int i = 0; i < 100; i++) {
+        edgeFilter.insert(i, 2 * i);
+    }
+    ASSERT_TRUE(edgeFilter.write(filePath, 101));
+
+    EdgeFilter loaded;
+    uint64_t relationCount = 0;
+    ASSERT_TRUE(loaded.read(filePath, relationCount));
+    ASSERT_EQ(relationCount, 101);
+    ASSERT_EQ(loaded.size(), 100);
+    ASSERT_EQ(loaded.getSizeInBytes(), edgeFilter.getSizeInBytes());
+    for (unsigned int i = 0; i < 100; i++) {
+        ASSERT_TRUE(loaded.mayContain(2 * i, i));
+    }
+    remove(filePath.c_str());
+}
+
+TEST(EdgeFilterTest, TestRebuild) {
+    // Relation blocks of 13 records with the node block addresses in the third and fourth records
+    std::string relationsPath = TEST_RESOURCE_DIR "temp/g1_p0_relations.db";
+    std::ofstream relationsFile(relationsPath, std::ios::binary);
+    unsigned int block[13] = {0};
+    relationsFile.write(reinterpret_cast<char *>(block), sizeof(block));
+    for (unsigned int i = 1; i <= 50; i++) {
+        block[2] = i * 52;
+        block[3] = (i + 1) * 52;
+        relationsFile.write(reinterpret_cast<char *>(block), sizeof(block));
+    }
+    relationsFile.close();
+
+    EdgeFilter edgeFilter;
+    ASSERT_TRUE(edgeFilter.rebuild(relationsPath, sizeof(block)));
+    ASSERT_EQ(edgeFilter.size(), 50);
+    for (unsigned int i = 1; i <= 50; i++) {
+        ASSERT_TRUE(edgeFilter.mayContain(i * 52, (i + 1) * 52));
+    }
+    remove(relationsPath.c_str());
+}
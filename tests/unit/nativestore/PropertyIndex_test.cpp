@@ -0,0 +1,95 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/nativestore/PropertyIndex.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../../../src/nativestore/PropertyStore.h"
+#include "gtest/gtest.h"
+
+static const std::string INDEX_PATH = TEST_RESOURCE_DIR "temp/g1_p0_properties.index0.db";
+static const std::string STORE_PATH = TEST_RESOURCE_DIR "temp/g3_p0_properties";
+
+TEST(PropertyIndexTest, TestLookupAndRange) {
+    PropertyIndex hash(INDEX_PATH, PropertyIndex::HASH);
+    ASSERT_TRUE(hash.open(true));
+    hash.add("Colombo", 24);
+    hash.add("Kandy", 48);
+    hash.add("Colombo", 72);
+    ASSERT_EQ(hash.lookup("Colombo"), std::vector<uint64_t>({24, 72}));
+    ASSERT_TRUE(hash.lookup("Galle").empty());
+    ASSERT_TRUE(hash.range("A", "Z").empty());
+    hash.close();
+
+    PropertyIndex ordered(INDEX_PATH, PropertyIndex::ORDERED);
+    ASSERT_TRUE(ordered.open(true));
+    ordered.add("9", 1);
+    ordered.add("10", 2);
+    ordered.add("2.5", 3);
+    ordered.add("abc", 4);
+    ordered.add("100", PropertyIndex::CENTRAL_RELATION | 5);
+    // Numbers compare by value, not byte by byte, and come before the other strings
+    ASSERT_EQ(ordered.range("2", "10"), std::vector<uint64_t>({3, 1, 2}));
+    ASSERT_EQ(ordered.range("50", ""), std::vector<uint64_t>({PropertyIndex::CENTRAL_RELATION | 5, 4}));
+    ASSERT_EQ(ordered.range("", "9"), std::vector<uint64_t>({3, 1}));
+    ordered.remove("10", 2);
+    ASSERT_TRUE(ordered.lookup("10").empty());
+    ASSERT_EQ(ordered.size(), 4);
+    ordered.close();
+
+    // The log is replayed on open, without the removed posting
+    PropertyIndex reopened(INDEX_PATH, PropertyIndex::ORDERED);
+    ASSERT_TRUE(reopened.open(false));
+    ASSERT_EQ(reopened.size(), 4);
+    ASSERT_EQ(reopened.range("2", "10"), std::vector<uint64_t>({3, 1}));
+    reopened.close();
+    remove(INDEX_PATH.c_str());
+}
+
+TEST(PropertyIndexTest, TestPropertyStoreUpdatesIndexes) {
+    PropertyStore store;
+    ASSERT_TRUE(store.open(STORE_PATH, true));
+    unsigned int first = store.put(0, "city", "Colombo", 0);
+    PropertyIndex *index = store.createIndex("age", PropertyIndex::ORDERED);
+    ASSERT_NE(index, nullptr);
+    ASSERT_EQ(store.createIndex("age", PropertyIndex::HASH), nullptr);
+    ASSERT_EQ(store.getIndex("city"), nullptr);
+
+    first = store.put(first, "age", "31", 0);
+    unsigned int second = store.put(0, "age", "45", 24);
+    store.put(second, "age", "27", 24);
+    // Puts that do not name the entity leave the index alone
+    store.put(0, "age", "60");
+    ASSERT_EQ(index->range("", "40"), std::vector<uint64_t>({24, 0}));
+    ASSERT_TRUE(index->lookup("45").empty());
+    store.close();
+
+    // The index definitions survive reopening, even when the store is truncated
+    PropertyStore reopened;
+    ASSERT_TRUE(reopened.open(STORE_PATH, false));
+    ASSERT_NE(reopened.getIndex("age"), nullptr);
+    ASSERT_EQ(reopened.getIndex("age")->lookup("31"), std::vector<uint64_t>({0}));
+    reopened.close();
+    PropertyStore truncated;
+    ASSERT_TRUE(truncated.open(STORE_PATH, true));
+    ASSERT_NE(truncated.getIndex("age"), nullptr);
+    ASSERT_EQ(truncated.getIndex("age")->size(), 0);
+    truncated.close();
+
+    for (auto suffix : {".keys.db", ".runs.db", ".indexes.db", ".index1.db"}) {
+        remove((STORE_PATH + suffix).c_str());
+    }
+}
@@ -0,0 +1,145 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/nativestore/PropertyStore.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "../../../src/nativestore/NodeBlock.h"
+#include "../../../src/nativestore/RelationBlock.h"
+#include "../../../src/util/Utils.h"
+#include "gtest/gtest.h"
+
+static const std::string STORE_PATH = TEST_RESOURCE_DIR "temp/g1_p0_properties";
+
+TEST(PropertyStoreTest, TestPutAndGet) {
+    PropertyStore store;
+    ASSERT_TRUE(store.open(STORE_PATH, true));
+    unsigned int reference = store.put(0, "name", "Ada Lovelace");
+    reference = store.put(reference, "a_property_name_longer_than_twelve_bytes", "1815");
+    reference = store.put(reference, "name", "Augusta Ada King");
+
+    std::map<std::string, std::string> properties = store.getAll(reference);
+    ASSERT_EQ(properties.size(), 2);
+    ASSERT_EQ(properties["name"], "Augusta Ada King");
+    ASSERT_EQ(properties["a_property_name_longer_than_twelve_bytes"], "1815");
+    std::string value;
+    ASSERT_TRUE(store.get(reference, "name", value));
+    ASSERT_EQ(value, "Augusta Ada King");
+    ASSERT_FALSE(store.get(reference, "age", value));
+    ASSERT_EQ(store.getKeyCount(), 2);
+    ASSERT_TRUE(store.getAll(0).empty());
+    store.close();
+}
+
+TEST(PropertyStoreTest, TestInlineAndGrowth) {
+    PropertyStore store;
+    ASSERT_TRUE(store.open(STORE_PATH, true));
+    uint64_t emptySize = store.getSizeInBytes();
+
+    // A single small value stays in the reference
+    unsigned int reference = store.put(0, "w", "42");
+    ASSERT_TRUE(reference & PropertyStore::INLINE_FLAG);
+    ASSERT_EQ(store.getAll(reference)["w"], "42");
+    ASSERT_EQ(store.getSizeInBytes(), emptySize + 3);
+
+    // Values of any size up to the limit, moving the run through the size classes
+    for (int i = 0; i < 50; i++) {
+        reference = store.put(reference, "p" + std::to_string(i), std::string(i * 20, 'a' + i % 26));
+    }
+    ASSERT_FALSE(reference & PropertyStore::INLINE_FLAG);
+    std::map<std::string, std::string> properties = store.getAll(reference);
+    ASSERT_EQ(properties.size(), 51);
+    ASSERT_EQ(properties["p49"], std::string(980, 'a' + 49 % 26));
+
+    // A released run is taken by the next run of its size class
+    unsigned int small = store.put(0, "name", "a value of 20 bytes.");
+    unsigned int grown = store.put(small, "other", "a value that does not fit in 32 bytes");
+    ASSERT_NE(grown, small);
+    unsigned int reused = store.put(0, "name", "another 20 byte name");
+    ASSERT_EQ(reused, small);
+    store.close();
+
+    PropertyStore reopened;
+    ASSERT_TRUE(reopened.open(STORE_PATH, false));
+    ASSERT_EQ(reopened.getAll(reference), properties);
+    ASSERT_EQ(reopened.getAll(grown)["other"], "a value that does not fit in 32 bytes");
+    reopened.close();
+}
+
+static void writeLegacyBlock(std::ofstream &file, const std::string &name, const std::string &value,
+                             unsigned int next) {
+    char block[196] = {0};
+    strncpy(block, name.c_str(), 12);
+    strncpy(block + 12, value.c_str(), 180);
+    memcpy(block + 192, &next, sizeof(next));
+    file.write(block, sizeof(block));
+}
+
+TEST(PropertyStoreTest, TestMigrate) {
+    std::string prefix = TEST_RESOURCE_DIR "temp/g2_p0";
+    // Two linked properties of node 1 and one of the relation 0, addressed by byte offsets
+    std::ofstream nodeProperties(prefix + "_properties.db", std::ios::binary);
+    writeLegacyBlock(nodeProperties, "", "", 0);
+    writeLegacyBlock(nodeProperties, "label", "a_long_vertex_id", 392);
+    writeLegacyBlock(nodeProperties, "city", "Colombo", 0);
+    nodeProperties.close();
+    std::ofstream edgeProperties(prefix + "_edge_properties.db", std::ios::binary);
+    writeLegacyBlock(edgeProperties, "", "", 0);
+    writeLegacyBlock(edgeProperties, "weight", "0.75", 0);
+    edgeProperties.close();
+
+    std::ofstream nodes(prefix + "_nodes.db", std::ios::binary);
+    char nodeBlock[NodeBlock::BLOCK_SIZE] = {0};
+    nodes.write(nodeBlock, sizeof(nodeBlock));
+    unsigned int propRef = 196;
+    memcpy(nodeBlock + 14, &propRef, sizeof(propRef));
+    nodes.write(nodeBlock, sizeof(nodeBlock));
+    nodes.close();
+    std::ofstream relations(prefix + "_relations.db", std::ios::binary);
+    unsigned int relationBlock[13] = {0};
+    relationBlock[static_cast<int>(RelationOffsets::RELATION_PROPS)] = 196;
+    relations.write(reinterpret_cast<char *>(relationBlock), sizeof(relationBlock));
+    relations.close();
+
+    ASSERT_TRUE(PropertyStore::migrate(prefix));
+    ASSERT_FALSE(Utils::fileExists(prefix + "_properties.db"));
+    ASSERT_TRUE(Utils::fileExists(prefix + "_properties.db.legacy"));
+
+    std::ifstream migratedNodes(prefix + "_nodes.db", std::ios::binary);
+    migratedNodes.seekg(NodeBlock::BLOCK_SIZE + 14);
+    migratedNodes.read(reinterpret_cast<char *>(&propRef), sizeof(propRef));
+    PropertyStore store;
+    ASSERT_TRUE(store.open(prefix + "_properties", false));
+    std::map<std::string, std::string> properties = store.getAll(propRef);
+    ASSERT_EQ(properties.size(), 2);
+    ASSERT_EQ(properties["label"], "a_long_vertex_id");
+    ASSERT_EQ(properties["city"], "Colombo");
+    store.close();
+
+    std::ifstream migratedRelations(prefix + "_relations.db", std::ios::binary);
+    migratedRelations.read(reinterpret_cast<char *>(relationBlock), sizeof(relationBlock));
+    PropertyStore edgeStore;
+    ASSERT_TRUE(edgeStore.open(prefix + "_edge_properties", false));
+    ASSERT_EQ(edgeStore.getAll(relationBlock[static_cast<int>(RelationOffsets::RELATION_PROPS)])["weight"], "0.75");
+    edgeStore.close();
+
+    for (auto suffix : {"_properties.db.legacy", "_edge_properties.db.legacy", "_nodes.db", "_relations.db",
+                        "_properties.keys.db", "_properties.runs.db", "_edge_properties.keys.db",
+                        "_edge_properties.runs.db"}) {
+        remove((prefix + suffix).c_str());
+    }
+}
@@ -0,0 +1,104 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/nativestore/StoreCompactor.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../../../src/nativestore/NodeManager.h"
+#include "../../../src/nativestore/RelationBlock.h"
+#include "../../../src/util/Utils.h"
+#include "gtest/gtest.h"
+
+TEST(StoreCompactorTest, TestCompact) {
+    GraphConfig graphConfig;
+    graphConfig.graphID = 900012;
+    graphConfig.partitionID = 0;
+    graphConfig.maxLabelSize = std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size"));
+    graphConfig.openMode = "trunc";
+    graphConfig.checkpointRecords = 0;
+
+    NodeManager *nodeManager = new NodeManager(graphConfig);
+    ASSERT_TRUE(nodeManager->createPropertyIndex(true, "weight", PropertyIndex::ORDERED));
+    // The relations of node 0 are spread over the relation file
+    std::vector<std::pair<std::string, std::string>> edges;
+    for (int i = 1; i < 10; i++) {
+        edges.push_back({std::to_string(i), std::to_string(i + 1)});
+        edges.push_back({"0", std::to_string(i)});
+    }
+    for (auto &edge : edges) {
+        RelationBlock *relation = nodeManager->addLocalEdge(edge);
+        ASSERT_NE(relation, nullptr);
+        relation->addLocalProperty("weight", edge.first + "-" + edge.second);
+        relation->getSource()->addProperty("name", "node" + edge.first);
+    }
+    RelationBlock *central = nodeManager->addCentralEdge({"3", "100"});
+    ASSERT_NE(central, nullptr);
+    central->addCentralProperty("weight", "3-100");
+    std::string dbPrefix = nodeManager->getDbPrefix();
+    // The store does not log, so only the partition lock keeps the compaction away from it
+    StoreCompactor::Stats stats;
+    ASSERT_FALSE(StoreCompactor::compact(dbPrefix, graphConfig.maxLabelSize, stats));
+    nodeManager->close();
+    delete nodeManager;
+
+    ASSERT_TRUE(StoreCompactor::compact(dbPrefix, graphConfig.maxLabelSize, stats));
+    ASSERT_EQ(stats.relations, edges.size());
+    ASSERT_EQ(stats.droppedRelations, 0);
+    ASSERT_EQ(stats.centralRelations, 1);
+    ASSERT_GT(stats.bytesBefore, 0);
+    ASSERT_FALSE(Utils::fileExists(dbPrefix + "_compact.commit"));
+    ASSERT_FALSE(Utils::fileExists(dbPrefix + "_compact_relations.db"));
+
+    // Relations are grouped by source
+    std::ifstream relations(dbPrefix + "_relations.db", std::ios::binary);
+    std::vector<uint32_t> sources;
+    uint32_t block[13];
+    while (relations.read(reinterpret_cast<char *>(block), sizeof(block))) {
+        sources.push_back(block[static_cast<int>(RelationOffsets::SOURCE)]);
+    }
+    ASSERT_EQ(sources.size(), edges.size() + 1);
+    for (size_t i = 2; i < sources.size(); i++) {
+        ASSERT_LE(sources[i - 1], sources[i]);
+    }
+
+    graphConfig.openMode = "app";
+    nodeManager = new NodeManager(graphConfig);
+    std::map<long, std::unordered_set<long>> adjacencyList = nodeManager->getAdjacencyList(true);
+    ASSERT_EQ(adjacencyList.size(), 10);
+    ASSERT_EQ(adjacencyList[0].size(), 9);
+    for (auto &edge : edges) {
+        NodeBlock *source = nodeManager->get(edge.first);
+        NodeBlock *destination = nodeManager->get(edge.second);
+        ASSERT_NE(source, nullptr);
+        ASSERT_NE(destination, nullptr);
+        ASSERT_EQ(source->getAllProperties()["name"], "node" + edge.first);
+        RelationBlock *relation = source->searchLocalRelation(*destination);
+        ASSERT_NE(relation, nullptr);
+        ASSERT_EQ(relation->getAllProperties()["weight"], edge.first + "-" + edge.second);
+    }
+    central = nodeManager->get("3")->searchCentralRelation(*nodeManager->get("100"));
+    ASSERT_NE(central, nullptr);
+    ASSERT_EQ(central->getAllProperties()["weight"], "3-100");
+
+    PropertyIndex *index = nodeManager->getPropertyIndex(true, "weight");
+    ASSERT_NE(index, nullptr);
+    std::vector<uint64_t> found = index->lookup("0-7");
+    ASSERT_EQ(found.size(), 1);
+    ASSERT_EQ(RelationBlock::getLocalRelation(found[0])->getAllProperties()["weight"], "0-7");
+    ASSERT_EQ(index->lookup("3-100"), std::vector<uint64_t>({PropertyIndex::CENTRAL_RELATION | central->addr}));
+    nodeManager->close();
+    delete nodeManager;
+}
@@ -0,0 +1,132 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/nativestore/VertexDictionary.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../../../src/util/Utils.h"
+#include "gtest/gtest.h"
+
+static std::vector<std::string> makeIds(int count) {
+    std::vector<std::string> externalIds;
+    for (int i = 0; i < count; i++) {
+        externalIds.push_back("http://example.org/user/" + std::to_string(i * 7919));
+    }
+    return externalIds;
+}
+
+TEST(VertexDictionaryTest, TestDenseIds) {
+    VertexDictionary dictionary(4);
+    std::vector<std::string> externalIds = makeIds(5000);
+    std::vector<uint64_t> ids;
+    dictionary.getOrAssign(externalIds, ids);
+    ASSERT_EQ(ids.size(), 5000);
+    ASSERT_EQ(dictionary.size(), 5000);
+
+    // Striped over the shards, the ids fill 0..n-1 up to the imbalance of the shards
+    std::set<uint64_t> distinct(ids.begin(), ids.end());
+    ASSERT_EQ(distinct.size(), 5000);
+    ASSERT_LT(*distinct.rbegin(), 5000 * 1.2);
+
+    // Assigning again, one at a time or in a batch with repeats, gives the same ids
+    ASSERT_EQ(dictionary.getOrAssign(externalIds[42]), ids[42]);
+    std::vector<std::string> repeated = {externalIds[7], externalIds[3], externalIds[7]};
+    std::vector<uint64_t> repeatedIds;
+    dictionary.getOrAssign(repeated, repeatedIds);
+    ASSERT_EQ(repeatedIds[0], ids[7]);
+    ASSERT_EQ(repeatedIds[1], ids[3]);
+    ASSERT_EQ(repeatedIds[2], ids[7]);
+    ASSERT_EQ(dictionary.size(), 5000);
+}
+
+TEST(VertexDictionaryTest, TestLookupAndReverse) {
+    VertexDictionary dictionary(3);
+    std::vector<std::string> externalIds = makeIds(1000);
+    std::vector<uint64_t> ids;
+    dictionary.getOrAssign(externalIds, ids);
+
+    std::vector<std::string> queries = {externalIds[10], "never assigned", ""};
+    std::vector<uint64_t> found;
+    dictionary.lookup(queries, found);
+    ASSERT_EQ(found[0], ids[10]);
+    ASSERT_EQ(found[1], VertexDictionary::NOT_FOUND);
+    ASSERT_EQ(found[2], VertexDictionary::NOT_FOUND);
+    ASSERT_EQ(dictionary.size(), 1000);
+
+    std::vector<std::string> translated;
+    dictionary.getExternalIds(ids, translated);
+    ASSERT_EQ(translated, externalIds);
+    ASSERT_EQ(dictionary.getExternalId(1000000), "");
+}
+
+TEST(VertexDictionaryTest, TestReopen) {
+    std::string directory = TEST_RESOURCE_DIR "temp/vertex_dictionary";
+    Utils::deleteDirectory(directory);
+    std::vector<std::string> externalIds = makeIds(2000);
+    std::vector<uint64_t> ids;
+    {
+        VertexDictionary dictionary(8);
+        ASSERT_TRUE(dictionary.open(directory));
+        dictionary.getOrAssign(std::vector<std::string>(externalIds.begin(), externalIds.begin() + 1500), ids);
+        dictionary.getOrAssign(externalIds, ids);
+    }
+
+    {
+        // The shard count of the logs wins over the constructor argument, so every id keeps its owner
+        VertexDictionary reopened(2);
+        ASSERT_TRUE(reopened.open(directory));
+        ASSERT_EQ(reopened.getShardCount(), 8);
+        ASSERT_EQ(reopened.size(), 2000);
+        std::vector<uint64_t> found;
+        reopened.lookup(externalIds, found);
+        ASSERT_EQ(found, ids);
+    }
+
+    // A record cut short by a crash is dropped
+    std::string logPath = directory + "/shard_" + std::to_string(ids[0] % 8) + ".log";
+    FILE *log = fopen(logPath.c_str(), "ab");
+    uint32_t length = 100;
+    fwrite(&length, sizeof(length), 1, log);
+    fwrite("abc", 1, 3, log);
+    fclose(log);
+    VertexDictionary recovered(8);
+    ASSERT_TRUE(recovered.open(directory));
+    ASSERT_EQ(recovered.size(), 2000);
+    uint64_t newId = recovered.getOrAssign("new vertex");
+    ASSERT_EQ(std::count(ids.begin(), ids.end(), newId), 0);
+    ASSERT_EQ(recovered.getExternalId(newId), "new vertex");
+    Utils::deleteDirectory(directory);
+}
+
+TEST(VertexDictionaryTest, TestCache) {
+    VertexDictionary dictionary(4);
+    VertexDictionaryCache cache(dictionary, 64);
+    std::vector<std::string> externalIds = {"hub", "a", "hub", "b", "hub"};
+    std::vector<uint64_t> ids;
+    cache.getOrAssign(externalIds, ids);
+    ASSERT_EQ(ids[0], ids[2]);
+    ASSERT_EQ(ids[0], ids[4]);
+    ASSERT_NE(ids[0], ids[1]);
+    ASSERT_EQ(dictionary.size(), 3);
+
+    std::vector<uint64_t> cachedIds;
+    cache.getOrAssign(externalIds, cachedIds);
+    ASSERT_EQ(cachedIds, ids);
+    ASSERT_EQ(cache.getHitCount(), 5);
+    ASSERT_EQ(cache.getMissCount(), 5);
+}
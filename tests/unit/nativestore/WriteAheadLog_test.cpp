@@ -0,0 +1,127 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/nativestore/WriteAheadLog.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../../../src/nativestore/NodeManager.h"
+#include "../../../src/nativestore/RelationBlock.h"
+#include "../../../src/util/Utils.h"
+#include "gtest/gtest.h"
+
+TEST(WriteAheadLogTest, TestRecover) {
+    std::string prefix = TEST_RESOURCE_DIR "temp/g4_p0";
+    std::string dataPath = prefix + "_nodes.db";
+    std::ofstream(dataPath, std::ios::binary) << std::string(48, 'a');
+    std::fstream data(dataPath, std::ios::in | std::ios::out | std::ios::binary);
+
+    WriteAheadLog log(prefix);
+    ASSERT_TRUE(log.lock());
+    ASSERT_TRUE(log.checkpoint({{dataPath, &data}}));
+    WriteAheadLog other(prefix);
+    ASSERT_FALSE(other.lock());
+
+    log.logEdge(false, "1", "2");
+    log.saveBeforeImage(&data, 8, 4);
+    data.seekp(8);
+    data.write("bbbb", 4);
+    // Only the first write since the checkpoint keeps the bytes, and appended bytes are not kept
+    log.saveBeforeImage(&data, 8, 4);
+    data.seekp(8);
+    data.write("cccc", 4);
+    log.saveBeforeImage(&data, 48, 24);
+    data.seekp(48);
+    data.write(std::string(24, 'd').data(), 24);
+    data.flush();
+    log.logNodeProperty("1", "name", "Ada");
+    log.logEdgeProperty(true, "1", "2", "weight", "0.5");
+    ASSERT_EQ(log.getRecordCount(), 3);
+    uint64_t logSize = log.getSizeInBytes();
+    log.close();
+    // A record cut short by the crash
+    std::ofstream(prefix + "_wal.db", std::ios::binary | std::ios::app) << std::string("\x01\x20\x00", 3);
+
+    WriteAheadLog recovered(prefix);
+    ASSERT_TRUE(recovered.lock());
+    std::vector<WriteAheadLog::Record> records;
+    ASSERT_TRUE(recovered.recover(records));
+    ASSERT_EQ(records.size(), 3);
+    ASSERT_EQ(records[0].type, WriteAheadLog::LOCAL_EDGE);
+    ASSERT_EQ(records[0].fields, std::vector<std::string>({"1", "2"}));
+    ASSERT_EQ(records[1].fields, std::vector<std::string>({"1", "name", "Ada"}));
+    ASSERT_EQ(records[2].type, WriteAheadLog::CENTRAL_EDGE_PROPERTY);
+    ASSERT_EQ(records[2].fields, std::vector<std::string>({"1", "2", "weight", "0.5"}));
+    ASSERT_EQ(Utils::getFileSize(dataPath), 48);
+    std::ifstream restored(dataPath, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(restored)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(content, std::string(48, 'a'));
+    ASSERT_GT(logSize, 0);
+    recovered.close();
+
+    for (auto suffix : {"_nodes.db", "_wal.db", "_wal.lock"}) {
+        remove((prefix + suffix).c_str());
+    }
+}
+
+TEST(WriteAheadLogTest, TestNodeManagerRecovery) {
+    GraphConfig graphConfig;
+    graphConfig.graphID = 900010;
+    graphConfig.partitionID = 0;
+    graphConfig.maxLabelSize = std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size"));
+    graphConfig.openMode = "trunc";
+    graphConfig.checkpointRecords = 8;
+
+    NodeManager *nodeManager = new NodeManager(graphConfig);
+    for (int i = 0; i < 20; i++) {
+        RelationBlock *relation = nodeManager->addLocalEdge({std::to_string(i), std::to_string(i + 1)});
+        ASSERT_NE(relation, nullptr);
+        relation->addLocalProperty("weight", std::to_string(i));
+        relation->getSource()->addProperty("name", "node" + std::to_string(i));
+    }
+    std::string dbPrefix = nodeManager->getDbPrefix();
+    // Crash while a relation is half written, without closing the store
+    delete nodeManager;
+    std::ofstream(dbPrefix + "_relations.db", std::ios::binary | std::ios::app) << std::string(20, '\x7f');
+
+    // A read-only node manager leaves the lock and the recovery to the node manager that writes
+    graphConfig.openMode = "app";
+    graphConfig.readOnly = true;
+    NodeManager *reader = new NodeManager(graphConfig);
+    WriteAheadLog probe(dbPrefix);
+    ASSERT_TRUE(probe.lock());
+    probe.close();
+    ASSERT_NE(NodeManager::dbSize(dbPrefix + "_relations.db") % RelationBlock::BLOCK_SIZE, 0);
+    reader->close();
+    delete reader;
+
+    graphConfig.readOnly = false;
+    nodeManager = new NodeManager(graphConfig);
+    ASSERT_EQ(NodeManager::dbSize(dbPrefix + "_relations.db") % RelationBlock::BLOCK_SIZE, 0);
+    std::map<long, std::unordered_set<long>> adjacencyList = nodeManager->getAdjacencyList(true);
+    ASSERT_EQ(adjacencyList.size(), 20);
+    for (int i = 0; i < 20; i++) {
+        ASSERT_EQ(adjacencyList[i].count(i + 1), 1);
+        NodeBlock *source = nodeManager->get(std::to_string(i));
+        NodeBlock *destination = nodeManager->get(std::to_string(i + 1));
+        ASSERT_EQ(source->getAllProperties()["name"], "node" + std::to_string(i));
+        RelationBlock *relation = source->searchLocalRelation(*destination);
+        ASSERT_NE(relation, nullptr);
+        ASSERT_EQ(relation->getAllProperties()["weight"], std::to_string(i));
+    }
+    nodeManager->close();
+    delete nodeManager;
+}
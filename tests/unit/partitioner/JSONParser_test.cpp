@@ -0,0 +1,53 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/partitioner/local/JSONParser.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+static const std::string OUTPUT_DIR = "/tmp/JSONParser_test";
+
+static std::string readFile(const std::string &path) {
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+TEST(JSONParserTest, RemapsIdsInOrderOfFirstAppearance) {
+    Utils::createDirectory(OUTPUT_DIR);
+    std::string inputPath = OUTPUT_DIR + "/papers.json";
+    std::ofstream input(inputPath);
+    input << "{\"id\": \"100\", \"title\": \"A {\\\"quoted\\\"} [title]\", \"references\": [\"300\", \"200\"]}\n"
+          << "{\"id\": 200, \"references\": [], \"fos\": [{\"name\": \"Graphs\", \"w\": 0.9}]}\n"
+          << "\n"
+          << "{\"id\": \"not a number\", \"references\": [\"100\"]}\n"
+          << "{\"references\": [\"100\"]}\n"
+          << "{\"id\": 400, \"authors\": [{\"name\": \"B\"}], \"references\": [100]}";
+    input.close();
+
+    JSONParseStats stats = JSONParser::jsonParse(inputPath, OUTPUT_DIR, 2);
+    EXPECT_EQ(5, stats.lineCount);
+    EXPECT_EQ(2, stats.malformedLineCount);
+    EXPECT_EQ(3, stats.edgeCount);
+    EXPECT_EQ(4, stats.vertexCount);
+    EXPECT_EQ("0 1\n0 2\n3 0\n", readFile(OUTPUT_DIR + "/edgelist.txt"));
+
+    // No field of study is frequent enough to be a column, so a row is only the mapped id
+    EXPECT_EQ(0, stats.fieldCount);
+    EXPECT_EQ("0\t\n2\t\n3\t\n", readFile(OUTPUT_DIR + "/attributeList.txt"));
+    Utils::deleteDirectory(OUTPUT_DIR);
+}
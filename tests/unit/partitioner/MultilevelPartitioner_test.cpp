@@ -0,0 +1,84 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/partitioner/local/MultilevelPartitioner.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// CSR of a width x height grid with both directions of every edge
+static void buildGrid(int width, int height, std::vector<int> &xadj, std::vector<int> &adjncy) {
+    xadj.assign(1, 0);
+    adjncy.clear();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (x > 0) {
+                adjncy.push_back(y * width + x - 1);
+            }
+            if (x < width - 1) {
+                adjncy.push_back(y * width + x + 1);
+            }
+            if (y > 0) {
+                adjncy.push_back((y - 1) * width + x);
+            }
+            if (y < height - 1) {
+                adjncy.push_back((y + 1) * width + x);
+            }
+            xadj.push_back(adjncy.size());
+        }
+    }
+}
+
+TEST(MultilevelPartitionerTest, TestGridPartition) {
+    std::vector<int> xadj;
+    std::vector<int> adjncy;
+    buildGrid(100, 100, xadj, adjncy);
+
+    MultilevelPartitioner partitioner(4, MultilevelPartitioner::DEFAULT_IMBALANCE, 2);
+    std::vector<int> parts = partitioner.partition(xadj, adjncy);
+    ASSERT_EQ(parts.size(), 10000);
+    ASSERT_LE(MultilevelPartitioner::getImbalance(parts, 4), MultilevelPartitioner::DEFAULT_IMBALANCE + 1e-3);
+    // Cutting the grid into quarters cuts 200 edges, a random partition about 14850
+    ASSERT_LT(MultilevelPartitioner::getEdgeCut(xadj, adjncy, parts), 400);
+}
+
+TEST(MultilevelPartitionerTest, TestDisconnectedGraph) {
+    // Ten separate triangles and ten isolated vertices
+    std::vector<int> xadj(1, 0);
+    std::vector<int> adjncy;
+    for (int t = 0; t < 10; t++) {
+        for (int i = 0; i < 3; i++) {
+            adjncy.push_back(3 * t + (i + 1) % 3);
+            adjncy.push_back(3 * t + (i + 2) % 3);
+            xadj.push_back(adjncy.size());
+        }
+    }
+    for (int i = 0; i < 10; i++) {
+        xadj.push_back(adjncy.size());
+    }
+
+    MultilevelPartitioner partitioner(2, 1.1);
+    std::vector<int> parts = partitioner.partition(xadj, adjncy);
+    ASSERT_EQ(parts.size(), 40);
+    ASSERT_LE(MultilevelPartitioner::getImbalance(parts, 2), 1.1);
+    ASSERT_EQ(MultilevelPartitioner::getEdgeCut(xadj, adjncy, parts), 0);
+}
+
+TEST(MultilevelPartitionerTest, TestSinglePartition) {
+    std::vector<int> xadj;
+    std::vector<int> adjncy;
+    buildGrid(3, 3, xadj, adjncy);
+    MultilevelPartitioner partitioner(1);
+    ASSERT_EQ(partitioner.partition(xadj, adjncy), std::vector<int>(9, 0));
+}
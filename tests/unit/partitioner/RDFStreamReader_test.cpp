@@ -0,0 +1,156 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/partitioner/local/RDFStreamReader.h"
+
+#include <cstdio>
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+static const std::string EDGE_FILE = "/tmp/RDFStreamReader_test_edges";
+static const std::string ATTRIBUTE_FILE = "/tmp/RDFStreamReader_test_attributes";
+
+TEST(RDFStreamReaderTest, ParsesStatements) {
+    std::string subject;
+    std::string predicate;
+    std::string object;
+    bool isLiteral;
+
+    ASSERT_TRUE(RDFStreamReader::parseStatement("<http://a> <http://knows> <http://b> .", subject, predicate, object,
+                                                isLiteral));
+    EXPECT_EQ("http://a", subject);
+    EXPECT_EQ("http://knows", predicate);
+    EXPECT_EQ("http://b", object);
+    EXPECT_FALSE(isLiteral);
+
+    ASSERT_TRUE(RDFStreamReader::parseStatement("_:x\t<http://name> \"say \\\"hi\\\"\"@en .", subject, predicate,
+                                                object, isLiteral));
+    EXPECT_EQ("_:x", subject);
+    EXPECT_EQ("say \"hi\"", object);
+    EXPECT_TRUE(isLiteral);
+
+    ASSERT_TRUE(RDFStreamReader::parseStatement(
+        "<http://a> <http://age> \"42\"^^<http://www.w3.org/2001/XMLSchema#integer> .", subject, predicate, object,
+        isLiteral));
+    EXPECT_EQ("42", object);
+
+    EXPECT_FALSE(RDFStreamReader::parseStatement("# comment", subject, predicate, object, isLiteral));
+    EXPECT_FALSE(RDFStreamReader::parseStatement("<http://a> <http://b> .", subject, predicate, object, isLiteral));
+    EXPECT_FALSE(RDFStreamReader::parseStatement("<http://a> <http://b> \"open .", subject, predicate, object,
+                                                 isLiteral));
+}
+
+TEST(RDFStreamReaderTest, WritesDictionaryEncodedEdges) {
+    std::istringstream input(
+        "# people\n"
+        "<http://a> <http://knows> <http://b> .\n"
+        "<http://b> <http://knows> <http://c> .\n"
+        "<http://a> <http://likes> <http://c> .\n"
+        "<http://a> <http://name> \"A\" .\n"
+        "not a statement\n"
+        "\n");
+    {
+        RDFEdgeWriter writer(EDGE_FILE, "");
+        RDFStreamReader reader(writer);
+        EXPECT_EQ(4, reader.readNTriples(input));
+        EXPECT_EQ(1, reader.getLiteralCount());
+        EXPECT_EQ(1, reader.getMalformedCount());
+        EXPECT_EQ(3u, reader.getVertices().size());
+        // The predicate of the literal is kept for the literal record
+        EXPECT_EQ(3u, reader.getPredicates().size());
+        EXPECT_EQ(3, writer.getEdgeCount());
+    }
+
+    std::map<std::pair<int, int>, int> labels;
+    ASSERT_TRUE(RDFEdgeWriter::readEdgeLabels(EDGE_FILE, labels));
+    ASSERT_EQ(3u, labels.size());
+    EXPECT_EQ(0, labels[std::make_pair(0, 1)]);
+    EXPECT_EQ(0, labels[std::make_pair(1, 2)]);
+    EXPECT_EQ(1, labels[std::make_pair(0, 2)]);
+    std::remove(EDGE_FILE.c_str());
+}
+
+TEST(RDFStreamReaderTest, WritesLiteralsOfVertices) {
+    std::istringstream input(
+        "<http://a> <http://knows> <http://b> .\n"
+        "<http://a> <http://name> \"Ada\\tL.\"@en .\n"
+        "<http://c> <http://name> \"C\" .\n"
+        "<http://a> <http://age> \"36\"^^<http://www.w3.org/2001/XMLSchema#integer> .\n");
+    {
+        RDFEdgeWriter writer(EDGE_FILE, ATTRIBUTE_FILE);
+        RDFStreamReader reader(writer);
+        EXPECT_EQ(4, reader.readNTriples(input));
+        EXPECT_EQ(3, reader.getLiteralCount());
+        EXPECT_EQ(3, writer.getLiteralCount());
+        EXPECT_EQ(1, writer.getEdgeCount());
+        // A vertex with literals only is still a vertex of the graph
+        EXPECT_EQ(3u, reader.getVertices().size());
+    }
+
+    std::map<long, std::vector<std::pair<long, std::string>>> literals;
+    ASSERT_TRUE(RDFEdgeWriter::readLiterals(ATTRIBUTE_FILE, literals));
+    ASSERT_EQ(2u, literals.size());
+    ASSERT_EQ(2u, literals[0].size());
+    EXPECT_EQ(1, literals[0][0].first);
+    EXPECT_EQ("Ada L.", literals[0][0].second);
+    EXPECT_EQ(2, literals[0][1].first);
+    EXPECT_EQ("36", literals[0][1].second);
+    ASSERT_EQ(1u, literals[2].size());
+    EXPECT_EQ(1, literals[2][0].first);
+    EXPECT_EQ("C", literals[2][0].second);
+    std::remove(EDGE_FILE.c_str());
+    std::remove(ATTRIBUTE_FILE.c_str());
+}
+
+TEST(RDFStreamReaderTest, WritesAttributesOfLabels) {
+    std::string first[RDFEdgeWriter::ATTRIBUTE_COUNT] = {"A title", "0", "Journal\tof RDF", "", "May", "2024", "3"};
+    std::string second[RDFEdgeWriter::ATTRIBUTE_COUNT] = {"Another", "1", "", "", "", "", ""};
+    {
+        RDFEdgeWriter writer(EDGE_FILE, ATTRIBUTE_FILE);
+        writer.addAttributes(0, first);
+        writer.addAttributes(1, second);
+        writer.addEdge(1, 2, 0);
+        EXPECT_EQ(2, writer.getLabelCount());
+    }
+
+    std::map<long, std::string[RDFEdgeWriter::ATTRIBUTE_COUNT]> attributes;
+    ASSERT_TRUE(RDFEdgeWriter::readAttributes(ATTRIBUTE_FILE, attributes));
+    ASSERT_EQ(2u, attributes.size());
+    EXPECT_EQ("A title", attributes[0][0]);
+    EXPECT_EQ("Journal of RDF", attributes[0][2]);
+    EXPECT_EQ("", attributes[0][3]);
+    EXPECT_EQ("3", attributes[0][6]);
+    EXPECT_EQ("Another", attributes[1][0]);
+    EXPECT_EQ("", attributes[1][6]);
+    std::remove(EDGE_FILE.c_str());
+    std::remove(ATTRIBUTE_FILE.c_str());
+}
+
+TEST(RDFStreamReaderTest, DictionaryAssignsDenseIds) {
+    RDFDictionary dictionary(1);
+    EXPECT_EQ(1, dictionary.getId("Ada Lovelace"));
+    EXPECT_EQ(2, dictionary.getId("Charles Babbage"));
+    EXPECT_EQ(1, dictionary.getId("Ada Lovelace"));
+    EXPECT_EQ(2u, dictionary.size());
+    EXPECT_GT(dictionary.getMemoryBytes(), 0u);
+}
+
+TEST(RDFStreamReaderTest, CheckHashIsIndependentOfTheKey) {
+    // A collision of the key is only detected if the check hash of the two terms differs
+    std::string first = "http://a";
+    std::string second = "http://b";
+    EXPECT_NE(RDFDictionary::hash(first.data(), first.size()), RDFDictionary::checkHash(first.data(), first.size()));
+    EXPECT_NE(RDFDictionary::checkHash(first.data(), first.size()),
+              RDFDictionary::checkHash(second.data(), second.size()));
+}
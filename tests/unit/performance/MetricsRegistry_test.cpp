@@ -0,0 +1,75 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/performance/metrics/MetricsRegistry.h"
+
+#include <climits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+class MetricsRegistryTest : public ::testing::Test {
+ protected:
+    void SetUp() override { MetricsRegistry::reset(); }
+};
+
+TEST_F(MetricsRegistryTest, TestCounterFromManyThreads) {
+    Counter &counter = MetricsRegistry::counter("test_edges_total", "Edges");
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&counter]() {
+            for (int i = 0; i < 100000; i++) {
+                counter.inc();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(counter.value(), 800000);
+    ASSERT_EQ(&MetricsRegistry::counter("test_edges_total", "Edges"), &counter);
+}
+
+TEST_F(MetricsRegistryTest, TestHistogramPercentiles) {
+    Histogram &histogram = MetricsRegistry::histogram("test_latency_us", "Latency");
+    for (long value = 1; value <= 100000; value++) {
+        histogram.record(value);
+    }
+    ASSERT_EQ(histogram.getCount(), 100000);
+    ASSERT_EQ(histogram.getMax(), 100000);
+    ASSERT_EQ(histogram.percentile(1.0), 100000);
+    for (double quantile : {0.5, 0.9, 0.99}) {
+        double expected = quantile * 100000;
+        ASSERT_NEAR(histogram.percentile(quantile), expected, expected / Histogram::SUB_BUCKET_COUNT);
+    }
+    ASSERT_EQ(Histogram::getBucketIndex(LONG_MAX), Histogram::BUCKET_COUNT - 1);
+    ASSERT_EQ(Histogram::getBucketUpperBound(Histogram::BUCKET_COUNT - 1), LONG_MAX);
+}
+
+TEST_F(MetricsRegistryTest, TestSnapshotAndMerge) {
+    MetricsRegistry::counter("test_bytes_total", "Bytes").inc(42);
+    MetricsRegistry::gauge("test_queue_depth", "Queue depth", "queue=\"jobs\"").set(3);
+
+    std::string snapshot = MetricsRegistry::snapshot();
+    ASSERT_NE(snapshot.find("# TYPE test_bytes_total counter\ntest_bytes_total 42\n"), std::string::npos);
+    ASSERT_NE(snapshot.find("test_queue_depth{queue=\"jobs\"} 3\n"), std::string::npos);
+
+    std::string merged = MetricsRegistry::merge({{"master", snapshot}, {"worker:7780", snapshot}});
+    ASSERT_NE(merged.find("# TYPE test_bytes_total counter\ntest_bytes_total{instance=\"master\"} 42\n"
+                          "test_bytes_total{instance=\"worker:7780\"} 42\n"),
+              std::string::npos);
+    ASSERT_NE(merged.find("test_queue_depth{instance=\"worker:7780\",queue=\"jobs\"} 3\n"), std::string::npos);
+    ASSERT_EQ(merged.find("# TYPE test_bytes_total"), merged.rfind("# TYPE test_bytes_total"));
+}
@@ -0,0 +1,84 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/performance/trace/Tracer.h"
+
+#include <future>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "gtest/gtest.h"
+
+class TracerTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        Tracer::setCapacity(Tracer::DEFAULT_CAPACITY);
+        Tracer::setEnabled(true);
+    }
+
+    void TearDown() override {
+        Tracer::setEnabled(false);
+        Tracer::clear();
+    }
+};
+
+static std::string countPartition(int partitionId) {
+    TraceSpan span("worker.count", "partition=" + std::to_string(partitionId));
+    return Tracer::getCurrentTraceId();
+}
+
+TEST_F(TracerTest, TestDisabledTracingRecordsNothing) {
+    Tracer::setEnabled(false);
+    ASSERT_TRUE(Tracer::startTrace().empty());
+    {
+        TraceContext context("abc");
+        TraceSpan span("frontend.triangles");
+    }
+    ASSERT_TRUE(Tracer::getSpans("abc").empty());
+}
+
+TEST_F(TracerTest, TestSpansFollowTheTraceIntoOtherThreads) {
+    std::string traceId = Tracer::startTrace();
+    ASSERT_EQ(traceId.size(), 16);
+    {
+        TraceContext context(traceId);
+        TraceSpan span("executor.triangles");
+        auto first = std::async(std::launch::async, traced(countPartition), 1);
+        auto second = std::async(std::launch::async, traced(countPartition), 2);
+        ASSERT_EQ(first.get(), traceId);
+        ASSERT_EQ(second.get(), traceId);
+    }
+    ASSERT_TRUE(Tracer::getCurrentTraceId().empty());
+    ASSERT_EQ(Tracer::getSpans(traceId).size(), 3);
+
+    std::string master = Tracer::exportEvents(traceId, 0);
+    std::string worker = Tracer::exportEvents(traceId, 1);
+    nlohmann::json trace = nlohmann::json::parse(Tracer::mergeEvents({master, worker, "not json"}));
+    ASSERT_EQ(trace["traceEvents"].size(), 8);
+    nlohmann::json &event = trace["traceEvents"][1];
+    ASSERT_EQ(event["ph"], "X");
+    ASSERT_EQ(event["args"]["traceId"], traceId);
+    ASSERT_GE(event["dur"].get<long>(), 0);
+}
+
+TEST_F(TracerTest, TestRingBufferKeepsTheLatestSpans) {
+    Tracer::setCapacity(2);
+    TraceContext context("ring");
+    for (int i = 0; i < 5; i++) {
+        TraceSpan span("span", std::to_string(i));
+    }
+    auto spans = Tracer::getSpans("ring");
+    ASSERT_EQ(spans.size(), 2);
+    ASSERT_EQ(spans[0].detail, "4");
+    ASSERT_EQ(spans[1].detail, "3");
+}
@@ -34,13 +34,17 @@ class PerformanceSQLiteDBInterfaceTest : public ::testing::Test {
 
 TEST_F(PerformanceSQLiteDBInterfaceTest, TestRunSelect) {
     std::string tables[] =
-        {"graph_performance_data",
+        {"aggregation_performance",
+         "graph_performance_data",
          "graph_place_sla_performance",
          "graph_sla",
          "host",
          "host_performance_data",
+         "job_performance",
+         "kernel_performance",
          "place",
-         "place_performance_data"};
+         "place_performance_data",
+         "training_performance"};
     for (const auto &table : tables) {
         auto result = perfdbInterface->runSelect("SELECT * FROM " + table);
         ASSERT_EQ(result.size(), 0);
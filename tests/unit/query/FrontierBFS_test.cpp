@@ -0,0 +1,130 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/query/algorithms/traversal/FrontierBFS.h"
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../../../src/nativestore/NodeManager.h"
+#include "../../../src/util/Utils.h"
+#include "gtest/gtest.h"
+
+static const unsigned int GRAPH_ID = 900014;
+
+static std::string createPartition(unsigned int partitionID,
+                                   const std::vector<std::pair<std::string, std::string>> &localEdges,
+                                   const std::vector<std::pair<std::string, std::string>> &centralEdges) {
+    GraphConfig graphConfig;
+    graphConfig.graphID = GRAPH_ID;
+    graphConfig.partitionID = partitionID;
+    graphConfig.maxLabelSize = std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size"));
+    graphConfig.openMode = "trunc";
+    graphConfig.checkpointRecords = 0;
+    NodeManager nodeManager(graphConfig);
+    for (auto &edge : localEdges) {
+        nodeManager.addLocalEdge(edge);
+    }
+    for (auto &edge : centralEdges) {
+        nodeManager.addCentralEdge(edge);
+    }
+    nodeManager.close();
+    return nodeManager.getDbPrefix();
+}
+
+// Vertices reached at every depth, merging the boundary vertices of the partitions with the step of the master
+static std::vector<uint64_t> search(std::vector<FrontierBFS> &partitions, const std::string &source, int threadCount) {
+    std::vector<std::string> exchanged = {source};
+    std::unordered_set<std::string> reachedBoundary = {source};
+    std::vector<uint64_t> levels;
+    uint64_t found = 0;
+    for (auto &partition : partitions) {
+        partition.reset();
+        found += partition.addToFrontier(exchanged);
+    }
+    if (found == 0) {
+        return levels;
+    }
+    levels.push_back(1);
+    while (true) {
+        uint64_t reached = 0;
+        std::vector<std::string> boundary;
+        for (auto &partition : partitions) {
+            partition.addToFrontier(exchanged);
+            FrontierBFS::LevelStats stats = partition.expand(threadCount, boundary);
+            reached += stats.reached - stats.reachedBoundary;
+        }
+        reached = FrontierBFS::mergeBoundary(reached, boundary, reachedBoundary, exchanged);
+        if (reached == 0) {
+            return levels;
+        }
+        levels.push_back(reached);
+    }
+}
+
+TEST(FrontierBFSTest, TestSearch) {
+    std::vector<std::pair<std::string, std::string>> localEdges = {{"0", "1"}, {"1", "2"}, {"2", "3"}};
+    for (int i = 10; i < 30; i++) {
+        localEdges.push_back({"2", std::to_string(i)});
+    }
+    std::string firstPrefix = createPartition(0, localEdges, {{"3", "100"}});
+    std::string secondPrefix = createPartition(1, {{"100", "101"}, {"101", "102"}}, {{"3", "100"}});
+    unsigned long indexKeySize =
+        std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size"));
+
+    for (bool directed : {false, true}) {
+        std::vector<FrontierBFS> partitions(2);
+        ASSERT_TRUE(partitions[0].load(firstPrefix, indexKeySize, directed));
+        ASSERT_TRUE(partitions[1].load(secondPrefix, indexKeySize, directed));
+        ASSERT_EQ(partitions[0].getVertexCount(), 25);
+        ASSERT_EQ(partitions[1].getEdgeCount(), directed ? 3 : 6);
+
+        std::vector<uint64_t> expected = {1, 1, 1, 21, 1, 1, 1};
+        ASSERT_EQ(search(partitions, "0", 1), expected);
+        ASSERT_EQ(search(partitions, "0", 4), expected);
+        for (auto &partition : partitions) {
+            partition.setDirectionOptimizing(false);
+        }
+        ASSERT_EQ(search(partitions, "0", 4), expected);
+        ASSERT_EQ(search(partitions, "102", 4),
+                  directed ? std::vector<uint64_t>({1}) : std::vector<uint64_t>({1, 1, 1, 1, 1, 21, 1}));
+        ASSERT_TRUE(search(partitions, "200", 4).empty());
+    }
+}
+
+TEST(FrontierBFSTest, TestMessage) {
+    std::string buffer;
+    ASSERT_TRUE(FrontierBFS::writeMessage(
+        [&buffer](const char *bytes, size_t size) {
+            buffer.append(bytes, size);
+            return true;
+        },
+        {3, 1ULL << 40}, {"12", "", "user_7"}));
+
+    size_t position = 0;
+    std::vector<uint64_t> counters;
+    std::vector<std::string> ids;
+    auto source = [&](char *bytes, size_t size) {
+        if (position + size > buffer.size()) {
+            return false;
+        }
+        memcpy(bytes, buffer.data() + position, size);
+        position += size;
+        return true;
+    };
+    ASSERT_TRUE(FrontierBFS::readMessage(source, counters, ids));
+    ASSERT_EQ(counters, std::vector<uint64_t>({3, 1ULL << 40}));
+    ASSERT_EQ(ids, std::vector<std::string>({"12", "", "user_7"}));
+    ASSERT_FALSE(FrontierBFS::readMessage(source, counters, ids));
+}
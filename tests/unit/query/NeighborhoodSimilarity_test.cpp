@@ -0,0 +1,77 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/query/algorithms/linkprediction/NeighborhoodSimilarity.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+// 1 - 2 - 3 - 4 with 5 connected to 2 and 3
+static NeighborhoodSimilarity buildGraph() {
+    std::map<long, std::unordered_set<long>> localStore = {{1, {2}}, {2, {3}}, {3, {4}}};
+    std::map<long, std::unordered_set<long>> centralStore = {{5, {2, 3}}};
+    NeighborhoodSimilarity similarity;
+    similarity.addEdges(localStore);
+    similarity.addEdges(centralStore);
+    similarity.addEdge(3, 2);  // Duplicates of edges already seen are dropped
+    similarity.build();
+    return similarity;
+}
+
+TEST(NeighborhoodSimilarityTest, TestScores) {
+    NeighborhoodSimilarity similarity = buildGraph();
+    ASSERT_EQ(similarity.getVertexCount(), 5);
+    ASSERT_EQ(similarity.getDegree(2), 3);
+
+    // N(1) = {2}, N(3) = {2, 4, 5}
+    ASSERT_EQ(similarity.score(1, 3, NeighborhoodSimilarity::COMMON_NEIGHBORS), 1);
+    ASSERT_DOUBLE_EQ(similarity.score(1, 3, NeighborhoodSimilarity::JACCARD), 1.0 / 3);
+    ASSERT_DOUBLE_EQ(similarity.score(1, 3, NeighborhoodSimilarity::ADAMIC_ADAR), 1 / std::log(3.0));
+    ASSERT_DOUBLE_EQ(similarity.score(1, 3, NeighborhoodSimilarity::RESOURCE_ALLOCATION), 1.0 / 3);
+    ASSERT_EQ(similarity.score(1, 42, NeighborhoodSimilarity::COMMON_NEIGHBORS), 0);
+
+    NeighborhoodSimilarity::Metric metric;
+    ASSERT_TRUE(NeighborhoodSimilarity::parseMetric("adamic-adar", metric));
+    ASSERT_EQ(metric, NeighborhoodSimilarity::ADAMIC_ADAR);
+    ASSERT_FALSE(NeighborhoodSimilarity::parseMetric("katz", metric));
+}
+
+TEST(NeighborhoodSimilarityTest, TestPredictTopK) {
+    NeighborhoodSimilarity similarity = buildGraph();
+
+    // Candidates of 4 are 2 (common neighbour 3) and 5 (common neighbour 3), tied and ordered by id
+    std::vector<LinkScore> scores = similarity.predict({4, 1}, NeighborhoodSimilarity::COMMON_NEIGHBORS, 1, 2);
+    ASSERT_EQ(scores.size(), 2);
+    ASSERT_EQ(scores[0].source, 4);
+    ASSERT_EQ(scores[0].target, 2);
+    ASSERT_EQ(scores[1].source, 1);
+
+    // 1 is two hops away from 3 and 5, 5 only shares 2 and scores higher on Jaccard
+    scores = similarity.predict({1}, NeighborhoodSimilarity::JACCARD, 5, 1);
+    ASSERT_EQ(scores.size(), 2);
+    ASSERT_EQ(scores[0].target, 5);
+    ASSERT_DOUBLE_EQ(scores[0].score, 0.5);
+    ASSERT_EQ(scores[1].target, 3);
+
+    // Every vertex with the same results regardless of the number of threads
+    std::vector<LinkScore> serial = similarity.predict({}, NeighborhoodSimilarity::ADAMIC_ADAR, 3, 1);
+    std::vector<LinkScore> parallel = similarity.predict({}, NeighborhoodSimilarity::ADAMIC_ADAR, 3, 4);
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (size_t i = 0; i < serial.size(); i++) {
+        ASSERT_EQ(serial[i].source, parallel[i].source);
+        ASSERT_EQ(serial[i].target, parallel[i].target);
+        ASSERT_DOUBLE_EQ(serial[i].score, parallel[i].score);
+        ASSERT_NE(similarity.score(serial[i].source, serial[i].target, NeighborhoodSimilarity::COMMON_NEIGHBORS), 0);
+    }
+}
@@ -0,0 +1,83 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/query/algorithms/triangles/TriangleSet.h"
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(TriangleSetTest, TestInsertIgnoresVertexOrder) {
+    TriangleSet triangles;
+    ASSERT_TRUE(triangles.insert(3, 1, 2));
+    ASSERT_FALSE(triangles.insert(1, 2, 3));
+    ASSERT_FALSE(triangles.insert(2, 3, 1));
+    ASSERT_TRUE(triangles.insert(1, 2, 4));
+    ASSERT_TRUE(triangles.contains(4, 2, 1));
+    ASSERT_FALSE(triangles.contains(1, 3, 4));
+    ASSERT_EQ(triangles.size(), 2);
+}
+
+TEST(TriangleSetTest, TestPackingBoundaries) {
+    TriangleSet triangles;
+    long max = TriangleSet::MAX_PACKED_VERTEX;
+    ASSERT_TRUE(triangles.insert(0, max - 1, max));
+    ASSERT_TRUE(triangles.insert(0, max - 2, max));
+    ASSERT_TRUE(triangles.insert(1, max - 1, max));
+    // Vertices outside of the packed range fall back to the exact overflow set
+    ASSERT_TRUE(triangles.insert(0, max, max + 1));
+    ASSERT_FALSE(triangles.insert(max + 1, 0, max));
+    ASSERT_TRUE(triangles.insert(-1, 0, 1));
+    ASSERT_EQ(triangles.size(), 5);
+}
+
+TEST(TriangleSetTest, TestInsertAll) {
+    TriangleSet triangles;
+    ASSERT_EQ(triangles.insertAll("1,2,3:2,3,4:1,2,3"), 2);
+    ASSERT_EQ(triangles.insertAll("NILL"), 0);
+    ASSERT_EQ(triangles.insertAll(":3,2,1::4,5,6:"), 1);
+    ASSERT_EQ(triangles.insertAll(""), 0);
+    ASSERT_EQ(triangles.size(), 3);
+}
+
+// Aggregators of a graph with a heavy edge cut report the same cross partition triangles many times. The packed set
+// has to keep as many triangles as the string based deduplication it replaces, see TriangleSet_bench for the timing.
+TEST(TriangleSetTest, TestHeavyEdgeCutDeduplication) {
+    long max = TriangleSet::MAX_PACKED_VERTEX;
+    std::vector<std::string> responses = {
+        "1,2,3:2,3,4:4,5,6:7,8,9",
+        "1,2,3:2,3,4:4,5,6:10,11,12",
+        "1,2,3:2,3,4:7,8,9:13,14,15",
+        "1,2,3:4,5,6:0," + std::to_string(max) + "," + std::to_string(max + 1) + ":13,14,15",
+        "2,3,4:4,5,6:0," + std::to_string(max) + "," + std::to_string(max + 1) + ":16,17,18",
+    };
+
+    std::set<std::string> stringTriangles;
+    for (auto &response : responses) {
+        std::stringstream stream(response);
+        std::string triangle;
+        while (std::getline(stream, triangle, ':')) {
+            stringTriangles.insert(triangle);
+        }
+    }
+
+    TriangleSet packedTriangles;
+    for (auto &response : responses) {
+        packedTriangles.insertAll(response);
+    }
+    ASSERT_EQ(stringTriangles.size(), 8);
+    ASSERT_EQ(packedTriangles.size(), stringTriangles.size());
+}
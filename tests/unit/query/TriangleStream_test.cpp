@@ -0,0 +1,105 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/query/algorithms/triangles/TriangleStream.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+class TriangleStreamTest : public ::testing::Test {
+ protected:
+    std::string stream;
+    size_t readOffset = 0;
+
+    TriangleStreamWriter::ByteSink sink() {
+        return [this](const char *bytes, size_t size) {
+            stream.append(bytes, size);
+            return true;
+        };
+    }
+
+    TriangleStreamReader::ByteSource source() {
+        return [this](char *bytes, size_t size) {
+            if (readOffset + size > stream.size()) return false;
+            memcpy(bytes, stream.data() + readOffset, size);
+            readOffset += size;
+            return true;
+        };
+    }
+};
+
+TEST_F(TriangleStreamTest, TestRoundTrip) {
+    TriangleStreamWriter writer(sink(), 4);
+    ASSERT_TRUE(writer.add(3, 1, 2));
+    ASSERT_TRUE(writer.add(100, 5, 7000000000L));
+    ASSERT_TRUE(writer.add(-4, 2, 0));
+    ASSERT_TRUE(writer.add(1, 2, 3));
+    ASSERT_TRUE(writer.finish());
+    ASSERT_EQ(writer.getTriangleCount(), 4);
+    ASSERT_EQ(writer.getBytesWritten(), stream.size());
+
+    TriangleStreamReader reader(source());
+    std::vector<long> frame;
+    std::vector<long> triangles;
+    int frames = 0;
+    while (reader.next(frame)) {
+        triangles.insert(triangles.end(), frame.begin(), frame.end());
+        frames++;
+    }
+    ASSERT_FALSE(reader.hasFailed());
+    ASSERT_GT(frames, 1);
+    std::vector<long> expected = {1, 2, 3, 5, 100, 7000000000L, -4, 0, 2, 1, 2, 3};
+    ASSERT_EQ(triangles, expected);
+}
+
+TEST_F(TriangleStreamTest, TestEmptyStream) {
+    TriangleStreamWriter writer(sink());
+    ASSERT_TRUE(writer.finish());
+
+    TriangleStreamReader reader(source());
+    std::vector<long> frame;
+    ASSERT_FALSE(reader.next(frame));
+    ASSERT_FALSE(reader.hasFailed());
+}
+
+TEST_F(TriangleStreamTest, TestTruncatedStream) {
+    TriangleStreamWriter writer(sink());
+    for (long i = 0; i < 100; i++) {
+        writer.add(i, i + 1, i + 2);
+    }
+    writer.finish();
+    stream.resize(stream.size() / 2);
+
+    TriangleStreamReader reader(source());
+    std::vector<long> frame;
+    ASSERT_FALSE(reader.next(frame));
+    ASSERT_TRUE(reader.hasFailed());
+}
+
+TEST_F(TriangleStreamTest, TestCorruptTriangleCount) {
+    TriangleStreamWriter writer(sink());
+    writer.add(1, 2, 3);
+    writer.finish();
+    // Claim more triangles than the payload bytes can encode
+    uint32_t count = 0xFFFFFFFF;
+    memcpy(&stream[sizeof(uint32_t)], &count, sizeof(count));
+
+    TriangleStreamReader reader(source());
+    std::vector<long> frame;
+    ASSERT_FALSE(reader.next(frame));
+    ASSERT_TRUE(reader.hasFailed());
+    ASSERT_EQ(frame.capacity(), 0);
+}
@@ -0,0 +1,133 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/streamingdb/StreamingSQLiteDBInterface.h"
+
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../../../src/nativestore/NodeManager.h"
+#include "../../../src/nativestore/RelationBlock.h"
+#include "../../../src/nativestore/StoreCompactor.h"
+#include "../../../src/util/Utils.h"
+#include "gtest/gtest.h"
+
+class StreamingSQLiteDBInterfaceTest : public ::testing::Test {
+ protected:
+    StreamingSQLiteDBInterface *streamingDB = NULL;
+
+    void SetUp() override {
+        streamingDB = new StreamingSQLiteDBInterface(TEST_RESOURCE_DIR "temp/jasminegraph_streaming.db");
+        streamingDB->init();
+    }
+
+    void TearDown() override {
+        streamingDB->finalize();
+        delete streamingDB;
+        remove(TEST_RESOURCE_DIR "temp/jasminegraph_streaming.db");
+    }
+
+    // Watermarks as the streaming triangle count saves them for a partition
+    void saveWatermarks(const std::string &graphId, int partitionId, long localEdges, long centralEdges,
+                        long triangles) {
+        streamingDB->runInsert("INSERT OR REPLACE INTO streaming_partition (partition_id, local_edges, triangles, "
+                               "central_edges, graph_id) VALUES (" + std::to_string(partitionId) + ", " +
+                               std::to_string(localEdges) + ", " + std::to_string(triangles) + ", " +
+                               std::to_string(centralEdges) + ", " + graphId + ")");
+    }
+};
+
+static long countTriangles(NodeManager *nodeManager) {
+    std::map<long, std::unordered_set<long>> adjacencyList;
+    for (auto &vertex : nodeManager->getAdjacencyList(true)) {
+        for (long neighbor : vertex.second) {
+            adjacencyList[vertex.first].insert(neighbor);
+            adjacencyList[neighbor].insert(vertex.first);
+        }
+    }
+    long triangles = 0;
+    for (auto &u : adjacencyList) {
+        for (long v : u.second) {
+            if (v <= u.first) continue;
+            for (long w : adjacencyList[v]) {
+                if (w > v && u.second.count(w) > 0) triangles++;
+            }
+        }
+    }
+    return triangles;
+}
+
+TEST_F(StreamingSQLiteDBInterfaceTest, TestWatermarksOfEveryPartition) {
+    ASSERT_FALSE(streamingDB->hasTriangleCountWatermarks("7", 2, false));
+    saveWatermarks("7", 0, 10, 2, 4);
+    ASSERT_FALSE(streamingDB->hasTriangleCountWatermarks("7", 2, false));
+    saveWatermarks("7", 1, 12, 3, 5);
+    saveWatermarks("8", 0, 1, 1, 0);
+    ASSERT_TRUE(streamingDB->hasTriangleCountWatermarks("7", 2, false));
+    ASSERT_FALSE(streamingDB->hasTriangleCountWatermarks("7", 3, false));
+    // The central stores are only counted for more than two partitions
+    ASSERT_FALSE(streamingDB->hasTriangleCountWatermarks("7", 2, true));
+    streamingDB->runInsert("INSERT OR REPLACE INTO central_store (triangles, graph_id) VALUES (3, 7)");
+    ASSERT_TRUE(streamingDB->hasTriangleCountWatermarks("7", 2, true));
+
+    streamingDB->removeTriangleCountWatermarks("7");
+    ASSERT_FALSE(streamingDB->hasTriangleCountWatermarks("7", 1, false));
+    ASSERT_TRUE(streamingDB->runSelect("SELECT * FROM central_store WHERE graph_id = 7").empty());
+    ASSERT_TRUE(streamingDB->hasTriangleCountWatermarks("8", 1, false));
+}
+
+// Compaction renumbers the relations the watermarks point into, so the incremental count after it is a full count
+TEST_F(StreamingSQLiteDBInterfaceTest, TestIncrementalCountAfterCompaction) {
+    GraphConfig graphConfig;
+    graphConfig.graphID = 900014;
+    graphConfig.partitionID = 0;
+    graphConfig.maxLabelSize = std::stoi(Utils::getJasmineGraphProperty("org.jasminegraph.nativestore.max.label.size"));
+    graphConfig.openMode = "trunc";
+    std::string graphId = std::to_string(graphConfig.graphID);
+
+    NodeManager *nodeManager = new NodeManager(graphConfig);
+    std::vector<std::pair<std::string, std::string>> edges = {{"1", "2"}, {"2", "3"}, {"1", "3"},
+                                                              {"3", "4"}, {"4", "5"}, {"3", "5"}};
+    for (auto &edge : edges) {
+        ASSERT_NE(nodeManager->addLocalEdge(edge), nullptr);
+    }
+    // Full count (mode 0) of the streamed edges
+    std::string dbPrefix = nodeManager->getDbPrefix();
+    long localRelations = nodeManager->dbSize(dbPrefix + "_relations.db") / RelationBlock::BLOCK_SIZE - 1;
+    ASSERT_EQ(localRelations, edges.size());
+    ASSERT_EQ(countTriangles(nodeManager), 2);
+    saveWatermarks(graphId, 0, localRelations, 0, 2);
+    nodeManager->close();
+    delete nodeManager;
+    ASSERT_TRUE(streamingDB->hasTriangleCountWatermarks(graphId, 1, false));
+
+    StoreCompactor::Stats stats;
+    ASSERT_TRUE(StoreCompactor::compact(dbPrefix, graphConfig.maxLabelSize, stats));
+    ASSERT_EQ(stats.relations, edges.size());
+    // What the master does once the partitions report the compaction
+    streamingDB->removeTriangleCountWatermarks(graphId);
+
+    // An incremental count (mode 1) requested now has no watermarks to continue from and counts the whole graph
+    ASSERT_FALSE(streamingDB->hasTriangleCountWatermarks(graphId, 1, false));
+    graphConfig.openMode = "app";
+    nodeManager = new NodeManager(graphConfig);
+    localRelations = nodeManager->dbSize(dbPrefix + "_relations.db") / RelationBlock::BLOCK_SIZE - 1;
+    ASSERT_EQ(localRelations, edges.size());
+    ASSERT_EQ(countTriangles(nodeManager), 2);
+    saveWatermarks(graphId, 0, localRelations, 0, 2);
+    nodeManager->close();
+    delete nodeManager;
+    ASSERT_TRUE(streamingDB->hasTriangleCountWatermarks(graphId, 1, false));
+}
@@ -0,0 +1,121 @@
+/**
+Copyright 2024 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#include "../../../src/util/logger/Logger.h"
+
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/spdlog.h>
+
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+static int formatCount = 0;
+
+struct CountingArg {
+    int value;
+};
+
+template <>
+struct fmt::formatter<CountingArg> : fmt::formatter<int> {
+    template <typename FormatContext>
+    auto format(const CountingArg &arg, FormatContext &ctx) const -> decltype(ctx.out()) {
+        formatCount++;
+        return fmt::formatter<int>::format(arg.value, ctx);
+    }
+};
+
+static Logger test_logger;
+
+static const std::string LOG_FILE = TEST_RESOURCE_DIR "temp/logger_test.log";
+
+static int countLines(const std::string &path, const std::string &marker) {
+    std::ifstream file(path);
+    std::string line;
+    int count = 0;
+    while (std::getline(file, line)) {
+        if (line.find(marker) != std::string::npos) {
+            count++;
+        }
+    }
+    return count;
+}
+
+class LoggerTest : public ::testing::Test {
+ protected:
+    std::vector<spdlog::sink_ptr> dailySinks;
+
+    void SetUp() override {
+        // The messages of the tests go to a temporary file instead of the daily log file, and not to the console.
+        // The first message configures the loggers.
+        std::vector<spdlog::sink_ptr> &sinks = spdlog::get("JasmineGraph")->sinks();
+        dailySinks = sinks;
+        sinks.assign(1, std::make_shared<spdlog::sinks::basic_file_sink_mt>(LOG_FILE, true));
+        test_logger.info("Logger test started");
+        spdlog::get("logger")->set_level(spdlog::level::off);
+    }
+
+    void TearDown() override {
+        Logger::setAsync(false);
+        Logger::setLevel(LOG_INFO);
+        spdlog::get("JasmineGraph")->sinks() = dailySinks;
+        spdlog::get("logger")->set_level(spdlog::level::trace);
+        std::remove(LOG_FILE.c_str());
+    }
+};
+
+TEST_F(LoggerTest, TestDisabledLevelsAreNotFormatted) {
+    formatCount = 0;
+    Logger::setLevel(LOG_INFO);
+    test_logger.debug("Adding node {}", CountingArg{1});
+    JG_LOG_DEBUG(test_logger, "Adding node {}", CountingArg{2});
+    ASSERT_EQ(formatCount, 0);
+
+    test_logger.info("Added node {}", CountingArg{3});
+    ASSERT_EQ(formatCount, 1);
+
+    ASSERT_EQ(Logger::parseLevel("debug"), LOG_DEBUG);
+    ASSERT_EQ(Logger::parseLevel("unknown"), LOG_INFO);
+    ASSERT_FALSE(Logger::isEnabled(LOG_DEBUG));
+    ASSERT_TRUE(Logger::isEnabled(LOG_ERROR));
+}
+
+TEST_F(LoggerTest, TestAsyncModeWritesEveryMessage) {
+    const std::string marker = "async-" + std::to_string(std::time(nullptr));
+    const int threads = 4;
+    const int messagesPerThread = 500;
+
+    // A small ring buffer makes the producers hit the synchronous fallback as well
+    Logger::setAsync(true, 16);
+    ASSERT_TRUE(Logger::isAsync());
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; t++) {
+        producers.emplace_back([&marker, t, messagesPerThread]() {
+            for (int i = 0; i < messagesPerThread; i++) {
+                test_logger.info("{} thread {} message {}", marker, t, i);
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    Logger::setAsync(false);
+
+    ASSERT_EQ(countLines(LOG_FILE, marker), threads * messagesPerThread);
+}